@@ -0,0 +1,268 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the allocators of vtkDataArrayTemplate and vtkIdList.
+
+#include "vtkArenaArrayAllocator.h"
+#include "vtkArrayAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkHugePageArrayAllocator.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkObjectFactory.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    ++errors; \
+    }
+
+// Check that values[i] == i for i < n.
+template <class ArrayT>
+static int CheckValues(ArrayT *array, vtkIdType n)
+{
+  if (array->GetNumberOfTuples() != n)
+    {
+    return 0;
+    }
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    if (array->GetValue(i) != i)
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+static int TestCounting()
+{
+  int errors = 0;
+  vtkArrayAllocator *allocator = vtkArrayAllocator::New();
+  vtkArrayAllocator::SetDefaultAllocator(allocator);
+
+  vtkDoubleArray *array = vtkDoubleArray::New();
+  vtkIdList *ids = vtkIdList::New();
+  vtkArrayAllocator::SetDefaultAllocator(NULL);
+  TEST_ASSERT(array->GetAllocator() == allocator, "array has no allocator");
+  TEST_ASSERT(ids->GetAllocator() == allocator, "id list has no allocator");
+
+  for (vtkIdType i = 0; i < 10000; ++i)
+    {
+    array->InsertNextValue(i);
+    ids->InsertNextId(i);
+    }
+  TEST_ASSERT(CheckValues(array, 10000), "wrong array values");
+  int idsOk = (ids->GetNumberOfIds() == 10000);
+  for (vtkIdType i = 0; idsOk && i < 10000; ++i)
+    {
+    idsOk = (ids->GetId(i) == i);
+    }
+  TEST_ASSERT(idsOk, "wrong ids");
+  TEST_ASSERT(allocator->GetNumberOfAllocations() == 2,
+              "expected 2 allocations, got "
+              << allocator->GetNumberOfAllocations());
+  TEST_ASSERT(allocator->GetNumberOfReallocations() > 0,
+              "growth was not reallocated");
+  TEST_ASSERT(allocator->GetBytesInUse() >=
+              10000 * (sizeof(double) + sizeof(vtkIdType)),
+              "too few bytes in use: " << allocator->GetBytesInUse());
+
+  vtkDoubleArray *copy = vtkDoubleArray::New();
+  copy->SetAllocator(allocator);
+  copy->DeepCopy(array);
+  TEST_ASSERT(CheckValues(copy, 10000), "wrong deep copy");
+  TEST_ASSERT(allocator->GetNumberOfAllocations() == 3,
+              "deep copy did not use the allocator");
+
+  array->Delete();
+  ids->Delete();
+  copy->Delete();
+  TEST_ASSERT(allocator->GetBytesInUse() == 0,
+              allocator->GetBytesInUse() << " bytes not freed");
+  TEST_ASSERT(allocator->GetNumberOfFrees() == 3,
+              "expected 3 frees, got " << allocator->GetNumberOfFrees());
+  allocator->Delete();
+  return errors;
+}
+
+//----------------------------------------------------------------------------
+static int TestArena()
+{
+  int errors = 0;
+  vtkArenaArrayAllocator *arena = vtkArenaArrayAllocator::New();
+  arena->SetBlockSize(1 << 16);
+  vtkArrayAllocator::SetDefaultAllocator(arena);
+
+  // Many small arrays fit in few blocks.
+  vtkIntArray *arrays[100];
+  for (int a = 0; a < 100; ++a)
+    {
+    arrays[a] = vtkIntArray::New();
+    for (int i = 0; i < 100; ++i)
+      {
+      arrays[a]->InsertNextValue(i);
+      }
+    }
+  vtkArrayAllocator::SetDefaultAllocator(NULL);
+  int ok = 1;
+  for (int a = 0; a < 100; ++a)
+    {
+    ok = ok && CheckValues(arrays[a], 100);
+    }
+  TEST_ASSERT(ok, "wrong values in the arena arrays");
+  TEST_ASSERT(arena->GetNumberOfBlocks() <= 2,
+              arena->GetNumberOfBlocks() << " blocks for 40 KiB");
+  TEST_ASSERT(arena->GetNumberOfLiveAllocations() == 100,
+              arena->GetNumberOfLiveAllocations() << " live allocations");
+
+  // An array grown past half a block leaves the arena.
+  vtkIntArray *large = vtkIntArray::New();
+  large->SetAllocator(arena);
+  for (int i = 0; i < 100000; ++i)
+    {
+    large->InsertNextValue(i);
+    }
+  TEST_ASSERT(CheckValues(large, 100000), "wrong values in the large array");
+  large->Delete();
+
+  int blocks = arena->GetNumberOfBlocks();
+  for (int a = 0; a < 100; ++a)
+    {
+    arrays[a]->Delete();
+    }
+  TEST_ASSERT(arena->GetNumberOfLiveAllocations() == 0,
+              "allocations left after deleting the arrays");
+  TEST_ASSERT(arena->GetNumberOfRewinds() == 1, "arena did not rewind");
+  TEST_ASSERT(arena->GetBytesInUse() == 0,
+              arena->GetBytesInUse() << " bytes not freed");
+
+  // A second execution reuses the blocks.
+  vtkIntArray *again = vtkIntArray::New();
+  again->SetAllocator(arena);
+  again->SetNumberOfValues(1000);
+  TEST_ASSERT(arena->GetNumberOfBlocks() == blocks, "blocks not reused");
+
+  // Moving the values to another allocator.
+  for (int i = 0; i < 1000; ++i)
+    {
+    again->SetValue(i, i);
+    }
+  again->SetAllocator(NULL);
+  TEST_ASSERT(CheckValues(again, 1000), "values lost by SetAllocator");
+  TEST_ASSERT(arena->GetNumberOfLiveAllocations() == 0,
+              "SetAllocator did not free the arena memory");
+  again->Delete();
+
+  TEST_ASSERT(arena->Release(), "could not release the arena");
+  TEST_ASSERT(arena->GetNumberOfBlocks() == 0, "blocks left after Release");
+  arena->Delete();
+  return errors;
+}
+
+//----------------------------------------------------------------------------
+static int TestHugePages()
+{
+  int errors = 0;
+  vtkHugePageArrayAllocator *allocator = vtkHugePageArrayAllocator::New();
+  allocator->ParallelFirstTouchOn();
+
+  vtkIdList *ids = vtkIdList::New();
+  ids->SetAllocator(allocator);
+  vtkDoubleArray *array = vtkDoubleArray::New();
+  array->SetAllocator(allocator);
+  for (vtkIdType i = 0; i < 1000000; ++i)
+    {
+    array->InsertNextValue(i);
+    ids->InsertNextId(i);
+    }
+  TEST_ASSERT(CheckValues(array, 1000000), "wrong values after growth");
+  int idsOk = (ids->GetNumberOfIds() == 1000000);
+  for (vtkIdType i = 0; idsOk && i < 1000000; ++i)
+    {
+    idsOk = (ids->GetId(i) == i);
+    }
+  TEST_ASSERT(idsOk, "wrong ids after growth");
+#if defined(__linux__)
+  TEST_ASSERT(allocator->GetNumberOfMappings() == 2,
+              allocator->GetNumberOfMappings() << " mappings");
+  TEST_ASSERT(allocator->GetMappedSize() >= 1000000 * sizeof(double),
+              "mapped size too small");
+#endif
+  array->Squeeze();
+  TEST_ASSERT(CheckValues(array, 1000000), "wrong values after Squeeze");
+
+  array->Delete();
+  ids->Delete();
+  TEST_ASSERT(allocator->GetNumberOfMappings() == 0, "mappings left");
+  TEST_ASSERT(allocator->GetBytesInUse() == 0,
+              allocator->GetBytesInUse() << " bytes not freed");
+  allocator->Delete();
+  return errors;
+}
+
+//----------------------------------------------------------------------------
+// An allocator without any memory to give.
+class vtkFailingArrayAllocator : public vtkArrayAllocator
+{
+public:
+  static vtkFailingArrayAllocator *New();
+  vtkTypeMacro(vtkFailingArrayAllocator,vtkArrayAllocator);
+
+protected:
+  void *AllocateMemory(size_t) { return NULL; }
+};
+
+vtkStandardNewMacro(vtkFailingArrayAllocator);
+
+static int TestFailure()
+{
+  int errors = 0;
+  vtkFailingArrayAllocator *allocator = vtkFailingArrayAllocator::New();
+
+  // The ids stay where they are when they cannot be moved.
+  vtkIdList *ids = vtkIdList::New();
+  for (vtkIdType i = 0; i < 100; ++i)
+    {
+    ids->InsertNextId(i);
+    }
+  cerr << "Expecting an allocation error." << endl;
+  ids->SetAllocator(allocator);
+  int idsOk = (ids->GetNumberOfIds() == 100);
+  for (vtkIdType i = 0; idsOk && i < 100; ++i)
+    {
+    idsOk = (ids->GetId(i) == i);
+    }
+  TEST_ASSERT(idsOk, "ids lost by a failed SetAllocator");
+  TEST_ASSERT(ids->GetAllocator() == NULL,
+              "failed SetAllocator changed the allocator of the id list");
+  ids->Delete();
+
+  allocator->Delete();
+  return errors;
+}
+
+//----------------------------------------------------------------------------
+int TestArrayAllocator(int, char *[])
+{
+  int errors = 0;
+  errors += TestCounting();
+  errors += TestArena();
+  errors += TestHugePages();
+  errors += TestFailure();
+  vtkArrayAllocator::SetDefaultAllocator(NULL);
+  return (errors == 0 ? 0 : 1);
+}
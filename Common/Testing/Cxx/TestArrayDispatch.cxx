@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayDispatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayDispatch.h"
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkTypeTraits.h"
+#include "vtkUnsignedCharArray.h"
+
+#define CHECK(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    retVal = 1; \
+    }
+
+// Records the type it is called with and sums the values.
+struct SumWorker
+{
+  vtkIdType NumberOfValues;
+  int Type;
+  double Sum;
+
+  template <class T> void operator()(T* values)
+    {
+    this->Type = vtkTypeTraits<T>::VTKTypeID();
+    this->Sum = 0.0;
+    for (vtkIdType i = 0; i < this->NumberOfValues; ++i)
+      {
+      this->Sum += static_cast<double>(values[i]);
+      }
+    }
+};
+
+// Copies the values of an array of any type to another.
+struct CopyWorker
+{
+  vtkIdType NumberOfValues;
+  int Calls;
+
+  template <class T1, class T2> void operator()(T1* from, T2* to)
+    {
+    for (vtkIdType i = 0; i < this->NumberOfValues; ++i)
+      {
+      to[i] = static_cast<T2>(from[i]);
+      }
+    ++this->Calls;
+    }
+};
+
+template <class ArrayT>
+static vtkSmartPointer<ArrayT> NewRamp(vtkIdType n)
+{
+  vtkSmartPointer<ArrayT> array = vtkSmartPointer<ArrayT>::New();
+  array->SetNumberOfTuples(n);
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    array->SetComponent(i, 0, static_cast<double>(i));
+    }
+  return array;
+}
+
+int TestArrayDispatch(int, char *[])
+{
+  int retVal = 0;
+  const vtkIdType n = 10;
+
+  vtkSmartPointer<vtkFloatArray> floats = NewRamp<vtkFloatArray>(n);
+  vtkSmartPointer<vtkIntArray> ints = NewRamp<vtkIntArray>(n);
+  vtkSmartPointer<vtkIdTypeArray> ids = NewRamp<vtkIdTypeArray>(n);
+  vtkSmartPointer<vtkUnsignedCharArray> chars =
+    NewRamp<vtkUnsignedCharArray>(n);
+
+  // All the types.
+  SumWorker sum = { n, -1, 0.0 };
+  CHECK(vtkArrayDispatch<>::Execute(floats, sum) &&
+        sum.Type == VTK_FLOAT && sum.Sum == 45.0, "float dispatch failed");
+  CHECK(vtkArrayDispatch<>::Execute(ids, sum) &&
+        sum.Type == vtkTypeTraits<vtkIdType>::VTKTypeID() && sum.Sum == 45.0,
+        "vtkIdType dispatch failed");
+  CHECK(vtkArrayDispatch<>::Execute(chars, sum) &&
+        sum.Type == VTK_UNSIGNED_CHAR, "unsigned char dispatch failed");
+
+  // Restricted lists.
+  CHECK(vtkArrayDispatch<vtkArrayDispatchRealTypes>::Execute(floats, sum),
+        "float not a real type");
+  CHECK(!vtkArrayDispatch<vtkArrayDispatchRealTypes>::Execute(ints, sum),
+        "int dispatched as a real type");
+  CHECK(vtkArrayDispatch<vtkArrayDispatchIntegerTypes>::Execute(ints, sum) &&
+        sum.Type == VTK_INT, "int not an integer type");
+  typedef vtkArrayDispatchList<VTK_UNSIGNED_CHAR> CharOnly;
+  CHECK(vtkArrayDispatch<CharOnly>::Execute(chars, sum) &&
+        !vtkArrayDispatch<CharOnly>::Execute(ints, sum),
+        "wrong dispatch on a custom list");
+
+  // Arrays that cannot be dispatched.
+  vtkSmartPointer<vtkBitArray> bits = vtkSmartPointer<vtkBitArray>::New();
+  bits->SetNumberOfTuples(n);
+  CHECK(!vtkArrayDispatch<>::Execute(bits, sum), "vtkBitArray dispatched");
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > soa =
+    vtkSmartPointer<vtkSOADataArrayTemplate<float> >::New();
+  soa->SetNumberOfComponents(2);
+  soa->SetNumberOfTuples(n);
+  CHECK(!vtkArrayDispatch<>::Execute(soa, sum),
+        "array without the standard layout dispatched");
+  CHECK(!vtkArrayDispatch<>::Execute(0, sum), "NULL array dispatched");
+
+  // Two arrays of different types.
+  vtkSmartPointer<vtkDoubleArray> doubles = vtkSmartPointer<vtkDoubleArray>::New();
+  doubles->SetNumberOfTuples(n);
+  CopyWorker copy = { n, 0 };
+  typedef vtkArrayDispatch2<vtkArrayDispatchIntegerTypes,
+                            vtkArrayDispatchRealTypes> IntegerToReal;
+  typedef vtkArrayDispatch2<vtkArrayDispatchIntegerTypes,
+                            vtkArrayDispatchIntegerTypes> IntegerToInteger;
+  CHECK(IntegerToReal::Execute(ints, doubles, copy) &&
+        copy.Calls == 1 && doubles->GetValue(7) == 7.0, "int to double failed");
+  CHECK(!IntegerToInteger::Execute(ints, doubles, copy) && copy.Calls == 1,
+        "double dispatched as an integer type");
+
+  // Two arrays of the same type.
+  vtkSmartPointer<vtkIntArray> ints2 = vtkSmartPointer<vtkIntArray>::New();
+  ints2->SetNumberOfTuples(n);
+  CHECK(vtkArrayDispatch2SameType<>::Execute(ints, ints2, copy) &&
+        ints2->GetValue(9) == 9, "int to int failed");
+  CHECK(!vtkArrayDispatch2SameType<>::Execute(ints, doubles, copy),
+        "arrays of different types dispatched as the same type");
+
+  return retVal;
+}
@@ -0,0 +1,114 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayGrowthPolicy.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the growth policies of vtkDataArrayTemplate.
+
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    ++errors; \
+    }
+
+// Insert n values one at a time, checking they are all kept.  Return the
+// largest capacity reached.
+static vtkIdType InsertValues(vtkIntArray *array, int n, int &errors)
+{
+  vtkIdType maxCapacity = 0;
+  for (int i = 0; i < n; ++i)
+    {
+    array->InsertNextValue(i);
+    if (array->Capacity() > maxCapacity)
+      {
+      maxCapacity = array->Capacity();
+      }
+    }
+  int ok = (array->GetNumberOfTuples() == n);
+  for (int i = 0; ok && i < n; ++i)
+    {
+    ok = (array->GetValue(i) == i);
+    }
+  TEST_ASSERT(ok, "values lost while growing");
+  return maxCapacity;
+}
+
+int TestDataArrayGrowthPolicy(int, char *[])
+{
+  int errors = 0;
+  const int n = 100000;
+
+  // The default doubles the array.
+  vtkIntArray *geometric = vtkIntArray::New();
+  TEST_ASSERT(geometric->GetGrowthPolicy() ==
+              vtkIntArray::VTK_DATA_ARRAY_GROW_GEOMETRIC,
+              "the default policy is not geometric");
+  vtkIdType capacity = InsertValues(geometric, n, errors);
+  cout << "Geometric x2 capacity: " << capacity << endl;
+  TEST_ASSERT(capacity >= n && capacity < 2 * n + 2,
+              "unexpected geometric capacity " << capacity);
+  geometric->Squeeze();
+  TEST_ASSERT(geometric->Capacity() == n, "Squeeze did not fit the data");
+
+  // A smaller factor overshoots less.
+  vtkIntArray *factor = vtkIntArray::New();
+  factor->SetGrowthFactor(1.25);
+  vtkIdType factorCapacity = InsertValues(factor, n, errors);
+  cout << "Geometric x1.25 capacity: " << factorCapacity << endl;
+  TEST_ASSERT(factorCapacity >= n && factorCapacity < 1.25 * n + 2,
+              "unexpected capacity " << factorCapacity << " for factor 1.25");
+  factor->SetGrowthFactor(0.5);
+  TEST_ASSERT(factor->GetGrowthFactor() == 1.0, "factor not clamped to 1");
+
+  // Exact arrays never overshoot.
+  vtkIntArray *exact = vtkIntArray::New();
+  exact->SetGrowthPolicyToExact();
+  InsertValues(exact, 1000, errors);
+  TEST_ASSERT(exact->Capacity() == 1000,
+              "exact array has capacity " << exact->Capacity());
+
+  // Chunked arrays overshoot by less than one chunk.
+  vtkIntArray *chunked = vtkIntArray::New();
+  chunked->SetGrowthPolicyToChunked();
+  chunked->SetGrowthChunkSize(4096);
+  vtkIdType chunkedCapacity = InsertValues(chunked, n, errors);
+  cout << "Chunked capacity: " << chunkedCapacity << endl;
+  TEST_ASSERT(chunkedCapacity % 4096 == 0 && chunkedCapacity >= n &&
+              chunkedCapacity < n + 4096,
+              "unexpected chunked capacity " << chunkedCapacity);
+
+  // Tuples of several components grow by whole chunks as well.
+  vtkFloatArray *vectors = vtkFloatArray::New();
+  vectors->SetNumberOfComponents(3);
+  vectors->SetGrowthPolicyToChunked();
+  vectors->SetGrowthChunkSize(30);
+  float v[3] = { 1.0f, 2.0f, 3.0f };
+  for (int i = 0; i < 25; ++i)
+    {
+    vectors->InsertNextTupleValue(v);
+    }
+  TEST_ASSERT(vectors->Capacity() == 90,
+              "vector capacity " << vectors->Capacity());
+  TEST_ASSERT(vectors->GetNumberOfTuples() == 25 &&
+              vectors->GetComponent(24, 2) == 3.0f, "wrong vectors");
+
+  geometric->Delete();
+  factor->Delete();
+  exact->Delete();
+  chunked->Delete();
+  vectors->Delete();
+  return (errors == 0 ? 0 : 1);
+}
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitDataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImplicitArrayFunction.h"
+#include "vtkImplicitDataArrayTemplate.h"
+#include "vtkIntArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#define CHECK(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    retVal = 1; \
+    }
+
+// Computes (i, i*i + Offset).
+class vtkSquareFunction : public vtkImplicitArrayFunction
+{
+public:
+  static vtkSquareFunction *New();
+  vtkTypeMacro(vtkSquareFunction,vtkImplicitArrayFunction);
+  vtkSetMacro(Offset, double);
+  virtual int GetNumberOfComponents() { return 2; }
+  virtual void EvaluateTuple(vtkIdType i, double *tuple)
+    {
+    tuple[0] = static_cast<double>(i);
+    tuple[1] = static_cast<double>(i) * static_cast<double>(i) + this->Offset;
+    }
+protected:
+  vtkSquareFunction() : Offset(0.0) {}
+  double Offset;
+private:
+  vtkSquareFunction(const vtkSquareFunction&);  // Not implemented.
+  void operator=(const vtkSquareFunction&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkSquareFunction);
+
+int TestImplicitDataArray(int, char *[])
+{
+  int retVal = 0;
+
+  // A constant.
+  vtkSmartPointer<vtkImplicitDataArrayTemplate<float> > constant =
+    vtkSmartPointer<vtkImplicitDataArrayTemplate<float> >::New();
+  constant->SetNumberOfComponents(2);
+  constant->SetNumberOfTuples(1000000);
+  double c[2] = { 3.5, -1.0 };
+  constant->SetConstantTuple(c);
+  CHECK(constant->GetNumberOfTuples() == 1000000, "wrong number of tuples");
+  CHECK(constant->GetDataType() == VTK_FLOAT, "wrong data type");
+  CHECK(!constant->HasStandardMemoryLayout(), "layout reported as standard");
+  CHECK(constant->GetActualMemorySize() < 4,
+        "constant uses " << constant->GetActualMemorySize() << " kB");
+  CHECK(constant->GetComponent(999999, 0) == 3.5 &&
+        constant->GetComponent(12, 1) == -1.0, "wrong constant");
+  double *range = constant->GetRange(1);
+  CHECK(range[0] == -1.0 && range[1] == -1.0, "wrong constant range");
+
+  // An integer ramp converts its values like a vtkIntArray.
+  vtkSmartPointer<vtkImplicitDataArrayTemplate<int> > ramp =
+    vtkSmartPointer<vtkImplicitDataArrayTemplate<int> >::New();
+  ramp->SetNumberOfTuples(100);
+  ramp->SetRamp(0, 10.0, 0.5);
+  CHECK(ramp->GetValue(3) == 11, "wrong ramp value " << ramp->GetValue(3));
+  range = ramp->GetRange();
+  CHECK(range[0] == 10.0 && range[1] == 59.0,
+        "wrong ramp range " << range[0] << " " << range[1]);
+  CHECK(ramp->LookupValue(20) == 20, "LookupValue failed");
+
+  // The iterator and the pointer see a copy of the values.
+  vtkArrayIteratorTemplate<int> *iter =
+    static_cast<vtkArrayIteratorTemplate<int>*>(ramp->NewIterator());
+  CHECK(iter->GetNumberOfValues() == 100 && iter->GetValue(99) == 59,
+        "wrong iterator");
+  iter->Delete();
+
+  // The coordinates of a 4x3x2 grid.
+  vtkSmartPointer<vtkImplicitDataArrayTemplate<double> > coords =
+    vtkSmartPointer<vtkImplicitDataArrayTemplate<double> >::New();
+  int dims[3] = { 4, 3, 2 };
+  double origin[3] = { 1.0, 2.0, 3.0 };
+  double spacing[3] = { 0.5, 1.0, 2.0 };
+  coords->SetStructuredCoordinates(dims, origin, spacing);
+  CHECK(coords->GetNumberOfComponents() == 3 &&
+        coords->GetNumberOfTuples() == 24, "wrong coordinates size");
+  double x[3];
+  coords->GetTuple(4*3 + 4 + 3, x);
+  CHECK(x[0] == 2.5 && x[1] == 3.0 && x[2] == 5.0,
+        "wrong point " << x[0] << " " << x[1] << " " << x[2]);
+  range = coords->GetRange(2);
+  CHECK(range[0] == 3.0 && range[1] == 5.0, "wrong coordinates range");
+
+  // A function.
+  vtkSmartPointer<vtkSquareFunction> square =
+    vtkSmartPointer<vtkSquareFunction>::New();
+  vtkSmartPointer<vtkImplicitDataArrayTemplate<float> > squares =
+    vtkSmartPointer<vtkImplicitDataArrayTemplate<float> >::New();
+  squares->SetNumberOfTuples(10);
+  squares->SetFunction(square);
+  CHECK(squares->GetNumberOfComponents() == 2 &&
+        squares->GetNumberOfTuples() == 10, "wrong function array size");
+  CHECK(squares->GetComponent(7, 1) == 49.0, "wrong function value");
+  float *values = static_cast<float*>(squares->GetVoidPointer(0));
+  CHECK(values && values[2*9 + 1] == 81.0f, "wrong values pointer");
+
+  // The copy is kept until the values change.
+  CHECK(squares->GetVoidPointer(0) == values && values[2*9 + 1] == 81.0f,
+        "values copy not kept");
+  square->SetOffset(1.0);
+  values = static_cast<float*>(squares->GetVoidPointer(0));
+  CHECK(values[2*9 + 1] == 82.0f, "values copy not updated by the function");
+  square->SetOffset(0.0);
+  values = static_cast<float*>(squares->GetVoidPointer(0));
+  CHECK(values[2*9 + 1] == 81.0f, "values copy not updated by the function");
+  vtkSmartPointer<vtkImplicitDataArrayTemplate<double> > steps =
+    vtkSmartPointer<vtkImplicitDataArrayTemplate<double> >::New();
+  steps->SetNumberOfTuples(4);
+  steps->SetRamp(0, 1.0, 2.0);
+  double *rampValues = static_cast<double*>(steps->GetVoidPointer(0));
+  CHECK(rampValues[3] == 7.0, "wrong ramp values");
+  steps->SetRamp(0, 0.0, 1.0);
+  rampValues = static_cast<double*>(steps->GetVoidPointer(0));
+  CHECK(rampValues[3] == 3.0, "values copy not updated by SetRamp");
+
+  // Copies hold the values in a regular array.
+  vtkDataArray *copy = squares->NewInstance();
+  CHECK(vtkFloatArray::SafeDownCast(copy) != NULL,
+        "NewInstance() did not return a vtkFloatArray");
+  copy->DeepCopy(squares);
+  CHECK(copy->GetNumberOfTuples() == 10 && copy->GetComponent(5, 1) == 25.0,
+        "wrong deep copy");
+  vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+  ids->InsertNextId(3);
+  ids->InsertNextId(8);
+  vtkSmartPointer<vtkFloatArray> picked = vtkSmartPointer<vtkFloatArray>::New();
+  picked->SetNumberOfComponents(2);
+  picked->SetNumberOfTuples(2);
+  squares->GetTuples(ids, picked);
+  CHECK(picked->GetComponent(1, 1) == 64.0, "wrong GetTuples");
+  copy->Delete();
+
+  // Implicit arrays copy each other's definition.
+  vtkSmartPointer<vtkImplicitDataArrayTemplate<float> > other =
+    vtkSmartPointer<vtkImplicitDataArrayTemplate<float> >::New();
+  other->DeepCopy(squares);
+  CHECK(other->GetFunction() == square.GetPointer() &&
+        other->GetComponent(3, 1) == 9.0, "wrong implicit deep copy");
+
+  // The array is read only.
+  cout << "Expecting an error:" << endl;
+  squares->SetComponent(0, 0, 1.0);
+  CHECK(squares->GetComponent(0, 0) == 0.0, "a value was modified");
+
+  return retVal;
+}
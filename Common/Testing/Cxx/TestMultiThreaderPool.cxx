@@ -0,0 +1,226 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMultiThreaderPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#define NUMBER_OF_THREADS 4
+#define REPETITIONS 200
+
+struct PoolTestData
+{
+  vtkMutexLock *Lock;
+  int Calls[NUMBER_OF_THREADS];
+  int MultipleCalls[NUMBER_OF_THREADS];
+  int BadThreadCount;
+};
+
+static VTK_THREAD_RETURN_TYPE SingleMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  PoolTestData *data = static_cast<PoolTestData *>(info->UserData);
+  data->Lock->Lock();
+  data->Calls[info->ThreadID]++;
+  if (info->NumberOfThreads != NUMBER_OF_THREADS)
+    {
+    data->BadThreadCount++;
+    }
+  data->Lock->Unlock();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+static VTK_THREAD_RETURN_TYPE MultipleMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  int *calls = static_cast<int *>(info->UserData);
+  // Each thread has its own counter: no lock needed.
+  (*calls)++;
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Methods that wait for each other, with a timeout so that the test
+// fails instead of hanging if they do not run concurrently.
+struct RendezvousData
+{
+  vtkMutexLock *Lock;
+  int Arrived;
+  int TimedOut;
+};
+
+static VTK_THREAD_RETURN_TYPE RendezvousMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  RendezvousData *data = static_cast<RendezvousData *>(info->UserData);
+  data->Lock->Lock();
+  data->Arrived++;
+  data->Lock->Unlock();
+  double start = vtkTimerLog::GetUniversalTime();
+  for (;;)
+    {
+    data->Lock->Lock();
+    int arrived = data->Arrived;
+    data->Lock->Unlock();
+    if (arrived == info->NumberOfThreads)
+      {
+      break;
+      }
+    if (vtkTimerLog::GetUniversalTime() - start > 10.0)
+      {
+      data->Lock->Lock();
+      data->TimedOut = 1;
+      data->Lock->Unlock();
+      break;
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Run a pooled rendezvous from a thread of the pool.
+static VTK_THREAD_RETURN_TYPE NestedMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  RendezvousData *data = static_cast<RendezvousData *>(info->UserData);
+  data += 1 + info->ThreadID;
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->UseThreadPoolOn();
+  threader->SetNumberOfThreads(NUMBER_OF_THREADS);
+  threader->SetSingleMethod(RendezvousMethod, data);
+  threader->SingleMethodExecute();
+  threader->Delete();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Time REPETITIONS executions of an empty method.
+static double TimeExecute(vtkMultiThreader *threader, PoolTestData *data,
+                          double *latency)
+{
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  *latency = 0.0;
+  timer->StartTimer();
+  for (int i = 0; i < REPETITIONS; ++i)
+    {
+    threader->SetSingleMethod(SingleMethod, data);
+    threader->SingleMethodExecute();
+    *latency += threader->GetLastDispatchLatency();
+    }
+  timer->StopTimer();
+  *latency /= REPETITIONS;
+  return timer->GetElapsedTime() / REPETITIONS;
+}
+
+int TestMultiThreaderPool(int, char *[])
+{
+  int retVal = 0;
+
+  PoolTestData data;
+  data.Lock = vtkMutexLock::New();
+  data.BadThreadCount = 0;
+  for (int i = 0; i < NUMBER_OF_THREADS; ++i)
+    {
+    data.Calls[i] = 0;
+    data.MultipleCalls[i] = 0;
+    }
+
+  vtkMultiThreader::SetThreadPoolSize(NUMBER_OF_THREADS);
+  if (vtkMultiThreader::GetThreadPoolSize() != NUMBER_OF_THREADS)
+    {
+    cerr << "Thread pool size is " << vtkMultiThreader::GetThreadPoolSize()
+         << " instead of " << NUMBER_OF_THREADS << endl;
+    retVal = 1;
+    }
+
+  vtkSmartPointer<vtkMultiThreader> threader =
+    vtkSmartPointer<vtkMultiThreader>::New();
+  threader->SetNumberOfThreads(NUMBER_OF_THREADS);
+
+  double spawnLatency, poolLatency;
+  threader->UseThreadPoolOff();
+  double spawnTime = TimeExecute(threader, &data, &spawnLatency);
+  threader->UseThreadPoolOn();
+  double poolTime = TimeExecute(threader, &data, &poolLatency);
+
+  cout << "Average SingleMethodExecute time with " << NUMBER_OF_THREADS
+       << " threads:" << endl;
+  cout << "  created threads: " << spawnTime * 1.0e6 << " us (dispatch "
+       << spawnLatency * 1.0e6 << " us)" << endl;
+  cout << "  thread pool:     " << poolTime * 1.0e6 << " us (dispatch "
+       << poolLatency * 1.0e6 << " us)" << endl;
+
+  for (int i = 0; i < NUMBER_OF_THREADS; ++i)
+    {
+    if (data.Calls[i] != 2 * REPETITIONS)
+      {
+      cerr << "Thread " << i << " ran " << data.Calls[i] << " times instead of "
+           << 2 * REPETITIONS << endl;
+      retVal = 1;
+      }
+    }
+  if (data.BadThreadCount)
+    {
+    cerr << "Wrong NumberOfThreads passed " << data.BadThreadCount
+         << " times" << endl;
+    retVal = 1;
+    }
+
+  // MultipleMethodExecute through the pool.
+  for (int i = 0; i < NUMBER_OF_THREADS; ++i)
+    {
+    threader->SetMultipleMethod(i, MultipleMethod, &data.MultipleCalls[i]);
+    }
+  for (int r = 0; r < REPETITIONS; ++r)
+    {
+    threader->MultipleMethodExecute();
+    }
+  for (int i = 0; i < NUMBER_OF_THREADS; ++i)
+    {
+    if (data.MultipleCalls[i] != REPETITIONS)
+      {
+      cerr << "Multiple method " << i << " ran " << data.MultipleCalls[i]
+           << " times instead of " << REPETITIONS << endl;
+      retVal = 1;
+      }
+    }
+
+  // Methods that wait for each other must not deadlock when the pooled
+  // execute is made from a pool thread.  The first entry is unused.
+  RendezvousData rendezvous[NUMBER_OF_THREADS + 1];
+  for (int i = 0; i <= NUMBER_OF_THREADS; ++i)
+    {
+    rendezvous[i].Lock = data.Lock;
+    rendezvous[i].Arrived = 0;
+    rendezvous[i].TimedOut = 0;
+    }
+  threader->SetSingleMethod(NestedMethod, rendezvous);
+  threader->SingleMethodExecute();
+  for (int i = 1; i <= NUMBER_OF_THREADS; ++i)
+    {
+    if (rendezvous[i].TimedOut ||
+        rendezvous[i].Arrived != NUMBER_OF_THREADS)
+      {
+      cerr << "The methods of a nested execute did not run concurrently"
+           << endl;
+      retVal = 1;
+      break;
+      }
+    }
+
+  data.Lock->Delete();
+  return retVal;
+}
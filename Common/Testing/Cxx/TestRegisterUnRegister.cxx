@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRegisterUnRegister.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that Register/UnRegister and vtkTimeStamp::Modified are safe to
+// call from many threads at once, and reports the Register/UnRegister
+// throughput for 1 to 64 threads.
+
+#include "vtkAtomicOperations.h"
+#include "vtkIntArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
+#include "vtkTimerLog.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
+#define REGISTER_PER_THREAD 20000
+#define MODIFIED_PER_THREAD 2000
+
+struct RegisterTestData
+{
+  vtkObjectBase *Object;
+  unsigned long *Times;
+};
+
+static VTK_THREAD_RETURN_TYPE RegisterMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  RegisterTestData *data = static_cast<RegisterTestData *>(info->UserData);
+  vtkObjectBase *object = data->Object;
+  for (int i = 0; i < REGISTER_PER_THREAD; ++i)
+    {
+    object->Register(0);
+    object->Register(0);
+    object->UnRegister(0);
+    object->UnRegister(0);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+static VTK_THREAD_RETURN_TYPE ModifiedMethod(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  RegisterTestData *data = static_cast<RegisterTestData *>(info->UserData);
+  unsigned long *times = data->Times + info->ThreadID * MODIFIED_PER_THREAD;
+  vtkTimeStamp stamp;
+  for (int i = 0; i < MODIFIED_PER_THREAD; ++i)
+    {
+    stamp.Modified();
+    times[i] = stamp.GetMTime();
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+int TestRegisterUnRegister(int, char *[])
+{
+  int retVal = 0;
+  cout << "Atomic operations: " << vtkAtomicOperations::GetImplementation()
+       << endl;
+
+  vtkIntArray *array = vtkIntArray::New();
+  RegisterTestData data;
+  data.Object = array;
+
+  vtkSmartPointer<vtkMultiThreader> threader =
+    vtkSmartPointer<vtkMultiThreader>::New();
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  for (int n = 1; n <= 64 && n <= VTK_MAX_THREADS; n *= 2)
+    {
+    threader->SetNumberOfThreads(n);
+    threader->SetSingleMethod(RegisterMethod, &data);
+    timer->StartTimer();
+    threader->SingleMethodExecute();
+    timer->StopTimer();
+
+    double ops = 4.0 * REGISTER_PER_THREAD * n;
+    double elapsed = timer->GetElapsedTime();
+    cout << n << " threads: " << ops << " Register/UnRegister in "
+         << elapsed << " s";
+    if (elapsed > 0.0)
+      {
+      cout << " (" << ops / elapsed / 1.0e6 << " M/s)";
+      }
+    cout << endl;
+
+    if (array->GetReferenceCount() != 1)
+      {
+      cerr << "Wrong reference count " << array->GetReferenceCount()
+           << " after " << n << " threads" << endl;
+      retVal = 1;
+      break;
+      }
+    }
+  array->Delete();
+
+  // Time stamps taken concurrently must all be different.
+  int numThreads = VTK_MAX_THREADS < 16 ? VTK_MAX_THREADS : 16;
+  vtkstd::vector<unsigned long> times(numThreads * MODIFIED_PER_THREAD);
+  data.Times = &times[0];
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(ModifiedMethod, &data);
+  threader->SingleMethodExecute();
+  vtkstd::sort(times.begin(), times.end());
+  if (vtkstd::adjacent_find(times.begin(), times.end()) != times.end())
+    {
+    cerr << "Concurrent calls to vtkTimeStamp::Modified gave the same time"
+         << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
@@ -0,0 +1,224 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+#define TEST_SIZE 100003
+
+// Fill an array in parallel.
+class FillFunctor
+{
+public:
+  FillFunctor(vtkIdType *array) : Array(array) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->Array[i] = 2*i;
+      }
+    }
+  vtkIdType *Array;
+};
+
+// Parallel sum using thread local partial sums.
+class SumFunctor
+{
+public:
+  SumFunctor(const vtkIdType *array) : Array(array), Total(0),
+                                       NumberOfInitializes(0) {}
+  void Initialize()
+    {
+    this->Partial.Local() = 0;
+    this->Initializes.Local() = 1;
+    }
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType& sum = this->Partial.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      sum += this->Array[i];
+      }
+    }
+  void Reduce()
+    {
+    this->Total = 0;
+    vtkSMPThreadLocal<vtkIdType>::iterator it;
+    for (it = this->Partial.begin(); it != this->Partial.end(); ++it)
+      {
+      this->Total += *it;
+      }
+    this->NumberOfInitializes = 0;
+    vtkSMPThreadLocal<int>::iterator it2;
+    for (it2 = this->Initializes.begin(); it2 != this->Initializes.end(); ++it2)
+      {
+      this->NumberOfInitializes += *it2;
+      }
+    }
+  const vtkIdType *Array;
+  vtkSMPThreadLocal<vtkIdType> Partial;
+  vtkSMPThreadLocal<int> Initializes;
+  vtkIdType Total;
+  int NumberOfInitializes;
+};
+
+// Run a parallel loop from within a parallel loop.
+class NestedFunctor
+{
+public:
+  NestedFunctor(vtkIdType *array) : Array(array) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      FillFunctor fill(this->Array + i*10);
+      vtkSMPTools::For(0, 10, 3, fill);
+      }
+    }
+  vtkIdType *Array;
+};
+
+// Uneven work: the cost of an index grows with the index.
+class UnevenFunctor
+{
+public:
+  UnevenFunctor(vtkIdType *array) : Array(array) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType value = 0;
+      for (vtkIdType j = 0; j < i; ++j)
+        {
+        value += 1 + (j & 1);
+        }
+      this->Array[i] = value;
+      }
+    }
+  vtkIdType *Array;
+};
+
+int TestSMPTools(int, char *[])
+{
+  int retVal = 0;
+  vtkSMPTools::Initialize(4);
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() != 4)
+    {
+    cerr << "Expected 4 threads, got "
+         << vtkSMPTools::GetEstimatedNumberOfThreads() << endl;
+    retVal = 1;
+    }
+
+  std::vector<vtkIdType> array(TEST_SIZE, -1);
+  FillFunctor fill(&array[0]);
+  vtkSMPTools::For(0, TEST_SIZE, fill);
+  for (vtkIdType i = 0; i < TEST_SIZE; ++i)
+    {
+    if (array[i] != 2*i)
+      {
+      cerr << "Wrong value at " << i << ": " << array[i] << endl;
+      retVal = 1;
+      break;
+      }
+    }
+
+  // Use several grain sizes, including one that does not divide the range.
+  vtkIdType grains[4] = { 0, 1, 997, TEST_SIZE };
+  vtkIdType expected = static_cast<vtkIdType>(TEST_SIZE) * (TEST_SIZE - 1);
+  for (int g = 0; g < 4; ++g)
+    {
+    SumFunctor sum(&array[0]);
+    vtkSMPTools::For(0, TEST_SIZE, grains[g], sum);
+    if (sum.Total != expected)
+      {
+      cerr << "Wrong sum with grain " << grains[g] << ": " << sum.Total
+           << " instead of " << expected << endl;
+      retVal = 1;
+      }
+    if (sum.NumberOfInitializes < 1 || sum.NumberOfInitializes > 4)
+      {
+      cerr << "Initialize called " << sum.NumberOfInitializes
+           << " times with grain " << grains[g] << endl;
+      retVal = 1;
+      }
+    }
+
+  // Same reductions with the work stealing schedule.
+  for (int g = 0; g < 4; ++g)
+    {
+    SumFunctor sum(&array[0]);
+    vtkSMPTools::ForWorkStealing(0, TEST_SIZE, grains[g], sum);
+    if (sum.Total != expected)
+      {
+      cerr << "Wrong work stealing sum with grain " << grains[g] << ": "
+           << sum.Total << " instead of " << expected << endl;
+      retVal = 1;
+      }
+    if (sum.NumberOfInitializes < 1 || sum.NumberOfInitializes > 4)
+      {
+      cerr << "Initialize called " << sum.NumberOfInitializes
+           << " times with work stealing and grain " << grains[g] << endl;
+      retVal = 1;
+      }
+    }
+
+  // Every index must be processed exactly once whatever the steals.
+  std::vector<vtkIdType> uneven(3000, -1);
+  UnevenFunctor unevenFunctor(&uneven[0]);
+  vtkSMPTools::ForWorkStealing(0, 3000, 1, unevenFunctor);
+  for (vtkIdType i = 0; i < 3000; ++i)
+    {
+    if (uneven[i] != i + i/2)
+      {
+      cerr << "Wrong uneven value at " << i << ": " << uneven[i] << endl;
+      retVal = 1;
+      break;
+      }
+    }
+
+  // Empty range: nothing must be executed.
+  SumFunctor empty(&array[0]);
+  vtkSMPTools::For(10, 10, empty);
+  if (empty.Total != 0 || empty.Partial.size() != 0)
+    {
+    cerr << "Empty range was executed." << endl;
+    retVal = 1;
+    }
+
+  std::vector<vtkIdType> nested(1000, -1);
+  NestedFunctor nest(&nested[0]);
+  vtkSMPTools::For(0, 100, 1, nest);
+  for (vtkIdType i = 0; i < 1000; ++i)
+    {
+    if (nested[i] != 2*(i % 10))
+      {
+      cerr << "Wrong nested value at " << i << ": " << nested[i] << endl;
+      retVal = 1;
+      break;
+      }
+    }
+
+  // The workers are persistent: they must have been created only once.
+  if (vtkSMPThreadPool::GetGlobalPool()->GetNumberOfWorkers() != 3)
+    {
+    cerr << "Expected 3 pool workers, got "
+         << vtkSMPThreadPool::GetGlobalPool()->GetNumberOfWorkers() << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
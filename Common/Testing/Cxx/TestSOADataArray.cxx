@@ -0,0 +1,221 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSOADataArray.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+
+#include <stdlib.h>
+
+#define NUM_POINTS 100
+
+#define CHECK(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    retVal = 1; \
+    }
+
+static bool TuplesEqual(vtkDataArray *a, vtkIdType i,
+                        vtkDataArray *b, vtkIdType j)
+{
+  for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+    if (a->GetComponent(i, c) != b->GetComponent(j, c))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+int TestSOADataArray(int, char *[])
+{
+  int retVal = 0;
+
+  // Three coordinate buffers, as a solver would hand them to us.
+  float *x = static_cast<float *>(malloc(NUM_POINTS * sizeof(float)));
+  float *y = new float[NUM_POINTS];
+  float z[NUM_POINTS];
+  for (int i = 0; i < NUM_POINTS; ++i)
+    {
+    x[i] = static_cast<float>(i);
+    y[i] = static_cast<float>(2*i);
+    z[i] = static_cast<float>(-i);
+    }
+
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > soa =
+    vtkSmartPointer<vtkSOADataArrayTemplate<float> >::New();
+  soa->SetNumberOfComponents(3);
+  soa->SetArray(0, x, NUM_POINTS, 0);
+  soa->SetArray(1, y, NUM_POINTS, 0,
+                vtkSOADataArrayTemplate<float>::VTK_DATA_ARRAY_DELETE);
+  soa->SetArray(2, z, NUM_POINTS, 1);
+
+  CHECK(soa->GetNumberOfTuples() == NUM_POINTS, "wrong number of tuples");
+  CHECK(soa->GetDataType() == VTK_FLOAT, "wrong data type");
+  CHECK(!soa->HasStandardMemoryLayout(), "layout reported as standard");
+  CHECK(vtkDataArray::SafeDownCast(soa) == soa.GetPointer(),
+        "SafeDownCast to vtkDataArray failed");
+  CHECK(vtkSOADataArrayTemplate<float>::SafeDownCast(soa) == soa.GetPointer(),
+        "SafeDownCast to vtkSOADataArrayTemplate failed");
+  CHECK(soa->GetComponentArrayPointer(1) == y, "buffer was copied");
+
+  // The buffers are used in place.
+  z[7] = 42.0f;
+  CHECK(soa->GetComponent(7, 2) == 42.0, "buffer is not shared");
+  z[7] = -7.0f;
+
+  double *t = soa->GetTuple(10);
+  CHECK(t[0] == 10.0 && t[1] == 20.0 && t[2] == -10.0, "wrong GetTuple");
+  CHECK(soa->GetValue(30) == 10.0f && soa->GetVariantValue(31).ToFloat() == 20.0f,
+        "wrong interleaved value");
+
+  // Interleaved read only view.
+  float *aos = static_cast<float *>(soa->GetVoidPointer(0));
+  CHECK(aos[3*5] == 5.0f && aos[3*5+1] == 10.0f && aos[3*5+2] == -5.0f,
+        "wrong interleaved copy");
+
+  // The copy is kept until the values change.
+  CHECK(soa->GetVoidPointer(0) == aos && aos[3*5] == 5.0f,
+        "interleaved copy not kept");
+  soa->SetComponent(5, 0, 6.0);
+  aos = static_cast<float *>(soa->GetVoidPointer(0));
+  CHECK(aos[3*5] == 6.0f, "interleaved copy not updated by SetComponent");
+  x[5] = 7.0f;
+  soa->DataChanged();
+  aos = static_cast<float *>(soa->GetVoidPointer(0));
+  CHECK(aos[3*5] == 7.0f, "interleaved copy not updated by DataChanged");
+  x[5] = 5.0f;
+  soa->Modified();
+  aos = static_cast<float *>(soa->GetVoidPointer(0));
+  CHECK(aos[3*5] == 5.0f, "interleaved copy not updated by Modified");
+
+  // Use the array as the points of a data set.
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetData(soa);
+  double p[3];
+  points->GetPoint(20, p);
+  CHECK(p[0] == 20.0 && p[1] == 40.0 && p[2] == -20.0, "wrong point");
+  double *bounds = points->GetBounds();
+  CHECK(bounds[0] == 0.0 && bounds[1] == NUM_POINTS - 1 &&
+        bounds[2] == 0.0 && bounds[3] == 2*(NUM_POINTS - 1) &&
+        bounds[4] == -(NUM_POINTS - 1) && bounds[5] == 0.0,
+        "wrong bounds");
+
+  vtkSmartPointer<vtkPoints> copy = vtkSmartPointer<vtkPoints>::New();
+  copy->DeepCopy(points);
+  CHECK(copy->GetData()->HasStandardMemoryLayout(),
+        "deep copy changed the array type");
+  CHECK(copy->GetNumberOfPoints() == NUM_POINTS, "wrong deep copy size");
+  bool same = true;
+  for (vtkIdType i = 0; i < NUM_POINTS; ++i)
+    {
+    same = same && TuplesEqual(copy->GetData(), i, soa, i);
+    }
+  CHECK(same, "wrong deep copy of the points");
+
+  // Copy tuples between the two layouts.
+  vtkSmartPointer<vtkFloatArray> aosArray =
+    vtkSmartPointer<vtkFloatArray>::New();
+  aosArray->SetNumberOfComponents(3);
+  aosArray->InsertNextTuple(3, soa);
+  aosArray->InsertTuple(1, 4, soa);
+  CHECK(aosArray->GetNumberOfTuples() == 2 &&
+        TuplesEqual(aosArray, 0, soa, 3) && TuplesEqual(aosArray, 1, soa, 4),
+        "wrong copy from vtkSOADataArrayTemplate to vtkFloatArray");
+
+  vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+  ids->InsertNextId(9);
+  ids->InsertNextId(2);
+  vtkSmartPointer<vtkFloatArray> gathered =
+    vtkSmartPointer<vtkFloatArray>::New();
+  gathered->SetNumberOfComponents(3);
+  gathered->SetNumberOfTuples(2);
+  soa->GetTuples(ids, gathered);
+  CHECK(TuplesEqual(gathered, 0, soa, 9) && TuplesEqual(gathered, 1, soa, 2),
+        "wrong GetTuples");
+
+  double weights[2] = { 0.5, 0.5 };
+  aosArray->InterpolateTuple(2, ids, soa, weights);
+  CHECK(aosArray->GetComponent(2, 0) == 5.5 &&
+        aosArray->GetComponent(2, 1) == 11.0,
+        "wrong interpolation from vtkSOADataArrayTemplate");
+
+  // Growing reallocates the user buffers; the data must be kept.
+  soa->InsertNextTuple(0, aosArray);
+  CHECK(soa->GetNumberOfTuples() == NUM_POINTS + 1 &&
+        TuplesEqual(soa, NUM_POINTS, aosArray, 0) &&
+        soa->GetComponent(NUM_POINTS - 1, 2) == -(NUM_POINTS - 1),
+        "wrong insertion");
+  CHECK(soa->GetComponentArrayPointer(2) != z, "saved buffer was reused");
+
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > soa2 =
+    vtkSmartPointer<vtkSOADataArrayTemplate<float> >::New();
+  soa2->DeepCopy(aosArray);
+  soa2->InterpolateTuple(3, 0, soa2, 1, aosArray, 0.5);
+  CHECK(soa2->GetNumberOfTuples() == 4 && TuplesEqual(soa2, 1, aosArray, 1) &&
+        soa2->GetComponent(3, 2) == -3.5,
+        "wrong deep copy or interpolation to vtkSOADataArrayTemplate");
+
+  soa2->RemoveTuple(0);
+  CHECK(soa2->GetNumberOfTuples() == 3 && TuplesEqual(soa2, 0, aosArray, 1),
+        "wrong RemoveTuple");
+  CHECK(soa2->LookupValue(vtkVariant(8.0f)) == 1, "wrong LookupValue");
+
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > soa3 =
+    vtkSmartPointer<vtkSOADataArrayTemplate<float> >::New();
+  soa3->DeepCopy(soa);
+  CHECK(soa3->GetNumberOfTuples() == soa->GetNumberOfTuples() &&
+        TuplesEqual(soa3, 50, soa, 50) &&
+        soa3->GetComponentArrayPointer(0) != soa->GetComponentArrayPointer(0),
+        "wrong deep copy between vtkSOADataArrayTemplate");
+
+  // Adopting all the buffers at once allocates nothing.
+  float u[NUM_POINTS], v[NUM_POINTS], w[NUM_POINTS];
+  for (int i = 0; i < NUM_POINTS; ++i)
+    {
+    u[i] = static_cast<float>(i);
+    v[i] = static_cast<float>(2*i);
+    w[i] = static_cast<float>(3*i);
+    }
+  float *uvw[3] = { u, v, w };
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > soa4 =
+    vtkSmartPointer<vtkSOADataArrayTemplate<float> >::New();
+  soa4->SetNumberOfComponents(3);
+  soa4->SetArrays(uvw, NUM_POINTS, 1);
+  CHECK(soa4->GetNumberOfTuples() == NUM_POINTS &&
+        soa4->GetComponentArrayPointer(0) == u &&
+        soa4->GetComponentArrayPointer(1) == v &&
+        soa4->GetComponentArrayPointer(2) == w &&
+        soa4->GetComponent(12, 1) == 24.0,
+        "wrong SetArrays");
+
+  // A single component array is a regular contiguous array.
+  vtkSmartPointer<vtkSOADataArrayTemplate<int> > scalars =
+    vtkSmartPointer<vtkSOADataArrayTemplate<int> >::New();
+  int *values = static_cast<int *>(scalars->WriteVoidPointer(0, 10));
+  for (int i = 0; i < 10; ++i)
+    {
+    values[i] = i * i;
+    }
+  CHECK(scalars->HasStandardMemoryLayout() &&
+        scalars->GetNumberOfTuples() == 10 &&
+        scalars->GetComponent(9, 0) == 81.0,
+        "wrong single component array");
+
+  return retVal;
+}
@@ -158,6 +158,14 @@ public:
   // special pointer manipulation.
   virtual void *GetVoidPointer(vtkIdType id) = 0;
 
+  // Description:
+  // Return 1 if the values are stored contiguously, tuple after tuple,
+  // so that the pointer returned by GetVoidPointer() and
+  // WriteVoidPointer() gives direct access to the data.  Arrays using
+  // another layout (see vtkSOADataArrayTemplate) return 0; code that
+  // accesses the memory directly must then use the tuple API instead.
+  virtual int HasStandardMemoryLayout() { return 1; }
+
   // Description:
   // Deep copy of data. Implementation left to subclasses, which
   // should support as many type conversions as possible given the
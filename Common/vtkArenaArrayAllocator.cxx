@@ -0,0 +1,282 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArenaArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArenaArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+vtkStandardNewMacro(vtkArenaArrayAllocator);
+
+// The allocations are aligned on cache lines.
+#define VTK_ARENA_ALIGNMENT 64
+
+//----------------------------------------------------------------------------
+struct vtkArenaArrayAllocatorBlock
+{
+  void *Raw;     // as returned by malloc()
+  char *Data;    // Raw aligned
+  size_t Size;
+  size_t Top;    // offset of the first free byte
+};
+
+class vtkArenaArrayAllocatorInternals
+{
+public:
+  vtkArenaArrayAllocatorInternals() : Current(0), Live(0), Rewinds(0) {}
+
+  // Return the index of the block containing ptr, or -1.
+  int FindBlock(void *ptr)
+    {
+    char *p = static_cast<char *>(ptr);
+    for (size_t i = 0; i < this->Blocks.size(); ++i)
+      {
+      if (p >= this->Blocks[i].Data &&
+          p < this->Blocks[i].Data + this->Blocks[i].Size)
+        {
+        return static_cast<int>(i);
+        }
+      }
+    return -1;
+    }
+
+  vtkSimpleCriticalSection Lock;
+  std::vector<vtkArenaArrayAllocatorBlock> Blocks;
+  size_t Current;
+  vtkIdType Live;
+  vtkIdType Rewinds;
+};
+
+//----------------------------------------------------------------------------
+static inline size_t vtkArenaArrayAllocatorAlign(size_t size)
+{
+  size = (size > 0 ? size : 1);
+  return (size + VTK_ARENA_ALIGNMENT - 1) &
+    ~static_cast<size_t>(VTK_ARENA_ALIGNMENT - 1);
+}
+
+//----------------------------------------------------------------------------
+vtkArenaArrayAllocator::vtkArenaArrayAllocator()
+{
+  this->BlockSize = 1 << 20;
+  this->Internals = new vtkArenaArrayAllocatorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkArenaArrayAllocator::~vtkArenaArrayAllocator()
+{
+  // The arrays keep a reference to their allocator, so none is left.
+  for (size_t i = 0; i < this->Internals->Blocks.size(); ++i)
+    {
+    free(this->Internals->Blocks[i].Raw);
+    }
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void *vtkArenaArrayAllocator::AllocateMemory(size_t size)
+{
+  size_t alignedSize = vtkArenaArrayAllocatorAlign(size);
+  if (alignedSize > static_cast<size_t>(this->BlockSize / 2))
+    {
+    return malloc(size > 0 ? size : 1);
+    }
+
+  vtkArenaArrayAllocatorInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  // Blocks after the current one are empty: the arena rewound.
+  while (internals->Current < internals->Blocks.size())
+    {
+    vtkArenaArrayAllocatorBlock &block = internals->Blocks[internals->Current];
+    if (block.Top + alignedSize <= block.Size)
+      {
+      void *ptr = block.Data + block.Top;
+      block.Top += alignedSize;
+      ++internals->Live;
+      internals->Lock.Unlock();
+      return ptr;
+      }
+    ++internals->Current;
+    }
+
+  vtkArenaArrayAllocatorBlock block;
+  block.Size = static_cast<size_t>(this->BlockSize) &
+    ~static_cast<size_t>(VTK_ARENA_ALIGNMENT - 1);
+  block.Raw = malloc(block.Size + VTK_ARENA_ALIGNMENT - 1);
+  if (!block.Raw)
+    {
+    internals->Lock.Unlock();
+    return 0;
+    }
+  size_t address = reinterpret_cast<size_t>(block.Raw);
+  block.Data = static_cast<char *>(block.Raw) +
+    (vtkArenaArrayAllocatorAlign(address) - address);
+  block.Top = alignedSize;
+  internals->Blocks.push_back(block);
+  internals->Current = internals->Blocks.size() - 1;
+  ++internals->Live;
+  internals->Lock.Unlock();
+  return block.Data;
+}
+
+//----------------------------------------------------------------------------
+void *vtkArenaArrayAllocator::ReallocateMemory(void *ptr, size_t oldSize,
+                                               size_t newSize)
+{
+  vtkArenaArrayAllocatorInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  int index = internals->FindBlock(ptr);
+  if (index < 0)
+    {
+    internals->Lock.Unlock();
+    if (vtkArenaArrayAllocatorAlign(newSize) >
+        static_cast<size_t>(this->BlockSize / 2))
+      {
+      return realloc(ptr, newSize > 0 ? newSize : 1);
+      }
+    }
+  else
+    {
+    // Grow or shrink the last allocation of the block in place.
+    vtkArenaArrayAllocatorBlock &block = internals->Blocks[index];
+    size_t offset = static_cast<char *>(ptr) - block.Data;
+    size_t alignedOld = vtkArenaArrayAllocatorAlign(oldSize);
+    size_t alignedNew = vtkArenaArrayAllocatorAlign(newSize);
+    if (offset + alignedOld == block.Top && offset + alignedNew <= block.Size)
+      {
+      block.Top = offset + alignedNew;
+      internals->Lock.Unlock();
+      return ptr;
+      }
+    internals->Lock.Unlock();
+    if (alignedNew <= alignedOld)
+      {
+      return ptr;
+      }
+    }
+
+  void *newPtr = this->AllocateMemory(newSize);
+  if (newPtr)
+    {
+    memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+    this->FreeMemory(ptr, oldSize);
+    }
+  return newPtr;
+}
+
+//----------------------------------------------------------------------------
+void vtkArenaArrayAllocator::FreeMemory(void *ptr, size_t size)
+{
+  vtkArenaArrayAllocatorInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  int index = internals->FindBlock(ptr);
+  if (index < 0)
+    {
+    internals->Lock.Unlock();
+    free(ptr);
+    return;
+    }
+
+  vtkArenaArrayAllocatorBlock &block = internals->Blocks[index];
+  size_t offset = static_cast<char *>(ptr) - block.Data;
+  if (offset + vtkArenaArrayAllocatorAlign(size) == block.Top)
+    {
+    block.Top = offset;
+    }
+  if (--internals->Live == 0)
+    {
+    for (size_t i = 0; i < internals->Blocks.size(); ++i)
+      {
+      internals->Blocks[i].Top = 0;
+      }
+    internals->Current = 0;
+    ++internals->Rewinds;
+    }
+  internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkArenaArrayAllocator::Release()
+{
+  vtkArenaArrayAllocatorInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  if (internals->Live > 0)
+    {
+    internals->Lock.Unlock();
+    return 0;
+    }
+  for (size_t i = 0; i < internals->Blocks.size(); ++i)
+    {
+    free(internals->Blocks[i].Raw);
+    }
+  internals->Blocks.clear();
+  internals->Current = 0;
+  internals->Lock.Unlock();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkArenaArrayAllocator::GetNumberOfBlocks()
+{
+  this->Internals->Lock.Lock();
+  int count = static_cast<int>(this->Internals->Blocks.size());
+  this->Internals->Lock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkArenaArrayAllocator::GetArenaSize()
+{
+  vtkTypeUInt64 size = 0;
+  this->Internals->Lock.Lock();
+  for (size_t i = 0; i < this->Internals->Blocks.size(); ++i)
+    {
+    size += this->Internals->Blocks[i].Size;
+    }
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkArenaArrayAllocator::GetNumberOfLiveAllocations()
+{
+  this->Internals->Lock.Lock();
+  vtkIdType count = this->Internals->Live;
+  this->Internals->Lock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkArenaArrayAllocator::GetNumberOfRewinds()
+{
+  this->Internals->Lock.Lock();
+  vtkIdType count = this->Internals->Rewinds;
+  this->Internals->Lock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkArenaArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Block Size: " << this->BlockSize << "\n";
+  os << indent << "Number Of Blocks: " << this->GetNumberOfBlocks() << "\n";
+  os << indent << "Arena Size: " << this->GetArenaSize() << "\n";
+  os << indent << "Number Of Live Allocations: "
+     << this->GetNumberOfLiveAllocations() << "\n";
+  os << indent << "Number Of Rewinds: " << this->GetNumberOfRewinds() << "\n";
+}
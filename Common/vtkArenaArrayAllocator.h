@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArenaArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkArenaArrayAllocator - array allocator carving memory out of large blocks
+// .SECTION Description
+// vtkArenaArrayAllocator serves the allocations of the arrays from a few
+// large blocks, moving a pointer forward in the current block.  Freeing
+// or growing the most recent allocation of a block is done in place, so
+// that an array grown one value at a time by InsertNextValue() is not
+// copied.  Other freed memory is only reused once every allocation of
+// the arena was freed: the arena then rewinds to the start of its first
+// block, keeping the blocks for the next use.  Requests larger than half
+// a block are passed to malloc().
+//
+// Used as the default allocator (see vtkArrayAllocator) while a filter
+// executes, the temporary arrays of the execution cost a few block
+// allocations instead of one malloc() per array and per reallocation,
+// and the arena rewinds by itself at the end of the execution when those
+// arrays are deleted.  Release() returns the blocks to the system.
+// .SECTION See Also
+// vtkArrayAllocator vtkHugePageArrayAllocator
+
+#ifndef __vtkArenaArrayAllocator_h
+#define __vtkArenaArrayAllocator_h
+
+#include "vtkArrayAllocator.h"
+
+class vtkArenaArrayAllocatorInternals;
+
+class VTK_COMMON_EXPORT vtkArenaArrayAllocator : public vtkArrayAllocator
+{
+public:
+  static vtkArenaArrayAllocator *New();
+  vtkTypeMacro(vtkArenaArrayAllocator,vtkArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the size in bytes of the blocks allocated by the arena.  The
+  // default is 1 MiB.  Only affects the blocks allocated afterwards.
+  vtkSetClampMacro(BlockSize,vtkIdType,4096,VTK_LARGE_ID);
+  vtkGetMacro(BlockSize,vtkIdType);
+
+  // Description:
+  // Return the number of blocks of the arena and their total size in
+  // bytes.
+  int GetNumberOfBlocks();
+  vtkTypeUInt64 GetArenaSize();
+
+  // Description:
+  // Return the number of allocations made in the blocks and not freed
+  // yet, and the number of times the arena rewound because all were
+  // freed.
+  vtkIdType GetNumberOfLiveAllocations();
+  vtkIdType GetNumberOfRewinds();
+
+  // Description:
+  // Return the blocks to the system.  Returns 0 and does nothing if
+  // allocations of the arena are still in use.
+  int Release();
+
+protected:
+  vtkArenaArrayAllocator();
+  ~vtkArenaArrayAllocator();
+
+  virtual void *AllocateMemory(size_t size);
+  virtual void *ReallocateMemory(void *ptr, size_t oldSize, size_t newSize);
+  virtual void FreeMemory(void *ptr, size_t size);
+
+  vtkIdType BlockSize;
+  vtkArenaArrayAllocatorInternals *Internals;
+
+private:
+  vtkArenaArrayAllocator(const vtkArenaArrayAllocator&);  // Not implemented.
+  void operator=(const vtkArenaArrayAllocator&);  // Not implemented.
+};
+
+#endif
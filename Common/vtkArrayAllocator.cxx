@@ -0,0 +1,219 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+vtkStandardNewMacro(vtkArrayAllocator);
+
+vtkArrayAllocator *vtkArrayAllocator::DefaultAllocator = 0;
+
+//----------------------------------------------------------------------------
+vtkArrayAllocator::vtkArrayAllocator()
+{
+  this->NumberOfAllocations = 0;
+  this->NumberOfReallocations = 0;
+  this->NumberOfFrees = 0;
+  this->BytesInUse = 0;
+  this->PeakBytesInUse = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkArrayAllocator::~vtkArrayAllocator()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::SetDefaultAllocator(vtkArrayAllocator *allocator)
+{
+  if (allocator == vtkArrayAllocator::DefaultAllocator)
+    {
+    return;
+    }
+  if (allocator)
+    {
+    allocator->Register(0);
+    }
+  if (vtkArrayAllocator::DefaultAllocator)
+    {
+    vtkArrayAllocator::DefaultAllocator->UnRegister(0);
+    }
+  vtkArrayAllocator::DefaultAllocator = allocator;
+}
+
+//----------------------------------------------------------------------------
+vtkArrayAllocator *vtkArrayAllocator::GetDefaultAllocator()
+{
+  return vtkArrayAllocator::DefaultAllocator;
+}
+
+//----------------------------------------------------------------------------
+void *vtkArrayAllocator::Allocate(size_t size)
+{
+  void *ptr = this->AllocateMemory(size);
+  if (ptr)
+    {
+    this->CountersLock.Lock();
+    ++this->NumberOfAllocations;
+    this->BytesInUse += size;
+    if (this->BytesInUse > this->PeakBytesInUse)
+      {
+      this->PeakBytesInUse = this->BytesInUse;
+      }
+    this->CountersLock.Unlock();
+    }
+  return ptr;
+}
+
+//----------------------------------------------------------------------------
+void *vtkArrayAllocator::Reallocate(void *ptr, size_t oldSize, size_t newSize)
+{
+  if (!ptr)
+    {
+    return this->Allocate(newSize);
+    }
+  void *newPtr = this->ReallocateMemory(ptr, oldSize, newSize);
+  if (newPtr)
+    {
+    this->CountersLock.Lock();
+    ++this->NumberOfReallocations;
+    this->BytesInUse += newSize;
+    this->BytesInUse -= oldSize;
+    if (this->BytesInUse > this->PeakBytesInUse)
+      {
+      this->PeakBytesInUse = this->BytesInUse;
+      }
+    this->CountersLock.Unlock();
+    }
+  return newPtr;
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::Free(void *ptr, size_t size)
+{
+  if (!ptr)
+    {
+    return;
+    }
+  this->FreeMemory(ptr, size);
+  this->CountersLock.Lock();
+  ++this->NumberOfFrees;
+  this->BytesInUse -= size;
+  this->CountersLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void *vtkArrayAllocator::AllocateMemory(size_t size)
+{
+  return malloc(size > 0 ? size : 1);
+}
+
+//----------------------------------------------------------------------------
+void *vtkArrayAllocator::ReallocateMemory(void *ptr, size_t oldSize,
+                                          size_t newSize)
+{
+#if defined(__APPLE__)
+  // As in vtkDataArrayTemplate: OS X's realloc does not free memory if the
+  // new block is smaller.
+  void *newPtr = malloc(newSize > 0 ? newSize : 1);
+  if (newPtr)
+    {
+    memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+    free(ptr);
+    }
+  return newPtr;
+#else
+  (void)oldSize;
+  return realloc(ptr, newSize > 0 ? newSize : 1);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::FreeMemory(void *ptr, size_t)
+{
+  free(ptr);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkArrayAllocator::GetNumberOfAllocations()
+{
+  this->CountersLock.Lock();
+  vtkTypeUInt64 count = this->NumberOfAllocations;
+  this->CountersLock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkArrayAllocator::GetNumberOfReallocations()
+{
+  this->CountersLock.Lock();
+  vtkTypeUInt64 count = this->NumberOfReallocations;
+  this->CountersLock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkArrayAllocator::GetNumberOfFrees()
+{
+  this->CountersLock.Lock();
+  vtkTypeUInt64 count = this->NumberOfFrees;
+  this->CountersLock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkArrayAllocator::GetBytesInUse()
+{
+  this->CountersLock.Lock();
+  vtkTypeUInt64 bytes = this->BytesInUse;
+  this->CountersLock.Unlock();
+  return bytes;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkArrayAllocator::GetPeakBytesInUse()
+{
+  this->CountersLock.Lock();
+  vtkTypeUInt64 bytes = this->PeakBytesInUse;
+  this->CountersLock.Unlock();
+  return bytes;
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::ResetCounters()
+{
+  this->CountersLock.Lock();
+  this->NumberOfAllocations = 0;
+  this->NumberOfReallocations = 0;
+  this->NumberOfFrees = 0;
+  this->PeakBytesInUse = this->BytesInUse;
+  this->CountersLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Number Of Allocations: "
+     << this->GetNumberOfAllocations() << "\n";
+  os << indent << "Number Of Reallocations: "
+     << this->GetNumberOfReallocations() << "\n";
+  os << indent << "Number Of Frees: " << this->GetNumberOfFrees() << "\n";
+  os << indent << "Bytes In Use: " << this->GetBytesInUse() << "\n";
+  os << indent << "Peak Bytes In Use: " << this->GetPeakBytesInUse() << "\n";
+}
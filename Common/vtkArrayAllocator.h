@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkArrayAllocator - memory allocator for the data arrays and id lists
+// .SECTION Description
+// vtkArrayAllocator provides the memory of vtkDataArrayTemplate and
+// vtkIdList objects that were given one with SetAllocator(), or that were
+// created while it was the default allocator.  This class allocates with
+// malloc(), realloc() and free() like the arrays without an allocator, and
+// counts the allocations, reallocations and frees and the bytes in use,
+// so that installing it as the default allocator measures the allocations
+// done by a filter:
+//
+// \code
+// vtkArrayAllocator *counter = vtkArrayAllocator::New();
+// vtkArrayAllocator::SetDefaultAllocator(counter);
+// cutter->Update();
+// vtkArrayAllocator::SetDefaultAllocator(NULL);
+// cout << counter->GetNumberOfAllocations() << endl;
+// \endcode
+//
+// Subclasses obtain the memory elsewhere by overriding AllocateMemory(),
+// ReallocateMemory() and FreeMemory(); the public methods keep the
+// counts.  All the methods may be called from several threads at once.
+//
+// An array frees its memory with the allocator that provided it, which
+// it keeps a reference to, so changing the default allocator while
+// arrays exist is safe.  Changing it while other threads create arrays
+// is not.
+// .SECTION See Also
+// vtkArenaArrayAllocator vtkHugePageArrayAllocator vtkDataArrayTemplate
+// vtkIdList
+
+#ifndef __vtkArrayAllocator_h
+#define __vtkArrayAllocator_h
+
+#include "vtkObject.h"
+#include "vtkCriticalSection.h" // For the counters
+
+class VTK_COMMON_EXPORT vtkArrayAllocator : public vtkObject
+{
+public:
+  static vtkArrayAllocator *New();
+  vtkTypeMacro(vtkArrayAllocator,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Allocate size bytes, resize the block ptr of oldSize bytes to newSize
+  // bytes keeping its content, or release the block ptr of size bytes.
+  // Allocate() and Reallocate() return NULL when out of memory.
+  // Reallocate() with a NULL ptr allocates.
+  void *Allocate(size_t size);
+  void *Reallocate(void *ptr, size_t oldSize, size_t newSize);
+  void Free(void *ptr, size_t size);
+
+  // Description:
+  // Return the number of calls to Allocate(), Reallocate() and Free()
+  // since the allocator was created or ResetCounters() was called.
+  vtkTypeUInt64 GetNumberOfAllocations();
+  vtkTypeUInt64 GetNumberOfReallocations();
+  vtkTypeUInt64 GetNumberOfFrees();
+
+  // Description:
+  // Return the number of bytes allocated and not freed yet, and the
+  // largest it was since the allocator was created or ResetCounters()
+  // was called.
+  vtkTypeUInt64 GetBytesInUse();
+  vtkTypeUInt64 GetPeakBytesInUse();
+
+  // Description:
+  // Set the numbers of calls and the peak to zero.
+  void ResetCounters();
+
+  // Description:
+  // Set the allocator given to the data arrays and the id lists when they
+  // are created.  NULL, the default, uses malloc() and free() directly.
+  static void SetDefaultAllocator(vtkArrayAllocator *allocator);
+  static vtkArrayAllocator *GetDefaultAllocator();
+
+protected:
+  vtkArrayAllocator();
+  ~vtkArrayAllocator();
+
+  // Description:
+  // Obtain and release the memory.  The default implementation uses
+  // malloc(), realloc() and free().
+  virtual void *AllocateMemory(size_t size);
+  virtual void *ReallocateMemory(void *ptr, size_t oldSize, size_t newSize);
+  virtual void FreeMemory(void *ptr, size_t size);
+
+  vtkSimpleCriticalSection CountersLock;
+  vtkTypeUInt64 NumberOfAllocations;
+  vtkTypeUInt64 NumberOfReallocations;
+  vtkTypeUInt64 NumberOfFrees;
+  vtkTypeUInt64 BytesInUse;
+  vtkTypeUInt64 PeakBytesInUse;
+
+  static vtkArrayAllocator *DefaultAllocator;
+
+private:
+  vtkArrayAllocator(const vtkArrayAllocator&);  // Not implemented.
+  void operator=(const vtkArrayAllocator&);  // Not implemented.
+};
+
+#endif
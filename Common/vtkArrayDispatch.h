@@ -0,0 +1,314 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayDispatch.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkArrayDispatch - call a functor with typed pointers to the values of data arrays
+// .SECTION Description
+// vtkArrayDispatch replaces the switch statements written with
+// vtkTemplateMacro.  It finds the value type of one or two data arrays
+// and calls a functor with pointers of that type to their values:
+//
+// \code
+// struct ScaleWorker
+// {
+//   double Factor;
+//   vtkIdType NumberOfValues;
+//   template <class T> void operator()(T* values)
+//     {
+//     for (vtkIdType i = 0; i < this->NumberOfValues; ++i)
+//       {
+//       values[i] = static_cast<T>(values[i] * this->Factor);
+//       }
+//     }
+// };
+//
+// ScaleWorker worker = { 2.0, n };
+// if (!vtkArrayDispatch<vtkArrayDispatchRealTypes>::Execute(array, worker))
+//   {
+//   // Use the vtkDataArray API.
+//   }
+// \endcode
+//
+// The types tried are given by a type list, vtkArrayDispatchAllTypes by
+// default: the functor is only instantiated for the types of the list,
+// so that restricting the list to the types a filter actually meets
+// (vtkArrayDispatchRealTypes, vtkArrayDispatchIntegerTypes or a list of
+// one's own) limits the code generated.  Lists are built from VTK type
+// constants:
+//
+// \code
+// typedef vtkArrayDispatchList<VTK_FLOAT,
+//         vtkArrayDispatchList<VTK_UNSIGNED_CHAR> > MyTypes;
+// \endcode
+//
+// vtkArrayDispatch2 does the same for two arrays whose types may differ,
+// instantiating the functor for every pair of types of its two lists,
+// and vtkArrayDispatch2SameType for two arrays of the same type.
+//
+// Execute() returns false, without calling the functor, when an array is
+// not numeric, is a vtkBitArray, does not have the standard memory layout
+// (see vtkDataArray::HasStandardMemoryLayout()) or has a type that is not
+// in the list: the caller then falls back to the generic vtkDataArray API.
+// The pointers point to the first value of the arrays; the functor must
+// stay within the values the arrays hold.
+//
+// The functor is passed by reference, so that it can return results in
+// its members.  As C++98 does not allow local types as template
+// arguments, it must be declared at namespace scope.
+// .SECTION See Also
+// vtkTemplateMacro vtkDataArray
+
+#ifndef __vtkArrayDispatch_h
+#define __vtkArrayDispatch_h
+
+#include "vtkDataArray.h"
+
+// The end of a type list.
+struct vtkArrayDispatchEnd {};
+
+// A type list: the VTK type TypeId followed by the list Tail.
+template <int TypeId, class Tail = vtkArrayDispatchEnd>
+struct vtkArrayDispatchList {};
+
+// The C++ type of the values of the arrays of VTK type TypeId.
+template <int TypeId> struct vtkArrayDispatchValueType;
+#define vtkArrayDispatchValueTypeMacro(typeN, type) \
+  template <> struct vtkArrayDispatchValueType<typeN> { typedef type Type; }
+vtkArrayDispatchValueTypeMacro(VTK_DOUBLE, double);
+vtkArrayDispatchValueTypeMacro(VTK_FLOAT, float);
+#if defined(VTK_TYPE_USE_LONG_LONG)
+vtkArrayDispatchValueTypeMacro(VTK_LONG_LONG, long long);
+vtkArrayDispatchValueTypeMacro(VTK_UNSIGNED_LONG_LONG, unsigned long long);
+#endif
+#if defined(VTK_TYPE_USE___INT64)
+vtkArrayDispatchValueTypeMacro(VTK___INT64, __int64);
+# if defined(VTK_TYPE_CONVERT_UI64_TO_DOUBLE)
+vtkArrayDispatchValueTypeMacro(VTK_UNSIGNED___INT64, unsigned __int64);
+# endif
+#endif
+vtkArrayDispatchValueTypeMacro(VTK_ID_TYPE, vtkIdType);
+vtkArrayDispatchValueTypeMacro(VTK_LONG, long);
+vtkArrayDispatchValueTypeMacro(VTK_UNSIGNED_LONG, unsigned long);
+vtkArrayDispatchValueTypeMacro(VTK_INT, int);
+vtkArrayDispatchValueTypeMacro(VTK_UNSIGNED_INT, unsigned int);
+vtkArrayDispatchValueTypeMacro(VTK_SHORT, short);
+vtkArrayDispatchValueTypeMacro(VTK_UNSIGNED_SHORT, unsigned short);
+vtkArrayDispatchValueTypeMacro(VTK_CHAR, char);
+vtkArrayDispatchValueTypeMacro(VTK_SIGNED_CHAR, signed char);
+vtkArrayDispatchValueTypeMacro(VTK_UNSIGNED_CHAR, unsigned char);
+#undef vtkArrayDispatchValueTypeMacro
+
+// The concatenation of two type lists.
+template <class List1, class List2> struct vtkArrayDispatchAppend;
+template <class List2>
+struct vtkArrayDispatchAppend<vtkArrayDispatchEnd, List2>
+{
+  typedef List2 Result;
+};
+template <int TypeId, class Tail, class List2>
+struct vtkArrayDispatchAppend<vtkArrayDispatchList<TypeId, Tail>, List2>
+{
+  typedef vtkArrayDispatchList<TypeId,
+    typename vtkArrayDispatchAppend<Tail, List2>::Result> Result;
+};
+
+// The predefined type lists, in the order of vtkTemplateMacro.
+typedef vtkArrayDispatchList<VTK_DOUBLE,
+        vtkArrayDispatchList<VTK_FLOAT> > vtkArrayDispatchRealTypes;
+
+#if defined(VTK_TYPE_USE_LONG_LONG)
+typedef vtkArrayDispatchList<VTK_LONG_LONG,
+        vtkArrayDispatchList<VTK_UNSIGNED_LONG_LONG> >
+  vtkArrayDispatchLongLongTypes;
+#else
+typedef vtkArrayDispatchEnd vtkArrayDispatchLongLongTypes;
+#endif
+#if defined(VTK_TYPE_USE___INT64) && defined(VTK_TYPE_CONVERT_UI64_TO_DOUBLE)
+typedef vtkArrayDispatchList<VTK___INT64,
+        vtkArrayDispatchList<VTK_UNSIGNED___INT64> > vtkArrayDispatchInt64Types;
+#elif defined(VTK_TYPE_USE___INT64)
+typedef vtkArrayDispatchList<VTK___INT64> vtkArrayDispatchInt64Types;
+#else
+typedef vtkArrayDispatchEnd vtkArrayDispatchInt64Types;
+#endif
+
+typedef vtkArrayDispatchAppend<
+  vtkArrayDispatchAppend<vtkArrayDispatchLongLongTypes,
+                         vtkArrayDispatchInt64Types>::Result,
+  vtkArrayDispatchList<VTK_ID_TYPE,
+  vtkArrayDispatchList<VTK_LONG,
+  vtkArrayDispatchList<VTK_UNSIGNED_LONG,
+  vtkArrayDispatchList<VTK_INT,
+  vtkArrayDispatchList<VTK_UNSIGNED_INT,
+  vtkArrayDispatchList<VTK_SHORT,
+  vtkArrayDispatchList<VTK_UNSIGNED_SHORT,
+  vtkArrayDispatchList<VTK_CHAR,
+  vtkArrayDispatchList<VTK_SIGNED_CHAR,
+  vtkArrayDispatchList<VTK_UNSIGNED_CHAR> > > > > > > > > >
+  >::Result vtkArrayDispatchIntegerTypes;
+
+typedef vtkArrayDispatchAppend<vtkArrayDispatchRealTypes,
+                               vtkArrayDispatchIntegerTypes>::Result
+  vtkArrayDispatchAllTypes;
+
+//BTX
+// Find the type of a pointer to values in a type list.  Execute() returns
+// false if the type is not in the list.
+template <class List> struct vtkArrayDispatchSwitch;
+template <>
+struct vtkArrayDispatchSwitch<vtkArrayDispatchEnd>
+{
+  template <class Worker>
+  static bool Execute(int, void*, Worker&) { return false; }
+};
+template <int TypeId, class Tail>
+struct vtkArrayDispatchSwitch<vtkArrayDispatchList<TypeId, Tail> >
+{
+  template <class Worker>
+  static bool Execute(int type, void* values, Worker& worker)
+    {
+    if (type == TypeId)
+      {
+      typedef typename vtkArrayDispatchValueType<TypeId>::Type ValueType;
+      worker(static_cast<ValueType*>(values));
+      return true;
+      }
+    return vtkArrayDispatchSwitch<Tail>::Execute(type, values, worker);
+    }
+};
+
+// Binds the values of the first array to a worker taking two pointers.
+template <class T1, class Worker>
+struct vtkArrayDispatchBinder
+{
+  vtkArrayDispatchBinder(T1* values1, Worker& worker)
+    : Values1(values1), Worker2(worker) {}
+  template <class T2> void operator()(T2* values2)
+    {
+    this->Worker2(this->Values1, values2);
+    }
+  T1* Values1;
+  Worker& Worker2;
+};
+
+// Dispatches the second array once the type of the first is known.
+template <class List2, class Worker>
+struct vtkArrayDispatchSecond
+{
+  vtkArrayDispatchSecond(int type2, void* values2, Worker& worker)
+    : Type2(type2), Values2(values2), Worker2(worker), Found(false) {}
+  template <class T1> void operator()(T1* values1)
+    {
+    vtkArrayDispatchBinder<T1, Worker> binder(values1, this->Worker2);
+    this->Found =
+      vtkArrayDispatchSwitch<List2>::Execute(this->Type2, this->Values2, binder);
+    }
+  int Type2;
+  void* Values2;
+  Worker& Worker2;
+  bool Found;
+};
+
+// Passes the pointer to the values of the first array twice, the second
+// being the values of the second array of the same type.
+template <class Worker>
+struct vtkArrayDispatchSame
+{
+  vtkArrayDispatchSame(void* values2, Worker& worker)
+    : Values2(values2), Worker2(worker) {}
+  template <class T> void operator()(T* values1)
+    {
+    this->Worker2(values1, static_cast<T*>(this->Values2));
+    }
+  void* Values2;
+  Worker& Worker2;
+};
+//ETX
+
+// Description:
+// Return whether the values of the array can be dispatched, whatever its
+// type.  Code that must prepare the arrays before a dispatch, by
+// extending them with WriteVoidPointer() for instance, checks this first.
+inline bool vtkArrayDispatchIsDirect(vtkDataArray* array)
+{
+  return array && array->HasStandardMemoryLayout() &&
+    array->GetDataType() != VTK_BIT;
+}
+
+// Description:
+// Call worker(T*) with a pointer to the values of array, T being the type
+// of the values, if the type is in List.
+template <class List = vtkArrayDispatchAllTypes>
+class vtkArrayDispatch
+{
+public:
+  template <class Worker>
+  static bool Execute(vtkDataArray* array, Worker& worker)
+    {
+    if (!vtkArrayDispatchIsDirect(array))
+      {
+      return false;
+      }
+    return vtkArrayDispatchSwitch<List>::Execute(
+      array->GetDataType(), array->GetVoidPointer(0), worker);
+    }
+};
+
+// Description:
+// Call worker(T1*, T2*) with pointers to the values of array1 and array2,
+// T1 being in List1 and T2 in List2.
+template <class List1 = vtkArrayDispatchAllTypes,
+          class List2 = vtkArrayDispatchAllTypes>
+class vtkArrayDispatch2
+{
+public:
+  template <class Worker>
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2,
+                      Worker& worker)
+    {
+    if (!vtkArrayDispatchIsDirect(array1) || !vtkArrayDispatchIsDirect(array2))
+      {
+      return false;
+      }
+    vtkArrayDispatchSecond<List2, Worker> second(
+      array2->GetDataType(), array2->GetVoidPointer(0), worker);
+    return vtkArrayDispatchSwitch<List1>::Execute(
+      array1->GetDataType(), array1->GetVoidPointer(0), second) &&
+      second.Found;
+    }
+};
+
+// Description:
+// Call worker(T*, T*) with pointers to the values of array1 and array2,
+// which must both be of the type T in List.  Only one instantiation of
+// the worker is made per type.
+template <class List = vtkArrayDispatchAllTypes>
+class vtkArrayDispatch2SameType
+{
+public:
+  template <class Worker>
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2,
+                      Worker& worker)
+    {
+    if (!vtkArrayDispatchIsDirect(array1) || !vtkArrayDispatchIsDirect(array2)
+        || array1->GetDataType() != array2->GetDataType())
+      {
+      return false;
+      }
+    vtkArrayDispatchSame<Worker> same(array2->GetVoidPointer(0), worker);
+    return vtkArrayDispatchSwitch<List>::Execute(
+      array1->GetDataType(), array1->GetVoidPointer(0), same);
+    }
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAtomicOperations.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAtomicOperations.h"
+
+#include "vtkCriticalSection.h"
+#include "vtkWindows.h"
+
+// OSAtomic.h optimizations only used in 10.5 and later
+#if defined(__APPLE__)
+  #include <AvailabilityMacros.h>
+  #if MAC_OS_X_VERSION_MAX_ALLOWED >= 1050
+    #include <libkern/OSAtomic.h>
+  #endif
+#endif
+
+#if defined(WIN32) || defined(_WIN32)
+# define VTK_ATOMIC_WINDOWS
+#elif defined(__APPLE__) && (MAC_OS_X_VERSION_MIN_REQUIRED >= 1050)
+# define VTK_ATOMIC_APPLE
+#elif defined(VTK_HAVE_SYNC_BUILTINS)
+# define VTK_ATOMIC_SYNC_BUILTINS
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+// Compilers that accept gcc style inline assembly but do not provide the
+// __sync builtins (older Intel, PathScale or PGI compilers on Linux).
+# define VTK_ATOMIC_X86_ASM
+#else
+# define VTK_ATOMIC_LOCK
+#endif
+
+#if defined(VTK_ATOMIC_X86_ASM)
+//----------------------------------------------------------------------------
+// "lock xadd" adds to memory and returns the previous value.
+static inline int vtkAtomicOperationsFetchAndAdd(int *value, int delta)
+{
+  __asm__ __volatile__("lock; xaddl %0, %1"
+                       : "+r" (delta), "+m" (*value)
+                       :
+                       : "memory", "cc");
+  return delta;
+}
+
+static inline unsigned long
+vtkAtomicOperationsFetchAndAdd(unsigned long *value, unsigned long delta)
+{
+# if defined(__x86_64__)
+  __asm__ __volatile__("lock; xaddq %0, %1"
+# else
+  __asm__ __volatile__("lock; xaddl %0, %1"
+# endif
+                       : "+r" (delta), "+m" (*value)
+                       :
+                       : "memory", "cc");
+  return delta;
+}
+#endif
+
+#if defined(VTK_ATOMIC_LOCK)
+//----------------------------------------------------------------------------
+static vtkSimpleCriticalSection *vtkAtomicOperationsGetLock()
+{
+  static vtkSimpleCriticalSection AtomicCritSec;
+  return &AtomicCritSec;
+}
+#endif
+
+//----------------------------------------------------------------------------
+int vtkAtomicOperations::Add(int *value, int delta)
+{
+#if defined(VTK_ATOMIC_WINDOWS)
+  return static_cast<int>(
+    InterlockedExchangeAdd(reinterpret_cast<volatile LONG *>(value),
+                           static_cast<LONG>(delta))) + delta;
+#elif defined(VTK_ATOMIC_APPLE)
+  return OSAtomicAdd32Barrier(delta, reinterpret_cast<volatile int32_t *>(value));
+#elif defined(VTK_ATOMIC_SYNC_BUILTINS)
+  return __sync_add_and_fetch(value, delta);
+#elif defined(VTK_ATOMIC_X86_ASM)
+  return vtkAtomicOperationsFetchAndAdd(value, delta) + delta;
+#else
+  vtkSimpleCriticalSection *lock = vtkAtomicOperationsGetLock();
+  lock->Lock();
+  int result = (*value += delta);
+  lock->Unlock();
+  return result;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkAtomicOperations::Increment(int *value)
+{
+#if defined(VTK_ATOMIC_WINDOWS)
+  return static_cast<int>(
+    InterlockedIncrement(reinterpret_cast<volatile LONG *>(value)));
+#elif defined(VTK_ATOMIC_APPLE)
+  return OSAtomicIncrement32Barrier(reinterpret_cast<volatile int32_t *>(value));
+#else
+  return vtkAtomicOperations::Add(value, 1);
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkAtomicOperations::Decrement(int *value)
+{
+#if defined(VTK_ATOMIC_WINDOWS)
+  return static_cast<int>(
+    InterlockedDecrement(reinterpret_cast<volatile LONG *>(value)));
+#elif defined(VTK_ATOMIC_APPLE)
+  return OSAtomicDecrement32Barrier(reinterpret_cast<volatile int32_t *>(value));
+#else
+  return vtkAtomicOperations::Add(value, -1);
+#endif
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkAtomicOperations::Increment(unsigned long *value)
+{
+#if defined(VTK_ATOMIC_WINDOWS)
+  // unsigned long has the size of LONG on Windows.
+  return static_cast<unsigned long>(
+    InterlockedIncrement(reinterpret_cast<volatile LONG *>(value)));
+#elif defined(VTK_ATOMIC_APPLE)
+# if __LP64__
+  // The cast does not change the size, but does change signedness.
+  return static_cast<unsigned long>(
+    OSAtomicIncrement64Barrier(reinterpret_cast<volatile int64_t *>(value)));
+# else
+  return static_cast<unsigned long>(
+    OSAtomicIncrement32Barrier(reinterpret_cast<volatile int32_t *>(value)));
+# endif
+#elif defined(VTK_ATOMIC_SYNC_BUILTINS)
+  return __sync_add_and_fetch(value, 1UL);
+#elif defined(VTK_ATOMIC_X86_ASM)
+  return vtkAtomicOperationsFetchAndAdd(value, 1UL) + 1UL;
+#else
+  vtkSimpleCriticalSection *lock = vtkAtomicOperationsGetLock();
+  lock->Lock();
+  unsigned long result = ++(*value);
+  lock->Unlock();
+  return result;
+#endif
+}
+
+//----------------------------------------------------------------------------
+const char *vtkAtomicOperations::GetImplementation()
+{
+#if defined(VTK_ATOMIC_WINDOWS)
+  return "Interlocked";
+#elif defined(VTK_ATOMIC_APPLE)
+  return "OSAtomic";
+#elif defined(VTK_ATOMIC_SYNC_BUILTINS)
+  return "__sync builtins";
+#elif defined(VTK_ATOMIC_X86_ASM)
+  return "x86 lock instructions";
+#else
+  return "critical section";
+#endif
+}
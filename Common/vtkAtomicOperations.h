@@ -0,0 +1,55 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAtomicOperations.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAtomicOperations - atomic increment and decrement of integers
+// .SECTION Description
+// vtkAtomicOperations provides atomic read-modify-write operations on
+// int and unsigned long variables, as used for reference counts and
+// modification times.  Each operation is a full memory barrier and
+// returns the new value.
+//
+// The implementation uses, in order of preference, the Windows
+// Interlocked functions, the Mac OS X OSAtomic functions, the gcc/clang
+// __sync builtins, x86 "lock" instructions for the other compilers that
+// understand gcc style inline assembly, and finally a global lock.
+// .SECTION See Also
+// vtkObjectBase vtkTimeStamp
+
+#ifndef __vtkAtomicOperations_h
+#define __vtkAtomicOperations_h
+
+#include "vtkSystemIncludes.h"
+
+class VTK_COMMON_EXPORT vtkAtomicOperations
+{
+public:
+  // Description:
+  // Add one to or remove one from *value and return the new value.
+  static int Increment(int *value);
+  static int Decrement(int *value);
+
+  // Description:
+  // Add delta to *value and return the new value.
+  static int Add(int *value, int delta);
+
+  // Description:
+  // Add one to *value and return the new value.
+  static unsigned long Increment(unsigned long *value);
+
+  // Description:
+  // Return a string naming the implementation in use, for diagnostics.
+  static const char *GetImplementation();
+};
+
+#endif
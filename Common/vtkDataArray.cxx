@@ -139,27 +139,39 @@ void vtkDataArray::DeepCopy(vtkDataArray *da)
     vtkIdType numTuples = da->GetNumberOfTuples();
     this->NumberOfComponents = da->NumberOfComponents;
     this->SetNumberOfTuples(numTuples);
-    void *input=da->GetVoidPointer(0);
 
-    switch (da->GetDataType())
+    // Arrays whose memory cannot be accessed directly use the double API.
+    if (!da->HasStandardMemoryLayout() || !this->HasStandardMemoryLayout())
       {
-      vtkTemplateMacro(
-        vtkDeepCopySwitchOnOutput(static_cast<VTK_TT*>(input),
-                                  this,
-                                  numTuples,
-                                  this->NumberOfComponents));
-
-      case VTK_BIT:
-        {//bit not supported, using generic double API
-        for (vtkIdType i=0; i < numTuples; i++)
-          {
-          this->SetTuple(i, da->GetTuple(i));
-          }
-        break;
+      for (vtkIdType i=0; i < numTuples; i++)
+        {
+        this->SetTuple(i, da->GetTuple(i));
         }
+      }
+    else
+      {
+      void *input = da->GetVoidPointer(0);
+
+      switch (da->GetDataType())
+        {
+        vtkTemplateMacro(
+          vtkDeepCopySwitchOnOutput(static_cast<VTK_TT*>(input),
+                                    this,
+                                    numTuples,
+                                    this->NumberOfComponents));
+
+        case VTK_BIT:
+          {//bit not supported, using generic double API
+          for (vtkIdType i=0; i < numTuples; i++)
+            {
+            this->SetTuple(i, da->GetTuple(i));
+            }
+          break;
+          }
 
-      default:
-        vtkErrorMacro("Unsupported data type " << da->GetDataType() << "!");
+        default:
+          vtkErrorMacro("Unsupported data type " << da->GetDataType() << "!");
+        }
       }
 
     this->SetLookupTable(0);
@@ -272,6 +284,19 @@ inline void vtkDataArrayRoundIfNecessary(double val, float* retVal)
   *retVal = static_cast<float>(val);
 }
 
+//--------------------------------------------------------------------------
+// Round a value the same way vtkDataArrayRoundIfNecessary does for the
+// type of the given array.
+static double vtkDataArrayRound(vtkDataArray* array, double val)
+{
+  int type = array->GetDataType();
+  if (type == VTK_FLOAT || type == VTK_DOUBLE)
+    {
+    return val;
+    }
+  return (val >= 0.0) ? floor(val + 0.5) : ceil(val - 0.5);
+}
+
 //--------------------------------------------------------------------------
 template <class T>
 void vtkDataArrayInterpolateTuple(T* from, T* to, int numComp,
@@ -312,6 +337,20 @@ void vtkDataArray::InterpolateTuple(vtkIdType i, vtkIdList *ptIndices,
     vtkIdType idx= i*numComp;
     double c;
 
+    if (!fromData->HasStandardMemoryLayout() ||
+        !this->HasStandardMemoryLayout())
+      {
+      for (int k=0; k<numComp; k++)
+        {
+        for (c=0, j=0; j<numIds; j++)
+          {
+          c += weights[j]*fromData->GetComponent(ids[j], k);
+          }
+        this->InsertComponent(i, k, vtkDataArrayRound(this, c));
+        }
+      return;
+      }
+
     switch (fromData->GetDataType())
       {
     case VTK_BIT:
@@ -386,6 +425,19 @@ void vtkDataArray::InterpolateTuple(vtkIdType i,
   double c;
   vtkIdType loc = i * numComp;
 
+  if (!fromData1->HasStandardMemoryLayout() ||
+      !fromData2->HasStandardMemoryLayout() ||
+      !this->HasStandardMemoryLayout())
+    {
+    for (k=0; k<numComp; k++)
+      {
+      double c1 = fromData1->GetComponent(id1, k);
+      c = (1.0 - t) * c1 + t * fromData2->GetComponent(id2, k);
+      this->InsertComponent(i, k, vtkDataArrayRound(this, c));
+      }
+    return;
+    }
+
   switch (fromData1->GetDataType())
     {
     case VTK_BIT:
@@ -816,6 +868,17 @@ void vtkDataArray::GetTuples(vtkIdList *ptIds, vtkAbstractArray *aa)
     }
 
   
+  // Arrays whose memory cannot be accessed directly use the double API.
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    vtkIdType num=ptIds->GetNumberOfIds();
+    for (vtkIdType i=0; i<num; i++)
+      {
+      da->SetTuple(i,this->GetTuple(ptIds->GetId(i)));
+      }
+    return;
+    }
+
   switch (this->GetDataType())
     {
     vtkTemplateMacro(vtkCopyTuples1 (static_cast<VTK_TT *>(this->GetVoidPointer(0)), da,
@@ -890,6 +953,17 @@ void vtkDataArray::GetTuples(vtkIdType p1, vtkIdType p2, vtkAbstractArray *aa)
     return;
     }
 
+  // Arrays whose memory cannot be accessed directly use the double API.
+  if (!this->HasStandardMemoryLayout() || !da->HasStandardMemoryLayout())
+    {
+    vtkIdType num=p2-p1+1;
+    for (vtkIdType i=0; i<num; i++)
+      {
+      da->SetTuple(i,this->GetTuple(p1+i));
+      }
+    return;
+    }
+
   switch (this->GetDataType())
     {
     vtkTemplateMacro(vtkCopyTuples1( static_cast<VTK_TT *>(this->GetVoidPointer(0)), da,
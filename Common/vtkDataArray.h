@@ -127,7 +127,8 @@ public:
   // Description:
   // Get the data tuple at ith location by filling in a user-provided array,
   // Make sure that your array is large enough to hold the NumberOfComponents
-  // amount of data being returned.
+  // amount of data being returned.  Unlike the method above, this one may
+  // be called from several threads as long as the array is not modified.
   virtual void GetTuple(vtkIdType i, double * tuple) = 0;
 
   // Description:
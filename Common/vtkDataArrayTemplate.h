@@ -23,6 +23,8 @@
 
 #include "vtkDataArray.h"
 
+class vtkArrayAllocator;
+
 template <class T>
 class vtkDataArrayTemplateLookup;
 
@@ -201,10 +203,52 @@ public:
   enum DeleteMethod
   {
     VTK_DATA_ARRAY_FREE,
-    VTK_DATA_ARRAY_DELETE
+    VTK_DATA_ARRAY_DELETE,
+    VTK_DATA_ARRAY_ALLOCATOR
+  };
+
+  enum GrowthPolicy
+  {
+    VTK_DATA_ARRAY_GROW_GEOMETRIC,
+    VTK_DATA_ARRAY_GROW_EXACT,
+    VTK_DATA_ARRAY_GROW_CHUNKED
   };
 //ETX
 
+  // Description:
+  // Set how the array grows when values are inserted past its size.
+  // GEOMETRIC, the default, adds GrowthFactor-1 times the current size to
+  // the requested size: inserting n values costs O(n) copies, but the
+  // array may end up GrowthFactor times larger than needed and holds
+  // both blocks while it is copied.  EXACT allocates the requested size
+  // only, for arrays sized beforehand that should not overshoot.
+  // CHUNKED rounds the requested size up to a multiple of
+  // GrowthChunkSize values, so the unused memory is less than one chunk;
+  // large blocks are grown by remapping their pages rather than by
+  // copying them (by realloc() on Linux, or by an allocator such as
+  // vtkHugePageArrayAllocator), so that the final Squeeze() costs
+  // nothing.
+  void SetGrowthPolicy(int policy);
+  int GetGrowthPolicy() { return this->GrowthPolicy; }
+  void SetGrowthPolicyToGeometric()
+    { this->SetGrowthPolicy(VTK_DATA_ARRAY_GROW_GEOMETRIC); }
+  void SetGrowthPolicyToExact()
+    { this->SetGrowthPolicy(VTK_DATA_ARRAY_GROW_EXACT); }
+  void SetGrowthPolicyToChunked()
+    { this->SetGrowthPolicy(VTK_DATA_ARRAY_GROW_CHUNKED); }
+
+  // Description:
+  // Set the factor by which a GEOMETRIC array grows at least.  The
+  // default, 2, doubles the array.  1 behaves like EXACT.
+  void SetGrowthFactor(double factor);
+  double GetGrowthFactor() { return this->GrowthFactor; }
+
+  // Description:
+  // Set the number of values by which a CHUNKED array grows.  The
+  // default is 65536.
+  void SetGrowthChunkSize(vtkIdType size);
+  vtkIdType GetGrowthChunkSize() { return this->GrowthChunkSize; }
+
   // Description:
   // This method lets the user specify data to be held by the array.  The
   // array argument is a pointer to the data.  size is the size of the
@@ -214,7 +258,9 @@ public:
   // suppled array. If specified, the delete method determines how the data
   // array will be deallocated. If the delete method is
   // VTK_DATA_ARRAY_FREE, free() will be used. If the delete method is
-  // DELETE, delete[] will be used. The default is FREE.
+  // DELETE, delete[] will be used. If the delete method is ALLOCATOR,
+  // the array of size values was obtained from the allocator of this
+  // array and will be freed with it. The default is FREE.
   void SetArray(T* array, vtkIdType size, int save, int deleteMethod);
   void SetArray(T* array, vtkIdType size, int save)
     { this->SetArray(array, size, save, VTK_DATA_ARRAY_FREE); }
@@ -228,6 +274,14 @@ public:
       this->SetArray(static_cast<T*>(array), size, save, deleteMethod);
     }
 
+  // Description:
+  // Set the allocator providing the memory of the values.  The values
+  // already allocated by the previous allocator are moved.  The default is
+  // the default allocator when the array was created, see
+  // vtkArrayAllocator::SetDefaultAllocator().  NULL uses malloc().
+  void SetAllocator(vtkArrayAllocator *allocator);
+  vtkArrayAllocator *GetAllocator() { return this->Allocator; }
+
   // Description:
   // This method copies the array data to the void pointer specified
   // by the user.  It is up to the user to allocate enough memory for
@@ -280,6 +334,11 @@ protected:
 
   int SaveUserArray;
   int DeleteMethod;
+  vtkArrayAllocator *Allocator;
+
+  int GrowthPolicy;
+  double GrowthFactor;
+  vtkIdType GrowthChunkSize;
 
   virtual void ComputeScalarRange(int comp);
   virtual void ComputeVectorRange();
@@ -291,6 +350,9 @@ private:
   void UpdateLookup();
 
   void DeleteArray();
+  T* AllocateValues(vtkIdType size);
+  void CopyTupleFromComponents(vtkIdType loc, vtkIdType j,
+                               vtkAbstractArray* source);
 };
 
 #if !defined(VTK_NO_EXPLICIT_TEMPLATE_INSTANTIATION)
@@ -17,6 +17,7 @@
 
 #include "vtkDataArrayTemplate.h"
 
+#include "vtkArrayAllocator.h"
 #include "vtkArrayIteratorTemplate.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -76,6 +77,14 @@ vtkDataArrayTemplate<T>::vtkDataArrayTemplate(vtkIdType numComp):
   this->TupleSize = 0;
   this->SaveUserArray = 0;
   this->DeleteMethod = VTK_DATA_ARRAY_FREE;
+  this->Allocator = vtkArrayAllocator::GetDefaultAllocator();
+  if(this->Allocator)
+    {
+    this->Allocator->Register(this);
+    }
+  this->GrowthPolicy = VTK_DATA_ARRAY_GROW_GEOMETRIC;
+  this->GrowthFactor = 2.0;
+  this->GrowthChunkSize = 65536;
   this->Lookup = 0;
   this->ValueRange[0] = 0;
   this->ValueRange[1] = 1;
@@ -94,6 +103,10 @@ vtkDataArrayTemplate<T>::~vtkDataArrayTemplate()
     {
     delete this->Lookup;
     }
+  if(this->Allocator)
+    {
+    this->Allocator->UnRegister(this);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -113,6 +126,12 @@ void vtkDataArrayTemplate<T>::SetArray(T* array,
 
   vtkDebugMacro(<<"Setting array to: " << static_cast<void*>(array));
 
+  if(deleteMethod == VTK_DATA_ARRAY_ALLOCATOR && !this->Allocator)
+    {
+    vtkErrorMacro("No allocator to free the array with, free() will be used.");
+    deleteMethod = VTK_DATA_ARRAY_FREE;
+    }
+
   this->Array = array;
   this->Size = size;
   this->MaxId = size-1;
@@ -121,6 +140,102 @@ void vtkDataArrayTemplate<T>::SetArray(T* array,
   this->DataChanged();
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetGrowthPolicy(int policy)
+{
+  policy = (policy < VTK_DATA_ARRAY_GROW_GEOMETRIC ?
+            VTK_DATA_ARRAY_GROW_GEOMETRIC :
+            (policy > VTK_DATA_ARRAY_GROW_CHUNKED ?
+             VTK_DATA_ARRAY_GROW_CHUNKED : policy));
+  if(policy != this->GrowthPolicy)
+    {
+    this->GrowthPolicy = policy;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetGrowthFactor(double factor)
+{
+  factor = (factor < 1.0 ? 1.0 : factor);
+  if(factor != this->GrowthFactor)
+    {
+    this->GrowthFactor = factor;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetGrowthChunkSize(vtkIdType size)
+{
+  size = (size < 1 ? 1 : size);
+  if(size != this->GrowthChunkSize)
+    {
+    this->GrowthChunkSize = size;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkDataArrayTemplate<T>::SetAllocator(vtkArrayAllocator *allocator)
+{
+  if(allocator == this->Allocator)
+    {
+    return;
+    }
+
+  // Move the values owned by the previous allocator, which frees them.
+  if(this->Array && !this->SaveUserArray &&
+     this->DeleteMethod == VTK_DATA_ARRAY_ALLOCATOR)
+    {
+    size_t size = static_cast<size_t>(this->Size) * sizeof(T);
+    T* newArray = static_cast<T*>(
+      allocator ? allocator->Allocate(size) : malloc(size > 0 ? size : 1));
+    if(!newArray)
+      {
+      vtkErrorMacro("Unable to allocate " << this->Size
+                    << " elements of size " << sizeof(T)
+                    << " bytes. ");
+      return;
+      }
+    memcpy(newArray, this->Array, size);
+    this->Allocator->Free(this->Array, size);
+    this->Array = newArray;
+    this->DeleteMethod =
+      allocator ? VTK_DATA_ARRAY_ALLOCATOR : VTK_DATA_ARRAY_FREE;
+    }
+
+  if(allocator)
+    {
+    allocator->Register(this);
+    }
+  if(this->Allocator)
+    {
+    this->Allocator->UnRegister(this);
+    }
+  this->Allocator = allocator;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+// Allocate memory for size values with the allocator of the array, or
+// malloc() if it has none.  The caller sets DeleteMethod accordingly once
+// the previous values are deleted.
+template <class T>
+T* vtkDataArrayTemplate<T>::AllocateValues(vtkIdType size)
+{
+  size_t bytes = static_cast<size_t>(size) * sizeof(T);
+  if(this->Allocator)
+    {
+    return static_cast<T*>(this->Allocator->Allocate(bytes));
+    }
+  return static_cast<T*>(malloc(bytes));
+}
+
 //----------------------------------------------------------------------------
 // Allocate memory for this array. Delete old storage only if necessary.
 template <class T>
@@ -135,8 +250,7 @@ int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
     this->Size = 0;
 
     vtkIdType newSize = (sz > 0 ? sz : 1);
-    this->Array = static_cast<T*>(malloc(static_cast<size_t>(newSize)
-                                         * sizeof(T)));
+    this->Array = this->AllocateValues(newSize);
     if(this->Array==0)
       {
       vtkErrorMacro("Unable to allocate " << newSize
@@ -154,6 +268,8 @@ int vtkDataArrayTemplate<T>::Allocate(vtkIdType sz, vtkIdType)
       #endif
       }
     this->Size = newSize;
+    this->DeleteMethod =
+      this->Allocator ? VTK_DATA_ARRAY_ALLOCATOR : VTK_DATA_ARRAY_FREE;
     }
   this->DataChanged();
 
@@ -189,8 +305,10 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
     return;
     }
 
-  // If data type does not match, do copy with conversion.
-  if(fa->GetDataType() != this->GetDataType())
+  // If data type does not match, or the memory of fa cannot be accessed
+  // directly, do copy with conversion.
+  if(fa->GetDataType() != this->GetDataType() ||
+     !fa->HasStandardMemoryLayout())
     {
     this->Superclass::DeepCopy(fa);
     this->DataChanged();
@@ -206,8 +324,7 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
   this->Size = fa->GetSize();
 
   this->Size = (this->Size > 0 ? this->Size : 1);
-  this->Array = static_cast<T* >(
-    malloc(static_cast<size_t>(this->Size) * sizeof(T)));
+  this->Array = this->AllocateValues(this->Size);
   if(this->Array==0)
     {
     vtkErrorMacro("Unable to allocate " << this->Size
@@ -228,6 +345,8 @@ void vtkDataArrayTemplate<T>::DeepCopy(vtkDataArray* fa)
     return;
     #endif
     }
+  this->DeleteMethod =
+    this->Allocator ? VTK_DATA_ARRAY_ALLOCATOR : VTK_DATA_ARRAY_FREE;
   if (fa->GetSize() > 0)
     {
     memcpy(this->Array, fa->GetVoidPointer(0),
@@ -251,6 +370,12 @@ void vtkDataArrayTemplate<T>::PrintSelf(ostream& os, vtkIndent indent)
     {
     osw << indent << "Array: (null)\n";
     }
+  osw << indent << "Growth Policy: "
+      << (this->GrowthPolicy == VTK_DATA_ARRAY_GROW_EXACT ? "Exact" :
+          (this->GrowthPolicy == VTK_DATA_ARRAY_GROW_CHUNKED ? "Chunked" :
+           "Geometric")) << "\n";
+  osw << indent << "Growth Factor: " << this->GrowthFactor << "\n";
+  osw << indent << "Growth Chunk Size: " << this->GrowthChunkSize << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -263,6 +388,11 @@ void vtkDataArrayTemplate<T>::DeleteArray()
       {
       free(this->Array);
       }
+    else if (this->DeleteMethod == VTK_DATA_ARRAY_ALLOCATOR)
+      {
+      this->Allocator->Free(this->Array,
+                            static_cast<size_t>(this->Size) * sizeof(T));
+      }
     else
       {
       delete[] this->Array;
@@ -283,9 +413,24 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
   if(sz > this->Size)
     {
     // Requested size is bigger than current size.  Allocate enough
-    // memory to fit the requested size and be more than double the
-    // currently allocated memory.
-    newSize = this->Size + sz;
+    // memory to fit the requested size, with room for the next
+    // insertions depending on the growth policy.
+    if(this->GrowthPolicy == VTK_DATA_ARRAY_GROW_EXACT)
+      {
+      newSize = sz;
+      }
+    else if(this->GrowthPolicy == VTK_DATA_ARRAY_GROW_CHUNKED)
+      {
+      newSize = ((sz + this->GrowthChunkSize - 1) / this->GrowthChunkSize) *
+        this->GrowthChunkSize;
+      }
+    else
+      {
+      // With the default factor of 2, more than double the currently
+      // allocated memory.
+      newSize = sz + static_cast<vtkIdType>(
+        static_cast<double>(this->Size) * (this->GrowthFactor - 1.0));
+      }
     }
   else if (sz == this->Size)
     {
@@ -317,12 +462,38 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
 
   // Allocate the new array or reallocate the old.
   if (this->Array
-      &&
-      (this->SaveUserArray
-       || this->DeleteMethod==VTK_DATA_ARRAY_DELETE
-       || dontUseRealloc ))
+      && !this->SaveUserArray
+      && this->DeleteMethod==VTK_DATA_ARRAY_ALLOCATOR)
+    {
+    // Let the allocator resize its memory, possibly in place.
+    newArray = static_cast<T*>(this->Allocator->Reallocate(
+      this->Array, static_cast<size_t>(this->Size)*sizeof(T),
+      static_cast<size_t>(newSize)*sizeof(T)));
+    if(!newArray)
+      {
+      vtkErrorMacro("Unable to allocate " << newSize
+                    << " elements of size " << sizeof(T)
+                    << " bytes. ");
+      #if !defined NDEBUG
+      // We're debugging, crash here preserving the stack
+      abort();
+      #elif !defined VTK_DONT_THROW_BAD_ALLOC
+      // We can throw something that has universal meaning
+      throw std::bad_alloc();
+      #else
+      // We indicate that malloc failed by return
+      return 0;
+      #endif
+      }
+    }
+  else if ((this->Array
+            &&
+            (this->SaveUserArray
+             || this->DeleteMethod==VTK_DATA_ARRAY_DELETE
+             || dontUseRealloc ))
+           || (!this->Array && this->Allocator))
     {
-    newArray = static_cast<T*>(malloc(static_cast<size_t>(newSize)*sizeof(T)));
+    newArray = this->AllocateValues(newSize);
     if(!newArray)
       {
       vtkErrorMacro("Unable to allocate " << newSize
@@ -340,12 +511,17 @@ T* vtkDataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
       #endif
       }
     // Copy the data from the old array.
-    memcpy(newArray, this->Array,
-           static_cast<size_t>(newSize < this->Size ? newSize : this->Size)
-           * sizeof(T));
+    if (this->Array)
+      {
+      memcpy(newArray, this->Array,
+             static_cast<size_t>(newSize < this->Size ? newSize : this->Size)
+             * sizeof(T));
+      }
 
     // Realease old array if we own
     this->DeleteArray();
+    this->DeleteMethod =
+      this->Allocator ? VTK_DATA_ARRAY_ALLOCATOR : VTK_DATA_ARRAY_FREE;
     }
   else
     {
@@ -430,6 +606,12 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
   vtkIdType loci = i * this->NumberOfComponents;
   vtkIdType locj = j * source->GetNumberOfComponents();
 
+  if (!source->HasStandardMemoryLayout())
+    {
+    this->CopyTupleFromComponents(loci, j, source);
+    return;
+    }
+
   T* data = static_cast<T*>(source->GetVoidPointer(0));
 
   for (vtkIdType cur = 0; cur < this->NumberOfComponents; cur++)
@@ -439,6 +621,26 @@ void vtkDataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
   this->DataChanged();
 }
 
+//----------------------------------------------------------------------------
+// Copy the jth tuple of a source array of the same type whose memory cannot
+// be accessed directly, component by component, starting at value loc.
+template <class T>
+void vtkDataArrayTemplate<T>::CopyTupleFromComponents(vtkIdType loc,
+  vtkIdType j, vtkAbstractArray* source)
+{
+  vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+  if (!da)
+    {
+    vtkWarningMacro("Input array is not a vtkDataArray.");
+    return;
+    }
+  for (int cur = 0; cur < this->NumberOfComponents; cur++)
+    {
+    this->Array[loc + cur] = static_cast<T>(da->GetComponent(j, cur));
+    }
+  this->DataChanged();
+}
+
 //----------------------------------------------------------------------------
 // Insert the jth tuple in the source array, at ith location in this array.
 // Note that memory allocation is performed as necessary to hold the data.
@@ -468,6 +670,17 @@ void vtkDataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
       }
     }
 
+  vtkIdType maxId = maxSize-1;
+  if (!source->HasStandardMemoryLayout())
+    {
+    this->CopyTupleFromComponents(locOut, j, source);
+    if ( maxId > this->MaxId )
+      {
+      this->MaxId = maxId;
+      }
+    return;
+    }
+
   vtkIdType locIn = j * inNumComp;
 
   T* outPtr = this->GetPointer(locOut);
@@ -476,7 +689,6 @@ void vtkDataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
   size_t s=static_cast<size_t>(inNumComp);
   memcpy(outPtr, inPtr, s*sizeof(T));
 
-  vtkIdType maxId = maxSize-1;
   if ( maxId > this->MaxId )
     {
     this->MaxId = maxId;
@@ -514,6 +726,13 @@ vtkIdType vtkDataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
       }
     }
 
+  if (!source->HasStandardMemoryLayout())
+    {
+    vtkIdType i = this->GetNumberOfTuples();
+    this->InsertTuple(i, j, source);
+    return i;
+    }
+
   T* data = static_cast<T*>(source->GetVoidPointer(0));
   vtkIdType locj = j * source->GetNumberOfComponents();
 
@@ -0,0 +1,251 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHugePageArrayAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHugePageArrayAllocator.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+# include <sys/mman.h>
+# define VTK_HUGE_PAGE_MAPPINGS
+#endif
+
+vtkStandardNewMacro(vtkHugePageArrayAllocator);
+
+// The size of a huge page on x86-64 and of the chunks touched by one
+// thread.
+#define VTK_HUGE_PAGE_SIZE (static_cast<size_t>(2) << 20)
+
+//----------------------------------------------------------------------------
+class vtkHugePageArrayAllocatorInternals
+{
+public:
+  vtkSimpleCriticalSection Lock;
+  std::map<void *, size_t> Mappings;  // start and length
+};
+
+//----------------------------------------------------------------------------
+static inline size_t vtkHugePageArrayAllocatorRound(size_t size)
+{
+  return (size + VTK_HUGE_PAGE_SIZE - 1) & ~(VTK_HUGE_PAGE_SIZE - 1);
+}
+
+#ifdef VTK_HUGE_PAGE_MAPPINGS
+//----------------------------------------------------------------------------
+// Touch one byte of each page of a chunk, from the thread processing it.
+class vtkHugePageArrayAllocatorToucher
+{
+public:
+  char *Data;
+  size_t Length;
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+      size_t start = static_cast<size_t>(chunk) * VTK_HUGE_PAGE_SIZE;
+      size_t stop = start + VTK_HUGE_PAGE_SIZE;
+      stop = (stop < this->Length ? stop : this->Length);
+      for (size_t offset = start; offset < stop; offset += 4096)
+        {
+        this->Data[offset] = 0;
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Map length bytes aligned on a huge page, or return NULL.
+static void *vtkHugePageArrayAllocatorMap(size_t length, int firstTouch)
+{
+  // Map one more huge page and trim the ends for the alignment.
+  size_t extended = length + VTK_HUGE_PAGE_SIZE;
+  void *raw = mmap(0, extended, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED)
+    {
+    return 0;
+    }
+  size_t address = reinterpret_cast<size_t>(raw);
+  size_t head = vtkHugePageArrayAllocatorRound(address) - address;
+  if (head > 0)
+    {
+    munmap(raw, head);
+    }
+  if (extended - head > length)
+    {
+    munmap(static_cast<char *>(raw) + head + length, extended - head - length);
+    }
+  char *data = static_cast<char *>(raw) + head;
+#if defined(MADV_HUGEPAGE)
+  madvise(data, length, MADV_HUGEPAGE);
+#endif
+  if (firstTouch)
+    {
+    vtkHugePageArrayAllocatorToucher toucher;
+    toucher.Data = data;
+    toucher.Length = length;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(length / VTK_HUGE_PAGE_SIZE),
+                     1, toucher);
+    }
+  return data;
+}
+#endif
+
+//----------------------------------------------------------------------------
+vtkHugePageArrayAllocator::vtkHugePageArrayAllocator()
+{
+  this->Threshold = static_cast<vtkIdType>(VTK_HUGE_PAGE_SIZE);
+  this->ParallelFirstTouch = 0;
+  this->Internals = new vtkHugePageArrayAllocatorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkHugePageArrayAllocator::~vtkHugePageArrayAllocator()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void *vtkHugePageArrayAllocator::AllocateMemory(size_t size)
+{
+#ifdef VTK_HUGE_PAGE_MAPPINGS
+  if (size > 0 && size >= static_cast<size_t>(this->Threshold))
+    {
+    size_t length = vtkHugePageArrayAllocatorRound(size);
+    void *ptr = vtkHugePageArrayAllocatorMap(length, this->ParallelFirstTouch);
+    if (ptr)
+      {
+      this->Internals->Lock.Lock();
+      this->Internals->Mappings[ptr] = length;
+      this->Internals->Lock.Unlock();
+      return ptr;
+      }
+    }
+#endif
+  return malloc(size > 0 ? size : 1);
+}
+
+//----------------------------------------------------------------------------
+void *vtkHugePageArrayAllocator::ReallocateMemory(void *ptr, size_t oldSize,
+                                                  size_t newSize)
+{
+#ifdef VTK_HUGE_PAGE_MAPPINGS
+  vtkHugePageArrayAllocatorInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  std::map<void *, size_t>::iterator iter = internals->Mappings.find(ptr);
+  if (iter != internals->Mappings.end())
+    {
+    size_t length = iter->second;
+    size_t newLength = vtkHugePageArrayAllocatorRound(newSize > 0 ? newSize : 1);
+    if (newLength == length)
+      {
+      internals->Lock.Unlock();
+      return ptr;
+      }
+    // The pages move with the mapping, no copy is made.
+    void *newPtr = mremap(ptr, length, newLength, MREMAP_MAYMOVE);
+    if (newPtr == MAP_FAILED)
+      {
+      internals->Lock.Unlock();
+      return 0;
+      }
+    internals->Mappings.erase(iter);
+    internals->Mappings[newPtr] = newLength;
+    internals->Lock.Unlock();
+#if defined(MADV_HUGEPAGE)
+    if (newLength > length)
+      {
+      madvise(newPtr, newLength, MADV_HUGEPAGE);
+      }
+#endif
+    return newPtr;
+    }
+  internals->Lock.Unlock();
+
+  // A malloc() block growing past the threshold moves to a mapping.
+  if (newSize >= static_cast<size_t>(this->Threshold) && newSize > 0)
+    {
+    void *newPtr = this->AllocateMemory(newSize);
+    if (newPtr)
+      {
+      memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+      free(ptr);
+      }
+    return newPtr;
+    }
+#else
+  (void)oldSize;
+#endif
+  return realloc(ptr, newSize > 0 ? newSize : 1);
+}
+
+//----------------------------------------------------------------------------
+void vtkHugePageArrayAllocator::FreeMemory(void *ptr, size_t)
+{
+#ifdef VTK_HUGE_PAGE_MAPPINGS
+  vtkHugePageArrayAllocatorInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  std::map<void *, size_t>::iterator iter = internals->Mappings.find(ptr);
+  if (iter != internals->Mappings.end())
+    {
+    size_t length = iter->second;
+    internals->Mappings.erase(iter);
+    internals->Lock.Unlock();
+    munmap(ptr, length);
+    return;
+    }
+  internals->Lock.Unlock();
+#endif
+  free(ptr);
+}
+
+//----------------------------------------------------------------------------
+int vtkHugePageArrayAllocator::GetNumberOfMappings()
+{
+  this->Internals->Lock.Lock();
+  int count = static_cast<int>(this->Internals->Mappings.size());
+  this->Internals->Lock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkHugePageArrayAllocator::GetMappedSize()
+{
+  vtkTypeUInt64 size = 0;
+  this->Internals->Lock.Lock();
+  std::map<void *, size_t>::const_iterator iter;
+  for (iter = this->Internals->Mappings.begin();
+       iter != this->Internals->Mappings.end(); ++iter)
+    {
+    size += iter->second;
+    }
+  this->Internals->Lock.Unlock();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkHugePageArrayAllocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Threshold: " << this->Threshold << "\n";
+  os << indent << "Parallel First Touch: "
+     << (this->ParallelFirstTouch ? "On\n" : "Off\n");
+  os << indent << "Number Of Mappings: " << this->GetNumberOfMappings() << "\n";
+  os << indent << "Mapped Size: " << this->GetMappedSize() << "\n";
+}
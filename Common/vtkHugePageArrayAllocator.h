@@ -0,0 +1,83 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHugePageArrayAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkHugePageArrayAllocator - array allocator mapping large arrays on huge pages
+// .SECTION Description
+// vtkHugePageArrayAllocator maps the allocations of at least Threshold
+// bytes directly from the system, aligned on 2 MiB and advised to use
+// transparent huge pages, which reduces the TLB misses of loops over
+// large arrays.  Growing such an allocation remaps it without copying.
+// Smaller allocations use malloc().
+//
+// With ParallelFirstTouch on, the pages of a new mapping are touched by
+// the threads of vtkSMPTools, each 2 MiB chunk by one thread, so that on
+// a NUMA machine the memory is spread over the nodes of the threads that
+// will process it with vtkSMPTools instead of all landing on the node of
+// the allocating thread.
+//
+// The mappings are only available on Linux; elsewhere this allocator
+// behaves like vtkArrayAllocator.
+// .SECTION See Also
+// vtkArrayAllocator vtkArenaArrayAllocator vtkSMPTools
+
+#ifndef __vtkHugePageArrayAllocator_h
+#define __vtkHugePageArrayAllocator_h
+
+#include "vtkArrayAllocator.h"
+
+class vtkHugePageArrayAllocatorInternals;
+
+class VTK_COMMON_EXPORT vtkHugePageArrayAllocator : public vtkArrayAllocator
+{
+public:
+  static vtkHugePageArrayAllocator *New();
+  vtkTypeMacro(vtkHugePageArrayAllocator,vtkArrayAllocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the size in bytes from which the allocations are mapped on huge
+  // pages.  The default is 2 MiB.
+  vtkSetClampMacro(Threshold,vtkIdType,0,VTK_LARGE_ID);
+  vtkGetMacro(Threshold,vtkIdType);
+
+  // Description:
+  // Touch the pages of new mappings from the threads of vtkSMPTools.
+  // Off by default.
+  vtkSetMacro(ParallelFirstTouch,int);
+  vtkGetMacro(ParallelFirstTouch,int);
+  vtkBooleanMacro(ParallelFirstTouch,int);
+
+  // Description:
+  // Return the number of mappings in use and their total size in bytes.
+  int GetNumberOfMappings();
+  vtkTypeUInt64 GetMappedSize();
+
+protected:
+  vtkHugePageArrayAllocator();
+  ~vtkHugePageArrayAllocator();
+
+  virtual void *AllocateMemory(size_t size);
+  virtual void *ReallocateMemory(void *ptr, size_t oldSize, size_t newSize);
+  virtual void FreeMemory(void *ptr, size_t size);
+
+  vtkIdType Threshold;
+  int ParallelFirstTouch;
+  vtkHugePageArrayAllocatorInternals *Internals;
+
+private:
+  vtkHugePageArrayAllocator(const vtkHugePageArrayAllocator&);  // Not implemented.
+  void operator=(const vtkHugePageArrayAllocator&);  // Not implemented.
+};
+
+#endif
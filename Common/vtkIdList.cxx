@@ -13,6 +13,7 @@
 
 =========================================================================*/
 #include "vtkIdList.h"
+#include "vtkArrayAllocator.h"
 #include "vtkObjectFactory.h"
 
 vtkStandardNewMacro(vtkIdList);
@@ -22,21 +23,98 @@ vtkIdList::vtkIdList()
   this->NumberOfIds = 0;
   this->Size = 0;
   this->Ids = NULL;
+  this->Allocator = vtkArrayAllocator::GetDefaultAllocator();
+  if ( this->Allocator )
+    {
+    this->Allocator->Register(this);
+    }
 }
 
 vtkIdList::~vtkIdList()
 {
   if ( this->Ids != NULL )
+    {
+    this->FreeIds();
+    }
+  if ( this->Allocator )
+    {
+    this->Allocator->UnRegister(this);
+    }
+}
+
+// The ids are allocated by the allocator of the list if it has one.
+vtkIdType *vtkIdList::AllocateIds(vtkIdType sz)
+{
+  if ( this->Allocator )
+    {
+    return static_cast<vtkIdType *>(
+      this->Allocator->Allocate(static_cast<size_t>(sz) * sizeof(vtkIdType)));
+    }
+  return new vtkIdType[sz];
+}
+
+void vtkIdList::FreeIds()
+{
+  if ( this->Allocator )
+    {
+    this->Allocator->Free(this->Ids,
+                          static_cast<size_t>(this->Size) * sizeof(vtkIdType));
+    }
+  else
     {
     delete [] this->Ids;
     }
 }
 
+void vtkIdList::SetAllocator(vtkArrayAllocator *allocator)
+{
+  if ( allocator == this->Allocator )
+    {
+    return;
+    }
+  vtkIdType *ids = this->Ids;
+  vtkArrayAllocator *previous = this->Allocator;
+  this->Allocator = allocator;
+  if ( ids != NULL )
+    {
+    // Move the ids to the memory of the new allocator, keeping them where
+    // they are if it cannot provide it.
+    this->Ids = this->AllocateIds(this->Size);
+    if ( this->Ids == NULL )
+      {
+      vtkErrorMacro("Unable to allocate " << this->Size
+                    << " ids with the new allocator, keeping the current one.");
+      this->Ids = ids;
+      this->Allocator = previous;
+      return;
+      }
+    memcpy(this->Ids, ids,
+           static_cast<size_t>(this->NumberOfIds) * sizeof(vtkIdType));
+    if ( previous )
+      {
+      previous->Free(ids, static_cast<size_t>(this->Size) * sizeof(vtkIdType));
+      }
+    else
+      {
+      delete [] ids;
+      }
+    }
+  if ( allocator )
+    {
+    allocator->Register(this);
+    }
+  if ( previous )
+    {
+    previous->UnRegister(this);
+    }
+  this->Modified();
+}
+
 void vtkIdList::Initialize()
 {
   if ( this->Ids != NULL )
     {
-    delete [] this->Ids;
+    this->FreeIds();
     this->Ids = NULL;
     }
   this->NumberOfIds = 0;
@@ -49,7 +127,7 @@ int vtkIdList::Allocate(const vtkIdType sz, const int vtkNotUsed(strategy))
     {
     this->Initialize();
     this->Size = ( sz > 0 ? sz : 1);
-    if ( (this->Ids = new vtkIdType[this->Size]) == NULL )
+    if ( (this->Ids = this->AllocateIds(this->Size)) == NULL )
       {
       return 0;
       }
@@ -133,7 +211,7 @@ void vtkIdList::DeepCopy(vtkIdList *ids)
   this->Initialize();
   this->NumberOfIds = ids->NumberOfIds;
   this->Size = ids->Size;
-  this->Ids = new vtkIdType [ids->Size];
+  this->Ids = this->AllocateIds(ids->Size);
   for (vtkIdType i=0; i < ids->NumberOfIds; i++)
     {
     this->Ids[i] = ids->Ids[i];
@@ -164,17 +242,32 @@ vtkIdType *vtkIdList::Resize(const vtkIdType sz)
     return 0;
     }
 
-  if ( (newIds = new vtkIdType[newSize]) == NULL )
-    { 
-    vtkErrorMacro(<< "Cannot allocate memory\n");
-    return 0;
+  if ( this->Allocator )
+    {
+    // Let the allocator resize its memory, possibly in place.
+    newIds = static_cast<vtkIdType *>(this->Allocator->Reallocate(
+      this->Ids, static_cast<size_t>(this->Size) * sizeof(vtkIdType),
+      static_cast<size_t>(newSize) * sizeof(vtkIdType)));
+    if ( newIds == NULL )
+      {
+      vtkErrorMacro(<< "Cannot allocate memory\n");
+      return 0;
+      }
     }
-
-  if (this->Ids)
+  else
     {
-    memcpy(newIds, this->Ids,
-           static_cast<size_t>(sz < this->Size ? sz : this->Size) * sizeof(vtkIdType));
-    delete [] this->Ids;
+    if ( (newIds = new vtkIdType[newSize]) == NULL )
+      { 
+      vtkErrorMacro(<< "Cannot allocate memory\n");
+      return 0;
+      }
+
+    if (this->Ids)
+      {
+      memcpy(newIds, this->Ids,
+             static_cast<size_t>(sz < this->Size ? sz : this->Size) * sizeof(vtkIdType));
+      delete [] this->Ids;
+      }
     }
 
   this->Size = newSize;
@@ -23,6 +23,8 @@
 
 #include "vtkObject.h"
 
+class vtkArrayAllocator;
+
 class VTK_COMMON_EXPORT vtkIdList : public vtkObject
 {
 public:
@@ -102,6 +104,13 @@ public:
   // to result of intersection operation.
   void IntersectWith(vtkIdList* otherIds);
 
+  // Description:
+  // Set the allocator providing the memory of the ids, see
+  // vtkArrayAllocator.  The ids already allocated are moved.  The default
+  // is the default allocator when the list was created.  NULL uses new[].
+  void SetAllocator(vtkArrayAllocator *allocator);
+  vtkArrayAllocator *GetAllocator() {return this->Allocator;};
+
   //BTX
   // This method should become legacy
   void IntersectWith(vtkIdList& otherIds) {
@@ -115,8 +124,11 @@ protected:
   vtkIdType NumberOfIds;
   vtkIdType Size; 
   vtkIdType *Ids;
+  vtkArrayAllocator *Allocator;
 
   vtkIdType *Resize(const vtkIdType sz);
+  vtkIdType *AllocateIds(vtkIdType sz);
+  void FreeIds();
 private:
   vtkIdList(const vtkIdList&);  // Not implemented.
   void operator=(const vtkIdList&);  // Not implemented.
@@ -0,0 +1,38 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArrayFunction.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImplicitArrayFunction.h"
+
+//----------------------------------------------------------------------------
+double vtkImplicitArrayFunction::EvaluateComponent(vtkIdType i, int j)
+{
+  int numComp = this->GetNumberOfComponents();
+  double local[16];
+  double *tuple = (numComp <= 16 ? local : new double[numComp]);
+  this->EvaluateTuple(i, tuple);
+  double value = tuple[j];
+  if (tuple != local)
+    {
+    delete [] tuple;
+    }
+  return value;
+}
+
+//----------------------------------------------------------------------------
+void vtkImplicitArrayFunction::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Number Of Components: "
+     << this->GetNumberOfComponents() << "\n";
+}
@@ -0,0 +1,64 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArrayFunction.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitArrayFunction - computes the values of an implicit array
+// .SECTION Description
+// vtkImplicitArrayFunction is the abstract functor that a
+// vtkImplicitDataArrayTemplate calls to obtain its values when they are
+// not a constant or an affine function of the tuple index.  Subclasses
+// implement EvaluateTuple(), which computes the values of one tuple,
+// and may override EvaluateComponent() when one component is cheaper to
+// compute alone.
+//
+// The function is called each time a value of the array is read, possibly
+// from several threads at once: subclasses that keep state between calls
+// must protect it.
+// .SECTION See Also
+// vtkImplicitDataArrayTemplate
+
+#ifndef __vtkImplicitArrayFunction_h
+#define __vtkImplicitArrayFunction_h
+
+#include "vtkObject.h"
+
+class VTK_COMMON_EXPORT vtkImplicitArrayFunction : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkImplicitArrayFunction,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return the number of components of the tuples computed.
+  virtual int GetNumberOfComponents() = 0;
+
+  // Description:
+  // Compute the values of tuple i into tuple, which holds
+  // GetNumberOfComponents() values.
+  virtual void EvaluateTuple(vtkIdType i, double *tuple) = 0;
+
+  // Description:
+  // Compute component j of tuple i.  The default implementation computes
+  // the whole tuple.
+  virtual double EvaluateComponent(vtkIdType i, int j);
+
+protected:
+  vtkImplicitArrayFunction() {}
+  ~vtkImplicitArrayFunction() {}
+
+private:
+  vtkImplicitArrayFunction(const vtkImplicitArrayFunction&);  // Not implemented.
+  void operator=(const vtkImplicitArrayFunction&);  // Not implemented.
+};
+
+#endif
@@ -0,0 +1,266 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitDataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkImplicitDataArrayTemplate - read-only data array computing its values on access
+// .SECTION Description
+// vtkImplicitDataArrayTemplate is a vtkDataArray that stores no values:
+// each value is computed from its tuple index when it is read.  The
+// memory used does not depend on the number of tuples.  The values are
+// either:
+//
+// - affine functions of the tuple index, set per component with
+// SetRamp(), of which constants, set with SetConstantValue() or
+// SetConstantTuple(), are a special case;
+// - the coordinates of the points of a regular grid, as vtkImageData
+// computes them, set with SetStructuredCoordinates().  The array can
+// then be the points of a vtkStructuredGrid or a vtkPolyData;
+// - the tuples computed by a vtkImplicitArrayFunction, set with
+// SetFunction().
+//
+// The computed values are converted to T, so that the array reads like a
+// vtkDataArrayTemplate<T> holding them.  The whole read API of
+// vtkDataArray (GetTuple(), GetComponent(), GetRange(), ...) is supported.
+// The array is read-only: the methods that modify values report an error.
+//
+// Code that accesses the memory of an array directly cannot work with
+// this array: HasStandardMemoryLayout() returns 0, and GetVoidPointer()
+// and NewIterator() return or iterate over a copy of all the values.  The
+// copy is kept until the values change: the methods setting how they are
+// computed, DataChanged(), Modified() and a modification of the function
+// rebuild it.  This copy is only meant for reading and defeats the
+// purpose of the class: code that knows about it should use the tuple
+// API, and Squeeze() releases it.
+//
+// NewInstance() returns a vtkDataArrayTemplate<T> of the same type, so
+// that the filters copying the attributes of their input with
+// CopyAllocate() and the deep copies of data objects produce regular
+// arrays holding the values.  Shallow copies share the implicit array.
+// .SECTION See Also
+// vtkImplicitArrayFunction vtkDataArrayTemplate vtkSOADataArrayTemplate
+
+#ifndef __vtkImplicitDataArrayTemplate_h
+#define __vtkImplicitDataArrayTemplate_h
+
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h" // For New()
+#include "vtkTypeTemplate.h" // For the type information
+
+class vtkImplicitArrayFunction;
+
+template <class T>
+class vtkImplicitDataArrayTemplate :
+  public vtkTypeTemplate<vtkImplicitDataArrayTemplate<T>, vtkDataArray>
+{
+public:
+  static vtkImplicitDataArrayTemplate<T>* New();
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return a new vtkDataArrayTemplate<T>, not a new implicit array: see
+  // the class description.
+  vtkDataArray* NewInstance() const
+    { return vtkDataArray::SafeDownCast(this->NewInstanceInternal()); }
+
+//BTX
+  enum ValueMode
+  {
+    VTK_IMPLICIT_ARRAY_AFFINE,
+    VTK_IMPLICIT_ARRAY_STRUCTURED_COORDINATES,
+    VTK_IMPLICIT_ARRAY_FUNCTION
+  };
+//ETX
+
+  // Description:
+  // Make every component of every tuple equal to value, or component j of
+  // every tuple equal to tuple[j].  Set the number of components first.
+  void SetConstantValue(double value);
+  void SetConstantTuple(const double* tuple);
+
+  // Description:
+  // Make component comp of tuple i equal to start + step*i.  Set the
+  // number of components first; the other components are not changed.
+  void SetRamp(int comp, double start, double step);
+
+  // Description:
+  // Make the array hold the coordinates of the points of a regular grid
+  // of the given dimensions, origin and spacing, in the order of the
+  // points of vtkImageData.  This sets the number of components to 3 and
+  // the number of tuples to the number of points.
+  void SetStructuredCoordinates(const int dims[3], const double origin[3],
+                                const double spacing[3]);
+
+  // Description:
+  // Compute the tuples with the given function.  This sets the number of
+  // components to the number of components of the function.  The number
+  // of tuples must be set.
+  void SetFunction(vtkImplicitArrayFunction* function);
+  vtkImplicitArrayFunction* GetFunction() { return this->Function; }
+
+  // Description:
+  // Return how the values are computed, depending on which of the
+  // methods above was called last.
+  int GetValueMode() { return this->ValueMode; }
+
+  // Description:
+  // Nothing is allocated: these methods return 1.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+  virtual int Resize(vtkIdType numTuples);
+
+  // Description:
+  // Make the array empty and reset it to a constant 0.
+  void Initialize();
+
+  // Description:
+  // Return the VTK type of T and its size.
+  int GetDataType();
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+
+  // Description:
+  // Set the number of n-tuples in the array.
+  void SetNumberOfTuples(vtkIdType number);
+
+  // Description:
+  // Get a pointer to a copy of the ith tuple as doubles.  This is a
+  // dangerous method (it is not thread safe since a pointer is returned).
+  double* GetTuple(vtkIdType i);
+
+  // Description:
+  // Compute the ith tuple into a user-provided array.
+  void GetTuple(vtkIdType i, double* tuple);
+  void GetTupleValue(vtkIdType i, T* tuple);
+
+  // Description:
+  // Compute the jth component of the ith tuple.
+  double GetComponent(vtkIdType i, int j);
+
+  // Description:
+  // Compute a value from its index i*NumberOfComponents+j.
+  T GetValue(vtkIdType id);
+  vtkVariant GetVariantValue(vtkIdType id);
+
+  // Description:
+  // The array is read-only: these methods report an error.
+  virtual void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  virtual void RemoveTuple(vtkIdType id);
+  virtual void RemoveFirstTuple();
+  virtual void RemoveLastTuple();
+  void SetComponent(vtkIdType i, int j, double c);
+  virtual void InsertComponent(vtkIdType i, int j, double c);
+  void SetVariantValue(vtkIdType id, vtkVariant value);
+  virtual void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  virtual void SetVoidArray(void* array, vtkIdType size, int save);
+
+  // Description:
+  // See the class description: GetVoidPointer() returns a read-only copy
+  // of the values.
+  virtual void* GetVoidPointer(vtkIdType id);
+  virtual int HasStandardMemoryLayout() { return 0; }
+
+  // Description:
+  // Compute the values to a user allocated buffer of
+  // GetNumberOfTuples()*GetNumberOfComponents() values.
+  virtual void ExportToVoidPointer(void *out_ptr);
+
+  // Description:
+  // Copy how another vtkImplicitDataArrayTemplate<T> computes its
+  // values.  The function, if any, is shared.  Other arrays cannot be
+  // copied into an implicit array.
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa)
+    { this->vtkDataArray::DeepCopy(aa); }
+
+  // Description:
+  // Release the copy returned by GetVoidPointer(), if any.
+  void Squeeze();
+
+  // Description:
+  // Returns a vtkArrayIteratorTemplate<T> over the copy returned by
+  // GetVoidPointer().
+  virtual vtkArrayIterator* NewIterator();
+
+  // Description:
+  // Return the memory in kilobytes used by the array, which does not
+  // depend on the number of tuples unless GetVoidPointer() was called.
+  virtual unsigned long GetActualMemorySize();
+
+  // Description:
+  // Return the indices where a specific value appears.  These methods
+  // compute all the values.
+  virtual vtkIdType LookupValue(vtkVariant value);
+  virtual void LookupValue(vtkVariant value, vtkIdList* ids);
+
+  // Description:
+  // There is no fast lookup structure to update or delete.  DataChanged()
+  // discards the copy returned by GetVoidPointer(), as does Modified().
+  virtual void DataChanged();
+  virtual void ClearLookup() {}
+  virtual void Modified();
+
+protected:
+  vtkImplicitDataArrayTemplate();
+  ~vtkImplicitDataArrayTemplate();
+
+  virtual const char* GetClassNameInternal() const
+    { return "vtkImplicitDataArrayTemplate"; }
+  virtual vtkObjectBase* NewInstanceInternal() const;
+
+  // The affine and structured coordinates ranges are computed from the
+  // first and last tuples.
+  virtual void ComputeScalarRange(int comp);
+
+  // Compute component j of tuple i, before its conversion to T.
+  double Evaluate(vtkIdType i, int j);
+  // Make room for the per-component ramps of numComp components.
+  void AllocateRamps(int numComp);
+  void ReadOnlyError(const char* method);
+
+  int ValueMode;
+
+  // Affine mode: component j of tuple i is Starts[j] + Steps[j]*i.
+  double* Starts;
+  double* Steps;
+  int NumberOfRamps;
+
+  // Structured coordinates mode.
+  int Dimensions[3];
+  double Origin[3];
+  double Spacing[3];
+
+  vtkImplicitArrayFunction* Function;
+
+  // Copy returned by GetVoidPointer(), valid until the values change.
+  T* Values;
+  vtkIdType ValuesSize;
+  int ValuesValid;
+  vtkTimeStamp ValuesTime;
+
+  double* Tuple;
+  int TupleSize;
+
+private:
+  vtkImplicitDataArrayTemplate(const vtkImplicitDataArrayTemplate&);  // Not implemented.
+  void operator=(const vtkImplicitDataArrayTemplate&);  // Not implemented.
+};
+
+#include "vtkImplicitDataArrayTemplate.txx"
+
+#endif
@@ -0,0 +1,758 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitDataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef __vtkImplicitDataArrayTemplate_txx
+#define __vtkImplicitDataArrayTemplate_txx
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkIdList.h"
+#include "vtkImplicitArrayFunction.h"
+#include "vtkTypeTraits.h"
+#include "vtkVariant.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitDataArrayTemplate<T>* vtkImplicitDataArrayTemplate<T>::New()
+{
+  vtkObject* ret = vtkObjectFactory::CreateInstance(
+    typeid(vtkImplicitDataArrayTemplate<T>).name());
+  if (ret)
+    {
+    return static_cast<vtkImplicitDataArrayTemplate<T>*>(ret);
+    }
+  return new vtkImplicitDataArrayTemplate<T>;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitDataArrayTemplate<T>::vtkImplicitDataArrayTemplate()
+{
+  this->ValueMode = VTK_IMPLICIT_ARRAY_AFFINE;
+  this->Starts = 0;
+  this->Steps = 0;
+  this->NumberOfRamps = 0;
+  for (int c = 0; c < 3; ++c)
+    {
+    this->Dimensions[c] = 0;
+    this->Origin[c] = 0.0;
+    this->Spacing[c] = 1.0;
+    }
+  this->Function = 0;
+  this->Values = 0;
+  this->ValuesSize = 0;
+  this->ValuesValid = 0;
+  this->Tuple = 0;
+  this->TupleSize = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkImplicitDataArrayTemplate<T>::~vtkImplicitDataArrayTemplate()
+{
+  if (this->Function)
+    {
+    this->Function->UnRegister(this);
+    }
+  delete [] this->Starts;
+  delete [] this->Steps;
+  free(this->Values);
+  delete [] this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->vtkDataArray::PrintSelf(os, indent);
+  os << indent << "ValueMode: ";
+  if (this->ValueMode == VTK_IMPLICIT_ARRAY_AFFINE)
+    {
+    os << "Affine\n";
+    for (int c = 0; c < this->NumberOfRamps; ++c)
+      {
+      os << indent << "Ramp " << c << ": " << this->Starts[c] << " + "
+         << this->Steps[c] << " * i\n";
+      }
+    }
+  else if (this->ValueMode == VTK_IMPLICIT_ARRAY_STRUCTURED_COORDINATES)
+    {
+    os << "Structured Coordinates\n";
+    os << indent << "Dimensions: (" << this->Dimensions[0] << ", "
+       << this->Dimensions[1] << ", " << this->Dimensions[2] << ")\n";
+    os << indent << "Origin: (" << this->Origin[0] << ", "
+       << this->Origin[1] << ", " << this->Origin[2] << ")\n";
+    os << indent << "Spacing: (" << this->Spacing[0] << ", "
+       << this->Spacing[1] << ", " << this->Spacing[2] << ")\n";
+    }
+  else
+    {
+    os << "Function\n";
+    }
+  os << indent << "Function: " << this->Function << "\n";
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkObjectBase* vtkImplicitDataArrayTemplate<T>::NewInstanceInternal() const
+{
+  return vtkDataArray::CreateDataArray(vtkTypeTraits<T>::VTKTypeID());
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkImplicitDataArrayTemplate<T>::GetDataType()
+{
+  return vtkTypeTraits<T>::VTKTypeID();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::ReadOnlyError(const char* method)
+{
+  vtkErrorMacro(<< method << " cannot modify an implicit array.");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::AllocateRamps(int numComp)
+{
+  if (numComp <= this->NumberOfRamps)
+    {
+    return;
+    }
+  double* starts = new double[numComp];
+  double* steps = new double[numComp];
+  for (int c = 0; c < numComp; ++c)
+    {
+    starts[c] = (c < this->NumberOfRamps ? this->Starts[c] : 0.0);
+    steps[c] = (c < this->NumberOfRamps ? this->Steps[c] : 0.0);
+    }
+  delete [] this->Starts;
+  delete [] this->Steps;
+  this->Starts = starts;
+  this->Steps = steps;
+  this->NumberOfRamps = numComp;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetConstantValue(double value)
+{
+  this->AllocateRamps(this->NumberOfComponents);
+  for (int c = 0; c < this->NumberOfRamps; ++c)
+    {
+    this->Starts[c] = value;
+    this->Steps[c] = 0.0;
+    }
+  this->ValueMode = VTK_IMPLICIT_ARRAY_AFFINE;
+  this->DataChanged();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetConstantTuple(const double* tuple)
+{
+  this->AllocateRamps(this->NumberOfComponents);
+  for (int c = 0; c < this->NumberOfRamps; ++c)
+    {
+    this->Starts[c] = (c < this->NumberOfComponents ? tuple[c] : 0.0);
+    this->Steps[c] = 0.0;
+    }
+  this->ValueMode = VTK_IMPLICIT_ARRAY_AFFINE;
+  this->DataChanged();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetRamp(int comp, double start,
+                                              double step)
+{
+  if (comp < 0 || comp >= this->NumberOfComponents)
+    {
+    vtkErrorMacro("Component " << comp << " out of range [0, "
+                  << this->NumberOfComponents << ").");
+    return;
+    }
+  if (this->ValueMode != VTK_IMPLICIT_ARRAY_AFFINE)
+    {
+    // Start from constant zeros.
+    for (int c = 0; c < this->NumberOfRamps; ++c)
+      {
+      this->Starts[c] = this->Steps[c] = 0.0;
+      }
+    }
+  this->AllocateRamps(this->NumberOfComponents);
+  this->Starts[comp] = start;
+  this->Steps[comp] = step;
+  this->ValueMode = VTK_IMPLICIT_ARRAY_AFFINE;
+  this->DataChanged();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetStructuredCoordinates(
+  const int dims[3], const double origin[3], const double spacing[3])
+{
+  for (int c = 0; c < 3; ++c)
+    {
+    this->Dimensions[c] = (dims[c] > 0 ? dims[c] : 0);
+    this->Origin[c] = origin[c];
+    this->Spacing[c] = spacing[c];
+    }
+  this->ValueMode = VTK_IMPLICIT_ARRAY_STRUCTURED_COORDINATES;
+  this->NumberOfComponents = 3;
+  this->SetNumberOfTuples(static_cast<vtkIdType>(this->Dimensions[0]) *
+                          this->Dimensions[1] * this->Dimensions[2]);
+  this->DataChanged();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetFunction(
+  vtkImplicitArrayFunction* function)
+{
+  if (function != this->Function)
+    {
+    vtkImplicitArrayFunction* old = this->Function;
+    this->Function = function;
+    if (function)
+      {
+      function->Register(this);
+      }
+    if (old)
+      {
+      old->UnRegister(this);
+      }
+    }
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (function)
+    {
+    this->NumberOfComponents = function->GetNumberOfComponents();
+    this->SetNumberOfTuples(numTuples);
+    }
+  this->ValueMode = VTK_IMPLICIT_ARRAY_FUNCTION;
+  this->DataChanged();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkImplicitDataArrayTemplate<T>::Allocate(vtkIdType, vtkIdType)
+{
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkImplicitDataArrayTemplate<T>::Resize(vtkIdType numTuples)
+{
+  this->SetNumberOfTuples(numTuples);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::Initialize()
+{
+  if (this->Function)
+    {
+    this->Function->UnRegister(this);
+    this->Function = 0;
+    }
+  for (int c = 0; c < this->NumberOfRamps; ++c)
+    {
+    this->Starts[c] = this->Steps[c] = 0.0;
+    }
+  this->ValueMode = VTK_IMPLICIT_ARRAY_AFFINE;
+  this->Squeeze();
+  this->Size = 0;
+  this->MaxId = -1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetNumberOfTuples(vtkIdType number)
+{
+  vtkIdType size = (number > 0 ? number * this->NumberOfComponents : 0);
+  this->Size = size;
+  this->MaxId = size - 1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double vtkImplicitDataArrayTemplate<T>::Evaluate(vtkIdType i, int j)
+{
+  switch (this->ValueMode)
+    {
+    case VTK_IMPLICIT_ARRAY_AFFINE:
+      if (j < this->NumberOfRamps)
+        {
+        return this->Starts[j] + this->Steps[j] * static_cast<double>(i);
+        }
+      break;
+    case VTK_IMPLICIT_ARRAY_STRUCTURED_COORDINATES:
+      {
+      vtkIdType idx;
+      if (j == 0)
+        {
+        idx = i % this->Dimensions[0];
+        }
+      else if (j == 1)
+        {
+        idx = (i / this->Dimensions[0]) % this->Dimensions[1];
+        }
+      else if (j == 2)
+        {
+        idx = i / (static_cast<vtkIdType>(this->Dimensions[0]) *
+                   this->Dimensions[1]);
+        }
+      else
+        {
+        break;
+        }
+      return this->Origin[j] + this->Spacing[j] * static_cast<double>(idx);
+      }
+    case VTK_IMPLICIT_ARRAY_FUNCTION:
+      if (this->Function)
+        {
+        return this->Function->EvaluateComponent(i, j);
+        }
+      break;
+    }
+  return 0.0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double* vtkImplicitDataArrayTemplate<T>::GetTuple(vtkIdType i)
+{
+  if (this->TupleSize < this->NumberOfComponents)
+    {
+    delete [] this->Tuple;
+    this->TupleSize = this->NumberOfComponents;
+    this->Tuple = new double[this->TupleSize];
+    }
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  int numComp = this->NumberOfComponents;
+  if (this->ValueMode == VTK_IMPLICIT_ARRAY_FUNCTION && this->Function &&
+      this->Function->GetNumberOfComponents() == numComp)
+    {
+    // One call for the whole tuple.
+    this->Function->EvaluateTuple(i, tuple);
+    for (int c = 0; c < numComp; ++c)
+      {
+      tuple[c] = static_cast<double>(static_cast<T>(tuple[c]));
+      }
+    return;
+    }
+  for (int c = 0; c < numComp; ++c)
+    {
+    tuple[c] = static_cast<double>(static_cast<T>(this->Evaluate(i, c)));
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::GetTupleValue(vtkIdType i, T* tuple)
+{
+  int numComp = this->NumberOfComponents;
+  if (this->ValueMode == VTK_IMPLICIT_ARRAY_FUNCTION && this->Function &&
+      this->Function->GetNumberOfComponents() == numComp)
+    {
+    double local[16];
+    double* values = (numComp <= 16 ? local : new double[numComp]);
+    this->Function->EvaluateTuple(i, values);
+    for (int c = 0; c < numComp; ++c)
+      {
+      tuple[c] = static_cast<T>(values[c]);
+      }
+    if (values != local)
+      {
+      delete [] values;
+      }
+    return;
+    }
+  for (int c = 0; c < numComp; ++c)
+    {
+    tuple[c] = static_cast<T>(this->Evaluate(i, c));
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double vtkImplicitDataArrayTemplate<T>::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(static_cast<T>(this->Evaluate(i, j)));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkImplicitDataArrayTemplate<T>::GetValue(vtkIdType id)
+{
+  int numComp = this->NumberOfComponents;
+  return static_cast<T>(this->Evaluate(id / numComp, id % numComp));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkVariant vtkImplicitDataArrayTemplate<T>::GetVariantValue(vtkIdType id)
+{
+  return vtkVariant(this->GetValue(id));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::ComputeScalarRange(int comp)
+{
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (this->ValueMode == VTK_IMPLICIT_ARRAY_FUNCTION || numTuples < 1)
+    {
+    this->vtkDataArray::ComputeScalarRange(comp);
+    return;
+    }
+  // Each component is monotonic in the tuple index.
+  double s[2];
+  s[0] = this->GetComponent(0, comp);
+  s[1] = this->GetComponent(numTuples - 1, comp);
+  for (int k = 0; k < 2; ++k)
+    {
+    if (s[k] < this->Range[0])
+      {
+      this->Range[0] = s[k];
+      }
+    if (s[k] > this->Range[1])
+      {
+      this->Range[1] = s[k];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetTuple(vtkIdType, vtkIdType,
+                                               vtkAbstractArray*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertTuple(vtkIdType, vtkIdType,
+                                                  vtkAbstractArray*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::InsertNextTuple(vtkIdType,
+                                                           vtkAbstractArray*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetTuple(vtkIdType, const float*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetTuple(vtkIdType, const double*)
+{
+  this->ReadOnlyError("SetTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertTuple(vtkIdType, const float*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertTuple(vtkIdType, const double*)
+{
+  this->ReadOnlyError("InsertTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::InsertNextTuple(const float*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::InsertNextTuple(const double*)
+{
+  this->ReadOnlyError("InsertNextTuple");
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::RemoveTuple(vtkIdType)
+{
+  this->ReadOnlyError("RemoveTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::RemoveFirstTuple()
+{
+  this->ReadOnlyError("RemoveFirstTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::RemoveLastTuple()
+{
+  this->ReadOnlyError("RemoveLastTuple");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetComponent(vtkIdType, int, double)
+{
+  this->ReadOnlyError("SetComponent");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::InsertComponent(vtkIdType, int, double)
+{
+  this->ReadOnlyError("InsertComponent");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetVariantValue(vtkIdType, vtkVariant)
+{
+  this->ReadOnlyError("SetVariantValue");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkImplicitDataArrayTemplate<T>::WriteVoidPointer(vtkIdType, vtkIdType)
+{
+  this->ReadOnlyError("WriteVoidPointer");
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::SetVoidArray(void*, vtkIdType, int)
+{
+  this->ReadOnlyError("SetVoidArray");
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkImplicitDataArrayTemplate<T>::GetVoidPointer(vtkIdType id)
+{
+  // The copy is kept until the values change: see DataChanged().
+  if (this->ValuesValid &&
+      (!this->Function || this->Function->GetMTime() < this->ValuesTime))
+    {
+    return this->Values + id;
+    }
+  vtkIdType size = this->MaxId + 1;
+  if (size > this->ValuesSize)
+    {
+    free(this->Values);
+    this->Values =
+      static_cast<T*>(malloc(static_cast<size_t>(size) * sizeof(T)));
+    if (!this->Values)
+      {
+      vtkErrorMacro("Unable to allocate " << size
+                    << " elements of size " << sizeof(T) << " bytes. ");
+      this->ValuesSize = 0;
+      this->ValuesValid = 0;
+      return 0;
+      }
+    this->ValuesSize = size;
+    }
+  this->ExportToVoidPointer(this->Values);
+  this->ValuesValid = 1;
+  this->ValuesTime.Modified();
+  return this->Values + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::ExportToVoidPointer(void *out_ptr)
+{
+  T* out = static_cast<T*>(out_ptr);
+  int numComp = this->NumberOfComponents;
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  for (vtkIdType i = 0; out && i < numTuples; ++i)
+    {
+    this->GetTupleValue(i, out + i*numComp);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::DeepCopy(vtkDataArray* da)
+{
+  if (da == NULL || da == this)
+    {
+    return;
+    }
+
+  vtkImplicitDataArrayTemplate<T>* ia =
+    vtkImplicitDataArrayTemplate<T>::SafeDownCast(da);
+  if (!ia)
+    {
+    vtkErrorMacro("Cannot copy a " << da->GetClassName()
+                  << " into an implicit array.");
+    return;
+    }
+
+  this->Initialize();
+  this->NumberOfComponents = ia->NumberOfComponents;
+  this->AllocateRamps(ia->NumberOfRamps);
+  for (int c = 0; c < ia->NumberOfRamps; ++c)
+    {
+    this->Starts[c] = ia->Starts[c];
+    this->Steps[c] = ia->Steps[c];
+    }
+  for (int c = 0; c < 3; ++c)
+    {
+    this->Dimensions[c] = ia->Dimensions[c];
+    this->Origin[c] = ia->Origin[c];
+    this->Spacing[c] = ia->Spacing[c];
+    }
+  this->Function = ia->Function;
+  if (this->Function)
+    {
+    this->Function->Register(this);
+    }
+  this->ValueMode = ia->ValueMode;
+  this->SetNumberOfTuples(ia->GetNumberOfTuples());
+  this->vtkAbstractArray::DeepCopy(da);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::Squeeze()
+{
+  free(this->Values);
+  this->Values = 0;
+  this->ValuesSize = 0;
+  this->ValuesValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::DataChanged()
+{
+  this->ValuesValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::Modified()
+{
+  this->ValuesValid = 0;
+  this->vtkDataArray::Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkArrayIterator* vtkImplicitDataArrayTemplate<T>::NewIterator()
+{
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+unsigned long vtkImplicitDataArrayTemplate<T>::GetActualMemorySize()
+{
+  double size = sizeof(*this) +
+    2.0 * this->NumberOfRamps * sizeof(double) +
+    static_cast<double>(this->ValuesSize) * sizeof(T);
+  // kilobytes
+  return static_cast<unsigned long>(ceil(size / 1024.0));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkImplicitDataArrayTemplate<T>::LookupValue(vtkVariant value)
+{
+  T* dummyPtr = 0;
+  bool valid;
+  T val = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    for (vtkIdType i = 0; i <= this->MaxId; ++i)
+      {
+      if (this->GetValue(i) == val)
+        {
+        return i;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkImplicitDataArrayTemplate<T>::LookupValue(vtkVariant value,
+                                                  vtkIdList* ids)
+{
+  ids->Reset();
+  T* dummyPtr = 0;
+  bool valid;
+  T val = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    for (vtkIdType i = 0; i <= this->MaxId; ++i)
+      {
+      if (this->GetValue(i) == val)
+        {
+        ids->InsertNextId(i);
+        }
+      }
+    }
+}
+
+#endif
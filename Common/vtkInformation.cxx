@@ -124,6 +124,37 @@ int vtkInformation::GetNumberOfKeys()
   return numberOfKeys;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkInformation::GetActualMemorySize()
+{
+  typedef vtkInformationInternals::MapType MapType;
+  MapType &map = this->Internal->Map;
+  // The buckets, then for each entry the hash node and a value object.
+  size_t size = map.bucket_count() * sizeof(void*);
+  for (MapType::iterator i = map.begin(); i != map.end(); ++i)
+    {
+    size += 3 * sizeof(void*) + sizeof(vtkObjectBase);
+    vtkInformationKey *key = i->first;
+    if (vtkInformationIntegerVectorKey *ikey =
+        vtkInformationIntegerVectorKey::SafeDownCast(key))
+      {
+      size += ikey->Length(this) * sizeof(int);
+      }
+    else if (vtkInformationDoubleVectorKey *dkey =
+             vtkInformationDoubleVectorKey::SafeDownCast(key))
+      {
+      size += dkey->Length(this) * sizeof(double);
+      }
+    else if (vtkInformationStringKey *skey =
+             vtkInformationStringKey::SafeDownCast(key))
+      {
+      const char *value = skey->Get(this);
+      size += value ? strlen(value) : 0;
+      }
+    }
+  return static_cast<unsigned long>((size + 1023) / 1024); //kilobytes
+}
+
 //----------------------------------------------------------------------------
 void vtkInformation::SetAsObjectBase(vtkInformationKey* key,
                                      vtkObjectBase* newvalue)
@@ -95,6 +95,13 @@ public:
   // by iterating over the keys).
   VTK_COMMON_EXPORT int GetNumberOfKeys();
 
+  // Description:
+  // Return an estimate of the memory used by the entries of this
+  // information object, in kilobytes: the hash table, the value objects
+  // and the contents of vector and string values.  Objects stored as
+  // values (data objects, nested information, ...) are not included.
+  VTK_COMMON_EXPORT unsigned long GetActualMemorySize();
+
   // Description:
   // Copy all information entries from the given vtkInformation
   // instance.  Any previously existing entries are removed.  If
@@ -16,6 +16,8 @@
 
 #include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkTimerLog.h"
 #include "vtkWindows.h"
 
 vtkStandardNewMacro(vtkMultiThreader);
@@ -143,6 +145,29 @@ int vtkMultiThreader::GetGlobalDefaultNumberOfThreads()
   return vtkMultiThreaderGlobalDefaultNumberOfThreads;
 }
 
+// 0 => threads are created on each execute.
+static int vtkMultiThreaderGlobalDefaultUseThreadPool = 0;
+
+void vtkMultiThreader::SetGlobalDefaultUseThreadPool(int val)
+{
+  vtkMultiThreaderGlobalDefaultUseThreadPool = val;
+}
+
+int vtkMultiThreader::GetGlobalDefaultUseThreadPool()
+{
+  return vtkMultiThreaderGlobalDefaultUseThreadPool;
+}
+
+void vtkMultiThreader::SetThreadPoolSize(int val)
+{
+  vtkSMPThreadPool::GetGlobalPool()->SetNumberOfThreads(val);
+}
+
+int vtkMultiThreader::GetThreadPoolSize()
+{
+  return vtkSMPThreadPool::GetGlobalPool()->GetNumberOfThreads();
+}
+
 // Constructor. Default all the methods to NULL. Since the
 // ThreadInfoArray is static, the ThreadIDs can be initialized here
 // and will not change.
@@ -164,7 +189,8 @@ vtkMultiThreader::vtkMultiThreader()
   this->SingleMethod = NULL;
   this->NumberOfThreads = 
     vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
-
+  this->UseThreadPool = vtkMultiThreaderGlobalDefaultUseThreadPool;
+  this->LastDispatchLatency = 0.0;
 }
 
 // Destructor. Nothing allocated so nothing needs to be done here.
@@ -258,7 +284,14 @@ void vtkMultiThreader::SingleMethodExecute()
     {
     this->NumberOfThreads = vtkMultiThreaderGlobalMaximumNumberOfThreads;
     }
-  
+
+  if (this->UseThreadPool && this->PooledExecute(0))
+    {
+    return;
+    }
+
+  double dispatchStart = vtkTimerLog::GetUniversalTime();
+  this->LastDispatchLatency = 0.0;
     
   // We are using sproc (on SGIs), pthreads(on Suns), or a single thread
   // (the default)  
@@ -286,6 +319,9 @@ void vtkMultiThreader::SingleMethodExecute()
       } 
     }
   
+  this->LastDispatchLatency =
+    vtkTimerLog::GetUniversalTime() - dispatchStart;
+
   // Now, the parent thread calls this->SingleMethod() itself
   this->ThreadInfoArray[0].UserData = this->SingleData;
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
@@ -329,6 +365,9 @@ void vtkMultiThreader::SingleMethodExecute()
       }
     }
   
+  this->LastDispatchLatency =
+    vtkTimerLog::GetUniversalTime() - dispatchStart;
+
   // Now, the parent thread calls this->SingleMethod() itself
   this->ThreadInfoArray[0].UserData        = this->SingleData;
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
@@ -388,6 +427,9 @@ void vtkMultiThreader::SingleMethodExecute()
 #endif
     }
   
+  this->LastDispatchLatency =
+    vtkTimerLog::GetUniversalTime() - dispatchStart;
+
   // Now, the parent thread calls this->SingleMethod() itself
   this->ThreadInfoArray[0].UserData        = this->SingleData;
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
@@ -405,6 +447,7 @@ void vtkMultiThreader::SingleMethodExecute()
 #ifndef VTK_USE_SPROC
 #ifndef VTK_USE_PTHREADS
   // There is no multi threading, so there is only one thread.
+  (void)dispatchStart;
   this->ThreadInfoArray[0].UserData        = this->SingleData;
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
   this->SingleMethod( (void *)(&this->ThreadInfoArray[0]) );
@@ -448,6 +491,14 @@ void vtkMultiThreader::MultipleMethodExecute()
       }
     }
 
+  if (this->UseThreadPool && this->PooledExecute(1))
+    {
+    return;
+    }
+
+  double dispatchStart = vtkTimerLog::GetUniversalTime();
+  this->LastDispatchLatency = 0.0;
+
   // We are using sproc (on SGIs), pthreads(on Suns), CreateThread
   // on a PC or a single thread (the default)  
 
@@ -476,6 +527,9 @@ void vtkMultiThreader::MultipleMethodExecute()
       } 
     }
   
+  this->LastDispatchLatency =
+    vtkTimerLog::GetUniversalTime() - dispatchStart;
+
   // Now, the parent thread calls the last method itself
   this->ThreadInfoArray[0].UserData        = this->MultipleData[0];
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
@@ -517,6 +571,9 @@ void vtkMultiThreader::MultipleMethodExecute()
              ( (void *)(&this->ThreadInfoArray[thread_loop]) ) );
     }
   
+  this->LastDispatchLatency =
+    vtkTimerLog::GetUniversalTime() - dispatchStart;
+
   // Now, the parent thread calls the last method itself
   this->ThreadInfoArray[0].UserData        = this->MultipleData[0];
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
@@ -573,6 +630,9 @@ void vtkMultiThreader::MultipleMethodExecute()
 #endif
     }
   
+  this->LastDispatchLatency =
+    vtkTimerLog::GetUniversalTime() - dispatchStart;
+
   // Now, the parent thread calls the last method itself
   this->ThreadInfoArray[0].UserData = this->MultipleData[0];
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
@@ -590,6 +650,7 @@ void vtkMultiThreader::MultipleMethodExecute()
 #ifndef VTK_USE_SPROC
 #ifndef VTK_USE_PTHREADS
   // There is no multi threading, so there is only one thread.
+  (void)dispatchStart;
   this->ThreadInfoArray[0].UserData        = this->MultipleData[0];
   this->ThreadInfoArray[0].NumberOfThreads = this->NumberOfThreads;
   (this->MultipleMethod[0])( (void *)(&this->ThreadInfoArray[0]) );
@@ -598,6 +659,63 @@ void vtkMultiThreader::MultipleMethodExecute()
 #endif
 }
 
+//----------------------------------------------------------------------------
+// Job run by the thread pool for a pooled execute: each logical thread
+// calls its method with its ThreadInfo and records when it started.
+class vtkMultiThreaderPoolJob
+{
+public:
+  vtkMultiThreader *Self;
+  int Multiple;
+  double StartTimes[VTK_MAX_THREADS];
+
+  static void Run(void *data, int threadId)
+    {
+    vtkMultiThreaderPoolJob *job = static_cast<vtkMultiThreaderPoolJob *>(data);
+    job->StartTimes[threadId] = vtkTimerLog::GetUniversalTime();
+    vtkMultiThreader *self = job->Self;
+    vtkThreadFunctionType method = job->Multiple ?
+      self->MultipleMethod[threadId] : self->SingleMethod;
+    (*method)((void *)(&self->ThreadInfoArray[threadId]));
+    }
+};
+
+// Return 0, without running anything, if the pool cannot run the methods
+// concurrently.
+int vtkMultiThreader::PooledExecute(int multiple)
+{
+  vtkSMPThreadPool *pool = vtkSMPThreadPool::GetGlobalPool();
+  if (pool->PrepareExecute(this->NumberOfThreads) < this->NumberOfThreads)
+    {
+    return 0;
+    }
+
+  vtkMultiThreaderPoolJob job;
+  job.Self = this;
+  job.Multiple = multiple;
+
+  for (int i = 0; i < this->NumberOfThreads; i++)
+    {
+    this->ThreadInfoArray[i].UserData =
+      multiple ? this->MultipleData[i] : this->SingleData;
+    this->ThreadInfoArray[i].NumberOfThreads = this->NumberOfThreads;
+    }
+
+  double dispatchStart = vtkTimerLog::GetUniversalTime();
+  pool->Execute(this->NumberOfThreads, &vtkMultiThreaderPoolJob::Run, &job);
+
+  double lastStart = dispatchStart;
+  for (int i = 0; i < this->NumberOfThreads; i++)
+    {
+    if (job.StartTimes[i] > lastStart)
+      {
+      lastStart = job.StartTimes[i];
+      }
+    }
+  this->LastDispatchLatency = lastStart - dispatchStart;
+  return 1;
+}
+
 int vtkMultiThreader::SpawnThread( vtkThreadFunctionType f, void *userdata )
 {
   int id;
@@ -648,6 +766,8 @@ int vtkMultiThreader::SpawnThread( vtkThreadFunctionType f, void *userdata )
   if (this->SpawnedThreadProcessID[id] == NULL)
     {
     vtkErrorMacro("Error in thread creation !!!");
+    this->SpawnedThreadActiveFlag[id] = 0;
+    id = -1;
     } 
 #endif
 
@@ -674,15 +794,22 @@ int vtkMultiThreader::SpawnThread( vtkThreadFunctionType f, void *userdata )
 #endif
   
 #ifdef VTK_HP_PTHREADS
-  pthread_create( &(this->SpawnedThreadProcessID[id]),
-                  attr, f,  
+  int threadError = pthread_create( &(this->SpawnedThreadProcessID[id]),
+                                    attr, f,  
                   ( (void *)(&this->SpawnedThreadInfoArray[id]) ) );
 #else
-  pthread_create( &(this->SpawnedThreadProcessID[id]),
-                  &attr,
+  int threadError = pthread_create( &(this->SpawnedThreadProcessID[id]),
+                                    &attr,
                   reinterpret_cast<vtkExternCThreadFunctionType>(f),  
                   ( (void *)(&this->SpawnedThreadInfoArray[id]) ) );
 #endif
+  if (threadError)
+    {
+    vtkErrorMacro("Unable to create a thread.  pthread_create() returned "
+                  << threadError);
+    this->SpawnedThreadActiveFlag[id] = 0;
+    id = -1;
+    }
 
 #endif
 
@@ -829,6 +956,10 @@ void vtkMultiThreader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Thread Count: " << this->NumberOfThreads << "\n";
   os << indent << "Global Maximum Number Of Threads: " << 
     vtkMultiThreaderGlobalMaximumNumberOfThreads << endl;
+  os << indent << "Use Thread Pool: "
+     << (this->UseThreadPool ? "On" : "Off") << endl;
+  os << indent << "Last Dispatch Latency: "
+     << this->LastDispatchLatency << endl;
   os << "Thread system used: " <<
 #ifdef VTK_USE_PTHREADS  
    "PTHREADS"
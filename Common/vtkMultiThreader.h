@@ -138,6 +138,42 @@ public:
   static void SetGlobalDefaultNumberOfThreads(int val);
   static int  GetGlobalDefaultNumberOfThreads();
 
+  // Description:
+  // Turn on/off the execution of SingleMethodExecute and
+  // MultipleMethodExecute on the persistent threads of the process wide
+  // vtkSMPThreadPool instead of creating and joining NumberOfThreads
+  // threads on every call.  The methods are called with the same
+  // ThreadInfo structure in both modes, and always run concurrently so
+  // that they may wait for each other: when the pool cannot give a thread
+  // to each of them, because the call is made from a pool thread or the
+  // workers could not be created, dedicated threads are spawned as with
+  // UseThreadPool off.  The initial value is given by
+  // GetGlobalDefaultUseThreadPool().
+  vtkSetMacro(UseThreadPool, int);
+  vtkGetMacro(UseThreadPool, int);
+  vtkBooleanMacro(UseThreadPool, int);
+
+  // Description:
+  // Set/Get the initial value of UseThreadPool for new multithreaders.
+  // Off by default.
+  static void SetGlobalDefaultUseThreadPool(int val);
+  static int  GetGlobalDefaultUseThreadPool();
+
+  // Description:
+  // Set/Get the number of threads of the process wide thread pool, the
+  // calling thread included.  Setting it creates the missing worker
+  // threads right away.  The pool grows on demand when a pooled execute
+  // asks for more threads.
+  static void SetThreadPoolSize(int val);
+  static int  GetThreadPoolSize();
+
+  // Description:
+  // Return the dispatch latency, in seconds, of the last
+  // SingleMethodExecute or MultipleMethodExecute call: the time it took
+  // until all the threads were running the method.  When
+  // UseThreadPool is off this is the time spent creating the threads.
+  vtkGetMacro(LastDispatchLatency, double);
+
   // These methods are excluded from Tcl wrapping 1) because the
   // wrapper gives up on them and 2) because they really shouldn't be
   // called from a script anyway.
@@ -170,7 +206,8 @@ public:
   // Description:
   // Create a new thread for the given function. Return a thread id
   // which is a number between 0 and VTK_MAX_THREADS - 1. This id should
-  // be used to kill the thread at a later time.
+  // be used to kill the thread at a later time. Return -1 if the thread
+  // could not be created.
   int SpawnThread( vtkThreadFunctionType, void *data );
 
   // Description:
@@ -197,6 +234,14 @@ protected:
   // The number of threads to use
   int                        NumberOfThreads;
 
+  // Dispatch to the persistent thread pool
+  int                        UseThreadPool;
+  double                     LastDispatchLatency;
+
+  // Run the methods on the thread pool.  Return 0 if it cannot run them
+  // concurrently.
+  int PooledExecute(int multiple);
+
   // An array of thread info containing a thread id
   // (0, 1, 2, .. VTK_MAX_THREADS-1), the thread count, and a pointer
   // to void so that user data can be passed to each thread
@@ -220,6 +265,8 @@ protected:
   void                       *MultipleData[VTK_MAX_THREADS];
 
 private:
+  friend class vtkMultiThreaderPoolJob;
+
   vtkMultiThreader(const vtkMultiThreader&);  // Not implemented.
   void operator=(const vtkMultiThreader&);  // Not implemented.
 };
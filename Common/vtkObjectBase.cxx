@@ -14,6 +14,7 @@
 =========================================================================*/
 
 #include "vtkObjectBase.h"
+#include "vtkAtomicOperations.h"
 #include "vtkDebugLeaks.h"
 #include "vtkGarbageCollector.h"
 #include "vtkWeakPointerBase.h"
@@ -252,7 +253,7 @@ void vtkObjectBase::RegisterInternal(vtkObjectBase*, int check)
   if(!(check &&
        vtkObjectBaseToGarbageCollectorFriendship::TakeReference(this)))
     {
-    ++this->ReferenceCount;
+    vtkAtomicOperations::Increment(&this->ReferenceCount);
     }
 }
 
@@ -268,7 +269,7 @@ void vtkObjectBase::UnRegisterInternal(vtkObjectBase*, int check)
     }
 
   // Decrement the reference count, delete object if count goes to zero.
-  if(--this->ReferenceCount <= 0)
+  if(vtkAtomicOperations::Decrement(&this->ReferenceCount) <= 0)
     {
     // Clear all weak pointers to the object before deleting it.
     if (this->WeakPointers)
@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadLocal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadLocal - thread local storage for vtkSMPTools functors
+// .SECTION Description
+// vtkSMPThreadLocal holds one instance of T per thread of the
+// vtkSMPThreadPool.  Local() returns the instance of the calling thread,
+// which is created as a copy of the exemplar given to the constructor
+// the first time the thread asks for it.  Once the parallel section is
+// over, the instances that were actually used can be visited with the
+// iterator, typically to combine per-thread partial results in the
+// Reduce() method of a vtkSMPTools functor.
+//
+// Each instance lives in its own cache line to avoid false sharing
+// between threads updating small values such as counters.
+//
+// Local() must only be called from within vtkSMPTools::For() or from
+// the thread that owns the object.  Iterating is not thread safe.
+// .SECTION See Also
+// vtkSMPTools vtkSMPThreadPool
+
+#ifndef __vtkSMPThreadLocal_h
+#define __vtkSMPThreadLocal_h
+
+#include "vtkSMPThreadPool.h"
+
+//BTX
+template <typename T>
+class vtkSMPThreadLocal
+{
+  struct Slot
+  {
+    T Value;
+    int Initialized;
+    char Padding[64];
+  };
+
+public:
+  // Description:
+  // Default constructor: the per-thread instances are default
+  // constructed.
+  vtkSMPThreadLocal() : Exemplar()
+    {
+    this->Initialize();
+    }
+
+  // Description:
+  // The per-thread instances are copies of the exemplar.
+  explicit vtkSMPThreadLocal(const T& exemplar) : Exemplar(exemplar)
+    {
+    this->Initialize();
+    }
+
+  ~vtkSMPThreadLocal()
+    {
+    delete [] this->Slots;
+    }
+
+  // Description:
+  // Return the instance of the calling thread, creating it from the
+  // exemplar on first access.
+  T& Local()
+    {
+    Slot& slot = this->Slots[vtkSMPThreadPool::GetThreadIndex()];
+    if (!slot.Initialized)
+      {
+      slot.Value = this->Exemplar;
+      slot.Initialized = 1;
+      }
+    return slot.Value;
+    }
+
+  // Description:
+  // Return the number of threads that have called Local().
+  size_t size() const
+    {
+    size_t count = 0;
+    for (int i = 0; i < VTK_MAX_THREADS; ++i)
+      {
+      count += (this->Slots[i].Initialized ? 1 : 0);
+      }
+    return count;
+    }
+
+  // Description:
+  // Forget all the per-thread instances.  The next call to Local() on
+  // any thread copies the exemplar again.
+  void Clear()
+    {
+    for (int i = 0; i < VTK_MAX_THREADS; ++i)
+      {
+      this->Slots[i].Initialized = 0;
+      }
+    }
+
+  // Description:
+  // Iterator over the per-thread instances that have been created.
+  class iterator;
+  friend class iterator;
+  class iterator
+  {
+  public:
+    iterator() : Owner(0), Index(0) {}
+    iterator& operator++()
+      {
+      this->Index = this->Owner->NextInitialized(this->Index + 1);
+      return *this;
+      }
+    bool operator==(const iterator& other) const
+      {
+      return this->Index == other.Index && this->Owner == other.Owner;
+      }
+    bool operator!=(const iterator& other) const
+      {
+      return !(*this == other);
+      }
+    T& operator*()
+      {
+      return this->Owner->Slots[this->Index].Value;
+      }
+    T* operator->()
+      {
+      return &this->Owner->Slots[this->Index].Value;
+      }
+
+  private:
+    friend class vtkSMPThreadLocal<T>;
+    iterator(vtkSMPThreadLocal<T>* owner, int index)
+      : Owner(owner), Index(index) {}
+    vtkSMPThreadLocal<T>* Owner;
+    int Index;
+  };
+
+  iterator begin()
+    {
+    return iterator(this, this->NextInitialized(0));
+    }
+  iterator end()
+    {
+    return iterator(this, VTK_MAX_THREADS);
+    }
+
+private:
+  void Initialize()
+    {
+    this->Slots = new Slot[VTK_MAX_THREADS];
+    this->Clear();
+    }
+
+  int NextInitialized(int index) const
+    {
+    while (index < VTK_MAX_THREADS && !this->Slots[index].Initialized)
+      {
+      ++index;
+      }
+    return index;
+    }
+
+  Slot* Slots;
+  T Exemplar;
+
+  vtkSMPThreadLocal(const vtkSMPThreadLocal&);  // Not implemented.
+  void operator=(const vtkSMPThreadLocal&);  // Not implemented.
+};
+//ETX
+
+#endif
@@ -0,0 +1,376 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPThreadPool.h"
+
+#include "vtkConditionVariable.h"
+#include "vtkCriticalSection.h"
+#include "vtkDebugLeaksManager.h" // DebugLeaks exists longer than the pool.
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkWindows.h"
+
+//----------------------------------------------------------------------------
+// Per-thread state.  The value stored for each thread is
+// 2*index + inJob, where index is the pool index of the thread (0 for
+// threads that are not workers) and inJob is 1 while the thread runs a
+// job of the pool.
+#if defined(VTK_USE_PTHREADS)
+static pthread_key_t vtkSMPThreadPoolKey;
+static pthread_once_t vtkSMPThreadPoolKeyOnce = PTHREAD_ONCE_INIT;
+extern "C" { static void vtkSMPThreadPoolCreateKey()
+{
+  pthread_key_create(&vtkSMPThreadPoolKey, 0);
+} }
+
+static int vtkSMPThreadPoolGetState()
+{
+  pthread_once(&vtkSMPThreadPoolKeyOnce, vtkSMPThreadPoolCreateKey);
+  return static_cast<int>(reinterpret_cast<size_t>(
+    pthread_getspecific(vtkSMPThreadPoolKey)));
+}
+
+static void vtkSMPThreadPoolSetState(int state)
+{
+  pthread_once(&vtkSMPThreadPoolKeyOnce, vtkSMPThreadPoolCreateKey);
+  pthread_setspecific(vtkSMPThreadPoolKey,
+                      reinterpret_cast<void *>(static_cast<size_t>(state)));
+}
+#elif defined(VTK_USE_WIN32_THREADS)
+static DWORD vtkSMPThreadPoolKey = TlsAlloc();
+
+static int vtkSMPThreadPoolGetState()
+{
+  return static_cast<int>(reinterpret_cast<size_t>(
+    TlsGetValue(vtkSMPThreadPoolKey)));
+}
+
+static void vtkSMPThreadPoolSetState(int state)
+{
+  TlsSetValue(vtkSMPThreadPoolKey,
+              reinterpret_cast<void *>(static_cast<size_t>(state)));
+}
+#else
+// No threads, a single state is enough.
+static int vtkSMPThreadPoolState = 0;
+
+static int vtkSMPThreadPoolGetState()
+{
+  return vtkSMPThreadPoolState;
+}
+
+static void vtkSMPThreadPoolSetState(int state)
+{
+  vtkSMPThreadPoolState = state;
+}
+#endif
+
+//----------------------------------------------------------------------------
+// The global pool is destroyed, and its workers joined, when the static
+// instance of this class goes away at exit.
+class vtkSMPThreadPoolCleanup
+{
+public:
+  vtkSMPThreadPoolCleanup() : Pool(0) {}
+  ~vtkSMPThreadPoolCleanup() { delete this->Pool; }
+  vtkSMPThreadPool *Pool;
+};
+
+static vtkSMPThreadPoolCleanup vtkSMPThreadPoolGlobal;
+static vtkSimpleCriticalSection vtkSMPThreadPoolGlobalLock;
+
+//----------------------------------------------------------------------------
+vtkSMPThreadPool *vtkSMPThreadPool::GetGlobalPool()
+{
+  if (!vtkSMPThreadPoolGlobal.Pool)
+    {
+    vtkSMPThreadPoolGlobalLock.Lock();
+    if (!vtkSMPThreadPoolGlobal.Pool)
+      {
+      vtkSMPThreadPoolGlobal.Pool = new vtkSMPThreadPool;
+      }
+    vtkSMPThreadPoolGlobalLock.Unlock();
+    }
+  return vtkSMPThreadPoolGlobal.Pool;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPThreadPool::GetThreadIndex()
+{
+  return vtkSMPThreadPoolGetState() >> 1;
+}
+
+//----------------------------------------------------------------------------
+vtkSMPThreadPool::vtkSMPThreadPool()
+{
+  this->Threader = vtkMultiThreader::New();
+  this->NumberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  this->NumberOfWorkers = 0;
+  for (int i = 0; i < VTK_MAX_THREADS; ++i)
+    {
+    this->WorkerIds[i] = -1;
+    this->WorkerGenerations[i] = 0;
+    }
+
+  this->Lock = new vtkSimpleMutexLock;
+  this->WakeCondition = new vtkSimpleConditionVariable;
+  this->DoneCondition = new vtkSimpleConditionVariable;
+  this->ExecuteLock = new vtkSimpleCriticalSection;
+
+  this->JobMethod = 0;
+  this->JobData = 0;
+  this->JobNumberOfThreads = 0;
+  this->PendingWorkers = 0;
+  this->Generation = 0;
+  this->ShuttingDown = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSMPThreadPool::~vtkSMPThreadPool()
+{
+  this->TerminateWorkers();
+  this->Threader->Delete();
+  delete this->Lock;
+  delete this->WakeCondition;
+  delete this->DoneCondition;
+  delete this->ExecuteLock;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPThreadPool::SetNumberOfThreads(int num)
+{
+  num = (num < 1 ? 1 : (num > VTK_MAX_THREADS ? VTK_MAX_THREADS : num));
+  this->ExecuteLock->Lock();
+  this->NumberOfThreads = num;
+  this->SpawnWorkers(num - 1);
+  this->ExecuteLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPThreadPool::GetNumberOfThreads()
+{
+  int num = this->NumberOfThreads;
+  int globalMax = vtkMultiThreader::GetGlobalMaximumNumberOfThreads();
+  if (globalMax > 0 && num > globalMax)
+    {
+    num = globalMax;
+    }
+  return num;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPThreadPool::GetNumberOfWorkers()
+{
+  return this->NumberOfWorkers;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkSMPThreadPool::GetNumberOfDispatches()
+{
+  return this->Generation;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMPThreadPool::IsInParallelScope()
+{
+  return (vtkSMPThreadPoolGetState() & 1) != 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPThreadPool::PrepareExecute(int numberOfThreads)
+{
+  if (numberOfThreads > VTK_MAX_THREADS)
+    {
+    numberOfThreads = VTK_MAX_THREADS;
+    }
+  if (numberOfThreads <= 1 || this->IsInParallelScope())
+    {
+    return 1;
+    }
+
+  this->ExecuteLock->Lock();
+  this->SpawnWorkers(numberOfThreads - 1);
+  int concurrent = this->NumberOfWorkers + 1;
+  this->ExecuteLock->Unlock();
+  return concurrent < numberOfThreads ? concurrent : numberOfThreads;
+}
+
+//----------------------------------------------------------------------------
+// Must be called with the ExecuteLock held so that no job is running.
+void vtkSMPThreadPool::SpawnWorkers(int numberOfWorkers)
+{
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+  if (numberOfWorkers > VTK_MAX_THREADS - 1)
+    {
+    numberOfWorkers = VTK_MAX_THREADS - 1;
+    }
+  while (this->NumberOfWorkers < numberOfWorkers)
+    {
+    // Workers learn their index from their position in WorkerIds, which
+    // is filled before the thread can look at it.
+    int index = this->NumberOfWorkers + 1;
+    this->Lock->Lock();
+    int id = this->Threader->SpawnThread(&vtkSMPThreadPool::WorkerMain, this);
+    if (id < 0)
+      {
+      this->Lock->Unlock();
+      break;
+      }
+    this->WorkerIds[index] = id;
+    this->WorkerGenerations[index] = this->Generation;
+    this->NumberOfWorkers = index;
+    this->Lock->Unlock();
+    }
+#else
+  (void)numberOfWorkers;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPThreadPool::TerminateWorkers()
+{
+  this->Lock->Lock();
+  this->ShuttingDown = 1;
+  this->WakeCondition->Broadcast();
+  this->Lock->Unlock();
+  for (int i = 1; i <= this->NumberOfWorkers; ++i)
+    {
+    this->Threader->TerminateThread(this->WorkerIds[i]);
+    this->WorkerIds[i] = -1;
+    }
+  this->NumberOfWorkers = 0;
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkSMPThreadPool::WorkerMain(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkSMPThreadPool *self = static_cast<vtkSMPThreadPool *>(info->UserData);
+
+  // Find our index.  SpawnWorkers() holds the lock until WorkerIds is
+  // up to date.  Jobs started after the spawn must not be missed, so the
+  // generation to wait from is the one recorded at spawn time.
+  self->Lock->Lock();
+  int index = 0;
+  for (int i = 1; i < VTK_MAX_THREADS; ++i)
+    {
+    if (self->WorkerIds[i] == info->ThreadID)
+      {
+      index = i;
+      break;
+      }
+    }
+  unsigned long generation = self->WorkerGenerations[index];
+  self->Lock->Unlock();
+
+  vtkSMPThreadPoolSetState(2 * index + 1);
+
+  self->Lock->Lock();
+  for (;;)
+    {
+    while (!self->ShuttingDown && self->Generation == generation)
+      {
+      self->WakeCondition->Wait(*self->Lock);
+      }
+    if (self->ShuttingDown)
+      {
+      break;
+      }
+    generation = self->Generation;
+    if (index < self->JobNumberOfThreads)
+      {
+      JobFunction method = self->JobMethod;
+      void *data = self->JobData;
+      self->Lock->Unlock();
+
+      (*method)(data, index);
+
+      self->Lock->Lock();
+      if (--self->PendingWorkers == 0)
+        {
+        self->DoneCondition->Signal();
+        }
+      }
+    }
+  self->Lock->Unlock();
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMPThreadPool::Execute(int numberOfThreads, JobFunction f, void *data)
+{
+  if (numberOfThreads < 1)
+    {
+    numberOfThreads = 1;
+    }
+  if (numberOfThreads > VTK_MAX_THREADS)
+    {
+    numberOfThreads = VTK_MAX_THREADS;
+    }
+
+  // Nested or single threaded execution: run every logical thread in
+  // turn on the calling thread.
+  int state = vtkSMPThreadPoolGetState();
+  if ((state & 1) || numberOfThreads == 1)
+    {
+    vtkSMPThreadPoolSetState(state | 1);
+    for (int i = 0; i < numberOfThreads; ++i)
+      {
+      (*f)(data, i);
+      }
+    vtkSMPThreadPoolSetState(state);
+    return;
+    }
+
+  this->ExecuteLock->Lock();
+  this->SpawnWorkers(numberOfThreads - 1);
+
+  // If the workers could not all be created, the calling thread runs the
+  // logical threads that have no worker.
+  int pooled = this->NumberOfWorkers + 1;
+  if (pooled > numberOfThreads)
+    {
+    pooled = numberOfThreads;
+    }
+
+  this->Lock->Lock();
+  this->JobMethod = f;
+  this->JobData = data;
+  this->JobNumberOfThreads = pooled;
+  this->PendingWorkers = pooled - 1;
+  ++this->Generation;
+  this->WakeCondition->Broadcast();
+  this->Lock->Unlock();
+
+  vtkSMPThreadPoolSetState(state | 1);
+  (*f)(data, 0);
+  for (int i = pooled; i < numberOfThreads; ++i)
+    {
+    (*f)(data, i);
+    }
+  vtkSMPThreadPoolSetState(state);
+
+  this->Lock->Lock();
+  while (this->PendingWorkers > 0)
+    {
+    this->DoneCondition->Wait(*this->Lock);
+    }
+  this->JobMethod = 0;
+  this->JobData = 0;
+  this->Lock->Unlock();
+
+  this->ExecuteLock->Unlock();
+}
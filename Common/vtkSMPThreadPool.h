@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadPool - persistent pool of worker threads
+// .SECTION Description
+// vtkSMPThreadPool keeps a set of worker threads alive for the lifetime
+// of the process so that parallel work can be dispatched without paying
+// for thread creation on every call.  The workers are spawned through
+// vtkMultiThreader::SpawnThread() the first time they are needed and
+// then sleep on a condition variable until Execute() hands them a job.
+//
+// Execute() runs a function on a given number of logical threads.  The
+// calling thread always takes part as logical thread 0, the remaining
+// logical threads are run by pool workers.  Execute() returns once every
+// logical thread has returned.  Calls to Execute() from several external
+// threads are serialized; a call made from inside a running job (nested
+// parallelism) runs all logical threads serially on the calling thread.
+//
+// Every thread taking part in a job has a small, stable index that can
+// be queried with GetThreadIndex().  It is used by vtkSMPThreadLocal to
+// give each thread its own storage.  This class is not meant to be used
+// directly by filters: see vtkSMPTools.
+// .SECTION See Also
+// vtkSMPTools vtkSMPThreadLocal vtkMultiThreader
+
+#ifndef __vtkSMPThreadPool_h
+#define __vtkSMPThreadPool_h
+
+#include "vtkSystemIncludes.h"
+
+class vtkMultiThreader;
+class vtkSimpleConditionVariable;
+class vtkSimpleCriticalSection;
+class vtkSimpleMutexLock;
+
+class VTK_COMMON_EXPORT vtkSMPThreadPool
+{
+public:
+  // Description:
+  // Signature of the functions run by Execute().  The first argument is
+  // the user data given to Execute(), the second one the logical thread
+  // id, between 0 and numberOfThreads-1.
+  typedef void (*JobFunction)(void *data, int threadId);
+
+  // Description:
+  // Return the process wide pool.  It is created on first use and
+  // destroyed (workers joined) when the process exits.
+  static vtkSMPThreadPool *GetGlobalPool();
+
+  // Description:
+  // Return the index of the calling thread in the pool: 0 for threads
+  // that are not pool workers (typically the thread that called
+  // Execute()) and 1 to VTK_MAX_THREADS-1 for workers.
+  static int GetThreadIndex();
+
+  // Description:
+  // Set/Get the number of threads used by default, the calling thread
+  // included.  Setting it spawns the missing workers right away so that
+  // the first Execute() does not pay for thread creation.  The value is
+  // clamped to 1 - VTK_MAX_THREADS.  The default is given by
+  // vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+  void SetNumberOfThreads(int num);
+  int GetNumberOfThreads();
+
+  // Description:
+  // Return the number of workers currently alive in the pool.
+  int GetNumberOfWorkers();
+
+  // Description:
+  // Run f(data, i) for i = 0 .. numberOfThreads-1, concurrently, and
+  // wait for all calls to return.  The call for i = 0 is made on the
+  // calling thread.  Workers are spawned as needed.
+  void Execute(int numberOfThreads, JobFunction f, void *data);
+
+  // Description:
+  // Spawn the workers that Execute(numberOfThreads, ...) needs, and return
+  // the number of its logical threads that would run concurrently:
+  // numberOfThreads, fewer if some workers could not be created, or 1 from
+  // inside a running job.  The other logical threads run one after the
+  // other on the calling thread.
+  int PrepareExecute(int numberOfThreads);
+
+  // Description:
+  // Return true if the calling thread is currently running a job of
+  // this pool, i.e. if a call to Execute() would be nested.
+  bool IsInParallelScope();
+
+  // Description:
+  // Return the number of times Execute() dispatched work to the pool
+  // workers since the process started.
+  unsigned long GetNumberOfDispatches();
+
+protected:
+  vtkSMPThreadPool();
+  ~vtkSMPThreadPool();
+
+  void SpawnWorkers(int numberOfWorkers);
+  void TerminateWorkers();
+  static VTK_THREAD_RETURN_TYPE WorkerMain(void *arg);
+
+  vtkMultiThreader *Threader;
+  int NumberOfThreads;
+  int NumberOfWorkers;
+  int WorkerIds[VTK_MAX_THREADS];
+  unsigned long WorkerGenerations[VTK_MAX_THREADS];
+
+  // Guards the job description below and is the mutex associated with
+  // both condition variables.
+  vtkSimpleMutexLock *Lock;
+  vtkSimpleConditionVariable *WakeCondition;
+  vtkSimpleConditionVariable *DoneCondition;
+
+  // Serializes Execute() calls made from independent threads.
+  vtkSimpleCriticalSection *ExecuteLock;
+
+  JobFunction JobMethod;
+  void *JobData;
+  int JobNumberOfThreads;
+  int PendingWorkers;
+  unsigned long Generation;
+  int ShuttingDown;
+
+private:
+  vtkSMPThreadPool(const vtkSMPThreadPool&);  // Not implemented.
+  void operator=(const vtkSMPThreadPool&);  // Not implemented.
+
+  friend class vtkSMPThreadPoolCleanup;
+};
+
+#endif
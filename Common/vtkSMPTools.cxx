@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSMPTools.h"
+
+#include "vtkMultiThreader.h"
+
+//----------------------------------------------------------------------------
+void vtkSMPTools::Initialize(int numThreads)
+{
+  if (numThreads <= 0)
+    {
+    numThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  vtkSMPThreadPool::GetGlobalPool()->SetNumberOfThreads(numThreads);
+}
+
+//----------------------------------------------------------------------------
+int vtkSMPTools::GetEstimatedNumberOfThreads()
+{
+  return vtkSMPThreadPool::GetGlobalPool()->GetNumberOfThreads();
+}
+
+//----------------------------------------------------------------------------
+// The range of chunks, [Begin, End), still owned by a thread.  Each block
+// sits in its own cache line.
+struct vtkSMPToolsStealingDispenser::Block
+{
+  vtkSimpleCriticalSection Lock;
+  vtkIdType Begin;
+  vtkIdType End;
+  char Padding[64];
+};
+
+//----------------------------------------------------------------------------
+vtkSMPToolsStealingDispenser::vtkSMPToolsStealingDispenser(
+  vtkIdType first, vtkIdType last, vtkIdType grain, int numberOfThreads)
+  : NumberOfThreads(numberOfThreads), First(first), Last(last),
+    Grain(grain), NumberOfSteals(0)
+{
+  this->Blocks = new Block[numberOfThreads];
+
+  // Distribute the chunks evenly in contiguous blocks.
+  vtkIdType numChunks = (last - first + grain - 1) / grain;
+  vtkIdType perThread = numChunks / numberOfThreads;
+  vtkIdType extra = numChunks % numberOfThreads;
+  vtkIdType next = 0;
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    this->Blocks[i].Begin = next;
+    next += perThread + (i < extra ? 1 : 0);
+    this->Blocks[i].End = next;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkSMPToolsStealingDispenser::~vtkSMPToolsStealingDispenser()
+{
+  delete [] this->Blocks;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMPToolsStealingDispenser::GetNumberOfSteals()
+{
+  return this->NumberOfSteals;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMPToolsStealingDispenser::GetChunk(int threadId, vtkIdType& begin,
+                                            vtkIdType& end)
+{
+  Block& own = this->Blocks[threadId];
+  vtkIdType chunk = -1;
+
+  own.Lock.Lock();
+  if (own.Begin < own.End)
+    {
+    chunk = own.Begin++;
+    }
+  own.Lock.Unlock();
+
+  // Our block is empty: steal the back half of the first non empty block
+  // of another thread.  Only one lock is held at a time, so a block in
+  // transit between two threads may be missed, but it is then processed
+  // by the thief.
+  for (int i = 1; chunk < 0 && i < this->NumberOfThreads; ++i)
+    {
+    Block& victim = this->Blocks[(threadId + i) % this->NumberOfThreads];
+    vtkIdType stolenBegin = 0, stolenEnd = 0;
+    victim.Lock.Lock();
+    vtkIdType remaining = victim.End - victim.Begin;
+    if (remaining > 0)
+      {
+      stolenEnd = victim.End;
+      stolenBegin = victim.End - (remaining + 1) / 2;
+      victim.End = stolenBegin;
+      }
+    victim.Lock.Unlock();
+
+    if (stolenEnd > stolenBegin)
+      {
+      own.Lock.Lock();
+      chunk = stolenBegin;
+      own.Begin = stolenBegin + 1;
+      own.End = stolenEnd;
+      own.Lock.Unlock();
+
+      this->StealsLock.Lock();
+      ++this->NumberOfSteals;
+      this->StealsLock.Unlock();
+      }
+    }
+
+  if (chunk < 0)
+    {
+    return false;
+    }
+  begin = this->First + chunk * this->Grain;
+  end = begin + this->Grain;
+  if (end > this->Last)
+    {
+    end = this->Last;
+    }
+  return true;
+}
@@ -0,0 +1,351 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPTools.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPTools - parallel for and reduce on a shared memory machine
+// .SECTION Description
+// vtkSMPTools provides a parallel for loop over an index range executed
+// by the persistent threads of vtkSMPThreadPool.  The range is cut into
+// chunks of "grain" indices that the threads grab dynamically, so that
+// threads finishing early keep working while others are busy with
+// expensive chunks.
+//
+// The functor passed to For() must provide
+// \code
+// void operator()(vtkIdType begin, vtkIdType end);
+// \endcode
+// which processes the indices [begin, end).  It may also provide
+// \code
+// void Initialize();
+// void Reduce();
+// \endcode
+// in which case Initialize() is called once on each thread before the
+// first chunk that thread processes, and Reduce() is called once on the
+// calling thread after the loop completes.  Together with
+// vtkSMPThreadLocal this implements a parallel reduction: Initialize()
+// sets up the per-thread state, operator() accumulates into it and
+// Reduce() combines the per-thread results.
+//
+// ForWorkStealing() has the same semantics but a different schedule: the
+// chunks are first distributed evenly, in contiguous blocks, among the
+// threads, and a thread that runs out of chunks steals half of the
+// remaining chunks of another thread.  It keeps the data locality of a
+// static split when the chunks have similar costs while still balancing
+// the load when they do not.  It is meant for loops over many small
+// chunks with very uneven costs.
+//
+// A For() called from within a running For() executes serially on the
+// calling thread.
+// .SECTION See Also
+// vtkSMPThreadLocal vtkSMPThreadPool vtkMultiThreader
+
+#ifndef __vtkSMPTools_h
+#define __vtkSMPTools_h
+
+#include "vtkSystemIncludes.h"
+#include "vtkCriticalSection.h" // For the chunk dispenser
+#include "vtkSMPThreadLocal.h" // For the Initialize() bookkeeping
+#include "vtkSMPThreadPool.h" // For the execution of the loop
+
+//BTX
+// Detect a "void Initialize()" member in a functor.
+template <typename T>
+class vtkSMPToolsHasInitialize
+{
+  typedef char Yes[1];
+  typedef char No[2];
+  template <typename U, void (U::*)()> struct Check;
+  template <typename U> static Yes& Test(Check<U, &U::Initialize>*);
+  template <typename U> static No& Test(...);
+public:
+  enum { Value = (sizeof(Test<T>(0)) == sizeof(Yes)) };
+};
+
+// Calls the functor, with or without Initialize()/Reduce().
+template <typename Functor, int HasInitialize>
+class vtkSMPToolsFunctorInternal;
+
+template <typename Functor>
+class vtkSMPToolsFunctorInternal<Functor, 0>
+{
+public:
+  vtkSMPToolsFunctorInternal(Functor& f) : F(f) {}
+  void Execute(vtkIdType begin, vtkIdType end)
+    {
+    this->F(begin, end);
+    }
+  void Reduce() {}
+private:
+  Functor& F;
+  void operator=(const vtkSMPToolsFunctorInternal&);  // Not implemented.
+};
+
+template <typename Functor>
+class vtkSMPToolsFunctorInternal<Functor, 1>
+{
+public:
+  vtkSMPToolsFunctorInternal(Functor& f) : F(f), Initialized(0) {}
+  void Execute(vtkIdType begin, vtkIdType end)
+    {
+    unsigned char& initialized = this->Initialized.Local();
+    if (!initialized)
+      {
+      this->F.Initialize();
+      initialized = 1;
+      }
+    this->F(begin, end);
+    }
+  void Reduce()
+    {
+    this->F.Reduce();
+    }
+private:
+  Functor& F;
+  vtkSMPThreadLocal<unsigned char> Initialized;
+  void operator=(const vtkSMPToolsFunctorInternal&);  // Not implemented.
+};
+
+// Hands out consecutive chunks of a range to the threads.
+class vtkSMPToolsChunkDispenser
+{
+public:
+  vtkSMPToolsChunkDispenser(vtkIdType first, vtkIdType last, vtkIdType grain)
+    : Next(first), Last(last), Grain(grain) {}
+
+  // Description:
+  // Get the next chunk.  Return false when the range is exhausted.
+  bool GetChunk(vtkIdType& begin, vtkIdType& end)
+    {
+    this->Lock.Lock();
+    begin = this->Next;
+    end = (this->Last - begin > this->Grain) ? begin + this->Grain : this->Last;
+    this->Next = end;
+    this->Lock.Unlock();
+    return begin < end;
+    }
+
+private:
+  vtkSimpleCriticalSection Lock;
+  vtkIdType Next;
+  vtkIdType Last;
+  vtkIdType Grain;
+};
+
+// Hands out chunks of a range with work stealing.  Each logical thread
+// owns a contiguous block of chunks that it consumes from the front;
+// an idle thread takes the back half of the block of another thread.
+class VTK_COMMON_EXPORT vtkSMPToolsStealingDispenser
+{
+public:
+  vtkSMPToolsStealingDispenser(vtkIdType first, vtkIdType last,
+                               vtkIdType grain, int numberOfThreads);
+  ~vtkSMPToolsStealingDispenser();
+
+  // Description:
+  // Get the next chunk for the given logical thread.  Return false when
+  // no thread has chunks left.
+  bool GetChunk(int threadId, vtkIdType& begin, vtkIdType& end);
+
+  // Description:
+  // Number of successful steals, for statistics.
+  vtkIdType GetNumberOfSteals();
+
+private:
+  struct Block;
+  Block *Blocks;
+  int NumberOfThreads;
+  vtkIdType First;
+  vtkIdType Last;
+  vtkIdType Grain;
+  vtkSimpleCriticalSection StealsLock;
+  vtkIdType NumberOfSteals;
+
+  vtkSMPToolsStealingDispenser(const vtkSMPToolsStealingDispenser&);  // Not implemented.
+  void operator=(const vtkSMPToolsStealingDispenser&);  // Not implemented.
+};
+
+template <typename FunctorInternal>
+class vtkSMPToolsForJob
+{
+public:
+  vtkSMPToolsForJob(FunctorInternal& fi, vtkIdType first, vtkIdType last,
+                    vtkIdType grain)
+    : F(fi), Chunks(first, last, grain) {}
+
+  static void Run(void *data, int vtkNotUsed(threadId))
+    {
+    vtkSMPToolsForJob *self = static_cast<vtkSMPToolsForJob *>(data);
+    vtkIdType begin, end;
+    while (self->Chunks.GetChunk(begin, end))
+      {
+      self->F.Execute(begin, end);
+      }
+    }
+
+private:
+  FunctorInternal& F;
+  vtkSMPToolsChunkDispenser Chunks;
+  void operator=(const vtkSMPToolsForJob&);  // Not implemented.
+};
+
+template <typename FunctorInternal>
+class vtkSMPToolsStealingJob
+{
+public:
+  vtkSMPToolsStealingJob(FunctorInternal& fi, vtkIdType first,
+                         vtkIdType last, vtkIdType grain, int numThreads)
+    : F(fi), Chunks(first, last, grain, numThreads) {}
+
+  static void Run(void *data, int threadId)
+    {
+    vtkSMPToolsStealingJob *self = static_cast<vtkSMPToolsStealingJob *>(data);
+    vtkIdType begin, end;
+    while (self->Chunks.GetChunk(threadId, begin, end))
+      {
+      self->F.Execute(begin, end);
+      }
+    }
+
+  FunctorInternal& F;
+  vtkSMPToolsStealingDispenser Chunks;
+
+private:
+  void operator=(const vtkSMPToolsStealingJob&);  // Not implemented.
+};
+//ETX
+
+class VTK_COMMON_EXPORT vtkSMPTools
+{
+public:
+  // Description:
+  // Set the number of threads used by For(), the calling thread
+  // included, and start the pool workers.  A value of 0 selects
+  // vtkMultiThreader::GetGlobalDefaultNumberOfThreads().  Calling this
+  // method is optional.
+  static void Initialize(int numThreads = 0);
+
+  // Description:
+  // Return the number of threads For() will use.
+  static int GetEstimatedNumberOfThreads();
+
+  //BTX
+  // Description:
+  // Execute f(begin, end) over [first, last) in parallel, in chunks of
+  // at most grain indices.  A grain of 0 or less lets vtkSMPTools choose
+  // one that gives each thread a few chunks to balance the load.
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, vtkIdType grain,
+                  Functor& f)
+    {
+    typedef vtkSMPToolsFunctorInternal<Functor,
+      vtkSMPToolsHasInitialize<Functor>::Value> InternalType;
+    InternalType fi(f);
+    vtkSMPTools::ForInternal(first, last, grain, fi);
+    fi.Reduce();
+    }
+
+  // Description:
+  // Same as above with an automatically chosen grain.
+  template <typename Functor>
+  static void For(vtkIdType first, vtkIdType last, Functor& f)
+    {
+    vtkSMPTools::For(first, last, 0, f);
+    }
+
+  // Description:
+  // Execute f(begin, end) over [first, last) in parallel, in chunks of
+  // at most grain indices scheduled by work stealing.  Return the number
+  // of steals that happened.
+  template <typename Functor>
+  static vtkIdType ForWorkStealing(vtkIdType first, vtkIdType last,
+                                   vtkIdType grain, Functor& f)
+    {
+    typedef vtkSMPToolsFunctorInternal<Functor,
+      vtkSMPToolsHasInitialize<Functor>::Value> InternalType;
+    InternalType fi(f);
+    vtkIdType steals = vtkSMPTools::ForWorkStealingInternal(
+      first, last, grain, fi);
+    fi.Reduce();
+    return steals;
+    }
+  //ETX
+
+protected:
+  //BTX
+  template <typename FunctorInternal>
+  static void ForInternal(vtkIdType first, vtkIdType last, vtkIdType grain,
+                          FunctorInternal& fi)
+    {
+    vtkIdType n = last - first;
+    if (n <= 0)
+      {
+      return;
+      }
+    vtkSMPThreadPool *pool = vtkSMPThreadPool::GetGlobalPool();
+    int numThreads = pool->GetNumberOfThreads();
+    if (grain <= 0)
+      {
+      vtkIdType estimate = n / (numThreads * 4);
+      grain = (estimate > 0) ? estimate : 1;
+      }
+    if (numThreads == 1 || n <= grain || pool->IsInParallelScope())
+      {
+      fi.Execute(first, last);
+      return;
+      }
+    vtkIdType numChunks = (n + grain - 1) / grain;
+    if (numChunks < numThreads)
+      {
+      numThreads = static_cast<int>(numChunks);
+      }
+    vtkSMPToolsForJob<FunctorInternal> job(fi, first, last, grain);
+    pool->Execute(numThreads, &vtkSMPToolsForJob<FunctorInternal>::Run, &job);
+    }
+
+  template <typename FunctorInternal>
+  static vtkIdType ForWorkStealingInternal(vtkIdType first, vtkIdType last,
+                                           vtkIdType grain,
+                                           FunctorInternal& fi)
+    {
+    vtkIdType n = last - first;
+    if (n <= 0)
+      {
+      return 0;
+      }
+    vtkSMPThreadPool *pool = vtkSMPThreadPool::GetGlobalPool();
+    int numThreads = pool->GetNumberOfThreads();
+    if (grain <= 0)
+      {
+      vtkIdType estimate = n / (numThreads * 16);
+      grain = (estimate > 0) ? estimate : 1;
+      }
+    if (numThreads == 1 || n <= grain || pool->IsInParallelScope())
+      {
+      fi.Execute(first, last);
+      return 0;
+      }
+    vtkIdType numChunks = (n + grain - 1) / grain;
+    if (numChunks < numThreads)
+      {
+      numThreads = static_cast<int>(numChunks);
+      }
+    vtkSMPToolsStealingJob<FunctorInternal> job(fi, first, last, grain,
+                                                numThreads);
+    pool->Execute(numThreads, &vtkSMPToolsStealingJob<FunctorInternal>::Run,
+                  &job);
+    return job.Chunks.GetNumberOfSteals();
+    }
+  //ETX
+};
+
+#endif
@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSOADataArrayTemplate - data array storing each component in its own buffer
+// .SECTION Description
+// vtkSOADataArrayTemplate is a vtkDataArray that stores its values as a
+// "structure of arrays": component j of all the tuples is kept in a
+// separate contiguous buffer, instead of the interleaved "array of
+// structures" layout of vtkDataArrayTemplate.  It is meant to wrap data
+// produced by simulation codes that keep, for instance, the x, y and z
+// coordinates of their points in separate arrays: SetArrays() adopts such
+// buffers without copying them, in the same way
+// vtkDataArrayTemplate::SetArray() does for interleaved data, and
+// SetArray() replaces the buffer of one component.
+//
+// The whole vtkDataArray tuple and component API (GetTuple(),
+// SetTuple(), GetComponent(), InsertNextTuple(), ...) is supported, so
+// the array can be used for instance as the data of a vtkPoints.
+//
+// Code that accesses the memory of an array directly cannot work with
+// this layout.  HasStandardMemoryLayout() returns 0 when the array has
+// more than one component, and GetVoidPointer() then returns a pointer to
+// an interleaved copy of the values.  The copy is kept until the values
+// change through the API of the array, or DataChanged() or Modified() is
+// called: call one of them after writing to the buffers of
+// GetComponentArrayPointer().  This copy is only meant for reading and
+// doubles the memory of the array: code that knows about this class
+// should use the tuple API or GetComponentArrayPointer() instead.  WriteVoidPointer() is only supported for single component
+// arrays.
+//
+// The fast lookup of vtkDataArrayTemplate is not implemented:
+// LookupValue() does a linear search.
+//
+// .SECTION See Also
+// vtkDataArrayTemplate vtkPoints
+
+#ifndef __vtkSOADataArrayTemplate_h
+#define __vtkSOADataArrayTemplate_h
+
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h" // For New()
+#include "vtkTypeTemplate.h" // For the type information
+
+template <class T>
+class vtkSOADataArrayTemplate :
+  public vtkTypeTemplate<vtkSOADataArrayTemplate<T>, vtkDataArray>
+{
+public:
+  static vtkSOADataArrayTemplate<T>* New();
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Allocate memory for sz values.  The current data is discarded.
+  // Note that ext is not used.
+  int Allocate(vtkIdType sz, vtkIdType ext=1000);
+
+  // Description:
+  // Release storage and reset array to initial state.
+  void Initialize();
+
+  // Description:
+  // Return the VTK type of T and its size.
+  int GetDataType();
+  int GetDataTypeSize() { return static_cast<int>(sizeof(T)); }
+
+  // Description:
+  // Set the number of n-tuples in the array.  The data that fits in the
+  // new size is kept.
+  void SetNumberOfTuples(vtkIdType number);
+
+  // Description:
+  // Copy the jth tuple of the source array into the ith tuple of this
+  // array.  The two arrays must have the same type and number of
+  // components.  SetTuple() does not allocate memory.
+  virtual void SetTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual void InsertTuple(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  virtual vtkIdType InsertNextTuple(vtkIdType j, vtkAbstractArray* source);
+
+  // Description:
+  // Get a pointer to a copy of the ith tuple as doubles.  This is a
+  // dangerous method (it is not thread safe since a pointer is returned).
+  double* GetTuple(vtkIdType i);
+
+  // Description:
+  // Copy the ith tuple into a user-provided array.
+  void GetTuple(vtkIdType i, double* tuple);
+  void GetTupleValue(vtkIdType i, T* tuple);
+
+  // Description:
+  // Set the ith tuple.  No memory is allocated.
+  void SetTuple(vtkIdType i, const float* tuple);
+  void SetTuple(vtkIdType i, const double* tuple);
+  void SetTupleValue(vtkIdType i, const T* tuple);
+
+  // Description:
+  // Insert (memory allocation performed) the tuple into the ith location
+  // in the array.
+  void InsertTuple(vtkIdType i, const float* tuple);
+  void InsertTuple(vtkIdType i, const double* tuple);
+  void InsertTupleValue(vtkIdType i, const T* tuple);
+
+  // Description:
+  // Insert (memory allocation performed) the tuple onto the end of the
+  // array.  Return the index of the tuple.
+  vtkIdType InsertNextTuple(const float* tuple);
+  vtkIdType InsertNextTuple(const double* tuple);
+  vtkIdType InsertNextTupleValue(const T* tuple);
+
+  // Description:
+  // Remove tuples, shifting the following ones.  This is slow.
+  virtual void RemoveTuple(vtkIdType id);
+  virtual void RemoveFirstTuple();
+  virtual void RemoveLastTuple();
+
+  // Description:
+  // Get/Set the jth component of the ith tuple.  SetComponent() does not
+  // allocate memory, InsertComponent() does.
+  double GetComponent(vtkIdType i, int j);
+  void SetComponent(vtkIdType i, int j, double c);
+  virtual void InsertComponent(vtkIdType i, int j, double c);
+
+  // Description:
+  // Get/Set a value from its index i*NumberOfComponents+j in the
+  // interleaved numbering used by vtkDataArrayTemplate.  SetValue() does
+  // not allocate memory.
+  T GetValue(vtkIdType id);
+  void SetValue(vtkIdType id, T value);
+  vtkVariant GetVariantValue(vtkIdType id);
+  void SetVariantValue(vtkIdType id, vtkVariant value);
+
+  // Description:
+  // See the class description: for arrays with more than one component
+  // GetVoidPointer() returns a read only interleaved copy of the values,
+  // and WriteVoidPointer() fails.
+  virtual void* GetVoidPointer(vtkIdType id);
+  virtual void* WriteVoidPointer(vtkIdType id, vtkIdType number);
+  virtual int HasStandardMemoryLayout();
+
+  // Description:
+  // Copy the values, interleaved, to a user allocated buffer of
+  // GetNumberOfTuples()*GetNumberOfComponents() values.
+  virtual void ExportToVoidPointer(void *out_ptr);
+
+  // Description:
+  // Deep copy of another array.
+  void DeepCopy(vtkDataArray* da);
+  void DeepCopy(vtkAbstractArray* aa)
+    { this->vtkDataArray::DeepCopy(aa); }
+
+  // Description:
+  // Resize object to just fit data requirement.  Reclaims extra memory.
+  void Squeeze();
+
+  // Description:
+  // Resize the array to numTuples tuples while conserving the data.
+  virtual int Resize(vtkIdType numTuples);
+
+  // Description:
+  // Returns a vtkArrayIteratorTemplate<T> over the interleaved copy
+  // returned by GetVoidPointer().
+  virtual vtkArrayIterator* NewIterator();
+
+  // Description:
+  // Return the indices where a specific value appears.  These methods do
+  // a linear search.
+  virtual vtkIdType LookupValue(vtkVariant value);
+  virtual void LookupValue(vtkVariant value, vtkIdList* ids);
+
+  // Description:
+  // There is no fast lookup structure to update or delete.  DataChanged()
+  // discards the interleaved copy returned by GetVoidPointer(), as does
+  // Modified().
+  virtual void DataChanged();
+  virtual void ClearLookup() {}
+  virtual void Modified();
+
+//BTX
+  enum DeleteMethod
+  {
+    VTK_DATA_ARRAY_FREE,
+    VTK_DATA_ARRAY_DELETE
+  };
+//ETX
+
+  // Description:
+  // Use the given buffer of numTuples values as the storage of component
+  // comp, without copying it.  Set the number of components first.  Set
+  // save to 1 to keep the class from deleting the buffer when it cleans
+  // up or reallocates memory.  If specified, the delete method
+  // determines how the buffer will be deallocated: with free() for
+  // VTK_DATA_ARRAY_FREE (the default) or delete[] for
+  // VTK_DATA_ARRAY_DELETE.  All the components must be given buffers of
+  // the same number of tuples; the number of tuples of the array is set
+  // to numTuples.  When this changes the number of tuples, the buffers
+  // of the other components are reallocated to match, so use SetArrays()
+  // to adopt the buffers of all the components.
+  void SetArray(int comp, T* array, vtkIdType numTuples, int save,
+                int deleteMethod);
+  void SetArray(int comp, T* array, vtkIdType numTuples, int save)
+    { this->SetArray(comp, array, numTuples, save, VTK_DATA_ARRAY_FREE); }
+
+  // Description:
+  // Use the given buffers, one per component and each of numTuples
+  // values, as the storage of the array without copying or allocating
+  // anything.  Set the number of components first.  save and
+  // deleteMethod apply to all the buffers, as in SetArray().
+  void SetArrays(T* const* arrays, vtkIdType numTuples, int save,
+                 int deleteMethod);
+  void SetArrays(T* const* arrays, vtkIdType numTuples, int save)
+    { this->SetArrays(arrays, numTuples, save, VTK_DATA_ARRAY_FREE); }
+
+  // Description:
+  // Adopt the buffer of a single component array, size being its number
+  // of values.  Use SetArray() for arrays with several components.
+  virtual void SetVoidArray(void* array, vtkIdType size, int save)
+    { this->SetVoidArray(array, size, save, VTK_DATA_ARRAY_FREE); }
+  virtual void SetVoidArray(void* array, vtkIdType size, int save,
+                            int deleteMethod);
+
+  // Description:
+  // Return the buffer holding component comp, or 0 if there is none.
+  T* GetComponentArrayPointer(int comp);
+
+protected:
+  vtkSOADataArrayTemplate();
+  ~vtkSOADataArrayTemplate();
+
+  virtual const char* GetClassNameInternal() const
+    { return "vtkSOADataArrayTemplate"; }
+
+  // Make sure there is room for the given number of values, growing the
+  // buffers geometrically.
+  int ResizeAndExtend(vtkIdType sz);
+  // Reallocate every component buffer to hold numTuples tuples.
+  int ReallocateBuffers(vtkIdType numTuples);
+  int ReallocateBuffer(int comp, vtkIdType oldTuples, vtkIdType numTuples);
+  void CopyTupleFrom(vtkIdType i, vtkIdType j, vtkAbstractArray* source);
+  void DeleteBuffer(int comp);
+  void DeleteBuffers();
+
+  T** Arrays;
+  int* SaveUserArrays;
+  int* DeleteMethods;
+  int NumberOfArrays;
+
+  // Interleaved copy returned by GetVoidPointer(), valid until the values
+  // change.
+  T* InterleavedCopy;
+  vtkIdType InterleavedCopySize;
+  int InterleavedCopyValid;
+
+  double* Tuple;
+  int TupleSize;
+
+private:
+  vtkSOADataArrayTemplate(const vtkSOADataArrayTemplate&);  // Not implemented.
+  void operator=(const vtkSOADataArrayTemplate&);  // Not implemented.
+};
+
+#include "vtkSOADataArrayTemplate.txx"
+
+#endif
@@ -0,0 +1,915 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSOADataArrayTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef __vtkSOADataArrayTemplate_txx
+#define __vtkSOADataArrayTemplate_txx
+
+#include "vtkArrayIteratorTemplate.h"
+#include "vtkIdList.h"
+#include "vtkTypeTraits.h"
+#include "vtkVariant.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>* vtkSOADataArrayTemplate<T>::New()
+{
+  vtkObject* ret = vtkObjectFactory::CreateInstance(
+    typeid(vtkSOADataArrayTemplate<T>).name());
+  if (ret)
+    {
+    return static_cast<vtkSOADataArrayTemplate<T>*>(ret);
+    }
+  return new vtkSOADataArrayTemplate<T>;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::vtkSOADataArrayTemplate()
+{
+  this->Arrays = 0;
+  this->SaveUserArrays = 0;
+  this->DeleteMethods = 0;
+  this->NumberOfArrays = 0;
+  this->InterleavedCopy = 0;
+  this->InterleavedCopySize = 0;
+  this->InterleavedCopyValid = 0;
+  this->Tuple = 0;
+  this->TupleSize = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkSOADataArrayTemplate<T>::~vtkSOADataArrayTemplate()
+{
+  this->DeleteBuffers();
+  free(this->InterleavedCopy);
+  delete [] this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->vtkDataArray::PrintSelf(os, indent);
+  os << indent << "NumberOfArrays: " << this->NumberOfArrays << "\n";
+  for (int c = 0; c < this->NumberOfArrays; ++c)
+    {
+    os << indent << "Array " << c << ": " << this->Arrays[c]
+       << (this->SaveUserArrays[c] ? " (user array)\n" : "\n");
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::GetDataType()
+{
+  return vtkTypeTraits<T>::VTKTypeID();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DeleteBuffer(int comp)
+{
+  if (this->Arrays[comp] && !this->SaveUserArrays[comp])
+    {
+    if (this->DeleteMethods[comp] == VTK_DATA_ARRAY_DELETE)
+      {
+      delete [] this->Arrays[comp];
+      }
+    else
+      {
+      free(this->Arrays[comp]);
+      }
+    }
+  this->Arrays[comp] = 0;
+  this->SaveUserArrays[comp] = 0;
+  this->DeleteMethods[comp] = VTK_DATA_ARRAY_FREE;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DeleteBuffers()
+{
+  for (int c = 0; c < this->NumberOfArrays; ++c)
+    {
+    this->DeleteBuffer(c);
+    }
+  delete [] this->Arrays;
+  delete [] this->SaveUserArrays;
+  delete [] this->DeleteMethods;
+  this->Arrays = 0;
+  this->SaveUserArrays = 0;
+  this->DeleteMethods = 0;
+  this->NumberOfArrays = 0;
+  this->Size = 0;
+  this->MaxId = -1;
+  this->InterleavedCopyValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::ReallocateBuffer(int comp, vtkIdType oldTuples,
+                                                 vtkIdType numTuples)
+{
+  if (numTuples <= 0)
+    {
+    this->DeleteBuffer(comp);
+    return 1;
+    }
+
+  size_t bytes = static_cast<size_t>(numTuples) * sizeof(T);
+  T* newArray;
+  if (this->Arrays[comp] && !this->SaveUserArrays[comp] &&
+      this->DeleteMethods[comp] == VTK_DATA_ARRAY_FREE)
+    {
+    newArray = static_cast<T*>(realloc(this->Arrays[comp], bytes));
+    if (!newArray)
+      {
+      vtkErrorMacro("Unable to allocate " << numTuples
+                    << " elements of size " << sizeof(T) << " bytes. ");
+      return 0;
+      }
+    }
+  else
+    {
+    newArray = static_cast<T*>(malloc(bytes));
+    if (!newArray)
+      {
+      vtkErrorMacro("Unable to allocate " << numTuples
+                    << " elements of size " << sizeof(T) << " bytes. ");
+      return 0;
+      }
+    if (this->Arrays[comp])
+      {
+      vtkIdType keep = (oldTuples < numTuples ? oldTuples : numTuples);
+      memcpy(newArray, this->Arrays[comp],
+             static_cast<size_t>(keep) * sizeof(T));
+      }
+    this->DeleteBuffer(comp);
+    }
+
+  this->Arrays[comp] = newArray;
+  this->SaveUserArrays[comp] = 0;
+  this->DeleteMethods[comp] = VTK_DATA_ARRAY_FREE;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// If the number of components changed since the buffers were created,
+// the data is discarded.
+template <class T>
+int vtkSOADataArrayTemplate<T>::ReallocateBuffers(vtkIdType numTuples)
+{
+  int numComp = this->NumberOfComponents;
+  if (numComp != this->NumberOfArrays)
+    {
+    this->DeleteBuffers();
+    this->Arrays = new T*[numComp];
+    this->SaveUserArrays = new int[numComp];
+    this->DeleteMethods = new int[numComp];
+    for (int c = 0; c < numComp; ++c)
+      {
+      this->Arrays[c] = 0;
+      this->SaveUserArrays[c] = 0;
+      this->DeleteMethods[c] = VTK_DATA_ARRAY_FREE;
+      }
+    this->NumberOfArrays = numComp;
+    }
+
+  vtkIdType oldTuples = this->Size / numComp;
+  if (numTuples == oldTuples)
+    {
+    return 1;
+    }
+  for (int c = 0; c < numComp; ++c)
+    {
+    if (!this->ReallocateBuffer(c, oldTuples, numTuples))
+      {
+      return 0;
+      }
+    }
+
+  this->Size = numTuples * numComp;
+  if (this->MaxId >= this->Size)
+    {
+    this->MaxId = this->Size - 1;
+    }
+  this->InterleavedCopyValid = 0;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::ResizeAndExtend(vtkIdType sz)
+{
+  int numComp = this->NumberOfComponents;
+  if (this->NumberOfArrays == numComp && sz <= this->Size)
+    {
+    return 1;
+    }
+  vtkIdType newSize = this->Size + sz;
+  return this->ReallocateBuffers((newSize + numComp - 1) / numComp);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::Allocate(vtkIdType sz,
+                                         vtkIdType vtkNotUsed(ext))
+{
+  int numComp = this->NumberOfComponents;
+  if (sz > this->Size || this->NumberOfArrays != numComp)
+    {
+    this->DeleteBuffers();
+    sz = (sz > 0 ? sz : 1);
+    if (!this->ReallocateBuffers((sz + numComp - 1) / numComp))
+      {
+      return 0;
+      }
+    }
+  this->MaxId = -1;
+  this->InterleavedCopyValid = 0;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::Initialize()
+{
+  this->DeleteBuffers();
+  free(this->InterleavedCopy);
+  this->InterleavedCopy = 0;
+  this->InterleavedCopySize = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetNumberOfTuples(vtkIdType number)
+{
+  int numComp = this->NumberOfComponents;
+  if (number * numComp > this->Size || this->NumberOfArrays != numComp)
+    {
+    if (!this->ReallocateBuffers(number))
+      {
+      return;
+      }
+    }
+  this->MaxId = number * numComp - 1;
+  this->InterleavedCopyValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::Resize(vtkIdType numTuples)
+{
+  if (numTuples <= 0)
+    {
+    this->Initialize();
+    return 1;
+    }
+  return this->ReallocateBuffers(numTuples);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::Squeeze()
+{
+  this->ReallocateBuffers(this->GetNumberOfTuples());
+}
+
+//----------------------------------------------------------------------------
+// Copy a tuple of an array of the same type, reading the source with the
+// fastest access it supports.
+template <class T>
+void vtkSOADataArrayTemplate<T>::CopyTupleFrom(vtkIdType i, vtkIdType j,
+                                               vtkAbstractArray* source)
+{
+  int numComp = this->NumberOfComponents;
+  this->InterleavedCopyValid = 0;
+  vtkSOADataArrayTemplate<T>* soa =
+    vtkSOADataArrayTemplate<T>::SafeDownCast(source);
+  if (soa)
+    {
+    for (int c = 0; c < numComp; ++c)
+      {
+      this->Arrays[c][i] = soa->Arrays[c][j];
+      }
+    }
+  else if (source->HasStandardMemoryLayout())
+    {
+    T* data = static_cast<T*>(source->GetVoidPointer(j * numComp));
+    for (int c = 0; c < numComp; ++c)
+      {
+      this->Arrays[c][i] = data[c];
+      }
+    }
+  else
+    {
+    vtkDataArray* da = vtkDataArray::SafeDownCast(source);
+    for (int c = 0; da && c < numComp; ++c)
+      {
+      this->Arrays[c][i] = static_cast<T>(da->GetComponent(j, c));
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, vtkIdType j,
+                                          vtkAbstractArray* source)
+{
+  if (source->GetDataType() != this->GetDataType())
+    {
+    vtkWarningMacro("Input and output array data types do not match.");
+    return;
+    }
+  if (this->NumberOfComponents != source->GetNumberOfComponents())
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+  this->CopyTupleFrom(i, j, source);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, vtkIdType j,
+                                             vtkAbstractArray* source)
+{
+  if (source->GetDataType() != this->GetDataType())
+    {
+    vtkWarningMacro("Input and output array data types do not match.");
+    return;
+    }
+  int numComp = this->NumberOfComponents;
+  if (numComp != source->GetNumberOfComponents())
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return;
+    }
+  vtkIdType maxSize = (i + 1) * numComp;
+  if (!this->ResizeAndExtend(maxSize))
+    {
+    return;
+    }
+  this->CopyTupleFrom(i, j, source);
+  if (maxSize - 1 > this->MaxId)
+    {
+    this->MaxId = maxSize - 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(vtkIdType j,
+                                                      vtkAbstractArray* source)
+{
+  if (source->GetDataType() != this->GetDataType())
+    {
+    vtkWarningMacro("Input and output array data types do not match.");
+    return -1;
+    }
+  if (this->NumberOfComponents != source->GetNumberOfComponents())
+    {
+    vtkWarningMacro("Input and output component sizes do not match.");
+    return -1;
+    }
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, j, source);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double* vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i)
+{
+  if (this->TupleSize < this->NumberOfComponents)
+    {
+    delete [] this->Tuple;
+    this->TupleSize = this->NumberOfComponents;
+    this->Tuple = new double[this->TupleSize];
+    }
+  this->GetTuple(i, this->Tuple);
+  return this->Tuple;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTuple(vtkIdType i, double* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    tuple[c] = static_cast<double>(this->Arrays[c][i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::GetTupleValue(vtkIdType i, T* tuple)
+{
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    tuple[c] = this->Arrays[c][i];
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const float* tuple)
+{
+  this->InterleavedCopyValid = 0;
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Arrays[c][i] = static_cast<T>(tuple[c]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTuple(vtkIdType i, const double* tuple)
+{
+  this->InterleavedCopyValid = 0;
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Arrays[c][i] = static_cast<T>(tuple[c]);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetTupleValue(vtkIdType i, const T* tuple)
+{
+  this->InterleavedCopyValid = 0;
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    this->Arrays[c][i] = tuple[c];
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, const float* tuple)
+{
+  vtkIdType maxSize = (i + 1) * this->NumberOfComponents;
+  if (!this->ResizeAndExtend(maxSize))
+    {
+    return;
+    }
+  this->SetTuple(i, tuple);
+  if (maxSize - 1 > this->MaxId)
+    {
+    this->MaxId = maxSize - 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTuple(vtkIdType i, const double* tuple)
+{
+  vtkIdType maxSize = (i + 1) * this->NumberOfComponents;
+  if (!this->ResizeAndExtend(maxSize))
+    {
+    return;
+    }
+  this->SetTuple(i, tuple);
+  if (maxSize - 1 > this->MaxId)
+    {
+    this->MaxId = maxSize - 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertTupleValue(vtkIdType i, const T* tuple)
+{
+  vtkIdType maxSize = (i + 1) * this->NumberOfComponents;
+  if (!this->ResizeAndExtend(maxSize))
+    {
+    return;
+    }
+  this->SetTupleValue(i, tuple);
+  if (maxSize - 1 > this->MaxId)
+    {
+    this->MaxId = maxSize - 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const float* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTuple(const double* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTuple(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::InsertNextTupleValue(const T* tuple)
+{
+  vtkIdType i = this->GetNumberOfTuples();
+  this->InsertTupleValue(i, tuple);
+  return i;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveTuple(vtkIdType id)
+{
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  if (id < 0 || id >= numTuples)
+    {
+    return;
+    }
+  size_t bytes = static_cast<size_t>(numTuples - id - 1) * sizeof(T);
+  for (int c = 0; c < this->NumberOfComponents; ++c)
+    {
+    memmove(this->Arrays[c] + id, this->Arrays[c] + id + 1, bytes);
+    }
+  this->MaxId -= this->NumberOfComponents;
+  this->InterleavedCopyValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveFirstTuple()
+{
+  this->RemoveTuple(0);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::RemoveLastTuple()
+{
+  this->RemoveTuple(this->GetNumberOfTuples() - 1);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+double vtkSOADataArrayTemplate<T>::GetComponent(vtkIdType i, int j)
+{
+  return static_cast<double>(this->Arrays[j][i]);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetComponent(vtkIdType i, int j, double c)
+{
+  this->Arrays[j][i] = static_cast<T>(c);
+  this->InterleavedCopyValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::InsertComponent(vtkIdType i, int j, double c)
+{
+  vtkIdType id = i * this->NumberOfComponents + j;
+  if (!this->ResizeAndExtend(id + 1))
+    {
+    return;
+    }
+  this->Arrays[j][i] = static_cast<T>(c);
+  this->InterleavedCopyValid = 0;
+  if (id > this->MaxId)
+    {
+    this->MaxId = id;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T vtkSOADataArrayTemplate<T>::GetValue(vtkIdType id)
+{
+  int numComp = this->NumberOfComponents;
+  return this->Arrays[id % numComp][id / numComp];
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetValue(vtkIdType id, T value)
+{
+  int numComp = this->NumberOfComponents;
+  this->Arrays[id % numComp][id / numComp] = value;
+  this->InterleavedCopyValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkVariant vtkSOADataArrayTemplate<T>::GetVariantValue(vtkIdType id)
+{
+  return vtkVariant(this->GetValue(id));
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVariantValue(vtkIdType id,
+                                                 vtkVariant value)
+{
+  T* dummyPtr = 0;
+  bool valid;
+  T toInsert = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    this->SetValue(id, toInsert);
+    }
+  else
+    {
+    vtkErrorMacro("unable to set value of type " << value.GetType());
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+int vtkSOADataArrayTemplate<T>::HasStandardMemoryLayout()
+{
+  return this->NumberOfComponents == 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkSOADataArrayTemplate<T>::GetVoidPointer(vtkIdType id)
+{
+  if (this->NumberOfComponents == 1 && this->NumberOfArrays == 1)
+    {
+    return this->Arrays[0] + id;
+    }
+
+  // The copy is kept until the values change: see DataChanged().
+  if (this->InterleavedCopyValid)
+    {
+    return this->InterleavedCopy + id;
+    }
+  vtkIdType size = this->MaxId + 1;
+  if (size > this->InterleavedCopySize)
+    {
+    free(this->InterleavedCopy);
+    this->InterleavedCopy =
+      static_cast<T*>(malloc(static_cast<size_t>(size) * sizeof(T)));
+    if (!this->InterleavedCopy)
+      {
+      vtkErrorMacro("Unable to allocate " << size
+                    << " elements of size " << sizeof(T) << " bytes. ");
+      this->InterleavedCopySize = 0;
+      return 0;
+      }
+    this->InterleavedCopySize = size;
+    }
+  this->ExportToVoidPointer(this->InterleavedCopy);
+  this->InterleavedCopyValid = 1;
+  return this->InterleavedCopy + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void* vtkSOADataArrayTemplate<T>::WriteVoidPointer(vtkIdType id,
+                                                   vtkIdType number)
+{
+  if (this->NumberOfComponents != 1)
+    {
+    vtkErrorMacro("WriteVoidPointer is only supported for arrays with one "
+                  "component.");
+    return 0;
+    }
+  vtkIdType newSize = id + number;
+  if (!this->ResizeAndExtend(newSize))
+    {
+    return 0;
+    }
+  if (newSize - 1 > this->MaxId)
+    {
+    this->MaxId = newSize - 1;
+    }
+  this->InterleavedCopyValid = 0;
+  return this->Arrays[0] + id;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DataChanged()
+{
+  this->InterleavedCopyValid = 0;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::Modified()
+{
+  this->InterleavedCopyValid = 0;
+  this->vtkDataArray::Modified();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::ExportToVoidPointer(void *out_ptr)
+{
+  T* out = static_cast<T*>(out_ptr);
+  int numComp = this->NumberOfComponents;
+  vtkIdType numTuples = this->GetNumberOfTuples();
+  for (int c = 0; out && c < numComp; ++c)
+    {
+    const T* in = this->Arrays[c];
+    for (vtkIdType i = 0; i < numTuples; ++i)
+      {
+      out[i*numComp + c] = in[i];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::DeepCopy(vtkDataArray* da)
+{
+  if (da == NULL || da == this)
+    {
+    return;
+    }
+
+  vtkSOADataArrayTemplate<T>* soa = vtkSOADataArrayTemplate<T>::SafeDownCast(da);
+  if (!soa)
+    {
+    // Generic copy, through the tuple API when needed.
+    this->vtkDataArray::DeepCopy(da);
+    return;
+    }
+
+  this->DeleteBuffers();
+  this->NumberOfComponents = soa->GetNumberOfComponents();
+  vtkIdType numTuples = soa->GetNumberOfTuples();
+  if (!this->ReallocateBuffers(numTuples))
+    {
+    return;
+    }
+  for (int c = 0; c < this->NumberOfComponents && numTuples > 0; ++c)
+    {
+    memcpy(this->Arrays[c], soa->Arrays[c],
+           static_cast<size_t>(numTuples) * sizeof(T));
+    }
+  this->MaxId = soa->GetMaxId();
+  this->vtkAbstractArray::DeepCopy(da);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkArrayIterator* vtkSOADataArrayTemplate<T>::NewIterator()
+{
+  vtkArrayIteratorTemplate<T>* iter = vtkArrayIteratorTemplate<T>::New();
+  iter->Initialize(this);
+  return iter;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkIdType vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant value)
+{
+  T* dummyPtr = 0;
+  bool valid;
+  T val = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    int numComp = this->NumberOfComponents;
+    for (vtkIdType i = 0; i <= this->MaxId; ++i)
+      {
+      if (this->Arrays[i % numComp][i / numComp] == val)
+        {
+        return i;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::LookupValue(vtkVariant value, vtkIdList* ids)
+{
+  ids->Reset();
+  T* dummyPtr = 0;
+  bool valid;
+  T val = value.ToNumeric(&valid, dummyPtr);
+  if (valid)
+    {
+    int numComp = this->NumberOfComponents;
+    for (vtkIdType i = 0; i <= this->MaxId; ++i)
+      {
+      if (this->Arrays[i % numComp][i / numComp] == val)
+        {
+        ids->InsertNextId(i);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetArray(int comp, T* array,
+                                          vtkIdType numTuples, int save,
+                                          int deleteMethod)
+{
+  int numComp = this->NumberOfComponents;
+  if (comp < 0 || comp >= numComp)
+    {
+    vtkErrorMacro("Component " << comp << " out of range [0, "
+                  << numComp << ").");
+    return;
+    }
+  if (this->NumberOfArrays != numComp)
+    {
+    this->ReallocateBuffers(0);
+    }
+
+  // Release the replaced buffer before resizing the others so that the
+  // memory peak stays as low as possible.
+  vtkIdType oldTuples = this->Size / numComp;
+  this->DeleteBuffer(comp);
+  if (numTuples != oldTuples)
+    {
+    for (int c = 0; c < numComp; ++c)
+      {
+      if (c != comp && !this->ReallocateBuffer(c, oldTuples, numTuples))
+        {
+        return;
+        }
+      }
+    }
+
+  this->Arrays[comp] = array;
+  this->SaveUserArrays[comp] = save;
+  this->DeleteMethods[comp] = deleteMethod;
+  this->Size = numTuples * numComp;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetArrays(T* const* arrays,
+                                           vtkIdType numTuples, int save,
+                                           int deleteMethod)
+{
+  int numComp = this->NumberOfComponents;
+  if (this->NumberOfArrays != numComp)
+    {
+    this->ReallocateBuffers(0);
+    }
+
+  for (int c = 0; c < numComp; ++c)
+    {
+    this->DeleteBuffer(c);
+    this->Arrays[c] = arrays[c];
+    this->SaveUserArrays[c] = save;
+    this->DeleteMethods[c] = deleteMethod;
+    }
+  this->Size = numTuples * numComp;
+  this->MaxId = this->Size - 1;
+  this->DataChanged();
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkSOADataArrayTemplate<T>::SetVoidArray(void* array, vtkIdType size,
+                                              int save, int deleteMethod)
+{
+  if (this->NumberOfComponents != 1)
+    {
+    vtkErrorMacro("SetVoidArray is only supported for arrays with one "
+                  "component, use SetArray instead.");
+    return;
+    }
+  this->SetArray(0, static_cast<T*>(array), size, save, deleteMethod);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T* vtkSOADataArrayTemplate<T>::GetComponentArrayPointer(int comp)
+{
+  if (comp < 0 || comp >= this->NumberOfArrays)
+    {
+    return 0;
+    }
+  return this->Arrays[comp];
+}
+
+#endif
@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAsynchronousUpdate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsynchronousUpdate.h"
+#include "vtkCellArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/SystemTools.hxx>
+
+// A source producing one point per millisecond, which stops when it is
+// aborted.
+class vtkSlowPointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkSlowPointSource *New();
+  vtkTypeMacro(vtkSlowPointSource,vtkPolyDataAlgorithm);
+
+  int NumberOfPoints;
+  int NumberOfExecutions;
+  int PointsGenerated;
+
+protected:
+  vtkSlowPointSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfPoints = 100;
+    this->NumberOfExecutions = 0;
+    this->PointsGenerated = 0;
+    }
+
+  int RequestData(vtkInformation *, vtkInformationVector **,
+                  vtkInformationVector *outputVector)
+    {
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    vtkPoints *points = vtkPoints::New();
+    vtkCellArray *verts = vtkCellArray::New();
+    this->NumberOfExecutions++;
+    this->PointsGenerated = 0;
+    for (vtkIdType i = 0; i < this->NumberOfPoints && !this->AbortExecute;
+         i++)
+      {
+      vtksys::SystemTools::Delay(1);
+      vtkIdType id = points->InsertNextPoint(i, 0.0, 0.0);
+      verts->InsertNextCell(1, &id);
+      this->PointsGenerated++;
+      this->UpdateProgress(static_cast<double>(i) / this->NumberOfPoints);
+      }
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    points->Delete();
+    verts->Delete();
+    return 1;
+    }
+};
+
+vtkStandardNewMacro(vtkSlowPointSource);
+
+int TestAsynchronousUpdate(int, char *[])
+{
+  int retVal = 0;
+
+  vtkSmartPointer<vtkSlowPointSource> source =
+    vtkSmartPointer<vtkSlowPointSource>::New();
+  vtkSmartPointer<vtkElevationFilter> elevation =
+    vtkSmartPointer<vtkElevationFilter>::New();
+  elevation->SetInputConnection(source->GetOutputPort());
+  vtkStreamingDemandDrivenPipeline *sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(elevation->GetExecutive());
+
+  // An update that runs to completion.
+  vtkAsynchronousUpdate *update = sddp->UpdateAsynchronously(0);
+  if (!update->Wait() ||
+      update->GetStatus() != vtkAsynchronousUpdate::COMPLETED ||
+      update->GetProgress() != 1.0)
+    {
+    cerr << "The update did not complete" << endl;
+    retVal = 1;
+    }
+  vtkPolyData *output = vtkPolyData::SafeDownCast(update->GetOutput());
+  if (!output || output == elevation->GetOutput() ||
+      output->GetNumberOfPoints() != 100 ||
+      !output->GetPointData()->GetScalars())
+    {
+    cerr << "Wrong output of the completed update" << endl;
+    retVal = 1;
+    }
+  update->Delete();
+
+  // An update that is cancelled while the source executes.
+  source->NumberOfPoints = 10000;
+  source->Modified();
+  update = sddp->UpdateAsynchronously(0);
+  while (update->GetProgress() == 0.0 && !update->IsDone())
+    {
+    vtksys::SystemTools::Delay(1);
+    }
+  update->Cancel();
+  if (update->Wait() ||
+      update->GetStatus() != vtkAsynchronousUpdate::CANCELLED ||
+      update->GetOutput())
+    {
+    cerr << "The update was not cancelled" << endl;
+    retVal = 1;
+    }
+  if (source->PointsGenerated >= source->NumberOfPoints)
+    {
+    cerr << "The source was not aborted" << endl;
+    retVal = 1;
+    }
+
+  // The aborted source must execute again, to completion although the
+  // handle of the cancelled update is still alive.
+  source->NumberOfPoints = 10;
+  int numExecutions = source->NumberOfExecutions;
+  elevation->Update();
+  if (source->NumberOfExecutions != numExecutions + 1 ||
+      elevation->GetOutput()->GetNumberOfPoints() != 10)
+    {
+    cerr << "The aborted source did not execute again" << endl;
+    retVal = 1;
+    }
+  update->Delete();
+
+  // Deleting the handle of a running update cancels it.
+  source->NumberOfPoints = 10000;
+  source->Modified();
+  update = sddp->UpdateAsynchronously(0);
+  update->Delete();
+  if (source->PointsGenerated >= source->NumberOfPoints)
+    {
+    cerr << "The update of a deleted handle was not cancelled" << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
@@ -0,0 +1,290 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkBVHCellLocator finds the same cells, intersections and
+// closest points as vtkCellLocator on a hexahedral grid graded like a
+// boundary layer, and reports the time taken by the build and the queries
+// of vtkBVHCellLocator, vtkCellLocator and vtkCellTreeLocator.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <math.h>
+#include <vector>
+
+#define RES 30
+#define LAYERS 40
+#define NUMBER_OF_QUERIES 2000
+
+// A RES x RES x LAYERS grid of hexahedra whose thickness grows
+// geometrically from about 1e-6 at z = 0 to 0.1 at z = 1.
+static vtkUnstructuredGrid *MakeGradedGrid()
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = vtkPoints::New();
+  const double ratio = 1.4, last = pow(ratio, LAYERS) - 1.0;
+  int i, j, k;
+  for (k = 0; k <= LAYERS; k++)
+    {
+    double z = (pow(ratio, k) - 1.0) / last;
+    for (j = 0; j <= RES; j++)
+      {
+      for (i = 0; i <= RES; i++)
+        {
+        points->InsertNextPoint(static_cast<double>(i) / RES,
+                                static_cast<double>(j) / RES, z);
+        }
+      }
+    }
+  grid->SetPoints(points);
+  points->Delete();
+
+  const vtkIdType dj = RES + 1, dk = (RES + 1) * (RES + 1);
+  vtkIdType hex[8];
+  grid->Allocate(RES * RES * LAYERS);
+  for (k = 0; k < LAYERS; k++)
+    {
+    for (j = 0; j < RES; j++)
+      {
+      for (i = 0; i < RES; i++)
+        {
+        hex[0] = i + j * dj + k * dk;
+        hex[1] = hex[0] + 1;
+        hex[2] = hex[1] + dj;
+        hex[3] = hex[0] + dj;
+        hex[4] = hex[0] + dk;
+        hex[5] = hex[1] + dk;
+        hex[6] = hex[2] + dk;
+        hex[7] = hex[3] + dk;
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+      }
+    }
+  return grid;
+}
+
+// The query points, most of them in the thin layers, the lines, coming
+// from above and below the grid, and points around the grid.
+struct Queries
+{
+  std::vector<double> Inside, P1, P2, Outside;
+};
+
+static void MakeQueries(Queries &q)
+{
+  vtkMath::RandomSeed(1408);
+  for (int i = 0; i < NUMBER_OF_QUERIES; i++)
+    {
+    q.Inside.push_back(vtkMath::Random(0.0, 1.0));
+    q.Inside.push_back(vtkMath::Random(0.0, 1.0));
+    q.Inside.push_back(pow(10.0, vtkMath::Random(-7.0, 0.0)));
+    double side = (i % 2 ? 1.5 : -0.5);
+    q.P1.push_back(vtkMath::Random(-0.2, 1.2));
+    q.P1.push_back(vtkMath::Random(-0.2, 1.2));
+    q.P1.push_back(side);
+    q.P2.push_back(vtkMath::Random(0.0, 1.0));
+    q.P2.push_back(vtkMath::Random(0.0, 1.0));
+    q.P2.push_back(pow(10.0, vtkMath::Random(-7.0, 0.0)));
+    for (int j = 0; j < 3; j++)
+      {
+      q.Outside.push_back(vtkMath::Random(-1.0, 2.0));
+      }
+    }
+}
+
+// The results of the queries for one locator.
+struct Results
+{
+  std::vector<vtkIdType> FoundCells;
+  std::vector<double> T, Dist2;
+};
+
+static void RunQueries(vtkAbstractCellLocator *locator,
+                       vtkUnstructuredGrid *grid, Queries &q, Results &r,
+                       bool closestPoints)
+{
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  double pcoords[3], weights[8], x[3], t;
+  int i, subId;
+  vtkIdType cellId;
+
+  locator->SetDataSet(grid);
+  locator->CacheCellBoundsOn();
+  timer->StartTimer();
+  locator->BuildLocator();
+  timer->StopTimer();
+  cout << locator->GetClassName() << ": build " << timer->GetElapsedTime()
+       << " s";
+
+  timer->StartTimer();
+  for (i = 0; i < NUMBER_OF_QUERIES; i++)
+    {
+    r.FoundCells.push_back(locator->FindCell(&q.Inside[3*i], 0.0, cell,
+                                             pcoords, weights));
+    }
+  timer->StopTimer();
+  cout << ", FindCell " << timer->GetElapsedTime() << " s";
+
+  timer->StartTimer();
+  for (i = 0; i < NUMBER_OF_QUERIES; i++)
+    {
+    if (!locator->IntersectWithLine(&q.P1[3*i], &q.P2[3*i], 0.0, t, x,
+                                    pcoords, subId, cellId, cell))
+      {
+      t = -1.0;
+      }
+    r.T.push_back(t);
+    }
+  timer->StopTimer();
+  cout << ", IntersectWithLine " << timer->GetElapsedTime() << " s";
+
+  if (closestPoints)
+    {
+    double dist2;
+    timer->StartTimer();
+    for (i = 0; i < NUMBER_OF_QUERIES; i++)
+      {
+      locator->FindClosestPoint(&q.Outside[3*i], x, cell, cellId, subId,
+                                dist2);
+      r.Dist2.push_back(dist2);
+      }
+    timer->StopTimer();
+    cout << ", FindClosestPoint " << timer->GetElapsedTime() << " s";
+    }
+  cout << endl;
+}
+
+// The parametric coordinate of the nearest intersection of the line with
+// all the cells, or -1 if the line misses them.
+static double IntersectAllCells(vtkUnstructuredGrid *grid, double p1[3],
+                                double p2[3])
+{
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  double best = VTK_DOUBLE_MAX, t, x[3], pcoords[3];
+  int subId;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); cellId++)
+    {
+    grid->GetCell(cellId, cell);
+    if (cell->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId) &&
+        t < best)
+      {
+      best = t;
+      }
+    }
+  return (best == VTK_DOUBLE_MAX ? -1.0 : best);
+}
+
+int TestBVHCellLocator(int, char *[])
+{
+  vtkUnstructuredGrid *grid = MakeGradedGrid();
+  Queries queries;
+  MakeQueries(queries);
+
+  Results expected, results, treeResults;
+  vtkSmartPointer<vtkCellLocator> cellLocator =
+    vtkSmartPointer<vtkCellLocator>::New();
+  RunQueries(cellLocator, grid, queries, expected, true);
+  vtkSmartPointer<vtkCellTreeLocator> cellTree =
+    vtkSmartPointer<vtkCellTreeLocator>::New();
+  RunQueries(cellTree, grid, queries, treeResults, false);
+  vtkSmartPointer<vtkBVHCellLocator> bvh =
+    vtkSmartPointer<vtkBVHCellLocator>::New();
+  RunQueries(bvh, grid, queries, results, true);
+  cout << "vtkBVHCellLocator: " << bvh->GetNumberOfNodes() << " nodes, depth "
+       << bvh->GetDepth() << endl;
+
+  int retVal = 0, i;
+  for (i = 0; i < NUMBER_OF_QUERIES; i++)
+    {
+    if (results.FoundCells[i] != expected.FoundCells[i])
+      {
+      cerr << "FindCell: found " << results.FoundCells[i] << " instead of "
+           << expected.FoundCells[i] << " for point " << i << endl;
+      retVal = 1;
+      }
+    // vtkCellLocator may miss the nearest of the thin cells, so the
+    // differences are checked against all the cells.
+    if (fabs(results.T[i] - expected.T[i]) > 1.0e-9 &&
+        fabs(results.T[i] - IntersectAllCells(grid, &queries.P1[3*i],
+                                              &queries.P2[3*i])) > 1.0e-12)
+      {
+      cerr << "IntersectWithLine: t is " << results.T[i] << " instead of "
+           << expected.T[i] << " for line " << i << endl;
+      retVal = 1;
+      }
+    if (fabs(results.Dist2[i] - expected.Dist2[i]) > 1.0e-9)
+      {
+      cerr << "FindClosestPoint: dist2 is " << results.Dist2[i]
+           << " instead of " << expected.Dist2[i] << " for point " << i
+           << endl;
+      retVal = 1;
+      }
+    }
+
+  // The batched intersection gives the same parametric coordinates.
+  std::vector<vtkIdType> cellIds(NUMBER_OF_QUERIES);
+  std::vector<double> t(NUMBER_OF_QUERIES);
+  bvh->IntersectWithLines(NUMBER_OF_QUERIES, &queries.P1[0], &queries.P2[0],
+                          0.0, &cellIds[0], &t[0], NULL);
+  for (i = 0; i < NUMBER_OF_QUERIES; i++)
+    {
+    if ((cellIds[i] < 0 ? -1.0 : t[i]) != results.T[i])
+      {
+      cerr << "IntersectWithLines: wrong hit for line " << i << endl;
+      retVal = 1;
+      break;
+      }
+    }
+
+  // Cells within bounds, compared to a brute force search.
+  double bbox[6] = { 0.2, 0.4, 0.3, 0.5, 0.0, 1.0e-4 }, b[6];
+  vtkSmartPointer<vtkIdList> cells = vtkSmartPointer<vtkIdList>::New();
+  bvh->FindCellsWithinBounds(bbox, cells);
+  vtkIdType count = 0;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); cellId++)
+    {
+    grid->GetCellBounds(cellId, b);
+    count += (b[0] <= bbox[1] && b[1] >= bbox[0] && b[2] <= bbox[3] &&
+              b[3] >= bbox[2] && b[4] <= bbox[5] && b[5] >= bbox[4]);
+    }
+  if (cells->GetNumberOfIds() != count || count == 0)
+    {
+    cerr << "FindCellsWithinBounds: " << cells->GetNumberOfIds()
+         << " cells instead of " << count << endl;
+    retVal = 1;
+    }
+
+  vtkSmartPointer<vtkPolyData> representation =
+    vtkSmartPointer<vtkPolyData>::New();
+  bvh->GenerateRepresentation(1, representation);
+  if (representation->GetNumberOfLines() != 24)
+    {
+    cerr << "GenerateRepresentation: " << representation->GetNumberOfLines()
+         << " lines at level 1" << endl;
+    retVal = 1;
+    }
+
+  grid->Delete();
+  return retVal;
+}
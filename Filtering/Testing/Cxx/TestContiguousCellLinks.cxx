@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContiguousCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the contiguous and 32 bit cell links give the same lists as
+// the regular ones, for a tetrahedral grid and a triangle mesh, and
+// reports the time and the memory taken by each storage.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#define RES 40
+
+// Each hexahedron of a RES^3 grid split into 6 tetrahedra.
+static vtkUnstructuredGrid *MakeTetGrid()
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = vtkPoints::New();
+  int i, j, k, t;
+  for (k = 0; k <= RES; k++)
+    {
+    for (j = 0; j <= RES; j++)
+      {
+      for (i = 0; i <= RES; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  grid->SetPoints(points);
+  points->Delete();
+
+  static const int tets[6][4] = { {0,1,3,7}, {0,1,7,5}, {0,5,7,4},
+                                  {1,2,3,7}, {1,6,7,2}, {1,5,7,6} };
+  const vtkIdType dj = RES + 1, dk = (RES + 1) * (RES + 1);
+  vtkIdType hex[8], pts[4];
+  grid->Allocate(6 * RES * RES * RES);
+  for (k = 0; k < RES; k++)
+    {
+    for (j = 0; j < RES; j++)
+      {
+      for (i = 0; i < RES; i++)
+        {
+        hex[0] = i + j * dj + k * dk;
+        hex[1] = hex[0] + 1;
+        hex[2] = hex[1] + dj;
+        hex[3] = hex[0] + dj;
+        hex[4] = hex[0] + dk;
+        hex[5] = hex[1] + dk;
+        hex[6] = hex[2] + dk;
+        hex[7] = hex[3] + dk;
+        for (t = 0; t < 6; t++)
+          {
+          pts[0] = hex[tets[t][0]];
+          pts[1] = hex[tets[t][1]];
+          pts[2] = hex[tets[t][2]];
+          pts[3] = hex[tets[t][3]];
+          grid->InsertNextCell(VTK_TETRA, 4, pts);
+          }
+        }
+      }
+    }
+  return grid;
+}
+
+// A (RES*10)^2 grid of quads split into triangles.
+static vtkPolyData *MakeTriangleMesh()
+{
+  const int res = RES * 10;
+  vtkPolyData *mesh = vtkPolyData::New();
+  vtkPoints *points = vtkPoints::New();
+  vtkCellArray *polys = vtkCellArray::New();
+  int i, j;
+  for (j = 0; j <= res; j++)
+    {
+    for (i = 0; i <= res; i++)
+      {
+      points->InsertNextPoint(i, j, 0.0);
+      }
+    }
+  vtkIdType pts[3];
+  for (j = 0; j < res; j++)
+    {
+    for (i = 0; i < res; i++)
+      {
+      pts[0] = i + j * (res + 1);
+      pts[1] = pts[0] + 1;
+      pts[2] = pts[1] + res + 1;
+      polys->InsertNextCell(3, pts);
+      pts[1] = pts[2];
+      pts[2] = pts[0] + res + 1;
+      polys->InsertNextCell(3, pts);
+      }
+    }
+  mesh->SetPoints(points);
+  mesh->SetPolys(polys);
+  points->Delete();
+  polys->Delete();
+  return mesh;
+}
+
+// Return 1 if the lists of the two links differ.
+static int CompareLinks(vtkCellLinks *expected, vtkCellLinks *links,
+                        vtkIdType numPts, const char *name)
+{
+  vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    unsigned short ncells = expected->GetNcells(ptId);
+    vtkIdType *cells = links->GetCells(ptId);
+    links->GetCells(ptId, ids);
+    int differ = (links->GetNcells(ptId) != ncells ||
+                  ids->GetNumberOfIds() != ncells);
+    for (unsigned short i = 0; !differ && i < ncells; i++)
+      {
+      vtkIdType cellId = expected->GetCells(ptId)[i];
+      differ = (cells[i] != cellId || ids->GetId(i) != cellId ||
+                links->GetCellId(ptId, i) != cellId);
+      }
+    if (differ)
+      {
+      cerr << name << ": wrong cells for point " << ptId << endl;
+      return 1;
+      }
+    }
+  return 0;
+}
+
+// Build the links of the dataset with each storage, report the time and
+// the memory taken, and compare the lists to the regular ones.
+template <class TDataSet>
+static int TestStorages(TDataSet *data, const char *name)
+{
+  int retVal = 0;
+  vtkIdType numPts = data->GetNumberOfPoints();
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+
+  timer->StartTimer();
+  data->BuildLinks();
+  timer->StopTimer();
+  vtkSmartPointer<vtkCellLinks> regular = data->GetCellLinks();
+  cout << name << " (" << data->GetNumberOfCells() << " cells) regular links: "
+       << timer->GetElapsedTime() << " s, "
+       << regular->GetActualMemorySize() << " kB" << endl;
+
+  data->UseContiguousLinksOn();
+  timer->StartTimer();
+  data->BuildLinks();
+  timer->StopTimer();
+  vtkCellLinks *links = data->GetCellLinks();
+  cout << name << " contiguous links: " << timer->GetElapsedTime() << " s, "
+       << links->GetActualMemorySize() << " kB" << endl;
+  retVal |= CompareLinks(regular, links, numPts, name);
+  if (links->GetActualMemorySize() >= regular->GetActualMemorySize())
+    {
+    cerr << name << ": the contiguous links are not smaller" << endl;
+    retVal = 1;
+    }
+
+  vtkSmartPointer<vtkCellLinks> compact = vtkSmartPointer<vtkCellLinks>::New();
+  compact->Use32BitStorageOn();
+  compact->Allocate(numPts);
+  timer->StartTimer();
+  compact->BuildLinks(data);
+  timer->StopTimer();
+  cout << name << " 32 bit links: " << timer->GetElapsedTime() << " s, "
+       << compact->GetActualMemorySize() << " kB" << endl;
+  retVal |= CompareLinks(regular, compact, numPts, name);
+
+  // Copying, converting back and editing the contiguous links.
+  vtkSmartPointer<vtkCellLinks> copy = vtkSmartPointer<vtkCellLinks>::New();
+  copy->DeepCopy(links);
+  retVal |= CompareLinks(regular, copy, numPts, name);
+  copy->UseContiguousStorageOff();
+  retVal |= CompareLinks(regular, copy, numPts, name);
+  links->ResizeCellList(0, 1);
+  links->AddCellReference(VTK_LARGE_ID, 0);
+  if (links->GetNcells(0) != regular->GetNcells(0) + 1 ||
+      links->GetCellId(0, regular->GetNcells(0)) != VTK_LARGE_ID)
+    {
+    cerr << name << ": the contiguous links cannot be edited" << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
+
+int TestContiguousCellLinks(int, char *[])
+{
+  int retVal = 0;
+
+  vtkUnstructuredGrid *grid = MakeTetGrid();
+  retVal |= TestStorages(grid, "vtkUnstructuredGrid");
+  grid->Delete();
+
+  vtkPolyData *mesh = MakeTriangleMesh();
+  retVal |= TestStorages(mesh, "vtkPolyData");
+  mesh->Delete();
+
+  return retVal;
+}
@@ -0,0 +1,194 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetAttributesBulkCopy.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the bulk forms of vtkDataSetAttributes::CopyData() and
+// InterpolatePoints() give the same results as the per tuple forms, for
+// arrays copied directly and for arrays that fall back to the generic API.
+
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtksys/ios/sstream>
+
+static vtkSmartPointer<vtkPointData> MakeSource(vtkIdType n)
+{
+  vtkSmartPointer<vtkPointData> pd = vtkSmartPointer<vtkPointData>::New();
+
+  vtkSmartPointer<vtkDoubleArray> doubles =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  doubles->SetName("doubles");
+  doubles->SetNumberOfComponents(3);
+  vtkSmartPointer<vtkIntArray> ints = vtkSmartPointer<vtkIntArray>::New();
+  ints->SetName("ints");
+  vtkSmartPointer<vtkUnsignedCharArray> chars =
+    vtkSmartPointer<vtkUnsignedCharArray>::New();
+  chars->SetName("chars");
+  chars->SetNumberOfComponents(2);
+  vtkSmartPointer<vtkBitArray> bits = vtkSmartPointer<vtkBitArray>::New();
+  bits->SetName("bits");
+  vtkSmartPointer<vtkSOADataArrayTemplate<float> > soa =
+    vtkSmartPointer<vtkSOADataArrayTemplate<float> >::New();
+  soa->SetName("soa");
+  soa->SetNumberOfComponents(2);
+  vtkSmartPointer<vtkStringArray> strings =
+    vtkSmartPointer<vtkStringArray>::New();
+  strings->SetName("strings");
+
+  for (vtkIdType i = 0; i < n; ++i)
+    {
+    double x = static_cast<double>(i);
+    doubles->InsertNextTuple3(x, 0.5*x, -x);
+    ints->InsertNextTuple1(3*x);
+    chars->InsertNextTuple2(i % 256, 255 - i % 256);
+    bits->InsertNextTuple1(i % 2);
+    soa->InsertNextTuple2(x, x + 0.25);
+    vtksys_ios::ostringstream os;
+    os << "s" << i;
+    strings->InsertNextValue(os.str());
+    }
+  pd->AddArray(doubles);
+  pd->AddArray(ints);
+  pd->AddArray(chars);
+  pd->AddArray(bits);
+  pd->AddArray(soa);
+  pd->AddArray(strings);
+  return pd;
+}
+
+static int Compare(vtkPointData *expected, vtkPointData *actual,
+                   const char *what)
+{
+  int retVal = 0;
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+    {
+    vtkAbstractArray *e = expected->GetAbstractArray(a);
+    vtkAbstractArray *r = actual->GetAbstractArray(e->GetName());
+    if (!r || r->GetNumberOfTuples() != e->GetNumberOfTuples())
+      {
+      cerr << what << ": wrong size for " << e->GetName() << endl;
+      retVal = 1;
+      continue;
+      }
+    vtkIdType numValues = e->GetNumberOfTuples()*e->GetNumberOfComponents();
+    for (vtkIdType v = 0; v < numValues; ++v)
+      {
+      if (e->GetVariantValue(v) != r->GetVariantValue(v))
+        {
+        cerr << what << ": value " << v << " of " << e->GetName() << " is "
+             << r->GetVariantValue(v).ToString() << " instead of "
+             << e->GetVariantValue(v).ToString() << endl;
+        retVal = 1;
+        break;
+        }
+      }
+    }
+  return retVal;
+}
+
+int TestDataSetAttributesBulkCopy(int, char *[])
+{
+  int retVal = 0;
+  const vtkIdType n = 100;
+  vtkSmartPointer<vtkPointData> source = MakeSource(n);
+
+  // Id lists, in an order that is neither increasing nor contiguous.
+  vtkSmartPointer<vtkIdList> fromIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> toIds = vtkSmartPointer<vtkIdList>::New();
+  for (vtkIdType i = 0; i < n/2; ++i)
+    {
+    fromIds->InsertNextId((7*i) % n);
+    toIds->InsertNextId(n/2 - 1 - i);
+    }
+  vtkSmartPointer<vtkPointData> expected = vtkSmartPointer<vtkPointData>::New();
+  vtkSmartPointer<vtkPointData> actual = vtkSmartPointer<vtkPointData>::New();
+  expected->CopyAllocate(source, n/2);
+  actual->CopyAllocate(source, n/2);
+  for (vtkIdType i = 0; i < n/2; ++i)
+    {
+    expected->CopyData(source, fromIds->GetId(i), toIds->GetId(i));
+    }
+  actual->CopyData(source, fromIds, toIds);
+  retVal |= Compare(expected, actual, "id lists");
+
+  // A range.
+  expected = vtkSmartPointer<vtkPointData>::New();
+  actual = vtkSmartPointer<vtkPointData>::New();
+  expected->CopyAllocate(source, n);
+  actual->CopyAllocate(source, n);
+  for (vtkIdType i = 0; i < 30; ++i)
+    {
+    expected->CopyData(source, 10 + i, i);
+    expected->CopyData(source, 60 + i, 30 + i);
+    }
+  actual->CopyData(source, 0, 30, 10);
+  actual->CopyData(source, 30, 30, 60);
+  retVal |= Compare(expected, actual, "range");
+
+  // Overlapping ranges of the same arrays, in both directions.
+  for (int direction = 0; direction < 2; ++direction)
+    {
+    vtkIdType srcStart = direction ? 10 : 0;
+    vtkIdType dstStart = direction ? 0 : 10;
+    expected = vtkSmartPointer<vtkPointData>::New();
+    expected->CopyAllocate(source, n);
+    for (vtkIdType i = 0; i < n; ++i)
+      {
+      vtkIdType fromId = i;
+      if (i >= dstStart && i < dstStart + 50)
+        {
+        fromId = i - dstStart + srcStart;
+        }
+      expected->CopyData(source, fromId, i);
+      }
+    actual = MakeSource(n);
+    actual->CopyAllocate(actual, n);
+    actual->CopyData(actual, dstStart, 50, srcStart);
+    retVal |= Compare(expected, actual, "overlapping range");
+    }
+
+  // Stencils of different sizes.
+  vtkIdType offsets[4] = { 0, 1, 3, 6 };
+  vtkIdType ids[6] = { 5, 10, 11, 20, 40, 99 };
+  double weights[6] = { 1.0, 0.25, 0.75, 0.2, 0.3, 0.5 };
+  expected = vtkSmartPointer<vtkPointData>::New();
+  actual = vtkSmartPointer<vtkPointData>::New();
+  expected->InterpolateAllocate(source, 5);
+  actual->InterpolateAllocate(source, 5);
+  vtkSmartPointer<vtkIdList> stencil = vtkSmartPointer<vtkIdList>::New();
+  for (vtkIdType i = 0; i < 3; ++i)
+    {
+    stencil->Reset();
+    for (vtkIdType j = offsets[i]; j < offsets[i+1]; ++j)
+      {
+      stencil->InsertNextId(ids[j]);
+      }
+    expected->InterpolatePoint(source, i, stencil, weights + offsets[i]);
+    }
+  actual->InterpolatePoints(source, 0, 3, offsets, ids, weights);
+  retVal |= Compare(expected, actual, "stencils");
+
+  // Mismatched lists are refused.
+  toIds->InsertNextId(0);
+  cout << "Expecting an error:" << endl;
+  actual->CopyData(source, fromIds, toIds);
+
+  return retVal;
+}
@@ -0,0 +1,295 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetThreadedAccess.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the thread safe query methods of the datasets give the same
+// answers from several threads once PrepareForThreadedAccess() was called.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/vector>
+
+#define RES 12
+
+// Points of a regular RES^3 lattice of unit spacing.
+static vtkPoints *MakeLatticePoints(int nz)
+{
+  vtkPoints *points = vtkPoints::New();
+  for (int k = 0; k < nz; k++)
+    {
+    for (int j = 0; j <= RES; j++)
+      {
+      for (int i = 0; i <= RES; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  return points;
+}
+
+static vtkUnstructuredGrid *MakeHexGrid(int use32Bits)
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = MakeLatticePoints(RES + 1);
+  grid->SetPoints(points);
+  points->Delete();
+  grid->SetUse32BitStorage(use32Bits);
+
+  const vtkIdType dj = RES + 1, dk = (RES + 1) * (RES + 1);
+  vtkIdType pts[8];
+  grid->Allocate(RES * RES * RES);
+  for (int k = 0; k < RES; k++)
+    {
+    for (int j = 0; j < RES; j++)
+      {
+      for (int i = 0; i < RES; i++)
+        {
+        pts[0] = i + j * dj + k * dk;
+        pts[1] = pts[0] + 1;
+        pts[2] = pts[1] + dj;
+        pts[3] = pts[0] + dj;
+        pts[4] = pts[0] + dk;
+        pts[5] = pts[1] + dk;
+        pts[6] = pts[2] + dk;
+        pts[7] = pts[3] + dk;
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+        }
+      }
+    }
+  return grid;
+}
+
+static vtkPolyData *MakeQuadMesh(int use32Bits)
+{
+  vtkPolyData *mesh = vtkPolyData::New();
+  vtkPoints *points = MakeLatticePoints(1);
+  mesh->SetPoints(points);
+  points->Delete();
+
+  vtkCellArray *polys = vtkCellArray::New();
+  polys->SetUse32BitStorage(use32Bits);
+  vtkIdType pts[4];
+  for (int j = 0; j < RES; j++)
+    {
+    for (int i = 0; i < RES; i++)
+      {
+      pts[0] = i + j * (RES + 1);
+      pts[1] = pts[0] + 1;
+      pts[2] = pts[1] + RES + 1;
+      pts[3] = pts[0] + RES + 1;
+      polys->InsertNextCell(4, pts);
+      }
+    }
+  mesh->SetPolys(polys);
+  polys->Delete();
+  return mesh;
+}
+
+// Reduces the answers of the queries on a point or a cell to one number
+// per point and per cell.
+class vtkDataSetQueryFunctor
+{
+public:
+  vtkDataSet *DataSet;
+  bool Cells;
+  double *Result;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    vtkSmartPointer<vtkIdList> nbrs = vtkSmartPointer<vtkIdList>::New();
+    vtkSmartPointer<vtkGenericCell> cell =
+      vtkSmartPointer<vtkGenericCell>::New();
+    double x[3], bounds[6], pcoords[3], weights[8];
+    int subId;
+    for (vtkIdType id = begin; id < end; id++)
+      {
+      double sum = 0.0;
+      vtkIdType i;
+      if (this->Cells)
+        {
+        this->DataSet->GetCell(id, cell);
+        this->DataSet->GetCellPoints(id, ids);
+        this->DataSet->GetCellBounds(id, bounds);
+        for (i = 0; i < ids->GetNumberOfIds(); i++)
+          {
+          sum += ids->GetId(i) + cell->GetPointId(i);
+          }
+        sum += bounds[0] + 3.0 * bounds[3] + 5.0 * bounds[5];
+        sum += 7.0 * this->DataSet->GetCellType(id);
+
+        // The cells sharing the first edge.
+        ids->SetNumberOfIds(2);
+        ids->SetId(1, cell->GetPointId(1));
+        this->DataSet->GetCellNeighbors(id, ids, nbrs);
+        for (i = 0; i < nbrs->GetNumberOfIds(); i++)
+          {
+          sum += 11.0 * nbrs->GetId(i);
+          }
+        }
+      else
+        {
+        this->DataSet->GetPointCells(id, ids);
+        for (i = 0; i < ids->GetNumberOfIds(); i++)
+          {
+          sum += ids->GetId(i);
+          }
+
+        // The links of the point, decoded into a buffer of this thread.
+        vtkUnstructuredGrid *grid =
+          vtkUnstructuredGrid::SafeDownCast(this->DataSet);
+        if (grid)
+          {
+          vtkIdType ncells, *cells;
+          grid->GetCellLinks()->GetCells(id, ncells, cells, nbrs);
+          for (i = 0; i < ncells; i++)
+            {
+            sum += 19.0 * cells[i];
+            }
+          }
+        this->DataSet->GetPoint(id, x);
+        sum += 13.0 * this->DataSet->FindPoint(x);
+
+        // Locate a point inside the first cell using the point.
+        x[0] += 0.25; x[1] += 0.25; x[2] += 0.25;
+        sum += 17.0 * this->DataSet->FindCell(x, NULL, cell, -1, 0.0, subId,
+                                              pcoords, weights);
+        }
+      this->Result[id] = sum;
+      }
+    }
+};
+
+static int CheckThreadedAccess(const char *name, vtkDataSet *ds)
+{
+  ds->PrepareForThreadedAccess();
+
+  int retVal = 0;
+  for (int cells = 0; cells < 2; cells++)
+    {
+    vtkIdType num = cells ? ds->GetNumberOfCells() : ds->GetNumberOfPoints();
+    vtkstd::vector<double> serial(num), parallel(num);
+
+    vtkDataSetQueryFunctor functor;
+    functor.DataSet = ds;
+    functor.Cells = cells != 0;
+    functor.Result = &serial[0];
+    functor(0, num);
+    functor.Result = &parallel[0];
+    vtkSMPTools::For(0, num, 16, functor);
+
+    for (vtkIdType id = 0; id < num; id++)
+      {
+      if (serial[id] != parallel[id])
+        {
+        cerr << name << ": wrong threaded query of "
+             << (cells ? "cell " : "point ") << id << endl;
+        retVal = 1;
+        break;
+        }
+      }
+    }
+  return retVal;
+}
+
+// The thread safe methods must not go through the buffer that the 32 bit
+// connectivity shares between the callers of the pointer methods.
+static int CheckDecodeBuffer(vtkPolyData *mesh)
+{
+  vtkCellArray *polys = mesh->GetPolys();
+  vtkIdType npts, *pts;
+  polys->GetCellAtId(0, npts, pts);
+  vtkIdType first = pts[0];
+
+  vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> buffer = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkGenericCell> cell =
+    vtkSmartPointer<vtkGenericCell>::New();
+  double bounds[6];
+  vtkIdType npts2, *pts2;
+  mesh->GetCellPoints(RES, ids);
+  mesh->GetCell(RES + 1, cell);
+  mesh->GetCellBounds(RES + 2, bounds);
+  polys->GetCellAtId(RES + 3, npts2, pts2, buffer);
+  if (pts[0] != first || pts2[0] != RES + 4 || npts2 != 4 ||
+      !polys->GetUse32BitStorage())
+    {
+    cerr << "vtkPolyData (32 bit storage): the decode buffer was used"
+         << endl;
+    return 1;
+    }
+  return 0;
+}
+
+// Same as above for the buffer that the 32 bit links share between the
+// callers of GetLink() and GetCells(ptId).
+static int CheckLinksDecodeBuffer(vtkUnstructuredGrid *grid)
+{
+  vtkCellLinks *links = grid->GetCellLinks();
+  vtkIdType *shared = links->GetCells(0);
+  vtkIdType first = shared[0];
+
+  vtkSmartPointer<vtkIdList> buffer = vtkSmartPointer<vtkIdList>::New();
+  vtkIdType ncells, *cells;
+  links->GetCells(1, ncells, cells, buffer);
+  if (shared[0] != first || ncells != 2 || cells != buffer->GetPointer(0) ||
+      cells[0] != 0 || cells[1] != 1 || !links->GetUse32BitStorage())
+    {
+    cerr << "vtkUnstructuredGrid (32 bit storage): the links decode buffer "
+         << "was used" << endl;
+    return 1;
+    }
+  return 0;
+}
+
+int TestDataSetThreadedAccess(int, char *[])
+{
+  int retVal = 0;
+
+  vtkUnstructuredGrid *grid = MakeHexGrid(0);
+  retVal |= CheckThreadedAccess("vtkUnstructuredGrid", grid);
+  grid->Delete();
+
+  grid = MakeHexGrid(1);
+  retVal |= CheckThreadedAccess("vtkUnstructuredGrid (32 bit storage)", grid);
+#if VTK_SIZEOF_ID_TYPE > 4
+  retVal |= CheckLinksDecodeBuffer(grid);
+#endif
+  grid->Delete();
+
+  vtkPolyData *mesh = MakeQuadMesh(0);
+  retVal |= CheckThreadedAccess("vtkPolyData", mesh);
+  mesh->Delete();
+
+  mesh = MakeQuadMesh(1);
+  retVal |= CheckThreadedAccess("vtkPolyData (32 bit storage)", mesh);
+  retVal |= CheckDecodeBuffer(mesh);
+  mesh->Delete();
+
+  vtkImageData *image = vtkImageData::New();
+  image->SetDimensions(RES + 1, RES + 1, RES + 1);
+  retVal |= CheckThreadedAccess("vtkImageData", image);
+  image->Delete();
+
+  return retVal;
+}
@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExactOutputAllocation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkThreshold and vtkExtractGeometry count their output
+// before filling it, so that its arrays are allocated to their exact size.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkExtractGeometry.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSphere.h"
+#include "vtkThreshold.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+// Return 1 if every array of the grid holds its values exactly.
+static int CheckExact(vtkUnstructuredGrid *grid, const char *name)
+{
+  int exact = 1;
+  vtkDataArray *points = grid->GetPoints()->GetData();
+  if (points->GetSize() != points->GetNumberOfTuples() * 3)
+    {
+    cerr << name << ": points sized " << points->GetSize() << " for "
+         << points->GetNumberOfTuples() << " points" << endl;
+    exact = 0;
+    }
+  vtkIdTypeArray *connectivity = grid->GetCells()->GetData();
+  if (connectivity->GetSize() != connectivity->GetNumberOfTuples())
+    {
+    cerr << name << ": connectivity sized " << connectivity->GetSize()
+         << " for " << connectivity->GetNumberOfTuples() << " ids" << endl;
+    exact = 0;
+    }
+  if (grid->GetCellTypesArray()->GetSize() != grid->GetNumberOfCells() ||
+      grid->GetCellLocationsArray()->GetSize() != grid->GetNumberOfCells())
+    {
+    cerr << name << ": cell types and locations sized "
+         << grid->GetCellTypesArray()->GetSize() << " and "
+         << grid->GetCellLocationsArray()->GetSize() << " for "
+         << grid->GetNumberOfCells() << " cells" << endl;
+    exact = 0;
+    }
+  vtkFieldData *fields[2] = { grid->GetPointData(), grid->GetCellData() };
+  for (int f = 0; f < 2; ++f)
+    {
+    for (int a = 0; a < fields[f]->GetNumberOfArrays(); ++a)
+      {
+      vtkDataArray *array = fields[f]->GetArray(a);
+      if (array && array->GetSize() !=
+          array->GetNumberOfTuples() * array->GetNumberOfComponents())
+        {
+        cerr << name << ": " << array->GetName() << " sized "
+             << array->GetSize() << " for " << array->GetNumberOfTuples()
+             << " tuples" << endl;
+        exact = 0;
+        }
+      }
+    }
+  return exact;
+}
+
+int TestExactOutputAllocation(int, char *[])
+{
+  int rval = 0;
+
+  // AllocateExact() sizes the topology arrays once, to the given sizes.
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  grid->AllocateExact(7, 35);
+  if (grid->GetCells()->GetData()->GetSize() != 35 ||
+      grid->GetCellTypesArray()->GetSize() != 7 ||
+      grid->GetCellLocationsArray()->GetSize() != 7)
+    {
+    cerr << "AllocateExact(7, 35) sized the connectivity, types and "
+         << "locations to " << grid->GetCells()->GetData()->GetSize() << ", "
+         << grid->GetCellTypesArray()->GetSize() << " and "
+         << grid->GetCellLocationsArray()->GetSize() << endl;
+    rval = 1;
+    }
+  grid->Delete();
+
+  vtkImageData *image = vtkImageData::New();
+  image->SetExtent(-15, 15, -15, 15, -15, 15);
+  vtkElevationFilter *elevation = vtkElevationFilter::New();
+  elevation->SetInput(image);
+  elevation->SetLowPoint(-15, -15, -15);
+  elevation->SetHighPoint(15, 15, 15);
+  elevation->Update();
+  vtkDataSet *input = elevation->GetOutput();
+
+  // Count the cells whose points are all in the range.
+  vtkDataArray *scalars = input->GetPointData()->GetArray("Elevation");
+  vtkIdList *cellPts = vtkIdList::New();
+  vtkIdType expectedCells = 0;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+    {
+    input->GetCellPoints(cellId, cellPts);
+    int keep = 1;
+    for (vtkIdType i = 0; keep && i < cellPts->GetNumberOfIds(); ++i)
+      {
+      double s = scalars->GetTuple1(cellPts->GetId(i));
+      keep = (s >= 0.3 && s <= 0.6);
+      }
+    expectedCells += keep;
+    }
+  cellPts->Delete();
+
+  vtkThreshold *threshold = vtkThreshold::New();
+  threshold->SetInputConnection(elevation->GetOutputPort());
+  threshold->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "Elevation");
+  threshold->ThresholdBetween(0.3, 0.6);
+  threshold->Update();
+  vtkUnstructuredGrid *thresholded = threshold->GetOutput();
+  cout << "vtkThreshold: " << thresholded->GetNumberOfCells() << " cells, "
+       << thresholded->GetNumberOfPoints() << " points" << endl;
+  if (thresholded->GetNumberOfCells() != expectedCells ||
+      expectedCells == 0)
+    {
+    cerr << "vtkThreshold kept " << thresholded->GetNumberOfCells()
+         << " cells instead of " << expectedCells << endl;
+    rval = 1;
+    }
+  if (!CheckExact(thresholded, "vtkThreshold"))
+    {
+    rval = 1;
+    }
+
+  vtkSphere *sphere = vtkSphere::New();
+  sphere->SetRadius(10.0);
+  vtkExtractGeometry *extract = vtkExtractGeometry::New();
+  extract->SetInputConnection(elevation->GetOutputPort());
+  extract->SetImplicitFunction(sphere);
+  for (int boundary = 0; boundary < 2; ++boundary)
+    {
+    extract->SetExtractBoundaryCells(boundary);
+    extract->Update();
+    vtkUnstructuredGrid *extracted = extract->GetOutput();
+    cout << "vtkExtractGeometry (boundary " << boundary << "): "
+         << extracted->GetNumberOfCells() << " cells, "
+         << extracted->GetNumberOfPoints() << " points" << endl;
+    if (extracted->GetNumberOfCells() == 0 ||
+        !CheckExact(extracted, "vtkExtractGeometry"))
+      {
+      rval = 1;
+      }
+    // Every point of the output is used and inside the sphere or, for
+    // boundary cells, one of their points.
+    double x[3];
+    int inside = 0;
+    for (vtkIdType ptId = 0; ptId < extracted->GetNumberOfPoints(); ++ptId)
+      {
+      extracted->GetPoint(ptId, x);
+      inside += (sphere->EvaluateFunction(x) < 0.0);
+      }
+    if ((boundary == 0 && inside != extracted->GetNumberOfPoints()) ||
+        (boundary == 1 && inside >= extracted->GetNumberOfPoints()))
+      {
+      cerr << "vtkExtractGeometry: " << inside << " of "
+           << extracted->GetNumberOfPoints() << " points inside" << endl;
+      rval = 1;
+      }
+    }
+
+  extract->Delete();
+  sphere->Delete();
+  threshold->Delete();
+  elevation->Delete();
+  image->Delete();
+
+  return rval;
+}
@@ -12,8 +12,28 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
+#include "vtkArrayAllocator.h"
 #include "vtkGenericCell.h"
 #include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+// Go through a grid alternating tetrahedra, hexahedra and wedges with a
+// generic cell and return the number of allocations made by the arrays.
+static vtkTypeUInt64 CountCellAllocations(vtkUnstructuredGrid *grid,
+                                          vtkGenericCell *cell)
+{
+  vtkArrayAllocator *counter = vtkArrayAllocator::New();
+  vtkArrayAllocator::SetDefaultAllocator(counter);
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+    {
+    grid->GetCell(cellId, cell);
+    }
+  vtkArrayAllocator::SetDefaultAllocator(NULL);
+  vtkTypeUInt64 count = counter->GetNumberOfAllocations();
+  counter->Delete();
+  return count;
+}
 
 int TestGenericCell(int , char *[])
 {
@@ -94,6 +114,40 @@ int TestGenericCell(int , char *[])
 
   cell->Delete();
 
+  // A generic cell keeps the cells of the types it took, so going through
+  // a mixed grid allocates only when a type is first met.
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = vtkPoints::New();
+  for (int p = 0; p < 8; ++p)
+    {
+    points->InsertNextPoint(p & 1, (p >> 1) & 1, (p >> 2) & 1);
+    }
+  grid->SetPoints(points);
+  points->Delete();
+  vtkIdType tetra[4] = { 0, 1, 2, 4 };
+  vtkIdType hexahedron[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+  vtkIdType wedge[6] = { 0, 1, 2, 4, 5, 6 };
+  grid->Allocate(300);
+  for (int c = 0; c < 100; ++c)
+    {
+    grid->InsertNextCell(VTK_TETRA, 4, tetra);
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedron);
+    grid->InsertNextCell(VTK_WEDGE, 6, wedge);
+    }
+  cell = vtkGenericCell::New();
+  vtkTypeUInt64 first = CountCellAllocations(grid, cell);
+  vtkTypeUInt64 second = CountCellAllocations(grid, cell);
+  cout << "Allocations going through " << grid->GetNumberOfCells()
+       << " mixed cells: " << first << ", then " << second << endl;
+  if (first >= static_cast<vtkTypeUInt64>(grid->GetNumberOfCells()) ||
+      second != 0)
+    {
+    cerr << "The generic cell allocates at every change of cell type" << endl;
+    ++rval;
+    }
+  cell->Delete();
+  grid->Delete();
+
   return rval;
 }
 
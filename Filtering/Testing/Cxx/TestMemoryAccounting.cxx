@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryAccounting.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkMemoryAccounting finds the same size as
+// GetActualMemorySize() for data objects with auxiliary structures, counts
+// shared arrays once, attributes the outputs of a pipeline to the
+// algorithms that produced them, and that vtkPipelineProfiler records the
+// high-water mark of the executions.
+
+#include "vtkElevationFilter.h"
+#include "vtkMemoryAccounting.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkShrinkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string.h>
+#include <string>
+#include <vtksys/ios/sstream>
+
+#define RES 20
+
+static vtkUnstructuredGrid *MakeGrid()
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = vtkPoints::New();
+  int i, j, k;
+  for (k = 0; k <= RES; k++)
+    {
+    for (j = 0; j <= RES; j++)
+      {
+      for (i = 0; i <= RES; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  grid->SetPoints(points);
+  points->Delete();
+
+  const vtkIdType dj = RES + 1, dk = (RES + 1) * (RES + 1);
+  vtkIdType hex[8];
+  grid->Allocate(RES * RES * RES);
+  for (k = 0; k < RES; k++)
+    {
+    for (j = 0; j < RES; j++)
+      {
+      for (i = 0; i < RES; i++)
+        {
+        hex[0] = i + j * dj + k * dk;
+        hex[1] = hex[0] + 1;
+        hex[2] = hex[1] + dj;
+        hex[3] = hex[0] + dj;
+        hex[4] = hex[0] + dk;
+        hex[5] = hex[1] + dk;
+        hex[6] = hex[2] + dk;
+        hex[7] = hex[3] + dk;
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+      }
+    }
+  return grid;
+}
+
+// Return 1 if the accounting has an entry of the owner named name.
+static int HasEntry(vtkMemoryAccounting *accounting, const char *owner,
+                    const char *name)
+{
+  for (int i = 0; i < accounting->GetNumberOfEntries(); i++)
+    {
+    if (!strcmp(accounting->GetEntryOwner(i), owner) &&
+        !strcmp(accounting->GetEntryName(i), name))
+      {
+      return 1;
+      }
+    }
+  return 0;
+}
+
+static std::string OwnerName(vtkAlgorithm *algorithm)
+{
+  vtksys_ios::ostringstream owner;
+  owner << algorithm->GetClassName() << "(" << algorithm << "):0";
+  return owner.str();
+}
+
+int TestMemoryAccounting(int, char *[])
+{
+  int retVal = 0;
+
+  // The auxiliary structures are part of the size of a data object.
+  vtkUnstructuredGrid *grid = MakeGrid();
+  unsigned long bare = grid->GetActualMemorySize();
+  grid->BuildLinks();
+  double x[3] = { 2.5, 3.5, 4.5 };
+  grid->FindPoint(x);
+  if (grid->GetActualMemorySize() <= bare)
+    {
+    cerr << "Cell links and locator not in GetActualMemorySize()" << endl;
+    retVal = 1;
+    }
+
+  vtkSmartPointer<vtkMemoryAccounting> accounting =
+    vtkSmartPointer<vtkMemoryAccounting>::New();
+  accounting->AddDataObject(grid, "grid");
+  accounting->PrintReport(cout);
+  if (accounting->GetTotalSize() != grid->GetActualMemorySize())
+    {
+    cerr << "Accounted " << accounting->GetTotalSize() << " KiB instead of "
+         << grid->GetActualMemorySize() << " KiB" << endl;
+    retVal = 1;
+    }
+  if (!HasEntry(accounting, "grid", "CellLinks") ||
+      !HasEntry(accounting, "grid", "PointLocator") ||
+      !HasEntry(accounting, "grid", "Points") ||
+      !HasEntry(accounting, "grid", "Information"))
+    {
+    cerr << "Missing entries for the grid" << endl;
+    retVal = 1;
+    }
+
+  // A shallow copy shares the arrays, which are counted once.
+  vtkUnstructuredGrid *copy = vtkUnstructuredGrid::New();
+  copy->ShallowCopy(grid);
+  unsigned long total = accounting->GetTotalSize();
+  accounting->AddDataObject(copy, "copy");
+  if (accounting->GetTotalSize() - total != accounting->GetOwnerSize("copy") ||
+      HasEntry(accounting, "copy", "Connectivity") ||
+      HasEntry(accounting, "copy", "Points"))
+    {
+    cerr << "Shared arrays counted twice" << endl;
+    retVal = 1;
+    }
+  copy->Delete();
+  grid->Delete();
+
+  // The outputs of a pipeline, each attributed to its producer.
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  vtkSmartPointer<vtkElevationFilter> elevation =
+    vtkSmartPointer<vtkElevationFilter>::New();
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  vtkSmartPointer<vtkShrinkPolyData> shrink =
+    vtkSmartPointer<vtkShrinkPolyData>::New();
+  shrink->SetInputConnection(elevation->GetOutputPort());
+
+  vtkSmartPointer<vtkPipelineProfiler> profiler =
+    vtkSmartPointer<vtkPipelineProfiler>::New();
+  profiler->StartProfiling();
+  shrink->Update();
+  profiler->StopProfiling();
+
+  vtkPolyData *spherePolys = sphere->GetOutput();
+  vtkPolyData *elevated = elevation->GetPolyDataOutput();
+  spherePolys->BuildLinks();
+  accounting->Reset();
+  accounting->AddPipeline(shrink);
+  accounting->PrintReport(cout);
+  std::string sphereOwner = OwnerName(sphere);
+  std::string elevationOwner = OwnerName(elevation);
+  std::string shrinkOwner = OwnerName(shrink);
+  if (accounting->GetOwnerSize(sphereOwner.c_str()) !=
+      spherePolys->GetActualMemorySize() ||
+      !HasEntry(accounting, sphereOwner.c_str(), "CellLinks"))
+    {
+    cerr << "Wrong size for the sphere: "
+         << accounting->GetOwnerSize(sphereOwner.c_str()) << " KiB instead of "
+         << spherePolys->GetActualMemorySize() << " KiB" << endl;
+    retVal = 1;
+    }
+  // The elevation filter passes the points and polygons of its input.
+  if (!HasEntry(accounting, elevationOwner.c_str(), "PointData/Elevation") ||
+      HasEntry(accounting, elevationOwner.c_str(), "Points") ||
+      accounting->GetOwnerSize(elevationOwner.c_str()) >=
+      elevated->GetActualMemorySize())
+    {
+    cerr << "Wrong attribution for the elevation filter" << endl;
+    retVal = 1;
+    }
+  if (accounting->GetOwnerSize(shrinkOwner.c_str()) == 0 ||
+      accounting->GetOwnerSize(shrinkOwner.c_str()) >
+      shrink->GetOutput()->GetActualMemorySize())
+    {
+    cerr << "Wrong size for the shrink filter: "
+         << accounting->GetOwnerSize(shrinkOwner.c_str()) << " KiB" << endl;
+    retVal = 1;
+    }
+
+  // The high-water mark of an execution covers its input and its output,
+  // the arrays they share counted once.
+  unsigned long peak = profiler->GetPeakMemorySize(elevation);
+  if (peak < profiler->GetOutputMemorySize(elevation) ||
+      peak >= profiler->GetOutputMemorySize(elevation) +
+      profiler->GetOutputMemorySize(sphere) ||
+      profiler->GetPeakMemorySize(shrink) <
+      profiler->GetOutputMemorySize(shrink))
+    {
+    cerr << "Wrong peak memory size: " << peak << " KiB" << endl;
+    retVal = 1;
+    }
+  profiler->PrintSummary(cout);
+
+  return retVal;
+}
@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkElevationFilter.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkShrinkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <vtksys/ios/sstream>
+
+int TestPipelineProfiler(int, char *[])
+{
+  int retVal = 0;
+
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  vtkSmartPointer<vtkElevationFilter> elevation =
+    vtkSmartPointer<vtkElevationFilter>::New();
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  vtkSmartPointer<vtkShrinkPolyData> shrink =
+    vtkSmartPointer<vtkShrinkPolyData>::New();
+  shrink->SetInputConnection(elevation->GetOutputPort());
+
+  vtkSmartPointer<vtkPipelineProfiler> profiler =
+    vtkSmartPointer<vtkPipelineProfiler>::New();
+  profiler->StartProfiling();
+  if (!profiler->GetProfiling() ||
+      vtkPipelineProfiler::GetActiveProfiler() != profiler.GetPointer())
+    {
+    cerr << "Profiler is not active" << endl;
+    retVal = 1;
+    }
+
+  shrink->Update();
+  // Only the filters downstream of the modified one execute again.
+  elevation->SetLowPoint(0.0, 0.0, -1.0);
+  shrink->Update();
+  profiler->StopProfiling();
+  shrink->Update();
+
+  if (profiler->GetNumberOfExecutions(sphere) != 1 ||
+      profiler->GetNumberOfExecutions(elevation) != 2 ||
+      profiler->GetNumberOfExecutions(shrink) != 2)
+    {
+    cerr << "Wrong number of executions: "
+         << profiler->GetNumberOfExecutions(sphere) << " "
+         << profiler->GetNumberOfExecutions(elevation) << " "
+         << profiler->GetNumberOfExecutions(shrink) << endl;
+    retVal = 1;
+    }
+  if (profiler->GetTime(shrink, "REQUEST_DATA") <= 0.0 ||
+      profiler->GetTime(shrink) < profiler->GetTime(shrink, "REQUEST_DATA") ||
+      profiler->GetTime(shrink, "NO_SUCH_PASS") != 0.0)
+    {
+    cerr << "Wrong times" << endl;
+    retVal = 1;
+    }
+  if (profiler->GetOutputMemorySize(shrink) == 0 ||
+      profiler->GetOutputMemorySize(shrink) <
+      profiler->GetOutputMemorySize(sphere))
+    {
+    cerr << "Wrong output memory size" << endl;
+    retVal = 1;
+    }
+
+  profiler->PrintSummary(cout);
+
+  vtksys_ios::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  vtksys_stl::string json = trace.str();
+  const char *expected[] = {
+    "{\"traceEvents\":[", "vtkSphereSource::REQUEST_DATA",
+    "vtkShrinkPolyData::REQUEST_INFORMATION",
+    "vtkElevationFilter::REQUEST_UPDATE_EXTENT", "\"ph\":\"X\"", 0 };
+  for (int i = 0; expected[i]; ++i)
+    {
+    if (json.find(expected[i]) == vtksys_stl::string::npos)
+      {
+      cerr << "Trace does not contain " << expected[i] << endl;
+      retVal = 1;
+      }
+    }
+
+  vtkIdType numEvents = profiler->GetNumberOfEvents();
+  profiler->Reset();
+  if (numEvents == 0 || profiler->GetNumberOfEvents() != 0 ||
+      profiler->GetNumberOfExecutions(shrink) != 0)
+    {
+    cerr << "Wrong Reset" << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
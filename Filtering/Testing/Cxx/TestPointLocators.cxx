@@ -19,6 +19,7 @@
 #include "vtkOctreePointLocator.h"
 #include "vtkPointLocator.h"
 #include "vtkPoints.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStructuredGrid.h"
 
 // returns true if 2 points are equidistant from x, within a tolerance
@@ -306,9 +307,15 @@ int TestPointLocators(int , char *[])
   cout << "Comparing vtkOctreePointLocator to vtkKdTreePointLocator.\n";
   rval += ComparePointLocators(octreeLocator, kdTreeLocator);
 
+  vtkStaticPointLocator* staticLocator = vtkStaticPointLocator::New();
+
+  cout << "Comparing vtkStaticPointLocator to vtkKdTreePointLocator.\n";
+  rval += ComparePointLocators(staticLocator, kdTreeLocator);
+
   kdTreeLocator->Delete();
   uniformLocator->Delete();
   octreeLocator->Delete();
+  staticLocator->Delete();
 
   rval += TestKdTreePointLocator();
 
@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpanSpace.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkSpanSpace returns exactly the cells spanning a scalar
+// value, in batches listing each candidate once, for several resolutions
+// and batch sizes, and that the tree does not depend on the number of
+// threads that built it, on an unstructured grid and on polygons with 32
+// bit connectivity.
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpanSpace.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/vector>
+
+#include <math.h>
+
+#define DIMENSION 17
+
+// A grid of hexahedra and tetrahedra with a few triangles and a vertex,
+// whose integer scalars repeat values.
+static vtkUnstructuredGrid *NewGrid()
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = vtkPoints::New();
+  vtkFloatArray *scalars = vtkFloatArray::New();
+  scalars->SetName("Scalars");
+  for (int k = 0; k < DIMENSION; k++)
+    {
+    for (int j = 0; j < DIMENSION; j++)
+      {
+      for (int i = 0; i < DIMENSION; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        scalars->InsertNextValue(static_cast<float>(
+          floor(10.0*sin(0.4*i) + 10.0*cos(0.3*j) + 0.5*k)));
+        }
+      }
+    }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  points->Delete();
+  scalars->Delete();
+
+  grid->Allocate(1000, 1000);
+  vtkIdType d = DIMENSION;
+  for (vtkIdType k = 0; k < d - 1; k++)
+    {
+    for (vtkIdType j = 0; j < d - 1; j++)
+      {
+      for (vtkIdType i = 0; i < d - 1; i++)
+        {
+        vtkIdType p = i + d*(j + d*k);
+        vtkIdType hex[8] = { p, p+1, p+1+d, p+d,
+                             p+d*d, p+1+d*d, p+1+d+d*d, p+d+d*d };
+        if ((i + j + k) % 2)
+          {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+          }
+        else
+          {
+          vtkIdType tet[4] = { hex[0], hex[1], hex[3], hex[4] };
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+          }
+        if (k == 0 && i == j)
+          {
+          grid->InsertNextCell(VTK_TRIANGLE, 3, hex);
+          }
+        }
+      }
+    }
+  vtkIdType vertex = 5;
+  grid->InsertNextCell(VTK_VERTEX, 1, &vertex);
+  return grid;
+}
+
+// The quadrilaterals of the bottom of the grid, and a triangle, with the
+// same points and scalars.  The polygons use 32 bit connectivity, which
+// the parallel binning must read safely.
+static vtkPolyData *NewSurface(vtkUnstructuredGrid *grid)
+{
+  vtkPolyData *surface = vtkPolyData::New();
+  surface->SetPoints(grid->GetPoints());
+  surface->GetPointData()->SetScalars(grid->GetPointData()->GetScalars());
+
+  vtkCellArray *polys = vtkCellArray::New();
+  polys->Use32BitStorageOn();
+  vtkIdType d = DIMENSION;
+  for (vtkIdType j = 0; j < d - 1; j++)
+    {
+    for (vtkIdType i = 0; i < d - 1; i++)
+      {
+      vtkIdType p = i + d*j;
+      vtkIdType quad[4] = { p, p+1, p+1+d, p+d };
+      polys->InsertNextCell(4, quad);
+      }
+    }
+  vtkIdType tri[3] = { 0, 1, d };
+  polys->InsertNextCell(3, tri);
+  surface->SetPolys(polys);
+  polys->Delete();
+  return surface;
+}
+
+// Return the range of the scalars of the points of a cell.
+static void GetCellRange(vtkDataSet *data, vtkIdType cellId, double range[2])
+{
+  vtkDataArray *scalars = data->GetPointData()->GetScalars();
+  vtkCell *cell = data->GetCell(cellId);
+  range[0] = VTK_DOUBLE_MAX;
+  range[1] = -VTK_DOUBLE_MAX;
+  for (vtkIdType i = 0; i < cell->GetNumberOfPoints(); i++)
+    {
+    double s = scalars->GetComponent(cell->GetPointId(i), 0);
+    range[0] = (s < range[0] ? s : range[0]);
+    range[1] = (s > range[1] ? s : range[1]);
+    }
+}
+
+// Check the traversals of one value.  The candidates of the batches are
+// returned in candidates.
+static int TestValue(vtkSpanSpace *tree, vtkDataSet *data, double value,
+                     vtkstd::vector<vtkIdType> &candidates)
+{
+  vtkIdType numCells = data->GetNumberOfCells();
+  tree->InitTraversal(value);
+
+  // The batches list each cell at most once, and all the cells spanning
+  // the value.
+  vtkstd::vector<int> seen(numCells, 0);
+  vtkstd::vector<vtkIdType> spanning;
+  candidates.clear();
+  for (vtkIdType b = 0; b < tree->GetNumberOfCellBatches(); b++)
+    {
+    vtkIdType n;
+    const vtkIdType *ids = tree->GetCellBatch(b, n);
+    if (n < 1 || n > tree->GetBatchSize())
+      {
+      cerr << "Batch " << b << " has " << n << " cells." << endl;
+      return 0;
+      }
+    for (vtkIdType i = 0; i < n; i++)
+      {
+      if (ids[i] < 0 || ids[i] >= numCells || seen[ids[i]]++)
+        {
+        cerr << "Bad or repeated candidate " << ids[i] << endl;
+        return 0;
+        }
+      candidates.push_back(ids[i]);
+      double range[2];
+      GetCellRange(data, ids[i], range);
+      if (range[0] <= value && value <= range[1])
+        {
+        spanning.push_back(ids[i]);
+        }
+      }
+    }
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+    double range[2];
+    GetCellRange(data, cellId, range);
+    if (range[0] <= value && value <= range[1] && !seen[cellId])
+      {
+      cerr << "Cell " << cellId << " spans " << value
+           << " but is not a candidate." << endl;
+      return 0;
+      }
+    }
+
+  // GetNextCell() returns the spanning candidates in the same order.
+  vtkSmartPointer<vtkFloatArray> cellScalars =
+    vtkSmartPointer<vtkFloatArray>::New();
+  vtkIdType cellId;
+  vtkIdList *cellPts;
+  size_t next = 0;
+  tree->InitTraversal(value);
+  while (tree->GetNextCell(cellId, cellPts, cellScalars))
+    {
+    if (next >= spanning.size() || spanning[next] != cellId ||
+        cellScalars->GetNumberOfTuples() != cellPts->GetNumberOfIds())
+      {
+      cerr << "GetNextCell() returned cell " << cellId << " at " << next
+           << " for " << value << endl;
+      return 0;
+      }
+    next++;
+    }
+  if (next != spanning.size())
+    {
+    cerr << "GetNextCell() returned " << next << " cells instead of "
+         << spanning.size() << " for " << value << endl;
+    return 0;
+    }
+  return 1;
+}
+
+// Check the trees of all the resolutions and batch sizes, built with one
+// thread and with several.
+static int TestDataSet(vtkDataSet *data)
+{
+  double values[] = { -100.0, -18.0, -7.5, 0.0, 3.0, 11.25, 27.0, 100.0 };
+  const int numValues = sizeof(values) / sizeof(values[0]);
+  vtkIdType resolutions[] = { 0, 1, 7, 100 };
+  vtkIdType batchSizes[] = { 1000, 7, 1, 100000 };
+
+  int retVal = 0;
+  for (int r = 0; r < 4 && !retVal; r++)
+    {
+    vtkstd::vector<vtkIdType> reference[numValues];
+    int threads[] = { 1, 4 };
+    for (int t = 0; t < 2 && !retVal; t++)
+      {
+      vtkSMPTools::Initialize(threads[t]);
+      vtkSmartPointer<vtkSpanSpace> tree = vtkSmartPointer<vtkSpanSpace>::New();
+      tree->SetDataSet(data);
+      tree->SetComputeResolution(resolutions[r] == 0);
+      if (resolutions[r])
+        {
+        tree->SetResolution(resolutions[r]);
+        }
+      tree->SetBatchSize(batchSizes[r]);
+      for (int v = 0; v < numValues && !retVal; v++)
+        {
+        vtkstd::vector<vtkIdType> candidates;
+        if (!TestValue(tree, data, values[v], candidates))
+          {
+          cerr << "Failed with resolution " << tree->GetResolution()
+               << " and " << threads[t] << " threads on a "
+               << data->GetClassName() << "." << endl;
+          retVal = 1;
+          }
+        else if (t == 0)
+          {
+          reference[v] = candidates;
+          }
+        else if (candidates != reference[v])
+          {
+          cerr << "The candidates of " << values[v] << " depend on the "
+               << "number of threads." << endl;
+          retVal = 1;
+          }
+        }
+      }
+    }
+
+  // The values out of the range of the scalars have no candidates.
+  vtkSmartPointer<vtkSpanSpace> tree = vtkSmartPointer<vtkSpanSpace>::New();
+  tree->SetDataSet(data);
+  tree->InitTraversal(values[0]);
+  if (tree->GetNumberOfCellBatches() != 0)
+    {
+    cerr << "Candidates out of the range of the scalars." << endl;
+    retVal = 1;
+    }
+  return retVal;
+}
+
+int TestSpanSpace(int, char *[])
+{
+  vtkUnstructuredGrid *grid = NewGrid();
+  int retVal = TestDataSet(grid);
+
+  vtkPolyData *surface = NewSurface(grid);
+  retVal |= TestDataSet(surface);
+  if (!surface->GetPolys()->GetUse32BitStorage())
+    {
+    cerr << "The polygons lost their 32 bit storage." << endl;
+    retVal = 1;
+    }
+
+  surface->Delete();
+  grid->Delete();
+  return retVal;
+}
@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticPointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Times the building and the queries of vtkStaticPointLocator against the
+// other point locators, and checks that queries from several threads
+// give the same results as serial ones.
+
+#include "vtkIdList.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkTimerLog.h"
+
+#include <vtkstd/vector>
+
+#define NUMBER_OF_POINTS 200000
+#define NUMBER_OF_QUERIES 20000
+
+// Runs the three queries for a range of query points and reduces each
+// answer to one number.
+class vtkStaticPointLocatorQueries
+{
+public:
+  vtkStaticPointLocator *Locator;
+  const double *QueryPoints;
+  double *Result;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkSmartPointer<vtkIdList> ids = vtkSmartPointer<vtkIdList>::New();
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      const double *x = this->QueryPoints + 3 * i;
+      double sum = this->Locator->FindClosestPoint(x);
+      this->Locator->FindClosestNPoints(10, x, ids);
+      for (vtkIdType j = 0; j < ids->GetNumberOfIds(); j++)
+        {
+        sum += (j + 1) * ids->GetId(j);
+        }
+      this->Locator->FindPointsWithinRadius(0.02, x, ids);
+      sum += 1000.0 * ids->GetNumberOfIds();
+      this->Result[i] = sum;
+      }
+    }
+};
+
+static void TimeLocator(vtkAbstractPointLocator *locator, vtkDataSet *ds,
+                        const double *queryPoints, vtkIdType *closest)
+{
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  locator->SetDataSet(ds);
+  timer->StartTimer();
+  locator->BuildLocator();
+  timer->StopTimer();
+  double buildTime = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; i++)
+    {
+    closest[i] = locator->FindClosestPoint(queryPoints + 3 * i);
+    }
+  timer->StopTimer();
+
+  cout << locator->GetClassName() << ": build " << buildTime
+       << " s, " << NUMBER_OF_QUERIES << " FindClosestPoint "
+       << timer->GetElapsedTime() << " s" << endl;
+}
+
+int TestStaticPointLocator(int, char *[])
+{
+  int retVal = 0;
+
+  vtkMath::RandomSeed(31415);
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetNumberOfPoints(NUMBER_OF_POINTS);
+  for (vtkIdType i = 0; i < NUMBER_OF_POINTS; i++)
+    {
+    points->SetPoint(i, vtkMath::Random(), vtkMath::Random(),
+                     vtkMath::Random());
+    }
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+
+  vtkstd::vector<double> queryPoints(3 * NUMBER_OF_QUERIES);
+  for (vtkIdType i = 0; i < 3 * NUMBER_OF_QUERIES; i++)
+    {
+    queryPoints[i] = vtkMath::Random(-0.1, 1.1);
+    }
+
+  vtkSmartPointer<vtkStaticPointLocator> staticLocator =
+    vtkSmartPointer<vtkStaticPointLocator>::New();
+  vtkSmartPointer<vtkPointLocator> pointLocator =
+    vtkSmartPointer<vtkPointLocator>::New();
+  vtkSmartPointer<vtkKdTreePointLocator> kdTreeLocator =
+    vtkSmartPointer<vtkKdTreePointLocator>::New();
+  vtkSmartPointer<vtkOctreePointLocator> octreeLocator =
+    vtkSmartPointer<vtkOctreePointLocator>::New();
+
+  vtkstd::vector<vtkIdType> staticClosest(NUMBER_OF_QUERIES);
+  vtkstd::vector<vtkIdType> closest(NUMBER_OF_QUERIES);
+  TimeLocator(staticLocator, polyData, &queryPoints[0], &staticClosest[0]);
+  vtkAbstractPointLocator *others[3] =
+    { pointLocator, kdTreeLocator, octreeLocator };
+  for (int l = 0; l < 3; l++)
+    {
+    TimeLocator(others[l], polyData, &queryPoints[0], &closest[0]);
+    for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; i++)
+      {
+      double *x = &queryPoints[3 * i];
+      if (closest[i] != staticClosest[i] &&
+          vtkMath::Distance2BetweenPoints(x, points->GetPoint(closest[i])) !=
+          vtkMath::Distance2BetweenPoints(x, points->GetPoint(staticClosest[i])))
+        {
+        cerr << "Closest point of query " << i << " differs from "
+             << others[l]->GetClassName() << endl;
+        retVal = 1;
+        break;
+        }
+      }
+    }
+
+  // The same queries, serially and from several threads.
+  vtkstd::vector<double> serial(NUMBER_OF_QUERIES);
+  vtkstd::vector<double> parallel(NUMBER_OF_QUERIES);
+  vtkStaticPointLocatorQueries queries;
+  queries.Locator = staticLocator;
+  queries.QueryPoints = &queryPoints[0];
+  queries.Result = &serial[0];
+
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  timer->StartTimer();
+  queries(0, NUMBER_OF_QUERIES);
+  timer->StopTimer();
+  double serialTime = timer->GetElapsedTime();
+  queries.Result = &parallel[0];
+  timer->StartTimer();
+  vtkSMPTools::For(0, NUMBER_OF_QUERIES, 100, queries);
+  timer->StopTimer();
+  cout << "vtkStaticPointLocator queries: serial " << serialTime
+       << " s, threaded " << timer->GetElapsedTime() << " s" << endl;
+
+  for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; i++)
+    {
+    if (serial[i] != parallel[i])
+      {
+      cerr << "Threaded query " << i << " differs from the serial one" << endl;
+      retVal = 1;
+      break;
+      }
+    }
+
+  return retVal;
+}
@@ -0,0 +1,169 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedImageAlgorithmSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that in SMP mode the extent is cut in as many pieces as
+// DesiredBytesPerPiece asks for, whatever NumberOfThreads is, and that the
+// threadId passed to ThreadedRequestData is less than NumberOfThreads and
+// never used by two pieces at once, whatever the number of threads of
+// vtkSMPTools, so that subclasses can keep per-thread results like with
+// vtkMultiThreader.
+
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+#include <vtksys/SystemTools.hxx>
+
+// A source filling its output with ones, which counts the pieces run
+// with each threadId and those run with a threadId already in use.
+class vtkThreadIdImageSource : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkThreadIdImageSource *New();
+  vtkTypeMacro(vtkThreadIdImageSource,vtkThreadedImageAlgorithm);
+
+  int Pieces[VTK_MAX_THREADS];
+  int Running[VTK_MAX_THREADS];
+  int BadThreadIds;
+  int SharedThreadIds;
+  vtkMutexLock *Lock;
+
+protected:
+  vtkThreadIdImageSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->Lock = vtkMutexLock::New();
+    }
+  ~vtkThreadIdImageSource()
+    {
+    this->Lock->Delete();
+    }
+
+  int RequestInformation(vtkInformation *, vtkInformationVector **,
+                         vtkInformationVector *outputVector)
+    {
+    int extent[6] = { 0, 63, 0, 63, 0, 63 };
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_UNSIGNED_CHAR, 1);
+    for (int i = 0; i < VTK_MAX_THREADS; i++)
+      {
+      this->Pieces[i] = 0;
+      this->Running[i] = 0;
+      }
+    this->BadThreadIds = 0;
+    this->SharedThreadIds = 0;
+    return 1;
+    }
+
+  void ThreadedRequestData(vtkInformation *, vtkInformationVector **,
+                           vtkInformationVector *, vtkImageData ***,
+                           vtkImageData **outData, int extent[6],
+                           int threadId)
+    {
+    this->Lock->Lock();
+    if (threadId < 0 || threadId >= this->NumberOfThreads)
+      {
+      this->BadThreadIds++;
+      }
+    else
+      {
+      this->Pieces[threadId]++;
+      this->SharedThreadIds += this->Running[threadId]++;
+      }
+    this->Lock->Unlock();
+    for (int k = extent[4]; k <= extent[5]; k++)
+      {
+      for (int j = extent[2]; j <= extent[3]; j++)
+        {
+        unsigned char *ptr = static_cast<unsigned char *>(
+          outData[0]->GetScalarPointer(extent[0], j, k));
+        for (int i = extent[0]; i <= extent[1]; i++)
+          {
+          *ptr++ = 1;
+          }
+        }
+      }
+    // Give the other threads a chance to run a piece meanwhile.
+    vtksys::SystemTools::Delay(1);
+    if (threadId >= 0 && threadId < this->NumberOfThreads)
+      {
+      this->Lock->Lock();
+      this->Running[threadId]--;
+      this->Lock->Unlock();
+      }
+    }
+};
+
+vtkStandardNewMacro(vtkThreadIdImageSource);
+
+int TestThreadedImageAlgorithmSMP(int, char *[])
+{
+  int retVal = 0;
+  vtkSmartPointer<vtkThreadIdImageSource> source =
+    vtkSmartPointer<vtkThreadIdImageSource>::New();
+  source->EnableSMPOn();
+
+  // The 64 slices of the 64^3 bytes of the output limit the number of
+  // pieces.
+  int poolThreads[] = { 1, 3, 8 };
+  int filterThreads[] = { 1, 2, 5, 16 };
+  vtkIdType bytesPerPiece[] = { 0, 1024, 65536 };
+  int piecesOfBytes[] = { 0, 64, 4 };
+  for (int p = 0; p < 3; p++)
+    {
+    vtkSMPTools::Initialize(poolThreads[p]);
+    for (int f = 0; f < 4; f++)
+      {
+      for (int b = 0; b < 3; b++)
+        {
+        source->SetNumberOfThreads(filterThreads[f]);
+        source->SetDesiredBytesPerPiece(bytesPerPiece[b]);
+        source->Modified();
+        source->Update();
+
+        int pieces = 0;
+        for (int i = 0; i < VTK_MAX_THREADS; i++)
+          {
+          pieces += source->Pieces[i];
+          }
+        int expectedPieces = (bytesPerPiece[b] > 0 ? piecesOfBytes[b] :
+                              filterThreads[f]);
+        double range[2];
+        source->GetOutput()->GetScalarRange(range);
+        if (source->BadThreadIds || source->SharedThreadIds ||
+            pieces != expectedPieces || range[0] != 1.0 || range[1] != 1.0)
+          {
+          cerr << source->BadThreadIds << " bad threadIds, "
+               << source->SharedThreadIds << " shared threadIds, " << pieces
+               << " pieces instead of " << expectedPieces << ", range "
+               << range[0] << " " << range[1]
+               << " with " << poolThreads[p] << " pool threads, "
+               << filterThreads[f] << " filter threads and "
+               << bytesPerPiece[b] << " bytes per piece." << endl;
+          retVal = 1;
+          }
+        }
+      }
+    }
+
+  return retVal;
+}
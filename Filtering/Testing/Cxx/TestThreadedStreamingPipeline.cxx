@@ -0,0 +1,358 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedStreamingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAppendPolyData.h"
+#include "vtkAtomicOperations.h"
+#include "vtkCellArray.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkCriticalSection.h"
+#include "vtkExecutionScheduler.h"
+#include "vtkExecutiveCollection.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedStreamingPipeline.h"
+
+#include <vtksys/SystemTools.hxx>
+
+// Number of filters executing right now and the largest number seen.
+static int RunningFilters = 0;
+static int MaximumRunningFilters = 0;
+static vtkSimpleCriticalSection MaximumLock;
+
+// A source producing NumberOfPoints points whose x coordinates start at
+// Value + 1000 * piece.
+class vtkTSPSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTSPSource *New();
+  vtkTypeMacro(vtkTSPSource,vtkPolyDataAlgorithm);
+
+  int NumberOfPoints;
+  double Value;
+  int NumberOfExecutions;
+
+protected:
+  vtkTSPSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfPoints = 10;
+    this->Value = 0.0;
+    this->NumberOfExecutions = 0;
+    }
+
+  int RequestInformation(vtkInformation *, vtkInformationVector **,
+                         vtkInformationVector *outputVector)
+    {
+    outputVector->GetInformationObject(0)->Set(
+      vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES(), -1);
+    return 1;
+    }
+
+  int RequestData(vtkInformation *, vtkInformationVector **,
+                  vtkInformationVector *outputVector)
+    {
+    vtkInformation *outInfo = outputVector->GetInformationObject(0);
+    int piece = outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    vtkPoints *points = vtkPoints::New();
+    vtkCellArray *verts = vtkCellArray::New();
+    for (vtkIdType i = 0; i < this->NumberOfPoints; i++)
+      {
+      vtkIdType id = points->InsertNextPoint(
+        this->Value + 1000.0 * piece + i, 0.0, 0.0);
+      verts->InsertNextCell(1, &id);
+      }
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    points->Delete();
+    verts->Delete();
+    vtkAtomicOperations::Increment(&this->NumberOfExecutions);
+    return 1;
+    }
+};
+
+vtkStandardNewMacro(vtkTSPSource);
+
+// A filter translating its input by Offset along y, taking Delay
+// milliseconds to do so.
+class vtkTSPFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTSPFilter *New();
+  vtkTypeMacro(vtkTSPFilter,vtkPolyDataAlgorithm);
+
+  double Offset;
+  int Delay;
+  int NumberOfExecutions;
+
+protected:
+  vtkTSPFilter()
+    {
+    this->Offset = 0.0;
+    this->Delay = 0;
+    this->NumberOfExecutions = 0;
+    }
+
+  int RequestData(vtkInformation *, vtkInformationVector **inputVector,
+                  vtkInformationVector *outputVector)
+    {
+    int running = vtkAtomicOperations::Increment(&RunningFilters);
+    MaximumLock.Lock();
+    if (running > MaximumRunningFilters)
+      {
+      MaximumRunningFilters = running;
+      }
+    MaximumLock.Unlock();
+
+    vtkPolyData *input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData *output = vtkPolyData::GetData(outputVector);
+    output->CopyStructure(input);
+    vtkPoints *points = vtkPoints::New();
+    points->DeepCopy(input->GetPoints());
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); i++)
+      {
+      double x[3];
+      points->GetPoint(i, x);
+      x[1] += this->Offset;
+      points->SetPoint(i, x);
+      }
+    output->SetPoints(points);
+    points->Delete();
+    if (this->Delay > 0)
+      {
+      vtksys::SystemTools::Delay(this->Delay);
+      }
+
+    vtkAtomicOperations::Increment(&this->NumberOfExecutions);
+    vtkAtomicOperations::Decrement(&RunningFilters);
+    return 1;
+    }
+};
+
+vtkStandardNewMacro(vtkTSPFilter);
+
+static void UseThreadedExecutive(vtkAlgorithm *algorithm)
+{
+  vtkThreadedStreamingPipeline *exec = vtkThreadedStreamingPipeline::New();
+  algorithm->SetExecutive(exec);
+  exec->Delete();
+}
+
+// Check the output of a fan: branch i translates the points of the
+// source by firstOffset + i along y.
+static int CheckOutput(vtkPolyData *output, int numberOfBranches,
+                       double firstOffset, int numberOfPoints,
+                       double value, int piece)
+{
+  if (output->GetNumberOfPoints() != numberOfBranches * numberOfPoints)
+    {
+    cerr << "Expected " << numberOfBranches * numberOfPoints
+         << " points, got " << output->GetNumberOfPoints() << endl;
+    return 1;
+    }
+  for (int b = 0; b < numberOfBranches; b++)
+    {
+    for (int i = 0; i < numberOfPoints; i++)
+      {
+      double x[3];
+      output->GetPoint(b * numberOfPoints + i, x);
+      if (x[0] != value + 1000.0 * piece + i || x[1] != firstOffset + b)
+        {
+        cerr << "Wrong point " << b * numberOfPoints + i << ": " << x[0]
+             << " " << x[1] << endl;
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+
+int TestThreadedStreamingPipeline(int, char *[])
+{
+  const int numberOfBranches = 4;
+  int retVal = 0;
+
+  vtkExecutionScheduler *scheduler =
+    vtkExecutionScheduler::GetGlobalScheduler();
+  scheduler->SetNumberOfThreads(numberOfBranches);
+
+  // A source feeding four branches merged by an append filter.
+  vtkSmartPointer<vtkTSPSource> source = vtkSmartPointer<vtkTSPSource>::New();
+  UseThreadedExecutive(source);
+  vtkSmartPointer<vtkAppendPolyData> append =
+    vtkSmartPointer<vtkAppendPolyData>::New();
+  UseThreadedExecutive(append);
+  vtkSmartPointer<vtkTSPFilter> filters[numberOfBranches];
+  for (int b = 0; b < numberOfBranches; b++)
+    {
+    filters[b] = vtkSmartPointer<vtkTSPFilter>::New();
+    UseThreadedExecutive(filters[b]);
+    filters[b]->Offset = b;
+    filters[b]->Delay = 50;
+    filters[b]->SetInputConnection(source->GetOutputPort());
+    append->AddInputConnection(filters[b]->GetOutputPort());
+    }
+  vtkThreadedStreamingPipeline *appendExec =
+    vtkThreadedStreamingPipeline::SafeDownCast(append->GetExecutive());
+  appendExec->EnableMultiThreadingOn();
+
+  // The branches execute concurrently, and once.
+  scheduler->ResetStatistics();
+  append->Update();
+  retVal |= CheckOutput(append->GetOutput(), numberOfBranches, 0.0,
+                        source->NumberOfPoints, source->Value, 0);
+  if (source->NumberOfExecutions != 1)
+    {
+    cerr << "The source executed " << source->NumberOfExecutions
+         << " times" << endl;
+    retVal = 1;
+    }
+  for (int b = 0; b < numberOfBranches; b++)
+    {
+    if (filters[b]->NumberOfExecutions != 1)
+      {
+      cerr << "Branch " << b << " executed "
+           << filters[b]->NumberOfExecutions << " times" << endl;
+      retVal = 1;
+      }
+    }
+  if (MaximumRunningFilters < 2 ||
+      scheduler->GetMaximumNumberOfConcurrentTasks() < 2)
+    {
+    cerr << "The branches did not execute concurrently" << endl;
+    retVal = 1;
+    }
+  if (scheduler->GetNumberOfPendingTasks() != 0)
+    {
+    cerr << "Tasks left after the update" << endl;
+    retVal = 1;
+    }
+
+  // Nothing executes when the pipeline is up to date.
+  append->Update();
+  if (source->NumberOfExecutions != 1 || filters[0]->NumberOfExecutions != 1)
+    {
+    cerr << "An up to date pipeline executed again" << endl;
+    retVal = 1;
+    }
+
+  // Many updates in a row, each modifying the source or one branch.
+  for (int b = 0; b < numberOfBranches; b++)
+    {
+    filters[b]->Delay = 0;
+    }
+  for (int i = 0; i < 200 && !retVal; i++)
+    {
+    int sourceExecutions = source->NumberOfExecutions;
+    if (i % 2 == 0)
+      {
+      source->Value = i;
+      source->NumberOfPoints = 10 + i % 7;
+      source->Modified();
+      }
+    else
+      {
+      filters[i % numberOfBranches]->Modified();
+      }
+    append->Update();
+    retVal |= CheckOutput(append->GetOutput(), numberOfBranches, 0.0,
+                          source->NumberOfPoints, source->Value, 0);
+    if (source->NumberOfExecutions != sourceExecutions + (i % 2 == 0))
+      {
+      cerr << "Wrong number of source executions at update " << i << endl;
+      retVal = 1;
+      }
+    }
+
+  // Streamed pieces: the branches of every piece run concurrently.
+  for (int piece = 0; piece < 3; piece++)
+    {
+    append->UpdateInformation();
+    appendExec->SetUpdateExtent(0, piece, 3, 0);
+    append->Update();
+    retVal |= CheckOutput(append->GetOutput(), numberOfBranches, 0.0,
+                          source->NumberOfPoints, source->Value, piece);
+    }
+  append->UpdateInformation();
+  appendExec->SetUpdateExtent(0, 0, 1, 0);
+
+  // A branch with another executive: the update is serial, and correct.
+  vtkSmartPointer<vtkTSPSource> source2 =
+    vtkSmartPointer<vtkTSPSource>::New();
+  UseThreadedExecutive(source2);
+  vtkSmartPointer<vtkTSPFilter> threadedFilter =
+    vtkSmartPointer<vtkTSPFilter>::New();
+  UseThreadedExecutive(threadedFilter);
+  threadedFilter->SetInputConnection(source2->GetOutputPort());
+  vtkSmartPointer<vtkTSPFilter> serialFilter =
+    vtkSmartPointer<vtkTSPFilter>::New();
+  vtkCompositeDataPipeline *serialExec = vtkCompositeDataPipeline::New();
+  serialFilter->SetExecutive(serialExec);
+  serialExec->Delete();
+  serialFilter->Offset = 1.0;
+  serialFilter->SetInputConnection(source2->GetOutputPort());
+  vtkSmartPointer<vtkAppendPolyData> append2 =
+    vtkSmartPointer<vtkAppendPolyData>::New();
+  UseThreadedExecutive(append2);
+  vtkThreadedStreamingPipeline::SafeDownCast(append2->GetExecutive())
+    ->EnableMultiThreadingOn();
+  append2->AddInputConnection(threadedFilter->GetOutputPort());
+  append2->AddInputConnection(serialFilter->GetOutputPort());
+  scheduler->ResetStatistics();
+  append2->Update();
+  retVal |= CheckOutput(append2->GetOutput(), 2, 0.0,
+                        source2->NumberOfPoints, source2->Value, 0);
+  if (scheduler->GetMaximumNumberOfConcurrentTasks() != 0)
+    {
+    cerr << "A pipeline with a serial executive was scheduled" << endl;
+    retVal = 1;
+    }
+
+  // Updating several sinks at once through the scheduler.
+  source->Value = 7.0;
+  source->Modified();
+  int sourceExecutions = source->NumberOfExecutions;
+  vtkSmartPointer<vtkExecutiveCollection> sinks =
+    vtkSmartPointer<vtkExecutiveCollection>::New();
+  for (int b = 0; b < numberOfBranches; b++)
+    {
+    // The branches still hold the update extent of the last piece
+    // requested by the append filter.
+    vtkStreamingDemandDrivenPipeline *exec =
+      vtkStreamingDemandDrivenPipeline::SafeDownCast(
+        filters[b]->GetExecutive());
+    exec->SetUpdateExtent(0, 0, 1, 0);
+    sinks->AddItem(exec);
+    }
+  vtkThreadedStreamingPipeline::Pull(sinks);
+  if (source->NumberOfExecutions != sourceExecutions + 1)
+    {
+    cerr << "The shared source of the sinks executed "
+         << source->NumberOfExecutions - sourceExecutions << " times" << endl;
+    retVal = 1;
+    }
+  for (int b = 0; b < numberOfBranches; b++)
+    {
+    retVal |= CheckOutput(filters[b]->GetOutput(), 1, b,
+                          source->NumberOfPoints, source->Value, 0);
+    }
+
+  return retVal;
+}
@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestUnstructuredGrid32BitStorage.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that an unstructured grid gives the same answers with its
+// topology stored in 32 bits, and reports the memory used in both modes.
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#define RES 30
+
+static vtkUnstructuredGrid *MakeHexGrid()
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = vtkPoints::New();
+  int i, j, k;
+  for (k = 0; k <= RES; k++)
+    {
+    for (j = 0; j <= RES; j++)
+      {
+      for (i = 0; i <= RES; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        }
+      }
+    }
+  grid->SetPoints(points);
+  points->Delete();
+
+  const vtkIdType di = 1, dj = RES + 1, dk = (RES + 1) * (RES + 1);
+  vtkIdType pts[8];
+  grid->Allocate(RES * RES * RES);
+  for (k = 0; k < RES; k++)
+    {
+    for (j = 0; j < RES; j++)
+      {
+      for (i = 0; i < RES; i++)
+        {
+        pts[0] = i + j * dj + k * dk;
+        pts[1] = pts[0] + di;
+        pts[2] = pts[1] + dj;
+        pts[3] = pts[0] + dj;
+        pts[4] = pts[0] + dk;
+        pts[5] = pts[1] + dk;
+        pts[6] = pts[2] + dk;
+        pts[7] = pts[3] + dk;
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+        }
+      }
+    }
+  grid->Squeeze();
+  return grid;
+}
+
+static bool SameIds(vtkIdList *a, vtkIdList *b)
+{
+  if (a->GetNumberOfIds() != b->GetNumberOfIds())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfIds(); i++)
+    {
+    if (a->GetId(i) != b->GetId(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+static void Report(const char *label, vtkUnstructuredGrid *grid)
+{
+  cout << label << ": connectivity "
+       << grid->GetCells()->GetActualMemorySize() << " KiB, links "
+       << grid->GetCellLinks()->GetActualMemorySize() << " KiB, grid "
+       << grid->GetActualMemorySize() << " KiB" << endl;
+}
+
+int TestUnstructuredGrid32BitStorage(int, char *[])
+{
+  int retVal = 0;
+  vtkUnstructuredGrid *grid64 = MakeHexGrid();
+  vtkUnstructuredGrid *grid32 = MakeHexGrid();
+  grid64->BuildLinks();
+  grid32->SetUse32BitStorage(1);
+  grid32->BuildLinks();
+
+  Report("vtkIdType storage", grid64);
+  Report("32 bit storage   ", grid32);
+
+  if (!grid32->GetCells()->GetUse32BitStorage() ||
+      !grid32->GetCellLinks()->GetUse32BitStorage())
+    {
+    cerr << "32 bit storage was not enabled" << endl;
+    retVal = 1;
+    }
+  if (sizeof(vtkIdType) > 4 &&
+      (grid32->GetActualMemorySize() >= grid64->GetActualMemorySize() ||
+       2*grid32->GetCells()->GetActualMemorySize() >
+       grid64->GetCells()->GetActualMemorySize() + 1 ||
+       2*grid32->GetCellLinks()->GetActualMemorySize() >
+       grid64->GetCellLinks()->GetActualMemorySize() + 1))
+    {
+    cerr << "32 bit storage does not save memory" << endl;
+    retVal = 1;
+    }
+
+  // The same topology must be seen through the vtkIdType API.
+  vtkSmartPointer<vtkIdList> ids64 = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> ids32 = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> nbrs64 = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> nbrs32 = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkGenericCell> cell =
+    vtkSmartPointer<vtkGenericCell>::New();
+  vtkIdType id, npts, *pts, ncells, *cellIds;
+  for (id = 0; id < grid64->GetNumberOfCells() && !retVal; id += 13)
+    {
+    grid64->GetCellPoints(id, ids64);
+    grid32->GetCellPoints(id, ids32);
+    grid32->GetCellPoints(id, npts, pts);
+    grid32->GetCell(id, cell);
+    if (!SameIds(ids64, ids32) || !SameIds(ids64, cell->PointIds) ||
+        npts != 8 || pts[7] != ids64->GetId(7))
+      {
+      cerr << "Wrong points for cell " << id << endl;
+      retVal = 1;
+      }
+    grid64->GetCellNeighbors(id, ids64, nbrs64);
+    grid32->GetCellNeighbors(id, ids32, nbrs32);
+    if (!SameIds(nbrs64, nbrs32))
+      {
+      cerr << "Wrong neighbors for cell " << id << endl;
+      retVal = 1;
+      }
+    }
+  for (id = 0; id < grid64->GetNumberOfPoints() && !retVal; id += 7)
+    {
+    grid64->GetPointCells(id, ids64);
+    grid32->GetPointCells(id, ids32);
+    grid32->GetCellLinks()->GetCells(id, ncells, cellIds, nbrs32);
+    if (!SameIds(ids64, ids32) || ncells != ids64->GetNumberOfIds() ||
+        cellIds[0] != ids64->GetId(0) ||
+        cellIds[ncells-1] != ids64->GetId(ncells-1))
+      {
+      cerr << "Wrong cells for point " << id << endl;
+      retVal = 1;
+      }
+    }
+
+  // The traversal with a buffer decodes the cells without converting the
+  // list, and the raw vtkIdType accessors fail rather than convert it.
+  vtkCellArray *cells64 = grid64->GetCells();
+  vtkCellArray *cells32 = grid32->GetCells();
+  vtkIdType loc64 = 0, loc32 = 0, npts64, *pts64;
+  vtkIdType numCells = 0;
+  while (cells64->GetNextCell(loc64, npts64, pts64) && !retVal)
+    {
+    if (!cells32->GetNextCell(loc32, npts, pts, ids32) || npts != npts64 ||
+        pts != ids32->GetPointer(0) || pts[0] != pts64[0] ||
+        pts[npts-1] != pts64[npts-1])
+      {
+      cerr << "Wrong traversal of the 32 bit cells" << endl;
+      retVal = 1;
+      }
+    numCells++;
+    }
+  if (cells32->GetNextCell(loc32, npts, pts, ids32) ||
+      numCells != cells32->GetNumberOfCells())
+    {
+    cerr << "Wrong end of the traversal of the 32 bit cells" << endl;
+    retVal = 1;
+    }
+#if VTK_SIZEOF_ID_TYPE > 4
+  vtkObject::GlobalWarningDisplayOff();
+  if (cells32->GetPointer() || cells32->GetData() ||
+      !cells32->GetUse32BitStorage())
+    {
+    cerr << "GetPointer() or GetData() converted the 32 bit cells" << endl;
+    retVal = 1;
+    }
+  vtkObject::GlobalWarningDisplayOn();
+#endif
+
+  // Copies keep the storage.
+  vtkUnstructuredGrid *copy = vtkUnstructuredGrid::New();
+  copy->DeepCopy(grid32);
+  if (!copy->GetUse32BitStorage() || !copy->GetCells()->GetUse32BitStorage())
+    {
+    cerr << "DeepCopy lost the 32 bit storage" << endl;
+    retVal = 1;
+    }
+
+  // Editing the links goes back to the regular storage.
+  vtkIdType newPts[4] = { 0, 1, RES + 2, RES + 1 };
+  vtkIdType newCell = grid32->InsertNextLinkedCell(VTK_QUAD, 4, newPts);
+  grid32->GetPointCells(0, ids32);
+  if (ids32->GetNumberOfIds() != 2 || ids32->GetId(1) != newCell)
+    {
+    cerr << "Wrong links after InsertNextLinkedCell" << endl;
+    retVal = 1;
+    }
+
+#if VTK_SIZEOF_ID_TYPE > 4
+  // Ids that do not fit convert the cell array back.
+  vtkCellArray *cells = copy->GetCells();
+  vtkIdType bigPts[3] = { 0, 1, static_cast<vtkIdType>(VTK_INT_MAX) + 10 };
+  vtkIdType bigCell = cells->InsertNextCell(3, bigPts);
+  cells->GetCellAtId(bigCell, npts, pts);
+  if (cells->GetUse32BitStorage() || npts != 3 || pts[2] != bigPts[2])
+    {
+    cerr << "Wrong conversion back to vtkIdType storage" << endl;
+    retVal = 1;
+    }
+#endif
+
+  copy->Delete();
+  grid32->Delete();
+  grid64->Delete();
+  return retVal;
+}
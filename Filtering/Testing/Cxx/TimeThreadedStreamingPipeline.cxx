@@ -0,0 +1,240 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeThreadedStreamingPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the execution time of representative pipeline graphs when
+// they are updated by vtkCompositeDataPipeline (one module at a time)
+// and by vtkThreadedStreamingPipeline (independent modules run by the
+// threads of vtkExecutionScheduler):
+//
+//   fan:     one source feeding compute-heavy branches merged by an append
+//   sources: independent sources and branches merged by an append
+//   chain:   a deep chain of cheap filters, where the scheduling overhead
+//            dominates
+//   pieces:  the fan updated piece by piece
+//
+// Usage: TimeThreadedStreamingPipeline [maxThreads [repetitions [branches]]]
+
+#include "vtkAlgorithmOutput.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkExecutionScheduler.h"
+#include "vtkMultiThreader.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkThreadedStreamingPipeline.h"
+#include "vtkTimerLog.h"
+#include "vtkTransform.h"
+#include "vtkTransformPolyDataFilter.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <vector>
+
+#include <stdlib.h>
+
+enum { Fan, Sources, Chain, Pieces, NumberOfGraphs };
+static const char *GraphNames[NumberOfGraphs] =
+  { "fan", "sources", "chain", "pieces" };
+static const int NumberOfPieces = 4;
+static const int ChainLength = 64;
+
+// The algorithms of one pipeline graph.  Every algorithm gets the
+// executive of the requested type before it is connected.
+class GraphBuilder
+{
+public:
+  GraphBuilder(int threaded) : Threaded(threaded) {}
+
+  template <class T> T *Add(vtkSmartPointer<T> algorithm)
+    {
+    vtkExecutive *exec;
+    if (this->Threaded)
+      {
+      exec = vtkThreadedStreamingPipeline::New();
+      }
+    else
+      {
+      exec = vtkCompositeDataPipeline::New();
+      }
+    algorithm->SetExecutive(exec);
+    exec->Delete();
+    this->Algorithms.push_back(algorithm.GetPointer());
+    return algorithm;
+    }
+
+  vtkSphereSource *NewSphere(int resolution, double x)
+    {
+    vtkSphereSource *sphere = this->Add(vtkSmartPointer<vtkSphereSource>::New());
+    sphere->SetThetaResolution(resolution);
+    sphere->SetPhiResolution(resolution);
+    sphere->SetCenter(x, 0.0, 0.0);
+    return sphere;
+    }
+
+  vtkAlgorithm *NewSmooth(vtkAlgorithmOutput *input, int branch)
+    {
+    vtkWindowedSincPolyDataFilter *smooth =
+      this->Add(vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New());
+    smooth->SetNumberOfIterations(20);
+    smooth->SetPassBand(0.1 + 0.01 * branch);
+    smooth->SetInputConnection(input);
+    return smooth;
+    }
+
+  int Threaded;
+  std::vector<vtkSmartPointer<vtkAlgorithm> > Algorithms;
+};
+
+// Build the graph and return its sink.
+static vtkAlgorithm *BuildGraph(GraphBuilder &builder, int graph,
+                                int branches)
+{
+  if (graph == Chain)
+    {
+    vtkAlgorithm *last = builder.NewSphere(64, 0.0);
+    vtkSmartPointer<vtkTransform> transform =
+      vtkSmartPointer<vtkTransform>::New();
+    for (int i = 0; i < ChainLength; i++)
+      {
+      vtkTransformPolyDataFilter *filter =
+        builder.Add(vtkSmartPointer<vtkTransformPolyDataFilter>::New());
+      filter->SetTransform(transform);
+      filter->SetInputConnection(last->GetOutputPort());
+      last = filter;
+      }
+    return last;
+    }
+
+  vtkAppendPolyData *append =
+    builder.Add(vtkSmartPointer<vtkAppendPolyData>::New());
+  vtkSphereSource *shared = 0;
+  if (graph != Sources)
+    {
+    shared = builder.NewSphere(256, 0.0);
+    }
+  for (int b = 0; b < branches; b++)
+    {
+    vtkSphereSource *source = shared;
+    if (!source)
+      {
+      source = builder.NewSphere(256, 2.0 * b);
+      }
+    append->AddInputConnection(
+      builder.NewSmooth(source->GetOutputPort(), b)->GetOutputPort());
+    }
+  return append;
+}
+
+// Time "repetitions" updates of the sink after its sources have been
+// modified and return the average time per update.  The number of
+// points of the last output is returned in numberOfPoints.
+static double TimeGraph(GraphBuilder &builder, vtkAlgorithm *sink,
+                        int graph, int repetitions,
+                        vtkIdType &numberOfPoints)
+{
+  vtkStreamingDemandDrivenPipeline *exec =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(sink->GetExecutive());
+  int pieces = (graph == Pieces ? NumberOfPieces : 1);
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  numberOfPoints = 0;
+  for (int r = -1; r < repetitions; r++)
+    {
+    if (r == 0)
+      {
+      timer->StartTimer(); // the first update is a warm up
+      }
+    for (size_t i = 0; i < builder.Algorithms.size(); i++)
+      {
+      if (builder.Algorithms[i]->IsA("vtkSphereSource"))
+        {
+        builder.Algorithms[i]->Modified();
+        }
+      }
+    numberOfPoints = 0;
+    for (int p = 0; p < pieces; p++)
+      {
+      exec->SetUpdateExtent(0, p, pieces, 0);
+      sink->Update();
+      numberOfPoints += vtkPolyData::SafeDownCast(
+        sink->GetOutputDataObject(0))->GetNumberOfPoints();
+      }
+    }
+  timer->StopTimer();
+  return timer->GetElapsedTime() / repetitions;
+}
+
+int main(int argc, char *argv[])
+{
+  int maxThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  int repetitions = 5;
+  int branches = 8;
+  if (argc > 1)
+    {
+    maxThreads = atoi(argv[1]);
+    }
+  if (argc > 2)
+    {
+    repetitions = atoi(argv[2]);
+    }
+  if (argc > 3)
+    {
+    branches = atoi(argv[3]);
+    }
+
+  vtkExecutionScheduler *scheduler =
+    vtkExecutionScheduler::GetGlobalScheduler();
+
+  int retVal = 0;
+  for (int g = 0; g < NumberOfGraphs; g++)
+    {
+    GraphBuilder serialBuilder(0);
+    vtkAlgorithm *serialSink = BuildGraph(serialBuilder, g, branches);
+    vtkIdType serialPoints;
+    double serialTime = TimeGraph(serialBuilder, serialSink, g,
+                                  repetitions, serialPoints);
+
+    GraphBuilder threadedBuilder(1);
+    vtkAlgorithm *threadedSink = BuildGraph(threadedBuilder, g, branches);
+    vtkThreadedStreamingPipeline::SafeDownCast(
+      threadedSink->GetExecutive())->EnableMultiThreadingOn();
+
+    cout << GraphNames[g] << " (" << threadedBuilder.Algorithms.size()
+         << " modules, " << repetitions << " updates)" << endl;
+    cout << "  threads  vtkCompositeDataPipeline(ms)"
+         << "  vtkThreadedStreamingPipeline(ms)  speedup  concurrency"
+         << endl;
+    for (int n = 1; n <= maxThreads; n *= 2)
+      {
+      scheduler->SetNumberOfThreads(n);
+      scheduler->ResetStatistics();
+      vtkIdType threadedPoints;
+      double threadedTime = TimeGraph(threadedBuilder, threadedSink, g,
+                                      repetitions, threadedPoints);
+      if (threadedPoints != serialPoints)
+        {
+        cerr << "The " << GraphNames[g] << " graph produced "
+             << threadedPoints << " points with " << n
+             << " threads instead of " << serialPoints << endl;
+        retVal = 1;
+        }
+
+      cout << "  " << n << "\t   " << serialTime * 1000.0 << "\t\t\t\t"
+           << threadedTime * 1000.0 << "\t\t\t  "
+           << serialTime / threadedTime << "\t   "
+           << scheduler->GetMaximumNumberOfConcurrentTasks() << endl;
+      }
+    }
+
+  return retVal;
+}
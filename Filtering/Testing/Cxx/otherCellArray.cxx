@@ -23,6 +23,7 @@
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 
 #include <vtksys/ios/sstream>
 
@@ -81,8 +82,167 @@ int TestCellArray(ostream& strm)
   return 0;
 }
 
+// Sums the point ids of a range of cells, accessed through the offsets.
+class vtkCellArraySumFunctor
+{
+public:
+  vtkCellArray *Cells;
+  vtkIdType *Sums;
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdType npts, *pts;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->Cells->GetCellAtId(cellId, npts, pts);
+      this->Sums[cellId] = 0;
+      for (vtkIdType i = 0; i < npts; i++)
+        {
+        this->Sums[cellId] += pts[i];
+        }
+      }
+    }
+};
+
+int TestCellArrayOffsets(ostream& strm)
+{
+  strm << "Test CellArray Offsets Start" << endl;
+  int retVal = 0;
+  const vtkIdType numCells = 1000;
+  vtkCellArray *ca = vtkCellArray::New();
+
+  // Cells of 1 to 5 points; cell i uses the points i, i+1, ...
+  vtkIdType pts[5];
+  vtkIdType cellId, i;
+  for (cellId = 0; cellId < numCells / 2; cellId++)
+    {
+    for (i = 0; i < cellId % 5 + 1; i++)
+      {
+      pts[i] = cellId + i;
+      }
+    ca->InsertNextCell(cellId % 5 + 1, pts);
+    }
+  ca->BuildOffsets();
+  if (!ca->HasOffsets() ||
+      ca->GetOffsets()->GetNumberOfTuples() != numCells / 2)
+    {
+    strm << "BuildOffsets failed" << endl;
+    retVal = 1;
+    }
+
+  // The offsets must follow the insertions.
+  for (; cellId < numCells; cellId++)
+    {
+    if (cellId % 2)
+      {
+      for (i = 0; i < cellId % 5 + 1; i++)
+        {
+        pts[i] = cellId + i;
+        }
+      ca->InsertNextCell(cellId % 5 + 1, pts);
+      }
+    else
+      {
+      ca->InsertNextCell(static_cast<int>(cellId % 5 + 1));
+      for (i = 0; i < cellId % 5 + 1; i++)
+        {
+        ca->InsertCellPoint(cellId + i);
+        }
+      }
+    }
+
+  // Random access.
+  vtkIdType npts, *cellPts;
+  vtkIdList *ids = vtkIdList::New();
+  for (cellId = numCells - 1; cellId >= 0; cellId -= 7)
+    {
+    ca->GetCellAtId(cellId, npts, cellPts);
+    ca->GetCellAtId(cellId, ids);
+    if (npts != cellId % 5 + 1 || cellPts[0] != cellId ||
+        cellPts[npts - 1] != cellId + npts - 1 ||
+        ids->GetNumberOfIds() != npts || ids->GetId(npts - 1) != cellId + npts - 1)
+      {
+      strm << "Wrong points for cell " << cellId << endl;
+      retVal = 1;
+      }
+    }
+
+  // Traversal with a caller held location.
+  vtkIdType loc = 0;
+  cellId = 0;
+  while (ca->GetNextCell(loc, npts, cellPts))
+    {
+    if (ca->GetCellLocation(cellId) + npts + 1 != loc || cellPts[0] != cellId)
+      {
+      strm << "Wrong traversal at cell " << cellId << endl;
+      retVal = 1;
+      }
+    cellId++;
+    }
+  if (cellId != numCells)
+    {
+    strm << "Traversal visited " << cellId << " cells" << endl;
+    retVal = 1;
+    }
+
+  // Concurrent random access.
+  vtkIdType *sums = new vtkIdType[numCells];
+  vtkCellArraySumFunctor functor;
+  functor.Cells = ca;
+  functor.Sums = sums;
+  vtkSMPTools::For(0, numCells, 10, functor);
+  for (cellId = 0; cellId < numCells; cellId++)
+    {
+    npts = cellId % 5 + 1;
+    if (sums[cellId] != npts * cellId + npts * (npts - 1) / 2)
+      {
+      strm << "Wrong parallel access to cell " << cellId << endl;
+      retVal = 1;
+      break;
+      }
+    }
+  delete [] sums;
+
+  // Copies keep the offsets, new connectivity discards them.
+  vtkCellArray *copy = vtkCellArray::New();
+  copy->DeepCopy(ca);
+  if (!copy->HasOffsets())
+    {
+    strm << "DeepCopy lost the offsets" << endl;
+    retVal = 1;
+    }
+  copy->Reset();
+  copy->InsertNextCell(3, pts);
+  copy->InsertNextCell(2, pts);
+  copy->GetCellAtId(1, npts, cellPts);
+  if (npts != 2 || copy->GetCellLocation(1) != 4)
+    {
+    strm << "Wrong offsets after Reset" << endl;
+    retVal = 1;
+    }
+  copy->SetCells(ca->GetNumberOfCells(), ca->GetData());
+  if (copy->HasOffsets() || copy->GetCellLocation(numCells - 1) !=
+      ca->GetCellLocation(numCells - 1))
+    {
+    strm << "Wrong offsets after SetCells" << endl;
+    retVal = 1;
+    }
+
+  ids->Delete();
+  copy->Delete();
+  ca->Delete();
+  strm << "Test CellArray Offsets Complete" << endl;
+
+  return retVal;
+}
+
 int otherCellArray(int,char *[])
 {
   vtksys_ios::ostringstream vtkmsg_with_warning_C4701; 
-  return TestCellArray(vtkmsg_with_warning_C4701);
+  int retVal = TestCellArray(vtkmsg_with_warning_C4701);
+  retVal |= TestCellArrayOffsets(vtkmsg_with_warning_C4701);
+  if (retVal)
+    {
+    cerr << vtkmsg_with_warning_C4701.str();
+    }
+  return retVal;
 } 
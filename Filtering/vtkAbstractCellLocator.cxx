@@ -22,6 +22,68 @@
 #include "vtkPoints.h"
 #include "vtkDataSet.h"
 #include "vtkMath.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+//----------------------------------------------------------------------------
+// Intersect a range of lines of IntersectWithLines() in parallel, with one
+// vtkGenericCell per thread.
+class vtkAbstractCellLocatorIntersectLines
+{
+public:
+  vtkAbstractCellLocator *Locator;
+  const double *P1;
+  const double *P2;
+  double Tol;
+  vtkIdType *CellIds;
+  double *T;
+  double *X;
+  vtkSMPThreadLocal<vtkGenericCell *> Cell;
+
+  void Initialize()
+    {
+    this->Cell.Local() = vtkGenericCell::New();
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkGenericCell *cell = this->Cell.Local();
+    double t, x[3], pcoords[3];
+    int subId;
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      vtkIdType cellId = -1;
+      if (!this->Locator->ThreadedIntersectWithLine(
+            const_cast<double *>(this->P1 + 3*i),
+            const_cast<double *>(this->P2 + 3*i),
+            this->Tol, t, x, pcoords, subId, cellId, cell))
+        {
+        cellId = -1;
+        }
+      this->CellIds[i] = cellId;
+      if (cellId >= 0 && this->T)
+        {
+        this->T[i] = t;
+        }
+      if (cellId >= 0 && this->X)
+        {
+        this->X[3*i] = x[0];
+        this->X[3*i+1] = x[1];
+        this->X[3*i+2] = x[2];
+        }
+      }
+    }
+
+  void Reduce()
+    {
+    vtkSMPThreadLocal<vtkGenericCell *>::iterator it;
+    for (it = this->Cell.begin(); it != this->Cell.end(); ++it)
+      {
+      (*it)->Delete();
+      }
+    }
+};
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -56,6 +118,16 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   return true;
 }
 //----------------------------------------------------------------------------
+unsigned long vtkAbstractCellLocator::GetActualMemorySize()
+{
+  if (!this->CellBounds || !this->DataSet)
+    {
+    return 0;
+    }
+  size_t size = this->DataSet->GetNumberOfCells() * 6 * sizeof(double);
+  return static_cast<unsigned long>((size + 1023) / 1024); //kilobytes
+}
+//----------------------------------------------------------------------------
 void vtkAbstractCellLocator::FreeCellBounds()
 {
   if (this->CellBounds)
@@ -107,6 +179,61 @@ int vtkAbstractCellLocator::IntersectWithLine(
   return 0;
 }
 //----------------------------------------------------------------------------
+vtkIdType vtkAbstractCellLocator::IntersectWithLines(
+  vtkIdType numLines, const double *p1, const double *p2, double tol,
+  vtkIdType *cellIds, double *t, double *x)
+{
+  vtkIdType i;
+  if (this->PrepareForThreadedIntersectWithLine())
+    {
+    vtkAbstractCellLocatorIntersectLines intersect;
+    intersect.Locator = this;
+    intersect.P1 = p1;
+    intersect.P2 = p2;
+    intersect.Tol = tol;
+    intersect.CellIds = cellIds;
+    intersect.T = t;
+    intersect.X = x;
+    vtkSMPTools::For(0, numLines, 64, intersect);
+    }
+  else
+    {
+    double tHit, xHit[3], pcoords[3];
+    int subId;
+    for (i = 0; i < numLines; i++)
+      {
+      cellIds[i] = -1;
+      if (this->IntersectWithLine(const_cast<double *>(p1 + 3*i),
+                                  const_cast<double *>(p2 + 3*i),
+                                  tol, tHit, xHit, pcoords, subId,
+                                  cellIds[i], this->GenericCell))
+        {
+        if (t)
+          {
+          t[i] = tHit;
+          }
+        if (x)
+          {
+          x[3*i] = xHit[0];
+          x[3*i+1] = xHit[1];
+          x[3*i+2] = xHit[2];
+          }
+        }
+      else
+        {
+        cellIds[i] = -1;
+        }
+      }
+    }
+
+  vtkIdType numHits = 0;
+  for (i = 0; i < numLines; i++)
+    {
+    numHits += (cellIds[i] >= 0);
+    }
+  return numHits;
+}
+//----------------------------------------------------------------------------
 void vtkAbstractCellLocator::FindClosestPoint(
   double x[3], double closestPoint[3],
   vtkIdType &cellId, int &subId,
@@ -130,6 +130,23 @@ public:
     const double p1[3], const double p2[3],
     vtkPoints *points, vtkIdList *cellIds);
 
+  // Description:
+  // Intersect a batch of finite lines with the cells.  Line i goes from
+  // p1+3*i to p2+3*i.  cellIds[i] is set to the intersected cell closest
+  // to the start of the line, or -1 if the line misses all the cells, and
+  // t[i] and x+3*i to the parametric coordinate and the position of the
+  // intersection; t and x may be NULL.  Return the number of lines that
+  // hit a cell.  Locators whose line intersection may run on several
+  // threads (see PrepareForThreadedIntersectWithLine()) process the lines
+  // in parallel with vtkSMPTools, each thread using its own vtkGenericCell;
+  // the other locators process them serially with a single cell.  The
+  // threads take chunks of consecutive lines, so bundles of coherent
+  // lines should be stored next to each other.
+  // THIS METHOD IS NOT THREAD SAFE.
+  virtual vtkIdType IntersectWithLines(
+    vtkIdType numLines, const double *p1, const double *p2, double tol,
+    vtkIdType *cellIds, double *t, double *x);
+
   // Description:
   // Return the closest point and the cell which is closest to the point x.
   // The closest point is somewhere on a cell, it need not be one of the
@@ -238,6 +255,11 @@ public:
   // Some locators cache cell bounds and this function can make use
   // of fast access to the data.
   virtual bool InsideCellBounds(double x[3], vtkIdType cell_ID);
+
+  // Description:
+  // Return the memory in kilobytes used by the cached cell bounds.
+  // Subclasses add their search structure.
+  virtual unsigned long GetActualMemorySize();
  
 protected:
    vtkAbstractCellLocator();
@@ -252,6 +274,30 @@ protected:
   virtual bool StoreCellBounds();
   virtual void FreeCellBounds();
 
+  // Description:
+  // Build the locator, and prepare the dataset with
+  // vtkDataSet::PrepareForThreadedAccess(), so that
+  // ThreadedIntersectWithLine() may be called from several threads at
+  // once.  Return 0, the default, if the locator does not support this;
+  // IntersectWithLines() then runs serially.
+  virtual int PrepareForThreadedIntersectWithLine() { return 0; }
+
+  // Description:
+  // The line intersection run by the threads of IntersectWithLines(), each
+  // with its own cell.  By default the IntersectWithLine() taking a
+  // vtkGenericCell, which must then not use other scratch space of the
+  // locator.
+  virtual int ThreadedIntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+    {
+    return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId,
+                                   cellId, cell);
+    }
+//BTX
+  friend class vtkAbstractCellLocatorIntersectLines;
+//ETX
+
   int NumberOfCellsPerNode;
   int RetainCellLists;
   int CacheCellBounds;
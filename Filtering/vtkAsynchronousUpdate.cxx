@@ -0,0 +1,377 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousUpdate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsynchronousUpdate.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAlgorithmOutput.h"
+#include "vtkCallbackCommand.h"
+#include "vtkConditionVariable.h"
+#include "vtkDataObject.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkObjectFactory.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+vtkStandardNewMacro(vtkAsynchronousUpdate);
+
+//----------------------------------------------------------------------------
+class vtkAsynchronousUpdateInternals
+{
+public:
+  // The algorithms upstream of the port, with their observers and
+  // progress.
+  std::vector<vtkAlgorithm*> Algorithms;
+  std::vector<unsigned long> ProgressTags;
+  std::vector<unsigned long> EndTags;
+  std::vector<double> Progress;
+
+  // The algorithms executing, and those that were aborted.
+  std::set<vtkAlgorithm*> Executing;
+  std::set<vtkAlgorithm*> Aborted;
+
+  vtkCallbackCommand *Observer;
+
+  static void AlgorithmCallback(vtkObject *caller, unsigned long event,
+                                void *clientData, void *callData)
+    {
+    vtkAsynchronousUpdate *self =
+      static_cast<vtkAsynchronousUpdate*>(clientData);
+    vtkAlgorithm *algorithm = static_cast<vtkAlgorithm*>(caller);
+    if (event == vtkCommand::ProgressEvent)
+      {
+      self->AlgorithmProgress(algorithm, *static_cast<double*>(callData));
+      }
+    else
+      {
+      self->AlgorithmEnd(algorithm);
+      }
+    }
+
+  // Add the algorithm and the algorithms upstream of it.
+  void CollectAlgorithms(vtkAlgorithm *algorithm)
+    {
+    if (std::find(this->Algorithms.begin(), this->Algorithms.end(),
+                  algorithm) != this->Algorithms.end())
+      {
+      return;
+      }
+    this->Algorithms.push_back(algorithm);
+    for (int i = 0; i < algorithm->GetNumberOfInputPorts(); ++i)
+      {
+      for (int j = 0; j < algorithm->GetNumberOfInputConnections(i); ++j)
+        {
+        vtkAlgorithmOutput *input = algorithm->GetInputConnection(i, j);
+        if (input && input->GetProducer())
+          {
+          this->CollectAlgorithms(input->GetProducer());
+          }
+        }
+      }
+    }
+
+  // Stop following the algorithms, so that they do not report to this
+  // update once it is done.
+  void RemoveObservers()
+    {
+    for (size_t i = 0; i < this->ProgressTags.size(); ++i)
+      {
+      this->Algorithms[i]->RemoveObserver(this->ProgressTags[i]);
+      this->Algorithms[i]->RemoveObserver(this->EndTags[i]);
+      }
+    this->ProgressTags.clear();
+    this->EndTags.clear();
+    }
+};
+
+//----------------------------------------------------------------------------
+void *vtkAsynchronousUpdate_UpdateThread(void *data)
+{
+  vtkAsynchronousUpdate *self = static_cast<vtkAsynchronousUpdate*>
+    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
+  self->Execute();
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousUpdate::vtkAsynchronousUpdate()
+{
+  this->Executive = 0;
+  this->Port = 0;
+  this->Status = NOT_STARTED;
+  this->Cancelled = 0;
+  this->Output = 0;
+  this->Threader = vtkMultiThreader::New();
+  this->ThreadId = -1;
+  this->Lock = vtkMutexLock::New();
+  this->Done = vtkConditionVariable::New();
+  this->Internals = new vtkAsynchronousUpdateInternals;
+  this->Internals->Observer = vtkCallbackCommand::New();
+  this->Internals->Observer->SetCallback(
+    &vtkAsynchronousUpdateInternals::AlgorithmCallback);
+  this->Internals->Observer->SetClientData(this);
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousUpdate::~vtkAsynchronousUpdate()
+{
+  // Nobody is interested in the result anymore.
+  if (this->ThreadId >= 0)
+    {
+    this->Cancel();
+    this->Wait();
+    this->Threader->TerminateThread(this->ThreadId);
+    }
+
+  this->Internals->RemoveObservers();
+  for (size_t i = 0; i < this->Internals->Algorithms.size(); ++i)
+    {
+    this->Internals->Algorithms[i]->UnRegister(this);
+    }
+  if (this->Executive)
+    {
+    this->Executive->UnRegister(this);
+    }
+  if (this->Output)
+    {
+    this->Output->Delete();
+    }
+  this->Internals->Observer->Delete();
+  delete this->Internals;
+  this->Done->Delete();
+  this->Lock->Delete();
+  this->Threader->Delete();
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousUpdate::Start(vtkStreamingDemandDrivenPipeline *exec,
+                                 int port)
+{
+  if (this->Status != NOT_STARTED)
+    {
+    vtkErrorMacro("The update was already started.");
+    return 0;
+    }
+  if (!exec || !exec->GetAlgorithm())
+    {
+    vtkErrorMacro("No executive or algorithm to update.");
+    return 0;
+    }
+
+  this->Executive = exec;
+  this->Executive->Register(this);
+  this->Port = port;
+
+  // Keep the algorithms alive while the worker thread uses them and
+  // follow their progress.
+  this->Internals->CollectAlgorithms(exec->GetAlgorithm());
+  size_t numAlgorithms = this->Internals->Algorithms.size();
+  this->Internals->Progress.resize(numAlgorithms, 0.0);
+  for (size_t i = 0; i < numAlgorithms; ++i)
+    {
+    vtkAlgorithm *algorithm = this->Internals->Algorithms[i];
+    algorithm->Register(this);
+    this->Internals->ProgressTags.push_back(
+      algorithm->AddObserver(vtkCommand::ProgressEvent,
+                             this->Internals->Observer));
+    this->Internals->EndTags.push_back(
+      algorithm->AddObserver(vtkCommand::EndEvent,
+                             this->Internals->Observer));
+    }
+
+  this->Status = RUNNING;
+  this->ThreadId = this->Threader->SpawnThread(
+    (vtkThreadFunctionType)(vtkAsynchronousUpdate_UpdateThread), this);
+  if (this->ThreadId < 0)
+    {
+    vtkErrorMacro("Could not create the worker thread.");
+    this->Internals->RemoveObservers();
+    this->Lock->Lock();
+    this->Status = FAILED;
+    this->Done->Broadcast();
+    this->Lock->Unlock();
+    return 0;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdate::Execute()
+{
+  int result = this->Executive->Update(this->Port);
+
+  // Later updates of the pipeline, asynchronous or not, must neither be
+  // followed nor cancelled by this one.
+  this->Lock->Lock();
+  this->Internals->RemoveObservers();
+  this->Internals->Executing.clear();
+  this->Lock->Unlock();
+
+  int status = result ? COMPLETED : FAILED;
+  vtkDataObject *output = 0;
+  if (!this->Internals->Aborted.empty())
+    {
+    // The partial outputs of the aborted algorithms must not be mistaken
+    // for up-to-date ones.
+    std::set<vtkAlgorithm*>::iterator it;
+    for (it = this->Internals->Aborted.begin();
+         it != this->Internals->Aborted.end(); ++it)
+      {
+      (*it)->Modified();
+      }
+    status = CANCELLED;
+    }
+  else if (result)
+    {
+    vtkDataObject *data = this->Executive->GetOutputData(this->Port);
+    if (data)
+      {
+      output = data->NewInstance();
+      output->ShallowCopy(data);
+      }
+    }
+
+  this->Lock->Lock();
+  this->Output = output;
+  this->Status = status;
+  this->Done->Broadcast();
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdate::AlgorithmProgress(vtkAlgorithm *algorithm,
+                                              double progress)
+{
+  this->Lock->Lock();
+  this->Internals->Executing.insert(algorithm);
+  if (this->Cancelled && this->Status == RUNNING &&
+      !algorithm->GetAbortExecute())
+    {
+    // The executive clears the flag when the algorithm starts executing.
+    algorithm->SetAbortExecute(1);
+    }
+  std::vector<vtkAlgorithm*>::iterator it =
+    std::find(this->Internals->Algorithms.begin(),
+              this->Internals->Algorithms.end(), algorithm);
+  if (it != this->Internals->Algorithms.end())
+    {
+    this->Internals->Progress[it - this->Internals->Algorithms.begin()] =
+      progress;
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdate::AlgorithmEnd(vtkAlgorithm *algorithm)
+{
+  this->Lock->Lock();
+  this->Internals->Executing.erase(algorithm);
+  if (algorithm->GetAbortExecute())
+    {
+    this->Internals->Aborted.insert(algorithm);
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousUpdate::GetStatus()
+{
+  this->Lock->Lock();
+  int status = this->Status;
+  this->Lock->Unlock();
+  return status;
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousUpdate::IsDone()
+{
+  int status = this->GetStatus();
+  return status != NOT_STARTED && status != RUNNING;
+}
+
+//----------------------------------------------------------------------------
+int vtkAsynchronousUpdate::Wait()
+{
+  this->Lock->Lock();
+  while (this->Status == RUNNING)
+    {
+    this->Done->Wait(this->Lock);
+    }
+  int status = this->Status;
+  this->Lock->Unlock();
+  return status == COMPLETED;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdate::Cancel()
+{
+  this->Lock->Lock();
+  if (this->Status == RUNNING)
+    {
+    this->Cancelled = 1;
+    std::set<vtkAlgorithm*>::iterator it;
+    for (it = this->Internals->Executing.begin();
+         it != this->Internals->Executing.end(); ++it)
+      {
+      (*it)->SetAbortExecute(1);
+      }
+    }
+  this->Lock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+double vtkAsynchronousUpdate::GetProgress()
+{
+  this->Lock->Lock();
+  double progress = 0.0;
+  if (this->Status == COMPLETED)
+    {
+    progress = 1.0;
+    }
+  else if (!this->Internals->Progress.empty())
+    {
+    for (size_t i = 0; i < this->Internals->Progress.size(); ++i)
+      {
+      progress += this->Internals->Progress[i];
+      }
+    progress /= this->Internals->Progress.size();
+    }
+  this->Lock->Unlock();
+  return progress;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject *vtkAsynchronousUpdate::GetOutput()
+{
+  this->Lock->Lock();
+  vtkDataObject *output = this->Output;
+  this->Lock->Unlock();
+  return output;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdate::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Executive: " << this->Executive << "\n";
+  os << indent << "Port: " << this->Port << "\n";
+  os << indent << "Status: " << this->GetStatus() << "\n";
+  os << indent << "Progress: " << this->GetProgress() << "\n";
+  os << indent << "Output: " << this->GetOutput() << "\n";
+}
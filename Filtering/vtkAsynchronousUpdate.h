@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousUpdate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkAsynchronousUpdate - handle on a pipeline update running on a worker thread
+// .SECTION Description
+// vtkAsynchronousUpdate is returned by
+// vtkStreamingDemandDrivenPipeline::UpdateAsynchronously().  It brings an
+// output port up-to-date on a worker thread while the calling thread
+// goes on, for example processing user interface events:
+//
+// \code
+// vtkStreamingDemandDrivenPipeline *sddp =
+//   vtkStreamingDemandDrivenPipeline::SafeDownCast(filter->GetExecutive());
+// vtkAsynchronousUpdate *update = sddp->UpdateAsynchronously(0);
+// while (!update->IsDone())
+//   {
+//   ... show update->GetProgress(), call update->Cancel() on request ...
+//   }
+// if (update->GetStatus() == vtkAsynchronousUpdate::COMPLETED)
+//   {
+//   mapper->SetInput(update->GetOutput());
+//   }
+// update->Delete();
+// \endcode
+//
+// The algorithms upstream of the port are executed by the worker thread:
+// until IsDone() returns true, do not modify or update them and do not
+// access their outputs from other threads.  GetOutput() gives a shallow
+// copy of the output taken when the update completed, so a result is only
+// ever visible once it is complete.
+//
+// Cancel() sets the AbortExecute flag of the algorithm executing and of
+// the algorithms executing after it.  Algorithms that poll this flag stop
+// promptly.  The algorithms that were aborted are marked modified, so the
+// next update executes them again instead of keeping partial outputs.
+// The update stops observing the algorithms when it finishes, so a
+// cancelled update left alive does not affect later updates.
+// .SECTION See Also
+// vtkStreamingDemandDrivenPipeline vtkAlgorithm
+
+#ifndef __vtkAsynchronousUpdate_h
+#define __vtkAsynchronousUpdate_h
+
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkConditionVariable;
+class vtkDataObject;
+class vtkMultiThreader;
+class vtkMutexLock;
+class vtkStreamingDemandDrivenPipeline;
+class vtkAsynchronousUpdateInternals;
+
+class VTK_FILTERING_EXPORT vtkAsynchronousUpdate : public vtkObject
+{
+public:
+  static vtkAsynchronousUpdate *New();
+  vtkTypeMacro(vtkAsynchronousUpdate,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  //BTX
+  enum StatusType
+  {
+    NOT_STARTED,
+    RUNNING,
+    COMPLETED,
+    CANCELLED,
+    FAILED
+  };
+  //ETX
+
+  // Description:
+  // Start bringing the given output port of the executive up-to-date on a
+  // worker thread.  Return 0 if this update was already started, or if
+  // the worker thread could not be created, in which case the status is
+  // FAILED.
+  int Start(vtkStreamingDemandDrivenPipeline *exec, int port);
+
+  // Description:
+  // Return the status of the update: NOT_STARTED, RUNNING, COMPLETED,
+  // CANCELLED or FAILED.
+  int GetStatus();
+
+  // Description:
+  // Return 1 if the update finished, successfully or not.
+  int IsDone();
+
+  // Description:
+  // Block until the update finished.  Return 1 if it completed.
+  int Wait();
+
+  // Description:
+  // Ask the algorithms to stop executing.  This returns immediately; use
+  // Wait() to know when the worker thread stopped.  The status is
+  // CANCELLED unless the update completed before the algorithms noticed.
+  void Cancel();
+
+  // Description:
+  // Return the progress of the update between 0 and 1: the mean progress
+  // of the algorithms upstream of the port.  Algorithms that do not need
+  // to execute only count when the update finishes.
+  double GetProgress();
+
+  // Description:
+  // Return a shallow copy of the output taken when the update completed,
+  // or NULL if it did not complete.
+  vtkDataObject *GetOutput();
+
+  // Description:
+  // Return the executive and port updated.
+  vtkStreamingDemandDrivenPipeline *GetExecutive() { return this->Executive; }
+  int GetPort() { return this->Port; }
+
+protected:
+  vtkAsynchronousUpdate();
+  ~vtkAsynchronousUpdate();
+
+  // Description:
+  // Run by the worker thread.
+  void Execute();
+
+  // Description:
+  // Called from the observers of the algorithms.
+  void AlgorithmProgress(vtkAlgorithm *algorithm, double progress);
+  void AlgorithmEnd(vtkAlgorithm *algorithm);
+
+  vtkStreamingDemandDrivenPipeline *Executive;
+  int Port;
+  int Status;
+  int Cancelled;
+  vtkDataObject *Output;
+
+  vtkMultiThreader *Threader;
+  int ThreadId;
+  vtkMutexLock *Lock;
+  vtkConditionVariable *Done;
+
+  vtkAsynchronousUpdateInternals *Internals;
+
+//BTX
+  friend class vtkAsynchronousUpdateInternals;
+  friend void *vtkAsynchronousUpdate_UpdateThread(void *data);
+//ETX
+
+private:
+  vtkAsynchronousUpdate(const vtkAsynchronousUpdate&);  // Not implemented.
+  void operator=(const vtkAsynchronousUpdate&);  // Not implemented.
+};
+
+#endif
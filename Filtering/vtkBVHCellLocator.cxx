@@ -0,0 +1,950 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+// Deeper nodes are made leaves, which bounds the traversal stacks.
+#define VTK_BVH_MAX_DEPTH 64
+#define VTK_BVH_STACK_SIZE (2*VTK_BVH_MAX_DEPTH + 2)
+
+//----------------------------------------------------------------------------
+// A node of the flattened tree.  An interior node has a Count of 0 and its
+// children at Offset and Offset+1; a leaf owns the Count cell ids starting
+// at Offset in CellIds.
+class vtkBVHCellLocatorNode
+{
+public:
+  double Bounds[6];
+  vtkIdType Offset;
+  vtkIdType Count;
+};
+
+//----------------------------------------------------------------------------
+namespace
+{
+// Half the surface area of a box, up to which the SAH compares costs.
+inline double vtkBVHHalfArea(const double b[6])
+{
+  double dx = b[1] - b[0], dy = b[3] - b[2], dz = b[5] - b[4];
+  return dx*dy + dy*dz + dz*dx;
+}
+
+inline void vtkBVHInitBounds(double b[6])
+{
+  b[0] = b[2] = b[4] = VTK_DOUBLE_MAX;
+  b[1] = b[3] = b[5] = -VTK_DOUBLE_MAX;
+}
+
+inline void vtkBVHAddBounds(double b[6], const double c[6])
+{
+  for (int i=0; i < 3; i++)
+    {
+    b[2*i] = (c[2*i] < b[2*i] ? c[2*i] : b[2*i]);
+    b[2*i+1] = (c[2*i+1] > b[2*i+1] ? c[2*i+1] : b[2*i+1]);
+    }
+}
+
+inline bool vtkBVHContains(const double b[6], const double x[3])
+{
+  return x[0] >= b[0] && x[0] <= b[1] && x[1] >= b[2] && x[1] <= b[3] &&
+    x[2] >= b[4] && x[2] <= b[5];
+}
+
+inline bool vtkBVHOverlaps(const double a[6], const double b[6])
+{
+  return a[0] <= b[1] && a[1] >= b[0] && a[2] <= b[3] && a[3] >= b[2] &&
+    a[4] <= b[5] && a[5] >= b[4];
+}
+
+// Squared distance from x to the box, 0 inside.
+inline double vtkBVHDistance2(const double b[6], const double x[3])
+{
+  double d2 = 0.0;
+  for (int i=0; i < 3; i++)
+    {
+    double d = (x[i] < b[2*i] ? b[2*i] - x[i] :
+                (x[i] > b[2*i+1] ? x[i] - b[2*i+1] : 0.0));
+    d2 += d*d;
+    }
+  return d2;
+}
+
+// Clip the parametric range [tmin,tmax] of the line p + t*dir to the box
+// grown by tol.  Return false if the line misses the box.
+inline bool vtkBVHClipLine(const double b[6], const double p[3],
+                           const double dir[3], double tol,
+                           double &tmin, double &tmax)
+{
+  for (int i=0; i < 3; i++)
+    {
+    double lo = b[2*i] - tol, hi = b[2*i+1] + tol;
+    if (dir[i] == 0.0)
+      {
+      if (p[i] < lo || p[i] > hi)
+        {
+        return false;
+        }
+      continue;
+      }
+    double t0 = (lo - p[i]) / dir[i], t1 = (hi - p[i]) / dir[i];
+    if (t0 > t1)
+      {
+      double tmp = t0; t0 = t1; t1 = tmp;
+      }
+    tmin = (t0 > tmin ? t0 : tmin);
+    tmax = (t1 < tmax ? t1 : tmax);
+    if (tmin > tmax)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+// Computes the bounds and the center of the cells.
+struct vtkBVHCellLocatorCellBounds
+{
+  vtkDataSet *DataSet;
+  double (*Bounds)[6];
+  double (*Centers)[3];
+  vtkIdType *CellIds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType cellId=begin; cellId < end; cellId++)
+      {
+      double *b = this->Bounds[cellId];
+      this->DataSet->GetCellBounds(cellId, b);
+      this->Centers[cellId][0] = 0.5 * (b[0] + b[1]);
+      this->Centers[cellId][1] = 0.5 * (b[2] + b[3]);
+      this->Centers[cellId][2] = 0.5 * (b[4] + b[5]);
+      this->CellIds[cellId] = cellId;
+      }
+    }
+};
+
+// A subtree left to build in parallel once the first levels are split.
+struct vtkBVHCellLocatorTask
+{
+  vtkIdType NodeId;
+  vtkIdType Begin;
+  vtkIdType End;
+  int Depth;
+  int MaxDepth;
+  std::vector<vtkBVHCellLocatorNode> Nodes;
+};
+
+// Builds the tree by recursively splitting ranges of CellIds.
+class vtkBVHCellLocatorBuilder
+{
+public:
+  const double (*Bounds)[6];
+  const double (*Centers)[3];
+  vtkIdType *CellIds;
+  int NumberOfBins;
+  int MaxCellsPerLeaf;
+
+  // Build the node nodeId over the cells [begin,end), appending its
+  // descendants to nodes, and return the depth of the deepest leaf.  When
+  // tasks is given, the ranges of at most taskSize cells are not built but
+  // recorded as tasks.
+  int Build(std::vector<vtkBVHCellLocatorNode> &nodes, vtkIdType nodeId,
+            vtkIdType begin, vtkIdType end, int depth,
+            vtkIdType taskSize, std::vector<vtkBVHCellLocatorTask> *tasks)
+    {
+    double bounds[6], centerBounds[6];
+    vtkBVHInitBounds(bounds);
+    vtkBVHInitBounds(centerBounds);
+    vtkIdType i;
+    for (i=begin; i < end; i++)
+      {
+      const double *c = this->Centers[this->CellIds[i]];
+      double cb[6] = { c[0], c[0], c[1], c[1], c[2], c[2] };
+      vtkBVHAddBounds(bounds, this->Bounds[this->CellIds[i]]);
+      vtkBVHAddBounds(centerBounds, cb);
+      }
+    std::copy(bounds, bounds+6, nodes[nodeId].Bounds);
+
+    vtkIdType n = end - begin;
+    if (tasks && n <= taskSize)
+      {
+      vtkBVHCellLocatorTask task;
+      task.NodeId = nodeId;
+      task.Begin = begin;
+      task.End = end;
+      task.Depth = depth;
+      task.MaxDepth = depth;
+      tasks->push_back(task);
+      nodes[nodeId].Offset = begin;
+      nodes[nodeId].Count = n;
+      return depth;
+      }
+
+    int axis = -1, split = 0;
+    if (n > this->MaxCellsPerLeaf && depth < VTK_BVH_MAX_DEPTH)
+      {
+      double cost = this->FindSplit(begin, end, centerBounds, axis, split);
+      // Keep small groups whose split does not pay the traversal.
+      if (axis >= 0 && n <= 4*this->MaxCellsPerLeaf &&
+          1.0 + cost / vtkBVHHalfArea(bounds) >= n)
+        {
+        axis = -1;
+        }
+      }
+    if (axis < 0)
+      {
+      nodes[nodeId].Offset = begin;
+      nodes[nodeId].Count = n;
+      return depth;
+      }
+
+    vtkIdType *mid = std::partition(
+      this->CellIds + begin, this->CellIds + end,
+      BinLess(this->Centers, axis, centerBounds, this->NumberOfBins, split));
+    vtkIdType m = static_cast<vtkIdType>(mid - this->CellIds);
+    if (m == begin || m == end)
+      {
+      // Round off put all the centers in a bin: split at the median.
+      m = begin + n/2;
+      std::nth_element(this->CellIds + begin, this->CellIds + m,
+                       this->CellIds + end, CenterLess(this->Centers, axis));
+      }
+
+    vtkIdType children = static_cast<vtkIdType>(nodes.size());
+    nodes.resize(children + 2);
+    nodes[nodeId].Offset = children;
+    nodes[nodeId].Count = 0;
+    int left = this->Build(nodes, children, begin, m, depth+1,
+                           taskSize, tasks);
+    int right = this->Build(nodes, children+1, m, end, depth+1,
+                            taskSize, tasks);
+    return (left > right ? left : right);
+    }
+
+protected:
+  struct BinLess
+  {
+    const double (*Centers)[3];
+    int Axis, NumberOfBins, Split;
+    double Min, Scale;
+    BinLess(const double (*centers)[3], int axis, const double cb[6],
+            int numBins, int split) : Centers(centers), Axis(axis),
+      NumberOfBins(numBins), Split(split), Min(cb[2*axis]),
+      Scale(numBins / (cb[2*axis+1] - cb[2*axis])) {}
+    bool operator()(vtkIdType cellId) const
+      {
+      int b = static_cast<int>((this->Centers[cellId][this->Axis] - this->Min)
+                               * this->Scale);
+      return (b < this->NumberOfBins ? b : this->NumberOfBins-1) < this->Split;
+      }
+  };
+
+  struct CenterLess
+  {
+    const double (*Centers)[3];
+    int Axis;
+    CenterLess(const double (*centers)[3], int axis) :
+      Centers(centers), Axis(axis) {}
+    bool operator()(vtkIdType a, vtkIdType b) const
+      {
+      return this->Centers[a][this->Axis] < this->Centers[b][this->Axis];
+      }
+  };
+
+  // Bin the centers along each axis and find the split between two bins
+  // of least SAH cost, the sum of the children half areas weighted by
+  // their number of cells.  Return the cost, axis is -1 if the centers
+  // are all at the same position.
+  double FindSplit(vtkIdType begin, vtkIdType end, const double cb[6],
+                   int &bestAxis, int &bestSplit)
+    {
+    const int numBins = this->NumberOfBins;
+    std::vector<vtkIdType> counts(numBins);
+    std::vector<double> binBounds(6*numBins), rightArea(numBins);
+    double bestCost = VTK_DOUBLE_MAX;
+    bestAxis = -1;
+    for (int axis=0; axis < 3; axis++)
+      {
+      if (cb[2*axis+1] <= cb[2*axis])
+        {
+        continue;
+        }
+      BinLess binner(this->Centers, axis, cb, numBins, 0);
+      int b;
+      for (b=0; b < numBins; b++)
+        {
+        counts[b] = 0;
+        vtkBVHInitBounds(&binBounds[6*b]);
+        }
+      for (vtkIdType i=begin; i < end; i++)
+        {
+        vtkIdType cellId = this->CellIds[i];
+        b = static_cast<int>((this->Centers[cellId][axis] - binner.Min) *
+                             binner.Scale);
+        b = (b < numBins ? b : numBins-1);
+        counts[b]++;
+        vtkBVHAddBounds(&binBounds[6*b], this->Bounds[cellId]);
+        }
+
+      // Sweep from the right, then from the left.
+      double box[6];
+      vtkBVHInitBounds(box);
+      for (b=numBins-1; b > 0; b--)
+        {
+        if (counts[b])
+          {
+          vtkBVHAddBounds(box, &binBounds[6*b]);
+          }
+        rightArea[b] = (box[0] <= box[1] ? vtkBVHHalfArea(box) : 0.0);
+        }
+      vtkBVHInitBounds(box);
+      vtkIdType leftCount = 0, n = end - begin;
+      for (b=1; b < numBins; b++)
+        {
+        leftCount += counts[b-1];
+        if (counts[b-1])
+          {
+          vtkBVHAddBounds(box, &binBounds[6*(b-1)]);
+          }
+        if (leftCount == 0 || leftCount == n)
+          {
+          continue;
+          }
+        double cost = vtkBVHHalfArea(box) * leftCount +
+          rightArea[b] * (n - leftCount);
+        if (cost < bestCost)
+          {
+          bestCost = cost;
+          bestAxis = axis;
+          bestSplit = b;
+          }
+        }
+      }
+    return bestCost;
+    }
+};
+
+// Builds the recorded subtrees in parallel, each in its own node array.
+struct vtkBVHCellLocatorBuildTasks
+{
+  vtkBVHCellLocatorBuilder *Builder;
+  std::vector<vtkBVHCellLocatorTask> *Tasks;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType i=begin; i < end; i++)
+      {
+      vtkBVHCellLocatorTask &task = (*this->Tasks)[i];
+      task.Nodes.resize(1);
+      task.MaxDepth = this->Builder->Build(task.Nodes, 0, task.Begin,
+                                           task.End, task.Depth, 0, NULL);
+      }
+    }
+};
+
+void vtkBVHCellLocatorAddBox(vtkPoints *pts, vtkCellArray *lines,
+                             const double b[6])
+{
+  vtkIdType ids[8], line[2];
+  for (int i=0; i < 8; i++)
+    {
+    ids[i] = pts->InsertNextPoint(b[i&1], b[2+((i>>1)&1)], b[4+((i>>2)&1)]);
+    }
+  // The 12 edges join the corners differing by one bit.
+  for (int i=0; i < 8; i++)
+    {
+    for (int bit=1; bit < 8; bit <<= 1)
+      {
+      if (!(i & bit))
+        {
+        line[0] = ids[i];
+        line[1] = ids[i | bit];
+        lines->InsertNextCell(2, line);
+        }
+      }
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+  this->NumberOfBins = 16;
+  this->Depth = 0;
+  this->NumberOfNodes = 0;
+  this->Nodes = NULL;
+  this->CellIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->vtkBVHCellLocator::FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  delete [] this->Nodes;
+  this->Nodes = NULL;
+  delete [] this->CellIds;
+  this->CellIds = NULL;
+  this->NumberOfNodes = 0;
+  this->Depth = 0;
+  this->Superclass::FreeCellBounds();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkBVHCellLocator::GetActualMemorySize()
+{
+  unsigned long size = this->Superclass::GetActualMemorySize();
+  if (this->Nodes)
+    {
+    size_t bytes = this->NumberOfNodes * sizeof(vtkBVHCellLocatorNode) +
+      this->DataSet->GetNumberOfCells() * sizeof(vtkIdType);
+    size += static_cast<unsigned long>((bytes + 1023) / 1024);
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorIfNeeded()
+{
+  if (this->LazyEvaluation)
+    {
+    if (!this->Nodes || (this->MTime > this->BuildTime))
+      {
+      this->Modified();
+      vtkDebugMacro(<< "Forcing BuildLocator");
+      this->ForceBuildLocator();
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::ForceBuildLocator()
+{
+  // don't rebuild if build time is newer than modified and dataset
+  // modified time
+  if ( this->Nodes && (this->BuildTime > this->MTime) &&
+       (this->BuildTime > this->DataSet->GetMTime()) )
+    {
+    return;
+    }
+  // don't rebuild if UseExistingSearchStructure is ON and a tree already
+  // exists
+  if ( this->Nodes && this->UseExistingSearchStructure )
+    {
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
+    return;
+    }
+  this->BuildLocatorInternal();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  if (this->LazyEvaluation)
+    {
+    return;
+    }
+  this->ForceBuildLocator();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocatorInternal()
+{
+  this->FreeSearchStructure();
+  vtkIdType numCells;
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+    {
+    vtkErrorMacro( << " No Cells in the data set\n");
+    return;
+    }
+
+  // The bounds are kept as the cell bounds cache when requested.
+  this->DataSet->PrepareForThreadedAccess();
+  double (*bounds)[6] = new double [numCells][6];
+  double (*centers)[3] = new double [numCells][3];
+  this->CellIds = new vtkIdType[numCells];
+  vtkBVHCellLocatorCellBounds cellBounds;
+  cellBounds.DataSet = this->DataSet;
+  cellBounds.Bounds = bounds;
+  cellBounds.Centers = centers;
+  cellBounds.CellIds = this->CellIds;
+  vtkSMPTools::For(0, numCells, 1000, cellBounds);
+
+  vtkBVHCellLocatorBuilder builder;
+  builder.Bounds = bounds;
+  builder.Centers = centers;
+  builder.CellIds = this->CellIds;
+  builder.NumberOfBins = this->NumberOfBins;
+  builder.MaxCellsPerLeaf =
+    (this->NumberOfCellsPerNode > 0 ? this->NumberOfCellsPerNode : 1);
+
+  // With several threads, the first levels are split serially until the
+  // ranges are small enough to give each thread a few subtrees, which are
+  // then built in parallel and appended to the node array.
+  std::vector<vtkBVHCellLocatorNode> nodes(1);
+  int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (numThreads > 1 && numCells > 8192)
+    {
+    std::vector<vtkBVHCellLocatorTask> tasks;
+    vtkIdType taskSize = numCells / (8 * numThreads);
+    this->Depth = builder.Build(nodes, 0, 0, numCells, 0,
+                                (taskSize > 1024 ? taskSize : 1024), &tasks);
+    vtkBVHCellLocatorBuildTasks buildTasks;
+    buildTasks.Builder = &builder;
+    buildTasks.Tasks = &tasks;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, buildTasks);
+
+    // The subtree root replaces the task node, the other nodes are
+    // appended and the child offsets relocated accordingly.
+    for (size_t i=0; i < tasks.size(); i++)
+      {
+      std::vector<vtkBVHCellLocatorNode> &sub = tasks[i].Nodes;
+      vtkIdType base = static_cast<vtkIdType>(nodes.size()) - 1;
+      for (size_t j=0; j < sub.size(); j++)
+        {
+        if (sub[j].Count == 0)
+          {
+          sub[j].Offset += base;
+          }
+        }
+      nodes[tasks[i].NodeId] = sub[0];
+      nodes.insert(nodes.end(), sub.begin() + 1, sub.end());
+      this->Depth = (tasks[i].MaxDepth > this->Depth ?
+                     tasks[i].MaxDepth : this->Depth);
+      std::vector<vtkBVHCellLocatorNode>().swap(sub);
+      }
+    }
+  else
+    {
+    this->Depth = builder.Build(nodes, 0, 0, numCells, 0, 0, NULL);
+    }
+
+  this->NumberOfNodes = static_cast<vtkIdType>(nodes.size());
+  this->Nodes = new vtkBVHCellLocatorNode[this->NumberOfNodes];
+  std::copy(nodes.begin(), nodes.end(), this->Nodes);
+  delete [] centers;
+  if (this->CacheCellBounds)
+    {
+    this->CellBounds = bounds;
+    }
+  else
+    {
+    delete [] bounds;
+    }
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(double x[3], double vtkNotUsed(tol2),
+                                      vtkGenericCell *cell, double pcoords[3],
+                                      double *weights)
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Nodes)
+    {
+    return -1;
+    }
+
+  double closestPoint[3], dist2, cellBounds[6];
+  int subId;
+  vtkIdType stack[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+    {
+    const vtkBVHCellLocatorNode &node = this->Nodes[stack[--top]];
+    if (!vtkBVHContains(node.Bounds, x))
+      {
+      continue;
+      }
+    if (node.Count == 0)
+      {
+      stack[top++] = node.Offset + 1;
+      stack[top++] = node.Offset;
+      continue;
+      }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.Count; i++)
+      {
+      vtkIdType cellId = this->CellIds[i];
+      if (this->CellBounds)
+        {
+        if (!vtkBVHContains(this->CellBounds[cellId], x))
+          {
+          continue;
+          }
+        }
+      else if (node.Count > 1)
+        {
+        this->DataSet->GetCellBounds(cellId, cellBounds);
+        if (!vtkBVHContains(cellBounds, x))
+          {
+          continue;
+          }
+        }
+      this->DataSet->GetCell(cellId, cell);
+      if (cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2,
+                                 weights) == 1)
+        {
+        return cellId;
+        }
+      }
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(double p1[3], double p2[3],
+                                         double tol, double& t, double x[3],
+                                         double pcoords[3], int &subId,
+                                         vtkIdType &cellId,
+                                         vtkGenericCell *cell)
+{
+  this->BuildLocatorIfNeeded();
+  cellId = -1;
+  if (!this->Nodes)
+    {
+    return 0;
+    }
+
+  double dir[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+  double tmin = 0.0, tmax = 1.0;
+  if (!vtkBVHClipLine(this->Nodes[0].Bounds, p1, dir, tol, tmin, tmax))
+    {
+    return 0;
+    }
+
+  // Front to back traversal: the nearer child is visited first and the
+  // nodes entered beyond the closest hit found so far are skipped.
+  vtkIdType stack[VTK_BVH_STACK_SIZE];
+  double entry[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top] = 0;
+  entry[top++] = tmin;
+  double bestT = VTK_DOUBLE_MAX, tHit, xHit[3], pHit[3];
+  int sHit;
+  vtkIdType fetched = -1;
+  while (top > 0)
+    {
+    --top;
+    if (entry[top] > bestT)
+      {
+      continue;
+      }
+    const vtkBVHCellLocatorNode &node = this->Nodes[stack[top]];
+    if (node.Count == 0)
+      {
+      double t0[2] = { 0.0, 0.0 }, t1[2] = { 1.0, 1.0 };
+      bool hit[2];
+      for (int c=0; c < 2; c++)
+        {
+        hit[c] = vtkBVHClipLine(this->Nodes[node.Offset + c].Bounds, p1,
+                                dir, tol, t0[c], t1[c]) && t0[c] <= bestT;
+        }
+      int nearer = (hit[1] && (!hit[0] || t0[1] < t0[0]));
+      if (hit[1-nearer])
+        {
+        stack[top] = node.Offset + 1 - nearer;
+        entry[top++] = t0[1-nearer];
+        }
+      if (hit[nearer])
+        {
+        stack[top] = node.Offset + nearer;
+        entry[top++] = t0[nearer];
+        }
+      continue;
+      }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.Count; i++)
+      {
+      vtkIdType id = this->CellIds[i];
+      if (this->CellBounds)
+        {
+        double c0 = 0.0, c1 = 1.0;
+        if (!vtkBVHClipLine(this->CellBounds[id], p1, dir, tol, c0, c1) ||
+            c0 > bestT)
+          {
+          continue;
+          }
+        }
+      this->DataSet->GetCell(id, cell);
+      fetched = id;
+      if (cell->IntersectWithLine(p1, p2, tol, tHit, xHit, pHit, sHit) &&
+          tHit < bestT)
+        {
+        bestT = tHit;
+        cellId = id;
+        t = tHit;
+        subId = sHit;
+        x[0] = xHit[0]; x[1] = xHit[1]; x[2] = xHit[2];
+        pcoords[0] = pHit[0]; pcoords[1] = pHit[1]; pcoords[2] = pHit[2];
+        }
+      }
+    }
+
+  if (cellId < 0)
+    {
+    return 0;
+    }
+  if (fetched != cellId)
+    {
+    this->DataSet->GetCell(cellId, cell);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindClosestPoint(double x[3], double closestPoint[3],
+                                         vtkGenericCell *cell,
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2)
+{
+  int inside;
+  if (!this->FindClosestPointWithinRadius(x, VTK_DOUBLE_MAX, closestPoint,
+                                          cell, cellId, subId, dist2, inside))
+    {
+    cellId = -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(
+  double x[3], double radius, double closestPoint[3], vtkGenericCell *cell,
+  vtkIdType &cellId, int &subId, double& dist2, int &inside)
+{
+  this->BuildLocatorIfNeeded();
+  cellId = -1;
+  if (!this->Nodes)
+    {
+    return 0;
+    }
+
+  // Nearest first traversal, pruning the nodes farther than the closest
+  // point found so far.
+  double bestDist2 = (radius < 1.0e150 ? radius*radius : VTK_DOUBLE_MAX);
+  double point[3], pcoords[3], d2, cellBounds[6];
+  double weightsArray[8];
+  std::vector<double> weightsVector;
+  double *weights = weightsArray;
+  int numWeights = 8, sub, status;
+  vtkIdType fetched = -1;
+  vtkIdType stack[VTK_BVH_STACK_SIZE];
+  double dist[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top] = 0;
+  dist[top++] = vtkBVHDistance2(this->Nodes[0].Bounds, x);
+  while (top > 0)
+    {
+    --top;
+    if (dist[top] > bestDist2)
+      {
+      continue;
+      }
+    const vtkBVHCellLocatorNode &node = this->Nodes[stack[top]];
+    if (node.Count == 0)
+      {
+      double d[2];
+      d[0] = vtkBVHDistance2(this->Nodes[node.Offset].Bounds, x);
+      d[1] = vtkBVHDistance2(this->Nodes[node.Offset + 1].Bounds, x);
+      int nearer = (d[1] < d[0]);
+      if (d[1-nearer] <= bestDist2)
+        {
+        stack[top] = node.Offset + 1 - nearer;
+        dist[top++] = d[1-nearer];
+        }
+      if (d[nearer] <= bestDist2)
+        {
+        stack[top] = node.Offset + nearer;
+        dist[top++] = d[nearer];
+        }
+      continue;
+      }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.Count; i++)
+      {
+      vtkIdType id = this->CellIds[i];
+      double *b = cellBounds;
+      if (this->CellBounds)
+        {
+        b = this->CellBounds[id];
+        }
+      else
+        {
+        this->DataSet->GetCellBounds(id, cellBounds);
+        }
+      if (vtkBVHDistance2(b, x) > bestDist2)
+        {
+        continue;
+        }
+      this->DataSet->GetCell(id, cell);
+      fetched = id;
+      int numPts = cell->GetNumberOfPoints();
+      if (numPts > numWeights)
+        {
+        weightsVector.resize(2*numPts);
+        weights = &weightsVector[0];
+        numWeights = 2*numPts;
+        }
+      status = cell->EvaluatePosition(x, point, sub, pcoords, d2, weights);
+      if (status != -1 && (d2 < bestDist2 || (cellId < 0 && d2 <= bestDist2)))
+        {
+        bestDist2 = d2;
+        cellId = id;
+        subId = sub;
+        inside = status;
+        closestPoint[0] = point[0];
+        closestPoint[1] = point[1];
+        closestPoint[2] = point[2];
+        }
+      }
+    }
+
+  if (cellId < 0)
+    {
+    return 0;
+    }
+  dist2 = bestDist2;
+  if (fetched != cellId)
+    {
+    this->DataSet->GetCell(cellId, cell);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Nodes)
+    {
+    return;
+    }
+
+  double cellBounds[6];
+  vtkIdType stack[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+    {
+    const vtkBVHCellLocatorNode &node = this->Nodes[stack[--top]];
+    if (!vtkBVHOverlaps(node.Bounds, bbox))
+      {
+      continue;
+      }
+    if (node.Count == 0)
+      {
+      stack[top++] = node.Offset + 1;
+      stack[top++] = node.Offset;
+      continue;
+      }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.Count; i++)
+      {
+      vtkIdType cellId = this->CellIds[i];
+      double *b = cellBounds;
+      if (this->CellBounds)
+        {
+        b = this->CellBounds[cellId];
+        }
+      else
+        {
+        this->DataSet->GetCellBounds(cellId, cellBounds);
+        }
+      if (vtkBVHOverlaps(b, bbox))
+        {
+        cells->InsertNextId(cellId);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkBVHCellLocator::PrepareForThreadedIntersectWithLine()
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Nodes)
+    {
+    return 0;
+    }
+  this->DataSet->PrepareForThreadedAccess();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData *pd)
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Nodes)
+    {
+    vtkErrorMacro(<<"Can't build representation...no data!");
+    return;
+    }
+
+  vtkPoints *pts = vtkPoints::New();
+  vtkCellArray *lines = vtkCellArray::New();
+  vtkIdType stack[VTK_BVH_STACK_SIZE];
+  int depth[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top] = 0;
+  depth[top++] = 0;
+  while (top > 0)
+    {
+    --top;
+    const vtkBVHCellLocatorNode &node = this->Nodes[stack[top]];
+    int d = depth[top];
+    if (d == level || (level == -1 && node.Count > 0))
+      {
+      vtkBVHCellLocatorAddBox(pts, lines, node.Bounds);
+      }
+    else if (node.Count == 0 && (level == -1 || d < level))
+      {
+      stack[top] = node.Offset + 1;
+      depth[top++] = d + 1;
+      stack[top] = node.Offset;
+      depth[top++] = d + 1;
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetLines(lines);
+  lines->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Bins: " << this->NumberOfBins << "\n";
+  os << indent << "Number Of Nodes: " << this->NumberOfNodes << "\n";
+  os << indent << "Depth: " << this->Depth << "\n";
+}
@@ -0,0 +1,221 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkBVHCellLocator - cell locator using a bounding volume hierarchy
+// .SECTION Description
+// vtkBVHCellLocator locates cells with a binary tree of axis aligned
+// bounding boxes (a bounding volume hierarchy).  Each node is split where
+// the surface area heuristic (SAH) estimates the cheapest traversal: the
+// cell centers are sorted into bins along each axis and the split between
+// two bins minimizing the area of the children boxes weighted by their
+// number of cells is chosen.  Unlike the uniform subdivision of
+// vtkCellLocator, the tree adapts to the cell sizes, so that it stays
+// shallow and balanced on strongly graded meshes.
+//
+// The tree is stored as a flat array of nodes, the two children of a node
+// next to each other, and the cell ids as a single array in which each
+// leaf owns a range.  The bounds and the centers of the cells are computed
+// in parallel, and the subtrees below the first levels are built in
+// parallel too (see vtkSMPTools).
+//
+// Since the search structure does not change once built, FindCell(),
+// IntersectWithLine() and FindClosestPoint() taking a vtkGenericCell are
+// thread safe after BuildLocator() and vtkDataSet::PrepareForThreadedAccess()
+// were called from a single thread, and IntersectWithLines() processes
+// the lines in parallel.
+//
+// .SECTION See Also
+// vtkLocator vtkCellLocator vtkCellTreeLocator vtkModifiedBSPTree
+// vtkSMPTools
+
+#ifndef __vtkBVHCellLocator_h
+#define __vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+
+class vtkBVHCellLocatorNode;
+class vtkIdList;
+
+class VTK_FILTERING_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  vtkTypeMacro(vtkBVHCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Construct with at most 8 cells per leaf and 16 bins.
+  static vtkBVHCellLocator *New();
+
+  // Description:
+  // Specify the number of bins along each axis used to evaluate the
+  // surface area heuristic.  More bins find better splits at the price of
+  // a slower build.
+  vtkSetClampMacro(NumberOfBins,int,2,256);
+  vtkGetMacro(NumberOfBins,int);
+
+  // Description:
+  // Find the cell containing the point x, within the squared tolerance
+  // tol2 of the cell.  Returns the cellId if inside or -1 if not; the cell
+  // parameters are copied into the supplied variables.
+  virtual vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                             double pcoords[3], double *weights);
+
+  // Description:
+  // Return intersection point (if any) AND the cell which was intersected by
+  // the finite line. The cell is returned as a cell id and as a generic cell.
+  // The intersection closest to p1 is returned.
+  virtual int IntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell);
+
+  // Description:
+  // Return the closest point and the cell which is closest to the point x.
+  // The closest point is somewhere on a cell, it need not be one of the
+  // vertices of the cell.  The nodes are visited nearest first and pruned
+  // with the distance to their bounding box.
+  virtual void FindClosestPoint(
+    double x[3], double closestPoint[3], vtkGenericCell *cell,
+    vtkIdType &cellId, int &subId, double& dist2);
+
+  // Description:
+  // Return the closest point within a specified radius and the cell which
+  // is closest to the point x.  Returns 1 if a point is found within the
+  // radius, 0 otherwise.  inside is set to the value returned by
+  // EvaluatePosition() for the closest cell.
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3],
+    vtkGenericCell *cell, vtkIdType &cellId,
+    int &subId, double& dist2, int &inside);
+
+  // Description:
+  // Return a list of unique cell ids whose bounds intersect the given
+  // bounding box.  The user must provide the vtkIdList to populate.
+  virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+
+//BTX
+  /*
+    if the borland compiler is ever removed, we can use these declarations
+    instead of reimplementaing the calls in this subclass
+    using vtkAbstractCellLocator::IntersectWithLine;
+    using vtkAbstractCellLocator::FindClosestPoint;
+    using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+    using vtkAbstractCellLocator::FindCell;
+  */
+//ETX
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual int IntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId)
+    {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords,
+                                               subId);
+    }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual int IntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId)
+    {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords,
+                                               subId, cellId);
+    }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual int IntersectWithLine(
+    const double p1[3], const double p2[3],
+    vtkPoints *points, vtkIdList *cellIds)
+    {
+    return this->Superclass::IntersectWithLine(p1, p2, points, cellIds);
+    }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual void FindClosestPoint(
+    double x[3], double closestPoint[3],
+    vtkIdType &cellId, int &subId, double& dist2)
+    {
+    this->Superclass::FindClosestPoint(x, closestPoint, cellId, subId, dist2);
+    }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3],
+    vtkIdType &cellId, int &subId, double& dist2)
+    {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cellId, subId, dist2);
+    }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double x[3], double radius, double closestPoint[3],
+    vtkGenericCell *cell, vtkIdType &cellId, int &subId, double& dist2)
+    {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cell, cellId, subId, dist2);
+    }
+
+  // Description:
+  // reimplemented from vtkAbstractCellLocator to support bad compilers
+  virtual vtkIdType FindCell(double x[3])
+    { return this->Superclass::FindCell(x); }
+
+  // Description:
+  // Return the number of nodes of the tree and its depth, once built.
+  vtkIdType GetNumberOfNodes() { return this->NumberOfNodes; }
+  int GetDepth() { return this->Depth; }
+
+  // Description:
+  // Satisfy vtkLocator abstract interface.  GenerateRepresentation()
+  // outputs the boxes of the nodes at the given level as lines, or the
+  // boxes of all the leaves if level is -1.
+  virtual void FreeSearchStructure();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+  virtual void BuildLocatorInternal();
+  virtual void BuildLocatorIfNeeded();
+  virtual void ForceBuildLocator();
+  virtual void BuildLocator();
+
+  // Description:
+  // Return the memory in kilobytes used by the nodes, the cell ids and
+  // the cached cell bounds.
+  virtual unsigned long GetActualMemorySize();
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator();
+
+  // Description:
+  // The queries only read the tree, so the lines of IntersectWithLines()
+  // may be processed in parallel.
+  virtual int PrepareForThreadedIntersectWithLine();
+
+  int NumberOfBins;
+  int Depth;
+  vtkIdType NumberOfNodes;
+  vtkBVHCellLocatorNode *Nodes;
+  vtkIdType *CellIds;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&);  // Not implemented.
+  void operator=(const vtkBVHCellLocator&);  // Not implemented.
+};
+
+#endif
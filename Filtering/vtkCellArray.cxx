@@ -21,6 +21,10 @@ vtkStandardNewMacro(vtkCellArray);
 vtkCellArray::vtkCellArray()
 {
   this->Ia = vtkIdTypeArray::New();
+  this->Offsets = NULL;
+  this->Ia32 = NULL;
+  this->CellBuffer = NULL;
+  this->CellBufferSize = 0;
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
@@ -35,25 +39,264 @@ void vtkCellArray::DeepCopy (vtkCellArray *ca)
     return;
     }
 
-  this->Ia->DeepCopy(ca->Ia);
+  if ( ca->Ia32 )
+    {
+    if ( !this->Ia32 )
+      {
+      this->Ia32 = vtkIntArray::New();
+      }
+    this->Ia32->DeepCopy(ca->Ia32);
+    this->Ia->Initialize();
+    }
+  else
+    {
+    if ( this->Ia32 )
+      {
+      this->Ia32->Delete();
+      this->Ia32 = NULL;
+      }
+    this->Ia->DeepCopy(ca->Ia);
+    }
   this->NumberOfCells = ca->NumberOfCells;
   this->InsertLocation = ca->InsertLocation;
   this->TraversalLocation = ca->TraversalLocation;
+  if ( ca->Offsets )
+    {
+    if ( !this->Offsets )
+      {
+      this->Offsets = vtkIdTypeArray::New();
+      }
+    this->Offsets->DeepCopy(ca->Offsets);
+    }
+  else
+    {
+    this->DeleteOffsets();
+    }
 }
 
 //----------------------------------------------------------------------------
 vtkCellArray::~vtkCellArray()
 {
   this->Ia->Delete();
+  this->DeleteOffsets();
+  if ( this->Ia32 )
+    {
+    this->Ia32->Delete();
+    }
+  delete [] this->CellBuffer;
 }
 
 //----------------------------------------------------------------------------
 void vtkCellArray::Initialize()
 {
   this->Ia->Initialize();
+  if ( this->Ia32 )
+    {
+    this->Ia32->Initialize();
+    }
   this->NumberOfCells = 0;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->DeleteOffsets();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetNumberOfCells(vtkIdType numCells)
+{
+  if ( this->NumberOfCells != numCells )
+    {
+    this->NumberOfCells = numCells;
+    this->DeleteOffsets();
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::SetUse32BitStorage(int use)
+{
+  if ( (this->Ia32 != NULL) == (use != 0) )
+    {
+    return;
+    }
+
+#if VTK_SIZEOF_ID_TYPE == VTK_SIZEOF_INT
+  // vtkIdType is already 32 bits.
+  return;
+#else
+  vtkIdType i, numEntries;
+  if ( use )
+    {
+    numEntries = this->Ia->GetMaxId() + 1;
+    const vtkIdType *ia = this->Ia->GetPointer(0);
+    for (i=0; i < numEntries; i++)
+      {
+      if ( !vtkCellArray::FitsIn32Bits(ia[i]) )
+        {
+        vtkWarningMacro(<< "Ids do not fit in 32 bits, keeping vtkIdType "
+                        "storage.");
+        return;
+        }
+      }
+    this->Ia32 = vtkIntArray::New();
+    if ( numEntries > 0 )
+      {
+      int *ia32 = this->Ia32->WritePointer(0, numEntries);
+      for (i=0; i < numEntries; i++)
+        {
+        ia32[i] = static_cast<int>(ia[i]);
+        }
+      }
+    // The array may be shared, see SetCells().
+    this->Ia->Delete();
+    this->Ia = vtkIdTypeArray::New();
+    }
+  else
+    {
+    numEntries = this->Ia32->GetMaxId() + 1;
+    if ( numEntries > 0 )
+      {
+      const int *ia32 = this->Ia32->GetPointer(0);
+      vtkIdType *ia = this->Ia->WritePointer(0, numEntries);
+      for (i=0; i < numEntries; i++)
+        {
+        ia[i] = ia32[i];
+        }
+      }
+    this->Ia32->Delete();
+    this->Ia32 = NULL;
+    }
+  this->Modified();
+#endif
+}
+
+//----------------------------------------------------------------------------
+vtkIdType *vtkCellArray::DecodeCell(vtkIdType loc, vtkIdType &npts)
+{
+  const int *ia32 = this->Ia32->GetPointer(loc);
+  npts = ia32[0];
+  if ( npts > this->CellBufferSize )
+    {
+    delete [] this->CellBuffer;
+    this->CellBufferSize = (npts > 2*this->CellBufferSize ? npts :
+                            2*this->CellBufferSize);
+    this->CellBuffer = new vtkIdType[this->CellBufferSize];
+    }
+  for (vtkIdType i=0; i < npts; i++)
+    {
+    this->CellBuffer[i] = ia32[i+1];
+    }
+  return this->CellBuffer;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::DecodeCell(vtkIdType loc, vtkIdType &npts,
+                              vtkIdType* &pts, vtkIdList *buffer)
+{
+  const int *ia32 = this->Ia32->GetPointer(loc);
+  npts = ia32[0];
+  buffer->SetNumberOfIds(npts);
+  pts = buffer->GetPointer(0);
+  for (vtkIdType i=0; i < npts; i++)
+    {
+    pts[i] = ia32[i+1];
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::ReportNoIdTypeStorage(const char *method)
+{
+  vtkErrorMacro(<< method << " needs vtkIdType storage but Use32BitStorage "
+                "is on: traverse the cells with GetNextCell(loc,npts,pts,"
+                "buffer) or turn Use32BitStorage off first.");
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellArray::InsertNextCell32(vtkIdType npts, const vtkIdType* pts)
+{
+  vtkIdType i;
+  for (i=0; i < npts; i++)
+    {
+    if ( !vtkCellArray::FitsIn32Bits(pts[i]) )
+      {
+      this->SetUse32BitStorage(0);
+      return this->InsertNextCell(npts, pts);
+      }
+    }
+
+  vtkIdType loc = this->Ia32->GetMaxId() + 1;
+  if ( this->Offsets )
+    {
+    this->Offsets->InsertNextValue(loc);
+    }
+  int *ptr = this->Ia32->WritePointer(loc, npts+1);
+  *ptr++ = static_cast<int>(npts);
+  for (i=0; i < npts; i++)
+    {
+    *ptr++ = static_cast<int>(pts[i]);
+    }
+
+  this->NumberOfCells++;
+  this->InsertLocation += npts + 1;
+
+  return this->NumberOfCells - 1;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+static void vtkCellArrayBuildOffsets(const T *ia, vtkIdType maxId,
+                                     vtkIdType numCells, vtkIdType *offsets)
+{
+  vtkIdType loc = 0;
+  for (vtkIdType cellId=0; cellId < numCells && loc <= maxId; cellId++)
+    {
+    offsets[cellId] = loc;
+    loc += ia[loc] + 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::BuildOffsets()
+{
+  if ( !this->Offsets )
+    {
+    this->Offsets = vtkIdTypeArray::New();
+    }
+  vtkIdType *offsets = this->Offsets->WritePointer(0, this->NumberOfCells);
+  if ( this->Ia32 )
+    {
+    vtkCellArrayBuildOffsets(this->Ia32->GetPointer(0),
+                             this->Ia32->GetMaxId(), this->NumberOfCells,
+                             offsets);
+    }
+  else
+    {
+    vtkCellArrayBuildOffsets(this->Ia->GetPointer(0), this->Ia->GetMaxId(),
+                             this->NumberOfCells, offsets);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::DeleteOffsets()
+{
+  if ( this->Offsets )
+    {
+    this->Offsets->Delete();
+    this->Offsets = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellArray::Squeeze()
+{
+  this->Ia->Squeeze();
+  if ( this->Ia32 )
+    {
+    this->Ia32->Squeeze();
+    }
+  if ( this->Offsets )
+    {
+    this->Offsets->Squeeze();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -63,6 +306,18 @@ int vtkCellArray::GetMaxCellSize()
 {
   int i, npts=0, maxSize=0;
 
+  if ( this->Ia32 )
+    {
+    for (i=0; i<this->Ia32->GetMaxId(); i+=(npts+1))
+      {
+      if ( (npts=this->Ia32->GetValue(i)) > maxSize )
+        {
+        maxSize = npts;
+        }
+      }
+    return maxSize;
+    }
+
   for (i=0; i<this->Ia->GetMaxId(); i+=(npts+1))
     {
     if ( (npts=this->Ia->GetValue(i)) > maxSize )
@@ -83,17 +338,34 @@ void vtkCellArray::SetCells(vtkIdType ncells, vtkIdTypeArray *cells)
     this->Ia->Delete();
     this->Ia = cells;
     this->Ia->Register(this);
+    if ( this->Ia32 )
+      {
+      // Convert the given list, which is left untouched.
+      this->Ia32->Delete();
+      this->Ia32 = NULL;
+      this->SetUse32BitStorage(1);
+      }
 
     this->NumberOfCells = ncells;
     this->InsertLocation = cells->GetMaxId() + 1;
     this->TraversalLocation = 0;
+    this->DeleteOffsets();
     }
 }
 
 //----------------------------------------------------------------------------
 unsigned long vtkCellArray::GetActualMemorySize()
 {
-  return this->Ia->GetActualMemorySize();
+  unsigned long size = this->Ia->GetActualMemorySize();
+  if ( this->Ia32 )
+    {
+    size += this->Ia32->GetActualMemorySize();
+    }
+  if ( this->Offsets )
+    {
+    size += this->Offsets->GetActualMemorySize();
+    }
+  return size;
 }
 
 //----------------------------------------------------------------------------
@@ -115,6 +387,17 @@ int vtkCellArray::GetNextCell(vtkIdList *pts)
 //----------------------------------------------------------------------------
 void vtkCellArray::GetCell(vtkIdType loc, vtkIdList *pts)
 {
+  if ( this->Ia32 )
+    {
+    int npts32 = this->Ia32->GetValue(loc++);
+    const int *ppts32 = this->Ia32->GetPointer(loc);
+    pts->SetNumberOfIds(npts32);
+    for (int i = 0; i < npts32; i++)
+      {
+      pts->SetId(i, ppts32[i]);
+      }
+    return;
+    }
   vtkIdType npts = this->Ia->GetValue(loc++);
   vtkIdType *ppts = this->Ia->GetPointer(loc);
   pts->SetNumberOfIds(npts);
@@ -132,4 +415,7 @@ void vtkCellArray::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Cells: " << this->NumberOfCells << endl;
   os << indent << "Insert Location: " << this->InsertLocation << endl;
   os << indent << "Traversal Location: " << this->TraversalLocation << endl;
+  os << indent << "Offsets: " << (this->Offsets ? "Built" : "None") << endl;
+  os << indent << "Use 32 Bit Storage: "
+     << (this->Ia32 ? "On" : "Off") << endl;
 }
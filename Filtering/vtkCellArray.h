@@ -26,6 +26,23 @@
 // using the vtkCellTypes and vtkCellLinks objects to extend the definition of
 // the data structure.
 //
+// Alternatively, the cell array can keep an offsets array giving the
+// location of each cell in the connectivity list: see BuildOffsets().  It
+// gives O(1) access to the points of any cell with GetCellAtId() and, as
+// the traversal state is then held by the caller, lets several threads
+// read the cells concurrently.  Once built, the offsets are kept up to
+// date by the InsertNextCell() methods.
+//
+// On builds with 64 bit ids the connectivity list can be stored with 32
+// bit integers, which halves its memory: see SetUse32BitStorage().  The
+// methods returning a vtkIdType pointer to the points of a cell then
+// decode the cell into a buffer shared by all callers, which holds one
+// cell at a time and must not be used from several threads: use the
+// versions taking a vtkIdList, or GetCellSize() and GetCellPointId(),
+// instead.  GetPointer() and GetData() have no vtkIdType list to return
+// and fail: traverse the cells with GetNextCell(loc,npts,pts,buffer)
+// instead, or turn the option off first.
+//
 // .SECTION See Also
 // vtkCellTypes vtkCellLinks
 
@@ -35,6 +52,7 @@
 #include "vtkObject.h"
 
 #include "vtkIdTypeArray.h" // Needed for inline methods
+#include "vtkIntArray.h" // Needed for inline methods
 #include "vtkCell.h" // Needed for inline methods
 
 class VTK_FILTERING_EXPORT vtkCellArray : public vtkObject
@@ -50,7 +68,8 @@ public:
   // Description:
   // Allocate memory and set the size to extend by.
   int Allocate(const vtkIdType sz, const int ext=1000)
-    {return this->Ia->Allocate(sz,ext);}
+    {return this->Ia32 ? this->Ia32->Allocate(sz,ext) :
+       this->Ia->Allocate(sz,ext);}
 
   // Description:
   // Free any memory and reset to an empty state.
@@ -62,8 +81,10 @@ public:
 
   // Description:
   // Set the number of cells in the array.
-  // DO NOT do any kind of allocation, advanced use only.
-  vtkSetMacro(NumberOfCells, vtkIdType);
+  // DO NOT do any kind of allocation, advanced use only.  As the
+  // connectivity list is assumed to have been modified directly, the
+  // offsets are deleted.
+  void SetNumberOfCells(vtkIdType numCells);
 
   // Description:
   // Utility routines help manage memory of cell array. EstimateSize()
@@ -92,17 +113,87 @@ public:
   // is encountered, 0 is returned.
   int GetNextCell(vtkIdList *pts);
 
+  // Description:
+  // A thread safe version of GetNextCell(): the traversal location is held
+  // by the caller in loc, which must be set to 0 to start the traversal.
+  int GetNextCell(vtkIdType& loc, vtkIdType& npts, vtkIdType* &pts);
+
+  // Description:
+  // The same traversal, with the points of the cell decoded into the given
+  // buffer when Use32BitStorage is on, so that several threads, each with
+  // its own buffer, may traverse the cells at once.  Otherwise pts points
+  // into the connectivity list and the buffer is not used.
+  int GetNextCell(vtkIdType& loc, vtkIdType& npts, vtkIdType* &pts,
+                  vtkIdList *buffer);
+
+  // Description:
+  // Build the offsets array: the location of each cell in the connectivity
+  // list.  Once built, the offsets are maintained by the InsertNextCell()
+  // methods; they are deleted by the methods that replace the connectivity
+  // list (SetCells(), WritePointer(), SetNumberOfCells()) or by
+  // DeleteOffsets().  The offsets cost one id per cell.
+  void BuildOffsets();
+  void DeleteOffsets();
+
+  // Description:
+  // Return 1 if the offsets array is available.
+  int HasOffsets()
+    {return this->Offsets != 0;}
+
+  // Description:
+  // Return the offsets array, or NULL if BuildOffsets() has not been called.
+  vtkIdTypeArray* GetOffsets()
+    {return this->Offsets;}
+
+  // Description:
+  // Return the location in the connectivity list of the given cell, for use
+  // with GetCell(loc,...).  The offsets are built if needed.
+  vtkIdType GetCellLocation(vtkIdType cellId);
+
+  // Description:
+  // Random access to the points of a cell in O(1).  The offsets are built
+  // on the first call if needed: call BuildOffsets() beforehand when the
+  // cells are accessed from several threads.  These methods are then
+  // thread safe as long as the cell array is not modified, except for the
+  // first one with Use32BitStorage on.  The third one decodes the cell
+  // into the given buffer in that case, and otherwise returns a pointer
+  // into the connectivity list like the first one.
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts);
+  void GetCellAtId(vtkIdType cellId, vtkIdList* pts);
+  void GetCellAtId(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts,
+                   vtkIdList *buffer);
+
+  // Description:
+  // Store the connectivity list with 32 bit integers instead of vtkIdType,
+  // halving its memory on builds with VTK_USE_64BIT_IDS (the option has no
+  // effect otherwise).  The list is only converted if all its entries fit
+  // in 32 bits, and it is converted back automatically when a larger id is
+  // inserted.  The vtkIdType API keeps working: the methods returning a
+  // pointer to the points of a cell (GetNextCell(), GetCell(),
+  // GetCellAtId()) then copy them to an internal buffer that is valid until
+  // the next such call, which makes them unsafe to call from several
+  // threads; use the vtkIdList or buffer versions instead.  GetPointer()
+  // and GetData() give access to the vtkIdType storage, which is empty:
+  // they report an error and return NULL rather than doubling the memory
+  // of the list behind the caller's back.  WritePointer() replaces the
+  // list with vtkIdType storage.  GetActualMemorySize() reports the
+  // memory of either storage.
+  void SetUse32BitStorage(int use);
+  int GetUse32BitStorage()
+    {return this->Ia32 != 0;}
+  vtkBooleanMacro(Use32BitStorage, int);
+
   // Description:
   // Get the size of the allocated connectivity array.
   vtkIdType GetSize()
-    {return this->Ia->GetSize();}
+    {return this->Ia32 ? this->Ia32->GetSize() : this->Ia->GetSize();}
 
   // Description:
   // Get the total number of entries (i.e., data values) in the connectivity
   // array. This may be much less than the allocated size (i.e., return value
   // from GetSize().)
   vtkIdType GetNumberOfConnectivityEntries()
-    {return this->Ia->GetMaxId()+1;}
+    {return (this->Ia32 ? this->Ia32->GetMaxId() : this->Ia->GetMaxId())+1;}
 
   // Description:
   // Internal method used to retrieve a cell given an offset into
@@ -114,6 +205,26 @@ public:
   // the internal array.
   void GetCell(vtkIdType loc, vtkIdList* pts);
 
+  // Description:
+  // Internal method used to retrieve a cell given an offset into the
+  // internal array.  With Use32BitStorage on, the points are decoded into
+  // the given buffer and pts points into it, so that several threads, each
+  // with its own buffer, may call this method at once.
+  void GetCell(vtkIdType loc, vtkIdType &npts, vtkIdType* &pts,
+               vtkIdList *buffer);
+
+  // Description:
+  // Return the number of points of the cell at offset loc, and the i-th
+  // point id of this cell.  These never use the internal buffer of the 32
+  // bit storage, so they may be called from several threads.
+  vtkIdType GetCellSize(vtkIdType loc)
+    {return this->Ia32 ? this->Ia32->GetValue(loc) : this->Ia->GetValue(loc);}
+  vtkIdType GetCellPointId(vtkIdType loc, vtkIdType i)
+    {
+    return this->Ia32 ? this->Ia32->GetValue(loc+1+i) :
+      this->Ia->GetValue(loc+1+i);
+    }
+
   // Description:
   // Insert a cell object. Return the cell id of the cell.
   vtkIdType InsertNextCell(vtkCell *cell);
@@ -179,9 +290,17 @@ public:
   int GetMaxCellSize();
 
   // Description:
-  // Get pointer to array of cell data.
+  // Get pointer to array of cell data.  Return NULL, with an error, when
+  // Use32BitStorage is on.
   vtkIdType *GetPointer()
-    {return this->Ia->GetPointer(0);}
+    {
+    if ( this->Ia32 )
+      {
+      this->ReportNoIdTypeStorage("GetPointer()");
+      return NULL;
+      }
+    return this->Ia->GetPointer(0);
+    }
 
   // Description:
   // Get pointer to data array for purpose of direct writes of data. Size is the
@@ -204,9 +323,17 @@ public:
   void DeepCopy(vtkCellArray *ca);
 
   // Description:
-  // Return the underlying data as a data array.
+  // Return the underlying data as a data array.  Return NULL, with an
+  // error, when Use32BitStorage is on.
   vtkIdTypeArray* GetData()
-    {return this->Ia;}
+    {
+    if ( this->Ia32 )
+      {
+      this->ReportNoIdTypeStorage("GetData()");
+      return NULL;
+      }
+    return this->Ia;
+    }
 
   // Description:
   // Reuse list. Reset to initial condition.
@@ -214,8 +341,7 @@ public:
 
   // Description:
   // Reclaim any extra memory.
-  void Squeeze()
-    {this->Ia->Squeeze();}
+  void Squeeze();
 
   // Description:
   // Return the memory in kilobytes consumed by this cell array. Used to
@@ -234,6 +360,22 @@ protected:
   vtkIdType InsertLocation;     //keep track of current insertion point
   vtkIdType TraversalLocation;   //keep track of traversal position
   vtkIdTypeArray *Ia;
+  vtkIdTypeArray *Offsets;      //location of each cell, see BuildOffsets()
+
+  // Connectivity list when Use32BitStorage is on; Ia is then empty.
+  vtkIntArray *Ia32;
+  vtkIdType *CellBuffer;
+  vtkIdType CellBufferSize;
+
+  // Copy the points of the cell at loc from Ia32 to CellBuffer.
+  vtkIdType *DecodeCell(vtkIdType loc, vtkIdType &npts);
+  void DecodeCell(vtkIdType loc, vtkIdType &npts, vtkIdType* &pts,
+                  vtkIdList *buffer);
+  // Report that a raw vtkIdType accessor was called with Use32BitStorage on.
+  void ReportNoIdTypeStorage(const char *method);
+  vtkIdType InsertNextCell32(vtkIdType npts, const vtkIdType* pts);
+  static int FitsIn32Bits(vtkIdType id)
+    {return id >= VTK_INT_MIN && id <= VTK_INT_MAX;}
 
 private:
   vtkCellArray(const vtkCellArray&);  // Not implemented.
@@ -245,7 +387,15 @@ private:
 inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
                                               const vtkIdType* pts)
 {
+  if ( this->Ia32 )
+    {
+    return this->InsertNextCell32(npts, pts);
+    }
   vtkIdType i = this->Ia->GetMaxId() + 1;
+  if ( this->Offsets )
+    {
+    this->Offsets->InsertNextValue(i);
+    }
   vtkIdType *ptr = this->Ia->WritePointer(i, npts+1);
 
   for ( *ptr++ = npts, i = 0; i < npts; i++)
@@ -262,7 +412,12 @@ inline vtkIdType vtkCellArray::InsertNextCell(vtkIdType npts,
 //----------------------------------------------------------------------------
 inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 {
-  this->InsertLocation = this->Ia->InsertNextValue(npts) + 1;
+  this->InsertLocation = (this->Ia32 ? this->Ia32->InsertNextValue(npts) :
+                          this->Ia->InsertNextValue(npts)) + 1;
+  if ( this->Offsets )
+    {
+    this->Offsets->InsertNextValue(this->InsertLocation - 1);
+    }
   this->NumberOfCells++;
 
   return this->NumberOfCells - 1;
@@ -271,12 +426,26 @@ inline vtkIdType vtkCellArray::InsertNextCell(int npts)
 //----------------------------------------------------------------------------
 inline void vtkCellArray::InsertCellPoint(vtkIdType id)
 {
+  if ( this->Ia32 )
+    {
+    if ( vtkCellArray::FitsIn32Bits(id) )
+      {
+      this->Ia32->InsertValue(this->InsertLocation++, static_cast<int>(id));
+      return;
+      }
+    this->SetUse32BitStorage(0);
+    }
   this->Ia->InsertValue(this->InsertLocation++, id);
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellArray::UpdateCellCount(int npts)
 {
+  if ( this->Ia32 )
+    {
+    this->Ia32->SetValue(this->InsertLocation-npts-1, npts);
+    return;
+    }
   this->Ia->SetValue(this->InsertLocation-npts-1, npts);
 }
 
@@ -300,17 +469,55 @@ inline void vtkCellArray::Reset()
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
   this->Ia->Reset();
+  if ( this->Ia32 )
+    {
+    this->Ia32->Reset();
+    }
+  if ( this->Offsets )
+    {
+    this->Offsets->Reset();
+    }
 }
 
 //----------------------------------------------------------------------------
 inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 {
-  if ( this->Ia->GetMaxId() >= 0 &&
-       this->TraversalLocation <= this->Ia->GetMaxId() )
+  return this->GetNextCell(this->TraversalLocation, npts, pts);
+}
+
+//----------------------------------------------------------------------------
+inline int vtkCellArray::GetNextCell(vtkIdType& loc, vtkIdType& npts,
+                                     vtkIdType* &pts)
+{
+  if ( this->Ia32 )
     {
-    npts = this->Ia->GetValue(this->TraversalLocation++);
-    pts = this->Ia->GetPointer(this->TraversalLocation);
-    this->TraversalLocation += npts;
+    if ( loc >= 0 && loc <= this->Ia32->GetMaxId() )
+      {
+      pts = this->DecodeCell(loc, npts);
+      loc += npts + 1;
+      return 1;
+      }
+    }
+  else if ( loc >= 0 && loc <= this->Ia->GetMaxId() )
+    {
+    npts = this->Ia->GetValue(loc++);
+    pts = this->Ia->GetPointer(loc);
+    loc += npts;
+    return 1;
+    }
+  npts=0;
+  pts=0;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+inline int vtkCellArray::GetNextCell(vtkIdType& loc, vtkIdType& npts,
+                                     vtkIdType* &pts, vtkIdList *buffer)
+{
+  if ( loc >= 0 && loc < this->GetNumberOfConnectivityEntries() )
+    {
+    this->GetCell(loc, npts, pts, buffer);
+    loc += npts + 1;
     return 1;
     }
   npts=0;
@@ -322,14 +529,74 @@ inline int vtkCellArray::GetNextCell(vtkIdType& npts, vtkIdType* &pts)
 inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
                                   vtkIdType* &pts)
 {
+  if ( this->Ia32 )
+    {
+    pts = this->DecodeCell(loc, npts);
+    return;
+    }
   npts = this->Ia->GetValue(loc++);
   pts  = this->Ia->GetPointer(loc);
 }
 
+//----------------------------------------------------------------------------
+inline void vtkCellArray::GetCell(vtkIdType loc, vtkIdType &npts,
+                                  vtkIdType* &pts, vtkIdList *buffer)
+{
+  if ( this->Ia32 )
+    {
+    this->DecodeCell(loc, npts, pts, buffer);
+    return;
+    }
+  npts = this->Ia->GetValue(loc++);
+  pts  = this->Ia->GetPointer(loc);
+}
+
+//----------------------------------------------------------------------------
+inline vtkIdType vtkCellArray::GetCellLocation(vtkIdType cellId)
+{
+  if ( !this->Offsets )
+    {
+    this->BuildOffsets();
+    }
+  return this->Offsets->GetValue(cellId);
+}
+
+//----------------------------------------------------------------------------
+inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                                      vtkIdType* &pts)
+{
+  this->GetCell(this->GetCellLocation(cellId), npts, pts);
+}
+
+//----------------------------------------------------------------------------
+inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdList* pts)
+{
+  this->GetCell(this->GetCellLocation(cellId), pts);
+}
+
+//----------------------------------------------------------------------------
+inline void vtkCellArray::GetCellAtId(vtkIdType cellId, vtkIdType &npts,
+                                      vtkIdType* &pts, vtkIdList *buffer)
+{
+  this->GetCell(this->GetCellLocation(cellId), npts, pts, buffer);
+}
+
 //----------------------------------------------------------------------------
 inline void vtkCellArray::ReverseCell(vtkIdType loc)
 {
   int i;
+  if ( this->Ia32 )
+    {
+    int npts32=this->Ia32->GetValue(loc);
+    int *pts32=this->Ia32->GetPointer(loc+1);
+    for (i=0; i < (npts32/2); i++)
+      {
+      int tmp32 = pts32[i];
+      pts32[i] = pts32[npts32-i-1];
+      pts32[npts32-i-1] = tmp32;
+      }
+    return;
+    }
   vtkIdType tmp;
   vtkIdType npts=this->Ia->GetValue(loc);
   vtkIdType *pts=this->Ia->GetPointer(loc+1);
@@ -345,6 +612,23 @@ inline void vtkCellArray::ReverseCell(vtkIdType loc)
 inline void vtkCellArray::ReplaceCell(vtkIdType loc, int npts,
                                       const vtkIdType *pts)
 {
+  if ( this->Ia32 )
+    {
+    int i;
+    for (i=0; i < npts && vtkCellArray::FitsIn32Bits(pts[i]); i++)
+      {
+      }
+    if ( i == npts )
+      {
+      int *oldPts32=this->Ia32->GetPointer(loc+1);
+      for (i=0; i < npts; i++)
+        {
+        oldPts32[i] = static_cast<int>(pts[i]);
+        }
+      return;
+      }
+    this->SetUse32BitStorage(0);
+    }
   vtkIdType *oldPts=this->Ia->GetPointer(loc+1);
   for (int i=0; i < npts; i++)
     {
@@ -359,6 +643,13 @@ inline vtkIdType *vtkCellArray::WritePointer(const vtkIdType ncells,
   this->NumberOfCells = ncells;
   this->InsertLocation = 0;
   this->TraversalLocation = 0;
+  this->DeleteOffsets();
+  if ( this->Ia32 )
+    {
+    // The list is about to be overwritten, there is nothing to convert.
+    this->Ia32->Delete();
+    this->Ia32 = NULL;
+    }
   return this->Ia->WritePointer(0,size);
 }
 
@@ -14,11 +14,17 @@
 =========================================================================*/
 #include "vtkCellLinks.h"
 
+#include "vtkAtomicOperations.h"
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtkstd/algorithm>
 
 vtkStandardNewMacro(vtkCellLinks);
 
@@ -27,6 +33,7 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 {
   static vtkCellLinks::Link linkInit = {0,NULL};
 
+  this->DeleteCompactLinks();
   this->Size = sz;
   if ( this->Array != NULL )
     {
@@ -45,6 +52,9 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 //----------------------------------------------------------------------------
 vtkCellLinks::~vtkCellLinks()
 {
+  this->DeleteCompactLinks();
+  delete [] this->Decoded.cells;
+
   if ( this->Array == NULL )
     {
     return;
@@ -75,6 +85,10 @@ void vtkCellLinks::AllocateLinks(vtkIdType n)
 // Reclaim any unused memory.
 void vtkCellLinks::Squeeze()
 {
+  if ( this->CompactOffsets )
+    {
+    return;
+    }
   this->Resize (this->MaxId+1);
 }
 
@@ -82,9 +96,403 @@ void vtkCellLinks::Squeeze()
 //----------------------------------------------------------------------------
 void vtkCellLinks::Reset()
 {
+  this->DeleteCompactLinks();
   this->MaxId = -1;
 }
 
+//----------------------------------------------------------------------------
+void vtkCellLinks::SetUse32BitStorage(int use)
+{
+  if ( this->Use32BitStorage == use )
+    {
+    return;
+    }
+  this->Use32BitStorage = use;
+  if ( !use && this->CompactCells )
+    {
+    this->ExpandCompactLinks();
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLinks::SetUseContiguousStorage(int use)
+{
+  if ( this->UseContiguousStorage == use )
+    {
+    return;
+    }
+  this->UseContiguousStorage = use;
+  if ( !use && this->CompactIdCells )
+    {
+    this->ExpandCompactLinks();
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkCellLinks::Link &vtkCellLinks::DecodeLink(vtkIdType ptId)
+{
+  vtkIdType begin = this->CompactOffsets[ptId];
+  vtkIdType ncells = this->CompactOffsets[ptId+1] - begin;
+  if ( ncells > this->DecodedSize )
+    {
+    delete [] this->Decoded.cells;
+    this->DecodedSize = ncells;
+    this->Decoded.cells = new vtkIdType[ncells];
+    }
+  if ( this->CompactIdCells )
+    {
+    memcpy(this->Decoded.cells, this->CompactIdCells + begin,
+           ncells*sizeof(vtkIdType));
+    }
+  else
+    {
+    const int *cells = this->CompactCells + begin;
+    for (vtkIdType i=0; i < ncells; i++)
+      {
+      this->Decoded.cells[i] = cells[i];
+      }
+    }
+  this->Decoded.ncells = static_cast<unsigned short>(ncells);
+  return this->Decoded;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLinks::GetCells(vtkIdType ptId, vtkIdList *cellIds)
+{
+  vtkIdType i, ncells = this->GetNcells(ptId);
+  cellIds->SetNumberOfIds(ncells);
+  if ( this->CompactIdCells )
+    {
+    memcpy(cellIds->GetPointer(0),
+           this->CompactIdCells + this->CompactOffsets[ptId],
+           ncells*sizeof(vtkIdType));
+    }
+  else if ( this->CompactOffsets )
+    {
+    const int *cells = this->CompactCells + this->CompactOffsets[ptId];
+    for (i=0; i < ncells; i++)
+      {
+      cellIds->SetId(i, cells[i]);
+      }
+    }
+  else
+    {
+    const vtkIdType *cells = this->Array[ptId].cells;
+    for (i=0; i < ncells; i++)
+      {
+      cellIds->SetId(i, cells[i]);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLinks::GetCells(vtkIdType ptId, vtkIdType& ncells,
+                            vtkIdType* &cells, vtkIdList *buffer)
+{
+  ncells = this->GetNcells(ptId);
+  if ( !this->CompactOffsets )
+    {
+    cells = this->Array[ptId].cells;
+    }
+  else if ( this->CompactIdCells )
+    {
+    cells = this->CompactIdCells + this->CompactOffsets[ptId];
+    }
+  else
+    {
+    const int *compact = this->CompactCells + this->CompactOffsets[ptId];
+    buffer->SetNumberOfIds(ncells);
+    cells = buffer->GetPointer(0);
+    for (vtkIdType i=0; i < ncells; i++)
+      {
+      cells[i] = compact[i];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Thread safe access to the points of the cells in the parallel build of the
+// compact links.  Unstructured grids and polydata whose connectivity is
+// stored as vtkIdType give a pointer to the points; other datasets copy them
+// with vtkDataSet::GetCellPoints(), which may be called from several
+// threads once it was called from a single one.
+class vtkCellLinksCellPoints
+{
+public:
+  vtkCellLinksCellPoints(vtkDataSet *data)
+    {
+    this->Data = data;
+    this->Grid = vtkUnstructuredGrid::SafeDownCast(data);
+    if ( this->Grid && this->Grid->GetUse32BitStorage() )
+      {
+      this->Grid = NULL;
+      }
+    this->PolyData = vtkPolyData::SafeDownCast(data);
+    if ( this->PolyData && (this->PolyData->GetVerts()->GetUse32BitStorage() ||
+                            this->PolyData->GetLines()->GetUse32BitStorage() ||
+                            this->PolyData->GetPolys()->GetUse32BitStorage() ||
+                            this->PolyData->GetStrips()->GetUse32BitStorage()) )
+      {
+      this->PolyData = NULL;
+      }
+    this->Ids = vtkIdList::New();
+    }
+  ~vtkCellLinksCellPoints()
+    {
+    this->Ids->Delete();
+    }
+
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts, vtkIdType* &pts)
+    {
+    if ( this->Grid )
+      {
+      this->Grid->GetCellPoints(cellId, npts, pts);
+      }
+    else if ( this->PolyData )
+      {
+      this->PolyData->GetCellPoints(cellId, npts, pts);
+      }
+    else
+      {
+      this->Data->GetCellPoints(cellId, this->Ids);
+      npts = this->Ids->GetNumberOfIds();
+      pts = this->Ids->GetPointer(0);
+      }
+    }
+
+private:
+  vtkDataSet *Data;
+  vtkUnstructuredGrid *Grid;
+  vtkPolyData *PolyData;
+  vtkIdList *Ids;
+};
+
+//----------------------------------------------------------------------------
+// The passes of the parallel build of the compact links.  The counters are
+// incremented atomically only when several threads run the loops.
+
+// Count the number of cells using each point.
+class vtkCellLinksCountUses
+{
+public:
+  vtkDataSet *Data;
+  int *Counts;
+  int Atomic;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkCellLinksCellPoints cellPoints(this->Data);
+    vtkIdType npts, *pts;
+    for (vtkIdType cellId=begin; cellId < end; cellId++)
+      {
+      cellPoints.GetCellPoints(cellId, npts, pts);
+      for (vtkIdType j=0; j < npts; j++)
+        {
+        if ( this->Atomic )
+          {
+          vtkAtomicOperations::Increment(this->Counts + pts[j]);
+          }
+        else
+          {
+          this->Counts[pts[j]]++;
+          }
+        }
+      }
+    }
+};
+
+// Store each cell in the lists of its points.  Counts holds the number of
+// cells already stored in each list.
+template <class T>
+class vtkCellLinksScatter
+{
+public:
+  vtkDataSet *Data;
+  const vtkIdType *Offsets;
+  int *Counts;
+  T *Cells;
+  int Atomic;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkCellLinksCellPoints cellPoints(this->Data);
+    vtkIdType npts, *pts;
+    for (vtkIdType cellId=begin; cellId < end; cellId++)
+      {
+      cellPoints.GetCellPoints(cellId, npts, pts);
+      for (vtkIdType j=0; j < npts; j++)
+        {
+        int pos = this->Atomic ?
+          vtkAtomicOperations::Increment(this->Counts + pts[j]) - 1 :
+          this->Counts[pts[j]]++;
+        this->Cells[this->Offsets[pts[j]] + pos] = static_cast<T>(cellId);
+        }
+      }
+    }
+};
+
+// Sort the lists, whose order depends on the scheduling of the scatter.
+template <class T>
+class vtkCellLinksSortLists
+{
+public:
+  const vtkIdType *Offsets;
+  T *Cells;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType ptId=begin; ptId < end; ptId++)
+      {
+      vtkstd::sort(this->Cells + this->Offsets[ptId],
+                   this->Cells + this->Offsets[ptId+1]);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+static T *vtkCellLinksBuildCompact(vtkDataSet *data, vtkIdType numPts,
+                                   vtkIdType numCells, vtkIdType *offsets)
+{
+  // A single thread processes the cells in order, so that the lists are
+  // already sorted.
+  int atomic = vtkSMPTools::GetEstimatedNumberOfThreads() > 1;
+
+  // count the uses of each point, then turn the counts into offsets
+  int *counts = new int[numPts];
+  memset(counts, 0, numPts*sizeof(int));
+  vtkCellLinksCountUses count;
+  count.Data = data;
+  count.Counts = counts;
+  count.Atomic = atomic;
+  vtkSMPTools::For(0, numCells, 10000, count);
+
+  offsets[0] = 0;
+  for (vtkIdType ptId=0; ptId < numPts; ptId++)
+    {
+    offsets[ptId+1] = offsets[ptId] + counts[ptId];
+    }
+
+  T *cells = new T[offsets[numPts]];
+  memset(counts, 0, numPts*sizeof(int));
+  vtkCellLinksScatter<T> scatter;
+  scatter.Data = data;
+  scatter.Offsets = offsets;
+  scatter.Counts = counts;
+  scatter.Cells = cells;
+  scatter.Atomic = atomic;
+  vtkSMPTools::For(0, numCells, 10000, scatter);
+  delete [] counts;
+
+  if ( atomic )
+    {
+    vtkCellLinksSortLists<T> sortLists;
+    sortLists.Offsets = offsets;
+    sortLists.Cells = cells;
+    vtkSMPTools::For(0, numPts, 10000, sortLists);
+    }
+
+  return cells;
+}
+
+//----------------------------------------------------------------------------
+// Build the compact links.  Return 0 if neither compact storage is enabled,
+// or if only Use32BitStorage is and the cell ids do not fit in 32 bits.
+int vtkCellLinks::BuildCompactLinks(vtkDataSet *data)
+{
+  vtkIdType numPts = data->GetNumberOfPoints();
+  vtkIdType numCells = data->GetNumberOfCells();
+  int use32Bits = this->Use32BitStorage &&
+    sizeof(vtkIdType) > sizeof(int) && numCells <= VTK_INT_MAX;
+  if ( !use32Bits && !this->UseContiguousStorage )
+    {
+    return 0;
+    }
+
+  // build any cell structure of the dataset from this thread
+  if ( numCells > 0 )
+    {
+    vtkIdList *ids = vtkIdList::New();
+    data->GetCellPoints(0, ids);
+    ids->Delete();
+    }
+
+  vtkIdType *offsets = new vtkIdType[numPts+1];
+  int *cells = NULL;
+  vtkIdType *idCells = NULL;
+  if ( use32Bits )
+    {
+    cells = vtkCellLinksBuildCompact<int>(data, numPts, numCells, offsets);
+    }
+  else
+    {
+    idCells = vtkCellLinksBuildCompact<vtkIdType>(data, numPts, numCells,
+                                                  offsets);
+    }
+
+  // release the regular storage
+  delete [] this->Array;
+  this->Array = NULL;
+  this->Size = 0;
+  this->DeleteCompactLinks();
+  this->CompactOffsets = offsets;
+  this->CompactCells = cells;
+  this->CompactIdCells = idCells;
+  this->MaxId = numPts - 1;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Convert compact links to the regular storage.
+void vtkCellLinks::ExpandCompactLinks()
+{
+  vtkIdType *offsets = this->CompactOffsets;
+  int *cells = this->CompactCells;
+  vtkIdType *idCells = this->CompactIdCells;
+  this->CompactOffsets = NULL;
+  this->CompactCells = NULL;
+  this->CompactIdCells = NULL;
+
+  vtkIdType numPts = this->MaxId + 1;
+  this->Allocate(numPts, this->Extend);
+  for (vtkIdType ptId=0; ptId < numPts; ptId++)
+    {
+    vtkIdType ncells = offsets[ptId+1] - offsets[ptId];
+    this->Array[ptId].ncells = static_cast<unsigned short>(ncells);
+    this->Array[ptId].cells = new vtkIdType[ncells];
+    if ( idCells )
+      {
+      memcpy(this->Array[ptId].cells, idCells + offsets[ptId],
+             ncells*sizeof(vtkIdType));
+      }
+    else
+      {
+      for (vtkIdType i=0; i < ncells; i++)
+        {
+        this->Array[ptId].cells[i] = cells[offsets[ptId]+i];
+        }
+      }
+    }
+  this->MaxId = numPts - 1;
+
+  delete [] offsets;
+  delete [] cells;
+  delete [] idCells;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLinks::DeleteCompactLinks()
+{
+  delete [] this->CompactOffsets;
+  this->CompactOffsets = NULL;
+  delete [] this->CompactCells;
+  this->CompactCells = NULL;
+  delete [] this->CompactIdCells;
+  this->CompactIdCells = NULL;
+}
+
 //----------------------------------------------------------------------------
 //
 // Private function does "reallocate"
@@ -128,6 +536,11 @@ vtkCellLinks::Link *vtkCellLinks::Resize(vtkIdType sz)
 // Build the link list array.
 void vtkCellLinks::BuildLinks(vtkDataSet *data)
 {
+  if ( this->BuildCompactLinks(data) )
+    {
+    return;
+    }
+
   vtkIdType numPts = data->GetNumberOfPoints();
   vtkIdType numCells = data->GetNumberOfCells();
   int j;
@@ -208,6 +621,11 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data)
 // Build the link list array.
 void vtkCellLinks::BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity)
 {
+  if ( this->BuildCompactLinks(data) )
+    {
+    return;
+    }
+
   vtkIdType numPts = data->GetNumberOfPoints();
   vtkIdType j, cellId;
   unsigned short *linkLoc;
@@ -251,6 +669,10 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity)
 // is the initial size of the list.
 vtkIdType vtkCellLinks::InsertNextPoint(int numLinks)
 {
+  if ( this->CompactOffsets )
+    {
+    this->ExpandCompactLinks();
+    }
   if ( ++this->MaxId >= this->Size )
     {
     this->Resize(this->MaxId + 1);
@@ -265,6 +687,14 @@ unsigned long vtkCellLinks::GetActualMemorySize()
   vtkIdType size=0;
   vtkIdType ptId;
 
+  if ( this->CompactOffsets )
+    {
+    size = (this->MaxId+2) * sizeof(vtkIdType) +
+      this->CompactOffsets[this->MaxId+1] *
+      (this->CompactIdCells ? sizeof(vtkIdType) : sizeof(int));
+    return static_cast<unsigned long>( ceil(size/1024.0)); //kilobytes
+    }
+
   for (ptId=0; ptId < (this->MaxId+1); ptId++)
     {
     size += this->GetNcells(ptId);
@@ -279,6 +709,32 @@ unsigned long vtkCellLinks::GetActualMemorySize()
 //----------------------------------------------------------------------------
 void vtkCellLinks::DeepCopy(vtkCellLinks *src)
 {
+  this->Use32BitStorage = src->Use32BitStorage;
+  this->UseContiguousStorage = src->UseContiguousStorage;
+  if ( src->CompactOffsets )
+    {
+    vtkIdType numPts = src->MaxId + 1;
+    vtkIdType numRefs = src->CompactOffsets[numPts];
+    this->Allocate(0, src->Extend);
+    delete [] this->Array;
+    this->Array = NULL;
+    this->CompactOffsets = new vtkIdType[numPts+1];
+    memcpy(this->CompactOffsets, src->CompactOffsets,
+           (numPts+1)*sizeof(vtkIdType));
+    if ( src->CompactIdCells )
+      {
+      this->CompactIdCells = new vtkIdType[numRefs];
+      memcpy(this->CompactIdCells, src->CompactIdCells,
+             numRefs*sizeof(vtkIdType));
+      }
+    else
+      {
+      this->CompactCells = new int[numRefs];
+      memcpy(this->CompactCells, src->CompactCells, numRefs*sizeof(int));
+      }
+    this->MaxId = src->MaxId;
+    return;
+    }
   this->Allocate(src->Size, src->Extend);
   memcpy(this->Array, src->Array, this->Size * sizeof(vtkCellLinks::Link));
   this->MaxId = src->MaxId;
@@ -292,4 +748,8 @@ void vtkCellLinks::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Size: " << this->Size << "\n";
   os << indent << "MaxId: " << this->MaxId << "\n";
   os << indent << "Extend: " << this->Extend << "\n";
+  os << indent << "Use 32 Bit Storage: "
+     << (this->Use32BitStorage ? "On\n" : "Off\n");
+  os << indent << "Use Contiguous Storage: "
+     << (this->UseContiguousStorage ? "On\n" : "Off\n");
 }
@@ -19,6 +19,17 @@
 // a list of Links, each link represents a dynamic list of cell id's using the 
 // point. The information provided by this object can be used to determine 
 // neighbors and construct other local topological information.
+//
+// With UseContiguousStorage on, BuildLinks() stores all the lists in a
+// single array of cell ids indexed by an array of offsets, built in
+// parallel, instead of allocating one small array per point.  With
+// Use32BitStorage on the single array holds 32 bit cell ids, which takes
+// even less memory.  GetLink() and GetCells(ptId) then copy the list of
+// the point to a buffer shared by all callers, which holds one list at a
+// time and must not be used from several threads: use
+// GetCells(ptId, ncells, cells, buffer), which decodes into storage
+// provided by the caller, GetNcells() with GetCellId(), or
+// GetCells(ptId, vtkIdList*) instead.
 // .SECTION See Also
 // vtkCellArray vtkCellTypes
 
@@ -28,6 +39,7 @@
 #include "vtkObject.h"
 class vtkDataSet;
 class vtkCellArray;
+class vtkIdList;
 
 class VTK_FILTERING_EXPORT vtkCellLinks : public vtkObject 
 {
@@ -51,12 +63,47 @@ public:
   void Allocate(vtkIdType numLinks, vtkIdType ext=1000);
 
   // Description:
-  // Get a link structure given a point id.
-  Link &GetLink(vtkIdType ptId) {return this->Array[ptId];};
+  // Get a link structure given a point id.  With compact links this is an
+  // internal copy that is valid until the next call and is shared by all
+  // the callers; see GetCells(ptId, ncells, cells, buffer).
+  Link &GetLink(vtkIdType ptId)
+    {return this->CompactOffsets ? this->DecodeLink(ptId) : this->Array[ptId];};
 
   // Description:
   // Get the number of cells using the point specified by ptId.
-  unsigned short GetNcells(vtkIdType ptId) { return this->Array[ptId].ncells;};
+  unsigned short GetNcells(vtkIdType ptId)
+    {
+    return this->CompactOffsets ? static_cast<unsigned short>(
+      this->CompactOffsets[ptId+1] - this->CompactOffsets[ptId]) :
+      this->Array[ptId].ncells;
+    };
+
+  // Description:
+  // Have BuildLinks() store the links compactly, with 32 bit cell ids, when
+  // all the cell ids fit in 32 bits.  GetLink() and GetCells() then copy
+  // the list of the point to an internal buffer that is valid until the
+  // next call.  The methods that edit the links (InsertNextPoint(),
+  // AddCellReference(), ResizeCellList(), ...) first convert them back to
+  // the regular storage.  Turning the option off converts compact links.
+  // This option has no effect when vtkIdType is 32 bits.
+  void SetUse32BitStorage(int use);
+  vtkGetMacro(Use32BitStorage, int);
+  vtkBooleanMacro(Use32BitStorage, int);
+
+  // Description:
+  // Have BuildLinks() store all the lists in a single array of vtkIdType
+  // cell ids, the cells using point i being at CompactOffsets[i] to
+  // CompactOffsets[i+1]-1.  The array is built with a parallel count,
+  // prefix sum and scatter (see vtkSMPTools), and each list is sorted so
+  // the result is the same as the one of the serial build.  GetCells()
+  // then returns a pointer into the single array and may be called from
+  // several threads at once.  As with Use32BitStorage, which takes
+  // precedence when the cell ids fit in 32 bits, the methods that edit the
+  // links first convert them back to the regular storage.  Turning the
+  // option off converts contiguous links.  Off by default.
+  void SetUseContiguousStorage(int use);
+  vtkGetMacro(UseContiguousStorage, int);
+  vtkBooleanMacro(UseContiguousStorage, int);
 
   // Description:
   // Build the link list array.
@@ -68,7 +115,46 @@ public:
 
   // Description:
   // Return a list of cell ids using the point.
-  vtkIdType *GetCells(vtkIdType ptId) {return this->Array[ptId].cells;};
+  vtkIdType *GetCells(vtkIdType ptId)
+    {
+    if ( !this->CompactOffsets )
+      {
+      return this->Array[ptId].cells;
+      }
+    return this->CompactIdCells ?
+      this->CompactIdCells + this->CompactOffsets[ptId] :
+      this->DecodeLink(ptId).cells;
+    };
+
+  // Description:
+  // Return the i-th cell using the point.  This does not go through the
+  // internal buffer used with compact links, so it may be called from
+  // several threads at once.
+  vtkIdType GetCellId(vtkIdType ptId, vtkIdType i)
+    {
+    if ( !this->CompactOffsets )
+      {
+      return this->Array[ptId].cells[i];
+      }
+    return this->CompactIdCells ?
+      this->CompactIdCells[this->CompactOffsets[ptId]+i] :
+      this->CompactCells[this->CompactOffsets[ptId]+i];
+    };
+
+  // Description:
+  // Copy the list of cell ids using the point into cellIds.  Unlike the
+  // method above this does not go through the internal buffer used with
+  // compact links, so it may be called from several threads at once.
+  void GetCells(vtkIdType ptId, vtkIdList *cellIds);
+
+  // Description:
+  // Return the number of cells using the point and a pointer to their ids.
+  // The pointer goes into the links when they hold vtkIdType cell ids;
+  // with 32 bit storage the ids are decoded into the buffer provided by
+  // the caller, and the pointer is valid until the buffer is modified.
+  // Several threads may call this at once with their own buffers.
+  void GetCells(vtkIdType ptId, vtkIdType& ncells, vtkIdType* &cells,
+                vtkIdList *buffer);
 
   // Description:
   // Insert a new point into the cell-links data structure. The size parameter
@@ -125,7 +211,10 @@ public:
   void DeepCopy(vtkCellLinks *src);
 
 protected:
-  vtkCellLinks():Array(NULL),Size(0),MaxId(-1),Extend(1000) {};
+  vtkCellLinks():Array(NULL),Size(0),MaxId(-1),Extend(1000),
+    Use32BitStorage(0),UseContiguousStorage(0),CompactOffsets(NULL),
+    CompactCells(NULL),CompactIdCells(NULL),DecodedSize(0)
+    {this->Decoded.ncells=0; this->Decoded.cells=NULL;};
   ~vtkCellLinks();
 
   // Description:
@@ -144,6 +233,23 @@ protected:
   vtkIdType MaxId;     // maximum index inserted thus far
   vtkIdType Extend;     // grow array by this point
   Link *Resize(vtkIdType sz);  // function to resize data
+
+  // Compact storage used with Use32BitStorage or UseContiguousStorage: the
+  // cells using point i are CompactCells[CompactOffsets[i]] to
+  // CompactCells[CompactOffsets[i+1]-1], or the same range of
+  // CompactIdCells.  Only one of the two arrays is allocated.
+  int Use32BitStorage;
+  int UseContiguousStorage;
+  vtkIdType *CompactOffsets;
+  int *CompactCells;
+  vtkIdType *CompactIdCells;
+  Link Decoded;           // list returned by GetLink() for compact links
+  vtkIdType DecodedSize;
+
+  Link &DecodeLink(vtkIdType ptId);
+  int BuildCompactLinks(vtkDataSet *data);
+  void ExpandCompactLinks();
+  void DeleteCompactLinks();
 private:
   vtkCellLinks(const vtkCellLinks&);  // Not implemented.
   void operator=(const vtkCellLinks&);  // Not implemented.
@@ -160,6 +266,10 @@ inline void vtkCellLinks::InsertCellReference(vtkIdType ptId,
 //----------------------------------------------------------------------------
 inline void vtkCellLinks::DeletePoint(vtkIdType ptId)
 {
+  if ( this->CompactOffsets )
+    {
+    this->ExpandCompactLinks();
+    }
   this->Array[ptId].ncells = 0;
   delete [] this->Array[ptId].cells;
   this->Array[ptId].cells = NULL;
@@ -169,12 +279,20 @@ inline void vtkCellLinks::DeletePoint(vtkIdType ptId)
 inline void vtkCellLinks::InsertNextCellReference(vtkIdType ptId,
                                                   vtkIdType cellId) 
 {
+  if ( this->CompactOffsets )
+    {
+    this->ExpandCompactLinks();
+    }
   this->Array[ptId].cells[this->Array[ptId].ncells++] = cellId;
 }
 
 //----------------------------------------------------------------------------
 inline void vtkCellLinks::RemoveCellReference(vtkIdType cellId, vtkIdType ptId)
 {
+  if ( this->CompactOffsets )
+    {
+    this->ExpandCompactLinks();
+    }
   vtkIdType *cells=this->Array[ptId].cells;
   int ncells=this->Array[ptId].ncells;
 
@@ -195,6 +313,10 @@ inline void vtkCellLinks::RemoveCellReference(vtkIdType cellId, vtkIdType ptId)
 //----------------------------------------------------------------------------
 inline void vtkCellLinks::AddCellReference(vtkIdType cellId, vtkIdType ptId)
 {
+  if ( this->CompactOffsets )
+    {
+    this->ExpandCompactLinks();
+    }
   this->Array[ptId].cells[this->Array[ptId].ncells++] = cellId;
 }
 
@@ -203,7 +325,11 @@ inline void vtkCellLinks::ResizeCellList(vtkIdType ptId, int size)
 {
   int newSize;
   vtkIdType *cells;
-  
+
+  if ( this->CompactOffsets )
+    {
+    this->ExpandCompactLinks();
+    }
   newSize = this->Array[ptId].ncells + size;
   cells = new vtkIdType[newSize];
   memcpy(cells, this->Array[ptId].cells,
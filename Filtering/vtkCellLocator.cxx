@@ -117,6 +117,30 @@ void vtkCellLocator::FreeSearchStructure()
     }
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkCellLocator::GetActualMemorySize()
+{
+  unsigned long size = this->Superclass::GetActualMemorySize();
+  if ( !this->Tree )
+    {
+    return size;
+    }
+  size_t bytes = this->NumberOfOctants * sizeof(vtkIdList *);
+  for (int i=0; i<this->NumberOfOctants; i++)
+    {
+    vtkIdList *cellIds = this->Tree[i];
+    if (cellIds && cellIds != reinterpret_cast<void *>(VTK_CELL_INSIDE))
+      {
+      bytes += sizeof(vtkIdList) + cellIds->GetNumberOfIds()*sizeof(vtkIdType);
+      }
+    }
+  if ( this->CellHasBeenVisited && this->DataSet )
+    {
+    bytes += this->DataSet->GetNumberOfCells();
+    }
+  return size + static_cast<unsigned long>((bytes + 1023) / 1024);
+}
+
 //----------------------------------------------------------------------------
 // Given an offset into the structure, the number of divisions in the octree,
 // an i,j,k location in the octree; return the index (idx) into the structure.
@@ -155,6 +179,22 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
                                       int &subId, vtkIdType &cellId,
                                       vtkGenericCell *cell)
 {
+  this->BuildLocatorIfNeeded();
+  return this->IntersectWithLineInternal(a0, a1, tol, t, x, pcoords, subId,
+                                         cellId, cell, 1);
+}
+
+//----------------------------------------------------------------------------
+// Without markVisited, the cells overlapping several octants may be tested
+// again, but no state of the locator is modified.
+int vtkCellLocator::IntersectWithLineInternal(double a0[3], double a1[3],
+                                              double tol, double& t,
+                                              double x[3], double pcoords[3],
+                                              int &subId, vtkIdType &cellId,
+                                              vtkGenericCell *cell,
+                                              int markVisited)
+{
+  double octantBounds[6];
   double origin[3];
   double direction1[3];
   double direction2[3];
@@ -174,8 +214,6 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
   double stopDist, currDist;
   double deltaT, pDistance, minPDistance=1.0e38;
   double length, maxLength=0.0;
-  
-  this->BuildLocatorIfNeeded();
 
   // convert the line into i,j,k coordinates
   tMax = 0.0;
@@ -216,11 +254,14 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
     // Clear the array that indicates whether we have visited this cell.
     // The array is only cleared when the query number rolls over.  This
     // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
+    if (markVisited)
       {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++;    // can't use 0 as a marker
+      this->QueryNumber++;
+      if (this->QueryNumber == 0)
+        {
+        this->ClearCellHasBeenVisited();
+        this->QueryNumber++;    // can't use 0 as a marker
+        }
       }
     
     // set up curr and stop dist
@@ -255,14 +296,22 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
       {
       if (this->Tree[idx])
         {
-        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1);
+        for (loop = 0; loop < 3; loop++)
+          {
+          octantBounds[2*loop] = this->Bounds[2*loop] + (pos[loop]-1)*H[loop];
+          octantBounds[2*loop+1] = octantBounds[2*loop] + H[loop];
+          }
         for (tMax = VTK_DOUBLE_MAX, cellId=0; 
         cellId < this->Tree[idx]->GetNumberOfIds(); cellId++) 
           {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (!markVisited ||
+              this->CellHasBeenVisited[cId] != this->QueryNumber)
             {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
+            if (markVisited)
+              {
+              this->CellHasBeenVisited[cId] = this->QueryNumber;
+              }
             hitCellBounds = 0;
             
             // check whether we intersect the cell bounds
@@ -287,9 +336,14 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
               this->DataSet->GetCell(cId, cell);
               if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId) )
                 {
-                if ( ! this->IsInOctantBounds(x) ) 
+                if ( x[0] < octantBounds[0] || x[0] > octantBounds[1] ||
+                     x[1] < octantBounds[2] || x[1] > octantBounds[3] ||
+                     x[2] < octantBounds[4] || x[2] > octantBounds[5] )
                   {
-                  this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                  if (markVisited)
+                    {
+                    this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                    }
                   }
                 else
                   {
@@ -381,6 +435,29 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkCellLocator::PrepareForThreadedIntersectWithLine()
+{
+  this->BuildLocatorIfNeeded();
+  if (!this->Tree)
+    {
+    return 0;
+    }
+  this->DataSet->PrepareForThreadedAccess();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkCellLocator::ThreadedIntersectWithLine(double a0[3], double a1[3],
+                                              double tol, double& t,
+                                              double x[3], double pcoords[3],
+                                              int &subId, vtkIdType &cellId,
+                                              vtkGenericCell *cell)
+{
+  return this->IntersectWithLineInternal(a0, a1, tol, t, x, pcoords, subId,
+                                         cellId, cell, 0);
+}
+
 //----------------------------------------------------------------------------
 // Return closest point (if any) AND the cell on which this closest point lies
 void vtkCellLocator::FindClosestPoint(double x[3], double closestPoint[3], 
@@ -223,6 +223,11 @@ public:
   virtual void ForceBuildLocator();
   virtual void BuildLocatorInternal();
   virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+  // Description:
+  // Return the memory in kilobytes used by the octants, their lists of
+  // cell ids and the cached cell bounds.
+  virtual unsigned long GetActualMemorySize();
   
 protected:
   vtkCellLocator();
@@ -235,6 +240,21 @@ protected:
   void ClearCellHasBeenVisited();
   void ClearCellHasBeenVisited(int id);
 
+  // Description:
+  // The line intersection of IntersectWithLine().  With markVisited off,
+  // the shared CellHasBeenVisited array is not used, so that
+  // ThreadedIntersectWithLine() may run on several threads.
+  int IntersectWithLineInternal(double a0[3], double a1[3], double tol,
+                                double& t, double x[3], double pcoords[3],
+                                int &subId, vtkIdType &cellId,
+                                vtkGenericCell *cell, int markVisited);
+  virtual int PrepareForThreadedIntersectWithLine();
+  virtual int ThreadedIntersectWithLine(double a0[3], double a1[3],
+                                        double tol, double& t, double x[3],
+                                        double pcoords[3], int &subId,
+                                        vtkIdType &cellId,
+                                        vtkGenericCell *cell);
+
   double Distance2ToBucket(double x[3], int nei[3]);
   double Distance2ToBounds(double x[3], double bounds[6]);
   
@@ -1260,6 +1260,18 @@ int vtkCellTreeLocator::IntersectCellInternal(
   return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //----------------------------------------------------------------------------
+unsigned long vtkCellTreeLocator::GetActualMemorySize()
+{
+  unsigned long size = this->Superclass::GetActualMemorySize();
+  if( this->Tree )
+    {
+    size_t bytes = this->Tree->Nodes.capacity() * sizeof(vtkCellTreeNode) +
+      this->Tree->Leaves.capacity() * sizeof(unsigned int);
+    size += static_cast<unsigned long>((bytes + 1023) / 1024);
+    }
+  return size;
+}
+//----------------------------------------------------------------------------
 void vtkCellTreeLocator::FreeSearchStructure(void)
 {
   if( this->Tree )
@@ -127,6 +127,11 @@ class VTK_FILTERING_EXPORT vtkCellTreeLocator : public vtkAbstractCellLocator
     virtual void ForceBuildLocator();
     virtual void BuildLocator();
 
+    // Description:
+    // Return the memory in kilobytes used by the nodes, the leaves and the
+    // cached cell bounds.
+    virtual unsigned long GetActualMemorySize();
+
 
 //BTX
     // Description:
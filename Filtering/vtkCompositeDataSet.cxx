@@ -22,9 +22,12 @@
 #include "vtkInformation.h"
 #include "vtkInformationStringKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkObjectFactory.h"
 #include "vtkTrivialProducer.h"
 
+#include <vtksys/ios/sstream>
+
 vtkInformationKeyMacro(vtkCompositeDataSet, NAME, String);
 //----------------------------------------------------------------------------
 vtkCompositeDataSet::vtkCompositeDataSet()
@@ -498,6 +501,21 @@ unsigned long vtkCompositeDataSet::GetActualMemorySize()
   return memSize;
 }
 
+//----------------------------------------------------------------------------
+void vtkCompositeDataSet::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  vtkCompositeDataIterator* iter = this->NewIterator();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+    vtksys_ios::ostringstream name;
+    name << "Block " << iter->GetCurrentFlatIndex();
+    accounting->PushName(name.str().c_str());
+    iter->GetCurrentDataObject()->ReportMemory(accounting);
+    accounting->PopName();
+    }
+  iter->Delete();
+}
+
 //----------------------------------------------------------------------------
 void vtkCompositeDataSet::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -97,6 +97,11 @@ public:
   // is valid only after the pipeline has updated.
   virtual unsigned long GetActualMemorySize();
 
+  // Description:
+  // Also reports the structures of each leaf data object, named after its
+  // flat index. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
+
   //BTX
   // Description:
   // Retrieve an instance of this class from an information object.
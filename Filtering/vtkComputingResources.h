@@ -74,7 +74,8 @@ public:
   // Description:
   // Assign the resources and information of this object to an
   // executive, i.e., set the number of threads of the algorithm the
-  // executive is pointing to
+  // executive is pointing to.  The executive is not updated: that is
+  // left to the caller.
   void Deploy(vtkThreadedStreamingPipeline *exec, vtkInformation *info);
   
   // Description:
@@ -20,6 +20,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkFieldData.h"
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkObjectFactory.h"
 #include "vtkSource.h"
 #include "vtkTrivialProducer.h"
@@ -893,7 +894,16 @@ vtkStreamingDemandDrivenPipeline* vtkDataObject::TrySDDP(const char* method)
 
 unsigned long vtkDataObject::GetActualMemorySize()
 {
-  return this->FieldData->GetActualMemorySize();
+  return this->FieldData->GetActualMemorySize() +
+    this->Information->GetActualMemorySize();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObject::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  accounting->Report(this->Information, "Information",
+                     this->Information->GetActualMemorySize());
+  accounting->ReportFieldData(this->FieldData, "FieldData");
 }
 
 //----------------------------------------------------------------------------
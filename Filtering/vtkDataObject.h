@@ -40,6 +40,7 @@ class vtkDataSetAttributes;
 class vtkExecutive;
 class vtkFieldData;
 class vtkInformation;
+class vtkMemoryAccounting;
 class vtkProcessObject;
 class vtkSource;
 class vtkStreamingDemandDrivenPipelineToDataObjectFriendship;
@@ -239,9 +240,19 @@ public:
   // is valid only after the pipeline has updated. The memory size
   // returned is guaranteed to be greater than or equal to the
   // memory required to represent the data (e.g., extra space in
-  // arrays, etc. are not included in the return value).
+  // arrays, etc. are not included in the return value).  The field data
+  // and the information are included; subclasses add their arrays and
+  // auxiliary structures (cell links, locators, ...).
   virtual unsigned long GetActualMemorySize();
 
+  // Description:
+  // Report each array and auxiliary structure of this data object, with
+  // its memory size, to the accounting.  Subclasses report their own
+  // structures after calling the superclass.  Used by vtkMemoryAccounting
+  // to attribute memory; the sizes reported add up to
+  // GetActualMemorySize().
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
+
   // Description:
   // Copy the generic information (WholeExtent ...)
   void CopyInformation( vtkDataObject *data );
@@ -23,6 +23,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkPointData.h"
 #include "vtkSource.h"
 
@@ -106,6 +107,13 @@ void vtkDataSet::ComputeBounds()
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkDataSet::PrepareForThreadedAccess()
+{
+  this->ComputeBounds();
+  this->ComputeScalarRange();
+}
+
 //----------------------------------------------------------------------------
 // Description:
 // Compute the range of the scalars and cache it into ScalarRange
@@ -324,6 +332,14 @@ unsigned long vtkDataSet::GetActualMemorySize()
   return size;
 }
 
+//----------------------------------------------------------------------------
+void vtkDataSet::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  this->vtkDataObject::ReportMemory(accounting);
+  accounting->ReportFieldData(this->PointData, "PointData");
+  accounting->ReportFieldData(this->CellData, "CellData");
+}
+
 //----------------------------------------------------------------------------
 void vtkDataSet::ShallowCopy(vtkDataObject *dataObject)
 {
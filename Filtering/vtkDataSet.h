@@ -28,6 +28,14 @@
 // Attribute data in vtk is either point data (data at points) or cell data
 // (data at cells). Typically filters operate on point data, but some may
 // operate on cell data, both cell and point data, either one, or none.
+//
+// Many query methods below are documented as thread safe "if first called
+// from a single thread and the dataset is not modified": the first call
+// builds internal structures (bounds, cell links, locators, ...) lazily.
+// Call PrepareForThreadedAccess() once before handing the dataset to
+// several threads; afterwards these methods, and the methods documented
+// as thread safe, may be called concurrently as long as each thread uses
+// its own vtkGenericCell, vtkIdList and output buffers.
 
 // .SECTION See Also
 // vtkPointSet vtkStructuredPoints vtkStructuredGrid vtkUnstructuredGrid
@@ -215,6 +223,16 @@ public:
   // THIS METHOD IS THREAD SAFE
   vtkPointData *GetPointData() {return this->PointData;};
 
+  // Description:
+  // Build all the internal structures that the thread safe query methods
+  // otherwise build on their first call: the bounds, the scalar range and,
+  // in subclasses, the cell and point links and the point locator.  After
+  // this call, and until the dataset is modified, the methods documented
+  // as thread safe if first called from a single thread may be called
+  // from several threads at once.
+  // THIS METHOD IS NOT THREAD SAFE.
+  virtual void PrepareForThreadedAccess();
+
   // Description:
   // Reclaim any extra memory used to store data.
   // THIS METHOD IS NOT THREAD SAFE.
@@ -296,6 +314,10 @@ public:
   // IS THREAD SAFE.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Also reports the point and cell data arrays. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
+
   // Description:
   // Return the type of data object.
   int GetDataObjectType()
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkDataSetAttributes.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkCell.h"
 #include "vtkMath.h"
@@ -700,6 +701,259 @@ void vtkDataSetAttributes::RemoveArray(int index)
     }
 }
 
+//--------------------------------------------------------------------------
+// The tuples of the data arrays of the same type are copied and
+// interpolated by these workers, dispatched on the type of the arrays with
+// vtkArrayDispatch2SameType.  The other arrays use the vtkAbstractArray
+// API.
+template <class T>
+inline void vtkDataSetAttributesRound(double val, T* retVal)
+{
+  *retVal = static_cast<T>((val>=0.0)?(val + 0.5):(val - 0.5));
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkDataSetAttributesRound(double val, double* retVal)
+{
+  *retVal = val;
+}
+
+VTK_TEMPLATE_SPECIALIZE
+inline void vtkDataSetAttributesRound(double val, float* retVal)
+{
+  *retVal = static_cast<float>(val);
+}
+
+struct vtkDataSetAttributesCopyWorker
+{
+  vtkIdType FromId;
+  vtkIdType ToId;
+  int NumComp;
+
+  template <class T> void operator()(T* from, T* to)
+    {
+    from += this->FromId*this->NumComp;
+    to += this->ToId*this->NumComp;
+    for (int k=0; k < this->NumComp; ++k)
+      {
+      to[k] = from[k];
+      }
+    }
+};
+
+struct vtkDataSetAttributesInterpolateWorker
+{
+  vtkIdType ToId;
+  int NumComp;
+  vtkIdType NumIds;
+  vtkIdType* Ids;
+  double* Weights;
+
+  template <class T> void operator()(T* from, T* to)
+    {
+    to += this->ToId*this->NumComp;
+    for (int k=0; k < this->NumComp; ++k)
+      {
+      double c = 0.0;
+      for (vtkIdType j=0; j < this->NumIds; ++j)
+        {
+        c += this->Weights[j]*
+          static_cast<double>(from[this->Ids[j]*this->NumComp+k]);
+        }
+      // Round integer types. Don't round floating point types.
+      vtkDataSetAttributesRound(c, to+k);
+      }
+    }
+};
+
+// Return the output array as a vtkDataArray when the tuples of fromArray
+// can be written directly to its tuple toId, after extending it to hold
+// that tuple.  IsNumeric() tells the data arrays apart without the string
+// comparisons of SafeDownCast().
+static vtkDataArray* vtkDataSetAttributesDirectOutput(
+  vtkAbstractArray* fromArray, vtkAbstractArray* toArray, vtkIdType toId)
+{
+  if (!fromArray->IsNumeric() || !toArray->IsNumeric() ||
+      fromArray->GetDataType() != toArray->GetDataType())
+    {
+    return 0;
+    }
+  vtkDataArray* from = static_cast<vtkDataArray*>(fromArray);
+  vtkDataArray* to = static_cast<vtkDataArray*>(toArray);
+  int numComp = to->GetNumberOfComponents();
+  if (from->GetNumberOfComponents() != numComp || numComp == 0 ||
+      !vtkArrayDispatchIsDirect(from) || !vtkArrayDispatchIsDirect(to) ||
+      !to->WriteVoidPointer(toId*numComp, numComp))
+    {
+    return 0;
+    }
+  return to;
+}
+
+// Interpolate the tuple toId of toArray with the workers above or the
+// vtkAbstractArray API.
+static void vtkDataSetAttributesInterpolateTuple(vtkAbstractArray* fromArray,
+                                                 vtkAbstractArray* toArray,
+                                                 vtkIdType toId,
+                                                 vtkIdList* ptIds,
+                                                 double* weights)
+{
+  vtkDataArray* to =
+    vtkDataSetAttributesDirectOutput(fromArray, toArray, toId);
+  if (to)
+    {
+    vtkDataSetAttributesInterpolateWorker worker;
+    worker.ToId = toId;
+    worker.NumComp = to->GetNumberOfComponents();
+    worker.NumIds = ptIds->GetNumberOfIds();
+    worker.Ids = ptIds->GetPointer(0);
+    worker.Weights = weights;
+    if (vtkArrayDispatch2SameType<>::Execute(
+          static_cast<vtkDataArray*>(fromArray), to, worker))
+      {
+      return;
+      }
+    }
+  toArray->InterpolateTuple(toId, ptIds, fromArray, weights);
+}
+
+// The bulk forms of the workers above.  The tuples copied are either
+// given by two lists of ids or, when FromIds is NULL, are a range.
+struct vtkDataSetAttributesCopyTuplesWorker
+{
+  vtkIdType* FromIds;
+  vtkIdType* ToIds;
+  vtkIdType FromStart;
+  vtkIdType ToStart;
+  vtkIdType NumTuples;
+  int NumComp;
+
+  template <class T> void operator()(T* from, T* to)
+    {
+    int numComp = this->NumComp;
+    if (!this->FromIds)
+      {
+      // The ranges overlap when copying on self.
+      memmove(to + this->ToStart*numComp, from + this->FromStart*numComp,
+              static_cast<size_t>(this->NumTuples*numComp)*sizeof(T));
+      return;
+      }
+    for (vtkIdType i=0; i < this->NumTuples; ++i)
+      {
+      T* fromTuple = from + this->FromIds[i]*numComp;
+      T* toTuple = to + this->ToIds[i]*numComp;
+      for (int k=0; k < numComp; ++k)
+        {
+        toTuple[k] = fromTuple[k];
+        }
+      }
+    }
+};
+
+struct vtkDataSetAttributesInterpolateTuplesWorker
+{
+  vtkIdType ToStart;
+  vtkIdType NumTuples;
+  int NumComp;
+  vtkIdType* Offsets;
+  vtkIdType* Ids;
+  double* Weights;
+
+  template <class T> void operator()(T* from, T* to)
+    {
+    int numComp = this->NumComp;
+    to += this->ToStart*numComp;
+    for (vtkIdType i=0; i < this->NumTuples; ++i, to += numComp)
+      {
+      vtkIdType begin = this->Offsets[i];
+      vtkIdType end = this->Offsets[i+1];
+      for (int k=0; k < numComp; ++k)
+        {
+        double c = 0.0;
+        for (vtkIdType j=begin; j < end; ++j)
+          {
+          c += this->Weights[j]*
+            static_cast<double>(from[this->Ids[j]*numComp+k]);
+          }
+        vtkDataSetAttributesRound(c, to+k);
+        }
+      }
+    }
+};
+
+// Copy the tuples described by the worker from fromArray to toArray, the
+// largest id written being maxToId.
+static void vtkDataSetAttributesCopyTuples(
+  vtkAbstractArray* fromArray, vtkAbstractArray* toArray,
+  vtkDataSetAttributesCopyTuplesWorker& worker, vtkIdType maxToId)
+{
+  vtkDataArray* to =
+    vtkDataSetAttributesDirectOutput(fromArray, toArray, maxToId);
+  if (to)
+    {
+    worker.NumComp = to->GetNumberOfComponents();
+    if (vtkArrayDispatch2SameType<>::Execute(
+          static_cast<vtkDataArray*>(fromArray), to, worker))
+      {
+      return;
+      }
+    }
+  if (worker.FromIds)
+    {
+    for (vtkIdType i=0; i < worker.NumTuples; ++i)
+      {
+      toArray->InsertTuple(worker.ToIds[i], worker.FromIds[i], fromArray);
+      }
+    }
+  else if (fromArray == toArray && worker.ToStart > worker.FromStart)
+    {
+    // Copy backwards so that an overlapping range is read before it is
+    // overwritten.
+    for (vtkIdType i=worker.NumTuples-1; i >= 0; --i)
+      {
+      toArray->InsertTuple(worker.ToStart+i, worker.FromStart+i, fromArray);
+      }
+    }
+  else
+    {
+    for (vtkIdType i=0; i < worker.NumTuples; ++i)
+      {
+      toArray->InsertTuple(worker.ToStart+i, worker.FromStart+i, fromArray);
+      }
+    }
+}
+
+// Interpolate the tuples described by the worker from fromArray to
+// toArray.
+static void vtkDataSetAttributesInterpolateTuples(
+  vtkAbstractArray* fromArray, vtkAbstractArray* toArray,
+  vtkDataSetAttributesInterpolateTuplesWorker& worker, vtkIdList* stencil)
+{
+  vtkDataArray* to = vtkDataSetAttributesDirectOutput(
+    fromArray, toArray, worker.ToStart+worker.NumTuples-1);
+  if (to)
+    {
+    worker.NumComp = to->GetNumberOfComponents();
+    if (vtkArrayDispatch2SameType<>::Execute(
+          static_cast<vtkDataArray*>(fromArray), to, worker))
+      {
+      return;
+      }
+    }
+  for (vtkIdType i=0; i < worker.NumTuples; ++i)
+    {
+    vtkIdType begin = worker.Offsets[i];
+    vtkIdType numIds = worker.Offsets[i+1] - begin;
+    stencil->SetNumberOfIds(numIds);
+    for (vtkIdType j=0; j < numIds; ++j)
+      {
+      stencil->SetId(j, worker.Ids[begin+j]);
+      }
+    toArray->InterpolateTuple(worker.ToStart+i, stencil, fromArray,
+                              worker.Weights+begin);
+    }
+}
+
 //--------------------------------------------------------------------------
 // Copy the attribute data from one id to another. Make sure CopyAllocate() has
 // been invoked before using this method.
@@ -715,6 +969,73 @@ void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
     }
 }
 
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
+                                    vtkIdList* fromIds, vtkIdList* toIds)
+{
+  vtkIdType numIds = fromIds->GetNumberOfIds();
+  if (toIds->GetNumberOfIds() != numIds)
+    {
+    vtkErrorMacro("The lists of ids to copy from and to differ in size.");
+    return;
+    }
+  if (numIds == 0)
+    {
+    return;
+    }
+
+  vtkDataSetAttributesCopyTuplesWorker worker;
+  worker.FromIds = fromIds->GetPointer(0);
+  worker.ToIds = toIds->GetPointer(0);
+  worker.FromStart = worker.ToStart = 0;
+  worker.NumTuples = numIds;
+  vtkIdType maxToId = 0;
+  for (vtkIdType j=0; j < numIds; ++j)
+    {
+    if (worker.ToIds[j] > maxToId)
+      {
+      maxToId = worker.ToIds[j];
+      }
+    }
+
+  // Iterate over a copy so that several threads may copy at once.
+  vtkFieldData::BasicIterator required(this->RequiredArrays);
+  int i;
+  for(i=required.BeginIndex(); !required.End(); i=required.NextIndex())
+    {
+    vtkDataSetAttributesCopyTuples(fromPd->Data[i],
+                                   this->Data[this->TargetIndices[i]],
+                                   worker, maxToId);
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyData(vtkDataSetAttributes* fromPd,
+                                    vtkIdType dstStart, vtkIdType n,
+                                    vtkIdType srcStart)
+{
+  if (n <= 0)
+    {
+    return;
+    }
+
+  vtkDataSetAttributesCopyTuplesWorker worker;
+  worker.FromIds = worker.ToIds = 0;
+  worker.FromStart = srcStart;
+  worker.ToStart = dstStart;
+  worker.NumTuples = n;
+
+  // Iterate over a copy so that several threads may copy at once.
+  vtkFieldData::BasicIterator required(this->RequiredArrays);
+  int i;
+  for(i=required.BeginIndex(); !required.End(); i=required.NextIndex())
+    {
+    vtkDataSetAttributesCopyTuples(fromPd->Data[i],
+                                   this->Data[this->TargetIndices[i]],
+                                   worker, dstStart+n-1);
+    }
+}
+
 //--------------------------------------------------------------------------
 void vtkDataSetAttributes::CopyAllocate(vtkDataSetAttributes* pd,
                                         vtkIdType sze, vtkIdType ext,
@@ -742,9 +1063,41 @@ void vtkDataSetAttributes::InterpolatePoint(vtkDataSetAttributes *fromPd,
   for(i=this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End(); 
       i=this->RequiredArrays.NextIndex())
     {
-    vtkAbstractArray* fromArray = this->Data[this->TargetIndices[i]];    
-    fromArray->InterpolateTuple(toId, ptIds, fromPd->Data[i], weights);
+    vtkDataSetAttributesInterpolateTuple(fromPd->Data[i],
+                                         this->Data[this->TargetIndices[i]],
+                                         toId, ptIds, weights);
+    }
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::InterpolatePoints(vtkDataSetAttributes *fromPd,
+                                             vtkIdType toStart, vtkIdType n,
+                                             vtkIdType *offsets,
+                                             vtkIdType *ids, double *weights)
+{
+  if (n <= 0)
+    {
+    return;
+    }
+
+  vtkDataSetAttributesInterpolateTuplesWorker worker;
+  worker.ToStart = toStart;
+  worker.NumTuples = n;
+  worker.Offsets = offsets;
+  worker.Ids = ids;
+  worker.Weights = weights;
+  vtkIdList* stencil = vtkIdList::New();
+
+  // Iterate over a copy so that several threads may interpolate at once.
+  vtkFieldData::BasicIterator required(this->RequiredArrays);
+  int i;
+  for(i=required.BeginIndex(); !required.End(); i=required.NextIndex())
+    {
+    vtkDataSetAttributesInterpolateTuples(fromPd->Data[i],
+                                          this->Data[this->TargetIndices[i]],
+                                          worker, stencil);
     }
+  stencil->Delete();
 }
 
 //--------------------------------------------------------------------------
@@ -824,6 +1177,19 @@ void vtkDataSetAttributes::CopyTuple(vtkAbstractArray *fromData,
                                      vtkAbstractArray *toData, vtkIdType fromId,
                                      vtkIdType toId)
 {
+  vtkDataArray* to = vtkDataSetAttributesDirectOutput(fromData, toData, toId);
+  if (to)
+    {
+    vtkDataSetAttributesCopyWorker worker;
+    worker.FromId = fromId;
+    worker.ToId = toId;
+    worker.NumComp = to->GetNumberOfComponents();
+    if (vtkArrayDispatch2SameType<>::Execute(
+          static_cast<vtkDataArray*>(fromData), to, worker))
+      {
+      return;
+      }
+    }
   toData->InsertTuple(toId, fromId, fromData);
 }
 
@@ -1608,7 +1974,8 @@ void vtkDataSetAttributes::InterpolatePoint(
       {
       toArray = this->GetAbstractArray(list.FieldIndices[i]);
       fromArray = fromPd->GetAbstractArray(list.DSAIndices[idx][i]);
-      toArray->InterpolateTuple(toId, ptIds, fromArray, weights);
+      vtkDataSetAttributesInterpolateTuple(fromArray, toArray, toId, ptIds,
+                                           weights);
       }
     }
 }
@@ -450,6 +450,20 @@ public:
   // CopyAllOn/Off
   void CopyData(vtkDataSetAttributes *fromPd, vtkIdType fromId, vtkIdType toId);
 
+  // Description:
+  // Bulk forms of CopyData(): copy the tuples fromIds->GetId(i) to the
+  // tuples toIds->GetId(i), or the n tuples from srcStart to the n tuples
+  // from dstStart.  They loop over the tuples for each array rather than
+  // over the arrays for each tuple, and copy the values of the arrays of
+  // the standard types directly.  Make sure CopyAllocate() has been
+  // invoked before using these methods.  Once the arrays have been sized
+  // with SetNumberOfTuples(), several threads may copy to disjoint
+  // tuples at once.
+  void CopyData(vtkDataSetAttributes *fromPd, vtkIdList *fromIds,
+                vtkIdList *toIds);
+  void CopyData(vtkDataSetAttributes *fromPd, vtkIdType dstStart,
+                vtkIdType n, vtkIdType srcStart);
+
 
   // Description:
   // Copy a tuple of data from one data array to another. This method
@@ -485,6 +499,18 @@ public:
   // If the flag is set to 2, nearest neighbor interpolation is used.
   void InterpolatePoint(vtkDataSetAttributes *fromPd, vtkIdType toId, 
                         vtkIdList *ids, double *weights);
+
+  // Description:
+  // Bulk form of InterpolatePoint(): interpolate the n tuples from
+  // toStart, tuple toStart+i from the tuples ids[offsets[i]] to
+  // ids[offsets[i+1]-1] with the weights of the same indices.  offsets
+  // holds n+1 entries.  Make sure InterpolateAllocate() has been invoked
+  // before using this method.  Once the arrays have been sized with
+  // SetNumberOfTuples(), several threads may interpolate disjoint tuples
+  // at once.
+  void InterpolatePoints(vtkDataSetAttributes *fromPd, vtkIdType toStart,
+                         vtkIdType n, vtkIdType *offsets, vtkIdType *ids,
+                         double *weights);
   
   // Description:
   // Interpolate data from the two points p1,p2 (forming an edge) and an 
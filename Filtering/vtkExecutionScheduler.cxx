@@ -32,6 +32,8 @@
 #include "vtkAlgorithm.h"
 #include "vtkCommand.h"
 #include "vtkComputingResources.h"
+#include "vtkConditionVariable.h"
+#include "vtkCriticalSection.h"
 #include "vtkExecutiveCollection.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -42,9 +44,7 @@
 #include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkThreadedStreamingPipeline.h"
-#include "vtkThreadMessager.h"
 
-#include <set>
 #include <vtksys/hash_map.hxx>
 #include <vector>
 #include <vtksys/hash_set.hxx>
@@ -55,30 +55,32 @@ vtkStandardNewMacro(vtkExecutionScheduler);
 vtkInformationKeyMacro(vtkExecutionScheduler, TASK_PRIORITY, Integer);
 
 //----------------------------------------------------------------------------
-class Task 
+// A request for data on one executive.  A task may start when all the
+// tasks it depends on are done: those scheduled before it for the same
+// executive or for an executive upstream of it.
+class vtkExecutionSchedulerTask
 {
 public:
-  Task(int _priority = -1, vtkExecutive *_exec = NULL, vtkInformation *_info = NULL) 
+  vtkExecutionSchedulerTask(int priority, vtkExecutive *exec,
+                            vtkInformation *info)
   {
-    this->priority = _priority;
-    this->exec = _exec;
-    this->info = _info;
-  }
-  
-  int             priority;
-  vtkExecutive   *exec;
-  vtkInformation *info;
-};
-  
-//----------------------------------------------------------------------------
-class TaskWeakOrdering 
-{
-public:
-  bool operator()(const Task& t1,
-                  const Task& t2) const 
-  {
-    return t1.priority < t2.priority;
+    this->Priority = priority;
+    this->Exec = exec;
+    this->Info = info;
+    this->UnfinishedPredecessors = 0;
+    this->InputsReleased = 0;
+    this->HoldsResources = 0;
+    this->ReleasedResources = 0;
   }
+
+  int                                       Priority;
+  vtkExecutive                             *Exec;
+  vtkInformation                           *Info;
+  int                                       UnfinishedPredecessors;
+  int                                       InputsReleased;
+  int                                       HoldsResources;
+  int                                       ReleasedResources;
+  std::vector<vtkExecutionSchedulerTask*>   Successors;
 };
 
 //----------------------------------------------------------------------------
@@ -102,96 +104,88 @@ public:
   vtkExecutionScheduler*  Scheduler;
 
   // Some convenient type definitions for STL containers
-  typedef vtksys::hash_map<vtkExecutive*, int, 
+  typedef vtkExecutionSchedulerTask                     Task;
+  typedef std::vector<Task*>                            TaskVector;
+  typedef vtksys::hash_map<vtkExecutive*, TaskVector,
+    vtkExecutiveHasher>                                 ExecutiveTasksHashMap;
+  typedef vtksys::hash_map<vtkExecutive*, Task*,
+    vtkExecutiveHasher>                                 ExecutiveTaskHashMap;
+  typedef vtksys::hash_map<vtkExecutive*, int,
     vtkExecutiveHasher>                                 ExecutiveIntHashMap;
-  typedef std::pair<int, int>                        Edge;
-  class                                                 EdgeHasher;
-  typedef vtksys::hash_set<Edge, EdgeHasher>            EdgeSet;
-  typedef std::multiset<Task, TaskWeakOrdering>      TaskPriorityQueue;
-  typedef std::vector<vtkMutexLock*>                 MutexLockVector;
-  typedef std::vector<vtkThreadMessager*>            MessagerVector;
-  class EdgeHasher 
-  {
-  public:
-    size_t operator()(const Edge &e) const 
-    {
-      return (size_t)((e.first << 16) +  e.second);
-    }
-  };
 
-  vtkExecutiveSet           ExecutingTasks;
-  TaskPriorityQueue         PrioritizedTasks;
-  ExecutiveIntHashMap       DependencyNodes;
-  EdgeSet                   DependencyEdges;
-  MessagerVector            TaskDoneMessagers;
-  MutexLockVector           InputsReleasedLocks;
-  MessagerVector            InputsReleasedMessagers;
+  // Tasks not started yet, in the order they were scheduled
+  TaskVector                QueuedTasks;
+  // Tasks queued or running for each executive
+  ExecutiveTasksHashMap     UnfinishedTasks;
+  // The task running for each executive, if any
+  ExecutiveTaskHashMap      RunningTasks;
+  // Number of unfinished tasks that did not release their inputs
+  ExecutiveIntHashMap       HeldInputs;
   int                       CurrentPriority;
-  
+  int                       NumberOfRunningTasks;
+  int                       MaximumNumberOfRunningTasks;
+
   // Description:
-  // Start from the exec and go all the way up to the sources (modules
-  // without any inputs), then call TraverseDownToSink to update edges
-  void FindAndTraverseFromSources(vtkExecutive *exec, vtkExecutiveSet &visited);
-  
+  // Insert in upstream all the executives upstream of exec
+  static void CollectUpstream(vtkExecutive *exec, vtkExecutiveSet &upstream);
+
   // Description:
-  // Actual traverse down the network, for each nodes, construct and
-  // add edges connecting all of its upstream modules to itself to the
-  // dependency graph
-  void TraverseDownToSink(vtkExecutive *exec, vtkExecutiveSet &upstream,
-                          vtkExecutiveSet &visited);
-  
+  // Append exec, after the members of execs upstream of it, to order
+  static void TopologicalSort(vtkExecutive *exec, vtkExecutiveSet &execs,
+                              vtkExecutiveSet &visited,
+                              vtkExecutiveVector &order);
+
   // Description:
   // Actual traverse down the network, for each nodes, construct and
   // add edges connecting all of its upstream modules to itself to the
   // dependency graph
   void CollectDownToSink(vtkExecutive *exec, vtkExecutiveSet &visited,
                          vtkExecutiveVector &graph);
-  
-  // Description:
-  // A task can be executed if none of its predecessor tasks are still
-  // on the queue. This only makes sense for tasks that are currently
-  // on the queue, thus, an iterator is provided instead of the task
-  // itself.
-  bool CanExecuteTask(TaskPriorityQueue::const_iterator ti);
-  // Description:
-  // Spawn a thread to execute a module
-  void Execute(const Task &task);
 
   // Description:
-  // Check if the given exec is a new module or not. If it is then
-  // traverse the network to update dependency edges for its connected
-  // subgraph
-  void UpdateDependencyGraph(vtkExecutive *exec);
+  // Queue a task for each executive of execs, given in topological
+  // order.  Must be called with the ScheduleLock held.
+  void AddTasks(const vtkExecutiveVector &execs, vtkInformation *info);
 
   // Description:
-  // Add the module exec to the set of dependency nodes if it is not
-  // already there and return its node id number
-  int AddToDependencyGraph(vtkExecutive *exec);
+  // Run the ready task with the highest priority, if any, and return
+  // true if a task was run.  Workers (reserve is true) only run tasks
+  // whose resources they can reserve; threads waiting for tasks run
+  // tasks on the resources they already hold.  Must be called with the
+  // ScheduleLock held, which is released while the task executes.
+  bool RunReadyTask(bool reserve);
 
   // Description:
-  // Add the given executive to the execution queue for later
-  // execution
-  void AddToQueue(vtkExecutive *exec, vtkInformation *info);
-  
+  // Mark the inputs of a running task as released.  Must be called
+  // with the ScheduleLock held.
+  void ReleaseTaskInputs(Task *task);
+
   // Description:
   // Obtain the priority from the information object if it is given,
   // otherwise, use a priority assigned from the scheduler
   int AcquirePriority(vtkInformation *info);
+
+  // Description:
+  // Return the number of unfinished tasks of exec.  Must be called
+  // with the ScheduleLock held.
+  int GetNumberOfUnfinishedTasks(vtkExecutive *exec);
 };
 
 //----------------------------------------------------------------------------
 static vtkExecutionScheduler *globalScheduler = NULL;
-
-//----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ScheduleThread(void *data);
-void * vtkExecutionScheduler_ExecuteThread(void *data);
+static vtkSimpleCriticalSection globalSchedulerLock;
 
 //----------------------------------------------------------------------------
 vtkExecutionScheduler* vtkExecutionScheduler::GetGlobalScheduler()
 {
   if (!globalScheduler)
     {
-    globalScheduler = vtkExecutionScheduler::New();
+    globalSchedulerLock.Lock();
+    if (!globalScheduler)
+      {
+      globalScheduler = vtkExecutionScheduler::New();
+      }
+    globalSchedulerLock.Unlock();
     }
   return globalScheduler;
 }
@@ -202,24 +196,49 @@ vtkExecutionScheduler::vtkExecutionScheduler()
 {
   this->Resources = vtkComputingResources::New();
   this->Resources->ObtainMaximumResources();
-  this->ResourceMessager = vtkThreadMessager::New();
-  this->ScheduleLock = vtkMutexLock::New();
-  this->ScheduleMessager = vtkThreadMessager::New();
   this->ScheduleThreader = vtkMultiThreader::New();
-  this->ScheduleThreader->SetNumberOfThreads(1);
-  this->ScheduleThreadId = -1;
+  this->NumberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  this->NumberOfWorkers = 0;
+  for (int i = 0; i < VTK_MAX_THREADS; ++i)
+    {
+    this->WorkerIds[i] = -1;
+    }
+  this->ShuttingDown = 0;
+  this->ScheduleLock = new vtkSimpleMutexLock;
+  this->ScheduleCondition = new vtkSimpleConditionVariable;
   this->Implementation->Scheduler = this;
   this->Implementation->CurrentPriority = 0;
+  this->Implementation->NumberOfRunningTasks = 0;
+  this->Implementation->MaximumNumberOfRunningTasks = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkExecutionScheduler::~vtkExecutionScheduler()
 {
+  this->ScheduleLock->Lock();
+  this->ShuttingDown = 1;
+  this->ScheduleCondition->Broadcast();
+  this->ScheduleLock->Unlock();
+  for (int i = 0; i < this->NumberOfWorkers; ++i)
+    {
+    this->ScheduleThreader->TerminateThread(this->WorkerIds[i]);
+    }
+
+  // Tasks nobody waited for are simply dropped.
+  implementation::TaskVector &queued = this->Implementation->QueuedTasks;
+  for (size_t i = 0; i < queued.size(); ++i)
+    {
+    if (queued[i]->Info)
+      {
+      queued[i]->Info->UnRegister(this);
+      }
+    delete queued[i];
+    }
+
   this->Resources->Delete();
-  this->ResourceMessager->Delete();
-  this->ScheduleLock->Delete();
-  this->ScheduleMessager->Delete();
   this->ScheduleThreader->Delete();
+  delete this->ScheduleLock;
+  delete this->ScheduleCondition;
   delete this->Implementation;
 }
 
@@ -227,6 +246,61 @@ vtkExecutionScheduler::~vtkExecutionScheduler()
 void vtkExecutionScheduler::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "NumberOfWorkers: " << this->NumberOfWorkers << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionScheduler::SetNumberOfThreads(int num)
+{
+  num = (num < 1 ? 1 : (num > VTK_MAX_THREADS ? VTK_MAX_THREADS : num));
+  this->ScheduleLock->Lock();
+  if (this->NumberOfThreads == num)
+    {
+    this->ScheduleLock->Unlock();
+    return;
+    }
+  // Missing workers are spawned with the next tasks.  Extra workers are
+  // kept but stay idle: see RunReadyTask().
+  this->NumberOfThreads = num;
+  this->ScheduleLock->Unlock();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionScheduler::SpawnWorkers()
+{
+#if defined(VTK_USE_PTHREADS) || defined(VTK_USE_WIN32_THREADS)
+  // The threads waiting for tasks help, so the pool itself is one thread
+  // short of the requested number.
+  while (this->NumberOfWorkers < this->NumberOfThreads - 1)
+    {
+    int id = this->ScheduleThreader->SpawnThread(
+      (vtkThreadFunctionType)(&vtkExecutionScheduler::WorkerMain), this);
+    if (id < 0)
+      {
+      break;
+      }
+    this->WorkerIds[this->NumberOfWorkers++] = id;
+    }
+#endif
+}
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkExecutionScheduler::WorkerMain(void *data)
+{
+  vtkExecutionScheduler *self = static_cast<vtkExecutionScheduler*>
+    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
+  self->ScheduleLock->Lock();
+  while (!self->ShuttingDown)
+    {
+    if (!self->Implementation->RunReadyTask(true))
+      {
+      self->ScheduleCondition->Wait(*self->ScheduleLock);
+      }
+    }
+  self->ScheduleLock->Unlock();
+  return VTK_THREAD_RETURN_VALUE;
 }
 
 //----------------------------------------------------------------------------
@@ -255,101 +329,116 @@ void vtkExecutionScheduler::SchedulePropagate(vtkExecutiveCollection *execs, vtk
 //----------------------------------------------------------------------------
 void vtkExecutionScheduler::Schedule(vtkExecutiveCollection *execs, vtkInformation *info)
 {
-  if (this->ScheduleThreadId == -1)
+  vtkExecutiveSet closure;
+  execs->InitTraversal();
+  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem()) 
     {
-    this->ScheduleThreadId = this->ScheduleThreader->
-      SpawnThread((vtkThreadFunctionType)(vtkExecutionScheduler_ScheduleThread), this);
+    closure.insert(e);
+    implementation::CollectUpstream(e, closure);
     }
-  this->ScheduleLock->Lock();
-  vtkExecutiveVector G;
+
+  // The update passes below must not run concurrently with tasks of the
+  // same executives.
+  bool threaded = true;
+  vtkExecutiveSet::iterator it;
+  for (it = closure.begin(); it != closure.end(); ++it)
+    {
+    this->WaitForTaskDone(*it);
+    threaded = threaded && vtkThreadedStreamingPipeline::SafeDownCast(*it);
+    }
+
   execs->InitTraversal();
   for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem()) 
     {
-    if (this->Implementation->ExecutingTasks.find(e) != this->Implementation->ExecutingTasks.end())
+    // Executives that cannot be scheduled are updated in the calling
+    // thread, together with everything upstream of them.
+    if (!threaded)
       {
-      return;
+      e->Update();
+      continue;
       }
-    if (this->Implementation->DependencyNodes.find(e) == this->Implementation->DependencyNodes.end()) 
-      {
-      this->Implementation->UpdateDependencyGraph(e);
-      }
-    G.push_back(e);
+    vtkStreamingDemandDrivenPipeline *sddp =
+      vtkStreamingDemandDrivenPipeline::SafeDownCast(e);
+    sddp->UpdateInformation();
+    sddp->PropagateUpdateExtent(-1);
+    }
+  if (!threaded)
+    {
+    return;
     }
 
-  // Create an adjacency matrix
-  unsigned i, j, k, p;
-  unsigned N = (unsigned)G.size();
-  int *A = (int*)malloc(N*N*sizeof(int));
-  int *degree = (int*)malloc(N*sizeof(int));
-  memset(A, 0, N*N*sizeof(int));
-  memset(degree, 0, N*sizeof(int));
-  for (i = 0; i < N; i++) 
+  vtkExecutiveVector order;
+  vtkExecutiveSet visited;
+  for (it = closure.begin(); it != closure.end(); ++it)
     {
-    int src = (*(this->Implementation->DependencyNodes.find(G[i]))).second;
-    for (j = 0; j < N; j++) 
-      {
-      int dst = (*(this->Implementation->DependencyNodes.find(G[j]))).second;
-      if (this->Implementation->DependencyEdges.find(implementation::Edge(src, dst)) !=
-          this->Implementation->DependencyEdges.end()) 
-        {
-        A[i*N+j] = 1;
-        degree[j]++;
-        }
-      }
+    implementation::TopologicalSort(*it, closure, visited, order);
     }
-  
-  unsigned *S = (unsigned*)malloc(N*sizeof(unsigned));
-  k = 0;
-  for (j = 0; j < N; j++)
+  this->ScheduleLock->Lock();
+  this->Implementation->AddTasks(order, info);
+  this->ScheduleLock->Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionScheduler::ScheduleData(vtkExecutiveCollection *execs, vtkInformation *info)
+{
+  vtkExecutiveSet members;
+  execs->InitTraversal();
+  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem()) 
     {
-    if (degree[j] == 0)
+    if (!vtkThreadedStreamingPipeline::SafeDownCast(e))
       {
-      S[k++] = j;
+      vtkErrorMacro("Cannot schedule " << e->GetClassName()
+                    << ": only vtkThreadedStreamingPipeline executives "
+                    "can be scheduled.");
+      return;
       }
+    members.insert(e);
     }
-  p = 0;
-  while (p < k) 
+
+  vtkExecutiveVector order;
+  vtkExecutiveSet visited;
+  for (vtkExecutiveSet::iterator it = members.begin(); it != members.end(); ++it)
     {
-    i = S[p++];
-    this->Implementation->AddToQueue(G[i], info);
-    for (j = 0; j < N; j++)
-      if (A[i*N+j]) 
-        {
-        degree[j]--;
-        A[i*N+j] = 0;
-        if (degree[j] == 0)
-          {
-          S[k++] = j;
-          }
-        }
+    implementation::TopologicalSort(*it, members, visited, order);
     }
-  free(S);
-  free(degree);
-  free(A);
-        
-  // Wake the scheduling thread up if it is currently waiting for tasks
-  this->ScheduleMessager->SendWakeMessage();
+  this->ScheduleLock->Lock();
+  this->Implementation->AddTasks(order, info);
   this->ScheduleLock->Unlock();
-
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::UpdateDependencyGraph(vtkExecutive *exec)
+void vtkExecutionScheduler::implementation::CollectUpstream
+(vtkExecutive *exec, vtkExecutiveSet &upstream)
 {
-  vtkExecutiveSet visited;
-  this->FindAndTraverseFromSources(exec, visited);
+  for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i) 
+    {
+    int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
+    vtkInformationVector* inVector = exec->GetInputInformation()[i];
+    for(int j = 0; j < nic; ++j) 
+      {
+      vtkInformation* inInfo = inVector->GetInformationObject(j);
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
+      if (e && upstream.find(e) == upstream.end())
+        {
+        upstream.insert(e);
+        CollectUpstream(e, upstream);
+        }
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::FindAndTraverseFromSources
-(vtkExecutive *exec, vtkExecutiveSet &visited)
+void vtkExecutionScheduler::implementation::TopologicalSort
+(vtkExecutive *exec, vtkExecutiveSet &execs, vtkExecutiveSet &visited,
+ vtkExecutiveVector &order)
 {
   if (visited.find(exec) != visited.end())
     {
     return;
     }
   visited.insert(exec);
-  bool isSource = true;
   for(int i = 0; i < exec->GetNumberOfInputPorts(); ++i) 
     {
     int nic = exec->GetAlgorithm()->GetNumberOfInputConnections(i);
@@ -360,155 +449,226 @@ void vtkExecutionScheduler::implementation::FindAndTraverseFromSources
       vtkExecutive* e;
       int producerPort;
       vtkExecutive::PRODUCER()->Get(inInfo, e, producerPort);
-      if (e) 
+      if (e)
         {
-        isSource = false;
-        this->FindAndTraverseFromSources(e, visited);
+        TopologicalSort(e, execs, visited, order);
         }
       }
     }
-  if (isSource) 
+  if (execs.find(exec) != execs.end())
     {
-    vtkExecutiveSet upstream;
-    vtkExecutiveSet downVisited;
-    this->TraverseDownToSink(exec, upstream, downVisited);
+    order.push_back(exec);
     }
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::TraverseDownToSink
-(vtkExecutive *exec, vtkExecutiveSet &upstream, vtkExecutiveSet &visited)
+void vtkExecutionScheduler::implementation::CollectDownToSink
+(vtkExecutive *exec, vtkExecutiveSet &visited, vtkExecutiveVector &graph)
 {
   if (visited.find(exec)!=visited.end())
     {
     return;
     }
   
-  // Now mark all edges from upstream modules to exec as dependency edges
-  int vId = this->AddToDependencyGraph(exec);
-  for (vtkExecutiveSet::const_iterator it = upstream.begin(); it != upstream.end(); it++)
-    {
-    implementation::ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find(*it);
-    this->DependencyEdges.insert(Edge((*hit).second, vId));
-    }
-  
   // Mark as visited
   visited.insert(exec);
 
-  // Then insert it to the upstream list for going down
-  upstream.insert(exec);
+  // Add it to the ordered graph
+  graph.push_back(exec);
+
+  // Then traverse down
   for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i) 
     {
     vtkInformation* info = exec->GetOutputInformation(i);
     int consumerCount = vtkExecutive::CONSUMERS()->Length(info);
     vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(info);
     for (int j = 0; j < consumerCount; j++)
+      {
       if (e[j]) 
         {
-        this->TraverseDownToSink(e[j], upstream, visited);
+        this->CollectDownToSink(e[j], visited, graph);
         }
+      }
     }
-  
-  // Take it out of the upstream and prepare for back-tracking
-  upstream.erase(exec);
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::CollectDownToSink
-(vtkExecutive *exec, vtkExecutiveSet &visited, vtkExecutiveVector &graph)
+int vtkExecutionScheduler::implementation::AcquirePriority(vtkInformation * info)
 {
-  if (visited.find(exec)!=visited.end())
+  int priority;
+  if (info && info->Has(TASK_PRIORITY())) 
     {
-    return;
+    priority = info->Get(TASK_PRIORITY());
     }
-  
-  // Mark as visited
-  visited.insert(exec);
-
-  // Add it to the ordered graph
-  graph.push_back(exec);
+  else 
+    {
+    priority = this->CurrentPriority++;
+    }
+  return priority;
+}
 
-  // Then traverse down
-  for(int i = 0; i < exec->GetNumberOfOutputPorts(); ++i) 
+//----------------------------------------------------------------------------
+void vtkExecutionScheduler::implementation::AddTasks
+(const vtkExecutiveVector &execs, vtkInformation *info)
+{
+  for (size_t i = 0; i < execs.size(); ++i)
     {
-    vtkInformation* info = exec->GetOutputInformation(i);
-    int consumerCount = vtkExecutive::CONSUMERS()->Length(info);
-    vtkExecutive** e = vtkExecutive::CONSUMERS()->GetExecutives(info);
-    for (int j = 0; j < consumerCount; j++)
+    vtkExecutive *exec = execs[i];
+    Task *task = new Task(this->AcquirePriority(info), exec, info);
+    if (info)
       {
-      if (e[j]) 
+      info->Register(this->Scheduler);
+      }
+
+    // Depend on the unfinished tasks of this executive and of the
+    // executives upstream of it.  Those of the current batch have
+    // already been added since execs is sorted.
+    vtkExecutiveSet upstream;
+    upstream.insert(exec);
+    CollectUpstream(exec, upstream);
+    for (vtkExecutiveSet::iterator it = upstream.begin();
+         it != upstream.end(); ++it)
+      {
+      ExecutiveTasksHashMap::iterator hit = this->UnfinishedTasks.find(*it);
+      if (hit == this->UnfinishedTasks.end())
         {
-        this->CollectDownToSink(e[j], visited, graph);
+        continue;
+        }
+      TaskVector &predecessors = (*hit).second;
+      for (size_t j = 0; j < predecessors.size(); ++j)
+        {
+        predecessors[j]->Successors.push_back(task);
+        task->UnfinishedPredecessors++;
         }
       }
+
+    this->UnfinishedTasks[exec].push_back(task);
+    this->HeldInputs[exec]++;
+    this->QueuedTasks.push_back(task);
     }
+
+  this->Scheduler->SpawnWorkers();
+  this->Scheduler->ScheduleCondition->Broadcast();
 }
 
 //----------------------------------------------------------------------------
-int vtkExecutionScheduler::implementation::AddToDependencyGraph(vtkExecutive *exec)
+bool vtkExecutionScheduler::implementation::RunReadyTask(bool reserve)
 {
-  // We never remove vertices, it's ok to just return the size of
-  // DependencyGraph as a node id
-  implementation::ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find(exec);
-  // Check if this is a new module or an untouched sub-network
-  int vId = -1;
-  if (hit == this->DependencyNodes.end()) 
+  vtkExecutionScheduler *self = this->Scheduler;
+
+  // Look for the ready task with the highest priority whose resources
+  // are available.
+  Task *task = NULL;
+  size_t taskIndex = 0;
+  for (size_t i = 0; i < this->QueuedTasks.size(); ++i)
     {
-    vId = (int)this->DependencyNodes.size();
-    this->DependencyNodes[exec] = vId;
-    
-    // Make sure that we have enough thread messagers for this vId
-    while (this->TaskDoneMessagers.size()<=(size_t)vId)
+    Task *t = this->QueuedTasks[i];
+    if (t->UnfinishedPredecessors == 0 &&
+        this->RunningTasks.find(t->Exec) == this->RunningTasks.end() &&
+        (!task || t->Priority < task->Priority))
       {
-      this->TaskDoneMessagers.push_back(vtkThreadMessager::New());
+      task = t;
+      taskIndex = i;
       }
-    
-    while (this->InputsReleasedMessagers.size()<=(size_t)vId) 
+    }
+  if (!task)
+    {
+    return false;
+    }
+  // Workers do not exceed the number of threads, the threads waiting
+  // for their tasks always help so that they cannot starve.
+  if (reserve && this->NumberOfRunningTasks >= self->NumberOfThreads)
+    {
+    return false;
+    }
+  vtkThreadedStreamingPipeline *exec =
+    static_cast<vtkThreadedStreamingPipeline*>(task->Exec);
+  if (reserve)
+    {
+    if (!self->Resources->Reserve(exec->GetResources()))
       {
-      this->InputsReleasedMessagers.push_back(vtkThreadMessager::New());
-      this->InputsReleasedLocks.push_back(vtkMutexLock::New());
+      return false;
       }
+    task->HoldsResources = 1;
     }
-  // We have this module in our cache before
-  else 
+
+  this->QueuedTasks.erase(this->QueuedTasks.begin() + taskIndex);
+  this->RunningTasks[exec] = task;
+  if (++this->NumberOfRunningTasks > this->MaximumNumberOfRunningTasks)
     {
-    vId = (*hit).second;
+    this->MaximumNumberOfRunningTasks = this->NumberOfRunningTasks;
     }
-  return vId;
-}
+  self->ScheduleLock->Unlock();
 
-//----------------------------------------------------------------------------
-int vtkExecutionScheduler::implementation::AcquirePriority(vtkInformation * info)
-{
-  int priority;
-  if (info && info->Has(TASK_PRIORITY())) 
+  exec->GetResources()->Deploy(exec, task->Info);
+  exec->ForceUpdateData(vtkThreadedStreamingPipeline::PROCESSING_UNIT_CPU,
+                        task->Info);
+  exec->UpdateRequestDataTimeFromSource();
+  if (task->Info &&
+      task->Info->Has(vtkThreadedStreamingPipeline::AUTO_PROPAGATE()))
     {
-    priority = info->Get(TASK_PRIORITY());
+    exec->ReleaseInputs();
+    exec->Push(task->Info);
     }
-  else 
+
+  self->ScheduleLock->Lock();
+  if (task->HoldsResources)
     {
-    priority = this->CurrentPriority++;
+    self->Resources->Collect(exec->GetResources());
     }
-  return priority;
+  this->ReleaseTaskInputs(task);
+  for (size_t i = 0; i < task->Successors.size(); ++i)
+    {
+    task->Successors[i]->UnfinishedPredecessors--;
+    }
+  TaskVector &unfinished = this->UnfinishedTasks[exec];
+  for (TaskVector::iterator ti = unfinished.begin(); ti != unfinished.end(); ++ti)
+    {
+    if (*ti == task)
+      {
+      unfinished.erase(ti);
+      break;
+      }
+    }
+  if (unfinished.empty())
+    {
+    this->UnfinishedTasks.erase(exec);
+    this->HeldInputs.erase(exec);
+    }
+  this->RunningTasks.erase(exec);
+  this->NumberOfRunningTasks--;
+  if (task->Info)
+    {
+    task->Info->UnRegister(self);
+    }
+  delete task;
+  self->ScheduleCondition->Broadcast();
+  return true;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::AddToQueue(vtkExecutive *exec, vtkInformation * info)
+void vtkExecutionScheduler::implementation::ReleaseTaskInputs(Task *task)
 {
-  int priority = this->AcquirePriority(info);
-  this->PrioritizedTasks.insert(Task(priority, exec, info));
-  vtkMutexLock *lock = this->Scheduler->GetInputsReleasedLock(exec);
-  if (lock) 
+  if (!task->InputsReleased)
     {
-//     fprintf(stderr, "A %s\n", exec->GetAlgorithm()->GetClassName());
-    lock->Lock();
+    task->InputsReleased = 1;
+    this->HeldInputs[task->Exec]--;
+    this->Scheduler->ScheduleCondition->Broadcast();
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkExecutionScheduler::implementation::GetNumberOfUnfinishedTasks
+(vtkExecutive *exec)
+{
+  ExecutiveTasksHashMap::iterator hit = this->UnfinishedTasks.find(exec);
+  return (hit == this->UnfinishedTasks.end() ?
+          0 : static_cast<int>((*hit).second.size()));
+}
+
 //----------------------------------------------------------------------------
 void vtkExecutionScheduler::WaitUntilDone(vtkExecutiveCollection *execs)
 {
-  vtkExecutiveSet::const_iterator it;
   execs->InitTraversal();
   for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem()) 
     {
@@ -519,24 +679,20 @@ void vtkExecutionScheduler::WaitUntilDone(vtkExecutiveCollection *execs)
 //----------------------------------------------------------------------------
 void vtkExecutionScheduler::WaitUntilAllDone()
 {
-  while (true) 
+  this->ScheduleLock->Lock();
+  while (!this->Implementation->UnfinishedTasks.empty())
     {
-    vtkExecutive *exec = NULL;
-    this->ScheduleLock->Lock();
-    if (this->Implementation->PrioritizedTasks.size() > 0)
-      exec = (*(this->Implementation->PrioritizedTasks.begin())).exec;
-    this->ScheduleLock->Unlock();
-    if (exec)
-      this->WaitForTaskDone(exec);
-    else
-      break;
+    if (!this->Implementation->RunReadyTask(false))
+      {
+      this->ScheduleCondition->Wait(*this->ScheduleLock);
+      }
     }
+  this->ScheduleLock->Unlock();
 }
 
 //----------------------------------------------------------------------------
 void vtkExecutionScheduler::WaitUntilReleased(vtkExecutiveCollection *execs)
 {
-  vtkExecutiveSet::const_iterator it;
   execs->InitTraversal();
   for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem())
     {
@@ -547,143 +703,118 @@ void vtkExecutionScheduler::WaitUntilReleased(vtkExecutiveCollection *execs)
 //----------------------------------------------------------------------------
 void vtkExecutionScheduler::WaitForTaskDone(vtkExecutive *exec)
 {
-  vtkThreadMessager *messager = this->GetTaskDoneMessager(exec);
-  if (messager)
-    messager->WaitForMessage();
+  this->ScheduleLock->Lock();
+  while (this->Implementation->GetNumberOfUnfinishedTasks(exec) > 0)
+    {
+    if (!this->Implementation->RunReadyTask(false))
+      {
+      this->ScheduleCondition->Wait(*this->ScheduleLock);
+      }
+    }
+  this->ScheduleLock->Unlock();
 }
 
 //----------------------------------------------------------------------------
 void vtkExecutionScheduler::WaitForInputsReleased(vtkExecutive *exec)
 {
-  vtkMutexLock *lock = this->GetInputsReleasedLock(exec);
-  if (lock) 
+  this->ScheduleLock->Lock();
+  for (;;)
     {
-    lock->Lock();
-    lock->Unlock();
+    implementation::ExecutiveIntHashMap::iterator hit =
+      this->Implementation->HeldInputs.find(exec);
+    if (hit == this->Implementation->HeldInputs.end() || (*hit).second == 0)
+      {
+      break;
+      }
+    if (!this->Implementation->RunReadyTask(false))
+      {
+      this->ScheduleCondition->Wait(*this->ScheduleLock);
+      }
     }
-//   vtkThreadMessager *messager = this->GetInputsReleasedMessager(exec);
-//   if (messager)
-//     messager->WaitForMessage();
+  this->ScheduleLock->Unlock();
 }
 
 //----------------------------------------------------------------------------
-vtkThreadMessager* vtkExecutionScheduler::GetTaskDoneMessager(vtkExecutive *exec)
+void vtkExecutionScheduler::ReleaseInputs(vtkExecutive *exec)
 {
-  implementation::ExecutiveIntHashMap::iterator hit = 
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end()) 
+  this->ScheduleLock->Lock();
+  implementation::ExecutiveTaskHashMap::iterator hit =
+    this->Implementation->RunningTasks.find(exec);
+  if (hit != this->Implementation->RunningTasks.end())
     {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++) 
-      {
-      if ((*ti).exec==exec)
-        {
-        return this->Implementation->TaskDoneMessagers[(*hit).second];
-        }
-      }
+    this->Implementation->ReleaseTaskInputs((*hit).second);
     }
-  return NULL;
+  this->ScheduleLock->Unlock();
 }
 
 //----------------------------------------------------------------------------
-vtkMutexLock* vtkExecutionScheduler::GetInputsReleasedLock(vtkExecutive *exec)
+int vtkExecutionScheduler::GetNumberOfPendingTasks()
 {
-  implementation::ExecutiveIntHashMap::iterator hit = 
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end()) 
-    {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++) 
-      {
-      if ((*ti).exec == exec)
-        {
-        return this->Implementation->InputsReleasedLocks[(*hit).second];
-        }
-      }
-    }
-  return NULL;
+  this->ScheduleLock->Lock();
+  int num = static_cast<int>(this->Implementation->QueuedTasks.size()) +
+    this->Implementation->NumberOfRunningTasks;
+  this->ScheduleLock->Unlock();
+  return num;
 }
 
 //----------------------------------------------------------------------------
-vtkThreadMessager* vtkExecutionScheduler::GetInputsReleasedMessager(vtkExecutive *exec)
+int vtkExecutionScheduler::GetMaximumNumberOfConcurrentTasks()
 {
-  implementation::ExecutiveIntHashMap::iterator hit = 
-    this->Implementation->DependencyNodes.find(exec);
-  if (hit != this->Implementation->DependencyNodes.end()) 
-    {
-    implementation::TaskPriorityQueue::const_iterator ti;
-    for (ti = this->Implementation->PrioritizedTasks.begin();
-         ti != this->Implementation->PrioritizedTasks.end(); ti++) 
-      {
-      if ((*ti).exec==exec)
-        {
-        return this->Implementation->InputsReleasedMessagers[(*hit).second];
-        }
-      }
-    }
-  return NULL;
+  this->ScheduleLock->Lock();
+  int num = this->Implementation->MaximumNumberOfRunningTasks;
+  this->ScheduleLock->Unlock();
+  return num;
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::ReleaseResources(vtkExecutive *exec)
+void vtkExecutionScheduler::ResetStatistics()
 {
-  vtkThreadedStreamingPipeline *threadedExec = vtkThreadedStreamingPipeline::
-    SafeDownCast(exec);
-  if (threadedExec) 
-    {
-    this->ScheduleLock->Lock();
-    this->Resources->Collect(threadedExec->GetResources());
-    this->ResourceMessager->SendWakeMessage();
-    this->ScheduleLock->Unlock();
-    }
+  this->ScheduleLock->Lock();
+  this->Implementation->MaximumNumberOfRunningTasks =
+    this->Implementation->NumberOfRunningTasks;
+  this->ScheduleLock->Unlock();
 }
 
 //----------------------------------------------------------------------------
-void vtkExecutionScheduler::ReacquireResources(vtkExecutive *exec)
+void vtkExecutionScheduler::ReleaseResources(vtkExecutive *exec)
 {
-  vtkThreadedStreamingPipeline *threadedExec = vtkThreadedStreamingPipeline::
-    SafeDownCast(exec);
-  if (threadedExec) 
+  // Only a running task holds resources.
+  this->ScheduleLock->Lock();
+  implementation::ExecutiveTaskHashMap::iterator hit =
+    this->Implementation->RunningTasks.find(exec);
+  if (hit != this->Implementation->RunningTasks.end() &&
+      (*hit).second->HoldsResources)
     {
-    while (!this->Resources->Reserve(threadedExec->GetResources())) 
-      {
-      this->ResourceMessager->WaitForMessage();
-      }
+    vtkThreadedStreamingPipeline *threadedExec =
+      static_cast<vtkThreadedStreamingPipeline*>(exec);
+    this->Resources->Collect(threadedExec->GetResources());
+    (*hit).second->HoldsResources = 0;
+    (*hit).second->ReleasedResources = 1;
+    this->ScheduleCondition->Broadcast();
     }
+  this->ScheduleLock->Unlock();
 }
 
 //----------------------------------------------------------------------------
-bool vtkExecutionScheduler::implementation::CanExecuteTask
-(TaskPriorityQueue::const_iterator taskIter)
+void vtkExecutionScheduler::ReacquireResources(vtkExecutive *exec)
 {
-  if (this->ExecutingTasks.find((*taskIter).exec) != this->ExecutingTasks.end())
-    {
-    return false;
-    }
-  ExecutiveIntHashMap::iterator hit = this->DependencyNodes.find((*taskIter).exec);
-  if (hit == this->DependencyNodes.end())
-    {
-    return true;
-    }
-  int dst = (*hit).second;
-  TaskPriorityQueue::const_iterator ti;
-  for (ti = this->PrioritizedTasks.begin();
-       ti != taskIter; ti++)
-    {
-    if ((*ti).priority > (*taskIter).priority)
-      {
-      break;
-      }
-    hit = this->DependencyNodes.find((*ti).exec);
-    int src = (*hit).second;
-    if (this->DependencyEdges.find(Edge(src, dst)) != this->DependencyEdges.end())
+  this->ScheduleLock->Lock();
+  implementation::ExecutiveTaskHashMap::iterator hit =
+    this->Implementation->RunningTasks.find(exec);
+  if (hit != this->Implementation->RunningTasks.end() &&
+      (*hit).second->ReleasedResources)
+    {
+    implementation::Task *task = (*hit).second;
+    vtkThreadedStreamingPipeline *threadedExec =
+      static_cast<vtkThreadedStreamingPipeline*>(exec);
+    while (!this->Resources->Reserve(threadedExec->GetResources()))
       {
-      return false;
+      this->ScheduleCondition->Wait(*this->ScheduleLock);
       }
+    task->ReleasedResources = 0;
+    task->HoldsResources = 1;
     }
-  return true;
+  this->ScheduleLock->Unlock();
 }
 
 //----------------------------------------------------------------------------
@@ -722,8 +853,13 @@ void vtkExecutionScheduler::RescheduleFrom(vtkExecutive *exec,
     };
   for (size_t i = 0; i < upstream.size(); i++) 
     {
-    float ratio = vtkThreadedStreamingPipeline::
-      SafeDownCast(upstream[i])->LastDataRequestTimeFromSource/totalUpStreamTime;
+    // Share evenly between branches that have never executed.
+    float ratio = 1.0f / upstream.size();
+    if (totalUpStreamTime > 0.0f)
+      {
+      ratio = vtkThreadedStreamingPipeline::
+        SafeDownCast(upstream[i])->LastDataRequestTimeFromSource/totalUpStreamTime;
+      }
     for (size_t j = 0; j < sizeof(totalResources)/sizeof(vtkProcessingUnitResource*); j++) 
       {
       vtkProcessingUnitResource* moduleResource = vtkThreadedStreamingPipeline::
@@ -745,7 +881,9 @@ void vtkExecutionScheduler::RescheduleFrom(vtkExecutive *exec,
 //----------------------------------------------------------------------------
 void vtkExecutionScheduler::RescheduleNetwork(vtkExecutive *sink) 
 {
+  this->ScheduleLock->Lock();
   this->Resources->ObtainMaximumResources();
+  this->ScheduleLock->Unlock();
   this->RescheduleFrom(sink, this->Resources);
 }
 
@@ -762,91 +900,6 @@ void vtkExecutionScheduler::ClassFinalize()
   if (globalScheduler)
     {
     globalScheduler->FastDelete();
+    globalScheduler = NULL;
     }
 }
-
-//----------------------------------------------------------------------------
-typedef struct 
-{
-  vtkExecutionScheduler *scheduler;
-  Task task;
-} ExecutionData;
-//----------------------------------------------------------------------------
-void vtkExecutionScheduler::implementation::Execute(const Task &task)
-{
-  ExecutionData *eData = new ExecutionData();
-  eData->scheduler = this->Scheduler;
-  eData->task = task;
-  this->Scheduler->ScheduleThreader->SpawnThread((vtkThreadFunctionType)(vtkExecutionScheduler_ExecuteThread), eData);
-}
-
-//----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ScheduleThread(void *data)
-{
-  vtkExecutionScheduler *self = static_cast<vtkExecutionScheduler*>
-    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
-  while (true) 
-    {
-    self->ScheduleLock->Lock();
-    bool needToWait = true;
-    vtkExecutionScheduler::implementation::TaskPriorityQueue::iterator ti;
-    for (ti = self->Implementation->PrioritizedTasks.begin();
-         ti != self->Implementation->PrioritizedTasks.end(); ti++) 
-      {
-      if (self->Implementation->CanExecuteTask(ti)) 
-        {
-        vtkThreadedStreamingPipeline *exec = vtkThreadedStreamingPipeline::
-          SafeDownCast((*ti).exec);
-        if (self->Resources->Reserve(exec->GetResources())) 
-          {
-          needToWait = false;
-          self->Implementation->ExecutingTasks.insert(exec);
-          self->ScheduleLock->Unlock();
-          self->Implementation->Execute(*ti);
-          break;
-          }
-        }
-      }
-    if (needToWait) 
-      {
-      self->ScheduleLock->Unlock();
-      self->ScheduleMessager->WaitForMessage();
-      }
-    }
-  return NULL;
-}
-
-//----------------------------------------------------------------------------
-void * vtkExecutionScheduler_ExecuteThread(void *data)
-{
-  ExecutionData *eData = static_cast<ExecutionData*>
-    (static_cast<vtkMultiThreader::ThreadInfo*>(data)->UserData);
-  vtkExecutionScheduler *self = eData->scheduler;
-  Task task = eData->task;
-  vtkThreadedStreamingPipeline *exec = vtkThreadedStreamingPipeline::
-    SafeDownCast(task.exec);
-  vtkThreadMessager *messager = self->GetTaskDoneMessager(task.exec);
-  vtkMutexLock *lock = self->GetInputsReleasedLock(task.exec);
-  exec->GetResources()->Deploy(exec, task.info);
-  self->ScheduleLock->Lock();
-  self->Implementation->PrioritizedTasks.erase(task);
-  self->Implementation->ExecutingTasks.erase(exec);
-  self->Resources->Collect(exec->GetResources());
-  self->ResourceMessager->SendWakeMessage();
-  self->ScheduleLock->Unlock();
-  exec->ReleaseInputs();
-  self->ScheduleMessager->SendWakeMessage();
-  if (task.info && task.info->Has(vtkThreadedStreamingPipeline::AUTO_PROPAGATE()))
-    {
-      fprintf(stderr, "Push DOWN from %s\n", exec->GetAlgorithm()->GetClassName());
-    exec->Push(task.info);
-    }
-  if (messager)
-    {
-    messager->SendWakeMessage();
-    }
-  delete eData;
-  fprintf(stderr, "Release now\n");
-  lock->Unlock();
-  return NULL;
-}
@@ -31,7 +31,17 @@
 // thread/computing resources distributing
 // .SECTION Description
 // This is a class for balancing the computing resources throughout
-// the network
+// the network.  Executives handed to Schedule() become tasks that are
+// run in dependency order by a bounded pool of worker threads: a task
+// starts once every task scheduled for its upstream executives is done
+// and the scheduler can reserve the computing resources of its
+// executive.  Independent branches of a pipeline, and the upstream
+// branches of each streamed piece, therefore execute concurrently.
+//
+// Threads that wait for tasks (in WaitUntilDone() and friends) run
+// ready tasks themselves instead of sleeping.  This lets tasks wait for
+// other tasks, e.g. when an algorithm updates an internal pipeline, on
+// any number of threads without deadlocking the pool.
 
 // .SECTION See Also
 // vtkComputingResources vtkThreadedStreamingPipeline
@@ -45,8 +55,8 @@
 class vtkExecutive;
 class vtkComputingResources;
 class vtkMultiThreader;
-class vtkMutexLock;
-class vtkThreadMessager;
+class vtkSimpleConditionVariable;
+class vtkSimpleMutexLock;
 class vtkInformation;
 class vtkInformationIntegerKey;
 class vtkExecutiveCollection;
@@ -66,11 +76,31 @@ public:
   // Key to store the priority of a task
   static vtkInformationIntegerKey* TASK_PRIORITY();
 
+  // Description:
+  // Set/Get the number of threads executing tasks, the threads waiting
+  // for tasks included: NumberOfThreads-1 workers are spawned.  The
+  // value is clamped to 1 - VTK_MAX_THREADS.  Lowering it leaves the
+  // extra workers idle.  The default is given by
+  // vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+  void SetNumberOfThreads(int num);
+  vtkGetMacro(NumberOfThreads, int);
+
   // Description:  
   // Put the current set of executives (modules) to the be scheduled given its
   // dependency graph which will be used to compute the set
-  // topological orders
+  // topological orders.  The REQUEST_INFORMATION and
+  // REQUEST_UPDATE_EXTENT passes are sent to the executives on the
+  // calling thread, then every executive upstream of them is scheduled
+  // for its REQUEST_DATA.
   void Schedule(vtkExecutiveCollection *execs, vtkInformation *info);
+
+  // Description:
+  // Schedule a REQUEST_DATA on the given executives only.  The caller
+  // must have sent the REQUEST_INFORMATION and REQUEST_UPDATE_EXTENT
+  // passes through them and must include every executive upstream of
+  // them that may need to execute.  This is how
+  // vtkThreadedStreamingPipeline updates its inputs.
+  void ScheduleData(vtkExecutiveCollection *execs, vtkInformation *info);
   
   // Description:
   // Put the current set of executives (modules) to the be scheduled
@@ -92,8 +122,7 @@ public:
   
   // Description:
   // Wait for a task that is on the scheduling queue to be done. If
-  // the task is not there, this will return immediately. If the exec
-  // is NULL, any task that is done will trigger this the return
+  // the task is not there, this will return immediately.
   void WaitForTaskDone(vtkExecutive *exec);
   
   // Description:
@@ -101,21 +130,22 @@ public:
   // of a task are released instead of done computing. But exec cannot
   // be NULL.
   void WaitForInputsReleased(vtkExecutive *exec);
-  
+
   // Description:
-  // Return the thread messager reserved for the given exec to notify
-  // when it is done
-  vtkThreadMessager* GetTaskDoneMessager(vtkExecutive *exec);
+  // Tell the scheduler that the task running the given executive no
+  // longer needs its inputs.  This is done automatically when the task
+  // is done.
+  void ReleaseInputs(vtkExecutive *exec);
 
   // Description:
-  // Return the thread messager reserved for the given exec to notify
-  // when it releases its inputs
-  vtkThreadMessager* GetInputsReleasedMessager(vtkExecutive *exec);
+  // Return the number of tasks queued or running.
+  int GetNumberOfPendingTasks();
 
   // Description:
-  // Return the mutex lock reserved for the given exec to notify
-  // when it releases its inputs
-  vtkMutexLock* GetInputsReleasedLock(vtkExecutive *exec);
+  // Return the largest number of tasks that ran at the same time since
+  // the scheduler was created or ResetStatistics() was called.
+  int GetMaximumNumberOfConcurrentTasks();
+  void ResetStatistics();
 
   // Description:
   // Release the resources that are being used by the given exec
@@ -140,27 +170,32 @@ protected:
   ~vtkExecutionScheduler();
 
   vtkComputingResources       *Resources;
-  vtkThreadMessager           *ScheduleMessager;
-  vtkThreadMessager           *ResourceMessager;
-  vtkMutexLock                *ScheduleLock;
   vtkMultiThreader            *ScheduleThreader;
-  int                          ScheduleThreadId;
+  int                          NumberOfThreads;
+  int                          NumberOfWorkers;
+  int                          WorkerIds[VTK_MAX_THREADS];
+  int                          ShuttingDown;
+
+  // Guards the task queue and the resources.  The condition variable is
+  // broadcast whenever a task is queued or finished, inputs are
+  // released or resources are collected.
+  vtkSimpleMutexLock          *ScheduleLock;
+  vtkSimpleConditionVariable  *ScheduleCondition;
 
 //BTX
   class implementation;
   implementation* const Implementation;
   friend class implementation;
 
-  // Description:  
-  // The scheduling thread that is responsible for queueing up module
-  // execution in the right order
-  friend void * vtkExecutionScheduler_ScheduleThread(void *data);
+  // Description:
+  // Spawn the worker threads if they do not exist yet.  Must be called
+  // with the ScheduleLock held.
+  void SpawnWorkers();
 
   // Description:  
-  // Execute thread function that is responsible for forking process
-  // for each module
-  friend void * vtkExecutionScheduler_ExecuteThread(void *data);
-
+  // Main function of the worker threads: run ready tasks until the
+  // scheduler is destroyed.
+  static VTK_THREAD_RETURN_TYPE WorkerMain(void *data);
 //ETX
 
   // Description: Functions and friend class to take care of initialization
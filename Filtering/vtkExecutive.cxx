@@ -25,6 +25,7 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <vector>
@@ -742,11 +743,27 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   // Copy default information in the direction of information flow.
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
+  // Record the request if the pipeline is being profiled.
+  vtkPipelineProfiler* profiler =
+    vtkPipelineProfiler::RegisterActiveProfiler(this);
+  vtkIdType event = -1;
+  if(profiler)
+    {
+    event = profiler->BeginRequest(this->Algorithm, request);
+    }
+
   // Invoke the request on the algorithm.
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
 
+  if(profiler)
+    {
+    profiler->EndRequest(event, this->GetNumberOfInputPorts(), inInfo,
+                          outInfo);
+    profiler->UnRegister(this);
+    }
+
   // If the algorithm failed report it now.
   if(!result)
     {
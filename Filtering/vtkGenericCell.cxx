@@ -58,13 +58,24 @@ vtkStandardNewMacro(vtkGenericCell);
 // Construct cell.
 vtkGenericCell::vtkGenericCell()
 {
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+    {
+    this->Cells[i] = NULL;
+    }
   this->Cell = vtkEmptyCell::New();
+  this->Cells[VTK_EMPTY_CELL] = this->Cell;
 }  
 
 //----------------------------------------------------------------------------
 vtkGenericCell::~vtkGenericCell()
 {
-  this->Cell->Delete();
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+    {
+    if (this->Cells[i])
+      {
+      this->Cells[i]->Delete();
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -359,14 +370,23 @@ void vtkGenericCell::SetCellType(int cellType)
     this->Points->UnRegister(this);
     this->PointIds->UnRegister(this);
     this->PointIds = NULL;
-    this->Cell->Delete();
 
-    vtkCell *cell = vtkGenericCell::InstantiateCell(cellType);
+    // Reuse the cell of that type if this generic cell already had one.
+    vtkCell *cell = NULL;
+    if (cellType >= 0 && cellType < VTK_NUMBER_OF_CELL_TYPES)
+      {
+      cell = this->Cells[cellType];
+      if (!cell)
+        {
+        cell = this->Cells[cellType] =
+          vtkGenericCell::InstantiateCell(cellType);
+        }
+      }
 
     if( !cell )
       {
       vtkErrorMacro( << "Unsupported cell type! Setting to vtkEmptyCell" );
-      cell = vtkEmptyCell::New();
+      cell = this->Cells[VTK_EMPTY_CELL];
       }
 
     this->Cell = cell;
@@ -20,6 +20,10 @@
 // like any type of cell, it just dereferences an internal representation.
 // The SetCellType() methods use \#define constants; these are defined in
 // the file vtkCellType.h.
+//
+// The cells of each type a vtkGenericCell took are kept, so that going
+// through a dataset mixing several types of cells does not create and
+// delete a cell, with its points and ids, at every change of type.
 
 // .SECTION See Also
 // vtkCell vtkDataSet
@@ -140,6 +144,7 @@ protected:
   ~vtkGenericCell();
 
   vtkCell *Cell;
+  vtkCell *Cells[VTK_NUMBER_OF_CELL_TYPES];  // by type, Cell included
 
 private:
   vtkGenericCell(const vtkGenericCell&);  // Not implemented.
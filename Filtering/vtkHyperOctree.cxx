@@ -2376,6 +2376,24 @@ void vtkHyperOctree::BuildLinks()
   this->Links->Delete();
 }
 
+//-----------------------------------------------------------------------------
+void vtkHyperOctree::PrepareForThreadedAccess()
+{
+  this->Superclass::PrepareForThreadedAccess();
+  if (this->DualGridFlag)
+    {
+    this->UpdateDualArrays();
+    }
+  else
+    {
+    this->UpdateGridArrays();
+    }
+  if (!this->Links)
+    {
+    this->BuildLinks();
+    }
+}
+
   
 //-----------------------------------------------------------------------------
 // This is exactly the same as GetCellNeighbors in unstructured grid.
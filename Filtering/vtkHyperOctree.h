@@ -364,6 +364,12 @@ public:
   // This is the number of points of a cell.
   // THIS METHOD IS THREAD SAFE
   virtual int GetMaxCellSize();
+
+  // Description:
+  // Also builds the dual or the grid arrays, depending on DualGridFlag,
+  // and the cell links. See vtkDataSet.
+  // THIS METHOD IS NOT THREAD SAFE.
+  virtual void PrepareForThreadedAccess();
   
   // Description:
   // Shallow and Deep copy.
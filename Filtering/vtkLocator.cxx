@@ -42,6 +42,11 @@ void vtkLocator::Initialize()
   this->FreeSearchStructure();
 }
 
+unsigned long vtkLocator::GetActualMemorySize()
+{
+  return 0;
+}
+
 void vtkLocator::Update()
 {
   if (!this->DataSet)
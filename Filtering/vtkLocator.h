@@ -122,6 +122,12 @@ public:
   // Return the time of the last data structure build.
   vtkGetMacro(BuildTime, unsigned long);
 
+  // Description:
+  // Return the memory in kilobytes used by the search structure, 0 if it
+  // is not built.  The default, for locators which do not account for
+  // their structure, is 0.
+  virtual unsigned long GetActualMemorySize();
+
   // Description:
   // Handle the PointSet <-> Locator loop.
   virtual void Register(vtkObjectBase *o);
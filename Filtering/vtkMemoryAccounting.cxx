@@ -0,0 +1,317 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryAccounting.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryAccounting.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithm.h"
+#include "vtkAlgorithmOutput.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <vtksys/ios/sstream>
+
+vtkStandardNewMacro(vtkMemoryAccounting);
+
+//----------------------------------------------------------------------------
+struct vtkMemoryAccountingEntry
+{
+  std::string Owner;
+  std::string Name;
+  unsigned long Size;
+};
+
+class vtkMemoryAccountingInternals
+{
+public:
+  std::vector<vtkMemoryAccountingEntry> Entries;
+  std::set<vtkObjectBase *> Counted;
+  std::vector<std::string> Names;
+  std::string Owner;
+};
+
+//----------------------------------------------------------------------------
+vtkMemoryAccounting::vtkMemoryAccounting()
+{
+  this->Internals = new vtkMemoryAccountingInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryAccounting::~vtkMemoryAccounting()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::Reset()
+{
+  this->Internals->Entries.clear();
+  this->Internals->Counted.clear();
+  this->Internals->Names.clear();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::AddDataObject(vtkDataObject *data, const char *owner)
+{
+  if (!data)
+    {
+    return;
+    }
+  if (owner)
+    {
+    this->Internals->Owner = owner;
+    }
+  else
+    {
+    vtksys_ios::ostringstream name;
+    name << data->GetClassName() << "(" << data << ")";
+    this->Internals->Owner = name.str();
+    }
+  this->Internals->Names.clear();
+  data->ReportMemory(this);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+// Add the outputs of the algorithm after those of its producers.
+static void vtkMemoryAccountingAddAlgorithm(vtkMemoryAccounting *self,
+                                            vtkAlgorithm *algorithm,
+                                            std::set<vtkAlgorithm *> &visited)
+{
+  if (!algorithm || !visited.insert(algorithm).second)
+    {
+    return;
+    }
+  int port, i;
+  for (port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+    {
+    for (i = 0; i < algorithm->GetNumberOfInputConnections(port); ++i)
+      {
+      vtkAlgorithmOutput *connection = algorithm->GetInputConnection(port, i);
+      if (connection)
+        {
+        vtkMemoryAccountingAddAlgorithm(self, connection->GetProducer(),
+                                        visited);
+        }
+      }
+    }
+
+  vtkExecutive *executive = algorithm->GetExecutive();
+  for (port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port)
+    {
+    vtkInformation *info = executive->GetOutputInformation(port);
+    vtkDataObject *output = info ? info->Get(vtkDataObject::DATA_OBJECT()) : 0;
+    if (output)
+      {
+      vtksys_ios::ostringstream owner;
+      owner << algorithm->GetClassName() << "(" << algorithm << "):" << port;
+      self->AddDataObject(output, owner.str().c_str());
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::AddPipeline(vtkAlgorithm *algorithm)
+{
+  std::set<vtkAlgorithm *> visited;
+  vtkMemoryAccountingAddAlgorithm(this, algorithm, visited);
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::Report(vtkObjectBase *object, const char *name,
+                                 unsigned long size)
+{
+  if (!object || !this->Internals->Counted.insert(object).second)
+    {
+    return;
+    }
+  vtkMemoryAccountingEntry entry;
+  entry.Owner = this->Internals->Owner;
+  for (size_t i = 0; i < this->Internals->Names.size(); ++i)
+    {
+    entry.Name += this->Internals->Names[i] + "/";
+    }
+  entry.Name += name ? name : "";
+  entry.Size = size;
+  this->Internals->Entries.push_back(entry);
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::ReportFieldData(vtkFieldData *fieldData,
+                                          const char *name)
+{
+  if (!fieldData)
+    {
+    return;
+    }
+  this->PushName(name);
+  for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
+    {
+    vtkAbstractArray *array = fieldData->GetAbstractArray(i);
+    if (!array)
+      {
+      continue;
+      }
+    if (array->GetName())
+      {
+      this->Report(array, array->GetName(), array->GetActualMemorySize());
+      }
+    else
+      {
+      vtksys_ios::ostringstream arrayName;
+      arrayName << "Array " << i;
+      this->Report(array, arrayName.str().c_str(),
+                   array->GetActualMemorySize());
+      }
+    }
+  this->PopName();
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::PushName(const char *name)
+{
+  this->Internals->Names.push_back(name ? name : "");
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::PopName()
+{
+  if (!this->Internals->Names.empty())
+    {
+    this->Internals->Names.pop_back();
+    }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMemoryAccounting::GetTotalSize()
+{
+  unsigned long size = 0;
+  for (size_t i = 0; i < this->Internals->Entries.size(); ++i)
+    {
+    size += this->Internals->Entries[i].Size;
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMemoryAccounting::GetOwnerSize(const char *owner)
+{
+  unsigned long size = 0;
+  for (size_t i = 0; owner && i < this->Internals->Entries.size(); ++i)
+    {
+    if (this->Internals->Entries[i].Owner == owner)
+      {
+      size += this->Internals->Entries[i].Size;
+      }
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryAccounting::GetNumberOfEntries()
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+const char *vtkMemoryAccounting::GetEntryOwner(int i)
+{
+  if (i < 0 || i >= this->GetNumberOfEntries())
+    {
+    return 0;
+    }
+  return this->Internals->Entries[i].Owner.c_str();
+}
+
+//----------------------------------------------------------------------------
+const char *vtkMemoryAccounting::GetEntryName(int i)
+{
+  if (i < 0 || i >= this->GetNumberOfEntries())
+    {
+    return 0;
+    }
+  return this->Internals->Entries[i].Name.c_str();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMemoryAccounting::GetEntrySize(int i)
+{
+  if (i < 0 || i >= this->GetNumberOfEntries())
+    {
+    return 0;
+    }
+  return this->Internals->Entries[i].Size;
+}
+
+//----------------------------------------------------------------------------
+static bool vtkMemoryAccountingCompare(const vtkMemoryAccountingEntry *a,
+                                       const vtkMemoryAccountingEntry *b)
+{
+  return a->Size > b->Size;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::PrintReport(ostream& os)
+{
+  // Owners by decreasing total, then their entries by decreasing size.
+  std::map<std::string, unsigned long> totals;
+  std::map<std::string, std::vector<const vtkMemoryAccountingEntry *> > owned;
+  size_t i;
+  for (i = 0; i < this->Internals->Entries.size(); ++i)
+    {
+    const vtkMemoryAccountingEntry &entry = this->Internals->Entries[i];
+    totals[entry.Owner] += entry.Size;
+    owned[entry.Owner].push_back(&entry);
+    }
+  std::vector<std::pair<unsigned long, std::string> > owners;
+  std::map<std::string, unsigned long>::const_iterator iter;
+  for (iter = totals.begin(); iter != totals.end(); ++iter)
+    {
+    owners.push_back(std::make_pair(iter->second, iter->first));
+    }
+  std::sort(owners.rbegin(), owners.rend());
+
+  os << "Memory: " << this->GetTotalSize() << " KiB in "
+     << this->Internals->Entries.size() << " structures\n";
+  for (i = 0; i < owners.size(); ++i)
+    {
+    os << "  " << owners[i].second << ": " << owners[i].first << " KiB\n";
+    std::vector<const vtkMemoryAccountingEntry *> &entries =
+      owned[owners[i].second];
+    std::stable_sort(entries.begin(), entries.end(),
+                     vtkMemoryAccountingCompare);
+    for (size_t j = 0; j < entries.size(); ++j)
+      {
+      os << "    " << entries[j]->Name << ": " << entries[j]->Size
+         << " KiB\n";
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryAccounting::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Number Of Entries: " << this->GetNumberOfEntries() << "\n";
+  os << indent << "Total Size: " << this->GetTotalSize() << " KiB\n";
+}
@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryAccounting.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryAccounting - attribute the memory of data objects to their owners
+// .SECTION Description
+// vtkMemoryAccounting lists the arrays and the auxiliary structures (cell
+// arrays, cell types, cell links, point locators, information) of data
+// objects with their memory size, each attributed to an owner: the name
+// given to AddDataObject(), or for AddPipeline() the algorithm output
+// holding the data object.
+//
+// \code
+// vtkMemoryAccounting *accounting = vtkMemoryAccounting::New();
+// accounting->AddPipeline(writer);
+// accounting->PrintReport(cout);
+// \endcode
+//
+// An array or a structure shared by several data objects, as after a
+// ShallowCopy() or when a filter passes the arrays of its input to its
+// output, is counted once, for the first owner it was found in.
+// AddPipeline() visits the upstream algorithms first, so that shared
+// arrays are attributed to the algorithm that produced them.  The data
+// objects describe their structures with vtkDataObject::ReportMemory().
+//
+// Sizes are in kilobytes, rounded up for each entry like
+// vtkDataObject::GetActualMemorySize(), which for a data object sharing
+// nothing gives the sum of its entries.
+// .SECTION See Also
+// vtkDataObject vtkPipelineProfiler
+
+#ifndef __vtkMemoryAccounting_h
+#define __vtkMemoryAccounting_h
+
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkDataObject;
+class vtkFieldData;
+class vtkMemoryAccountingInternals;
+
+class VTK_FILTERING_EXPORT vtkMemoryAccounting : public vtkObject
+{
+public:
+  static vtkMemoryAccounting *New();
+  vtkTypeMacro(vtkMemoryAccounting,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Account for the structures of the data object, attributed to owner,
+  // or to the class name and address of the data object if owner is NULL.
+  void AddDataObject(vtkDataObject *data, const char *owner=0);
+
+  // Description:
+  // Account for the outputs of the algorithm and of all the algorithms
+  // upstream of it, each output attributed to "ClassName(address):port".
+  // The pipeline is not updated.
+  void AddPipeline(vtkAlgorithm *algorithm);
+
+  // Description:
+  // Forget all the entries and the structures already counted.
+  void Reset();
+
+  // Description:
+  // Return the total size in kilobytes of the entries, or of the entries
+  // of one owner.
+  unsigned long GetTotalSize();
+  unsigned long GetOwnerSize(const char *owner);
+
+  // Description:
+  // Access the entries: their owner, their name (e.g. "PointData/Normals"
+  // or "CellLinks") and their size in kilobytes.
+  int GetNumberOfEntries();
+  const char *GetEntryOwner(int i);
+  const char *GetEntryName(int i);
+  unsigned long GetEntrySize(int i);
+
+  // Description:
+  // Print the entries grouped by owner, by decreasing size.
+  void PrintReport(ostream& os);
+
+  // Description:
+  // Used by vtkDataObject::ReportMemory().  Record the object under name,
+  // unless it is NULL or was already counted.  ReportFieldData() records
+  // each array of the field data as "name/ArrayName".  PushName() makes
+  // the names reported until PopName() start with "name/".
+  void Report(vtkObjectBase *object, const char *name, unsigned long size);
+  void ReportFieldData(vtkFieldData *fieldData, const char *name);
+  void PushName(const char *name);
+  void PopName();
+
+protected:
+  vtkMemoryAccounting();
+  ~vtkMemoryAccounting();
+
+  vtkMemoryAccountingInternals *Internals;
+
+private:
+  vtkMemoryAccounting(const vtkMemoryAccounting&);  // Not implemented.
+  void operator=(const vtkMemoryAccounting&);  // Not implemented.
+};
+
+#endif
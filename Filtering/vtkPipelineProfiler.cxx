@@ -0,0 +1,522 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCriticalSection.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMemoryAccounting.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+vtkPipelineProfiler *vtkPipelineProfiler::ActiveProfiler = 0;
+static vtkSimpleCriticalSection vtkPipelineProfilerActiveLock;
+
+//----------------------------------------------------------------------------
+// One request passed to an algorithm.
+struct vtkPipelineProfilerEvent
+{
+  vtkAlgorithm *Algorithm;
+  std::string ClassName;
+  std::string Pass;
+  double Start;
+  double End;          // negative until the request is finished
+  double ChildTime;    // time spent in the requests started during this one,
+                       // including the profiler's own work around them
+  int Thread;
+  int Depth;
+  int Execution;       // for REQUEST_DATA, the number of the execution
+  unsigned long OutputSize;
+  unsigned long PeakSize;  // inputs and outputs at the end of REQUEST_DATA
+  unsigned long ProcessPeak;  // VmHWM before the start, then its growth
+};
+
+// The requests being processed by one thread, innermost last.
+struct vtkPipelineProfilerThread
+{
+  vtkMultiThreaderIDType Id;
+  std::vector<vtkIdType> Open;
+};
+
+// Totals for one algorithm.
+struct vtkPipelineProfilerAlgorithm
+{
+  vtkPipelineProfilerAlgorithm() : Executions(0), OutputSize(0), PeakSize(0),
+    ProcessGrowth(0), Time(0.0) {}
+  std::string ClassName;
+  int Executions;
+  unsigned long OutputSize;
+  unsigned long PeakSize;
+  unsigned long ProcessGrowth;
+  double Time;
+  std::map<std::string, double> PassTimes;
+};
+
+typedef std::map<vtkAlgorithm *, vtkPipelineProfilerAlgorithm>
+  vtkPipelineProfilerAlgorithmMap;
+
+class vtkPipelineProfilerInternals
+{
+public:
+  vtkSimpleCriticalSection Lock;
+  std::vector<vtkPipelineProfilerEvent> Events;
+  std::vector<vtkPipelineProfilerThread> Threads;
+  vtkPipelineProfilerAlgorithmMap Algorithms;
+  double StartTime;
+  unsigned long ProcessPeak;  // the last VmHWM sampled
+
+  // Return the index of the calling thread in Threads.  The lock must be
+  // held.
+  int GetThreadIndex()
+    {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+      {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i].Id, id))
+        {
+        return static_cast<int>(i);
+        }
+      }
+    vtkPipelineProfilerThread thread;
+    thread.Id = id;
+    this->Threads.push_back(thread);
+    return static_cast<int>(this->Threads.size() - 1);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Return the name of the pass requested, e.g. "REQUEST_DATA".
+static const char* vtkPipelineProfilerGetPass(vtkInformation *request)
+{
+  vtkInformationRequestKey *key = request->GetRequest();
+  return (key && key->GetName()) ? key->GetName() : "UNKNOWN";
+}
+
+//----------------------------------------------------------------------------
+// Return the peak resident memory of the process in kilobytes, or 0 if
+// it is not known.
+static unsigned long vtkPipelineProfilerGetProcessPeak()
+{
+  unsigned long peak = 0;
+#if defined(__linux__)
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while (status >> key)
+    {
+    if (key == "VmHWM:")
+      {
+      status >> peak;
+      break;
+      }
+    status.ignore(1024, '\n');
+    }
+#endif
+  return peak;
+}
+
+//----------------------------------------------------------------------------
+// Account for the data objects of the information vector.
+static void vtkPipelineProfilerAddData(vtkMemoryAccounting *accounting,
+                                       vtkInformationVector *infoVector)
+{
+  int n = infoVector ? infoVector->GetNumberOfInformationObjects() : 0;
+  for (int i = 0; i < n; ++i)
+    {
+    accounting->AddDataObject(
+      infoVector->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT()));
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+{
+  this->Internals = new vtkPipelineProfilerInternals;
+  this->Internals->StartTime = vtkTimerLog::GetUniversalTime();
+  this->Internals->ProcessPeak = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  this->StopProfiling();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::StartProfiling()
+{
+  this->Internals->Lock.Lock();
+  if (this->Internals->Events.empty())
+    {
+    this->Internals->StartTime = vtkTimerLog::GetUniversalTime();
+    }
+  this->Internals->ProcessPeak = vtkPipelineProfilerGetProcessPeak();
+  this->Internals->Lock.Unlock();
+
+  vtkPipelineProfilerActiveLock.Lock();
+  vtkPipelineProfiler::ActiveProfiler = this;
+  vtkPipelineProfilerActiveLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::StopProfiling()
+{
+  vtkPipelineProfilerActiveLock.Lock();
+  if (vtkPipelineProfiler::ActiveProfiler == this)
+    {
+    vtkPipelineProfiler::ActiveProfiler = 0;
+    }
+  vtkPipelineProfilerActiveLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetProfiling()
+{
+  return vtkPipelineProfiler::GetActiveProfiler() == this;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler *vtkPipelineProfiler::GetActiveProfiler()
+{
+  vtkPipelineProfilerActiveLock.Lock();
+  vtkPipelineProfiler *profiler = vtkPipelineProfiler::ActiveProfiler;
+  vtkPipelineProfilerActiveLock.Unlock();
+  return profiler;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineProfiler *
+vtkPipelineProfiler::RegisterActiveProfiler(vtkObjectBase *user)
+{
+  vtkPipelineProfilerActiveLock.Lock();
+  vtkPipelineProfiler *profiler = vtkPipelineProfiler::ActiveProfiler;
+  if (profiler)
+    {
+    profiler->Register(user);
+    }
+  vtkPipelineProfilerActiveLock.Unlock();
+  return profiler;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::Reset()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Events.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Algorithms.clear();
+  this->Internals->StartTime = vtkTimerLog::GetUniversalTime();
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfEvents()
+{
+  return static_cast<vtkIdType>(this->Internals->Events.size());
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::BeginRequest(vtkAlgorithm *algorithm,
+                                            vtkInformation *request)
+{
+  double begin = vtkTimerLog::GetUniversalTime();
+  vtkPipelineProfilerEvent event;
+  event.Algorithm = algorithm;
+  event.ClassName = algorithm->GetClassName();
+  event.Pass = vtkPipelineProfilerGetPass(request);
+  event.End = -1.0;
+  event.ChildTime = 0.0;
+  event.Execution = 0;
+  event.OutputSize = 0;
+  event.PeakSize = 0;
+
+  vtkPipelineProfilerInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  event.ProcessPeak = internals->ProcessPeak;
+  event.Thread = internals->GetThreadIndex();
+  vtkPipelineProfilerThread &thread = internals->Threads[event.Thread];
+  event.Depth = static_cast<int>(thread.Open.size());
+  vtkIdType index = static_cast<vtkIdType>(internals->Events.size());
+  event.Start = vtkTimerLog::GetUniversalTime();
+  if (!thread.Open.empty())
+    {
+    // Not the parent's own time.
+    internals->Events[thread.Open.back()].ChildTime += event.Start - begin;
+    }
+  thread.Open.push_back(index);
+  internals->Events.push_back(event);
+  internals->Lock.Unlock();
+  return index;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::EndRequest(vtkIdType index, int numInputPorts,
+                                     vtkInformationVector **inInfo,
+                                     vtkInformationVector *outInfo)
+{
+  double end = vtkTimerLog::GetUniversalTime();
+  vtkPipelineProfilerInternals *internals = this->Internals;
+  internals->Lock.Lock();
+  bool execution = index >= 0 &&
+    index < static_cast<vtkIdType>(internals->Events.size()) &&
+    internals->Events[index].Pass == "REQUEST_DATA";
+  internals->Lock.Unlock();
+
+  // Measure the memory of an execution without holding the lock.
+  unsigned long outputSize = 0, peakSize = 0, processPeak = 0;
+  if (execution)
+    {
+    processPeak = vtkPipelineProfilerGetProcessPeak();
+    int numOutputs = outInfo ? outInfo->GetNumberOfInformationObjects() : 0;
+    for (int i = 0; i < numOutputs; ++i)
+      {
+      vtkDataObject *output =
+        outInfo->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+      if (output)
+        {
+        outputSize += output->GetActualMemorySize();
+        }
+      }
+    vtkMemoryAccounting *accounting = vtkMemoryAccounting::New();
+    for (int port = 0; inInfo && port < numInputPorts; ++port)
+      {
+      vtkPipelineProfilerAddData(accounting, inInfo[port]);
+      }
+    vtkPipelineProfilerAddData(accounting, outInfo);
+    peakSize = accounting->GetTotalSize();
+    accounting->Delete();
+    }
+
+  internals->Lock.Lock();
+  // Reset() must not be called while a pipeline updates, but be safe.
+  if (index < 0 || index >= static_cast<vtkIdType>(internals->Events.size()))
+    {
+    internals->Lock.Unlock();
+    return;
+    }
+
+  vtkPipelineProfilerEvent &event = internals->Events[index];
+  event.End = end;
+  double duration = end - event.Start;
+
+  vtkPipelineProfilerThread &thread = internals->Threads[event.Thread];
+  if (!thread.Open.empty() && thread.Open.back() == index)
+    {
+    thread.Open.pop_back();
+    }
+  if (!thread.Open.empty())
+    {
+    // The memory accounting above is not the parent's own time either.
+    internals->Events[thread.Open.back()].ChildTime +=
+      vtkTimerLog::GetUniversalTime() - event.Start;
+    }
+
+  vtkPipelineProfilerAlgorithm &totals = internals->Algorithms[event.Algorithm];
+  totals.ClassName = event.ClassName;
+  double self = duration - event.ChildTime;
+  totals.Time += self;
+  totals.PassTimes[event.Pass] += self;
+
+  if (event.Pass == "REQUEST_DATA")
+    {
+    event.Execution = ++totals.Executions;
+    event.OutputSize = outputSize;
+    totals.OutputSize = outputSize;
+    event.PeakSize = peakSize;
+    totals.PeakSize = std::max(totals.PeakSize, peakSize);
+    event.ProcessPeak = processPeak > event.ProcessPeak ?
+      processPeak - event.ProcessPeak : 0;
+    internals->ProcessPeak = std::max(internals->ProcessPeak, processPeak);
+    totals.ProcessGrowth = std::max(totals.ProcessGrowth, event.ProcessPeak);
+    }
+  internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::GetNumberOfExecutions(vtkAlgorithm *algorithm)
+{
+  vtkPipelineProfilerAlgorithmMap::iterator iter =
+    this->Internals->Algorithms.find(algorithm);
+  return iter == this->Internals->Algorithms.end() ? 0 :
+    iter->second.Executions;
+}
+
+//----------------------------------------------------------------------------
+double vtkPipelineProfiler::GetTime(vtkAlgorithm *algorithm, const char *pass)
+{
+  vtkPipelineProfilerAlgorithmMap::iterator iter =
+    this->Internals->Algorithms.find(algorithm);
+  if (iter == this->Internals->Algorithms.end())
+    {
+    return 0.0;
+    }
+  if (!pass)
+    {
+    return iter->second.Time;
+    }
+  std::map<std::string, double>::iterator passIter =
+    iter->second.PassTimes.find(pass);
+  return passIter == iter->second.PassTimes.end() ? 0.0 : passIter->second;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineProfiler::GetOutputMemorySize(vtkAlgorithm *algorithm)
+{
+  vtkPipelineProfilerAlgorithmMap::iterator iter =
+    this->Internals->Algorithms.find(algorithm);
+  return iter == this->Internals->Algorithms.end() ? 0 :
+    iter->second.OutputSize;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineProfiler::GetPeakMemorySize(vtkAlgorithm *algorithm)
+{
+  vtkPipelineProfilerAlgorithmMap::iterator iter =
+    this->Internals->Algorithms.find(algorithm);
+  return iter == this->Internals->Algorithms.end() ? 0 :
+    iter->second.PeakSize;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineProfiler::GetPeakProcessMemoryGrowth(
+  vtkAlgorithm *algorithm)
+{
+  vtkPipelineProfilerAlgorithmMap::iterator iter =
+    this->Internals->Algorithms.find(algorithm);
+  return iter == this->Internals->Algorithms.end() ? 0 :
+    iter->second.ProcessGrowth;
+}
+
+//----------------------------------------------------------------------------
+static bool vtkPipelineProfilerCompare(
+  vtkPipelineProfilerAlgorithmMap::const_iterator a,
+  vtkPipelineProfilerAlgorithmMap::const_iterator b)
+{
+  std::map<std::string, double>::const_iterator ta =
+    a->second.PassTimes.find("REQUEST_DATA");
+  std::map<std::string, double>::const_iterator tb =
+    b->second.PassTimes.find("REQUEST_DATA");
+  double timeA = ta == a->second.PassTimes.end() ? 0.0 : ta->second;
+  double timeB = tb == b->second.PassTimes.end() ? 0.0 : tb->second;
+  return timeA > timeB || (timeA == timeB && a->second.Time > b->second.Time);
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  std::vector<vtkPipelineProfilerAlgorithmMap::const_iterator> algorithms;
+  vtkPipelineProfilerAlgorithmMap::const_iterator iter;
+  for (iter = this->Internals->Algorithms.begin();
+       iter != this->Internals->Algorithms.end(); ++iter)
+    {
+    algorithms.push_back(iter);
+    }
+  std::sort(algorithms.begin(), algorithms.end(), vtkPipelineProfilerCompare);
+
+  os << "Pipeline profile: " << this->Internals->Events.size()
+     << " requests, " << algorithms.size() << " algorithms\n";
+  for (size_t i = 0; i < algorithms.size(); ++i)
+    {
+    const vtkPipelineProfilerAlgorithm &totals = algorithms[i]->second;
+    os << "  " << totals.ClassName << " (" << algorithms[i]->first << "): "
+       << totals.Executions << " executions, " << totals.Time
+       << " s, output " << totals.OutputSize << " KiB, peak "
+       << totals.PeakSize << " KiB";
+    if (totals.ProcessGrowth)
+      {
+      os << ", process peak +" << totals.ProcessGrowth << " KiB";
+      }
+    os << "\n";
+    std::map<std::string, double>::const_iterator passIter;
+    for (passIter = totals.PassTimes.begin();
+         passIter != totals.PassTimes.end(); ++passIter)
+      {
+      os << "    " << passIter->first << ": " << passIter->second << " s\n";
+      }
+    }
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  this->Internals->Lock.Lock();
+  std::streamsize precision = os.precision(15);
+  os << "{\"traceEvents\":[";
+  const char *separator = "\n";
+  for (size_t i = 0; i < this->Internals->Events.size(); ++i)
+    {
+    const vtkPipelineProfilerEvent &event = this->Internals->Events[i];
+    if (event.End < 0.0)
+      {
+      continue;
+      }
+    double start = (event.Start - this->Internals->StartTime) * 1.0e6;
+    double duration = (event.End - event.Start) * 1.0e6;
+    os << separator
+       << "{\"name\":\"" << event.ClassName << "::" << event.Pass << "\","
+       << "\"cat\":\"" << event.Pass << "\",\"ph\":\"X\","
+       << "\"pid\":1,\"tid\":" << event.Thread << ","
+       << "\"ts\":" << start << ",\"dur\":" << duration << ","
+       << "\"args\":{\"algorithm\":\"" << event.Algorithm << "\","
+       << "\"depth\":" << event.Depth;
+    if (event.Execution)
+      {
+      os << ",\"execution\":" << event.Execution
+         << ",\"output KiB\":" << event.OutputSize
+         << ",\"peak KiB\":" << event.PeakSize
+         << ",\"process peak growth KiB\":" << event.ProcessPeak;
+      }
+    os << "}}";
+    separator = ",\n";
+    }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os.precision(precision);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineProfiler::WriteChromeTrace(const char *filename)
+{
+  ofstream os(filename);
+  if (!os)
+    {
+    vtkErrorMacro("Cannot open " << (filename ? filename : "(null)"));
+    return 0;
+    }
+  this->WriteChromeTrace(os);
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Profiling: " << this->GetProfiling() << "\n";
+  os << indent << "Number Of Events: " << this->GetNumberOfEvents() << "\n";
+}
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineProfiler - record the time spent by each algorithm of a pipeline
+// .SECTION Description
+// vtkPipelineProfiler records every request that the executives pass to
+// their algorithm (REQUEST_DATA_OBJECT, REQUEST_INFORMATION,
+// REQUEST_UPDATE_EXTENT, REQUEST_DATA, ...) while it is profiling: the
+// wall clock time of the request, the request that was being processed
+// when it started (for example when a filter updates an internal pipeline)
+// and, for REQUEST_DATA, the memory size of the outputs produced and the
+// high-water mark of the execution.
+//
+// \code
+// vtkPipelineProfiler *profiler = vtkPipelineProfiler::New();
+// profiler->StartProfiling();
+// writer->Write();
+// profiler->StopProfiling();
+// profiler->PrintSummary(cout);
+// profiler->WriteChromeTrace("pipeline.json");
+// \endcode
+//
+// PrintSummary() lists the algorithms by decreasing time spent in their
+// own REQUEST_DATA, with the number of executions and their high-water
+// mark.  WriteChromeTrace()
+// writes the requests as a nested timeline in the Trace Event format,
+// which chrome://tracing and similar viewers can display.
+//
+// Only one profiler is active at a time.  Requests processed by several
+// threads at once are recorded on separate timelines.  When no profiler
+// is active, the cost for the executives is a pointer comparison.
+// .SECTION See Also
+// vtkExecutive vtkTimerLog
+
+#ifndef __vtkPipelineProfiler_h
+#define __vtkPipelineProfiler_h
+
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+class vtkPipelineProfilerInternals;
+
+class VTK_FILTERING_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler *New();
+  vtkTypeMacro(vtkPipelineProfiler,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Make this profiler the active one, replacing any other, and start
+  // recording requests.  Requests recorded before are kept; use Reset()
+  // to forget them.
+  void StartProfiling();
+
+  // Description:
+  // Stop recording requests.
+  void StopProfiling();
+
+  // Description:
+  // Return 1 if this profiler is recording requests.
+  int GetProfiling();
+
+  // Description:
+  // Return the profiler recording requests, or NULL.
+  static vtkPipelineProfiler *GetActiveProfiler();
+
+  // Description:
+  // Forget all the recorded requests.  Do not call this while a pipeline
+  // is updating.
+  void Reset();
+
+  // Description:
+  // Return the number of requests recorded.
+  vtkIdType GetNumberOfEvents();
+
+  // Description:
+  // Return the number of REQUEST_DATA recorded for the algorithm, that
+  // is the number of times it executed.
+  int GetNumberOfExecutions(vtkAlgorithm *algorithm);
+
+  // Description:
+  // Return the time in seconds spent by the algorithm in the given pass
+  // (for example "REQUEST_DATA"), or in all the passes if pass is NULL.
+  // The time spent in requests started during these, such as updates of
+  // internal pipelines, is not included, nor the time the profiler spends
+  // measuring them.
+  double GetTime(vtkAlgorithm *algorithm, const char *pass=0);
+
+  // Description:
+  // Return the memory size in kilobytes of the outputs of the last
+  // execution of the algorithm.
+  unsigned long GetOutputMemorySize(vtkAlgorithm *algorithm);
+
+  // Description:
+  // Return the largest memory size in kilobytes of the data live at the
+  // end of an execution of the algorithm: its inputs and its outputs, the
+  // arrays and structures they share counted once (see
+  // vtkMemoryAccounting).
+  unsigned long GetPeakMemorySize(vtkAlgorithm *algorithm);
+
+  // Description:
+  // Return the largest growth in kilobytes of the peak resident memory of
+  // the process during an execution of the algorithm, including the
+  // requests it started.  This catches the temporary allocations of the
+  // execution, but is only available on Linux; 0 elsewhere.  The peak is
+  // sampled once per execution, at its end, and compared with the sample
+  // taken before it (at the end of the previous execution or when
+  // profiling started), so the growth of work done in between is
+  // included.
+  unsigned long GetPeakProcessMemoryGrowth(vtkAlgorithm *algorithm);
+
+  // Description:
+  // Print the time spent by each algorithm, by decreasing REQUEST_DATA
+  // time.
+  void PrintSummary(ostream& os);
+
+  // Description:
+  // Write the recorded requests in the Trace Event (JSON) format.
+  // Return 0 if the file cannot be written.
+  void WriteChromeTrace(ostream& os);
+  int WriteChromeTrace(const char *filename);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler();
+
+  //BTX
+  friend class vtkExecutive;
+  //ETX
+
+  // Description:
+  // Called by vtkExecutive around each request it passes to an algorithm.
+  // BeginRequest() returns the index of the event given to EndRequest().
+  vtkIdType BeginRequest(vtkAlgorithm *algorithm, vtkInformation *request);
+  void EndRequest(vtkIdType event, int numInputPorts,
+                  vtkInformationVector **inInfo, vtkInformationVector *outInfo);
+
+  // Description:
+  // Return the active profiler registered by user, or NULL.  Unlike
+  // GetActiveProfiler(), the profiler cannot be released by another
+  // thread before the caller uses it.
+  static vtkPipelineProfiler *RegisterActiveProfiler(vtkObjectBase *user);
+
+  vtkPipelineProfilerInternals *Internals;
+
+  // Guarded by a lock since the executives of several threads read it.
+  static vtkPipelineProfiler *ActiveProfiler;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&);  // Not implemented.
+  void operator=(const vtkPipelineProfiler&);  // Not implemented.
+};
+
+#endif
@@ -126,6 +126,24 @@ void vtkPointLocator::Initialize()
   this->FreeSearchStructure();
 }
 
+unsigned long vtkPointLocator::GetActualMemorySize()
+{
+  if ( !this->HashTable )
+    {
+    return 0;
+    }
+  vtkIdList *ptIds;
+  size_t size = this->NumberOfBuckets * sizeof(vtkIdList *);
+  for (vtkIdType i=0; i<this->NumberOfBuckets; i++)
+    {
+    if ( (ptIds = this->HashTable[i]) )
+      {
+      size += sizeof(vtkIdList) + ptIds->GetNumberOfIds() * sizeof(vtkIdType);
+      }
+    }
+  return static_cast<unsigned long>((size + 1023) / 1024); //kilobytes
+}
+
 void vtkPointLocator::FreeSearchStructure()
 {
   vtkIdList *ptIds;
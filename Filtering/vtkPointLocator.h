@@ -195,6 +195,11 @@ public:
   void BuildLocator();
   void GenerateRepresentation(int level, vtkPolyData *pd);
 
+  // Description:
+  // Return the memory in kilobytes used by the buckets and their lists of
+  // point ids.
+  virtual unsigned long GetActualMemorySize();
+
 protected:
   vtkPointLocator();
   virtual ~vtkPointLocator();
@@ -19,6 +19,7 @@
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkPointLocator.h"
 #include "vtkSource.h"
 
@@ -124,11 +125,11 @@ unsigned long int vtkPointSet::GetMTime()
 }
 
 //----------------------------------------------------------------------------
-vtkIdType vtkPointSet::FindPoint(double x[3])
+void vtkPointSet::BuildLocator()
 {
-  if ( !this->Points )
+  if ( !this->Points || this->Points->GetNumberOfPoints() < 1 )
     {
-    return -1;
+    return;
     }
 
   if ( !this->Locator )
@@ -137,11 +138,30 @@ vtkIdType vtkPointSet::FindPoint(double x[3])
     this->Locator->Register(this);
     this->Locator->Delete();
     this->Locator->SetDataSet(this);
+    this->Locator->BuildLocator();
     }
 
   if ( this->Points->GetMTime() > this->Locator->GetMTime() )
     {
     this->Locator->SetDataSet(this);
+    this->Locator->BuildLocator();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPointSet::PrepareForThreadedAccess()
+{
+  this->Superclass::PrepareForThreadedAccess();
+  this->BuildLocator();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPointSet::FindPoint(double x[3])
+{
+  this->BuildLocator();
+  if ( !this->Locator )
+    {
+    return -1;
     }
 
   return this->Locator->FindClosestPoint(x);
@@ -253,20 +273,7 @@ vtkIdType vtkPointSet::FindCell(double x[3], vtkCell *cell,
     return -1;
     }
 
-  if ( !this->Locator )
-    {
-    this->Locator = vtkPointLocator::New();
-    this->Locator->Register(this);
-    this->Locator->Delete();
-    this->Locator->SetDataSet(this);
-    this->Locator->BuildLocator();
-    }
-
-  if ( this->Points->GetMTime() > this->Locator->GetMTime() )
-    {
-    this->Locator->SetDataSet(this);
-    this->Locator->BuildLocator();
-    }
+  this->BuildLocator();
 
   std::set<vtkIdType> visitedCells;
   VTK_CREATE(vtkIdList, ptIds);
@@ -359,9 +366,29 @@ unsigned long vtkPointSet::GetActualMemorySize()
     {
     size += this->Points->GetActualMemorySize();
     }
+  if ( this->Locator )
+    {
+    size += this->Locator->GetActualMemorySize();
+    }
   return size;
 }
 
+//----------------------------------------------------------------------------
+void vtkPointSet::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  this->vtkDataSet::ReportMemory(accounting);
+  if ( this->Points )
+    {
+    accounting->Report(this->Points->GetData(), "Points",
+                       this->Points->GetActualMemorySize());
+    }
+  if ( this->Locator )
+    {
+    accounting->Report(this->Locator, "PointLocator",
+                       this->Locator->GetActualMemorySize());
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkPointSet::ShallowCopy(vtkDataObject *dataObject)
 {
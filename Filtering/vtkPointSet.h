@@ -70,6 +70,15 @@ public:
   // Compute the (X, Y, Z)  bounds of the data.
   void ComputeBounds();
 
+  // Description:
+  // Build the point locator used by FindPoint() and FindCell(). It is
+  // otherwise built on the first call to these methods.
+  void BuildLocator();
+
+  // Description:
+  // Also builds the point locator. See vtkDataSet.
+  virtual void PrepareForThreadedAccess();
+
   // Description:
   // Reclaim any unused memory.
   void Squeeze();
@@ -84,10 +93,14 @@ public:
   // is valid only after the pipeline has updated. The memory size
   // returned is guaranteed to be greater than or equal to the
   // memory required to represent the data (e.g., extra space in
-  // arrays, etc. are not included in the return value). THIS METHOD
-  // IS THREAD SAFE.
+  // arrays, etc. are not included in the return value). The point
+  // locator is included. THIS METHOD IS THREAD SAFE.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Also reports the points and the point locator. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
+
   // Description:
   // Shallow and Deep copy.
   void ShallowCopy(vtkDataObject *src);
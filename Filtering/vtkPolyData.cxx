@@ -22,6 +22,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
@@ -84,6 +85,7 @@ vtkPolyData::vtkPolyData ()
 
   this->Cells = NULL;
   this->Links = NULL;
+  this->UseContiguousLinks = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -389,48 +391,48 @@ void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
     {
     case VTK_VERTEX:
       cell->SetCellTypeToVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_VERTEX:
       cell->SetCellTypeToPolyVertex();
-      this->Verts->GetCell(loc,numPts,pts);
+      this->Verts->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_LINE: 
       cell->SetCellTypeToLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLY_LINE:
       cell->SetCellTypeToPolyLine();
-      this->Lines->GetCell(loc,numPts,pts);
+      this->Lines->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE:
       cell->SetCellTypeToTriangle();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_QUAD:
       cell->SetCellTypeToQuad();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       break;
 
     case VTK_POLYGON:
       cell->SetCellTypeToPolygon();
-      this->Polys->GetCell(loc,numPts,pts);
+      this->Polys->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
 
     case VTK_TRIANGLE_STRIP:
       cell->SetCellTypeToTriangleStrip();
-      this->Strips->GetCell(loc,numPts,pts);
+      this->Strips->GetCell(loc,numPts,pts,cell->PointIds);
       cell->PointIds->SetNumberOfIds(numPts); //reset number of points
       cell->Points->SetNumberOfPoints(numPts);
       break;
@@ -440,6 +442,7 @@ void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
       numPts = 0;
     }
 
+  // With 32 bit connectivity, pts already points into cell->PointIds.
   for (i=0; i < numPts; i++)
     {
     cell->PointIds->SetId(i,pts[i]);
@@ -527,7 +530,8 @@ void vtkPolyData::CopyCells(vtkPolyData *pd, vtkIdList *idList,
 void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
 {
   int i, loc;
-  vtkIdType *pts, numPts;
+  vtkIdType numPts;
+  vtkCellArray *cells;
   unsigned char type;
   double x[3];
 
@@ -543,22 +547,22 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
     {
     case VTK_VERTEX:
     case VTK_POLY_VERTEX:
-      this->Verts->GetCell(loc,numPts,pts);
+      cells = this->Verts;
       break;
 
     case VTK_LINE: 
     case VTK_POLY_LINE:
-      this->Lines->GetCell(loc,numPts,pts);
+      cells = this->Lines;
       break;
 
     case VTK_TRIANGLE:
     case VTK_QUAD:
     case VTK_POLYGON:
-      this->Polys->GetCell(loc,numPts,pts);
+      cells = this->Polys;
       break;
 
     case VTK_TRIANGLE_STRIP:
-      this->Strips->GetCell(loc,numPts,pts);
+      cells = this->Strips;
       break;
 
     default:
@@ -567,10 +571,12 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
       return;
     }
 
-  // carefully compute the bounds
+  // carefully compute the bounds, reading the ids one at a time so that
+  // this stays thread safe with 32 bit connectivity
+  numPts = cells->GetCellSize(loc);
   if (numPts)
     {
-    this->Points->GetPoint( pts[0], x );
+    this->Points->GetPoint( cells->GetCellPointId(loc, 0), x );
     bounds[0] = x[0];
     bounds[2] = x[1];
     bounds[4] = x[2];
@@ -579,7 +585,7 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
     bounds[5] = x[2];
     for (i=1; i < numPts; i++)
       {
-      this->Points->GetPoint( pts[i], x );
+      this->Points->GetPoint( cells->GetCellPointId(loc, i), x );
       bounds[0] = (x[0] < bounds[0] ? x[0] : bounds[0]);
       bounds[1] = (x[0] > bounds[1] ? x[0] : bounds[1]);
       bounds[2] = (x[1] < bounds[2] ? x[1] : bounds[2]);
@@ -1056,6 +1062,7 @@ void vtkPolyData::BuildLinks(int initialSize)
     }
 
   this->Links = vtkCellLinks::New();
+  this->Links->SetUseContiguousStorage(this->UseContiguousLinks);
   if ( initialSize > 0 )
     {
     this->Links->Allocate(initialSize);
@@ -1070,24 +1077,50 @@ void vtkPolyData::BuildLinks(int initialSize)
   this->Links->BuildLinks(this);
 }
 
+//----------------------------------------------------------------------------
+void vtkPolyData::PrepareForThreadedAccess()
+{
+  this->Superclass::PrepareForThreadedAccess();
+  if ( this->Cells == NULL )
+    {
+    this->BuildCells();
+    }
+  if ( this->Links == NULL )
+    {
+    this->BuildLinks();
+    }
+}
+
 //----------------------------------------------------------------------------
 // Copy a cells point ids into list provided. (Less efficient.)
 void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 {
-  vtkIdType i;
-  vtkIdType *pts, npts;
-  
   ptIds->Reset();
   if ( this->Cells == NULL )
     {
     this->BuildCells();
     }
 
-  this->vtkPolyData::GetCellPoints(cellId, npts, pts);
-  ptIds->InsertId (npts-1,pts[npts-1]);
-  for (i=0; i<npts-1; i++)
+  // Copy the ids straight to ptIds rather than through the pointer
+  // version, which is not thread safe with 32 bit connectivity.
+  int loc = this->Cells->GetCellLocation(cellId);
+  switch (this->Cells->GetCellType(cellId))
     {
-    ptIds->SetId(i,pts[i]);
+    case VTK_VERTEX: case VTK_POLY_VERTEX:
+      this->Verts->GetCell(loc,ptIds);
+      break;
+
+    case VTK_LINE: case VTK_POLY_LINE:
+      this->Lines->GetCell(loc,ptIds);
+      break;
+
+    case VTK_TRIANGLE: case VTK_QUAD: case VTK_POLYGON:
+      this->Polys->GetCell(loc,ptIds);
+      break;
+
+    case VTK_TRIANGLE_STRIP:
+      this->Strips->GetCell(loc,ptIds);
+      break;
     }
 }
 
@@ -1130,23 +1163,11 @@ void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
 //----------------------------------------------------------------------------
 void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
 {
-  vtkIdType *cells;
-  vtkIdType numCells;
-  vtkIdType i;
-
   if ( ! this->Links )
     {
     this->BuildLinks();
     }
-  cellIds->Reset();
-
-  numCells = this->Links->GetNcells(ptId);
-  cells = this->Links->GetCells(ptId);
-
-  for (i=0; i < numCells; i++)
-    {
-    cellIds->InsertId(i,cells[i]);
-    }
+  this->Links->GetCells(ptId, cellIds);
 }
 
 //----------------------------------------------------------------------------
@@ -1817,6 +1838,42 @@ unsigned long vtkPolyData::GetActualMemorySize()
   return size;
 }
 
+//----------------------------------------------------------------------------
+void vtkPolyData::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  this->vtkPointSet::ReportMemory(accounting);
+  if ( this->Verts )
+    {
+    accounting->Report(this->Verts, "Verts",
+                       this->Verts->GetActualMemorySize());
+    }
+  if ( this->Lines )
+    {
+    accounting->Report(this->Lines, "Lines",
+                       this->Lines->GetActualMemorySize());
+    }
+  if ( this->Polys )
+    {
+    accounting->Report(this->Polys, "Polys",
+                       this->Polys->GetActualMemorySize());
+    }
+  if ( this->Strips )
+    {
+    accounting->Report(this->Strips, "Strips",
+                       this->Strips->GetActualMemorySize());
+    }
+  if ( this->Cells )
+    {
+    accounting->Report(this->Cells, "CellTypes",
+                       this->Cells->GetActualMemorySize());
+    }
+  if ( this->Links )
+    {
+    accounting->Report(this->Links, "CellLinks",
+                       this->Links->GetActualMemorySize());
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkPolyData::ShallowCopy(vtkDataObject *dataObject)
 {
@@ -1828,6 +1885,7 @@ void vtkPolyData::ShallowCopy(vtkDataObject *dataObject)
     this->SetLines(polyData->GetLines());
     this->SetPolys(polyData->GetPolys());
     this->SetStrips(polyData->GetStrips());
+    this->UseContiguousLinks = polyData->UseContiguousLinks;
     
     // I do not know if this is correct but.
     if (this->Cells)
@@ -1887,6 +1945,7 @@ void vtkPolyData::DeepCopy(vtkDataObject *dataObject)
     ca->DeepCopy(polyData->GetStrips());
     this->SetStrips(ca);
     ca->Delete();
+    this->UseContiguousLinks = polyData->UseContiguousLinks;
 
     if ( this->Cells )
       {
@@ -2159,6 +2218,8 @@ void vtkPolyData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Pieces: " << this->GetNumberOfPieces() << endl;
   os << indent << "Piece: " << this->GetPiece() << endl;
   os << indent << "Ghost Level: " << this->GetGhostLevel() << endl;
+  os << indent << "Use Contiguous Links: "
+     << (this->UseContiguousLinks ? "On" : "Off") << endl;
 }
 
 
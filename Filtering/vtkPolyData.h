@@ -221,6 +221,25 @@ public:
   // based on the number of points in the vtkPolyData. The optional 
   // initialSize parameter can be used to allocate a larger size initially.
   void BuildLinks(int initialSize=0);
+  vtkCellLinks *GetCellLinks() {return this->Links;};
+
+  // Description:
+  // Have BuildLinks() store the cell links in a single array built in
+  // parallel, see vtkCellLinks::SetUseContiguousStorage().  This speeds
+  // up BuildLinks() on large meshes, and GetPointCells() then returns a
+  // pointer that may be used from several threads.  The methods editing
+  // the links convert them back to the regular storage, so this is best
+  // left off for filters that edit the mesh.  Takes effect at the next
+  // BuildLinks().  Off by default.
+  vtkSetMacro(UseContiguousLinks, int);
+  vtkGetMacro(UseContiguousLinks, int);
+  vtkBooleanMacro(UseContiguousLinks, int);
+
+  // Description:
+  // Also builds the cells and the links, so that GetCell(),
+  // GetCellPoints(), GetPointCells() and GetCellNeighbors() may be called
+  // from several threads. See vtkDataSet.
+  virtual void PrepareForThreadedAccess();
 
   // Description:
   // Release data structure that allows random access of the cells. This must
@@ -387,6 +406,10 @@ public:
   // arrays, etc. are not included in the return value). THIS METHOD
   // IS THREAD SAFE.
   unsigned long GetActualMemorySize();
+
+  // Description:
+  // Also reports the cell arrays, the cell types and the cell links. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
   
   // Description:
   // Shallow and Deep copy.
@@ -468,6 +491,7 @@ protected:
   // built only when necessary
   vtkCellTypes *Cells;
   vtkCellLinks *Links;
+  int UseContiguousLinks;
 
   // This method is called during an update.  
   // If the CropFilter is set, the user reqquested a piece which the 
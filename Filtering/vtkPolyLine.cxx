@@ -30,12 +30,15 @@ vtkStandardNewMacro(vtkPolyLine);
 vtkPolyLine::vtkPolyLine()
 {
   this->Line = vtkLine::New();
+  this->Scalars = vtkDoubleArray::New();
+  this->Scalars->SetNumberOfTuples(2);
 }
 
 //----------------------------------------------------------------------------
 vtkPolyLine::~vtkPolyLine()
 {
   this->Line->Delete();
+  this->Scalars->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -466,8 +469,7 @@ void vtkPolyLine::Clip(double value, vtkDataArray *cellScalars,
                        int insideOut)
 {
   int i, numLines=this->Points->GetNumberOfPoints() - 1;
-  vtkDoubleArray *lineScalars=vtkDoubleArray::New();
-  lineScalars->SetNumberOfTuples(2);
+  vtkDoubleArray *lineScalars=this->Scalars;
 
   for ( i=0; i < numLines; i++)
     {
@@ -483,8 +485,6 @@ void vtkPolyLine::Clip(double value, vtkDataArray *cellScalars,
     this->Line->Clip(value, lineScalars, locator, lines, inPd, outPd, 
                     inCd, cellId, outCd, insideOut);
     }
-  
-  lineScalars->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -28,6 +28,7 @@ class vtkLine;
 class vtkDataArray;
 class vtkIncrementalPointLocator;
 class vtkCellData;
+class vtkDoubleArray;
 
 class VTK_FILTERING_EXPORT vtkPolyLine : public vtkCell
 {
@@ -91,6 +92,7 @@ protected:
   ~vtkPolyLine();
 
   vtkLine *Line;
+  vtkDoubleArray *Scalars; // used by Clip()
 
 private:
   vtkPolyLine(const vtkPolyLine&);  // Not implemented.
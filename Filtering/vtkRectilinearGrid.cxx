@@ -21,6 +21,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkObjectFactory.h"
 #include "vtkPixel.h"
 #include "vtkPointData.h"
@@ -879,6 +880,27 @@ unsigned long vtkRectilinearGrid::GetActualMemorySize()
   return size;
 }
 
+//----------------------------------------------------------------------------
+void vtkRectilinearGrid::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  this->vtkDataSet::ReportMemory(accounting);
+  if ( this->XCoordinates )
+    {
+    accounting->Report(this->XCoordinates, "XCoordinates",
+                       this->XCoordinates->GetActualMemorySize());
+    }
+  if ( this->YCoordinates )
+    {
+    accounting->Report(this->YCoordinates, "YCoordinates",
+                       this->YCoordinates->GetActualMemorySize());
+    }
+  if ( this->ZCoordinates )
+    {
+    accounting->Report(this->ZCoordinates, "ZCoordinates",
+                       this->ZCoordinates->GetActualMemorySize());
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkRectilinearGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
                                           vtkIdList *cellIds)
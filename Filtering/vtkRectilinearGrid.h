@@ -154,6 +154,10 @@ public:
   // IS THREAD SAFE.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Also reports the coordinate arrays. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
+
   // Description:
   // Shallow and Deep copy.
   void ShallowCopy(vtkDataObject *src);  
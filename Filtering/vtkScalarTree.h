@@ -27,7 +27,7 @@
 // scalar value specified.
 
 // .SECTION See Also
-// vtkSimpleScalarTree 
+// vtkSimpleScalarTree vtkSpanSpace
 
 #ifndef __vtkScalarTree_h
 #define __vtkScalarTree_h
@@ -73,6 +73,20 @@ public:
   virtual vtkCell *GetNextCell(vtkIdType &cellId, vtkIdList* &ptIds,
                                vtkDataArray *cellScalars) = 0;
 
+  // Description:
+  // Get the candidate cells of the scalar value specified to
+  // InitTraversal() in batches, for processing them concurrently.  The
+  // batches list the cells in the order of GetNextCell(), but a cell of a
+  // batch does not necessarily span the scalar value.  GetCellBatch()
+  // returns the ids of the cells of a batch and their number in numCells.
+  // Both methods are thread safe once InitTraversal() has returned.
+  // Scalar trees that can only be traversed with GetNextCell() return 0
+  // batches, which is what this class does.
+  virtual vtkIdType GetNumberOfCellBatches() { return 0; }
+  virtual const vtkIdType *GetCellBatch(vtkIdType vtkNotUsed(batchNum),
+                                        vtkIdType &numCells)
+    { numCells = 0; return NULL; }
+
 protected:
   vtkScalarTree();
   ~vtkScalarTree();
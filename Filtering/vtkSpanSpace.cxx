@@ -0,0 +1,431 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpanSpace.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpanSpace.h"
+
+#include "vtkCell.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+
+#include <math.h>
+
+vtkStandardNewMacro(vtkSpanSpace);
+
+//----------------------------------------------------------------------------
+// Maps scalar values to the bins along either axis of span space.
+class vtkSpanSpaceBinner
+{
+public:
+  double Min;
+  double Scale;
+  vtkIdType Resolution;
+
+  vtkIdType GetBin(double s) const
+    {
+    vtkIdType bin = static_cast<vtkIdType>((s - this->Min) * this->Scale);
+    return (bin < 0 ? 0 :
+            (bin >= this->Resolution ? this->Resolution - 1 : bin));
+    }
+};
+
+//----------------------------------------------------------------------------
+// Computes the bin of each cell from the range of the scalars of its
+// points, read directly from the array, with one id list per thread.
+template <class T>
+class vtkSpanSpaceBinCells : public vtkSpanSpaceBinner
+{
+public:
+  vtkDataSet *DataSet;
+  const T *Scalars;
+  int NumberOfComponents;
+  vtkIdType *Bins;
+  vtkSMPThreadLocal<vtkIdList *> CellPts;
+
+  void Initialize()
+    {
+    this->CellPts.Local() = vtkIdList::New();
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *cellPts = this->CellPts.Local();
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+      this->DataSet->GetCellPoints(cellId, cellPts);
+      vtkIdType numPts = cellPts->GetNumberOfIds();
+      if (numPts < 1)
+        {
+        // A cell without points spans no value.
+        this->Bins[cellId] = this->Resolution - 1;
+        continue;
+        }
+      vtkIdType *pts = cellPts->GetPointer(0);
+      double min = static_cast<double>(
+        this->Scalars[pts[0] * this->NumberOfComponents]);
+      double max = min;
+      for (vtkIdType i = 1; i < numPts; i++)
+        {
+        double s = static_cast<double>(
+          this->Scalars[pts[i] * this->NumberOfComponents]);
+        if (s < min)
+          {
+          min = s;
+          }
+        if (s > max)
+          {
+          max = s;
+          }
+        }
+      this->Bins[cellId] =
+        this->GetBin(max) * this->Resolution + this->GetBin(min);
+      }
+    }
+
+  void Reduce()
+    {
+    typename vtkSMPThreadLocal<vtkIdList *>::iterator it;
+    for (it = this->CellPts.begin(); it != this->CellPts.end(); ++it)
+      {
+      (*it)->Delete();
+      }
+    }
+};
+
+template <class T>
+void vtkSpanSpaceBin(const vtkSpanSpaceBinner &binner, vtkDataSet *dataSet,
+                     T *scalars, int numComp, vtkIdType *bins)
+{
+  vtkSpanSpaceBinCells<T> functor;
+  static_cast<vtkSpanSpaceBinner&>(functor) = binner;
+  functor.DataSet = dataSet;
+  functor.Scalars = scalars;
+  functor.NumberOfComponents = numComp;
+  functor.Bins = bins;
+  vtkSMPTools::For(0, dataSet->GetNumberOfCells(), 10000, functor);
+}
+
+//----------------------------------------------------------------------------
+vtkSpanSpace::vtkSpanSpace()
+{
+  this->Resolution = 100;
+  this->ComputeResolution = 1;
+  this->NumberOfCellsPerBucket = 5;
+  this->BatchSize = 1000;
+  this->Range[0] = 0.0;
+  this->Range[1] = 1.0;
+  this->NumberOfCells = 0;
+  this->Offsets = NULL;
+  this->CellIds = NULL;
+  this->Batches = vtkIdTypeArray::New();
+  this->CurrentBatch = 0;
+  this->CurrentCell = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSpanSpace::~vtkSpanSpace()
+{
+  this->Initialize();
+  this->Batches->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Initialize locator. Frees memory and resets object as appropriate.
+void vtkSpanSpace::Initialize()
+{
+  delete [] this->Offsets;
+  this->Offsets = NULL;
+  delete [] this->CellIds;
+  this->CellIds = NULL;
+  this->NumberOfCells = 0;
+  this->Batches->Initialize();
+  this->CurrentBatch = 0;
+  this->CurrentCell = 0;
+}
+
+//----------------------------------------------------------------------------
+// Construct the span space from the dataset provided. Checks build times
+// and modified time from input and reconstructs the tree if necessary.
+void vtkSpanSpace::BuildTree()
+{
+  vtkIdType numCells;
+
+  // Check input...see whether we have to rebuild
+  //
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+    {
+    vtkErrorMacro( << "No data to build tree with");
+    return;
+    }
+
+  if ( this->Offsets != NULL && this->BuildTime > this->MTime
+    && this->BuildTime > this->DataSet->GetMTime() )
+    {
+    return;
+    }
+
+  vtkDebugMacro( << "Building span space..." );
+
+  this->Scalars = this->DataSet->GetPointData()->GetScalars();
+  if ( ! this->Scalars )
+    {
+    vtkErrorMacro( << "No scalar data to build trees with");
+    return;
+    }
+
+  this->Initialize();
+
+  this->Scalars->GetRange(this->Range, 0);
+  if ( this->Range[1] <= this->Range[0] ) //prevent zero width
+    {
+    this->Range[1] = this->Range[0] + 1.0;
+    }
+  if ( this->ComputeResolution )
+    {
+    double res = sqrt(static_cast<double>(numCells) /
+                      this->NumberOfCellsPerBucket);
+    this->Resolution = static_cast<vtkIdType>(res);
+    this->Resolution = (this->Resolution < 1 ? 1 :
+                        (this->Resolution > 10000 ? 10000 :
+                         this->Resolution));
+    }
+  vtkIdType res = this->Resolution;
+  vtkIdType numBins = res * res;
+
+  // Compute the bin of each cell in parallel: GetCellPoints() with a
+  // vtkIdList is thread safe once called from a single thread, including
+  // on cell arrays with 32 bit storage.  Data sets that build their cells
+  // lazily, such as vtkPolyData, do it now rather than from the threads.
+  // Scalars whose memory cannot be read directly are copied.
+  vtkIdList *cellPts = vtkIdList::New();
+  this->DataSet->GetCellPoints(0, cellPts);
+  cellPts->Delete();
+
+  vtkSpanSpaceBinner binner;
+  binner.Min = this->Range[0];
+  binner.Scale = res / (this->Range[1] - this->Range[0]);
+  binner.Resolution = res;
+  vtkIdType *bins = new vtkIdType[numCells];
+  vtkDataArray *scalars = this->Scalars;
+  int numComp = scalars->GetNumberOfComponents();
+  vtkDoubleArray *copy = NULL;
+  if ( !scalars->HasStandardMemoryLayout() )
+    {
+    copy = vtkDoubleArray::New();
+    copy->SetNumberOfTuples(scalars->GetNumberOfTuples());
+    for (vtkIdType i=0; i < scalars->GetNumberOfTuples(); i++)
+      {
+      copy->SetValue(i, scalars->GetComponent(i, 0));
+      }
+    scalars = copy;
+    numComp = 1;
+    }
+  switch (scalars->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkSpanSpaceBin(binner, this->DataSet,
+                      static_cast<VTK_TT *>(scalars->GetVoidPointer(0)),
+                      numComp, bins));
+    default:
+      vtkErrorMacro(<< "Unsupported scalar type " << scalars->GetDataType());
+      delete [] bins;
+      if ( copy )
+        {
+        copy->Delete();
+        }
+      return;
+    }
+  if ( copy )
+    {
+    copy->Delete();
+    }
+
+  // Counting sort of the cell ids by bin.  Offsets[b] first counts the
+  // cells of bin b, then gives where they start.  The bin of a cell is
+  // max*Resolution + min, so that the bins sharing a maximum are
+  // adjacent.
+  this->Offsets = new vtkIdType[numBins + 1];
+  this->CellIds = new vtkIdType[numCells];
+  std::fill(this->Offsets, this->Offsets + numBins + 1, 0);
+  vtkIdType cellId, b;
+  for (cellId=0; cellId < numCells; cellId++)
+    {
+    this->Offsets[bins[cellId]]++;
+    }
+  vtkIdType start = 0;
+  for (b=0; b < numBins; b++)
+    {
+    vtkIdType count = this->Offsets[b];
+    this->Offsets[b] = start;
+    start += count;
+    }
+  for (cellId=0; cellId < numCells; cellId++)
+    {
+    this->CellIds[this->Offsets[bins[cellId]]++] = cellId;
+    }
+  // Offsets[b] now is where bin b+1 starts.
+  for (b=numBins; b > 0; b--)
+    {
+    this->Offsets[b] = this->Offsets[b-1];
+    }
+  this->Offsets[0] = 0;
+  delete [] bins;
+
+  this->NumberOfCells = numCells;
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+// Begin to traverse the cells based on a scalar value. Returned cells
+// will have scalar values that span the scalar value specified.
+void vtkSpanSpace::InitTraversal(double scalarValue)
+{
+  this->BuildTree();
+
+  this->ScalarValue = scalarValue;
+  this->Batches->Reset();
+  this->Batches->SetNumberOfComponents(2);
+  this->CurrentBatch = 0;
+  this->CurrentCell = 0;
+  if ( !this->Offsets || scalarValue < this->Range[0] ||
+       scalarValue > this->Range[1] )
+    {
+    return;
+    }
+
+  // The candidates have a minimum in the bins up to that of the value,
+  // and a maximum in the bins from that of the value: one range of cell
+  // ids per maximum, cut into batches.
+  vtkSpanSpaceBinner binner;
+  binner.Min = this->Range[0];
+  binner.Scale = this->Resolution / (this->Range[1] - this->Range[0]);
+  binner.Resolution = this->Resolution;
+  vtkIdType bin = binner.GetBin(scalarValue);
+  for (vtkIdType max=bin; max < this->Resolution; max++)
+    {
+    vtkIdType start = this->Offsets[max*this->Resolution];
+    vtkIdType end = this->Offsets[max*this->Resolution + bin + 1];
+    for ( ; start < end; start += this->BatchSize)
+      {
+      this->Batches->InsertNextValue(start);
+      this->Batches->InsertNextValue(
+        start + this->BatchSize < end ? start + this->BatchSize : end);
+      }
+    }
+  if ( this->Batches->GetNumberOfTuples() > 0 )
+    {
+    this->CurrentCell = this->Batches->GetValue(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSpanSpace::GetNumberOfCellBatches()
+{
+  return this->Batches->GetNumberOfTuples();
+}
+
+//----------------------------------------------------------------------------
+const vtkIdType *vtkSpanSpace::GetCellBatch(vtkIdType batchNum,
+                                            vtkIdType &numCells)
+{
+  if ( batchNum < 0 || batchNum >= this->Batches->GetNumberOfTuples() )
+    {
+    numCells = 0;
+    return NULL;
+    }
+  vtkIdType *batch = this->Batches->GetPointer(2*batchNum);
+  numCells = batch[1] - batch[0];
+  return this->CellIds + batch[0];
+}
+
+//----------------------------------------------------------------------------
+// Return the next cell that may contain scalar value specified to
+// initialize traversal. The value NULL is returned if the list is
+// exhausted. Make sure that InitTraversal() has been invoked first or
+// you'll get erratic behavior.
+vtkCell *vtkSpanSpace::GetNextCell(vtkIdType& cellId, vtkIdList* &cellPts,
+                                   vtkDataArray *cellScalars)
+{
+  vtkIdType numBatches = this->Batches->GetNumberOfTuples();
+  while ( this->CurrentBatch < numBatches )
+    {
+    vtkIdType end = this->Batches->GetValue(2*this->CurrentBatch + 1);
+    while ( this->CurrentCell < end )
+      {
+      vtkIdType id = this->CellIds[this->CurrentCell++];
+      vtkCell *cell = this->DataSet->GetCell(id);
+      cellPts = cell->GetPointIds();
+      vtkIdType numScalars = cellPts->GetNumberOfIds();
+      cellScalars->SetNumberOfTuples(numScalars);
+      this->Scalars->GetTuples(cellPts, cellScalars);
+      double min = VTK_DOUBLE_MAX, max = -VTK_DOUBLE_MAX;
+      for (vtkIdType i=0; i < numScalars; i++)
+        {
+        double s = cellScalars->GetComponent(i, 0);
+        if ( s < min )
+          {
+          min = s;
+          }
+        if ( s > max )
+          {
+          max = s;
+          }
+        }
+      if ( this->ScalarValue >= min && this->ScalarValue <= max )
+        {
+        cellId = id;
+        return cell;
+        }
+      } //for each candidate of this batch
+
+    if ( ++this->CurrentBatch < numBatches )
+      {
+      this->CurrentCell = this->Batches->GetValue(2*this->CurrentBatch);
+      }
+    } //while not all batches visited
+
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkSpanSpace::GetActualMemorySize()
+{
+  if ( !this->Offsets )
+    {
+    return 0;
+    }
+  size_t size = (this->Resolution * this->Resolution + 1 +
+                 this->NumberOfCells) * sizeof(vtkIdType);
+  return static_cast<unsigned long>((size + 1023) / 1024); //kilobytes
+}
+
+//----------------------------------------------------------------------------
+void vtkSpanSpace::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Resolution: " << this->Resolution << "\n";
+  os << indent << "Compute Resolution: "
+     << (this->ComputeResolution ? "On\n" : "Off\n");
+  os << indent << "Number of Cells Per Bucket: "
+     << this->NumberOfCellsPerBucket << "\n";
+  os << indent << "Batch Size: " << this->BatchSize << "\n";
+}
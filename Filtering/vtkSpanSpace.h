@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpanSpace.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSpanSpace - organize cells by their scalar range in span space (used to accelerate contouring operations)
+// .SECTION Description
+// vtkSpanSpace is a scalar tree that places each cell in the span space,
+// the plane whose coordinates are the minimum and the maximum of the
+// scalars of the points of the cell.  The span space is cut into
+// Resolution x Resolution bins over the range of the scalars, and the
+// cell ids are sorted by bin into a single array, with an array of
+// offsets giving where the ids of each bin start.  The cells spanning a
+// scalar value lie in the bins whose minimum is at most the value and
+// whose maximum is at least the value; for a given maximum these bins are
+// adjacent in the array, so the candidates of a value are Resolution
+// ranges of cell ids at most.  Only the cells of the bins containing the
+// value are candidates that do not necessarily span it.
+//
+// Unlike vtkSimpleScalarTree, which visits every cell of the leaves whose
+// range spans the value, the cost of a traversal is proportional to the
+// number of cells spanning the value.  BuildTree() computes the bins of
+// the cells in parallel (see vtkSMPTools) and sorts the ids with a
+// counting sort.  The candidates are also available in batches of at
+// most BatchSize cells, so that they can be contoured concurrently: see
+// vtkContourGrid.
+//
+// The tree uses one id per cell plus one per bin.  It is built from
+// the first component of the point scalars.
+
+// .SECTION See Also
+// vtkScalarTree vtkSimpleScalarTree vtkContourGrid vtkSMPTools
+
+#ifndef __vtkSpanSpace_h
+#define __vtkSpanSpace_h
+
+#include "vtkScalarTree.h"
+
+class vtkIdTypeArray;
+
+class VTK_FILTERING_EXPORT vtkSpanSpace : public vtkScalarTree
+{
+public:
+  // Description:
+  // Instantiate a span space whose resolution is computed to hold five
+  // cells per bin on average, and whose batches hold 1000 cells at most.
+  static vtkSpanSpace *New();
+
+  // Description:
+  // Standard type related macros and PrintSelf() method.
+  vtkTypeMacro(vtkSpanSpace,vtkScalarTree);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set/Get the number of bins along each axis of the span space.  Used
+  // when ComputeResolution is off.  Finer bins mean fewer candidates that
+  // do not span the value, but more memory for the offsets of the bins.
+  vtkSetClampMacro(Resolution,vtkIdType,1,10000);
+  vtkGetMacro(Resolution,vtkIdType);
+
+  // Description:
+  // Compute the resolution from the number of cells so that the bins
+  // hold NumberOfCellsPerBucket cells on average.  On by default.
+  vtkSetMacro(ComputeResolution,int);
+  vtkGetMacro(ComputeResolution,int);
+  vtkBooleanMacro(ComputeResolution,int);
+
+  // Description:
+  // Specify the average number of cells in each bin.  Used when
+  // ComputeResolution is on.
+  vtkSetClampMacro(NumberOfCellsPerBucket,int,1,VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfCellsPerBucket,int);
+
+  // Description:
+  // Set/Get the maximum number of cells of a batch returned by
+  // GetCellBatch().
+  vtkSetClampMacro(BatchSize,vtkIdType,1,VTK_LARGE_ID);
+  vtkGetMacro(BatchSize,vtkIdType);
+
+  // Description:
+  // Construct the span space from the dataset provided.  Checks build
+  // times and modified time from input and reconstructs the tree if
+  // necessary.
+  virtual void BuildTree();
+
+  // Description:
+  // Initialize locator. Frees memory and resets object as appropriate.
+  virtual void Initialize();
+
+  // Description:
+  // Begin to traverse the cells based on a scalar value. Returned cells
+  // will have scalar values that span the scalar value specified.
+  virtual void InitTraversal(double scalarValue);
+
+  // Description:
+  // Return the next cell that may contain scalar value specified to
+  // initialize traversal. The value NULL is returned if the list is
+  // exhausted. Make sure that InitTraversal() has been invoked first or
+  // you'll get erratic behavior.
+  virtual vtkCell *GetNextCell(vtkIdType &cellId, vtkIdList* &ptIds,
+                               vtkDataArray *cellScalars);
+
+  // Description:
+  // Get the candidate cells of the scalar value given to InitTraversal()
+  // in batches of at most BatchSize cells.  Thread safe once
+  // InitTraversal() has returned.
+  virtual vtkIdType GetNumberOfCellBatches();
+  virtual const vtkIdType *GetCellBatch(vtkIdType batchNum,
+                                        vtkIdType &numCells);
+
+  // Description:
+  // Return the memory in kilobytes used by the bin offsets and the sorted
+  // cell ids.
+  unsigned long GetActualMemorySize();
+
+protected:
+  vtkSpanSpace();
+  ~vtkSpanSpace();
+
+  vtkIdType Resolution;
+  int ComputeResolution;
+  int NumberOfCellsPerBucket;
+  vtkIdType BatchSize;
+
+  double Range[2]; //range of the scalars covered by the bins
+  vtkIdType NumberOfCells; //number of cells sorted
+  vtkIdType *Offsets; //where the ids of each bin start, Resolution^2+1
+  vtkIdType *CellIds; //cell ids sorted by bin
+
+private:
+  vtkIdTypeArray *Batches; //start and end of each batch in CellIds
+  vtkIdType CurrentBatch; //traversal location within the batches
+  vtkIdType CurrentCell; //traversal location within CellIds
+
+private:
+  vtkSpanSpace(const vtkSpanSpace&);  // Not implemented.
+  void operator=(const vtkSpanSpace&);  // Not implemented.
+};
+
+#endif
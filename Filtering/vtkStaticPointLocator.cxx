@@ -0,0 +1,653 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticPointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticPointLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkStaticPointLocator);
+
+//----------------------------------------------------------------------------
+// Computes the bucket of each point.  The points are read directly from
+// the array when it holds float or double values.
+class vtkStaticPointLocatorBinner
+{
+public:
+  double Origin[3];
+  double InvH[3];
+  int Divisions[3];
+  vtkIdType *Buckets;
+
+  vtkIdType GetBucket(const double x[3]) const
+    {
+    int ijk[3];
+    for (int i = 0; i < 3; i++)
+      {
+      ijk[i] = static_cast<int>((x[i] - this->Origin[i]) * this->InvH[i]);
+      ijk[i] = (ijk[i] < 0 ? 0 :
+                (ijk[i] >= this->Divisions[i] ? this->Divisions[i] - 1 :
+                 ijk[i]));
+      }
+    return ijk[0] + static_cast<vtkIdType>(this->Divisions[0]) *
+      (ijk[1] + static_cast<vtkIdType>(this->Divisions[1]) * ijk[2]);
+    }
+};
+
+template <class T>
+class vtkStaticPointLocatorBinPoints : public vtkStaticPointLocatorBinner
+{
+public:
+  const T *Points;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double x[3];
+    const T *p = this->Points + 3 * begin;
+    for (vtkIdType i = begin; i < end; i++, p += 3)
+      {
+      x[0] = static_cast<double>(p[0]);
+      x[1] = static_cast<double>(p[1]);
+      x[2] = static_cast<double>(p[2]);
+      this->Buckets[i] = this->GetBucket(x);
+      }
+    }
+};
+
+class vtkStaticPointLocatorBinDataSet : public vtkStaticPointLocatorBinner
+{
+public:
+  vtkDataSet *DataSet;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double x[3];
+    for (vtkIdType i = begin; i < end; i++)
+      {
+      this->DataSet->GetPoint(i, x);
+      this->Buckets[i] = this->GetBucket(x);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkStaticPointLocator::vtkStaticPointLocator()
+{
+  this->Divisions[0] = this->Divisions[1] = this->Divisions[2] = 50;
+  this->NumberOfPointsPerBucket = 5;
+  this->H[0] = this->H[1] = this->H[2] = 0.0;
+  this->NumberOfBuckets = 0;
+  this->Offsets = NULL;
+  this->PointIds = NULL;
+}
+
+//----------------------------------------------------------------------------
+vtkStaticPointLocator::~vtkStaticPointLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FreeSearchStructure()
+{
+  delete [] this->Offsets;
+  this->Offsets = NULL;
+  delete [] this->PointIds;
+  this->PointIds = NULL;
+  this->NumberOfBuckets = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::BuildLocator()
+{
+  vtkIdType numPts;
+  int i;
+
+  if ( !this->DataSet )
+    {
+    vtkErrorMacro( << "No data set to subdivide");
+    return;
+    }
+
+  if ( (this->Offsets != NULL) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+    {
+    return;
+    }
+
+  vtkDebugMacro( << "Sorting points into buckets..." );
+  this->Level = 1; //only single lowest level
+
+  if ( (numPts = this->DataSet->GetNumberOfPoints()) < 1 )
+    {
+    vtkErrorMacro( << "No points to subdivide");
+    return;
+    }
+  this->FreeSearchStructure();
+
+  // Size the buckets like vtkPointLocator does.
+  double *bounds = this->DataSet->GetBounds();
+  for (i=0; i<3; i++)
+    {
+    this->Bounds[2*i] = bounds[2*i];
+    this->Bounds[2*i+1] = bounds[2*i+1];
+    if ( this->Bounds[2*i+1] <= this->Bounds[2*i] ) //prevent zero width
+      {
+      this->Bounds[2*i+1] = this->Bounds[2*i] + 1.0;
+      }
+    }
+
+  int ndivs[3];
+  if ( this->Automatic )
+    {
+    double level = static_cast<double>(numPts) / this->NumberOfPointsPerBucket;
+    level = ceil( pow(level, 0.33333333) );
+    for (i=0; i<3; i++)
+      {
+      ndivs[i] = static_cast<int>(level);
+      }
+    }
+  else
+    {
+    for (i=0; i<3; i++)
+      {
+      ndivs[i] = this->Divisions[i];
+      }
+    }
+  for (i=0; i<3; i++)
+    {
+    this->Divisions[i] = (ndivs[i] > 0 ? ndivs[i] : 1);
+    this->H[i] = (this->Bounds[2*i+1] - this->Bounds[2*i]) / this->Divisions[i];
+    }
+  this->NumberOfBuckets = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1] * this->Divisions[2];
+
+  // Compute the bucket of each point in parallel.
+  vtkIdType *buckets = new vtkIdType[numPts];
+  vtkStaticPointLocatorBinner binner;
+  for (i=0; i<3; i++)
+    {
+    binner.Origin[i] = this->Bounds[2*i];
+    binner.InvH[i] = 1.0 / this->H[i];
+    binner.Divisions[i] = this->Divisions[i];
+    }
+  binner.Buckets = buckets;
+
+  vtkPointSet *pointSet = vtkPointSet::SafeDownCast(this->DataSet);
+  vtkDataArray *data = (pointSet && pointSet->GetPoints()) ?
+    pointSet->GetPoints()->GetData() : NULL;
+  if (data && data->GetDataType() == VTK_FLOAT)
+    {
+    vtkStaticPointLocatorBinPoints<float> functor;
+    static_cast<vtkStaticPointLocatorBinner&>(functor) = binner;
+    functor.Points = static_cast<float*>(data->GetVoidPointer(0));
+    vtkSMPTools::For(0, numPts, 10000, functor);
+    }
+  else if (data && data->GetDataType() == VTK_DOUBLE)
+    {
+    vtkStaticPointLocatorBinPoints<double> functor;
+    static_cast<vtkStaticPointLocatorBinner&>(functor) = binner;
+    functor.Points = static_cast<double*>(data->GetVoidPointer(0));
+    vtkSMPTools::For(0, numPts, 10000, functor);
+    }
+  else
+    {
+    vtkStaticPointLocatorBinDataSet functor;
+    static_cast<vtkStaticPointLocatorBinner&>(functor) = binner;
+    functor.DataSet = this->DataSet;
+    vtkSMPTools::For(0, numPts, 10000, functor);
+    }
+
+  // Counting sort of the point ids by bucket.  Offsets[b] first counts
+  // the points of bucket b, then gives where they start.
+  vtkIdType numBuckets = this->NumberOfBuckets;
+  this->Offsets = new vtkIdType[numBuckets + 1];
+  this->PointIds = new vtkIdType[numPts];
+  std::fill(this->Offsets, this->Offsets + numBuckets + 1, 0);
+  vtkIdType ptId, b;
+  for (ptId=0; ptId < numPts; ptId++)
+    {
+    this->Offsets[buckets[ptId]]++;
+    }
+  vtkIdType start = 0;
+  for (b=0; b < numBuckets; b++)
+    {
+    vtkIdType count = this->Offsets[b];
+    this->Offsets[b] = start;
+    start += count;
+    }
+  for (ptId=0; ptId < numPts; ptId++)
+    {
+    this->PointIds[this->Offsets[buckets[ptId]]++] = ptId;
+    }
+  // Offsets[b] now is where bucket b+1 starts.
+  for (b=numBuckets; b > 0; b--)
+    {
+    this->Offsets[b] = this->Offsets[b-1];
+    }
+  this->Offsets[0] = 0;
+  delete [] buckets;
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkStaticPointLocator::GetActualMemorySize()
+{
+  if ( !this->Offsets )
+    {
+    return 0;
+    }
+  size_t size = (this->NumberOfBuckets + 1) * sizeof(vtkIdType) +
+    this->Offsets[this->NumberOfBuckets] * sizeof(vtkIdType);
+  return static_cast<unsigned long>((size + 1023) / 1024); //kilobytes
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketIndices(const double x[3], int ijk[3])
+{
+  for (int i=0; i<3; i++)
+    {
+    ijk[i] = static_cast<int>((x[i] - this->Bounds[2*i]) / this->H[i]);
+    ijk[i] = (ijk[i] < 0 ? 0 :
+              (ijk[i] >= this->Divisions[i] ? this->Divisions[i] - 1 : ijk[i]));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketRange(const double x[3], double r,
+                                           int lo[3], int hi[3])
+{
+  double xMin[3], xMax[3];
+  for (int i=0; i<3; i++)
+    {
+    xMin[i] = x[i] - r;
+    xMax[i] = x[i] + r;
+    }
+  this->GetBucketIndices(xMin, lo);
+  this->GetBucketIndices(xMax, hi);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestPointInBuckets(const double x[3],
+                                                      const int lo[3],
+                                                      const int hi[3],
+                                                      vtkIdType& closest,
+                                                      double& minDist2)
+{
+  double pt[3], dist2;
+  vtkIdType sliceSize = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1];
+  for (int k=lo[2]; k <= hi[2]; k++)
+    {
+    for (int j=lo[1]; j <= hi[1]; j++)
+      {
+      vtkIdType row = j * this->Divisions[0] + k * sliceSize;
+      for (int i=lo[0]; i <= hi[0]; i++)
+        {
+        vtkIdType b = row + i;
+        for (vtkIdType n=this->Offsets[b]; n < this->Offsets[b+1]; n++)
+          {
+          vtkIdType ptId = this->PointIds[n];
+          this->DataSet->GetPoint(ptId, pt);
+          dist2 = vtkMath::Distance2BetweenPoints(x, pt);
+          if ( dist2 < minDist2 || (dist2 == minDist2 && ptId < closest) )
+            {
+            closest = ptId;
+            minDist2 = dist2;
+            }
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPoint(const double x[3])
+{
+  this->BuildLocator();
+  if ( !this->Offsets )
+    {
+    return -1;
+    }
+
+  // Search shells of buckets of increasing level around the bucket of x
+  // until one contains a point.
+  int ijk[3], lo[3], hi[3], i, j, k, level;
+  vtkIdType closest = -1;
+  double minDist2 = VTK_DOUBLE_MAX;
+  this->GetBucketIndices(x, ijk);
+  vtkIdType sliceSize = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1];
+  for (level=0; closest < 0; level++)
+    {
+    int covered = 1;
+    for (i=0; i<3; i++)
+      {
+      lo[i] = (ijk[i] - level < 0 ? 0 : ijk[i] - level);
+      hi[i] = (ijk[i] + level >= this->Divisions[i] ?
+               this->Divisions[i] - 1 : ijk[i] + level);
+      covered = covered && lo[i] == 0 && hi[i] == this->Divisions[i] - 1;
+      }
+    for (k=lo[2]; k <= hi[2]; k++)
+      {
+      int kIn = (k > ijk[2] - level && k < ijk[2] + level);
+      for (j=lo[1]; j <= hi[1]; j++)
+        {
+        int jIn = kIn && (j > ijk[1] - level && j < ijk[1] + level);
+        for (i=lo[0]; i <= hi[0]; i++)
+          {
+          if ( jIn && i > ijk[0] - level && i < ijk[0] + level )
+            {
+            continue; // searched at a previous level
+            }
+          vtkIdType b = i + j * this->Divisions[0] + k * sliceSize;
+          if ( this->Offsets[b] < this->Offsets[b+1] )
+            {
+            int one[3] = {i, j, k};
+            this->FindClosestPointInBuckets(x, one, one, closest, minDist2);
+            }
+          }
+        }
+      }
+    if ( covered )
+      {
+      break;
+      }
+    }
+
+  // A closer point may lie in the buckets overlapping the sphere through
+  // the point found.
+  if ( closest >= 0 && minDist2 > 0.0 )
+    {
+    this->GetBucketRange(x, sqrt(minDist2), lo, hi);
+    this->FindClosestPointInBuckets(x, lo, hi, closest, minDist2);
+    }
+  return closest;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkStaticPointLocator::FindClosestPointWithinRadius(
+  double radius, const double x[3], double& dist2)
+{
+  this->BuildLocator();
+  vtkIdType closest = -1;
+  dist2 = radius * radius;
+  if ( !this->Offsets )
+    {
+    return -1;
+    }
+
+  // Accept points at exactly the radius.
+  double minDist2 = dist2 * (1.0 + 1.0e-12);
+  int lo[3], hi[3];
+  this->GetBucketRange(x, radius, lo, hi);
+  this->FindClosestPointInBuckets(x, lo, hi, closest, minDist2);
+  if ( closest >= 0 )
+    {
+    dist2 = minDist2;
+    }
+  return closest;
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
+                                                   vtkIdList *result)
+{
+  result->Reset();
+  this->BuildLocator();
+  if ( !this->Offsets )
+    {
+    return;
+    }
+
+  int lo[3], hi[3], i, j, k;
+  double pt[3], R2 = R * R;
+  this->GetBucketRange(x, R, lo, hi);
+  vtkIdType sliceSize = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1];
+  for (k=lo[2]; k <= hi[2]; k++)
+    {
+    for (j=lo[1]; j <= hi[1]; j++)
+      {
+      vtkIdType row = j * this->Divisions[0] + k * sliceSize;
+      for (i=lo[0]; i <= hi[0]; i++)
+        {
+        vtkIdType b = row + i;
+        for (vtkIdType n=this->Offsets[b]; n < this->Offsets[b+1]; n++)
+          {
+          this->DataSet->GetPoint(this->PointIds[n], pt);
+          if ( vtkMath::Distance2BetweenPoints(x, pt) <= R2 )
+            {
+            result->InsertNextId(this->PointIds[n]);
+            }
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPoints(int N, const double x[3],
+                                               vtkIdList *result)
+{
+  result->Reset();
+  this->BuildLocator();
+  if ( !this->Offsets || N <= 0 )
+    {
+    return;
+    }
+  vtkIdType numPts = this->Offsets[this->NumberOfBuckets];
+  if ( N > numPts )
+    {
+    N = static_cast<int>(numPts);
+    }
+
+  // Grow a box of buckets around x until it holds N points.
+  int ijk[3], lo[3], hi[3], i, j, k, level;
+  vtkIdType sliceSize = static_cast<vtkIdType>(this->Divisions[0]) *
+    this->Divisions[1];
+  this->GetBucketIndices(x, ijk);
+  for (level=0; ; level++)
+    {
+    vtkIdType count = 0;
+    for (i=0; i<3; i++)
+      {
+      lo[i] = (ijk[i] - level < 0 ? 0 : ijk[i] - level);
+      hi[i] = (ijk[i] + level >= this->Divisions[i] ?
+               this->Divisions[i] - 1 : ijk[i] + level);
+      }
+    for (k=lo[2]; k <= hi[2]; k++)
+      {
+      for (j=lo[1]; j <= hi[1]; j++)
+        {
+        vtkIdType row = j * this->Divisions[0] + k * sliceSize;
+        count += this->Offsets[row + hi[0] + 1] - this->Offsets[row + lo[0]];
+        }
+      }
+    if ( count >= N )
+      {
+      break;
+      }
+    }
+
+  // The N closest points of the box bound the distance of the N closest
+  // points; gather all the points within that distance.
+  typedef std::pair<double, vtkIdType> DistanceAndId;
+  std::vector<DistanceAndId> candidates;
+  double pt[3];
+  for (int pass=0; pass < 2; pass++)
+    {
+    double maxDist2 = VTK_DOUBLE_MAX;
+    if ( pass == 1 )
+      {
+      std::nth_element(candidates.begin(), candidates.begin() + (N - 1),
+                       candidates.end());
+      maxDist2 = candidates[N - 1].first;
+      this->GetBucketRange(x, sqrt(maxDist2), lo, hi);
+      candidates.clear();
+      }
+    for (k=lo[2]; k <= hi[2]; k++)
+      {
+      for (j=lo[1]; j <= hi[1]; j++)
+        {
+        vtkIdType row = j * this->Divisions[0] + k * sliceSize;
+        for (vtkIdType n=this->Offsets[row + lo[0]];
+             n < this->Offsets[row + hi[0] + 1]; n++)
+          {
+          this->DataSet->GetPoint(this->PointIds[n], pt);
+          double dist2 = vtkMath::Distance2BetweenPoints(x, pt);
+          if ( dist2 <= maxDist2 )
+            {
+            candidates.push_back(DistanceAndId(dist2, this->PointIds[n]));
+            }
+          }
+        }
+      }
+    }
+
+  std::partial_sort(candidates.begin(), candidates.begin() + N,
+                    candidates.end());
+  result->SetNumberOfIds(N);
+  for (i=0; i < N; i++)
+    {
+    result->SetId(i, candidates[i].second);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GetBucketIds(vtkIdType bucket, vtkIdList *bList)
+{
+  bList->Reset();
+  if ( !this->Offsets || bucket < 0 || bucket >= this->NumberOfBuckets )
+    {
+    return;
+    }
+  vtkIdType numIds = this->Offsets[bucket+1] - this->Offsets[bucket];
+  bList->SetNumberOfIds(numIds);
+  for (vtkIdType i=0; i < numIds; i++)
+    {
+    bList->SetId(i, this->PointIds[this->Offsets[bucket] + i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Build a polygonal representation of the boundary between the empty and
+// non-empty buckets.
+void vtkStaticPointLocator::GenerateRepresentation(int vtkNotUsed(level),
+                                                   vtkPolyData *pd)
+{
+  if ( this->Offsets == NULL )
+    {
+    vtkErrorMacro(<<"Can't build representation...no data!");
+    return;
+    }
+
+  vtkPoints *pts = vtkPoints::New();
+  pts->Allocate(5000);
+  vtkCellArray *polys = vtkCellArray::New();
+  polys->Allocate(10000);
+
+  int ijk[3], nei[3], ii;
+  for (ijk[2]=0; ijk[2] < this->Divisions[2]; ijk[2]++)
+    {
+    for (ijk[1]=0; ijk[1] < this->Divisions[1]; ijk[1]++)
+      {
+      for (ijk[0]=0; ijk[0] < this->Divisions[0]; ijk[0]++)
+        {
+        vtkIdType idx = ijk[0] + this->Divisions[0] *
+          (ijk[1] + static_cast<vtkIdType>(this->Divisions[1]) * ijk[2]);
+        int inside = this->GetNumberOfPointsInBucket(idx) > 0;
+
+        // A face separates the bucket from its "negative" neighbor.
+        for (ii=0; ii < 3; ii++)
+          {
+          nei[0] = ijk[0]; nei[1] = ijk[1]; nei[2] = ijk[2];
+          nei[ii]--;
+          int neiInside = 0;
+          if ( nei[ii] >= 0 )
+            {
+            vtkIdType neiIdx = nei[0] + this->Divisions[0] *
+              (nei[1] + static_cast<vtkIdType>(this->Divisions[1]) * nei[2]);
+            neiInside = this->GetNumberOfPointsInBucket(neiIdx) > 0;
+            }
+          if ( inside != neiInside )
+            {
+            this->GenerateFace(ii, ijk[0], ijk[1], ijk[2], pts, polys);
+            }
+          // Buckets on the "positive" boundaries close the surface.
+          if ( inside && ijk[ii] + 1 == this->Divisions[ii] )
+            {
+            nei[ii] = ijk[ii] + 1;
+            this->GenerateFace(ii, nei[0], nei[1], nei[2], pts, polys);
+            nei[ii] = ijk[ii];
+            }
+          }
+        }
+      }
+    }
+
+  pd->SetPoints(pts);
+  pts->Delete();
+  pd->SetPolys(polys);
+  polys->Delete();
+  pd->Squeeze();
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::GenerateFace(int face, int i, int j, int k,
+                                         vtkPoints *pts, vtkCellArray *polys)
+{
+  vtkIdType ids[4];
+  double origin[3], x[3];
+  int a = (face + 1) % 3, b = (face + 2) % 3;
+
+  origin[0] = this->Bounds[0] + i * this->H[0];
+  origin[1] = this->Bounds[2] + j * this->H[1];
+  origin[2] = this->Bounds[4] + k * this->H[2];
+  ids[0] = pts->InsertNextPoint(origin);
+
+  x[0] = origin[0]; x[1] = origin[1]; x[2] = origin[2];
+  x[a] += this->H[a];
+  ids[1] = pts->InsertNextPoint(x);
+  x[b] += this->H[b];
+  ids[2] = pts->InsertNextPoint(x);
+  x[a] = origin[a];
+  ids[3] = pts->InsertNextPoint(x);
+
+  polys->InsertNextCell(4,ids);
+}
+
+//----------------------------------------------------------------------------
+void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number of Points Per Bucket: "
+     << this->NumberOfPointsPerBucket << "\n";
+  os << indent << "Divisions: (" << this->Divisions[0] << ", "
+     << this->Divisions[1] << ", " << this->Divisions[2] << ")\n";
+  os << indent << "Number of Buckets: " << this->NumberOfBuckets << "\n";
+}
@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticPointLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkStaticPointLocator - quickly locate points of a dataset that does not change
+// .SECTION Description
+// vtkStaticPointLocator divides the bounds of the points of a dataset
+// into a regular array of "rectangular" buckets, like vtkPointLocator.
+// Instead of one vtkIdList per bucket, the point ids are sorted by bucket
+// into a single array, with an array of offsets giving where the ids of
+// each bucket start.  BuildLocator() computes the buckets of the points
+// in parallel (see vtkSMPTools) and sorts the ids with a counting sort, so
+// that building is fast and uses two arrays whatever the number of
+// points.
+//
+// Points cannot be inserted once the locator is built: use
+// vtkPointLocator to merge points.  Since the search structure does not
+// change after BuildLocator(), all the Find methods are thread safe once
+// BuildLocator() was called from a single thread, as long as the dataset
+// is not modified.
+//
+// .SECTION See Also
+// vtkPointLocator vtkKdTreePointLocator vtkOctreePointLocator vtkSMPTools
+
+#ifndef __vtkStaticPointLocator_h
+#define __vtkStaticPointLocator_h
+
+#include "vtkAbstractPointLocator.h"
+
+class vtkCellArray;
+class vtkIdList;
+class vtkPoints;
+
+class VTK_FILTERING_EXPORT vtkStaticPointLocator : public vtkAbstractPointLocator
+{
+public:
+  // Description:
+  // Construct with automatic computation of divisions, averaging
+  // 5 points per bucket.
+  static vtkStaticPointLocator *New();
+
+  vtkTypeMacro(vtkStaticPointLocator,vtkAbstractPointLocator);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set the number of divisions in x-y-z directions.  Used when Automatic
+  // is off.
+  vtkSetVector3Macro(Divisions,int);
+  vtkGetVectorMacro(Divisions,int,3);
+
+  // Description:
+  // Specify the average number of points in each bucket.  Used when
+  // Automatic is on.
+  vtkSetClampMacro(NumberOfPointsPerBucket,int,1,VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfPointsPerBucket,int);
+
+  // Description:
+  // Given a position x, return the id of the point closest to it.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual vtkIdType FindClosestPoint(const double x[3]);
+
+  // Description:
+  // Given a position x and a radius r, return the id of the point
+  // closest to the point in that radius, or -1.  dist2 returns the
+  // squared distance to the point.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual vtkIdType FindClosestPointWithinRadius(
+    double radius, const double x[3], double& dist2);
+
+  // Description:
+  // Find the closest N points to a position.  The returned points are
+  // sorted from closest to farthest.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual void FindClosestNPoints(int N, const double x[3], vtkIdList *result);
+
+  // Description:
+  // Find all points within a specified radius R of position x.
+  // The result is sorted by bucket, not by distance.
+  // These methods are thread safe if BuildLocator() is directly or
+  // indirectly called from a single thread first.
+  virtual void FindPointsWithinRadius(double R, const double x[3],
+                                      vtkIdList *result);
+
+  // Description:
+  // Return the number of buckets, and the number and the ids of the
+  // points in a bucket.  Valid once the locator is built.
+  vtkIdType GetNumberOfBuckets() { return this->NumberOfBuckets; }
+  vtkIdType GetNumberOfPointsInBucket(vtkIdType bucket)
+    {
+    return this->Offsets ?
+      this->Offsets[bucket+1] - this->Offsets[bucket] : 0;
+    }
+  void GetBucketIds(vtkIdType bucket, vtkIdList *bList);
+
+  // Description:
+  // See vtkLocator interface documentation.
+  // These methods are not thread safe.
+  virtual void FreeSearchStructure();
+  virtual void BuildLocator();
+  virtual void GenerateRepresentation(int level, vtkPolyData *pd);
+
+  // Description:
+  // Return the memory in kilobytes used by the bucket offsets and the
+  // sorted point ids.
+  virtual unsigned long GetActualMemorySize();
+
+protected:
+  vtkStaticPointLocator();
+  virtual ~vtkStaticPointLocator();
+
+  // Description:
+  // Get the bucket containing x, clamped to the grid.
+  void GetBucketIndices(const double x[3], int ijk[3]);
+
+  // Description:
+  // Get the range of buckets overlapping the box of half width r around x.
+  void GetBucketRange(const double x[3], double r, int lo[3], int hi[3]);
+
+  // Description:
+  // Update closest and minDist2 with the points of the buckets in the
+  // range which are closer than minDist2.
+  void FindClosestPointInBuckets(const double x[3], const int lo[3],
+                                 const int hi[3], vtkIdType& closest,
+                                 double& minDist2);
+
+  void GenerateFace(int face, int i, int j, int k,
+                    vtkPoints *pts, vtkCellArray *polys);
+
+  int Divisions[3]; // Number of sub-divisions in x-y-z directions
+  int NumberOfPointsPerBucket; // Used when Automatic is on
+  double H[3]; // Width of each bucket in x-y-z directions
+  vtkIdType NumberOfBuckets;
+
+  // The ids of the points of bucket b are PointIds[Offsets[b]] to
+  // PointIds[Offsets[b+1]-1].
+  vtkIdType *Offsets;
+  vtkIdType *PointIds;
+
+private:
+  vtkStaticPointLocator(const vtkStaticPointLocator&);  // Not implemented.
+  void operator=(const vtkStaticPointLocator&);  // Not implemented.
+};
+
+#endif
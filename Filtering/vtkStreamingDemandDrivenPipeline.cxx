@@ -16,6 +16,7 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAsynchronousUpdate.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
 #include "vtkExtentTranslator.h"
@@ -65,6 +66,7 @@ vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, PIECE_BOUNDIN
 vtkInformationKeyRestrictedMacro(vtkStreamingDemandDrivenPipeline, PIECE_NORMAL, DoubleVector, 3);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, PRIORITY, Double);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, ORIGINAL_NUMBER_OF_CELLS, UnsignedLong);
+vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, ESTIMATED_MEMORY_SIZE, UnsignedLong);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, UPDATE_RESOLUTION, Double);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, REMOVE_ATTRIBUTE_INFORMATION, Integer);
 
@@ -364,6 +366,15 @@ int vtkStreamingDemandDrivenPipeline::UpdateWholeExtent()
   return this->Update();
 }
 
+//----------------------------------------------------------------------------
+vtkAsynchronousUpdate*
+vtkStreamingDemandDrivenPipeline::UpdateAsynchronously(int port)
+{
+  vtkAsynchronousUpdate* update = vtkAsynchronousUpdate::New();
+  update->Start(this, port);
+  return update;
+}
+
 //----------------------------------------------------------------------------
 int
 vtkStreamingDemandDrivenPipeline
@@ -655,6 +666,7 @@ vtkStreamingDemandDrivenPipeline
         // if they need to.
         outInfo->CopyEntry(inInfo, PRIORITY());
         outInfo->CopyEntry(inInfo, ORIGINAL_NUMBER_OF_CELLS());
+        outInfo->CopyEntry(inInfo, ESTIMATED_MEMORY_SIZE());
         outInfo->CopyEntry(inInfo, PIECE_NORMAL());
 
         vtkInformation *algsProps = this->GetAlgorithm()->GetInformation();
@@ -886,6 +898,44 @@ int vtkStreamingDemandDrivenPipeline::PropagateUpdateExtent(int outputPort)
                               this->GetOutputInformation());
 }
 
+//----------------------------------------------------------------------------
+int vtkStreamingDemandDrivenPipeline
+::PropagateUpdateExtentInformation(int outputPort)
+{
+  // The algorithm should not invoke anything on the executive.
+  if(!this->CheckAlgorithm("PropagateUpdateExtentInformation", 0))
+    {
+    return 0;
+    }
+
+  // Range check.
+  if(outputPort < -1 ||
+     outputPort >= this->Algorithm->GetNumberOfOutputPorts())
+    {
+    vtkErrorMacro("PropagateUpdateExtentInformation given output port index "
+                  << outputPort << " on an algorithm with "
+                  << this->Algorithm->GetNumberOfOutputPorts()
+                  << " output ports.");
+    return 0;
+    }
+
+  vtkInformation* request = vtkInformation::New();
+  request->Set(REQUEST_UPDATE_EXTENT_INFORMATION());
+  // The request is forwarded upstream through the pipeline.
+  request->Set(vtkExecutive::FORWARD_DIRECTION(),
+               vtkExecutive::RequestUpstream);
+  // Algorithms process this request after it is forwarded.
+  request->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+  request->Set(FROM_OUTPUT_PORT(), outputPort);
+
+  // Send the request.
+  int result = this->ProcessRequest(request,
+                                    this->GetInputInformation(),
+                                    this->GetOutputInformation());
+  request->Delete();
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkStreamingDemandDrivenPipeline
 ::VerifyOutputInformation(int outputPort,
@@ -28,6 +28,7 @@
 #define VTK_UPDATE_EXTENT_COMBINE 1
 #define VTK_UPDATE_EXTENT_REPLACE 2
 
+class vtkAsynchronousUpdate;
 class vtkExtentTranslator;
 class vtkInformationDoubleKey;
 class vtkInformationDoubleVectorKey;
@@ -58,12 +59,27 @@ public:
   virtual int Update(int port);
   virtual int UpdateWholeExtent();
 
+  // Description:
+  // Start bringing the given output port up-to-date on a worker thread
+  // and return immediately.  The returned handle can wait for the update,
+  // report its progress, cancel it and give its output.  The caller must
+  // Delete() it.  The pipeline must not be used until the update is done.
+  vtkAsynchronousUpdate* UpdateAsynchronously(int port);
+
   // Description:
   // Propagate the update request from the given output port back
   // through the pipeline.  Should be called only when information is
   // up to date.
   int PropagateUpdateExtent(int outputPort);
 
+  // Description:
+  // Send the update extent information request from the given output
+  // port back through the pipeline.  Sources describe the piece given
+  // by their update extent (see PRIORITY and ESTIMATED_MEMORY_SIZE) and
+  // the description flows back downstream.  Should be called after
+  // PropagateUpdateExtent.
+  int PropagateUpdateExtentInformation(int outputPort);
+
   // Description:
   // Set/Get the maximum number of pieces that can be requested from
   // the given port.  The maximum number of pieces is meta data for
@@ -254,6 +270,13 @@ public:
   // pipeline, so that work estimates can be made.
   static vtkInformationUnsignedLongKey* ORIGINAL_NUMBER_OF_CELLS();
 
+  // Description:
+  // Key that specifies an estimate, in kilobytes, of the memory needed
+  // by the data of this update extent.  Sources set it in the update
+  // extent information request, algorithms that change the size of the
+  // data may scale it.
+  static vtkInformationUnsignedLongKey* ESTIMATED_MEMORY_SIZE();
+
   // Description:
   // Key that specifies a requested resolution level for this update
   // extent. 0.0 is very low and 1.0 is full resolution.
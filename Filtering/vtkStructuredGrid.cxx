@@ -22,6 +22,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -941,7 +942,36 @@ void vtkStructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
 //----------------------------------------------------------------------------
 unsigned long vtkStructuredGrid::GetActualMemorySize()
 {
-  return this->vtkPointSet::GetActualMemorySize();
+  unsigned long size = this->vtkPointSet::GetActualMemorySize();
+  vtkUnsignedCharArray *visibility = this->PointVisibility->GetVisibilityById();
+  if ( visibility )
+    {
+    size += visibility->GetActualMemorySize();
+    }
+  visibility = this->CellVisibility->GetVisibilityById();
+  if ( visibility )
+    {
+    size += visibility->GetActualMemorySize();
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkStructuredGrid::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  this->vtkPointSet::ReportMemory(accounting);
+  vtkUnsignedCharArray *visibility = this->PointVisibility->GetVisibilityById();
+  if ( visibility )
+    {
+    accounting->Report(visibility, "PointVisibility",
+                       visibility->GetActualMemorySize());
+    }
+  visibility = this->CellVisibility->GetVisibilityById();
+  if ( visibility )
+    {
+    accounting->Report(visibility, "CellVisibility",
+                       visibility->GetActualMemorySize());
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -121,6 +121,10 @@ public:
   // IS THREAD SAFE.
   unsigned long GetActualMemorySize();
 
+  // Description:
+  // Also reports the point and cell visibility arrays. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
+
   // Description:
   // Shallow and Deep copy.
   void ShallowCopy(vtkDataObject *src);  
@@ -26,6 +26,7 @@
 #include "vtkDataSetAttributes.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkObjectFactory.h"
 #include "vtkStringArray.h"
 #include "vtkUnicodeStringArray.h"
@@ -169,6 +170,13 @@ unsigned long vtkTable::GetActualMemorySize()
          this->Superclass::GetActualMemorySize();
 }
 
+//----------------------------------------------------------------------------
+void vtkTable::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  this->Superclass::ReportMemory(accounting);
+  accounting->ReportFieldData(this->RowData, "RowData");
+}
+
 //
 // Row functions
 //
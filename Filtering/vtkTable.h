@@ -80,6 +80,10 @@ public:
   // arrays, etc. are not included in the return value).
   virtual unsigned long GetActualMemorySize();
 
+  // Description:
+  // Also reports the row data arrays. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
+
   // Description:
   // Get/Set the main data (columns) of the table.
   vtkGetObjectMacro(RowData, vtkDataSetAttributes);
@@ -16,22 +16,33 @@
 
 #include "vtkCellData.h"
 #include "vtkCommand.h"
+#include "vtkConditionVariable.h"
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
+#include <vector>
+
+
+// Initial value of EnableSMP for new filters.
+static int vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = 0;
 
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
   this->Threader = vtkMultiThreader::New();
   this->NumberOfThreads = this->Threader->GetNumberOfThreads();
+  this->EnableSMP = vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
+  this->DesiredBytesPerPiece = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -46,6 +57,21 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
   
   os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
+  os << indent << "DesiredBytesPerPiece: "
+     << this->DesiredBytesPerPiece << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedImageAlgorithm::SetGlobalDefaultEnableSMP(int enable)
+{
+  vtkThreadedImageAlgorithmGlobalDefaultEnableSMP = enable;
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedImageAlgorithm::GetGlobalDefaultEnableSMP()
+{
+  return vtkThreadedImageAlgorithmGlobalDefaultEnableSMP;
 }
 
 struct vtkImageThreadStruct
@@ -122,22 +148,13 @@ int vtkThreadedImageAlgorithm::SplitExtent(int splitExt[6],
 }
 
 
-// this mess is really a simple function. All it does is call
-// the ThreadedExecute method after setting the correct
-// extent for this thread. Its just a pain to calculate
-// the correct extent.
-VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+//----------------------------------------------------------------------------
+// Find the extent the filter must generate: the update extent of the
+// output the request came from or, for sinks, of the first input.
+// Returns 0 if there is nothing to do.
+static int vtkThreadedImageAlgorithmGetExecuteExtent(vtkImageThreadStruct *str,
+                                                     int ext[6])
 {
-  vtkImageThreadStruct *str;
-  int ext[6], splitExt[6], total;
-  int threadId, threadCount;
-  
-  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
-  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
-  
-  str = static_cast<vtkImageThreadStruct *>
-    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
-
   // if we have an output
   if (str->Filter->GetNumberOfOutputPorts())
     {
@@ -149,7 +166,7 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
     // update directly, for now an error
     if (outputPort == -1)
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return 0;
       }
   
     // get the update extent from the output port
@@ -179,9 +196,32 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
       }
     if (inPort >= str->Filter->GetNumberOfInputPorts())
       {
-      return VTK_THREAD_RETURN_VALUE;
+      return 0;
       }
     }
+  return 1;
+}
+
+// this mess is really a simple function. All it does is call
+// the ThreadedExecute method after setting the correct
+// extent for this thread. Its just a pain to calculate
+// the correct extent.
+VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
+{
+  vtkImageThreadStruct *str;
+  int ext[6], splitExt[6], total;
+  int threadId, threadCount;
+  
+  threadId = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->ThreadID;
+  threadCount = static_cast<vtkMultiThreader::ThreadInfo *>(arg)->NumberOfThreads;
+  
+  str = static_cast<vtkImageThreadStruct *>
+    (static_cast<vtkMultiThreader::ThreadInfo *>(arg)->UserData);
+
+  if (!vtkThreadedImageAlgorithmGetExecuteExtent(str, ext))
+    {
+    return VTK_THREAD_RETURN_VALUE;
+    }
   
   // execute the actual method with appropriate extent
   // first find out how many pieces extent can be split into.
@@ -211,6 +251,157 @@ VTK_THREAD_RETURN_TYPE vtkThreadedImageAlgorithmThreadedExecute( void *arg )
   return VTK_THREAD_RETURN_VALUE;
 }
 
+//----------------------------------------------------------------------------
+// Hands out the threadIds of the pieces executing in SMP mode.  Each id is
+// less than NumberOfThreads and used by one piece at a time, so subclasses
+// can index per-thread state with it as with vtkMultiThreader.  A pool
+// thread gets back the id it used for its previous piece, so the ids are
+// stable when the pool has no more threads than NumberOfThreads; extra
+// pool threads wait for an id to be released.
+class vtkThreadedImageAlgorithmThreadIds
+{
+public:
+  vtkThreadedImageAlgorithmThreadIds(int numberOfIds)
+    : Owners(numberOfIds, -1), Busy(numberOfIds, 0) {}
+
+  int Acquire()
+    {
+    int thread = vtkSMPThreadPool::GetThreadIndex();
+    int n = static_cast<int>(this->Busy.size());
+    int id = -1;
+    this->Lock.Lock();
+    while (id < 0)
+      {
+      // The id of the calling thread, then one nobody uses, then any
+      // free one.
+      int i;
+      for (i = 0; id < 0 && i < n; ++i)
+        {
+        if (!this->Busy[i] && this->Owners[i] == thread)
+          {
+          id = i;
+          }
+        }
+      for (i = 0; id < 0 && i < n; ++i)
+        {
+        if (!this->Busy[i] && this->Owners[i] < 0)
+          {
+          id = i;
+          this->Owners[i] = thread;
+          }
+        }
+      for (i = 0; id < 0 && i < n; ++i)
+        {
+        if (!this->Busy[i])
+          {
+          id = i;
+          }
+        }
+      if (id < 0)
+        {
+        this->Released.Wait(this->Lock);
+        }
+      }
+    this->Busy[id] = 1;
+    this->Lock.Unlock();
+    return id;
+    }
+
+  void Release(int id)
+    {
+    this->Lock.Lock();
+    this->Busy[id] = 0;
+    this->Released.Broadcast();
+    this->Lock.Unlock();
+    }
+
+private:
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Released;
+  std::vector<int> Owners;
+  std::vector<char> Busy;
+};
+
+//----------------------------------------------------------------------------
+// vtkSMPTools functor executing the pieces of the extent.
+class vtkThreadedImageAlgorithmFunctor
+{
+public:
+  vtkThreadedImageAlgorithmFunctor(vtkImageThreadStruct *str,
+                                   int extent[6], int numberOfPieces,
+                                   int numberOfThreads)
+    : Str(str), NumberOfPieces(numberOfPieces), ThreadIds(numberOfThreads)
+    {
+    memcpy(this->Extent, extent, sizeof(int)*6);
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    int splitExt[6];
+    for (vtkIdType piece = begin; piece < end; ++piece)
+      {
+      this->Str->Filter->SplitExtent(splitExt, this->Extent,
+                                     static_cast<int>(piece),
+                                     this->NumberOfPieces);
+      if (splitExt[1] < splitExt[0] ||
+          splitExt[3] < splitExt[2] ||
+          splitExt[5] < splitExt[4])
+        {
+        continue;
+        }
+      int threadId = this->ThreadIds.Acquire();
+      this->Str->Filter->ThreadedRequestData(
+        this->Str->Request, this->Str->InputsInfo, this->Str->OutputsInfo,
+        this->Str->Inputs, this->Str->Outputs, splitExt, threadId);
+      this->ThreadIds.Release(threadId);
+      }
+    }
+
+private:
+  vtkImageThreadStruct *Str;
+  int Extent[6];
+  int NumberOfPieces;
+  vtkThreadedImageAlgorithmThreadIds ThreadIds;
+};
+
+//----------------------------------------------------------------------------
+// Execute the pieces of the extent with vtkSMPTools.  With a desired
+// piece size the extent is cut in pieces of about that size, however many
+// threads there are, and the pool threads take them as they become idle.
+// Without one, it is cut in numberOfThreads pieces.
+static void vtkThreadedImageAlgorithmSMPExecute(vtkImageThreadStruct *str,
+                                                int numberOfThreads,
+                                                vtkIdType bytesPerPiece)
+{
+  int ext[6], splitExt[6];
+  if (!vtkThreadedImageAlgorithmGetExecuteExtent(str, ext))
+    {
+    return;
+    }
+
+  int numberOfPieces = numberOfThreads;
+  vtkImageData *data = (str->Outputs ? str->Outputs[0] : 0);
+  if (!data && str->Inputs && str->Inputs[0])
+    {
+    data = str->Inputs[0][0];
+    }
+  if (bytesPerPiece > 0 && data)
+    {
+    vtkIdType bytes = data->GetScalarSize() *
+      data->GetNumberOfScalarComponents();
+    for (int i = 0; i < 3; ++i)
+      {
+      bytes *= (ext[2*i+1] - ext[2*i] + 1);
+      }
+    vtkIdType pieces = (bytes + bytesPerPiece - 1) / bytesPerPiece;
+    numberOfPieces = static_cast<int>(pieces < 1 ? 1 :
+      (pieces > VTK_INT_MAX ? VTK_INT_MAX : pieces));
+    }
+
+  int total = str->Filter->SplitExtent(splitExt, ext, 0, numberOfPieces);
+  vtkThreadedImageAlgorithmFunctor functor(str, ext, total, numberOfThreads);
+  vtkSMPTools::For(0, total, 1, functor);
+}
 
 //----------------------------------------------------------------------------
 // This is the superclasses style of Execute method.  Convert it into
@@ -284,13 +475,21 @@ int vtkThreadedImageAlgorithm::RequestData(
     this->CopyAttributeData(str.Inputs[0][0],str.Outputs[0],inputVector);
     }
     
-  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
-  this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute, &str);  
-
   // always shut off debugging to avoid threading problems with GetMacros
   int debug = this->Debug;
   this->Debug = 0;
-  this->Threader->SingleMethodExecute();
+  if (this->EnableSMP)
+    {
+    vtkThreadedImageAlgorithmSMPExecute(&str, this->NumberOfThreads,
+                                        this->DesiredBytesPerPiece);
+    }
+  else
+    {
+    this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+    this->Threader->SetSingleMethod(vtkThreadedImageAlgorithmThreadedExecute,
+                                    &str);
+    this->Threader->SingleMethodExecute();
+    }
   this->Debug = debug;
 
   // free up the arrays
@@ -58,6 +58,41 @@ public:
   vtkSetClampMacro( NumberOfThreads, int, 1, VTK_MAX_THREADS );
   vtkGetMacro( NumberOfThreads, int );
 
+  // Description:
+  // Enable/Disable the use of vtkSMPTools instead of vtkMultiThreader to
+  // execute ThreadedRequestData.  In SMP mode the extent is split in
+  // pieces (see DesiredBytesPerPiece) executed by the persistent threads
+  // of vtkSMPThreadPool, so no thread is created per execution.  As with
+  // vtkMultiThreader, the threadId passed to ThreadedRequestData is less
+  // than NumberOfThreads and never used by two pieces executing at once,
+  // so subclasses may index per-thread state with it.  Unlike with
+  // vtkMultiThreader, there may be more pieces than NumberOfThreads, so a
+  // threadId may be passed for several pieces: per-thread state must be
+  // accumulated, not reset, by each piece.  At most NumberOfThreads
+  // pieces execute at once.
+  // The initial value is given by GetGlobalDefaultEnableSMP().
+  vtkSetMacro(EnableSMP, int);
+  vtkGetMacro(EnableSMP, int);
+  vtkBooleanMacro(EnableSMP, int);
+
+  // Description:
+  // Set/Get the approximate number of output bytes per piece in SMP
+  // mode.  When this is larger than 0, the extent is cut in pieces of
+  // about this size, whatever NumberOfThreads is, and the pool threads
+  // take the pieces one after the other as they become idle, which
+  // balances filters whose cost varies a lot across the extent.  As
+  // SplitExtent is used to cut the pieces, the number of pieces is
+  // limited by what SplitExtent can produce.  The default is 0: one
+  // piece per thread.
+  vtkSetMacro(DesiredBytesPerPiece, vtkIdType);
+  vtkGetMacro(DesiredBytesPerPiece, vtkIdType);
+
+  // Description:
+  // Set/Get the initial value of EnableSMP for new filters.  Off by
+  // default.
+  static void SetGlobalDefaultEnableSMP(int enable);
+  static int GetGlobalDefaultEnableSMP();
+
   // Description:
   // Putting this here until I merge graphics and imaging streaming.
   virtual int SplitExtent(int splitExt[6], int startExt[6], 
@@ -69,6 +104,8 @@ protected:
 
   vtkMultiThreader *Threader;
   int NumberOfThreads;
+  int EnableSMP;
+  vtkIdType DesiredBytesPerPiece;
   
   // Description:
   // This is called by the superclass.
@@ -32,6 +32,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkComputingResources.h"
+#include "vtkDataObject.h"
 #include "vtkExecutionScheduler.h"
 #include "vtkExecutive.h"
 #include "vtkExecutiveCollection.h"
@@ -41,11 +42,7 @@
 #include "vtkInformationExecutivePortVectorKey.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationObjectBaseKey.h"
-#include "vtkInformationVector.h"
-#include "vtkMultiThreader.h"
-#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
-#include "vtkThreadMessager.h"
 #include "vtkTimerLog.h"
 #include <vtksys/hash_set.hxx>
 
@@ -77,6 +74,8 @@ vtkThreadedStreamingPipeline::vtkThreadedStreamingPipeline()
   this->ForceDataRequest = NULL;
   this->Resources = NULL;
   this->Scheduler = NULL;
+  this->EnableMultiThreading = 0;
+  this->ExecutingTask = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -100,6 +99,12 @@ vtkThreadedStreamingPipeline::~vtkThreadedStreamingPipeline()
 void vtkThreadedStreamingPipeline::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "EnableMultiThreading: " << this->EnableMultiThreading
+     << endl;
+  os << indent << "LastDataRequestTime: " << this->LastDataRequestTime
+     << endl;
+  os << indent << "LastDataRequestTimeFromSource: "
+     << this->LastDataRequestTimeFromSource << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -112,6 +117,12 @@ void vtkThreadedStreamingPipeline::SetMultiThreadedEnabled(bool enabled)
   MultiThreadedEnabled = enabled;
 }
 
+//----------------------------------------------------------------------------
+bool vtkThreadedStreamingPipeline::GetMultiThreadedEnabled() 
+{
+  return MultiThreadedEnabled;
+}
+
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::SetAutoPropagatePush(bool enabled) 
 {
@@ -166,21 +177,9 @@ void vtkThreadedStreamingPipeline::Pull(vtkExecutiveCollection *execs)
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Pull(vtkExecutiveCollection *execs, vtkInformation *info) 
 {
-  vtkExecutiveSet eSet;
-  execs->InitTraversal();
-  for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem()) 
-    {
-    eSet.insert(e);
-    CollectUpstreamModules(e, eSet);
-    }
-  vtkExecutiveCollection *collectedExecs = vtkExecutiveCollection::New();
-  for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
-    {
-    collectedExecs->AddItem(*ti);
-    }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(collectedExecs, info);
-  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilDone(collectedExecs);
-  collectedExecs->Delete();
+  // The scheduler updates everything upstream of the execs as well.
+  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
+  vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilDone(execs);
 }
 
 //----------------------------------------------------------------------------
@@ -207,25 +206,28 @@ void vtkThreadedStreamingPipeline::Push(vtkExecutiveCollection *execs)
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::Push(vtkExecutiveCollection *execs, vtkInformation *info) 
 {
-  vtkExecutiveSet eSet;
   execs->InitTraversal();
   for (vtkExecutive *e = execs->GetNextItem(); e != 0; e = execs->GetNextItem()) 
     {
-    eSet.insert(e);
     e->GetAlgorithm()->GetInformation()->Set(EXTRA_INFORMATION(), info);
     }
+  vtkInformation *propagateInfo = NULL;
   if (AutoPropagatePush) 
     {
-    if (info==NULL)
+    propagateInfo = vtkInformation::New();
+    if (info)
       {
-      info = vtkInformation::New();
+      propagateInfo->Copy(info);
       }
-    info->Set(vtkThreadedStreamingPipeline::AUTO_PROPAGATE(), 1);
+    propagateInfo->Set(vtkThreadedStreamingPipeline::AUTO_PROPAGATE(), 1);
+    info = propagateInfo;
     }
   vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-  fprintf(stderr, "OK 2 %d\n", execs->GetNumberOfItems());
   vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilReleased(execs);
-  fprintf(stderr, "OK 3\n");
+  if (propagateInfo)
+    {
+    propagateInfo->Delete();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -244,10 +246,10 @@ void vtkThreadedStreamingPipeline::Pull(vtkInformation *info)
     {
     execs->AddItem(*ti);
     }
-  vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-  vtkExecutionScheduler::GetGlobalScheduler()->ReleaseResources(this);
+  // The update passes have already gone through the upstream
+  // executives: only their data requests are left.
+  vtkExecutionScheduler::GetGlobalScheduler()->ScheduleData(execs, info);
   vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilDone(execs);
-  vtkExecutionScheduler::GetGlobalScheduler()->ReacquireResources(this);
   execs->Delete();
 }
   
@@ -283,9 +285,7 @@ void vtkThreadedStreamingPipeline::Push(vtkInformation *info)
   else
     {
     vtkExecutionScheduler::GetGlobalScheduler()->Schedule(execs, info);
-    vtkExecutionScheduler::GetGlobalScheduler()->ReleaseResources(this);
     vtkExecutionScheduler::GetGlobalScheduler()->WaitUntilReleased(execs);
-    vtkExecutionScheduler::GetGlobalScheduler()->ReacquireResources(this);
     }
   execs->Delete();
 }
@@ -293,13 +293,8 @@ void vtkThreadedStreamingPipeline::Push(vtkInformation *info)
 //----------------------------------------------------------------------------
 void vtkThreadedStreamingPipeline::ReleaseInputs() 
 {
-  vtkThreadMessager *messager = vtkExecutionScheduler::
-    GetGlobalScheduler()->GetInputsReleasedMessager(this);
-  if (messager)
-    {
-    messager->SendWakeMessage();
-    }
-}  
+  vtkExecutionScheduler::GetGlobalScheduler()->ReleaseInputs(this);
+}
 
 //----------------------------------------------------------------------------
 int vtkThreadedStreamingPipeline
@@ -340,13 +335,16 @@ int vtkThreadedStreamingPipeline::ForceUpdateData(int vtkNotUsed(processingUnit)
   this->ForceDataRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
   // Algorithms process this request after it is forwarded.
   this->ForceDataRequest->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
-//   this->ForceDataRequest->
-//     Set(vtkThreadedStreamingPipeline::PROCESSING_UNIT(), processingUnit);
-  double startTime = vtkTimerLog::GetUniversalTime();
-  int result =  this->CallAlgorithm(this->ForceDataRequest, vtkExecutive::RequestDownstream,
+  this->ForceDataRequest->Set(FROM_OUTPUT_PORT(), -1);
+
+  // Go through ProcessRequest() so that the algorithm only executes if
+  // its outputs are out of date, and so that they are marked as
+  // generated.  ForwardUpstream() does nothing meanwhile.
+  this->ExecutingTask = 1;
+  int result = this->ProcessRequest(this->ForceDataRequest,
                                     this->GetInputInformation(),
                                     this->GetOutputInformation());
-  this->LastDataRequestTime = vtkTimerLog::GetUniversalTime() - startTime;
+  this->ExecutingTask = 0;
   return result;
 }
 
@@ -388,15 +386,51 @@ vtkComputingResources *vtkThreadedStreamingPipeline::GetResources() {
 //----------------------------------------------------------------------------
 int vtkThreadedStreamingPipeline::ForwardUpstream(vtkInformation* request)
 {
-  if (MultiThreadedEnabled && request->Has(vtkDemandDrivenPipeline::REQUEST_DATA())) 
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
     {
-    this->Pull();
-    return 1;
+    if (this->ExecutingTask)
+      {
+      // The scheduler has already updated the inputs.
+      return 1;
+      }
+    if ((MultiThreadedEnabled || this->EnableMultiThreading) &&
+        this->CanScheduleUpstream())
+      {
+      this->Pull();
+      return 1;
+      }
     }
-  else
+  return this->Superclass::ForwardUpstream(request);
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedStreamingPipeline::CanScheduleUpstream()
+{
+  if (vtkDataObject::GetGlobalReleaseDataFlag())
     {
-    return this->Superclass::ForwardUpstream(request);
+    return 0;
+    }
+  vtkExecutiveSet eSet;
+  CollectUpstreamModules(this, eSet);
+  for (vtkExecutiveSet::iterator ti = eSet.begin(); ti != eSet.end(); ti++)
+    {
+    vtkThreadedStreamingPipeline *te =
+      vtkThreadedStreamingPipeline::SafeDownCast(*ti);
+    if (!te)
+      {
+      return 0;
+      }
+    // Data released by one consumer could still be read by another one
+    // running concurrently.
+    for (int i = 0; i < te->GetNumberOfOutputPorts(); ++i)
+      {
+      if (te->GetReleaseDataFlag(i))
+        {
+        return 0;
+        }
+      }
     }
+  return 1;
 }
 
 //----------------------------------------------------------------------------
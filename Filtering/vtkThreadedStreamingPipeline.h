@@ -31,6 +31,21 @@
 // .SECTION Description
 // vtkThreadeStreamingDemandDrivenPipeline is an executive that supports
 // updating input ports based on the number of threads available.
+//
+// When multi-threading is enabled, globally with SetMultiThreadedEnabled()
+// or for one executive with EnableMultiThreadingOn(), the REQUEST_DATA
+// pass of an update is not forwarded upstream recursively: every
+// executive upstream is handed to the vtkExecutionScheduler, which
+// executes independent branches concurrently, and the algorithm of this
+// executive runs once they are all done.  The REQUEST_INFORMATION and
+// REQUEST_UPDATE_EXTENT passes still go through the pipeline in the
+// calling thread, so streaming works as usual: the upstream branches of
+// each piece run concurrently.  If an executive upstream is not a
+// vtkThreadedStreamingPipeline, or releases its data after use, the
+// update falls back to the serial behavior of vtkCompositeDataPipeline.
+//
+// Consumers of a shared producer must request compatible extents, as
+// the producer executes once for all of them.
 
 // .SECTION See Also
 // vtkExecutionScheduler
@@ -75,6 +90,15 @@ public:
   // Description:
   // Enable/Disable Multi-Threaded updating mechanism
   static void SetMultiThreadedEnabled(bool enabled);
+  static bool GetMultiThreadedEnabled();
+
+  // Description:
+  // Enable/Disable the multi-threaded update of the inputs of this
+  // executive only.  The inputs are updated concurrently if either this
+  // flag or the global MultiThreadedEnabled flag is set.  Off by default.
+  vtkSetMacro(EnableMultiThreading, int);
+  vtkGetMacro(EnableMultiThreading, int);
+  vtkBooleanMacro(EnableMultiThreading, int);
 
   // Description:
   // Enable/Disable automatic propagation of Push events
@@ -92,7 +116,9 @@ public:
   
   // Description:
   // Trigger the updates on certain execs and asking all of its
-  // downstream modules to be updated as well (propagate down)  
+  // downstream modules to be updated as well (propagate down).  The
+  // non-propagating forms must not be called by an algorithm executing
+  // in a task of the scheduler; use SetAutoPropagatePush() instead.
   static void Push(vtkExecutiveCollection *execs);
 
   // Description:
@@ -144,7 +170,9 @@ public:
                              vtkInformationVector* outInfo);
 
   // Description:
-  // Send a direct REQUEST_DATA (on all ports) to this executive
+  // Send a direct REQUEST_DATA (on all ports) to this executive.  The
+  // request is not forwarded upstream: the inputs must be up to date.
+  // The keys of info, if any, are copied to the request.
   int ForceUpdateData(int processingUnit, vtkInformation *info);
 
   // Description:
@@ -167,6 +195,17 @@ protected:
 
   virtual int ForwardUpstream(vtkInformation* request);
   virtual int ForwardUpstream(int i, int j, vtkInformation* request);
+
+  // Description:
+  // Return true if every executive upstream can be scheduled, i.e. is a
+  // vtkThreadedStreamingPipeline that does not release its data.
+  int CanScheduleUpstream();
+
+  int EnableMultiThreading;
+
+  // Set while ForceUpdateData() runs, when the inputs are known to be
+  // up to date.
+  int ExecutingTask;
   
 private:
   vtkThreadedStreamingPipeline(const vtkThreadedStreamingPipeline&);  // Not implemented.
@@ -26,6 +26,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
+#include "vtkMemoryAccounting.h"
 #include "vtkObjectFactory.h"
 #include "vtkPixel.h"
 #include "vtkPointData.h"
@@ -113,6 +114,9 @@ vtkUnstructuredGrid::vtkUnstructuredGrid ()
 
   this->Faces = NULL;
   this->FaceLocations = NULL;
+
+  this->Use32BitStorage = 0;
+  this->UseContiguousLinks = 0;
   
   this->Allocate(1000,1000);
 }
@@ -136,6 +140,7 @@ void vtkUnstructuredGrid::Allocate (vtkIdType numCells, int extSize)
     this->Connectivity->UnRegister(this);
     }
   this->Connectivity = vtkCellArray::New();
+  this->Connectivity->SetUse32BitStorage(this->Use32BitStorage);
   this->Connectivity->Allocate(numCells,4*extSize);
   this->Connectivity->Register(this);
   this->Connectivity->Delete();
@@ -159,6 +164,48 @@ void vtkUnstructuredGrid::Allocate (vtkIdType numCells, int extSize)
   this->Locations->Delete();
 }
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::AllocateExact(vtkIdType numCells,
+                                        vtkIdType connectivitySize)
+{
+  if ( numCells < 1 )
+    {
+    numCells = 1;
+    }
+  if ( connectivitySize < 1 )
+    {
+    connectivitySize = 1;
+    }
+
+  if ( this->Connectivity )
+    {
+    this->Connectivity->UnRegister(this);
+    }
+  this->Connectivity = vtkCellArray::New();
+  this->Connectivity->SetUse32BitStorage(this->Use32BitStorage);
+  this->Connectivity->Allocate(connectivitySize);
+  this->Connectivity->Register(this);
+  this->Connectivity->Delete();
+
+  if ( this->Types )
+    {
+    this->Types->UnRegister(this);
+    }
+  this->Types = vtkUnsignedCharArray::New();
+  this->Types->Allocate(numCells);
+  this->Types->Register(this);
+  this->Types->Delete();
+
+  if ( this->Locations )
+    {
+    this->Locations->UnRegister(this);
+    }
+  this->Locations = vtkIdTypeArray::New();
+  this->Locations->Allocate(numCells);
+  this->Locations->Register(this);
+  this->Locations->Delete();
+}
+
 //----------------------------------------------------------------------------
 vtkUnstructuredGrid::~vtkUnstructuredGrid()
 {
@@ -792,15 +839,17 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   cell->SetCellType(cellType);
 
+  // Copy the point ids directly, which is thread safe whatever the
+  // storage of the connectivity.
   loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  this->Connectivity->GetCell(loc,cell->PointIds);
 
-  cell->PointIds->SetNumberOfIds(numPts);
+  numPts = cell->PointIds->GetNumberOfIds();
+  pts = cell->PointIds->GetPointer(0);
   cell->Points->SetNumberOfPoints(numPts);
 
   for (i=0; i<numPts; i++)
     {
-    cell->PointIds->SetId(i,pts[i]);
     this->Points->GetPoint(pts[i], x);
     cell->Points->SetPoint(i, x);
     }
@@ -827,15 +876,16 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
   vtkIdType i;
   vtkIdType loc;
   double x[3];
-  vtkIdType *pts, numPts;
+  vtkIdType numPts;
 
+  // Read the ids one at a time: this is thread safe with 32 bit storage.
   loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
+  numPts = this->Connectivity->GetCellSize(loc);
 
   // carefully compute the bounds
   if (numPts)
     {
-    this->Points->GetPoint( pts[0], x );
+    this->Points->GetPoint( this->Connectivity->GetCellPointId(loc, 0), x );
     bounds[0] = x[0];
     bounds[2] = x[1];
     bounds[4] = x[2];
@@ -844,7 +894,7 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
     bounds[5] = x[2];
     for (i=1; i < numPts; i++)
       {
-      this->Points->GetPoint( pts[i], x );
+      this->Points->GetPoint( this->Connectivity->GetCellPointId(loc, i), x );
       bounds[0] = (x[0] < bounds[0] ? x[0] : bounds[0]);
       bounds[1] = (x[0] > bounds[1] ? x[0] : bounds[1]);
       bounds[2] = (x[1] < bounds[2] ? x[1] : bounds[2]);
@@ -960,7 +1010,8 @@ vtkIdType vtkUnstructuredGrid::InsertNextCell(int type, vtkIdType npts,
       }
     
     // insert cell location
-    this->Locations->InsertNextValue(this->Connectivity->GetData()->GetMaxId()+1);
+    this->Locations->InsertNextValue(
+      this->Connectivity->GetNumberOfConnectivityEntries());
     // insert face location
     this->FaceLocations->InsertNextValue(this->Faces->GetMaxId()+1);
     // insert cell connectivity and faces stream
@@ -1128,7 +1179,7 @@ void vtkUnstructuredGrid::SetCells(int *types, vtkCellArray *cells)
   for (i=0, cells->InitTraversal(); cells->GetNextCell(npts,pts); i++)
     {
     cellTypes->InsertNextValue(static_cast<unsigned char>(types[i]));
-    cellLocations->InsertNextValue(newCells->GetData()->GetMaxId()+1);
+    cellLocations->InsertNextValue(newCells->GetNumberOfConnectivityEntries());
     if (types[i] != VTK_POLYHEDRON)
       {
       newCells->InsertNextCell(npts, pts);
@@ -1191,7 +1242,8 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray *cellTypes,
   vtkIdType npts, nfaces, realnpts, *pts;
   for (i=0, cells->InitTraversal(); cells->GetNextCell(npts,pts); i++)
     {
-    newCellLocations->InsertNextValue(newCells->GetData()->GetMaxId()+1);
+    newCellLocations->InsertNextValue(
+      newCells->GetNumberOfConnectivityEntries());
     if (cellTypes->GetValue(i) != VTK_POLYHEDRON)
       {
       newCells->InsertNextCell(npts, pts);
@@ -1229,6 +1281,10 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray *cellTypes,
   if ( this->Connectivity )
     {
     this->Connectivity->Register(this);
+    if ( this->Use32BitStorage )
+      {
+      this->Connectivity->Use32BitStorageOn();
+      }
     }
 
   if ( this->Types )
@@ -1282,6 +1338,8 @@ void vtkUnstructuredGrid::BuildLinks()
     }
 
   this->Links = vtkCellLinks::New();
+  this->Links->SetUse32BitStorage(this->Use32BitStorage);
+  this->Links->SetUseContiguousStorage(this->UseContiguousLinks);
   this->Links->Allocate(this->GetNumberOfPoints());
   this->Links->Register(this);
   this->Links->BuildLinks(this, this->Connectivity);
@@ -1289,19 +1347,19 @@ void vtkUnstructuredGrid::BuildLinks()
 }
 
 //----------------------------------------------------------------------------
-void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
+void vtkUnstructuredGrid::PrepareForThreadedAccess()
 {
-  vtkIdType i, loc;
-  vtkIdType *pts, numPts;
-
-  loc = this->Locations->GetValue(cellId);
-  this->Connectivity->GetCell(loc,numPts,pts);
-  ptIds->SetNumberOfIds(numPts);
-  for (i=0; i<numPts; i++)
+  this->Superclass::PrepareForThreadedAccess();
+  if ( this->Connectivity && !this->Links )
     {
-    ptIds->SetId(i,pts[i]);
+    this->BuildLinks();
     }
+}
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
+{
+  this->Connectivity->GetCell(this->Locations->GetValue(cellId),ptIds);
 }
 
 //----------------------------------------------------------------------------
@@ -1374,24 +1432,11 @@ void vtkUnstructuredGrid::GetFaceStream(vtkIdType cellId, vtkIdType& nfaces,
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
 {
-  vtkIdType *cells;
-  int numCells;
-  int i;
-
   if ( ! this->Links )
     {
     this->BuildLinks();
     }
-  cellIds->Reset();
-
-  numCells = this->Links->GetNcells(ptId);
-  cells = this->Links->GetCells(ptId);
-
-  cellIds->SetNumberOfIds(numCells);
-  for (i=0; i < numCells; i++)
-    {
-    cellIds->SetId(i,cells[i]);
-    }
+  this->Links->GetCells(ptId, cellIds);
 }
 
 //----------------------------------------------------------------------------
@@ -1581,6 +1626,42 @@ unsigned long vtkUnstructuredGrid::GetActualMemorySize()
   return size;
 }
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::ReportMemory(vtkMemoryAccounting *accounting)
+{
+  this->vtkPointSet::ReportMemory(accounting);
+  if ( this->Connectivity )
+    {
+    accounting->Report(this->Connectivity, "Connectivity",
+                       this->Connectivity->GetActualMemorySize());
+    }
+  if ( this->Types )
+    {
+    accounting->Report(this->Types, "CellTypes",
+                       this->Types->GetActualMemorySize());
+    }
+  if ( this->Locations )
+    {
+    accounting->Report(this->Locations, "CellLocations",
+                       this->Locations->GetActualMemorySize());
+    }
+  if ( this->Faces )
+    {
+    accounting->Report(this->Faces, "Faces",
+                       this->Faces->GetActualMemorySize());
+    }
+  if ( this->FaceLocations )
+    {
+    accounting->Report(this->FaceLocations, "FaceLocations",
+                       this->FaceLocations->GetActualMemorySize());
+    }
+  if ( this->Links )
+    {
+    accounting->Report(this->Links, "CellLinks",
+                       this->Links->GetActualMemorySize());
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
 {
@@ -1590,6 +1671,8 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
     {
     // I do not know if this is correct but.
 
+    this->Use32BitStorage = grid->Use32BitStorage;
+    this->UseContiguousLinks = grid->UseContiguousLinks;
     if (this->Connectivity)
       {
       this->Connectivity->UnRegister(this);
@@ -1663,6 +1746,8 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject *dataObject)
 
   if ( grid != NULL )
     {
+    this->Use32BitStorage = grid->Use32BitStorage;
+    this->UseContiguousLinks = grid->UseContiguousLinks;
     if ( this->Connectivity )
       {
       this->Connectivity->UnRegister(this);
@@ -1753,6 +1838,34 @@ void vtkUnstructuredGrid::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Pieces: " << this->GetNumberOfPieces() << endl;
   os << indent << "Piece: " << this->GetPiece() << endl;
   os << indent << "Ghost Level: " << this->GetGhostLevel() << endl;
+  os << indent << "Use 32 Bit Storage: "
+     << (this->Use32BitStorage ? "On" : "Off") << endl;
+  os << indent << "Use Contiguous Links: "
+     << (this->UseContiguousLinks ? "On" : "Off") << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::SetUse32BitStorage(int use)
+{
+  if ( this->Use32BitStorage == use )
+    {
+    return;
+    }
+  this->Use32BitStorage = use;
+  if ( this->Connectivity )
+    {
+    this->Connectivity->SetUse32BitStorage(use);
+    }
+  if ( this->Links )
+    {
+    // Compact links are only created by BuildLinks().
+    this->Links->SetUse32BitStorage(use);
+    if ( use )
+      {
+      this->BuildLinks();
+      }
+    }
+  this->Modified();
 }
 
 //----------------------------------------------------------------------------
@@ -1765,8 +1878,7 @@ void vtkUnstructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
 {
   vtkIdType i, j, k;
   vtkIdType numPts, minNumCells, numCells;
-  vtkIdType *pts, ptId, *cellPts, *cells;
-  vtkIdType *minCells = NULL;
+  vtkIdType *pts, ptId, minCellId, loc;
   vtkIdType match;
   vtkIdType minPtId = 0, npts;
 
@@ -1785,11 +1897,9 @@ void vtkUnstructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
     {
     ptId = pts[i];
     numCells = this->Links->GetNcells(ptId);
-    cells = this->Links->GetCells(ptId);
     if ( numCells < minNumCells )
       {
       minNumCells = numCells;
-      minCells = cells;
       minPtId = ptId;
       }
     }
@@ -1799,19 +1909,22 @@ void vtkUnstructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
     minNumCells = 0;
   }
   //Now for each cell, see if it contains all the points
-  //in the ptIds list.
+  //in the ptIds list. The links and the connectivity are read one id
+  //at a time, which stays thread safe with 32 bit storage.
   for (i=0; i<minNumCells; i++)
     {
-    if ( minCells[i] != cellId ) //don't include current cell
+    minCellId = this->Links->GetCellId(minPtId, i);
+    if ( minCellId != cellId ) //don't include current cell
       {
-      this->GetCellPoints(minCells[i],npts,cellPts);
+      loc = this->Locations->GetValue(minCellId);
+      npts = this->Connectivity->GetCellSize(loc);
       for (match=1, j=0; j<numPts && match; j++) //for all pts in input cell
         {
         if ( pts[j] != minPtId ) //of course minPtId is contained by cell
           {
           for (match=k=0; k<npts; k++) //for all points in candidate cell
             {
-            if ( pts[j] == cellPts[k] )
+            if ( pts[j] == this->Connectivity->GetCellPointId(loc, k) )
               {
               match = 1; //a match was found
               break;
@@ -1821,7 +1934,7 @@ void vtkUnstructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
         }//for all points in input cell
       if ( match )
         {
-        cellIds->InsertNextId(minCells[i]);
+        cellIds->InsertNextId(minCellId);
         }
       }//if not the reference cell
     }//for all candidate cells attached to point
@@ -79,6 +79,12 @@ public:
   // Standard vtkDataSet API methods. See vtkDataSet for more information.
   int GetDataObjectType() {return VTK_UNSTRUCTURED_GRID;};
   virtual void Allocate(vtkIdType numCells=1000, int extSize=1000);
+
+  // Description:
+  // Allocate memory for exactly numCells cells whose connectivity list,
+  // including the number of points of each cell, holds connectivitySize
+  // ids.  Use this instead of Allocate() when the output size is known.
+  void AllocateExact(vtkIdType numCells, vtkIdType connectivitySize);
   
   // Description:
   // Insert/create cell in object by type and list of point ids defining
@@ -129,6 +135,10 @@ public:
   vtkCellLinks *GetCellLinks() {return this->Links;};
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                              vtkIdType* &pts);
+
+  // Description:
+  // Also builds the cell links. See vtkDataSet.
+  virtual void PrepareForThreadedAccess();
   
   // Description:
   // Get the face stream of a polyhedron cell in the following format:
@@ -181,6 +191,29 @@ public:
   virtual void GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds, 
                                 vtkIdList *cellIds);
 
+  // Description:
+  // Store the connectivity list and the cell links with 32 bit integers.
+  // On builds with VTK_USE_64BIT_IDS this roughly halves the memory taken
+  // by the topology of the grid, see GetActualMemorySize().  The cell
+  // locations and types are not affected.  The vtkIdType API keeps working,
+  // except for the raw connectivity pointers of vtkCellArray which fail
+  // (see vtkCellArray::SetUse32BitStorage()).  The methods returning
+  // pointers to point or cell ids are then no longer thread safe; the
+  // methods of vtkDataSet documented as thread safe still are.  Off by
+  // default.
+  void SetUse32BitStorage(int use);
+  vtkGetMacro(Use32BitStorage, int);
+  vtkBooleanMacro(Use32BitStorage, int);
+
+  // Description:
+  // Have BuildLinks() store the cell links in a single array built in
+  // parallel, see vtkCellLinks::SetUseContiguousStorage().  This speeds
+  // up BuildLinks() and GetPointCells() on large grids.  Takes effect at
+  // the next BuildLinks().  Off by default.
+  vtkSetMacro(UseContiguousLinks, int);
+  vtkGetMacro(UseContiguousLinks, int);
+  vtkBooleanMacro(UseContiguousLinks, int);
+
   // Description:
   // For streaming.  User/next filter specifies which piece the want updated.
   // The source of this poly data has to return exactly this piece.
@@ -210,6 +243,11 @@ public:
   // arrays, etc. are not included in the return value). THIS METHOD
   // IS THREAD SAFE.
   unsigned long GetActualMemorySize();
+
+  // Description:
+  // Also reports the connectivity, the cell types and locations, the faces
+  // and the cell links. See vtkDataObject.
+  virtual void ReportMemory(vtkMemoryAccounting *accounting);
     
   // Description:
   // Shallow and Deep copy.
@@ -367,6 +405,9 @@ protected:
   vtkIdTypeArray *Faces;
   vtkIdTypeArray *FaceLocations;
 
+  int Use32BitStorage;
+  int UseContiguousLinks;
+
 private:
   // Hide these from the user and the compiler.
   vtkUnstructuredGrid(const vtkUnstructuredGrid&);  // Not implemented.
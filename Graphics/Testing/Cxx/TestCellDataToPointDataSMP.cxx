@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellDataToPointDataSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Average the cell data of a polydata, with regular and contiguous links,
+// and of an image at the points with vtkCellDataToPointData, serially and
+// with several numbers of threads, and check that the outputs are
+// identical.  The polydata has a point used by no cell, which is nulled.
+// A bit array in the cell data makes the filter fall back to the serial
+// loop.
+
+#include "vtkBitArray.h"
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkContourTestUtilities.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+
+// Add cell arrays of several types to the data set.
+static void AddCellData(vtkDataSet *data)
+{
+  vtkIdType numCells = data->GetNumberOfCells();
+  vtkSmartPointer<vtkDoubleArray> vectors =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numCells);
+  vtkSmartPointer<vtkIntArray> ints = vtkSmartPointer<vtkIntArray>::New();
+  ints->SetName("Ints");
+  ints->SetNumberOfTuples(numCells);
+  vtkSmartPointer<vtkUnsignedCharArray> chars =
+    vtkSmartPointer<vtkUnsignedCharArray>::New();
+  chars->SetName("Chars");
+  chars->SetNumberOfTuples(numCells);
+  for (vtkIdType i = 0; i < numCells; i++)
+    {
+    vectors->SetTuple3(i, 0.5*i, -3.0*i, 1.0/(i+1));
+    ints->SetValue(i, static_cast<int>(7*i - 1000));
+    chars->SetValue(i, static_cast<unsigned char>(i % 251));
+    }
+  data->GetCellData()->SetVectors(vectors);
+  data->GetCellData()->SetScalars(ints);
+  data->GetCellData()->AddArray(chars);
+}
+
+// Return 1 if the filter gives the same point data with several numbers
+// of threads as serially.
+static int TestThreads(const char *name, vtkDataSet *input)
+{
+  vtkSmartPointer<vtkCellDataToPointData> filter =
+    vtkSmartPointer<vtkCellDataToPointData>::New();
+  filter->SetInput(input);
+
+  vtkSMPTools::Initialize(1);
+  filter->EnableSMPOff();
+  filter->Update();
+  vtkSmartPointer<vtkPointData> serial = vtkSmartPointer<vtkPointData>::New();
+  serial->DeepCopy(filter->GetOutput()->GetPointData());
+  if (serial->GetNumberOfArrays() == 0 ||
+      serial->GetNumberOfTuples() != input->GetNumberOfPoints())
+    {
+    cerr << name << ": the cell data was not averaged." << endl;
+    return 0;
+    }
+
+  filter->EnableSMPOn();
+  int threads[] = { 2, 3, 4 };
+  for (int t = 0; t < 3; t++)
+    {
+    vtkSMPTools::Initialize(threads[t]);
+    filter->Modified();
+    filter->Update();
+    if (!CompareAttributes("point data", serial,
+                           filter->GetOutput()->GetPointData()))
+      {
+      cerr << name << " differs with " << threads[t] << " threads." << endl;
+      return 0;
+      }
+    }
+  vtkSMPTools::Initialize(1);
+  return 1;
+}
+
+int TestCellDataToPointDataSMP(int, char *[])
+{
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(40);
+  sphere->Update();
+  vtkSmartPointer<vtkPolyData> poly = vtkSmartPointer<vtkPolyData>::New();
+  poly->DeepCopy(sphere->GetOutput());
+  poly->GetPointData()->Initialize();
+  poly->GetPoints()->InsertNextPoint(2.0, 2.0, 2.0);
+  AddCellData(poly);
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(31, 17, 23);
+  AddCellData(image);
+
+  int ok = TestThreads("polydata", poly) && TestThreads("image", image);
+
+  if (ok)
+    {
+    poly->UseContiguousLinksOn();
+    poly->DeleteLinks();
+    ok = TestThreads("polydata with contiguous links", poly);
+    }
+
+  if (ok)
+    {
+    // The values of a bit array are packed: the filter runs serially.
+    vtkSmartPointer<vtkBitArray> bits = vtkSmartPointer<vtkBitArray>::New();
+    bits->SetName("Bits");
+    bits->SetNumberOfTuples(poly->GetNumberOfCells());
+    for (vtkIdType i = 0; i < poly->GetNumberOfCells(); i++)
+      {
+      bits->SetValue(i, static_cast<int>(i % 3 == 0));
+      }
+    poly->GetCellData()->AddArray(bits);
+    ok = TestThreads("polydata with a bit array", poly);
+    }
+
+  return !ok;
+}
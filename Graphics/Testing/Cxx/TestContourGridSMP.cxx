@@ -0,0 +1,401 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourGridSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Contour an unstructured grid of mixed cells with vtkContourGrid and a
+// scalar tree, serially and with several numbers of threads, and check
+// that the outputs are identical.  Both vtkSpanSpace, which gives its
+// candidates in batches, and vtkSimpleScalarTree, whose candidates the
+// filter gathers, are tested.  The scalars are integers and so are some
+// contour values, so that many points lie exactly on the isovalues.
+// When the grid mixes 3D cells with lower dimensional ones, the cells
+// number the output cell data with offsets that leave tuples unset, so
+// only the size of the cell data is compared.  Each contour value alone
+// visits the cells in order with vtkSimpleScalarTree though, and the
+// lower dimensional cells come first: then the cell data has no unset
+// tuples and the outputs are compared in full.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkContourFilter.h"
+#include "vtkContourTestUtilities.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkContourGrid.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkShortArray.h"
+#include "vtkSimpleScalarTree.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpanSpace.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <math.h>
+
+static const vtkIdType Dimensions[3] = { 23, 19, 41 };
+
+// Return 1 if both cell arrays are identical.
+static int CompareCells(const char *what, vtkCellArray *a, vtkCellArray *b)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+    cerr << "Expected " << a->GetNumberOfCells() << " " << what << ", got "
+         << b->GetNumberOfCells() << endl;
+    return 0;
+    }
+  return CompareArrays(what, a->GetData(), b->GetData());
+}
+
+// Return 1 if both cell data have the same number of tuples.
+static int CompareSizes(vtkCellData *a, vtkCellData *b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays() ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    cerr << "The cell data have " << a->GetNumberOfTuples() << " and "
+         << b->GetNumberOfTuples() << " tuples." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+// Return 1 if both outputs are identical.
+static int CompareOutputs(vtkPolyData *serial, vtkPolyData *parallel,
+                          int mixed)
+{
+  if (serial->GetNumberOfPoints() != parallel->GetNumberOfPoints())
+    {
+    cerr << "Expected " << serial->GetNumberOfPoints() << " points, got "
+         << parallel->GetNumberOfPoints() << endl;
+    return 0;
+    }
+  return CompareArrays("point", serial->GetPoints()->GetData(),
+                       parallel->GetPoints()->GetData()) &&
+    CompareCells("verts", serial->GetVerts(), parallel->GetVerts()) &&
+    CompareCells("lines", serial->GetLines(), parallel->GetLines()) &&
+    CompareCells("polys", serial->GetPolys(), parallel->GetPolys()) &&
+    CompareAttributes("point data", serial->GetPointData(),
+                      parallel->GetPointData()) &&
+    (mixed ? CompareSizes(serial->GetCellData(), parallel->GetCellData()) :
+     CompareAttributes("cell data", serial->GetCellData(),
+                       parallel->GetCellData()));
+}
+
+// A grid of hexahedra and tetrahedra, with vertices, lines and triangles
+// on its bottom face before them if mixed, integer scalars, a vector field
+// and cell data.
+static vtkUnstructuredGrid *NewGrid(int mixed)
+{
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::New();
+  vtkPoints *points = vtkPoints::New();
+  vtkShortArray *scalars = vtkShortArray::New();
+  scalars->SetName("Integers");
+  vtkDoubleArray *vectors = vtkDoubleArray::New();
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (int k = 0; k < Dimensions[2]; k++)
+    {
+    for (int j = 0; j < Dimensions[1]; j++)
+      {
+      for (int i = 0; i < Dimensions[0]; i++)
+        {
+        points->InsertNextPoint(i + 0.1*sin(0.5*j), j + 0.2*k, k);
+        double s = 20.0*sin(0.3*i) + 20.0*cos(0.25*j) + 30.0*sin(0.2*k);
+        scalars->InsertNextValue(static_cast<short>(floor(s)));
+        vectors->InsertNextTuple3(i, j*j, sin(0.1*k));
+        }
+      }
+    }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->GetPointData()->AddArray(vectors);
+  points->Delete();
+  scalars->Delete();
+  vectors->Delete();
+
+  grid->Allocate(1000, 1000);
+  vtkIdType dx = Dimensions[0], dxy = Dimensions[0]*Dimensions[1];
+  for (int type = VTK_VERTEX; mixed && type <= VTK_TRIANGLE; type++)
+    {
+    for (vtkIdType j = 0; j < Dimensions[1] - 1; j++)
+      {
+      for (vtkIdType i = 0; i < Dimensions[0] - 1; i++)
+        {
+        vtkIdType p = i + dx*j;
+        vtkIdType pts[3] = { p, p+1, p+1+dx };
+        switch (type)
+          {
+          case VTK_VERTEX:
+            grid->InsertNextCell(VTK_VERTEX, 1, pts + 2);
+            break;
+          case VTK_LINE:
+            grid->InsertNextCell(VTK_LINE, 2, pts + 1);
+            break;
+          case VTK_TRIANGLE:
+            grid->InsertNextCell(VTK_TRIANGLE, 3, pts);
+            break;
+          }
+        }
+      }
+    }
+  for (vtkIdType k = 0; k < Dimensions[2] - 1; k++)
+    {
+    for (vtkIdType j = 0; j < Dimensions[1] - 1; j++)
+      {
+      for (vtkIdType i = 0; i < Dimensions[0] - 1; i++)
+        {
+        vtkIdType p = i + dx*j + dxy*k;
+        vtkIdType hex[8] = { p, p+1, p+1+dx, p+dx,
+                             p+dxy, p+1+dxy, p+1+dx+dxy, p+dx+dxy };
+        if ((i + j + k) % 3)
+          {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+          }
+        else
+          {
+          // Five tetrahedra filling the hexahedron.
+          vtkIdType tets[5][4] = {
+            { hex[0], hex[1], hex[3], hex[4] },
+            { hex[1], hex[2], hex[3], hex[6] },
+            { hex[1], hex[4], hex[5], hex[6] },
+            { hex[3], hex[4], hex[6], hex[7] },
+            { hex[1], hex[3], hex[4], hex[6] } };
+          for (int t = 0; t < 5; t++)
+            {
+            grid->InsertNextCell(VTK_TETRA, 4, tets[t]);
+            }
+          }
+        }
+      }
+    }
+
+  vtkIntArray *cellIds = vtkIntArray::New();
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); i++)
+    {
+    cellIds->InsertNextValue(static_cast<int>(i));
+    }
+  grid->GetCellData()->AddArray(cellIds);
+  cellIds->Delete();
+  return grid;
+}
+
+// Set the contour values and the computed arrays of a filter.
+template <class Filter>
+static void SetUpFilter(Filter *filter, vtkUnstructuredGrid *grid)
+{
+  filter->SetInput(grid);
+  filter->SetValue(0, -10.0);
+  filter->SetValue(1, 0.0);
+  filter->SetValue(2, 12.0);
+  filter->SetValue(3, 25.5);
+  filter->SetValue(4, 200.0);
+  filter->ComputeScalarsOn();
+  filter->UseScalarTreeOn();
+}
+
+// Contour the grid with the given scalar tree, serially and in parallel.
+static int TestTree(const char *name, vtkUnstructuredGrid *grid,
+                    int mixed, vtkScalarTree *tree)
+{
+  vtkSmartPointer<vtkContourGrid> filter =
+    vtkSmartPointer<vtkContourGrid>::New();
+  SetUpFilter(filter.GetPointer(), grid);
+  filter->SetScalarTree(tree);
+
+  vtkSMPTools::Initialize(1);
+  filter->EnableSMPOff();
+  filter->Update();
+  vtkSmartPointer<vtkPolyData> serial = vtkSmartPointer<vtkPolyData>::New();
+  serial->DeepCopy(filter->GetOutput());
+  if (serial->GetNumberOfPolys() == 0 ||
+      (mixed && (serial->GetNumberOfLines() == 0 ||
+                 serial->GetNumberOfVerts() == 0)))
+    {
+    cerr << name << ": some cells were not contoured." << endl;
+    return 0;
+    }
+
+  filter->EnableSMPOn();
+  int threads[] = { 2, 3, 4, 8 };
+  for (int t = 0; t < 4; t++)
+    {
+    vtkSMPTools::Initialize(threads[t]);
+    filter->Modified();
+    filter->Update();
+    if (!CompareOutputs(serial, filter->GetOutput(), mixed))
+      {
+      cerr << name << " differs with " << threads[t] << " threads." << endl;
+      return 0;
+      }
+    }
+
+  // Without scalar tree the cells are visited in another order, but the
+  // same lines and polygons are generated.  The vertices are skipped.
+  vtkSMPTools::Initialize(1);
+  filter->UseScalarTreeOff();
+  filter->Update();
+  vtkPolyData *output = filter->GetOutput();
+  if ((!mixed && output->GetNumberOfPoints() != serial->GetNumberOfPoints()) ||
+      output->GetNumberOfPolys() != serial->GetNumberOfPolys() ||
+      output->GetNumberOfLines() != serial->GetNumberOfLines())
+    {
+    cerr << name << ": the output differs from the one without tree." << endl;
+    return 0;
+    }
+
+  cout << name << ": " << serial->GetNumberOfPoints() << " points, "
+       << serial->GetNumberOfPolys() << " triangles." << endl;
+  return 1;
+}
+
+// Contour the mixed grid with one contour value at a time and compare the
+// whole outputs, cell data included.
+static int TestSingleValues(vtkUnstructuredGrid *grid)
+{
+  vtkSmartPointer<vtkSimpleScalarTree> tree =
+    vtkSmartPointer<vtkSimpleScalarTree>::New();
+  vtkSmartPointer<vtkContourGrid> filter =
+    vtkSmartPointer<vtkContourGrid>::New();
+  filter->SetInput(grid);
+  filter->ComputeScalarsOn();
+  filter->UseScalarTreeOn();
+  filter->SetScalarTree(tree);
+
+  double values[] = { 0.0, 12.0, 25.5 };
+  for (int v = 0; v < 3; v++)
+    {
+    filter->SetValue(0, values[v]);
+    vtkSMPTools::Initialize(1);
+    filter->EnableSMPOff();
+    filter->Update();
+    vtkSmartPointer<vtkPolyData> serial = vtkSmartPointer<vtkPolyData>::New();
+    serial->DeepCopy(filter->GetOutput());
+    if (serial->GetNumberOfVerts() == 0 || serial->GetNumberOfLines() == 0 ||
+        serial->GetNumberOfPolys() == 0)
+      {
+      cerr << "Contour value " << values[v] << ": some cells were not "
+           << "contoured." << endl;
+      return 0;
+      }
+
+    filter->EnableSMPOn();
+    int threads[] = { 2, 4 };
+    for (int t = 0; t < 2; t++)
+      {
+      vtkSMPTools::Initialize(threads[t]);
+      filter->Modified();
+      filter->Update();
+      if (!CompareOutputs(serial, filter->GetOutput(), 0))
+        {
+        cerr << "Contour value " << values[v] << " differs with "
+             << threads[t] << " threads." << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// Contour the grid and extract its surface with its connectivity stored in
+// 32 bits.  Without scalar tree, both filters read the cells directly: the
+// outputs must be those of the regular storage, and the connectivity must
+// stay in 32 bits.
+static int Test32BitStorage(vtkUnstructuredGrid *grid)
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid32 =
+    vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid32->DeepCopy(grid);
+  grid32->SetUse32BitStorage(1);
+
+  vtkSmartPointer<vtkContourGrid> contour =
+    vtkSmartPointer<vtkContourGrid>::New();
+  SetUpFilter(contour.GetPointer(), grid);
+  contour->UseScalarTreeOff();
+  vtkSmartPointer<vtkDataSetSurfaceFilter> surface =
+    vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
+  surface->SetInput(grid);
+  contour->Update();
+  surface->Update();
+  vtkSmartPointer<vtkPolyData> contour64 = vtkSmartPointer<vtkPolyData>::New();
+  contour64->DeepCopy(contour->GetOutput());
+  vtkSmartPointer<vtkPolyData> surface64 = vtkSmartPointer<vtkPolyData>::New();
+  surface64->DeepCopy(surface->GetOutput());
+
+  contour->SetInput(grid32);
+  surface->SetInput(grid32);
+  contour->Update();
+  surface->Update();
+  if (!CompareOutputs(contour64, contour->GetOutput(), 0) ||
+      !CompareOutputs(surface64, surface->GetOutput(), 0))
+    {
+    cerr << "The outputs differ with 32 bit storage." << endl;
+    return 0;
+    }
+#if VTK_SIZEOF_ID_TYPE > 4
+  if (!grid32->GetCells()->GetUse32BitStorage())
+    {
+    cerr << "The 32 bit connectivity was converted back." << endl;
+    return 0;
+    }
+#endif
+  return 1;
+}
+
+int TestContourGridSMP(int, char *[])
+{
+  vtkSmartPointer<vtkSpanSpace> spanSpace =
+    vtkSmartPointer<vtkSpanSpace>::New();
+  spanSpace->SetBatchSize(100);
+  vtkSmartPointer<vtkSimpleScalarTree> simpleTree =
+    vtkSmartPointer<vtkSimpleScalarTree>::New();
+
+  int ok = 1;
+  for (int mixed = 0; mixed < 2 && ok; mixed++)
+    {
+    vtkUnstructuredGrid *grid = NewGrid(mixed);
+    ok = TestTree("vtkSpanSpace", grid, mixed, spanSpace) &&
+      TestTree("vtkSimpleScalarTree", grid, mixed, simpleTree) &&
+      (mixed ? TestSingleValues(grid) : Test32BitStorage(grid));
+
+    // vtkContourFilter passes its scalar tree to vtkContourGrid.
+    if (ok)
+      {
+      vtkSmartPointer<vtkContourGrid> contourGrid =
+        vtkSmartPointer<vtkContourGrid>::New();
+      SetUpFilter(contourGrid.GetPointer(), grid);
+      contourGrid->SetScalarTree(spanSpace);
+      contourGrid->EnableSMPOff();
+      vtkSmartPointer<vtkContourFilter> contour =
+        vtkSmartPointer<vtkContourFilter>::New();
+      SetUpFilter(contour.GetPointer(), grid);
+      contour->SetScalarTree(spanSpace);
+      vtkSMPTools::Initialize(4);
+      contourGrid->Update();
+      contour->Update();
+      if (!CompareOutputs(contourGrid->GetOutput(), contour->GetOutput(),
+                          mixed))
+        {
+        cerr << "vtkContourFilter differs from vtkContourGrid." << endl;
+        ok = 0;
+        }
+      }
+    grid->Delete();
+    }
+
+  return !ok;
+}
@@ -0,0 +1,346 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFlyingEdges3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Contour images with vtkFlyingEdges3D and check that the triangles are
+// those of vtkSynchronizedTemplates3D, in the same order, once the points
+// are matched by their coordinates, and that the output does not depend
+// on the number of threads.  The scalars are integers and so are some
+// contour values, so that many points lie exactly on the isovalues.  The
+// origin and spacing are integers so that both filters compute the same
+// coordinates for those points.  Bit array attributes, which threads
+// cannot write to at once, must make the filter run serially.
+
+#include "vtkBitArray.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkShortArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkSynchronizedTemplates3D.h"
+
+#include <map>
+#include <vector>
+
+#include <math.h>
+
+// Return the ids of the points of "a" in "b", matched by coordinates, or
+// an empty vector when the points differ.
+static std::vector<vtkIdType> MatchPoints(vtkPoints *a, vtkPoints *b)
+{
+  typedef std::map<std::vector<double>, vtkIdType> PointMap;
+  PointMap ids;
+  std::vector<double> x(3);
+  for (vtkIdType i = 0; i < b->GetNumberOfPoints(); i++)
+    {
+    b->GetPoint(i, &x[0]);
+    if (!ids.insert(PointMap::value_type(x, i)).second)
+      {
+      cerr << "Two points at the same place." << endl;
+      return std::vector<vtkIdType>();
+      }
+    }
+  std::vector<vtkIdType> map(a->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); i++)
+    {
+    a->GetPoint(i, &x[0]);
+    PointMap::iterator it = ids.find(x);
+    if (it == ids.end())
+      {
+      cerr << "Point " << i << " (" << x[0] << ", " << x[1] << ", " << x[2]
+           << ") is not in the reference." << endl;
+      return std::vector<vtkIdType>();
+      }
+    map[i] = it->second;
+    ids.erase(it);
+    }
+  return map;
+}
+
+// Return 1 if the tuples of "a" are close to the tuples of "b" given by
+// the map, or equal to those of the same ids when the map is empty.
+static int CompareArrays(vtkDataArray *a, vtkDataArray *b,
+                         const std::vector<vtkIdType> &map)
+{
+  if (!a || !b || a->GetDataType() != b->GetDataType() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples())
+    {
+    cerr << "The " << (a ? a->GetName() : "") << " arrays differ in type "
+         << "or size." << endl;
+    return 0;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    vtkIdType id = (map.empty() ? i : map[i]);
+    for (int c = 0; c < a->GetNumberOfComponents(); c++)
+      {
+      double va = a->GetComponent(i, c);
+      double vb = b->GetComponent(id, c);
+      if (map.empty() ? va != vb :
+          fabs(va - vb) > 1e-5*(1.0 + fabs(vb)))
+        {
+        cerr << "The " << a->GetName() << " arrays differ at tuple " << i
+             << ": " << va << " instead of " << vb << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// Return 1 if the arrays of both attributes match.
+static int CompareAttributes(vtkDataSetAttributes *a, vtkDataSetAttributes *b,
+                             const std::vector<vtkIdType> &map)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    cerr << "Got " << a->GetNumberOfArrays() << " arrays instead of "
+         << b->GetNumberOfArrays() << endl;
+    return 0;
+    }
+  for (int i = 0; i < b->GetNumberOfArrays(); i++)
+    {
+    vtkDataArray *array = b->GetArray(i);
+    if (!CompareArrays(a->GetArray(array->GetName()), array, map))
+      {
+      return 0;
+      }
+    }
+  if (!a->GetNormals() != !b->GetNormals() ||
+      !a->GetScalars() != !b->GetScalars())
+    {
+    cerr << "The active attributes differ." << endl;
+    return 0;
+    }
+  return 1;
+}
+
+// Return 1 if "a" has the triangles of the reference "b", in the same
+// order.  When exact is set, the points must also be numbered the same.
+static int CompareOutputs(vtkPolyData *a, vtkPolyData *b, int exact)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfPolys() != b->GetNumberOfPolys())
+    {
+    cerr << "Expected " << b->GetNumberOfPoints() << " points and "
+         << b->GetNumberOfPolys() << " triangles, got "
+         << a->GetNumberOfPoints() << " and " << a->GetNumberOfPolys() << endl;
+    return 0;
+    }
+  std::vector<vtkIdType> map;
+  if (!exact)
+    {
+    map = MatchPoints(a->GetPoints(), b->GetPoints());
+    if (map.empty())
+      {
+      return 0;
+      }
+    }
+  else if (!CompareArrays(a->GetPoints()->GetData(),
+                          b->GetPoints()->GetData(), map))
+    {
+    return 0;
+    }
+
+  vtkIdType *ptsA = a->GetPolys()->GetPointer();
+  vtkIdType *ptsB = b->GetPolys()->GetPointer();
+  for (vtkIdType c = 0; c < a->GetNumberOfPolys(); c++)
+    {
+    for (int m = 0; m < 4; m++)
+      {
+      vtkIdType id = ptsA[4*c+m];
+      if (m > 0 && !exact)
+        {
+        id = map[id];
+        }
+      if (id != ptsB[4*c+m])
+        {
+        cerr << "Triangle " << c << " differs." << endl;
+        return 0;
+        }
+      }
+    }
+
+  std::vector<vtkIdType> noMap;
+  return CompareAttributes(a->GetPointData(), b->GetPointData(), map) &&
+    CompareAttributes(a->GetCellData(), b->GetCellData(), noMap);
+}
+
+// An image with integer scalars, a vector field and cell data.
+static vtkImageData *NewImage(int scalarType)
+{
+  vtkImageData *image = vtkImageData::New();
+  image->SetExtent(-4, 28, 3, 31, -2, 60);
+  image->SetOrigin(-3.0, 0.0, 5.0);
+  image->SetSpacing(1.0, 2.0, 1.0);
+  int *ext = image->GetExtent();
+
+  vtkDataArray *scalars;
+  if (scalarType == VTK_SHORT)
+    {
+    scalars = vtkShortArray::New();
+    }
+  else
+    {
+    scalars = vtkFloatArray::New();
+    }
+  scalars->SetName("Values");
+  vtkDoubleArray *vectors = vtkDoubleArray::New();
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        double s = 20.0*sin(0.3*i) + 20.0*cos(0.25*j) + 30.0*sin(0.2*k);
+        scalars->InsertNextTuple1(scalarType == VTK_SHORT ? floor(s) : s);
+        vectors->InsertNextTuple3(i, j*j, sin(0.1*k));
+        }
+      }
+    }
+  image->GetPointData()->SetScalars(scalars);
+  image->GetPointData()->AddArray(vectors);
+  scalars->Delete();
+  vectors->Delete();
+
+  vtkIntArray *cellIds = vtkIntArray::New();
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); i++)
+    {
+    cellIds->InsertNextValue(static_cast<int>(i));
+    }
+  image->GetCellData()->AddArray(cellIds);
+  cellIds->Delete();
+  return image;
+}
+
+// Contour the image with both filters and compare the outputs.
+static int TestImage(const char *name, vtkImageData *image)
+{
+  vtkSmartPointer<vtkSynchronizedTemplates3D> templates =
+    vtkSmartPointer<vtkSynchronizedTemplates3D>::New();
+  vtkSmartPointer<vtkFlyingEdges3D> edges =
+    vtkSmartPointer<vtkFlyingEdges3D>::New();
+  templates->SetInput(image);
+  edges->SetInput(image);
+  double values[] = { -10.0, 0.0, 12.0, 25.5 };
+  for (int i = 0; i < 4; i++)
+    {
+    templates->SetValue(i, values[i]);
+    edges->SetValue(i, values[i]);
+    }
+  templates->ComputeGradientsOn();
+  edges->ComputeGradientsOn();
+  templates->EnableSMPOff();
+
+  vtkSMPTools::Initialize(1);
+  templates->Update();
+  edges->Update();
+  if (templates->GetOutput()->GetNumberOfPolys() == 0 ||
+      !CompareOutputs(edges->GetOutput(), templates->GetOutput(), 0))
+    {
+    cerr << name << ": the triangles differ from vtkSynchronizedTemplates3D."
+         << endl;
+    return 0;
+    }
+  vtkSmartPointer<vtkPolyData> serial = vtkSmartPointer<vtkPolyData>::New();
+  serial->DeepCopy(edges->GetOutput());
+
+  int threads[] = { 2, 3, 4, 8 };
+  for (int t = 0; t < 4; t++)
+    {
+    vtkSMPTools::Initialize(threads[t]);
+    edges->Modified();
+    edges->Update();
+    if (!CompareOutputs(edges->GetOutput(), serial, 1))
+      {
+      cerr << name << " differs with " << threads[t] << " threads." << endl;
+      return 0;
+      }
+    }
+  cout << name << ": " << serial->GetNumberOfPoints() << " points, "
+       << serial->GetNumberOfPolys() << " triangles." << endl;
+  return 1;
+}
+
+// Add bit arrays to the point and cell data of the image.
+static void AddBitArrays(vtkImageData *image)
+{
+  int *ext = image->GetExtent();
+  vtkBitArray *pointBits = vtkBitArray::New();
+  pointBits->SetName("PointBits");
+  for (int k = ext[4]; k <= ext[5]; k++)
+    {
+    for (int j = ext[2]; j <= ext[3]; j++)
+      {
+      for (int i = ext[0]; i <= ext[1]; i++)
+        {
+        pointBits->InsertNextValue((i + j + k) % 3 == 0);
+        }
+      }
+    }
+  image->GetPointData()->AddArray(pointBits);
+  pointBits->Delete();
+
+  vtkBitArray *cellBits = vtkBitArray::New();
+  cellBits->SetName("CellBits");
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); i++)
+    {
+    cellBits->InsertNextValue(i % 5 < 2);
+    }
+  image->GetCellData()->AddArray(cellBits);
+  cellBits->Delete();
+}
+
+int TestFlyingEdges3D(int, char *[])
+{
+  int scalarTypes[] = { VTK_SHORT, VTK_FLOAT };
+  const char *names[] = { "short scalars", "float scalars" };
+  for (int i = 0; i < 2; i++)
+    {
+    vtkImageData *image = NewImage(scalarTypes[i]);
+    int ok = TestImage(names[i], image);
+    image->Delete();
+    if (!ok)
+      {
+      return 1;
+      }
+    }
+
+  vtkImageData *image = NewImage(VTK_FLOAT);
+  AddBitArrays(image);
+  int ok = 1;
+  if (vtkSynchronizedTemplatesSlabs::CanContourInParallel(image))
+    {
+    cerr << "An image with bit arrays may not be contoured in parallel."
+         << endl;
+    ok = 0;
+    }
+  else
+    {
+    ok = TestImage("bit arrays", image);
+    }
+  image->Delete();
+  return ok ? 0 : 1;
+}
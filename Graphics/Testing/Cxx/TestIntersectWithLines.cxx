@@ -0,0 +1,191 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIntersectWithLines.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the batched IntersectWithLines() of the cell locators gives
+// the same hits as IntersectWithLine() called for each line, and reports
+// the time taken by both.  Also checks that IntersectWithLine() and
+// IntersectWithLines() still go through the cell test that subclasses of
+// vtkModifiedBSPTree override.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkObjectFactory.h"
+#include "vtkOBBTree.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+
+#include <vtkstd/vector>
+
+#define NUMBER_OF_LINES 10000
+
+// A tree counting its cell tests.
+class vtkCountingBSPTree : public vtkModifiedBSPTree
+{
+public:
+  static vtkCountingBSPTree *New();
+  vtkTypeMacro(vtkCountingBSPTree,vtkModifiedBSPTree);
+
+  int NumberOfCellTests;
+
+protected:
+  vtkCountingBSPTree() { this->NumberOfCellTests = 0; }
+
+  int IntersectCellInternal(vtkIdType cellId, const double p1[3],
+                            const double p2[3], const double tol, double &t,
+                            double ipt[3], double pcoords[3], int &subId)
+    {
+    this->NumberOfCellTests++;
+    return this->Superclass::IntersectCellInternal(cellId, p1, p2, tol, t,
+                                                   ipt, pcoords, subId);
+    }
+};
+
+vtkStandardNewMacro(vtkCountingBSPTree);
+
+static int TestLocator(vtkAbstractCellLocator *locator, vtkPolyData *sphere,
+                       const double *p1, const double *p2)
+{
+  locator->SetDataSet(sphere);
+  locator->CacheCellBoundsOn();
+  locator->BuildLocator();
+
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  vtkstd::vector<vtkIdType> cellIds(NUMBER_OF_LINES);
+  vtkstd::vector<double> t(NUMBER_OF_LINES);
+  vtkIdType i, numHits = 0;
+  timer->StartTimer();
+  for (i = 0; i < NUMBER_OF_LINES; i++)
+    {
+    double x[3], pcoords[3];
+    int subId;
+    cellIds[i] = -1;
+    if (locator->IntersectWithLine(const_cast<double *>(p1 + 3 * i),
+                                   const_cast<double *>(p2 + 3 * i),
+                                   0.0, t[i], x, pcoords, subId, cellIds[i],
+                                   cell))
+      {
+      numHits++;
+      }
+    else
+      {
+      cellIds[i] = -1;
+      }
+    }
+  timer->StopTimer();
+  double serialTime = timer->GetElapsedTime();
+
+  vtkstd::vector<vtkIdType> batchCellIds(NUMBER_OF_LINES);
+  vtkstd::vector<double> batchT(NUMBER_OF_LINES);
+  vtkstd::vector<double> batchX(3 * NUMBER_OF_LINES);
+  timer->StartTimer();
+  vtkIdType batchHits = locator->IntersectWithLines(
+    NUMBER_OF_LINES, p1, p2, 0.0, &batchCellIds[0], &batchT[0], &batchX[0]);
+  timer->StopTimer();
+
+  cout << locator->GetClassName() << ": " << numHits << " hits, one by one "
+       << serialTime << " s, batched " << timer->GetElapsedTime() << " s"
+       << endl;
+
+  if (batchHits != numHits || numHits == 0)
+    {
+    cerr << locator->GetClassName() << ": " << batchHits
+         << " batched hits instead of " << numHits << endl;
+    return 1;
+    }
+  for (i = 0; i < NUMBER_OF_LINES; i++)
+    {
+    if (batchCellIds[i] != cellIds[i] ||
+        (cellIds[i] >= 0 && batchT[i] != t[i]))
+      {
+      cerr << locator->GetClassName() << ": wrong batched hit for line "
+           << i << endl;
+      return 1;
+      }
+    }
+  return 0;
+}
+
+int TestIntersectWithLines(int, char *[])
+{
+  vtkSmartPointer<vtkSphereSource> source =
+    vtkSmartPointer<vtkSphereSource>::New();
+  source->SetThetaResolution(60);
+  source->SetPhiResolution(60);
+  source->Update();
+  vtkPolyData *sphere = source->GetOutput();
+
+  // Lines from points around the sphere to points near its center, half of
+  // which are shifted so that some lines miss.
+  vtkMath::RandomSeed(8775070);
+  vtkstd::vector<double> p1(3 * NUMBER_OF_LINES);
+  vtkstd::vector<double> p2(3 * NUMBER_OF_LINES);
+  for (vtkIdType i = 0; i < NUMBER_OF_LINES; i++)
+    {
+    double shift = (i % 2) ? vtkMath::Random(0.0, 1.0) : 0.0;
+    for (int j = 0; j < 3; j++)
+      {
+      p1[3 * i + j] = vtkMath::Random(-1.0, 1.0) + shift;
+      p2[3 * i + j] = vtkMath::Random(-0.1, 0.1) + shift;
+      }
+    }
+
+  int retVal = 0;
+  vtkSmartPointer<vtkCellLocator> cellLocator =
+    vtkSmartPointer<vtkCellLocator>::New();
+  retVal |= TestLocator(cellLocator, sphere, &p1[0], &p2[0]);
+  vtkSmartPointer<vtkModifiedBSPTree> bspTree =
+    vtkSmartPointer<vtkModifiedBSPTree>::New();
+  retVal |= TestLocator(bspTree, sphere, &p1[0], &p2[0]);
+  vtkSmartPointer<vtkOBBTree> obbTree = vtkSmartPointer<vtkOBBTree>::New();
+  retVal |= TestLocator(obbTree, sphere, &p1[0], &p2[0]);
+  vtkSmartPointer<vtkCellTreeLocator> cellTree =
+    vtkSmartPointer<vtkCellTreeLocator>::New();
+  retVal |= TestLocator(cellTree, sphere, &p1[0], &p2[0]);
+
+  vtkSmartPointer<vtkCountingBSPTree> countingTree =
+    vtkSmartPointer<vtkCountingBSPTree>::New();
+  countingTree->SetDataSet(sphere);
+  countingTree->BuildLocator();
+  double t, x[3], pcoords[3];
+  int subId;
+  vtkIdType cellId;
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  double q1[3] = { 0.0, 0.0, 1.0 }, q2[3] = { 0.0, 0.0, 0.0 };
+  if (!countingTree->IntersectWithLine(q1, q2, 0.0, t, x, pcoords, subId,
+                                       cellId, cell) ||
+      countingTree->NumberOfCellTests == 0)
+    {
+    cerr << "IntersectWithLine() did not call the overridden cell test."
+         << endl;
+    retVal = 1;
+    }
+  vtkstd::vector<vtkIdType> cellIds(NUMBER_OF_LINES);
+  countingTree->NumberOfCellTests = 0;
+  vtkIdType numHits = countingTree->IntersectWithLines(
+    NUMBER_OF_LINES, &p1[0], &p2[0], 0.0, &cellIds[0], 0, 0);
+  if (numHits == 0 || countingTree->NumberOfCellTests < numHits)
+    {
+    cerr << "IntersectWithLines() did not call the overridden cell test."
+         << endl;
+    retVal = 1;
+    }
+
+  return retVal;
+}
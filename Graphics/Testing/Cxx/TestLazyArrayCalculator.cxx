@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLazyArrayCalculator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the lazily evaluated results of vtkArrayCalculator to the
+// results it computes up front, read from one thread and from several.
+
+#include "vtkArrayCalculator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkImageData.h"
+#include "vtkImplicitDataArrayTemplate.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+// Copies the tuples of an array from the threads of vtkSMPTools.
+class vtkReadTuples
+{
+public:
+  vtkReadTuples(vtkDataArray *in, vtkDataArray *out) : In(in), Out(out) {}
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    double tuple[3];
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->In->GetTuple(i, tuple);
+      this->Out->SetTuple(i, tuple);
+      }
+    }
+private:
+  vtkDataArray *In;
+  vtkDataArray *Out;
+};
+
+static vtkDataArray* Calculate(vtkArrayCalculator *calculator, int lazy,
+                               const char *function)
+{
+  calculator->SetLazyResult(lazy);
+  calculator->SetFunction(function);
+  calculator->Update();
+  return calculator->GetOutput()->GetPointData()->GetArray("result");
+}
+
+int TestLazyArrayCalculator(int, char *[])
+{
+  int rval = 0;
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 9, 0, 9, 0, 9);
+  image->SetSpacing(0.5, 1.0, 2.0);
+  vtkSmartPointer<vtkElevationFilter> elevation =
+    vtkSmartPointer<vtkElevationFilter>::New();
+  elevation->SetInput(image);
+  elevation->SetLowPoint(0, 0, 0);
+  elevation->SetHighPoint(0, 0, 18);
+
+  vtkSmartPointer<vtkArrayCalculator> calculator =
+    vtkSmartPointer<vtkArrayCalculator>::New();
+  calculator->SetInputConnection(elevation->GetOutputPort());
+  calculator->AddScalarVariable("s", "Elevation");
+  calculator->AddCoordinateScalarVariable("x", 0);
+  calculator->AddCoordinateVectorVariable("p", 0, 1, 2);
+  calculator->SetResultArrayName("result");
+  calculator->SetResultArrayType(VTK_FLOAT);
+
+  const char *functions[2] = { "2*s + x", "s*p + iHat" };
+  for (int f = 0; f < 2; ++f)
+    {
+    vtkSmartPointer<vtkDataArray> expected =
+      Calculate(calculator, 0, functions[f]);
+    vtkSmartPointer<vtkDataArray> lazy =
+      Calculate(calculator, 1, functions[f]);
+    if (!expected || !lazy ||
+        !vtkImplicitDataArrayTemplate<float>::SafeDownCast(lazy))
+      {
+      cerr << "No lazy result for " << functions[f] << endl;
+      return 1;
+      }
+    cout << functions[f] << ": " << lazy->GetNumberOfTuples() << " tuples of "
+         << lazy->GetNumberOfComponents() << " components, "
+         << lazy->GetActualMemorySize() << " kB instead of "
+         << expected->GetActualMemorySize() << " kB" << endl;
+    if (lazy->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+        lazy->GetNumberOfComponents() != expected->GetNumberOfComponents())
+      {
+      cerr << "Wrong lazy result size for " << functions[f] << endl;
+      return 1;
+      }
+    for (vtkIdType i = 0; i < lazy->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < lazy->GetNumberOfComponents(); ++c)
+        {
+        if (lazy->GetComponent(i, c) != expected->GetComponent(i, c))
+          {
+          cerr << functions[f] << ": tuple " << i << " component " << c
+               << " is " << lazy->GetComponent(i, c) << " instead of "
+               << expected->GetComponent(i, c) << endl;
+          rval = 1;
+          }
+        }
+      }
+
+    vtkSmartPointer<vtkDoubleArray> parallel =
+      vtkSmartPointer<vtkDoubleArray>::New();
+    parallel->SetNumberOfComponents(lazy->GetNumberOfComponents());
+    parallel->SetNumberOfTuples(lazy->GetNumberOfTuples());
+    vtkReadTuples read(lazy, parallel);
+    vtkSMPTools::Initialize(4);
+    vtkSMPTools::For(0, lazy->GetNumberOfTuples(), 7, read);
+    for (vtkIdType i = 0; i < lazy->GetNumberOfTuples(); ++i)
+      {
+      for (int c = 0; c < lazy->GetNumberOfComponents(); ++c)
+        {
+        if (parallel->GetComponent(i, c) != expected->GetComponent(i, c))
+          {
+          cerr << functions[f] << ": tuple " << i << " component " << c
+               << " read from the threads is " << parallel->GetComponent(i, c)
+               << " instead of " << expected->GetComponent(i, c) << endl;
+          rval = 1;
+          }
+        }
+      }
+    }
+
+  // Downstream filters copy the values into regular arrays.
+  Calculate(calculator, 1, "2*s + x");
+  vtkSmartPointer<vtkThreshold> threshold =
+    vtkSmartPointer<vtkThreshold>::New();
+  threshold->SetInputConnection(calculator->GetOutputPort());
+  threshold->SetInputArrayToProcess(0, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "result");
+  threshold->ThresholdBetween(1.0, 2.0);
+  threshold->Update();
+  vtkDataArray *copied =
+    threshold->GetOutput()->GetPointData()->GetArray("result");
+  if (!copied || copied->GetNumberOfTuples() == 0 ||
+      !copied->HasStandardMemoryLayout())
+    {
+    cerr << "The thresholded result was not copied into a regular array"
+         << endl;
+    rval = 1;
+    }
+
+  return rval;
+}
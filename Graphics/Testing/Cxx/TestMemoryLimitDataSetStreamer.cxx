@@ -0,0 +1,200 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryLimitDataSetStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Stream an unstructured grid read from a multi-piece XML file and a
+// synthetic image through vtkContourFilter with vtkMemoryLimitDataSetStreamer
+// and compare the results with the unstreamed pipelines.
+
+#include "vtkAppendFilter.h"
+#include "vtkCommand.h"
+#include "vtkContourFilter.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMemoryLimitDataSetStreamer.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+// Count the pieces forwarded by the streamer and their cells.
+class vtkPieceCounter : public vtkCommand
+{
+public:
+  static vtkPieceCounter *New() { return new vtkPieceCounter; }
+  virtual void Execute(vtkObject *, unsigned long, void *callData)
+    {
+    this->NumberOfPieces++;
+    this->NumberOfCells +=
+      static_cast<vtkDataSet*>(callData)->GetNumberOfCells();
+    }
+  int NumberOfPieces;
+  vtkIdType NumberOfCells;
+protected:
+  vtkPieceCounter() : NumberOfPieces(0), NumberOfCells(0) {}
+};
+
+// Return the estimated size of piece "piece" of "numberOfPieces" of the
+// output of the given algorithm.
+static unsigned long EstimateSize(vtkAlgorithm *algorithm, int piece,
+                                  int numberOfPieces)
+{
+  vtkStreamingDemandDrivenPipeline *exec =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(algorithm->GetExecutive());
+  exec->UpdateInformation();
+  exec->SetUpdateExtent(0, piece, numberOfPieces, 0);
+  exec->PropagateUpdateExtent(0);
+  exec->PropagateUpdateExtentInformation(0);
+  return exec->GetOutputInformation(0)->Get(
+    vtkStreamingDemandDrivenPipeline::ESTIMATED_MEMORY_SIZE());
+}
+
+int TestMemoryLimitDataSetStreamer(int argc, char *argv[])
+{
+  const int numberOfFilePieces = 8;
+  char *fileName = vtkTestUtilities::ExpandFileNameWithArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary",
+    "TestMemoryLimitDataSetStreamer.vtu");
+
+  vtkSmartPointer<vtkRTAnalyticSource> image =
+    vtkSmartPointer<vtkRTAnalyticSource>::New();
+  image->SetWholeExtent(-16, 15, -16, 15, -16, 15);
+  vtkSmartPointer<vtkAppendFilter> toGrid =
+    vtkSmartPointer<vtkAppendFilter>::New();
+  toGrid->SetInputConnection(image->GetOutputPort());
+  vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer =
+    vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+  writer->SetInputConnection(toGrid->GetOutputPort());
+  writer->SetNumberOfPieces(numberOfFilePieces);
+  writer->SetFileName(fileName);
+  writer->Write();
+
+  vtkSmartPointer<vtkXMLUnstructuredGridReader> reader =
+    vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
+  reader->SetFileName(fileName);
+  delete [] fileName;
+
+  // The reader estimates the size of its pieces.  The update extent of
+  // the last estimate, the whole grid, is kept by the update.
+  unsigned long quarterSize = EstimateSize(reader, 1, 4);
+  unsigned long wholeSize = EstimateSize(reader, 0, 1);
+  reader->Update();
+  unsigned long actualSize = reader->GetOutput()->GetActualMemorySize();
+  cout << "Estimated " << wholeSize << " KB for the whole grid, "
+       << quarterSize << " KB for a quarter, " << actualSize
+       << " KB used." << endl;
+  if (wholeSize < actualSize / 2 || wholeSize > actualSize * 2 ||
+      quarterSize < wholeSize / 8 || quarterSize > wholeSize / 2)
+    {
+    cerr << "Wrong size estimates." << endl;
+    return 1;
+    }
+
+  // The unstreamed result.
+  vtkSmartPointer<vtkContourFilter> contour =
+    vtkSmartPointer<vtkContourFilter>::New();
+  contour->SetInputConnection(reader->GetOutputPort());
+  contour->SetValue(0, 150.0);
+  contour->Update();
+  vtkIdType expectedCells = contour->GetOutput()->GetNumberOfCells();
+  if (expectedCells == 0)
+    {
+    cerr << "Empty contour." << endl;
+    return 1;
+    }
+
+  // The pieces are chosen from the estimates.
+  vtkSmartPointer<vtkMemoryLimitDataSetStreamer> streamer =
+    vtkSmartPointer<vtkMemoryLimitDataSetStreamer>::New();
+  streamer->SetInputConnection(contour->GetOutputPort());
+  streamer->SetMemoryLimit(wholeSize / 2);
+  streamer->Update();
+  vtkPolyData *output = vtkPolyData::SafeDownCast(streamer->GetOutput());
+  cout << "Streamed the grid in " << streamer->GetNumberOfStreamDivisions()
+       << " pieces." << endl;
+  if (streamer->GetNumberOfStreamDivisions() < 4 ||
+      streamer->GetNumberOfStreamDivisions() > numberOfFilePieces)
+    {
+    cerr << "Wrong number of pieces." << endl;
+    return 1;
+    }
+  if (!output || output->GetNumberOfCells() != expectedCells)
+    {
+    cerr << "Expected " << expectedCells << " triangles, got "
+         << (output ? output->GetNumberOfCells() : 0) << endl;
+    return 1;
+    }
+
+  // An up-to-date streamer does not execute again.
+  unsigned long mtime = output->GetMTime();
+  streamer->Update();
+  if (output->GetMTime() != mtime)
+    {
+    cerr << "The streamer executed again." << endl;
+    return 1;
+    }
+
+  // The pieces are forwarded without being merged.
+  vtkSmartPointer<vtkPieceCounter> counter =
+    vtkSmartPointer<vtkPieceCounter>::New();
+  streamer->AddObserver(vtkCommand::UpdateDataEvent, counter);
+  streamer->MergePiecesOff();
+  streamer->Update();
+  if (counter->NumberOfPieces < 2 ||
+      counter->NumberOfPieces > streamer->GetNumberOfStreamDivisions() ||
+      counter->NumberOfCells != expectedCells ||
+      streamer->GetOutput()->GetNumberOfCells() != 0)
+    {
+    cerr << "Forwarded " << counter->NumberOfPieces << " pieces and "
+         << counter->NumberOfCells << " triangles." << endl;
+    return 1;
+    }
+
+  // The image is sized from its extent.  The contour is not estimated,
+  // so the pieces are split once they have been measured.
+  vtkSmartPointer<vtkContourFilter> imageContour =
+    vtkSmartPointer<vtkContourFilter>::New();
+  imageContour->SetInputConnection(image->GetOutputPort());
+  imageContour->SetValue(0, 150.0);
+  imageContour->Update();
+  expectedCells = imageContour->GetOutput()->GetNumberOfCells();
+  unsigned long imageSize =
+    image->GetOutput()->GetActualMemorySize() +
+    imageContour->GetOutput()->GetActualMemorySize();
+
+  vtkSmartPointer<vtkMemoryLimitDataSetStreamer> imageStreamer =
+    vtkSmartPointer<vtkMemoryLimitDataSetStreamer>::New();
+  imageStreamer->SetInputConnection(imageContour->GetOutputPort());
+  imageStreamer->SetMemoryLimit(imageSize / 4);
+  imageStreamer->Update();
+  output = vtkPolyData::SafeDownCast(imageStreamer->GetOutput());
+  cout << "Streamed the image in "
+       << imageStreamer->GetNumberOfStreamDivisions() << " pieces." << endl;
+  if (imageStreamer->GetNumberOfStreamDivisions() < 4)
+    {
+    cerr << "Wrong number of pieces." << endl;
+    return 1;
+    }
+  if (!output || output->GetNumberOfCells() != expectedCells)
+    {
+    cerr << "Expected " << expectedCells << " triangles, got "
+         << (output ? output->GetNumberOfCells() : 0) << endl;
+    return 1;
+    }
+
+  return 0;
+}
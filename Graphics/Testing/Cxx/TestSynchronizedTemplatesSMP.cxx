@@ -0,0 +1,179 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSynchronizedTemplatesSMP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Contour image data and structured grids with vtkSynchronizedTemplates3D
+// and vtkGridSynchronizedTemplates3D in parallel slabs and check that the
+// outputs are identical to the serial ones for several numbers of
+// threads.  The scalars are integers and so are some contour values, so
+// that many points lie exactly on the isovalues.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourFilter.h"
+#include "vtkContourTestUtilities.h"
+#include "vtkDoubleArray.h"
+#include "vtkGridSynchronizedTemplates3D.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkShortArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkSynchronizedTemplates3D.h"
+
+#include <math.h>
+
+// The number of slabs grows with the number of threads up to 16.
+static const int Dimensions[3] = { 33, 29, 131 };
+
+// Return 1 if both outputs are identical.
+static int CompareOutputs(vtkPolyData *serial, vtkPolyData *parallel)
+{
+  if (serial->GetNumberOfPoints() != parallel->GetNumberOfPoints() ||
+      serial->GetNumberOfPolys() != parallel->GetNumberOfPolys())
+    {
+    cerr << "Expected " << serial->GetNumberOfPoints() << " points and "
+         << serial->GetNumberOfPolys() << " triangles, got "
+         << parallel->GetNumberOfPoints() << " and "
+         << parallel->GetNumberOfPolys() << endl;
+    return 0;
+    }
+  return CompareArrays("point", serial->GetPoints()->GetData(),
+                       parallel->GetPoints()->GetData()) &&
+    CompareArrays("connectivity", serial->GetPolys()->GetData(),
+                  parallel->GetPolys()->GetData()) &&
+    CompareAttributes("point data", serial->GetPointData(),
+                      parallel->GetPointData()) &&
+    CompareAttributes("cell data", serial->GetCellData(),
+                      parallel->GetCellData());
+}
+
+// Integer scalars, an interpolated vector field and cell data.
+static void AddAttributes(vtkDataSet *data)
+{
+  vtkSmartPointer<vtkShortArray> scalars =
+    vtkSmartPointer<vtkShortArray>::New();
+  scalars->SetName("Integers");
+  vtkSmartPointer<vtkDoubleArray> vectors =
+    vtkSmartPointer<vtkDoubleArray>::New();
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (int k = 0; k < Dimensions[2]; k++)
+    {
+    for (int j = 0; j < Dimensions[1]; j++)
+      {
+      for (int i = 0; i < Dimensions[0]; i++)
+        {
+        double s = 20.0*sin(0.3*i) + 20.0*cos(0.25*j) + 30.0*sin(0.2*k);
+        scalars->InsertNextValue(static_cast<short>(floor(s)));
+        vectors->InsertNextTuple3(i, j*j, sin(0.1*k));
+        }
+      }
+    }
+  data->GetPointData()->SetScalars(scalars);
+  data->GetPointData()->AddArray(vectors);
+
+  vtkSmartPointer<vtkIntArray> cellIds = vtkSmartPointer<vtkIntArray>::New();
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < data->GetNumberOfCells(); i++)
+    {
+    cellIds->InsertNextValue(static_cast<int>(i));
+    }
+  data->GetCellData()->AddArray(cellIds);
+}
+
+// Contour the data with the given filter, serially and in parallel.
+template <class Filter>
+int TestFilter(const char *name, vtkDataSet *data)
+{
+  vtkSmartPointer<Filter> filter = vtkSmartPointer<Filter>::New();
+  filter->SetInput(data);
+  filter->SetValue(0, -10.0);
+  filter->SetValue(1, 0.0);
+  filter->SetValue(2, 12.0);
+  filter->SetValue(3, 25.5);
+  filter->ComputeNormalsOn();
+  filter->ComputeGradientsOn();
+  filter->ComputeScalarsOn();
+
+  vtkSMPTools::Initialize(1);
+  filter->EnableSMPOff();
+  filter->Update();
+  vtkSmartPointer<vtkPolyData> serial = vtkSmartPointer<vtkPolyData>::New();
+  serial->DeepCopy(filter->GetOutput());
+  if (serial->GetNumberOfPolys() == 0)
+    {
+    cerr << name << ": empty contour." << endl;
+    return 0;
+    }
+
+  filter->EnableSMPOn();
+  int threads[] = { 1, 2, 3, 4, 8 };
+  for (int t = 0; t < 5; t++)
+    {
+    vtkSMPTools::Initialize(threads[t]);
+    filter->Modified();
+    filter->Update();
+    if (!CompareOutputs(serial, filter->GetOutput()))
+      {
+      cerr << name << " differs with " << threads[t] << " threads." << endl;
+      return 0;
+      }
+    }
+  cout << name << ": " << serial->GetNumberOfPoints() << " points, "
+       << serial->GetNumberOfPolys() << " triangles." << endl;
+  return 1;
+}
+
+int TestSynchronizedTemplatesSMP(int, char *[])
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(Dimensions[0], Dimensions[1], Dimensions[2]);
+  image->SetOrigin(-1.0, 2.0, 0.5);
+  image->SetSpacing(0.5, 0.25, 1.0);
+  AddAttributes(image);
+
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  for (int k = 0; k < Dimensions[2]; k++)
+    {
+    for (int j = 0; j < Dimensions[1]; j++)
+      {
+      for (int i = 0; i < Dimensions[0]; i++)
+        {
+        points->InsertNextPoint(i + 0.1*sin(0.5*j), j + 0.2*k, k + 0.01*i*j);
+        }
+      }
+    }
+  vtkSmartPointer<vtkStructuredGrid> grid =
+    vtkSmartPointer<vtkStructuredGrid>::New();
+  grid->SetDimensions(Dimensions[0], Dimensions[1], Dimensions[2]);
+  grid->SetPoints(points);
+  AddAttributes(grid);
+
+  if (!TestFilter<vtkSynchronizedTemplates3D>("vtkSynchronizedTemplates3D",
+                                              image) ||
+      !TestFilter<vtkGridSynchronizedTemplates3D>(
+        "vtkGridSynchronizedTemplates3D", grid) ||
+      !TestFilter<vtkContourFilter>("vtkContourFilter (image)", image) ||
+      !TestFilter<vtkContourFilter>("vtkContourFilter (grid)", grid))
+    {
+    return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,231 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeSynchronizedTemplates.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the throughput of vtkSynchronizedTemplates3D and
+// vtkGridSynchronizedTemplates3D when they contour serially and in
+// parallel slabs with vtkSMPTools, for a growing number of threads, and
+// that of vtkFlyingEdges3D, whose speedup is given with respect to the
+// serial vtkSynchronizedTemplates3D.  The volume is a cube of "size"
+// points a side filled with the distances to two spheres, contoured at
+// several values.  The point counts are checked against the serial ones.
+//
+// Usage: TimeSynchronizedTemplates [size [maxThreads [repetitions [grid]]]]
+//
+// Large volumes (1024 points a side, 4 GB of float scalars) show the
+// scaling best when they fit in memory.  The structured grid adds 12
+// bytes of points per voxel; pass 0 for grid to time the image filters
+// only.
+
+#include "vtkFlyingEdges3D.h"
+#include "vtkFloatArray.h"
+#include "vtkGridSynchronizedTemplates3D.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkSynchronizedTemplates3D.h"
+#include "vtkTimerLog.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// Fill the scalars of a size^3 volume with the distances to two spheres.
+static vtkFloatArray *NewScalars(int size)
+{
+  vtkFloatArray *scalars = vtkFloatArray::New();
+  scalars->SetName("Distance");
+  scalars->SetNumberOfTuples(static_cast<vtkIdType>(size) * size * size);
+  float *s = scalars->GetPointer(0);
+  double scale = 1.0 / size;
+  for (int k = 0; k < size; k++)
+    {
+    double z = k * scale;
+    for (int j = 0; j < size; j++)
+      {
+      double y = j * scale;
+      for (int i = 0; i < size; i++)
+        {
+        double x = i * scale;
+        double d0 = sqrt((x-0.3)*(x-0.3) + (y-0.4)*(y-0.4) + (z-0.5)*(z-0.5));
+        double d1 = sqrt((x-0.7)*(x-0.7) + (y-0.6)*(y-0.6) + (z-0.5)*(z-0.5));
+        *s++ = static_cast<float>(d0 < d1 ? d0 : d1);
+        }
+      }
+    }
+  return scalars;
+}
+
+// Time "repetitions" executions of the filter and return the average
+// time per execution.  The number of points of the output is returned
+// in numberOfPoints.
+static double TimeFilter(vtkPolyDataAlgorithm *filter, int repetitions,
+                         vtkIdType &numberOfPoints)
+{
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  timer->StartTimer();
+  for (int r = 0; r < repetitions; r++)
+    {
+    filter->Modified();
+    filter->Update();
+    }
+  timer->StopTimer();
+  numberOfPoints = filter->GetOutput()->GetNumberOfPoints();
+  return timer->GetElapsedTime() / repetitions;
+}
+
+// Set the contour values and the arrays computed by the filter.
+template <class Filter>
+static void SetUpFilter(Filter *filter)
+{
+  filter->SetValue(0, 0.1);
+  filter->SetValue(1, 0.2);
+  filter->SetValue(2, 0.3);
+  filter->ComputeNormalsOn();
+  filter->ComputeScalarsOff();
+}
+
+// Print the times of the parallel filter for 1 to maxThreads threads,
+// given the time and number of points of the serial one.  Return 0 when
+// a parallel output differs in size.
+static int TimeThreads(const char *name, vtkPolyDataAlgorithm *parallel,
+                       double serialTime, vtkIdType serialPoints,
+                       vtkIdType size, int maxThreads, int repetitions)
+{
+  double megaVoxels = size * size * size / 1.0e6;
+
+  cout << name << " (" << serialPoints << " points, " << repetitions
+       << " executions)" << endl;
+  cout << "  threads  serial(ms)  parallel(ms)  Mvoxels/s  speedup" << endl;
+  int retVal = 1;
+  for (int n = 1; n <= maxThreads; n *= 2)
+    {
+    vtkSMPTools::Initialize(n);
+    vtkIdType parallelPoints;
+    double parallelTime = TimeFilter(parallel, repetitions, parallelPoints);
+    if (parallelPoints != serialPoints)
+      {
+      cerr << name << " produced " << parallelPoints << " points with "
+           << n << " threads instead of " << serialPoints << endl;
+      retVal = 0;
+      }
+    cout << "  " << n << "\t   " << serialTime * 1000.0 << "\t"
+         << parallelTime * 1000.0 << "\t      "
+         << megaVoxels / parallelTime << "\t "
+         << serialTime / parallelTime << endl;
+    }
+  return retVal;
+}
+
+// Print the serial and parallel times of a synchronized templates filter.
+template <class Filter>
+static int TimeTemplates(const char *name, Filter *filter, vtkIdType size,
+                         int maxThreads, int repetitions,
+                         double &serialTime, vtkIdType &serialPoints)
+{
+  SetUpFilter(filter);
+  vtkSMPTools::Initialize(1);
+  filter->EnableSMPOff();
+  serialTime = TimeFilter(filter, repetitions, serialPoints);
+  filter->EnableSMPOn();
+  return TimeThreads(name, filter, serialTime, serialPoints, size,
+                     maxThreads, repetitions);
+}
+
+int main(int argc, char *argv[])
+{
+  int size = 256;
+  int maxThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  int repetitions = 3;
+  if (argc > 1)
+    {
+    size = atoi(argv[1]);
+    }
+  if (argc > 2)
+    {
+    maxThreads = atoi(argv[2]);
+    }
+  if (argc > 3)
+    {
+    repetitions = atoi(argv[3]);
+    }
+  int timeGrid = 1;
+  if (argc > 4)
+    {
+    timeGrid = atoi(argv[4]);
+    }
+
+  vtkFloatArray *scalars = NewScalars(size);
+
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(size, size, size);
+  image->SetSpacing(1.0 / size, 1.0 / size, 1.0 / size);
+  image->GetPointData()->SetScalars(scalars);
+
+  vtkSmartPointer<vtkSynchronizedTemplates3D> imageContour =
+    vtkSmartPointer<vtkSynchronizedTemplates3D>::New();
+  imageContour->SetInput(image);
+  double serialTime;
+  vtkIdType serialPoints;
+  int retVal = !TimeTemplates("vtkSynchronizedTemplates3D",
+                              imageContour.GetPointer(), size, maxThreads,
+                              repetitions, serialTime, serialPoints);
+  imageContour->SetInput(0);
+
+  vtkSmartPointer<vtkFlyingEdges3D> flyingEdges =
+    vtkSmartPointer<vtkFlyingEdges3D>::New();
+  flyingEdges->SetInput(image);
+  SetUpFilter(flyingEdges.GetPointer());
+  if (!TimeThreads("vtkFlyingEdges3D", flyingEdges.GetPointer(), serialTime,
+                   serialPoints, size, maxThreads, repetitions))
+    {
+    retVal = 1;
+    }
+  flyingEdges->SetInput(0);
+  if (!timeGrid)
+    {
+    scalars->Delete();
+    return retVal;
+    }
+
+  // The grid has the points of the image, so that both filters extract
+  // the same surfaces.
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); i++)
+    {
+    points->SetPoint(i, image->GetPoint(i));
+    }
+  image = 0;
+  vtkSmartPointer<vtkStructuredGrid> grid =
+    vtkSmartPointer<vtkStructuredGrid>::New();
+  grid->SetDimensions(size, size, size);
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  scalars->Delete();
+
+  vtkSmartPointer<vtkGridSynchronizedTemplates3D> gridContour =
+    vtkSmartPointer<vtkGridSynchronizedTemplates3D>::New();
+  gridContour->SetInput(grid);
+  if (!TimeTemplates("vtkGridSynchronizedTemplates3D",
+                     gridContour.GetPointer(), size, maxThreads,
+                     repetitions, serialTime, serialPoints))
+    {
+    retVal = 1;
+    }
+
+  return retVal;
+}
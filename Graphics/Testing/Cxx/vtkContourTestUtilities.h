@@ -0,0 +1,86 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkContourTestUtilities.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// The comparisons of the outputs of the filters run serially and in
+// parallel, shared by their tests.
+
+#ifndef __vtkContourTestUtilities_h
+#define __vtkContourTestUtilities_h
+
+#include "vtkDataArray.h"
+#include "vtkDataSetAttributes.h"
+
+#include <string.h>
+
+// Return 1 if both arrays hold the same values.
+static int CompareArrays(const char *what, vtkDataArray *a, vtkDataArray *b)
+{
+  if (!a || !b || a->GetDataType() != b->GetDataType() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      (a->GetName() && (!b->GetName() || strcmp(a->GetName(), b->GetName()))))
+    {
+    cerr << "The " << what << " arrays differ in type or size." << endl;
+    return 0;
+    }
+  int numComp = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < numComp; c++)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+        {
+        cerr << "The " << what << " arrays "
+             << (a->GetName() ? a->GetName() : "") << " differ at tuple "
+             << i << ": " << a->GetComponent(i, c) << " instead of "
+             << b->GetComponent(i, c) << endl;
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
+// Return 1 if both attributes have the same arrays and active attributes.
+static int CompareAttributes(const char *what, vtkDataSetAttributes *a,
+                             vtkDataSetAttributes *b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    cerr << "The " << what << " have " << a->GetNumberOfArrays()
+         << " and " << b->GetNumberOfArrays() << " arrays." << endl;
+    return 0;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); i++)
+    {
+    if (!CompareArrays(what, a->GetArray(i), b->GetArray(i)))
+      {
+      return 0;
+      }
+    }
+  for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; i++)
+    {
+    vtkDataArray *aa = a->GetAttribute(i);
+    vtkDataArray *ba = b->GetAttribute(i);
+    if ((aa == NULL) != (ba == NULL) ||
+        (aa && strcmp(aa->GetName(), ba->GetName())))
+      {
+      cerr << "The " << what << " have different attributes." << endl;
+      return 0;
+      }
+    }
+  return 1;
+}
+
+#endif
@@ -15,21 +15,198 @@
 #include "vtkArrayCalculator.h"
 
 #include "vtkCellData.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
 #include "vtkFunctionParser.h"
 #include "vtkGraph.h"
+#include "vtkImplicitArrayFunction.h"
+#include "vtkImplicitDataArrayTemplate.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <string>
+#include <vector>
+
 vtkStandardNewMacro(vtkArrayCalculator);
 
+// Evaluates the function of the calculator for one tuple at a time, for
+// the arrays returned when LazyResult is on.  It keeps its own parsers
+// and references to the input arrays and points, so that the result does
+// not change when the calculator executes again.  The arrays and points
+// are not copied: modifying them in place changes the result.
+//
+// The parser holds the values of the variables, so each thread of the
+// vtkSMPThreadPool evaluates the tuples with its own parser, set up like
+// Parser on its first call.  Thread index 0 is shared by the thread
+// calling vtkSMPTools and by the threads outside the pool: it uses Parser
+// under a lock.
+class vtkArrayCalculatorFunction : public vtkImplicitArrayFunction
+{
+public:
+  static vtkArrayCalculatorFunction *New();
+  vtkTypeMacro(vtkArrayCalculatorFunction,vtkImplicitArrayFunction);
+
+  virtual int GetNumberOfComponents() { return this->NumberOfComponents; }
+  virtual void EvaluateTuple(vtkIdType i, double *tuple);
+
+  // Set up a parser with the expression and the variables, defined in
+  // the order of their indices.
+  void InitializeParser(vtkFunctionParser *parser);
+
+  vtkFunctionParser *Parser;
+  int NumberOfComponents;
+
+  std::string Expression;
+  int ReplaceInvalidValues;
+  double ReplacementValue;
+  std::vector<std::string> ScalarVariableNames;
+  std::vector<std::string> VectorVariableNames;
+
+  std::vector<vtkSmartPointer<vtkDataArray> > ScalarArrays;
+  std::vector<int> ScalarComponents;
+  std::vector<vtkSmartPointer<vtkDataArray> > VectorArrays;
+  std::vector<int> VectorComponents;
+  // Points of a copy of the structure of the input data set, or of the
+  // input graph.
+  vtkSmartPointer<vtkDataSet> Structure;
+  vtkSmartPointer<vtkPoints> Points;
+  std::vector<int> CoordinateScalarComponents;
+  std::vector<int> CoordinateVectorComponents;
+
+protected:
+  vtkArrayCalculatorFunction()
+    {
+    this->Parser = vtkFunctionParser::New();
+    this->NumberOfComponents = 1;
+    this->ReplaceInvalidValues = 0;
+    this->ReplacementValue = 0.0;
+    }
+  ~vtkArrayCalculatorFunction()
+    {
+    this->Parser->Delete();
+    vtkSMPThreadLocal<vtkFunctionParser*>::iterator it;
+    for (it = this->ThreadParsers.begin();
+         it != this->ThreadParsers.end(); ++it)
+      {
+      if (*it)
+        {
+        (*it)->Delete();
+        }
+      }
+    }
+
+  void Evaluate(vtkFunctionParser *parser, vtkIdType i, double *tuple);
+
+  // The parsers of the pool threads other than thread 0.
+  vtkSMPThreadLocal<vtkFunctionParser*> ThreadParsers;
+  vtkSimpleCriticalSection Lock;
+
+private:
+  vtkArrayCalculatorFunction(const vtkArrayCalculatorFunction&);  // Not implemented.
+  void operator=(const vtkArrayCalculatorFunction&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkArrayCalculatorFunction);
+
+void vtkArrayCalculatorFunction::InitializeParser(vtkFunctionParser *parser)
+{
+  size_t j;
+  parser->SetFunction(this->Expression.c_str());
+  parser->SetReplaceInvalidValues(this->ReplaceInvalidValues);
+  parser->SetReplacementValue(this->ReplacementValue);
+  for (j = 0; j < this->ScalarVariableNames.size(); j++)
+    {
+    parser->SetScalarVariableValue(this->ScalarVariableNames[j].c_str(), 0.0);
+    }
+  for (j = 0; j < this->VectorVariableNames.size(); j++)
+    {
+    parser->SetVectorVariableValue(this->VectorVariableNames[j].c_str(),
+                                   0.0, 0.0, 0.0);
+    }
+}
+
+void vtkArrayCalculatorFunction::EvaluateTuple(vtkIdType i, double *tuple)
+{
+  if (vtkSMPThreadPool::GetThreadIndex() == 0)
+    {
+    this->Lock.Lock();
+    this->Evaluate(this->Parser, i, tuple);
+    this->Lock.Unlock();
+    return;
+    }
+
+  vtkFunctionParser *&parser = this->ThreadParsers.Local();
+  if (!parser)
+    {
+    parser = vtkFunctionParser::New();
+    this->InitializeParser(parser);
+    }
+  this->Evaluate(parser, i, tuple);
+}
+
+void vtkArrayCalculatorFunction::Evaluate(vtkFunctionParser *parser,
+                                          vtkIdType i, double *tuple)
+{
+  size_t j;
+  int numScalars = static_cast<int>(this->ScalarArrays.size());
+  int numVectors = static_cast<int>(this->VectorArrays.size());
+  double pt[3] = { 0.0, 0.0, 0.0 };
+  if (this->Structure)
+    {
+    this->Structure->GetPoint(i, pt);
+    }
+  else if (this->Points)
+    {
+    this->Points->GetPoint(i, pt);
+    }
+
+  for (j = 0; j < this->ScalarArrays.size(); j++)
+    {
+    parser->SetScalarVariableValue(
+      static_cast<int>(j),
+      this->ScalarArrays[j]->GetComponent(i, this->ScalarComponents[j]));
+    }
+  for (j = 0; j < this->VectorArrays.size(); j++)
+    {
+    const int *comps = &this->VectorComponents[3*j];
+    parser->SetVectorVariableValue(
+      static_cast<int>(j),
+      this->VectorArrays[j]->GetComponent(i, comps[0]),
+      this->VectorArrays[j]->GetComponent(i, comps[1]),
+      this->VectorArrays[j]->GetComponent(i, comps[2]));
+    }
+  for (j = 0; j < this->CoordinateScalarComponents.size(); j++)
+    {
+    parser->SetScalarVariableValue(
+      static_cast<int>(j) + numScalars, pt[this->CoordinateScalarComponents[j]]);
+    }
+  for (j = 0; 3*j < this->CoordinateVectorComponents.size(); j++)
+    {
+    const int *comps = &this->CoordinateVectorComponents[3*j];
+    parser->SetVectorVariableValue(
+      static_cast<int>(j) + numVectors,
+      pt[comps[0]], pt[comps[1]], pt[comps[2]]);
+    }
+  if (this->NumberOfComponents == 1)
+    {
+    tuple[0] = parser->GetScalarResult();
+    }
+  else
+    {
+    parser->GetVectorResult(tuple);
+    }
+}
+
 vtkArrayCalculator::vtkArrayCalculator()
 {
   this->FunctionParser = vtkFunctionParser::New();
@@ -56,6 +233,7 @@ vtkArrayCalculator::vtkArrayCalculator()
   this->ReplacementValue = 0.0;
 
   this->ResultArrayType=VTK_DOUBLE;
+  this->LazyResult = 0;
 }
 
 vtkArrayCalculator::~vtkArrayCalculator()
@@ -422,6 +600,34 @@ int vtkArrayCalculator::RequestData(
       }
     return 1;
     }
+  else if (this->LazyResult)
+    {
+    // The values are computed when they are read.
+    resultArray = this->NewLazyResultArray(
+      inFD, (attributeDataType == 0 ? dsInput : 0),
+      (attributeDataType == 0 ? graphInput : 0),
+      (resultType == 0 ? 1 : 3), numTuples);
+    if (!resultArray)
+      {
+      return 1;
+      }
+    dsOutput->CopyStructure(dsInput);
+    dsOutput->CopyAttributes(dsInput);
+
+    resultArray->SetName(this->ResultArrayName);
+    outFD->AddArray(resultArray);
+    if (resultType == 0)
+      {
+      outFD->SetActiveScalars(this->ResultArrayName);
+      }
+    else
+      {
+      outFD->SetActiveVectors(this->ResultArrayName);
+      }
+
+    resultArray->Delete();
+    return 1;
+    }
   else
     {
       resultArray=
@@ -563,6 +769,85 @@ int vtkArrayCalculator::RequestData(
   return 1;
 }
 
+vtkDataArray* vtkArrayCalculator::NewLazyResultArray(
+  vtkDataSetAttributes *inFD, vtkDataSet *inputData, vtkGraph *inputGraph,
+  int resultComponents, vtkIdType numTuples)
+{
+  int i;
+  vtkArrayCalculatorFunction *function = vtkArrayCalculatorFunction::New();
+  function->Expression = (this->Function ? this->Function : "");
+  function->ReplaceInvalidValues = this->ReplaceInvalidValues;
+  function->ReplacementValue = this->ReplacementValue;
+  function->NumberOfComponents = resultComponents;
+
+  // Define the variables in the order of their indices in RequestData().
+  for (i = 0; i < this->NumberOfScalarArrays; i++)
+    {
+    function->ScalarArrays.push_back(
+      inFD->GetArray(this->ScalarArrayNames[i]));
+    function->ScalarComponents.push_back(this->SelectedScalarComponents[i]);
+    function->ScalarVariableNames.push_back(this->ScalarVariableNames[i]);
+    }
+  for (i = 0; i < this->NumberOfVectorArrays; i++)
+    {
+    function->VectorArrays.push_back(
+      inFD->GetArray(this->VectorArrayNames[i]));
+    for (int c = 0; c < 3; c++)
+      {
+      function->VectorComponents.push_back(
+        this->SelectedVectorComponents[i][c]);
+      }
+    function->VectorVariableNames.push_back(this->VectorVariableNames[i]);
+    }
+  if (inputData || inputGraph)
+    {
+    if (inputData)
+      {
+      function->Structure.TakeReference(inputData->NewInstance());
+      function->Structure->CopyStructure(inputData);
+      }
+    else
+      {
+      function->Points = inputGraph->GetPoints();
+      }
+    for (i = 0; i < this->NumberOfCoordinateScalarArrays; i++)
+      {
+      function->CoordinateScalarComponents.push_back(
+        this->SelectedCoordinateScalarComponents[i]);
+      function->ScalarVariableNames.push_back(
+        this->CoordinateScalarVariableNames[i]);
+      }
+    for (i = 0; i < this->NumberOfCoordinateVectorArrays; i++)
+      {
+      for (int c = 0; c < 3; c++)
+        {
+        function->CoordinateVectorComponents.push_back(
+          this->SelectedCoordinateVectorComponents[i][c]);
+        }
+      function->VectorVariableNames.push_back(
+        this->CoordinateVectorVariableNames[i]);
+      }
+    }
+  function->InitializeParser(function->Parser);
+
+  vtkDataArray *resultArray = 0;
+  switch (this->ResultArrayType)
+    {
+    vtkTemplateMacro(
+      vtkImplicitDataArrayTemplate<VTK_TT> *array =
+        vtkImplicitDataArrayTemplate<VTK_TT>::New();
+      array->SetNumberOfComponents(resultComponents);
+      array->SetNumberOfTuples(numTuples);
+      array->SetFunction(function);
+      resultArray = array);
+    default:
+      vtkErrorMacro("Lazy results cannot be of type "
+                    << this->ResultArrayType << ".");
+    }
+  function->Delete();
+  return resultArray;
+}
+
 void vtkArrayCalculator::SetFunction(const char* function)
 {
   if (this->Function && function &&
@@ -1208,6 +1493,8 @@ void vtkArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Result Array Type: " << vtkImageScalarTypeNameMacro(this->ResultArrayType) << endl;
 
   os << indent << "Coordinate Results: " << this->CoordinateResults << endl;
+  os << indent << "Lazy Result: " << (this->LazyResult ? "On" : "Off")
+     << endl;
   os << indent << "Attribute Mode: " << this->GetAttributeModeAsString() << endl;
   os << indent << "Number Of Scalar Arrays: " << this->NumberOfScalarArrays
      << endl;
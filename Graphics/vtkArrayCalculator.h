@@ -52,15 +52,21 @@
 // tuple-wise (i.e., tuple-by-tuple). The user must specify which arrays to use as
 // vectors and/or scalars, and the name of the output data array.
 //
+// With LazyResult on, the result array computes each value when it is read
+// instead of holding them all (see vtkImplicitDataArrayTemplate).
+//
 // .SECTION See Also
-// vtkFunctionParser
+// vtkFunctionParser vtkImplicitDataArrayTemplate
 
 #ifndef __vtkArrayCalculator_h
 #define __vtkArrayCalculator_h
 
 #include "vtkDataSetAlgorithm.h"
 
+class vtkDataArray;
+class vtkDataSetAttributes;
 class vtkFunctionParser;
+class vtkGraph;
 
 #define VTK_ATTRIBUTE_MODE_DEFAULT 0
 #define VTK_ATTRIBUTE_MODE_USE_POINT_DATA 1
@@ -130,6 +136,21 @@ public:
   vtkGetMacro(CoordinateResults, int);
   vtkSetMacro(CoordinateResults, int);
   vtkBooleanMacro(CoordinateResults, int);
+
+  // Description:
+  // Set whether the result array computes each value from the input
+  // arrays when it is read, instead of holding all the values.  Such an
+  // array uses no memory for its values, but evaluates the function at
+  // every read: it suits results that are read once, or only in part.
+  // The arrays copied from it by downstream filters hold the values.  The
+  // result keeps references to the input arrays and points, not copies:
+  // it does not change when the filter executes again, but modifying
+  // these arrays in place changes its values.  It may be read from
+  // several threads at once.  It is ignored if CoordinateResults is
+  // true.  Initial value is false.
+  vtkGetMacro(LazyResult, int);
+  vtkSetMacro(LazyResult, int);
+  vtkBooleanMacro(LazyResult, int);
   
   // Description:
   // Control whether the filter operates on point data or cell data.
@@ -205,6 +226,15 @@ protected:
   ~vtkArrayCalculator();
 
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+
+  // Create the vtkImplicitDataArrayTemplate returned when LazyResult is
+  // on.  The coordinate variables read the points of inputData or
+  // inputGraph, or are not used when both are NULL.
+  vtkDataArray* NewLazyResultArray(vtkDataSetAttributes *inFD,
+                                   vtkDataSet *inputData,
+                                   vtkGraph *inputGraph,
+                                   int resultComponents,
+                                   vtkIdType numTuples);
   
   char  * Function;
   char  * ResultArrayName;
@@ -231,6 +261,7 @@ protected:
   int     NumberOfCoordinateVectorArrays;
 
   int     ResultArrayType;
+  int     LazyResult;
 private:
   vtkArrayCalculator(const vtkArrayCalculator&);  // Not implemented.
   void operator=(const vtkArrayCalculator&);  // Not implemented.
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkCellDataToPointData.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
 #include "vtkDataSet.h"
@@ -25,9 +26,12 @@
 #include "vtkUnsignedIntArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <functional>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellDataToPointData);
 
@@ -36,10 +40,84 @@ vtkStandardNewMacro(vtkCellDataToPointData);
 vtkCellDataToPointData::vtkCellDataToPointData()
 {
   this->PassCellData = 0;
+  this->EnableSMP = 1;
 }
 
 #define VTK_MAX_CELLS_PER_POINT 4096
 
+//----------------------------------------------------------------------------
+// Average the cell data at the points with the threads of vtkSMPTools.
+// Each thread queries the cells of the points of a chunk in its own list
+// and interpolates the whole chunk with InterpolatePoints(); the points
+// used by no cell, or by too many, are nulled as in the serial loop.
+class vtkCellDataToPointDataAverage
+{
+public:
+  vtkDataSet *Input;
+  vtkCellData *InCD;
+  vtkPointData *OutPD;
+  vtkSMPThreadLocal<vtkIdList *> CellIds;
+
+  void Initialize()
+    {
+    vtkIdList *cellIds = vtkIdList::New();
+    cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
+    this->CellIds.Local() = cellIds;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *cellIds = this->CellIds.Local();
+    std::vector<vtkIdType> offsets(end-begin+1);
+    std::vector<vtkIdType> ids;
+    std::vector<double> weights;
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+      offsets[ptId-begin] = static_cast<vtkIdType>(ids.size());
+      this->Input->GetPointCells(ptId, cellIds);
+      vtkIdType numCells = cellIds->GetNumberOfIds();
+      if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
+        {
+        double weight = 1.0 / numCells;
+        for (vtkIdType i = 0; i < numCells; i++)
+          {
+          ids.push_back(cellIds->GetId(i));
+          weights.push_back(weight);
+          }
+        }
+      }
+    offsets[end-begin] = static_cast<vtkIdType>(ids.size());
+    this->OutPD->InterpolatePoints(this->InCD, begin, end-begin, &offsets[0],
+                                   ids.empty() ? NULL : &ids[0],
+                                   weights.empty() ? NULL : &weights[0]);
+    }
+
+  void Reduce()
+    {
+    vtkSMPThreadLocal<vtkIdList *>::iterator it;
+    for (it = this->CellIds.begin(); it != this->CellIds.end(); ++it)
+      {
+      (*it)->Delete();
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Return 1 when all the cell arrays can be read, and interpolated to
+// disjoint point tuples, by several threads at once.
+static int vtkCellDataToPointDataCanAverageInParallel(vtkCellData *inCD)
+{
+  for (int i = 0; i < inCD->GetNumberOfArrays(); i++)
+    {
+    vtkDataArray *array = inCD->GetArray(i);
+    if ( !array || !vtkArrayDispatchIsDirect(array) )
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkCellDataToPointData::RequestData(
   vtkInformation*,
@@ -97,30 +175,50 @@ int vtkCellDataToPointData::RequestData(
   // It's weird, but it works.
   outPD->InterpolateAllocate(inPD,numPts);
 
-  int abort=0;
-  vtkIdType progressInterval=numPts/20 + 1;
-  for (ptId=0; ptId < numPts && !abort; ptId++)
+  if ( this->EnableSMP && vtkSMPTools::GetEstimatedNumberOfThreads() > 1 &&
+       vtkCellDataToPointDataCanAverageInParallel(inPD) )
     {
-    if ( !(ptId % progressInterval) )
+    // Size the arrays so that the threads only write their own tuples.
+    for (int i = 0; i < outPD->GetNumberOfArrays(); i++)
       {
-      this->UpdateProgress(static_cast<double>(ptId)/numPts);
-      abort = GetAbortExecute();
+      outPD->GetAbstractArray(i)->SetNumberOfTuples(numPts);
       }
-
-    input->GetPointCells(ptId, cellIds);
-    numCells = cellIds->GetNumberOfIds();
-    if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
+    input->PrepareForThreadedAccess();
+    vtkCellDataToPointDataAverage functor;
+    functor.Input = input;
+    functor.InCD = inPD;
+    functor.OutPD = outPD;
+    this->UpdateProgress(0.0);
+    vtkSMPTools::For(0, numPts, 1000, functor);
+    this->UpdateProgress(1.0);
+    }
+  else
+    {
+    int abort=0;
+    vtkIdType progressInterval=numPts/20 + 1;
+    for (ptId=0; ptId < numPts && !abort; ptId++)
       {
-      weight = 1.0 / numCells;
-      for (cellId=0; cellId < numCells; cellId++)
+      if ( !(ptId % progressInterval) )
         {
-        weights[cellId] = weight;
+        this->UpdateProgress(static_cast<double>(ptId)/numPts);
+        abort = GetAbortExecute();
+        }
+
+      input->GetPointCells(ptId, cellIds);
+      numCells = cellIds->GetNumberOfIds();
+      if ( numCells > 0 && numCells < VTK_MAX_CELLS_PER_POINT )
+        {
+        weight = 1.0 / numCells;
+        for (cellId=0; cellId < numCells; cellId++)
+          {
+          weights[cellId] = weight;
+          }
+        outPD->InterpolatePoint(inPD, ptId, cellIds, weights);
+        }
+      else
+        {
+        outPD->NullPoint(ptId);
         }
-      outPD->InterpolatePoint(inPD, ptId, cellIds, weights);
-      }
-    else
-      {
-      outPD->NullPoint(ptId);
       }
     }
 
@@ -143,6 +241,7 @@ void vtkCellDataToPointData::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Pass Cell Data: " << (this->PassCellData ? "On\n" : "Off\n");
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -52,6 +52,18 @@ public:
   vtkGetMacro(PassCellData,int);
   vtkBooleanMacro(PassCellData,int);
 
+  // Description:
+  // Enable/Disable averaging the cell data at the points with the threads
+  // of vtkSMPTools.  The output does not depend on it.  The threads query
+  // the cells of each point with vtkDataSet::GetPointCells(), after
+  // vtkDataSet::PrepareForThreadedAccess(), and are only used when
+  // several threads are available and all the cell arrays of the input
+  // can be read concurrently.  Unstructured grids, which are traversed
+  // cell by cell instead, are always processed serially.  On by default.
+  vtkSetMacro(EnableSMP,int);
+  vtkGetMacro(EnableSMP,int);
+  vtkBooleanMacro(EnableSMP,int);
+
 protected:
   vtkCellDataToPointData();
   ~vtkCellDataToPointData() {};
@@ -65,6 +77,7 @@ protected:
     (vtkInformation*, vtkInformationVector**, vtkInformationVector*);
 
   int PassCellData;
+  int EnableSMP;
 private:
   vtkCellDataToPointData(const vtkCellDataToPointData&);  // Not implemented.
   void operator=(const vtkCellDataToPointData&);  // Not implemented.
@@ -499,6 +499,12 @@ int vtkClipDataSet::ClipPoints(vtkDataSet* input,
 
   outPD->CopyAllocate(inPD, numPts/2, numPts/4);
 
+  // The point data is copied in bulk once the points are known.
+  vtkIdList* fromIds = vtkIdList::New();
+  vtkIdList* toIds = vtkIdList::New();
+  fromIds->Allocate(numPts/2);
+  toIds->Allocate(numPts/2);
+
   double value = 0.0;
   if (this->UseValueAsOffset || !this->ClipFunction)
     {
@@ -528,7 +534,8 @@ int vtkClipDataSet::ClipPoints(vtkDataSet* input,
       if (addPoint)
         {
         vtkIdType id = outPoints->InsertNextPoint(input->GetPoint(i));
-        outPD->CopyData(inPD, i, id);
+        fromIds->InsertNextId(i);
+        toIds->InsertNextId(id);
         }
       }
     }
@@ -559,12 +566,17 @@ int vtkClipDataSet::ClipPoints(vtkDataSet* input,
         if (addPoint)
           {
           vtkIdType id = outPoints->InsertNextPoint(input->GetPoint(i));
-          outPD->CopyData(inPD, i, id);
+          fromIds->InsertNextId(i);
+          toIds->InsertNextId(id);
           }
         }
       }
     }
 
+  outPD->CopyData(inPD, fromIds, toIds);
+  fromIds->Delete();
+  toIds->Delete();
+
   output->SetPoints(outPoints);
   outPoints->Delete();
 
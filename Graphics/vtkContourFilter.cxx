@@ -62,6 +62,8 @@ vtkContourFilter::vtkContourFilter()
   this->UseScalarTree = 0;
   this->ScalarTree = NULL;
 
+  this->EnableSMP = 1;
+
   this->SynchronizedTemplates2D = vtkSynchronizedTemplates2D::New();
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->GridSynchronizedTemplates = vtkGridSynchronizedTemplates3D::New();
@@ -296,6 +298,7 @@ int vtkContourFilter::RequestData(
       this->SynchronizedTemplates3D->SetComputeNormals(this->ComputeNormals);
       this->SynchronizedTemplates3D->SetComputeGradients(this->ComputeGradients);
       this->SynchronizedTemplates3D->SetComputeScalars(this->ComputeScalars);      
+      this->SynchronizedTemplates3D->SetEnableSMP(this->EnableSMP);
       this->SynchronizedTemplates3D->
         SetInputArrayToProcess(0,this->GetInputArrayInformation(0));
 
@@ -340,6 +343,7 @@ int vtkContourFilter::RequestData(
       this->GridSynchronizedTemplates->SetComputeNormals(this->ComputeNormals);
       this->GridSynchronizedTemplates->SetComputeGradients(this->ComputeGradients);
       this->GridSynchronizedTemplates->SetComputeScalars(this->ComputeScalars);
+      this->GridSynchronizedTemplates->SetEnableSMP(this->EnableSMP);
       this->GridSynchronizedTemplates->
         SetInputArrayToProcess(0,this->GetInputArrayInformation(0));
       return this->GridSynchronizedTemplates->
@@ -377,6 +381,17 @@ int vtkContourFilter::RequestData(
       {
       cgrid->SetLocator( this->Locator );
       }
+    // Keep the scalar tree from one execution to the next.
+    if ( this->UseScalarTree )
+      {
+      if ( this->ScalarTree == NULL )
+        {
+        this->ScalarTree = vtkSimpleScalarTree::New();
+        }
+      cgrid->SetScalarTree(this->ScalarTree);
+      }
+    cgrid->SetUseScalarTree(this->UseScalarTree);
+    cgrid->SetEnableSMP(this->EnableSMP);
       
     for (i = 0; i < numContours; i++)
       {
@@ -742,6 +757,8 @@ void vtkContourFilter::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Scalar Tree: (none)\n";
     }
 
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
+
   if ( this->Locator )
     {
     os << indent << "Locator: " << this->Locator << "\n";
@@ -118,6 +118,16 @@ public:
   virtual void SetScalarTree(vtkScalarTree*);
   vtkGetObjectMacro(ScalarTree,vtkScalarTree);
 
+  // Description:
+  // Enable/Disable contouring 3D image data and structured grids, and
+  // unstructured grids with a scalar tree, with the threads of
+  // vtkSMPTools: see vtkSynchronizedTemplates3D,
+  // vtkGridSynchronizedTemplates3D and vtkContourGrid.  The output does
+  // not depend on it.  On by default.
+  vtkSetMacro(EnableSMP,int);
+  vtkGetMacro(EnableSMP,int);
+  vtkBooleanMacro(EnableSMP,int);
+
   // Description:
   // Set / get a spatial locator for merging points. By default, 
   // an instance of vtkMergePoints is used.
@@ -161,6 +171,7 @@ protected:
   int ComputeScalars;
   vtkIncrementalPointLocator *Locator;
   int UseScalarTree;
+  int EnableSMP;
   vtkScalarTree *ScalarTree;
   
   vtkSynchronizedTemplates2D *SynchronizedTemplates2D;
@@ -19,21 +19,29 @@
 #include "vtkCellData.h"
 #include "vtkContourValues.h"
 #include "vtkFloatArray.h"
+#include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSimpleScalarTree.h"
+#include "vtkSynchronizedTemplates3D.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkCutter.h"
 #include "vtkMergePoints.h"
 #include "vtkPointLocator.h"
 #include "vtkIncrementalPointLocator.h"
 
+#include <vector>
+
 #include <math.h>
 
 vtkStandardNewMacro(vtkContourGrid);
+vtkCxxSetObjectMacro(vtkContourGrid,ScalarTree,vtkScalarTree);
 
 // Construct object with initial range (0,1) and single contour value
 // of 0.0.
@@ -49,6 +57,7 @@ vtkContourGrid::vtkContourGrid()
 
   this->UseScalarTree = 0;
   this->ScalarTree = NULL;
+  this->EnableSMP = 1;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
@@ -63,10 +72,7 @@ vtkContourGrid::~vtkContourGrid()
     this->Locator->UnRegister(this);
     this->Locator = NULL;
     }
-  if ( this->ScalarTree )
-    {
-    this->ScalarTree->Delete();
-    }
+  this->SetScalarTree(NULL);
 }
 
 // Overload standard modified time function. If contour values are modified,
@@ -90,13 +96,423 @@ unsigned long vtkContourGrid::GetMTime()
   return mTime;
 }
 
+//----------------------------------------------------------------------------
+// The candidate cells that vtkContourGrid gathers from scalar trees that
+// can only be traversed with GetNextCell() are cut in batches of this size.
+static const vtkIdType vtkContourGridBatchSize = 1000;
+
+// The locator of a thread.  vtkVertex and vtkPolyVertex add their points
+// with InsertNextPoint(), which does not merge them.  Such points are
+// flagged and left out of the buckets, so that the thread merges none of
+// its other points with them: both kinds are then inserted in the output
+// locator the way the serial filter inserts them.
+class vtkContourGridThreadLocator : public vtkMergePoints
+{
+public:
+  static vtkContourGridThreadLocator *New();
+  vtkTypeMacro(vtkContourGridThreadLocator,vtkMergePoints);
+
+  vtkIdType InsertNextPoint(const double x[3])
+    {
+    this->Unmerged.resize(this->InsertionPointId + 1, 0);
+    this->Unmerged[this->InsertionPointId] = 1;
+    this->Points->InsertPoint(this->InsertionPointId, x);
+    return this->InsertionPointId++;
+    }
+
+  int IsUnmerged(vtkIdType ptId)
+    {
+    return ptId < static_cast<vtkIdType>(this->Unmerged.size()) &&
+      this->Unmerged[ptId];
+    }
+
+protected:
+  vtkContourGridThreadLocator() {}
+  ~vtkContourGridThreadLocator() {}
+
+  std::vector<char> Unmerged;
+
+private:
+  vtkContourGridThreadLocator(const vtkContourGridThreadLocator&);  // Not implemented.
+  void operator=(const vtkContourGridThreadLocator&);  // Not implemented.
+};
+
+vtkStandardNewMacro(vtkContourGridThreadLocator);
+
+// The cells that contouring one input cell added to one of the cell
+// arrays of a thread.  Like the serial filter, the cells copy the cell
+// data of the input cell to the output cell data, at their id in their
+// cell array, offset by the number of cells of the arrays before it when
+// the cell class numbers the cells of the whole polydata (see for
+// instance vtkTetra).
+struct vtkContourGridCellRun
+{
+  vtkIdType InputCellId;
+  int Type; // 0, 1 or 2 for verts, lines or polys
+  int NumberOfCells;
+  int Offset; // whether the cell data ids are offset
+};
+
+// Set which cell types offset the ids of the cell data of the cells
+// they generate by the cells of the lower dimensional arrays.  All the
+// cells do but the vertices and the 1D cells, which generate vertices,
+// and vtkPixel, which numbers its lines on its own.  The nonlinear cells
+// contour through the linear ones.
+static void vtkContourGridGetOffsetCellTypes(unsigned char *offsetTypes)
+{
+  vtkCutter::GetCellTypeDimensions(offsetTypes);
+  for (int type = 0; type < VTK_NUMBER_OF_CELL_TYPES; type++)
+    {
+    offsetTypes[type] = (offsetTypes[type] >= 2 && type != VTK_PIXEL);
+    }
+}
+
+// The points and cells generated by one thread.  The thread merges the
+// points it generates with its own locator, so they are numbered in the
+// order it inserts them, like the serial filter would.
+struct vtkContourGridThreadOutput
+{
+  vtkGenericCell *Cell;
+  vtkDataArray *CellScalars;
+  vtkPoints *Points;
+  vtkContourGridThreadLocator *Locator;
+  vtkPointData *PointData;
+  vtkCellData *CellData; // no arrays: the cell data is copied when merged
+  vtkCellArray *Cells[3]; // verts, lines and polys
+  std::vector<vtkContourGridCellRun> Runs; // in the order of contouring
+  std::vector<vtkIdType> OutputPointIds; // output id of each point
+};
+
+// What a batch of candidate cells added to the output of its thread.
+struct vtkContourGridBatch
+{
+  vtkContourGridThreadOutput *Output;
+  vtkIdType PointStart;
+  vtkIdType PointEnd;
+  vtkIdType RunStart;
+  vtkIdType RunEnd;
+  vtkIdType ConnectivityStart[3];
+};
+
+// Contours the batches of candidate cells of one contour value, then
+// merges them in order into the output.  A thread processes its batches
+// in increasing order, so a point its locator already holds was created
+// by a batch that is merged before.  The points new to the output are
+// thus inserted in the order of the serial filter, with the attributes
+// interpolated at the same cells, and the cells are inserted and their
+// cell data copied in the same order too.
+class vtkContourGridContourBatches
+{
+public:
+  vtkUnstructuredGrid *Input;
+  vtkDataArray *InScalars;
+  vtkPointData *InPd;
+  vtkCellData *InCd;
+  const unsigned char *OffsetTypes;
+  double Value;
+  int ComputeScalars;
+  double Bounds[6];
+  vtkIdType EstimatedSize;
+
+  // The batches are those of the scalar tree, or cut from the candidates.
+  vtkScalarTree *ScalarTree;
+  const vtkIdType *Candidates;
+  vtkIdType NumberOfCandidates;
+  std::vector<vtkContourGridBatch> Batches;
+  vtkSMPThreadLocal<vtkContourGridThreadOutput *> Output;
+
+  vtkIncrementalPointLocator *Locator;
+  vtkCellArray *NewCells[3];
+  vtkPointData *OutPd;
+  vtkCellData *OutCd;
+
+  const vtkIdType *GetBatch(vtkIdType batchNum, vtkIdType &numCells)
+    {
+    if (this->ScalarTree)
+      {
+      return this->ScalarTree->GetCellBatch(batchNum, numCells);
+      }
+    vtkIdType start = batchNum * vtkContourGridBatchSize;
+    numCells = this->NumberOfCandidates - start;
+    if (numCells > vtkContourGridBatchSize)
+      {
+      numCells = vtkContourGridBatchSize;
+      }
+    return this->Candidates + start;
+    }
+
+  void Initialize()
+    {
+    vtkIdType size = this->EstimatedSize;
+    vtkContourGridThreadOutput *output = new vtkContourGridThreadOutput;
+    output->Cell = vtkGenericCell::New();
+    output->CellScalars = this->InScalars->NewInstance();
+    output->CellScalars->SetNumberOfComponents(
+      this->InScalars->GetNumberOfComponents());
+    output->CellScalars->Allocate(
+      VTK_CELL_SIZE*this->InScalars->GetNumberOfComponents());
+    output->Points = vtkPoints::New();
+    output->Points->Allocate(size, size);
+    output->Locator = vtkContourGridThreadLocator::New();
+    output->Locator->InitPointInsertion(output->Points, this->Bounds, size);
+    output->PointData = vtkPointData::New();
+    if (!this->ComputeScalars)
+      {
+      output->PointData->CopyScalarsOff();
+      }
+    output->PointData->InterpolateAllocate(this->InPd, size, size);
+    output->CellData = vtkCellData::New();
+    for (int t = 0; t < 3; t++)
+      {
+      output->Cells[t] = vtkCellArray::New();
+      output->Cells[t]->Allocate(size, size);
+      }
+    this->Output.Local() = output;
+    }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkContourGridThreadOutput *output = this->Output.Local();
+    vtkGenericCell *cell = output->Cell;
+    vtkDataArray *cellScalars = output->CellScalars;
+    vtkCellData *cellData = output->CellData;
+    vtkIdType numCells[3];
+    int t;
+    for (vtkIdType b = begin; b < end; b++)
+      {
+      vtkContourGridBatch &batch = this->Batches[b];
+      batch.Output = output;
+      batch.PointStart = output->Points->GetNumberOfPoints();
+      batch.RunStart = static_cast<vtkIdType>(output->Runs.size());
+      for (t = 0; t < 3; t++)
+        {
+        batch.ConnectivityStart[t] =
+          output->Cells[t]->GetNumberOfConnectivityEntries();
+        }
+
+      vtkIdType numIds;
+      const vtkIdType *cellIds = this->GetBatch(b, numIds);
+      for (vtkIdType i = 0; i < numIds; i++)
+        {
+        vtkIdType cellId = cellIds[i];
+        this->Input->GetCell(cellId, cell);
+        vtkIdList *cellPts = cell->GetPointIds();
+        vtkIdType numPts = cellPts->GetNumberOfIds();
+        cellScalars->SetNumberOfTuples(numPts);
+        this->InScalars->GetTuples(cellPts, cellScalars);
+        double min = VTK_DOUBLE_MAX, max = -VTK_DOUBLE_MAX;
+        for (vtkIdType j = 0; j < numPts; j++)
+          {
+          double s = cellScalars->GetComponent(j, 0);
+          min = (s < min ? s : min);
+          max = (s > max ? s : max);
+          }
+        if (this->Value < min || this->Value > max)
+          {
+          continue;
+          }
+        for (t = 0; t < 3; t++)
+          {
+          numCells[t] = output->Cells[t]->GetNumberOfCells();
+          }
+        cell->Contour(this->Value, cellScalars, output->Locator,
+                      output->Cells[0], output->Cells[1], output->Cells[2],
+                      this->InPd, output->PointData, this->InCd, cellId,
+                      cellData);
+        int cellType = cell->GetCellType();
+        int offset = (cellType >= 0 && cellType < VTK_NUMBER_OF_CELL_TYPES &&
+                      this->OffsetTypes[cellType]);
+        for (t = 0; t < 3; t++)
+          {
+          vtkIdType newCells = output->Cells[t]->GetNumberOfCells();
+          if (newCells > numCells[t])
+            {
+            vtkContourGridCellRun run;
+            run.InputCellId = cellId;
+            run.Type = t;
+            run.NumberOfCells = static_cast<int>(newCells - numCells[t]);
+            run.Offset = offset;
+            output->Runs.push_back(run);
+            }
+          }
+        }
+
+      batch.PointEnd = output->Points->GetNumberOfPoints();
+      batch.RunEnd = static_cast<vtkIdType>(output->Runs.size());
+      }
+    }
+
+  void Reduce()
+    {
+    std::vector<vtkIdType> pts;
+    double x[3];
+    for (size_t b = 0; b < this->Batches.size(); b++)
+      {
+      vtkContourGridBatch &batch = this->Batches[b];
+      vtkContourGridThreadOutput *output = batch.Output;
+      std::vector<vtkIdType> &outputIds = output->OutputPointIds;
+      outputIds.resize(batch.PointEnd);
+      for (vtkIdType p = batch.PointStart; p < batch.PointEnd; p++)
+        {
+        output->Points->GetPoint(p, x);
+        if (output->Locator->IsUnmerged(p))
+          {
+          outputIds[p] = this->Locator->InsertNextPoint(x);
+          this->OutPd->CopyData(output->PointData, p, outputIds[p]);
+          }
+        else if (this->Locator->InsertUniquePoint(x, outputIds[p]))
+          {
+          this->OutPd->CopyData(output->PointData, p, outputIds[p]);
+          }
+        }
+
+      vtkIdType *cellPts[3];
+      for (int t = 0; t < 3; t++)
+        {
+        cellPts[t] = output->Cells[t]->GetPointer() +
+          batch.ConnectivityStart[t];
+        }
+      for (vtkIdType r = batch.RunStart; r < batch.RunEnd; r++)
+        {
+        vtkContourGridCellRun &run = output->Runs[r];
+        int t = run.Type;
+        vtkIdType offset = 0;
+        if (run.Offset)
+          {
+          for (int lower = 0; lower < t; lower++)
+            {
+            offset += this->NewCells[lower]->GetNumberOfCells();
+            }
+          }
+        for (int c = 0; c < run.NumberOfCells; c++)
+          {
+          vtkIdType numPts = *cellPts[t]++;
+          pts.resize(numPts);
+          for (vtkIdType i = 0; i < numPts; i++)
+            {
+            pts[i] = outputIds[cellPts[t][i]];
+            }
+          cellPts[t] += numPts;
+          vtkIdType newCellId =
+            this->NewCells[t]->InsertNextCell(numPts, &pts[0]);
+          this->OutCd->CopyData(this->InCd, run.InputCellId,
+                                offset + newCellId);
+          }
+        }
+      }
+
+    vtkSMPThreadLocal<vtkContourGridThreadOutput *>::iterator it;
+    for (it = this->Output.begin(); it != this->Output.end(); ++it)
+      {
+      vtkContourGridThreadOutput *output = *it;
+      output->Cell->Delete();
+      output->CellScalars->Delete();
+      output->Points->Delete();
+      output->Locator->Delete();
+      output->PointData->Delete();
+      output->CellData->Delete();
+      for (int t = 0; t < 3; t++)
+        {
+        output->Cells[t]->Delete();
+        }
+      delete output;
+      }
+    }
+};
+
+// Contour the candidate cells of the scalar tree with the threads of
+// vtkSMPTools, one contour value after the other.
+static void vtkContourGridContourInParallel(
+  vtkContourGrid *self, vtkUnstructuredGrid *input, vtkDataArray *inScalars,
+  int numContours, double *values, int computeScalars,
+  vtkScalarTree *scalarTree, vtkIncrementalPointLocator *locator,
+  vtkCellArray *newVerts, vtkCellArray *newLines, vtkCellArray *newPolys,
+  vtkDataArray *cellScalars, vtkIdType estimatedSize, vtkPolyData *output)
+{
+  vtkPointData *inPd = input->GetPointData(), *outPd = output->GetPointData();
+  vtkCellData *inCd = input->GetCellData();
+
+  // The threads interpolate the point data from the input and the output
+  // copies it from the threads, which all have the same arrays.
+  vtkPointData *threadPd = vtkPointData::New();
+  if (!computeScalars)
+    {
+    threadPd->CopyScalarsOff();
+    }
+  threadPd->InterpolateAllocate(inPd, 0);
+  outPd->CopyAllOn();
+  outPd->CopyAllocate(threadPd, estimatedSize, estimatedSize);
+  threadPd->Delete();
+
+  vtkIdType threadSize =
+    estimatedSize / vtkSMPTools::GetEstimatedNumberOfThreads();
+  threadSize = (threadSize < 1024 ? 1024 : threadSize);
+
+  unsigned char offsetTypes[VTK_NUMBER_OF_CELL_TYPES];
+  vtkContourGridGetOffsetCellTypes(offsetTypes);
+
+  std::vector<vtkIdType> candidates;
+  for (int i = 0; i < numContours && !self->GetAbortExecute(); i++)
+    {
+    vtkContourGridContourBatches functor;
+    functor.Input = input;
+    functor.InScalars = inScalars;
+    functor.InPd = inPd;
+    functor.InCd = inCd;
+    functor.OffsetTypes = offsetTypes;
+    functor.Value = values[i];
+    functor.ComputeScalars = computeScalars;
+    input->GetBounds(functor.Bounds);
+    functor.EstimatedSize = threadSize;
+    functor.ScalarTree = NULL;
+    functor.Candidates = NULL;
+    functor.NumberOfCandidates = 0;
+    functor.Locator = locator;
+    functor.NewCells[0] = newVerts;
+    functor.NewCells[1] = newLines;
+    functor.NewCells[2] = newPolys;
+    functor.OutPd = outPd;
+    functor.OutCd = output->GetCellData();
+
+    scalarTree->InitTraversal(values[i]);
+    vtkIdType numBatches = scalarTree->GetNumberOfCellBatches();
+    if (numBatches > 0)
+      {
+      functor.ScalarTree = scalarTree;
+      }
+    else
+      {
+      // The tree can only be traversed serially: gather its candidates.
+      vtkIdType cellId;
+      vtkIdList *cellPts;
+      candidates.clear();
+      while (scalarTree->GetNextCell(cellId, cellPts, cellScalars) != NULL)
+        {
+        candidates.push_back(cellId);
+        }
+      functor.NumberOfCandidates = static_cast<vtkIdType>(candidates.size());
+      functor.Candidates = (candidates.empty() ? NULL : &candidates[0]);
+      numBatches = (functor.NumberOfCandidates + vtkContourGridBatchSize - 1) /
+        vtkContourGridBatchSize;
+      }
+    if (numBatches > 0)
+      {
+      functor.Batches.resize(numBatches);
+      vtkSMPTools::For(0, numBatches, 1, functor);
+      }
+    self->UpdateProgress(static_cast<double>(i+1)/numContours);
+    }
+}
+
+//----------------------------------------------------------------------------
 template <class T>
 void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
                            vtkPolyData *output,
                            vtkDataArray *inScalars, T *scalarArrayPtr,
                            int numContours, double *values, 
                            int computeScalars,
-                           int useScalarTree,vtkScalarTree *&scalarTree)
+                           int useScalarTree,vtkScalarTree *&scalarTree,
+                           int parallel)
 {
   vtkIdType cellId, i;
   int abortExecute=0;
@@ -112,6 +528,7 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
   vtkDataArray *cellScalars;
   vtkUnstructuredGrid *grid = static_cast<vtkUnstructuredGrid *>(input);
   //In this case, we know that the input is an unstructured grid.
+  vtkCellArray *cells = grid->GetCells();
   vtkIdType numPoints, cellArrayIt = 0;
   int needCell = 0;
   vtkIdType *cellArrayPtr;
@@ -176,6 +593,7 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
     unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
     vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
     int dimensionality;
+    vtkIdList *cellIdBuffer = vtkIdList::New();
     // We skip 0d cells (points), because they cannot be cut (generate no data).
     for (dimensionality = 1; dimensionality <= 3; ++dimensionality)
       {
@@ -183,34 +601,31 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
       // and process each cell.
       //
       cellArrayIt = 0;
-      cellArrayPtr = grid->GetCells()->GetPointer();
       for (cellId=0; cellId < numCells && !abortExecute; cellId++)
         {
-        numPoints = cellArrayPtr[cellArrayIt];
         // I assume that "GetCellType" is fast.
         cellType = input->GetCellType(cellId);
         if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
           { // Protect against new cell types added.
           vtkGenericWarningMacro("Unknown cell type " << cellType);
-          cellArrayIt += 1+numPoints;
+          cellArrayIt += 1+cells->GetCellSize(cellArrayIt);
           continue;
           }
         if (cellTypeDimensions[cellType] != dimensionality)
           {
-          cellArrayIt += 1+numPoints;
+          cellArrayIt += 1+cells->GetCellSize(cellArrayIt);
           continue;
           }
-        cellArrayIt++;
+        // The points are decoded into cellIdBuffer with 32 bit storage.
+        cells->GetNextCell(cellArrayIt, numPoints, cellArrayPtr, cellIdBuffer);
         
         //find min and max values in scalar data
-        range[0] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        range[1] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        cellArrayIt++;
+        range[0] = scalarArrayPtr[cellArrayPtr[0]];
+        range[1] = scalarArrayPtr[cellArrayPtr[0]];
         
         for (i = 1; i < numPoints; i++)
           {
-          tempScalar = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-          cellArrayIt++;
+          tempScalar = scalarArrayPtr[cellArrayPtr[i]];
           if (tempScalar <= range[0])
             {
             range[0] = tempScalar;
@@ -258,6 +673,7 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
         needCell = 0;
         } // for all cells
       } // For all dimensions.
+    cellIdBuffer->Delete();
     } //if using scalar tree
   else
     {
@@ -271,21 +687,31 @@ void vtkContourGridExecute(vtkContourGrid *self, vtkDataSet *input,
       scalarTree = vtkSimpleScalarTree::New();
       }
     scalarTree->SetDataSet(input);
-    //
-    // Loop over all contour values.  Then for each contour value, 
-    // loop over all cells.
-    //
-    for (i=0; i < numContours; i++)
+    if ( parallel )
+      {
+      vtkContourGridContourInParallel(self, grid, inScalars, numContours,
+                                      values, computeScalars, scalarTree,
+                                      locator, newVerts, newLines, newPolys,
+                                      cellScalars, estimatedSize, output);
+      }
+    else
       {
-      for ( scalarTree->InitTraversal(values[i]); 
-          (cell=scalarTree->GetNextCell(cellId,cellPts,cellScalars)) != NULL; )
+      //
+      // Loop over all contour values.  Then for each contour value, 
+      // loop over all cells.
+      //
+      for (i=0; i < numContours; i++)
         {
-        cell->Contour(values[i], cellScalars, locator,
-                      newVerts, newLines, newPolys, inPd, outPd,
-                      inCd, cellId, outCd);
-           //don't want to call Contour any more than necessary
-        } //for all cells
-      } //for all contour values
+        for ( scalarTree->InitTraversal(values[i]); 
+            (cell=scalarTree->GetNextCell(cellId,cellPts,cellScalars)) != NULL; )
+          {
+          cell->Contour(values[i], cellScalars, locator,
+                        newVerts, newLines, newPolys, inPd, outPd,
+                        inCd, cellId, outCd);
+             //don't want to call Contour any more than necessary
+          } //for all cells
+        } //for all contour values
+      }
     } //using scalar tree
 
   //
@@ -360,6 +786,13 @@ int vtkContourGrid::RequestData(
     return 1;
     }
 
+  // Contour the candidate cells of the scalar tree concurrently when the
+  // threads can merge their points the way the locator does.
+  int parallel = useScalarTree && this->EnableSMP &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1 &&
+    vtkMergePoints::SafeDownCast(this->Locator) != NULL &&
+    vtkSynchronizedTemplatesSlabs::CanContourInParallel(input);
+
   scalarArrayPtr = inScalars->GetVoidPointer(0);
         
   switch (inScalars->GetDataType())
@@ -368,7 +801,7 @@ int vtkContourGrid::RequestData(
       vtkContourGridExecute(this, input, output, inScalars,
                             static_cast<VTK_TT *>(scalarArrayPtr),
                             numContours, values,computeScalars, useScalarTree, 
-                            scalarTree));
+                            scalarTree, parallel));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
       return 1;
@@ -408,6 +841,15 @@ void vtkContourGrid::CreateDefaultLocator()
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkContourGrid::ReportReferences(vtkGarbageCollector* collector)
+{
+  this->Superclass::ReportReferences(collector);
+  // The scalar tree shares our input and is therefore involved in a
+  // reference loop.
+  vtkGarbageCollectorReport(collector, this->ScalarTree, "ScalarTree");
+}
+
 int vtkContourGrid::FillInputPortInformation(int, vtkInformation *info)
 {
   info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
@@ -426,6 +868,15 @@ void vtkContourGrid::PrintSelf(ostream& os, vtkIndent indent)
      << (this->ComputeScalars ? "On\n" : "Off\n");
   os << indent << "Use Scalar Tree: " 
      << (this->UseScalarTree ? "On\n" : "Off\n");
+  if ( this->ScalarTree )
+    {
+    os << indent << "Scalar Tree: " << this->ScalarTree << "\n";
+    }
+  else
+    {
+    os << indent << "Scalar Tree: (none)\n";
+    }
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
 
   this->ContourValues->PrintSelf(os,indent.GetNextIndent());
 
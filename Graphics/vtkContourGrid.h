@@ -30,8 +30,16 @@
 // vtkScalarTree. A scalar tree is used to quickly locate cells that
 // contain a contour surface. This is especially effective if multiple
 // contours are being extracted. If you want to use a scalar tree,
-// invoke the method UseScalarTreeOn().
+// invoke the method UseScalarTreeOn(). A vtkSimpleScalarTree is used
+// unless another one is given with SetScalarTree(); a vtkSpanSpace only
+// visits the cells spanning the contour values, which pays off when
+// the same grid is contoured again and again at different values.
 //
+// When a scalar tree is used and EnableSMP is on, the candidate cells of
+// each contour value are contoured in batches with the threads of
+// vtkSMPTools. Each thread merges the points it generates, and the
+// batches are then merged in order into the output, which is identical
+// to the serial one.
 
 // .SECTION Caveats
 // For unstructured data or structured grids, normals and gradients
@@ -39,6 +47,7 @@
 // normals of the resulting isosurface.
 
 // .SECTION See Also
+// vtkScalarTree vtkSpanSpace vtkSMPTools
 // vtkMarchingContourFilter vtkKitwareContourFilter
 // vtkMarchingCubes vtkSliceCubes vtkDividingCubes vtkMarchingSquares
 // vtkImageMarchingCubes
@@ -112,6 +121,24 @@ public:
   vtkGetMacro(UseScalarTree,int);
   vtkBooleanMacro(UseScalarTree,int);
 
+  // Description:
+  // Set / get the scalar tree used when UseScalarTree is on. By default,
+  // an instance of vtkSimpleScalarTree is created.
+  virtual void SetScalarTree(vtkScalarTree*);
+  vtkGetObjectMacro(ScalarTree,vtkScalarTree);
+
+  // Description:
+  // Enable/Disable contouring the candidate cells of the scalar tree
+  // with the threads of vtkSMPTools. The output does not depend on it,
+  // but the batches are kept until they are merged, which about doubles
+  // the memory used by the output during the execution. The batches are
+  // only used when several threads are available, the locator is a
+  // vtkMergePoints and all the input arrays can be read concurrently.
+  // On by default.
+  vtkSetMacro(EnableSMP,int);
+  vtkGetMacro(EnableSMP,int);
+  vtkBooleanMacro(EnableSMP,int);
+
   // Description:
   // Set / get a spatial locator for merging points. By default, 
   // an instance of vtkMergePoints is used.
@@ -129,6 +156,7 @@ protected:
 
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
   virtual int FillInputPortInformation(int port, vtkInformation *info);
+  virtual void ReportReferences(vtkGarbageCollector*);
 
   vtkContourValues *ContourValues;
   int ComputeNormals;
@@ -137,6 +165,7 @@ protected:
   vtkIncrementalPointLocator *Locator;
   int UseScalarTree;
   vtkScalarTree *ScalarTree;
+  int EnableSMP;
   vtkEdgeTable *EdgeTable;
   
 private:
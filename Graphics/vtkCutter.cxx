@@ -657,7 +657,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   vtkIdType estimatedSize, numCells=input->GetNumberOfCells();
   vtkIdType numPts=input->GetNumberOfPoints();
   vtkIdType cellArrayIt = 0;
-  int numCellPts;
+  vtkIdType numCellPts;
   vtkPointData *inPD, *outPD;
   vtkCellData *inCD=input->GetCellData(), *outCD=output->GetCellData();
   vtkIdList *cellIds;
@@ -724,7 +724,10 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   int cut=0;
 
   vtkUnstructuredGrid *grid = static_cast<vtkUnstructuredGrid *>(input);
-  vtkIdType *cellArrayPtr = grid->GetCells()->GetPointer();
+  // The points of a cell are decoded into cellIdBuffer with 32 bit storage.
+  vtkCellArray *cells = grid->GetCells();
+  vtkIdList *cellIdBuffer = vtkIdList::New();
+  vtkIdType *cellArrayPtr;
   double *scalarArrayPtr = cutScalars->GetPointer(0);
   double tempScalar;
   cellScalars = cutScalars->NewInstance();
@@ -750,18 +753,16 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
           abortExecute = this->GetAbortExecute();
           }
 
-        numCellPts = cellArrayPtr[cellArrayIt];
-        cellArrayIt++;
+        cells->GetNextCell(cellArrayIt, numCellPts, cellArrayPtr,
+                           cellIdBuffer);
         
         //find min and max values in scalar data
-        range[0] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        range[1] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        cellArrayIt++;
+        range[0] = scalarArrayPtr[cellArrayPtr[0]];
+        range[1] = scalarArrayPtr[cellArrayPtr[0]];
         
         for (i = 1; i < numCellPts; i++)
           {
-          tempScalar = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-          cellArrayIt++;
+          tempScalar = scalarArrayPtr[cellArrayPtr[i]];
           if (tempScalar <= range[0])
             {
             range[0] = tempScalar;
@@ -833,31 +834,29 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
       cellArrayIt = 0;
       for (cellId=0; cellId < numCells && !abortExecute; cellId++)
         {
-        numCellPts = cellArrayPtr[cellArrayIt];
         // I assume that "GetCellType" is fast.
         cellType = input->GetCellType(cellId);
         if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
           { // Protect against new cell types added.
           vtkErrorMacro("Unknown cell type " << cellType);
-          cellArrayIt += 1+numCellPts;
+          cellArrayIt += 1+cells->GetCellSize(cellArrayIt);
           continue;
           }
         if (cellTypeDimensions[cellType] != dimensionality)
           {
-          cellArrayIt += 1+numCellPts;
+          cellArrayIt += 1+cells->GetCellSize(cellArrayIt);
           continue;
           }
-        cellArrayIt++;
+        cells->GetNextCell(cellArrayIt, numCellPts, cellArrayPtr,
+                           cellIdBuffer);
             
         //find min and max values in scalar data
-        range[0] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        range[1] = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-        cellArrayIt++;
+        range[0] = scalarArrayPtr[cellArrayPtr[0]];
+        range[1] = scalarArrayPtr[cellArrayPtr[0]];
             
         for (i = 1; i < numCellPts; i++)
           {
-          tempScalar = scalarArrayPtr[cellArrayPtr[cellArrayIt]];
-          cellArrayIt++;
+          tempScalar = scalarArrayPtr[cellArrayPtr[i]];
           if (tempScalar <= range[0])
             {
             range[0] = tempScalar;
@@ -909,6 +908,7 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet *input, vtkPolyData *output)
   // polys we've created, take care to reclaim memory.
   //
   cellScalars->Delete();
+  cellIdBuffer->Delete();
   cutScalars->Delete();
 
   if ( this->GenerateCutScalars )
@@ -51,6 +51,25 @@ static int sizeofFastQuad(int numPts)
   return static_cast<int>(sizeof(vtkFastGeomQuad)+(numPts-4)*sizeof(vtkIdType));
 }
 
+//----------------------------------------------------------------------------
+// Copy in bulk the data of the tuples inIds to the consecutive tuples
+// starting at outStart.
+static void vtkDataSetSurfaceFilterCopyData(vtkDataSetAttributes *inDSA,
+                                            vtkDataSetAttributes *outDSA,
+                                            vtkIdList *inIds,
+                                            vtkIdType outStart)
+{
+  vtkIdType numIds = inIds->GetNumberOfIds();
+  vtkIdList *outIds = vtkIdList::New();
+  outIds->SetNumberOfIds(numIds);
+  for (vtkIdType i = 0; i < numIds; ++i)
+    {
+    outIds->SetId(i, outStart + i);
+    }
+  outDSA->CopyData(inDSA, inIds, outIds);
+  outIds->Delete();
+}
+
 
 class vtkDataSetSurfaceFilter::vtkEdgeInterpolationMap
 {
@@ -555,7 +574,9 @@ void vtkDataSetSurfaceFilter::ExecuteFaceStrips(vtkDataSet *input,
     }
 
   outStartPtId = outPts->GetNumberOfPoints();
-  // Make the points for this face.
+  // Make the points for this face.  Their data is copied in bulk.
+  vtkIdList *inPtIds = vtkIdList::New();
+  inPtIds->Allocate((ext[bA2+1]-ext[bA2]+1)*(ext[cA2+1]-ext[cA2]+1));
   for (ic = ext[cA2]; ic <= ext[cA2+1]; ++ic)
     {
     for (ib = ext[bA2]; ib <= ext[bA2+1]; ++ib)
@@ -564,11 +585,12 @@ void vtkDataSetSurfaceFilter::ExecuteFaceStrips(vtkDataSet *input,
                          + (ic-ext[cA2])*pInc[cAxis];
       input->GetPoint(inId, pt);
       outId = outPts->InsertNextPoint(pt);
-      // Copy point data.
-      outPD->CopyData(inPD,inId,outId);
+      inPtIds->InsertNextId(inId);
       this->RecordOrigPointId(outId, inId);
       }
     }
+  vtkDataSetSurfaceFilterCopyData(inPD, outPD, inPtIds, outStartPtId);
+  inPtIds->Delete();
 
   // Do the cells.
   cOutInc = ext[bA2+1] - ext[bA2] + 1;
@@ -715,7 +737,10 @@ void vtkDataSetSurfaceFilter::ExecuteFaceQuads(vtkDataSet *input,
     }
 
   outStartPtId = outPts->GetNumberOfPoints();
-  // Make the points for this face.
+  // Make the points for this face.  Their data is copied in bulk, as is
+  // the data of the cells.
+  vtkIdList *inIds = vtkIdList::New();
+  inIds->Allocate((ext[bA2+1]-ext[bA2]+1)*(ext[cA2+1]-ext[cA2]+1));
   for (ic = ext[cA2]; ic <= ext[cA2+1]; ++ic)
     {
     for (ib = ext[bA2]; ib <= ext[bA2+1]; ++ib)
@@ -724,16 +749,18 @@ void vtkDataSetSurfaceFilter::ExecuteFaceQuads(vtkDataSet *input,
                          + (ic-ext[cA2])*pInc[cAxis];
       input->GetPoint(inId, pt);
       outId = outPts->InsertNextPoint(pt);
-      // Copy point data.
-      outPD->CopyData(inPD,inId,outId);
+      inIds->InsertNextId(inId);
       this->RecordOrigPointId(outId, inId);     
       }
     }
+  vtkDataSetSurfaceFilterCopyData(inPD, outPD, inIds, outStartPtId);
+  inIds->Reset();
 
   // Do the cells.
   cOutInc = ext[bA2+1] - ext[bA2] + 1;
 
   outPolys = output->GetPolys();
+  vtkIdType outStartCellId = outPolys->GetNumberOfCells();
 
   // Old method for creating quads (needed for cell data.).
   for (ic = ext[cA2]; ic < ext[cA2+1]; ++ic)
@@ -748,11 +775,12 @@ void vtkDataSetSurfaceFilter::ExecuteFaceQuads(vtkDataSet *input,
       outPolys->InsertCellPoint(outPtId+cOutInc);
       outPolys->InsertCellPoint(outPtId+cOutInc+1);
       outPolys->InsertCellPoint(outPtId+1);
-      // Copy cell data.
-      outCD->CopyData(inCD,inId,outId);
+      inIds->InsertNextId(inId);
       this->RecordOrigCellId(outId, inId);      
       }
     }
+  vtkDataSetSurfaceFilterCopyData(inCD, outCD, inIds, outStartCellId);
+  inIds->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -783,6 +811,11 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
 
   cellIds = vtkIdList::New();
   pts = vtkIdList::New();
+  // The point and cell data are copied in bulk once the ids are known.
+  vtkIdList *fromPtIds = vtkIdList::New();
+  vtkIdList *toPtIds = vtkIdList::New();
+  vtkIdList *fromCellIds = vtkIdList::New();
+  vtkIdList *toCellIds = vtkIdList::New();
 
   vtkDebugMacro(<<"Executing geometry filter");
 
@@ -828,12 +861,14 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
           ptId = cell->GetPointId(i);
           input->GetPoint(ptId, x);
           pt = newPts->InsertNextPoint(x);
-          outputPD->CopyData(pd,ptId,pt);
+          fromPtIds->InsertNextId(ptId);
+          toPtIds->InsertNextId(pt);
           this->RecordOrigPointId(pt, ptId);
           pts->InsertId(i,pt);
           }
         newCellId = output->InsertNextCell(cell->GetCellType(), pts);
-        outputCD->CopyData(cd,cellId,newCellId);
+        fromCellIds->InsertNextId(cellId);
+        toCellIds->InsertNextId(newCellId);
         this->RecordOrigCellId(newCellId, cellId);
         break;
        case 3:
@@ -850,12 +885,14 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
               ptId = face->GetPointId(i);
               input->GetPoint(ptId, x);
               pt = newPts->InsertNextPoint(x);
-              outputPD->CopyData(pd,ptId,pt);
+              fromPtIds->InsertNextId(ptId);
+              toPtIds->InsertNextId(pt);
               this->RecordOrigPointId(pt, ptId);
               pts->InsertId(i,pt);
               }
             newCellId = output->InsertNextCell(face->GetCellType(), pts);
-            outputCD->CopyData(cd,cellId,newCellId);
+            fromCellIds->InsertNextId(cellId);
+            toCellIds->InsertNextId(newCellId);
             this->RecordOrigCellId(newCellId, cellId);
             }
           }
@@ -866,6 +903,9 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
   vtkDebugMacro(<<"Extracted " << newPts->GetNumberOfPoints() << " points,"
                 << output->GetNumberOfCells() << " cells.");
 
+  outputPD->CopyData(pd, fromPtIds, toPtIds);
+  outputCD->CopyData(cd, fromCellIds, toCellIds);
+
   // Update ourselves and release memory
   //
   cell->Delete();
@@ -877,6 +917,10 @@ int vtkDataSetSurfaceFilter::DataSetExecute(vtkDataSet *input,
   
   cellIds->Delete();
   pts->Delete();
+  fromPtIds->Delete();
+  toPtIds->Delete();
+  fromCellIds->Delete();
+  toCellIds->Delete();
 
   return 1;
 }
@@ -1012,12 +1056,16 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   int progressCount;
   vtkIdType cellId;
   int i, j;
-  vtkIdType *cellPointer;
+  vtkCellArray *cells = input->GetCells();
+  vtkIdType cellLoc;
+  // The points of a cell are decoded into cellIdBuffer with 32 bit storage.
+  vtkIdList *cellIdBuffer;
   int cellType;
   vtkIdType numPts=input->GetNumberOfPoints();
   vtkIdType numCells=input->GetNumberOfCells();
   vtkGenericCell *cell;
-  int numFacePts, numCellPts;
+  int numFacePts;
+  vtkIdType numCellPts;
   vtkIdType inPtId, outPtId;
   vtkPointData *inputPD = input->GetPointData();
   vtkCellData *inputCD = input->GetCellData();
@@ -1038,6 +1086,8 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   vtkDoubleArray *parametricCoords2;
   vtkIdList *outPts;
   vtkIdList *outPts2;
+  // The neighbors of the faces of nonlinear cells, reused for every cell
+  vtkIdList *faceNeighbors;
   
   pts = vtkIdList::New();  
   coords = vtkPoints::New();
@@ -1045,6 +1095,8 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   parametricCoords2 = vtkDoubleArray::New();
   outPts = vtkIdList::New();
   outPts2 = vtkIdList::New();
+  faceNeighbors = vtkIdList::New();
+  cellIdBuffer = vtkIdList::New();
   // might not be necessary to set the data type for coords
   // but certainly safer to do so
   coords->SetDataType(input->GetPoints()->GetData()->GetDataType());
@@ -1089,20 +1141,17 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
     }
 
   // First insert all points.  Points have to come first in poly data.
-  cellPointer = input->GetCells()->GetPointer();
+  cellLoc = 0;
   for(cellId=0; cellId < numCells; cellId++)
     {
     // Direct access to cells.
     cellType = cellTypes[cellId];
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    cells->GetNextCell(cellLoc, numCellPts, ids, cellIdBuffer);
 
     // A couple of common cases to see if things go faster.
     if (cellType == VTK_VERTEX || cellType == VTK_POLY_VERTEX)
       {
-      newVerts->InsertNextCell(numCellPts);
+      newVerts->InsertNextCell(static_cast<int>(numCellPts));
       for (i = 0; i < numCellPts; ++i)
         {
         inPtId = ids[i];
@@ -1123,7 +1172,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   // First insert all points lines in output and 3D geometry in hash.
   // Save 2D geometry for second pass.
   // initialize the pointer to the cells for fast traversal.
-  cellPointer = input->GetCells()->GetPointer();
+  cellLoc = 0;
   for(cellId=0; cellId < numCells && !abort; cellId++)
     {
     //Progress and abort method support
@@ -1138,10 +1187,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
 
     // Direct access to cells.
     cellType = cellTypes[cellId];
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    cells->GetNextCell(cellLoc, numCellPts, ids, cellIdBuffer);
 
     // A couple of common cases to see if things go faster.
     if (cellType == VTK_VERTEX || cellType == VTK_POLY_VERTEX)
@@ -1150,7 +1196,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
       }
     else if (cellType == VTK_LINE || cellType == VTK_POLY_LINE)
       {
-      newLines->InsertNextCell(numCellPts);
+      newLines->InsertNextCell(static_cast<int>(numCellPts));
       for (i = 0; i < numCellPts; ++i)
         {
         inPtId = ids[i];
@@ -1284,7 +1330,7 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
           } 
         else //3D nonlinear cell
           {
-          vtkIdList *cellIds = vtkIdList::New();
+          vtkIdList *cellIds = faceNeighbors;
           int numFaces = cell->GetNumberOfFaces();
           for (j=0; j < numFaces; j++)
             {
@@ -1327,7 +1373,6 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
                 } // subdivision level
               } // cell has ids
             } // for faces
-          cellIds->Delete();
           } //3d cell
         } //nonlinear cell
       } // Cell type else.
@@ -1340,15 +1385,12 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   // Now insert 2DCells.  Because of poly datas (cell data) ordering,
   // the 2D cells have to come after points and lines.
   // initialize the pointer to the cells for fast traversal.
-  cellPointer = input->GetCells()->GetPointer();
+  cellLoc = 0;
   for(cellId=0; cellId < numCells && !abort && flag2D; cellId++)
     {  
     // Direct acces to cells.
     cellType = input->GetCellType(cellId);
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    cells->GetNextCell(cellLoc, numCellPts, ids, cellIdBuffer);
 
     // If we have a quadratic face and our subdivision level is zero, just treat
     // it as a linear cell.  This should work so long as the first points of the
@@ -1537,6 +1579,24 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
     outputCD->CopyData(inputCD, q->SourceId, this->NumberOfNewCells++);
     }
 
+  // Copy the data of the points taken from the input, which
+  // GetOutputPointId() numbered in PointMap.
+  vtkIdList *fromPtIds = vtkIdList::New();
+  vtkIdList *toPtIds = vtkIdList::New();
+  fromPtIds->Allocate(newPts->GetNumberOfPoints());
+  toPtIds->Allocate(newPts->GetNumberOfPoints());
+  for (inPtId = 0; inPtId < numPts; ++inPtId)
+    {
+    if ((outPtId = this->PointMap[inPtId]) >= 0)
+      {
+      fromPtIds->InsertNextId(inPtId);
+      toPtIds->InsertNextId(outPtId);
+      }
+    }
+  outputPD->CopyData(inputPD, fromPtIds, toPtIds);
+  fromPtIds->Delete();
+  toPtIds->Delete();
+
   if (this->PassThroughCellIds)
     {
     outputCD->AddArray(this->OriginalCellIds);
@@ -1555,6 +1615,8 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   parametricCoords2->Delete();
   outPts->Delete();
   outPts2->Delete();
+  faceNeighbors->Delete();
+  cellIdBuffer->Delete();
 
   output->SetPoints(newPts);
   newPts->Delete();
@@ -2018,7 +2080,7 @@ vtkFastGeomQuad *vtkDataSetSurfaceFilter::GetNextVisibleQuadFromHash()
 vtkIdType vtkDataSetSurfaceFilter::GetOutputPointId(vtkIdType inPtId,
                                                     vtkDataSet *input,
                                                     vtkPoints *outPts,
-                                                    vtkPointData *outPD)
+                                                    vtkPointData *)
 {
   vtkIdType outPtId;
   
@@ -2026,7 +2088,6 @@ vtkIdType vtkDataSetSurfaceFilter::GetOutputPointId(vtkIdType inPtId,
   if (outPtId == -1)
     {
     outPtId = outPts->InsertNextPoint(input->GetPoint(inPtId));
-    outPD->CopyData(input->GetPointData(), inPtId, outPtId);
     this->PointMap[inPtId] = outPtId;
     this->RecordOrigPointId(outPtId, inPtId);
     }
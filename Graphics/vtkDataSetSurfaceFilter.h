@@ -169,12 +169,20 @@ protected:
   vtkIdType QuadHashTraversalIndex;
 
   vtkIdType *PointMap;
+  // Map an input point to an output point, inserting it on first use.
+  // GetOutputPointId() does not copy the point data anymore, outPD is
+  // unused: UnstructuredGridExecute() copies the data of all the points
+  // numbered in PointMap in bulk once the surface is generated.  Other
+  // callers must copy the point data themselves.
   vtkIdType GetOutputPointId(vtkIdType inPtId, vtkDataSet *input, 
                              vtkPoints *outPts, vtkPointData *outPD);
 //BTX
   class vtkEdgeInterpolationMap;
 //ETX
   vtkEdgeInterpolationMap *EdgeMap;
+  // Insert the point of the edge at pcoords in the cell on first use.  Its
+  // point data is interpolated right away into outPD since these points are
+  // numbered between the ones of PointMap.
   vtkIdType GetInterpolatedPointId(vtkIdType edgePtA, vtkIdType edgePtB,
                                    vtkDataSet *input, vtkCell *cell,
                                    double pcoords[3], vtkPoints *outPts,
@@ -461,7 +461,7 @@ vtkIdList *vtkExtractCells::reMapPointIds(vtkDataSet *grid)
   
     this->SubSetUGridCellArraySize = 0;
   
-    vtkIdType *cellArray = ugrid->GetCells()->GetPointer();
+    vtkCellArray *cellArray = ugrid->GetCells();
     vtkIdType *locs = ugrid->GetCellLocationsArray()->GetPointer(0);
 
     this->SubSetUGridCellArraySize = 0;
@@ -475,13 +475,13 @@ vtkIdList *vtkExtractCells::reMapPointIds(vtkDataSet *grid)
         
       int loc = locs[*cellPtr];
 
-      vtkIdType nIds = cellArray[loc++];
+      vtkIdType nIds = cellArray->GetCellSize(loc);
 
       this->SubSetUGridCellArraySize += (1 + nIds);
         
       for (i=0; i<nIds; i++)  
         {
-        id = cellArray[loc++];
+        id = cellArray->GetCellPointId(loc, i);
           
         if (temp[id] == 0)  
           {
@@ -606,7 +606,7 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
   int nextCellId = 0;
 
   std::set<vtkIdType>::iterator cellPtr;                           // input
-  vtkIdType *cells = ugrid->GetCells()->GetPointer();
+  vtkCellArray *cells = ugrid->GetCells();
   vtkIdType maxid = ugrid->GetCellLocationsArray()->GetMaxId();
   vtkIdType *locs = ugrid->GetCellLocationsArray()->GetPointer(0);
   vtkUnsignedCharArray *types = ugrid->GetCellTypesArray();
@@ -620,8 +620,7 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
     int oldCellId = *cellPtr;
 
     int loc = locs[oldCellId];
-    int size = static_cast<int>(cells[loc]);
-    vtkIdType *pts = cells + loc + 1;
+    int size = static_cast<int>(cells->GetCellSize(loc));
     unsigned char type = types->GetValue(oldCellId);
 
     locationArray->SetValue(nextCellId, cellArrayIdx);
@@ -631,7 +630,7 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkIdList *ptMap,
 
     for (int i=0; i<size; i++)  
       {
-      vtkIdType oldId = *pts++;
+      vtkIdType oldId = cells->GetCellPointId(loc, i);
       vtkIdType newId = vtkExtractCells::findInSortedList(ptMap, oldId);
 
       newcells->SetValue(cellArrayIdx++, newId);
@@ -14,7 +14,7 @@
 =========================================================================*/
 #include "vtkExtractGeometry.h"
 
-#include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -82,13 +82,14 @@ int vtkExtractGeometry::RequestData(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType ptId, numPts, numCells, i, cellId, newCellId, newId, *pointMap;
+  vtkIdType numNewPts, numNewCells, connectivitySize;
   vtkIdList *cellPts;
-  vtkCell *cell;
   int numCellPts;
   double x[3];
   double multiplier;
   vtkPoints *newPts;
   vtkIdList *newCellPts;
+  vtkIdList *fromIds, *toIds;
   vtkPointData *pd = input->GetPointData();
   vtkCellData *cd = input->GetCellData();
   vtkPointData *outputPD = output->GetPointData();
@@ -108,6 +109,8 @@ int vtkExtractGeometry::RequestData(
   outputPD->CopyGlobalIdsOn();
   outputCD->CopyGlobalIdsOn();
 
+  cellPts = vtkIdList::New();
+  cellPts->Allocate(VTK_CELL_SIZE);
   newCellPts = vtkIdList::New();
   newCellPts->Allocate(VTK_CELL_SIZE);
 
@@ -121,7 +124,9 @@ int vtkExtractGeometry::RequestData(
     }
 
   // Loop over all points determining whether they are inside the
-  // implicit function. Copy the points and point data if they are.
+  // implicit function, numbering them if they are.  The points, cells
+  // and their data are copied once they are all counted, so that the
+  // output is allocated once to its exact size.
   //
   numPts = input->GetNumberOfPoints();
   numCells = input->GetNumberOfCells();
@@ -130,12 +135,8 @@ int vtkExtractGeometry::RequestData(
     {
     pointMap[i] = -1;
     }
+  numNewPts = 0;
 
-  output->Allocate(numCells/4); //allocate storage for geometry/topology
-  newPts = vtkPoints::New();
-  newPts->Allocate(numPts/4,numPts);
-  outputPD->CopyAllocate(pd);
-  outputCD->CopyAllocate(cd);
   vtkFloatArray *newScalars = NULL;
   
   if ( ! this->ExtractBoundaryCells )
@@ -145,9 +146,7 @@ int vtkExtractGeometry::RequestData(
       input->GetPoint(ptId, x);
       if ( (this->ImplicitFunction->FunctionValue(x)*multiplier) < 0.0 )
         {
-        newId = newPts->InsertNextPoint(x);
-        pointMap[ptId] = newId;
-        outputPD->CopyData(pd,ptId,newId);
+        pointMap[ptId] = numNewPts++;
         }
       }
     }
@@ -165,9 +164,7 @@ int vtkExtractGeometry::RequestData(
       newScalars->SetValue(ptId, val);
       if ( val < 0.0 )
         {
-        newId = newPts->InsertNextPoint(x);
-        pointMap[ptId] = newId;
-        outputPD->CopyData(pd,ptId,newId);
+        pointMap[ptId] = numNewPts++;
         }
       }
     }
@@ -175,13 +172,14 @@ int vtkExtractGeometry::RequestData(
   // Now loop over all cells to see whether they are inside implicit
   // function (or on boundary if ExtractBoundaryCells is on).
   //
+  char *keptCells = new char[numCells > 0 ? numCells : 1];
+  numNewCells = 0;
+  connectivitySize = 0;
   for (cellId=0; cellId < numCells; cellId++)
     {
-    cell = input->GetCell(cellId);
-    cellPts = cell->GetPointIds();
-    numCellPts = cell->GetNumberOfPoints();
+    input->GetCellPoints(cellId, cellPts);
+    numCellPts = cellPts->GetNumberOfIds();
 
-    newCellPts->Reset();
     if ( ! this->ExtractBoundaryCells ) //requires less work
       {
       for ( npts=0, i=0; i < numCellPts; i++, npts++)
@@ -191,10 +189,6 @@ int vtkExtractGeometry::RequestData(
           {
           break; //this cell won't be inserted
           }
-        else
-          {
-          newCellPts->InsertId(i,pointMap[ptId]);
-          }
         }
       } //if don't want to extract boundary cells
     
@@ -230,12 +224,8 @@ int vtkExtractGeometry::RequestData(
           ptId = cellPts->GetId(i);
           if ( pointMap[ptId] < 0 )
             {
-            input->GetPoint(ptId, x);
-            newId = newPts->InsertNextPoint(x);
-            pointMap[ptId] = newId;
-            outputPD->CopyData(pd,ptId,newId);
+            pointMap[ptId] = numNewPts++;
             }
-          newCellPts->InsertId(i,pointMap[ptId]);
           }
         }//a boundary or interior cell
       }//if mapping boundary cells
@@ -255,25 +245,83 @@ int vtkExtractGeometry::RequestData(
         extraction_condition = 1;
         }
       }
+    keptCells[cellId] = static_cast<char>(extraction_condition);
     if ( extraction_condition )
       {
-      // special handling for polyhedron cells
-      if (vtkUnstructuredGrid::SafeDownCast(input) &&
-          cell->GetCellType() == VTK_POLYHEDRON)
+      numNewCells++;
+      connectivitySize += numCellPts + 1;
+      }
+    }//for all cells
+
+  // Copy the points and cells kept.
+  //
+  output->AllocateExact(numNewCells, connectivitySize);
+  newPts = vtkPoints::New();
+  newPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyAllocate(pd,numNewPts);
+  outputCD->CopyAllocate(cd,numNewCells);
+
+  // The point and cell data are copied in bulk once the ids are known.
+  fromIds = vtkIdList::New();
+  toIds = vtkIdList::New();
+  fromIds->Allocate(numNewPts);
+  toIds->Allocate(numNewPts);
+  for (ptId=0; ptId < numPts; ptId++)
+    {
+    if ( (newId = pointMap[ptId]) >= 0 )
+      {
+      input->GetPoint(ptId, x);
+      newPts->SetPoint(newId, x);
+      fromIds->InsertNextId(ptId);
+      toIds->InsertNextId(newId);
+      }
+    }
+  outputPD->CopyData(pd,fromIds,toIds);
+
+  fromIds->Reset();
+  toIds->Reset();
+  fromIds->Allocate(numNewCells);
+  toIds->Allocate(numNewCells);
+
+  for (cellId=0; cellId < numCells; cellId++)
+    {
+    if ( !keptCells[cellId] )
+      {
+      continue;
+      }
+    int cellType = input->GetCellType(cellId);
+    // special handling for polyhedron cells
+    if (vtkUnstructuredGrid::SafeDownCast(input) &&
+        cellType == VTK_POLYHEDRON)
+      {
+      newCellPts->Reset();
+      vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
+      vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap);
+      }
+    else
+      {
+      input->GetCellPoints(cellId, cellPts);
+      numCellPts = cellPts->GetNumberOfIds();
+      newCellPts->SetNumberOfIds(numCellPts);
+      for (i=0; i < numCellPts; i++)
         {
-        newCellPts->Reset();
-        vtkUnstructuredGrid::SafeDownCast(input)->GetFaceStream(cellId, newCellPts);
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap);
+        newCellPts->SetId(i, pointMap[cellPts->GetId(i)]);
         }
-      newCellId = output->InsertNextCell(cell->GetCellType(),newCellPts);
-      outputCD->CopyData(cd,cellId,newCellId);
       }
-    }//for all cells
+    newCellId = output->InsertNextCell(cellType,newCellPts);
+    fromIds->InsertNextId(cellId);
+    toIds->InsertNextId(newCellId);
+    }//for all kept cells
+  outputCD->CopyData(cd,fromIds,toIds);
 
   // Update ourselves and release memory
   //
+  delete [] keptCells;
   delete [] pointMap;
+  cellPts->Delete();
   newCellPts->Delete();
+  fromIds->Delete();
+  toIds->Delete();
   output->SetPoints(newPts);
   newPts->Delete();
 
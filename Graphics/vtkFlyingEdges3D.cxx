@@ -0,0 +1,992 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFlyingEdges3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFlyingEdges3D.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkExtentTranslator.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkSynchronizedTemplates3D.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkFlyingEdges3D);
+
+//----------------------------------------------------------------------------
+// Description:
+// Construct object with a single contour value of 0.0.
+vtkFlyingEdges3D::vtkFlyingEdges3D()
+{
+  this->ContourValues = vtkContourValues::New();
+  this->ComputeNormals = 1;
+  this->ComputeGradients = 0;
+  this->ComputeScalars = 1;
+  this->ArrayComponent = 0;
+
+  this->ExecuteExtent[0] = this->ExecuteExtent[1]
+    = this->ExecuteExtent[2] = this->ExecuteExtent[3]
+    = this->ExecuteExtent[4] = this->ExecuteExtent[5] = 0;
+
+  // by default process active point scalars
+  this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
+                               vtkDataSetAttributes::SCALARS);
+}
+
+//----------------------------------------------------------------------------
+vtkFlyingEdges3D::~vtkFlyingEdges3D()
+{
+  this->ContourValues->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Overload standard modified time function. If contour values are modified,
+// then this object is modified as well.
+unsigned long vtkFlyingEdges3D::GetMTime()
+{
+  unsigned long mTime=this->Superclass::GetMTime();
+  unsigned long mTime2=this->ContourValues->GetMTime();
+
+  mTime = ( mTime2 > mTime ? mTime2 : mTime );
+  return mTime;
+}
+
+//----------------------------------------------------------------------------
+// The classification of a point of the volume for one contour value.  The
+// output points are owned by the points of the volume: a point that lies
+// exactly on the contour value owns the output point shared by all the
+// edges meeting the contour there, and a point owns the output points of
+// the edges starting from it along x, y and z that meet the contour
+// strictly between their ends.
+enum
+{
+  vtkFlyingEdges3DAbove = 1,   // not below the contour value
+  vtkFlyingEdges3DOnValue = 2, // equal to the contour value
+  vtkFlyingEdges3DOnPoint = 4, // owns an output point on itself
+  vtkFlyingEdges3DOnX = 8,     // owns an output point on its x edge
+  vtkFlyingEdges3DOnY = 16,    // owns an output point on its y edge
+  vtkFlyingEdges3DOnZ = 32     // owns an output point on its z edge
+};
+
+// Return the number of output points owned by a point.
+static inline int vtkFlyingEdges3DNumberOfPoints(unsigned char c)
+{
+  return ((c >> 2) & 1) + ((c >> 3) & 1) + ((c >> 4) & 1) + ((c >> 5) & 1);
+}
+
+// Return 1 if the contour crosses an edge strictly between its ends,
+// given the scalar at its end and whether its origin is below the value.
+static inline int vtkFlyingEdges3DCrosses(double s1, int below, double value)
+{
+  return (s1 < value) != below && s1 != value;
+}
+
+// The twelve edges of a voxel, in the order of the edge offsets of
+// vtkSynchronizedTemplates3D so that its case tables can be used: the
+// axis of the edge, its first corner and its second corner.  Corner
+// di + 2*dj + 4*dk is the point (i+di, j+dj, k+dk) of the voxel (i,j,k);
+// its row is dj + 2*dk.
+static const int vtkFlyingEdges3DEdges[12][3] = {
+  {0, 0, 1}, {1, 0, 2}, {2, 0, 4}, {1, 1, 3}, {2, 1, 5}, {0, 2, 3},
+  {2, 2, 6}, {2, 3, 7}, {0, 4, 5}, {1, 4, 6}, {1, 5, 7}, {0, 6, 7} };
+
+// Return the index of the case of a voxel in the tables of
+// vtkSynchronizedTemplates3D, given the classification of its corners.
+static inline int vtkFlyingEdges3DGetCase(const unsigned char *corners)
+{
+  int idx = (corners[6] & vtkFlyingEdges3DAbove ? 4096 : 0);
+  for (int e = 0; e < 12; e++)
+    {
+    const int *edge = vtkFlyingEdges3DEdges[e];
+    if ((corners[edge[1]] ^ corners[edge[2]]) & vtkFlyingEdges3DAbove)
+      {
+      idx |= (2048 >> e);
+      }
+    }
+  return idx;
+}
+
+// Return the corner of a voxel on which the point of an edge lies, or -1
+// when it lies strictly between the ends of the edge.
+static inline int vtkFlyingEdges3DGetPointCorner(const unsigned char *corners,
+                                                 int e)
+{
+  const int *edge = vtkFlyingEdges3DEdges[e];
+  if (corners[edge[1]] & vtkFlyingEdges3DOnValue)
+    {
+    return edge[1];
+    }
+  if (corners[edge[2]] & vtkFlyingEdges3DOnValue)
+    {
+    return edge[2];
+    }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+// Calculate the gradient using central difference, as
+// vtkSynchronizedTemplates3D does.
+template <class T>
+void vtkFlyingEdges3DComputePointGradient(int i, int j, int k, T *s,
+                                          int *wholeExt, vtkIdType *inc,
+                                          double *spacing, double n[3])
+{
+  int ijk[3] = {i, j, k};
+  for (int axis = 0; axis < 3; axis++)
+    {
+    vtkIdType d = inc[axis];
+    if (ijk[axis] == wholeExt[2*axis])
+      {
+      n[axis] = (*(s+d) - (double)*s) / spacing[axis];
+      }
+    else if (ijk[axis] == wholeExt[2*axis+1])
+      {
+      n[axis] = (*s - (double)*(s-d)) / spacing[axis];
+      }
+    else
+      {
+      n[axis] = 0.5 * (*(s+d) - (double)*(s-d)) / spacing[axis];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// The state shared by the passes contouring the execute extent for one
+// contour value.  The rows of points along x are numbered j + k*ydim;
+// row (j,k) also holds the voxels (i,j,k).
+class vtkFlyingEdges3DAlgorithm
+{
+public:
+  // The contoured extent and its dimensions.
+  int ExExt[6];
+  vtkIdType Dims[3];
+  vtkIdType NumberOfRows;
+  double Value;
+
+  // The classification of the points of the extent, and for each row,
+  // 1 if it has points below the contour value or'ed with 2 if it has
+  // points above.
+  unsigned char *Classes;
+  std::vector<unsigned char> RowSides;
+
+  // The number of points and triangles of each row, then, once summed,
+  // the id of the first point and triangle of each row in the output.
+  // They hold NumberOfRows+1 entries.
+  std::vector<vtkIdType> PointOffsets;
+  std::vector<vtkIdType> CellOffsets;
+
+  // The input.
+  int *InExt;
+  int *WholeExt;
+  vtkIdType Increments[3];
+  vtkIdType PointIncrements[3];
+  double *Origin;
+  double *Spacing;
+  vtkPointData *InPD;
+  vtkCellData *InCD;
+
+  // The output, allocated at its final size.
+  float *Points;
+  float *Normals;
+  float *Gradients;
+  float *Scalars;
+  vtkPointData *OutPD;
+  vtkCellData *OutCD;
+  vtkIdType *Connectivity;
+
+  unsigned char *GetRowClasses(vtkIdType row)
+    {
+    return this->Classes + row*this->Dims[0];
+    }
+
+  // Get the classification of the four rows holding the corners of the
+  // voxels of the row.  Return 0 when no voxel of the row is cut.
+  int GetVoxelRows(vtkIdType row, unsigned char *classes[4],
+                   vtkIdType rows[4])
+    {
+    vtkIdType j = row % this->Dims[1];
+    vtkIdType k = row / this->Dims[1];
+    if (j >= this->Dims[1] - 1 || k >= this->Dims[2] - 1)
+      {
+      return 0;
+      }
+    rows[0] = row;
+    rows[1] = row + 1;
+    rows[2] = row + this->Dims[1];
+    rows[3] = rows[2] + 1;
+    unsigned char sides = 0;
+    for (int r = 0; r < 4; r++)
+      {
+      classes[r] = this->GetRowClasses(rows[r]);
+      sides |= this->RowSides[rows[r]];
+      }
+    return sides == 3;
+    }
+
+  // Get the classification of the corners of voxel i of the row.
+  // Return 0 when the voxel is not cut.
+  static int GetCorners(unsigned char *classes[4], vtkIdType i,
+                        unsigned char corners[8])
+    {
+    unsigned char all = vtkFlyingEdges3DAbove;
+    unsigned char any = 0;
+    for (int r = 0; r < 4; r++)
+      {
+      corners[2*r] = classes[r][i];
+      corners[2*r+1] = classes[r][i+1];
+      all &= corners[2*r] & corners[2*r+1];
+      any |= corners[2*r] | corners[2*r+1];
+      }
+    return (all ^ any) & vtkFlyingEdges3DAbove;
+    }
+
+  // Count the triangles of the voxels of a row.
+  vtkIdType CountTriangles(vtkIdType row)
+    {
+    unsigned char *classes[4];
+    vtkIdType rows[4];
+    if (!this->GetVoxelRows(row, classes, rows))
+      {
+      return 0;
+      }
+    vtkIdType numCells = 0;
+    unsigned char corners[8];
+    for (vtkIdType i = 0; i < this->Dims[0] - 1; i++)
+      {
+      if (!vtkFlyingEdges3DAlgorithm::GetCorners(classes, i, corners))
+        {
+        continue;
+        }
+      int *tablePtr = VTK_SYNCHRONIZED_TEMPLATES_3D_TABLE_2 +
+        VTK_SYNCHRONIZED_TEMPLATES_3D_TABLE_1[
+          vtkFlyingEdges3DGetCase(corners)];
+      // The points of two edges are the same when they lie on the same
+      // corner.
+      for (; *tablePtr != -1; tablePtr += 3)
+        {
+        int keys[3];
+        for (int m = 0; m < 3; m++)
+          {
+          int corner = vtkFlyingEdges3DGetPointCorner(corners, tablePtr[m]);
+          keys[m] = (corner >= 0 ? 12 + corner : tablePtr[m]);
+          }
+        if (keys[0] != keys[1] && keys[0] != keys[2] && keys[1] != keys[2])
+          {
+          numCells++;
+          }
+        }
+      }
+    return numCells;
+    }
+
+  // Write the triangles of the voxels of a row.  The ids of the first
+  // point owned by points i and i+1 of the four rows are updated as the
+  // voxels are visited.
+  void GenerateTriangles(vtkIdType row, vtkIdList *fromIds, vtkIdList *toIds)
+    {
+    vtkIdType cellId = this->CellOffsets[row];
+    vtkIdType numCells = this->CellOffsets[row+1] - cellId;
+    unsigned char *classes[4];
+    vtkIdType rows[4];
+    if (numCells == 0 || !this->GetVoxelRows(row, classes, rows))
+      {
+      return;
+      }
+    vtkIdType firstIds[4][2];
+    int r;
+    for (r = 0; r < 4; r++)
+      {
+      firstIds[r][0] = this->PointOffsets[rows[r]];
+      firstIds[r][1] =
+        firstIds[r][0] + vtkFlyingEdges3DNumberOfPoints(classes[r][0]);
+      }
+
+    vtkIdType j = row % this->Dims[1] + this->ExExt[2] - this->InExt[2];
+    vtkIdType k = row / this->Dims[1] + this->ExExt[4] - this->InExt[4];
+    vtkIdType inCellId = (this->ExExt[0] - this->InExt[0]) +
+      (this->InExt[1] - this->InExt[0]) *
+      (j + k*(this->InExt[3] - this->InExt[2]));
+    fromIds->SetNumberOfIds(numCells);
+    toIds->SetNumberOfIds(numCells);
+    vtkIdType *outPts = this->Connectivity + 4*cellId;
+    vtkIdType numCellsDone = 0;
+    unsigned char corners[8];
+    for (vtkIdType i = 0; i < this->Dims[0] - 1; i++, inCellId++)
+      {
+      if (vtkFlyingEdges3DAlgorithm::GetCorners(classes, i, corners))
+        {
+        int *tablePtr = VTK_SYNCHRONIZED_TEMPLATES_3D_TABLE_2 +
+          VTK_SYNCHRONIZED_TEMPLATES_3D_TABLE_1[
+            vtkFlyingEdges3DGetCase(corners)];
+        for (; *tablePtr != -1; tablePtr += 3)
+          {
+          vtkIdType ptIds[3];
+          for (int m = 0; m < 3; m++)
+            {
+            int e = tablePtr[m];
+            int corner = vtkFlyingEdges3DGetPointCorner(corners, e);
+            if (corner >= 0)
+              {
+              ptIds[m] = firstIds[corner >> 1][corner & 1];
+              }
+            else
+              {
+              // The point of the edge follows the points owned by its
+              // first corner on the axes before its own.
+              int axis = vtkFlyingEdges3DEdges[e][0];
+              corner = vtkFlyingEdges3DEdges[e][1];
+              unsigned char before = corners[corner] &
+                ((vtkFlyingEdges3DOnX << axis) - vtkFlyingEdges3DOnPoint);
+              ptIds[m] = firstIds[corner >> 1][corner & 1] +
+                vtkFlyingEdges3DNumberOfPoints(before);
+              }
+            }
+          if (ptIds[0] != ptIds[1] &&
+              ptIds[0] != ptIds[2] &&
+              ptIds[1] != ptIds[2])
+            {
+            outPts[0] = 3;
+            outPts[1] = ptIds[0];
+            outPts[2] = ptIds[1];
+            outPts[3] = ptIds[2];
+            outPts += 4;
+            fromIds->SetId(numCellsDone, inCellId);
+            toIds->SetId(numCellsDone, cellId + numCellsDone);
+            numCellsDone++;
+            }
+          }
+        }
+      // Move to the next voxel.
+      if (i + 2 < this->Dims[0])
+        {
+        for (r = 0; r < 4; r++)
+          {
+          firstIds[r][0] = firstIds[r][1];
+          firstIds[r][1] += vtkFlyingEdges3DNumberOfPoints(classes[r][i+1]);
+          }
+        }
+      }
+    this->OutCD->CopyData(this->InCD, fromIds, toIds);
+    }
+};
+
+//----------------------------------------------------------------------------
+// First pass: classify the points of the rows and count the output
+// points they own.
+template <class T>
+class vtkFlyingEdges3DClassifyPoints
+{
+public:
+  vtkFlyingEdges3DAlgorithm *Algorithm;
+  T *Scalars;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkFlyingEdges3DAlgorithm *a = this->Algorithm;
+    double value = a->Value;
+    vtkIdType xdim = a->Dims[0];
+    vtkIdType ydim = a->Dims[1];
+    vtkIdType zdim = a->Dims[2];
+    vtkIdType xInc = a->Increments[0];
+    vtkIdType yInc = a->Increments[1];
+    vtkIdType zInc = a->Increments[2];
+    for (vtkIdType row = begin; row < end; row++)
+      {
+      vtkIdType j = row % ydim;
+      vtkIdType k = row / ydim;
+      T *s = this->Scalars + j*yInc + k*zInc;
+      unsigned char *classes = a->GetRowClasses(row);
+      unsigned char sides = 0;
+      vtkIdType numPts = 0;
+      for (vtkIdType i = 0; i < xdim; i++, s += xInc)
+        {
+        double s0 = *s;
+        unsigned char c;
+        if (s0 < value)
+          {
+          sides |= 1;
+          c = 0;
+          }
+        else
+          {
+          sides |= 2;
+          c = vtkFlyingEdges3DAbove;
+          }
+        if (s0 == value)
+          {
+          // The point is shared by the edges crossing the contour there:
+          // those going to a point below the contour value.
+          c |= vtkFlyingEdges3DOnValue;
+          if ((i > 0 && *(s-xInc) < value) ||
+              (i < xdim-1 && *(s+xInc) < value) ||
+              (j > 0 && *(s-yInc) < value) ||
+              (j < ydim-1 && *(s+yInc) < value) ||
+              (k > 0 && *(s-zInc) < value) ||
+              (k < zdim-1 && *(s+zInc) < value))
+            {
+            c |= vtkFlyingEdges3DOnPoint;
+            }
+          }
+        else
+          {
+          // An edge has a point of its own when the contour crosses it
+          // strictly between its ends.
+          int below = (s0 < value);
+          if (i < xdim-1 && vtkFlyingEdges3DCrosses(*(s+xInc), below, value))
+            {
+            c |= vtkFlyingEdges3DOnX;
+            }
+          if (j < ydim-1 && vtkFlyingEdges3DCrosses(*(s+yInc), below, value))
+            {
+            c |= vtkFlyingEdges3DOnY;
+            }
+          if (k < zdim-1 && vtkFlyingEdges3DCrosses(*(s+zInc), below, value))
+            {
+            c |= vtkFlyingEdges3DOnZ;
+            }
+          }
+        classes[i] = c;
+        numPts += vtkFlyingEdges3DNumberOfPoints(c);
+        }
+      a->RowSides[row] = sides;
+      a->PointOffsets[row] = numPts;
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Second pass: count the triangles of the rows.
+class vtkFlyingEdges3DCountTriangles
+{
+public:
+  vtkFlyingEdges3DAlgorithm *Algorithm;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType row = begin; row < end; row++)
+      {
+      this->Algorithm->CellOffsets[row] =
+        this->Algorithm->CountTriangles(row);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Last pass: write the points, their attributes and the triangles of the
+// rows at their place in the output.
+template <class T>
+class vtkFlyingEdges3DGenerate
+{
+public:
+  vtkFlyingEdges3DAlgorithm *Algorithm;
+  T *Scalars;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList *fromIds = vtkIdList::New();
+    vtkIdList *toIds = vtkIdList::New();
+    for (vtkIdType row = begin; row < end; row++)
+      {
+      this->GeneratePoints(row);
+      this->Algorithm->GenerateTriangles(row, fromIds, toIds);
+      }
+    fromIds->Delete();
+    toIds->Delete();
+    }
+
+  // Write an output point and its normal, gradient and scalar.
+  void SetPoint(vtkIdType id, double x0, double x1, double x2, double n[3])
+    {
+    vtkFlyingEdges3DAlgorithm *a = this->Algorithm;
+    float *x = a->Points + 3*id;
+    x[0] = static_cast<float>(x0);
+    x[1] = static_cast<float>(x1);
+    x[2] = static_cast<float>(x2);
+    if (a->Gradients)
+      {
+      float *g = a->Gradients + 3*id;
+      g[0] = static_cast<float>(n[0]);
+      g[1] = static_cast<float>(n[1]);
+      g[2] = static_cast<float>(n[2]);
+      }
+    if (a->Normals)
+      {
+      vtkMath::Normalize(n);
+      float *normal = a->Normals + 3*id;
+      normal[0] = static_cast<float>(-n[0]);
+      normal[1] = static_cast<float>(-n[1]);
+      normal[2] = static_cast<float>(-n[2]);
+      }
+    if (a->Scalars)
+      {
+      a->Scalars[id] = static_cast<float>(a->Value);
+      }
+    }
+
+  void GeneratePoints(vtkIdType row)
+    {
+    vtkFlyingEdges3DAlgorithm *a = this->Algorithm;
+    vtkIdType id = a->PointOffsets[row];
+    vtkIdType numPts = a->PointOffsets[row+1] - id;
+    if (numPts == 0)
+      {
+      return;
+      }
+    int needGradients = (a->Gradients || a->Normals);
+    double value = a->Value;
+    double *origin = a->Origin;
+    double *spacing = a->Spacing;
+    vtkIdType *inc = a->Increments;
+    int j = static_cast<int>(row % a->Dims[1]) + a->ExExt[2];
+    int k = static_cast<int>(row / a->Dims[1]) + a->ExExt[4];
+    double y = origin[1] + spacing[1]*j;
+    double z = origin[2] + spacing[2]*k;
+    T *s = this->Scalars + (j - a->ExExt[2])*inc[1] + (k - a->ExExt[4])*inc[2];
+    vtkIdType inPtId = (a->ExExt[0] - a->InExt[0]) +
+      (j - a->InExt[2])*a->PointIncrements[1] +
+      (k - a->InExt[4])*a->PointIncrements[2];
+    unsigned char *classes = a->GetRowClasses(row);
+
+    // The attributes of a point are interpolated from one or two input
+    // points.
+    std::vector<vtkIdType> offsets(numPts+1);
+    std::vector<vtkIdType> ids(2*numPts);
+    std::vector<double> weights(2*numPts);
+    vtkIdType numPtsDone = 0;
+    vtkIdType numWeights = 0;
+    double n[3], n0[3], n1[3];
+    n0[0] = n0[1] = n0[2] = 0.0;
+    n[0] = n[1] = n[2] = 0.0;
+
+    for (int i = a->ExExt[0]; numPtsDone < numPts;
+         i++, s += inc[0], inPtId++, classes++)
+      {
+      unsigned char c = *classes;
+      if (!(c & (vtkFlyingEdges3DOnPoint | vtkFlyingEdges3DOnX |
+                 vtkFlyingEdges3DOnY | vtkFlyingEdges3DOnZ)))
+        {
+        continue;
+        }
+      double x = origin[0] + spacing[0]*i;
+      if (needGradients)
+        {
+        vtkFlyingEdges3DComputePointGradient(i, j, k, s, a->WholeExt, inc,
+                                             spacing, n0);
+        }
+      if (c & vtkFlyingEdges3DOnPoint)
+        {
+        n[0] = n0[0]; n[1] = n0[1]; n[2] = n0[2];
+        this->SetPoint(id + numPtsDone, x, y, z, n);
+        offsets[numPtsDone++] = numWeights;
+        ids[numWeights] = inPtId;
+        weights[numWeights++] = 1.0;
+        continue;
+        }
+      int ijk[3] = {i, j, k};
+      for (int axis = 0; axis < 3; axis++)
+        {
+        if (!(c & (vtkFlyingEdges3DOnX << axis)))
+          {
+          continue;
+          }
+        T *s1 = s + inc[axis];
+        double t = (value - (double)(*s)) / ((double)(*s1) - (double)(*s));
+        if (needGradients)
+          {
+          ijk[axis]++;
+          vtkFlyingEdges3DComputePointGradient(ijk[0], ijk[1], ijk[2], s1,
+                                               a->WholeExt, inc, spacing, n1);
+          ijk[axis]--;
+          for (int jj = 0; jj < 3; jj++)
+            {
+            n[jj] = n0[jj] + t * (n1[jj] - n0[jj]);
+            }
+          }
+        if (axis == 0)
+          {
+          this->SetPoint(id + numPtsDone, origin[0] + spacing[0]*(i+t), y, z,
+                         n);
+          }
+        else if (axis == 1)
+          {
+          this->SetPoint(id + numPtsDone, x, y + spacing[1]*t, z, n);
+          }
+        else
+          {
+          this->SetPoint(id + numPtsDone, x, y, z + spacing[2]*t, n);
+          }
+        offsets[numPtsDone++] = numWeights;
+        ids[numWeights] = inPtId;
+        weights[numWeights++] = 1.0 - t;
+        ids[numWeights] = inPtId + a->PointIncrements[axis];
+        weights[numWeights++] = t;
+        }
+      }
+    offsets[numPts] = numWeights;
+    a->OutPD->InterpolatePoints(a->InPD, id, numPts, &offsets[0], &ids[0],
+                                &weights[0]);
+    }
+};
+
+//----------------------------------------------------------------------------
+// Resize an output array to n tuples, keeping its values.
+static void vtkFlyingEdges3DResize(vtkAbstractArray *array, vtkIdType n)
+{
+  array->Resize(n);
+  array->SetNumberOfTuples(n);
+}
+
+//----------------------------------------------------------------------------
+// Contour the execute extent of the image for each contour value in turn.
+template <class T>
+void vtkFlyingEdges3DContour(vtkFlyingEdges3D *self, int *exExt,
+                             vtkInformation *inInfo, vtkImageData *data,
+                             vtkPolyData *output, T *ptr,
+                             vtkDataArray *inScalars)
+{
+  double *values = self->GetValues();
+  int numContours = self->GetNumberOfContours();
+  int *inExt = data->GetExtent();
+  vtkIdType numComps = inScalars->GetNumberOfComponents();
+  int i;
+
+  vtkFlyingEdges3DAlgorithm algo;
+  for (i = 0; i < 3; i++)
+    {
+    algo.ExExt[2*i] = exExt[2*i];
+    algo.ExExt[2*i+1] = exExt[2*i+1];
+    algo.Dims[i] = exExt[2*i+1] - exExt[2*i] + 1;
+    }
+  algo.NumberOfRows = algo.Dims[1]*algo.Dims[2];
+  algo.InExt = inExt;
+  algo.WholeExt =
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+  algo.PointIncrements[0] = 1;
+  algo.PointIncrements[1] = inExt[1] - inExt[0] + 1;
+  algo.PointIncrements[2] = algo.PointIncrements[1]*(inExt[3] - inExt[2] + 1);
+  for (i = 0; i < 3; i++)
+    {
+    algo.Increments[i] = numComps*algo.PointIncrements[i];
+    }
+  algo.Origin = data->GetOrigin();
+  algo.Spacing = data->GetSpacing();
+  algo.InPD = data->GetPointData();
+  algo.InCD = data->GetCellData();
+  algo.OutPD = output->GetPointData();
+  algo.OutCD = output->GetCellData();
+  algo.RowSides.resize(algo.NumberOfRows);
+  algo.PointOffsets.resize(algo.NumberOfRows + 1);
+  algo.CellOffsets.resize(algo.NumberOfRows + 1);
+  algo.Classes = new unsigned char[algo.NumberOfRows*algo.Dims[0]];
+  ptr += self->GetArrayComponent();
+
+  // The output grows after each contour value.
+  vtkPoints *newPts = vtkPoints::New();
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  vtkFloatArray *newScalars = NULL;
+  vtkFloatArray *newNormals = NULL;
+  vtkFloatArray *newGradients = NULL;
+  if (self->GetComputeScalars())
+    {
+    newScalars = vtkFloatArray::New();
+    newScalars->SetName(inScalars->GetName());
+    }
+  if (self->GetComputeNormals())
+    {
+    newNormals = vtkFloatArray::New();
+    newNormals->SetNumberOfComponents(3);
+    newNormals->SetName("Normals");
+    }
+  if (self->GetComputeGradients())
+    {
+    newGradients = vtkFloatArray::New();
+    newGradients->SetNumberOfComponents(3);
+    newGradients->SetName("Gradients");
+    }
+  // It is more efficient to just create the scalar array
+  // rather than redundantly interpolate the scalars.
+  algo.OutPD->CopyAllOn();
+  if (algo.InPD->GetScalars() == inScalars)
+    {
+    algo.OutPD->CopyScalarsOff();
+    }
+  else
+    {
+    algo.OutPD->CopyFieldOff(inScalars->GetName());
+    }
+  algo.OutPD->InterpolateAllocate(algo.InPD, 0);
+  algo.OutCD->CopyAllocate(algo.InCD, 0);
+
+  // The attributes are interpolated from the threads only if all the
+  // input arrays can be read concurrently.
+  int parallel = vtkSynchronizedTemplatesSlabs::CanContourInParallel(data);
+
+  vtkFlyingEdges3DClassifyPoints<T> classify;
+  classify.Algorithm = &algo;
+  classify.Scalars = ptr;
+  vtkFlyingEdges3DCountTriangles count;
+  count.Algorithm = &algo;
+  vtkFlyingEdges3DGenerate<T> generate;
+  generate.Algorithm = &algo;
+  generate.Scalars = ptr;
+
+  vtkIdType numPts = 0;
+  vtkIdType numCells = 0;
+  for (int vidx = 0; vidx < numContours && !self->GetAbortExecute(); vidx++)
+    {
+    algo.Value = values[vidx];
+    self->UpdateProgress((double)vidx/numContours);
+    vtkSMPTools::For(0, algo.NumberOfRows, classify);
+    self->UpdateProgress((vidx + 0.4)/numContours);
+    vtkSMPTools::For(0, algo.NumberOfRows, count);
+    self->UpdateProgress((vidx + 0.5)/numContours);
+
+    // Number the points and triangles of the rows in order.
+    vtkIdType row;
+    for (row = 0; row < algo.NumberOfRows; row++)
+      {
+      vtkIdType rowPts = algo.PointOffsets[row];
+      vtkIdType rowCells = algo.CellOffsets[row];
+      algo.PointOffsets[row] = numPts;
+      algo.CellOffsets[row] = numCells;
+      numPts += rowPts;
+      numCells += rowCells;
+      }
+    algo.PointOffsets[row] = numPts;
+    algo.CellOffsets[row] = numCells;
+
+    vtkFlyingEdges3DResize(newPts->GetData(), numPts);
+    vtkFlyingEdges3DResize(connectivity, 4*numCells);
+    for (i = 0; i < algo.OutPD->GetNumberOfArrays(); i++)
+      {
+      vtkFlyingEdges3DResize(algo.OutPD->GetAbstractArray(i), numPts);
+      }
+    for (i = 0; i < algo.OutCD->GetNumberOfArrays(); i++)
+      {
+      vtkFlyingEdges3DResize(algo.OutCD->GetAbstractArray(i), numCells);
+      }
+    algo.Points = static_cast<float*>(newPts->GetVoidPointer(0));
+    algo.Connectivity = connectivity->GetPointer(0);
+    algo.Scalars = algo.Normals = algo.Gradients = NULL;
+    if (newScalars)
+      {
+      vtkFlyingEdges3DResize(newScalars, numPts);
+      algo.Scalars = newScalars->GetPointer(0);
+      }
+    if (newNormals)
+      {
+      vtkFlyingEdges3DResize(newNormals, numPts);
+      algo.Normals = newNormals->GetPointer(0);
+      }
+    if (newGradients)
+      {
+      vtkFlyingEdges3DResize(newGradients, numPts);
+      algo.Gradients = newGradients->GetPointer(0);
+      }
+
+    if (parallel)
+      {
+      vtkSMPTools::For(0, algo.NumberOfRows, generate);
+      }
+    else
+      {
+      generate(0, algo.NumberOfRows);
+      }
+    }
+  delete [] algo.Classes;
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  vtkCellArray *newPolys = vtkCellArray::New();
+  newPolys->SetCells(numCells, connectivity);
+  connectivity->Delete();
+  output->SetPolys(newPolys);
+  newPolys->Delete();
+
+  if (newScalars)
+    {
+    int idx = output->GetPointData()->AddArray(newScalars);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    newScalars->Delete();
+    }
+  if (newGradients)
+    {
+    int idx = output->GetPointData()->AddArray(newGradients);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::VECTORS);
+    newGradients->Delete();
+    }
+  if (newNormals)
+    {
+    output->GetPointData()->SetNormals(newNormals);
+    newNormals->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkFlyingEdges3D::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info objects
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkImageData *input = vtkImageData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData *output = vtkPolyData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  // to be safe recompute the execute extent
+  this->RequestUpdateExtent(request,inputVector,outputVector);
+  int *exExt = this->ExecuteExtent;
+
+  vtkDebugMacro(<< "Executing 3D flying edges");
+
+  if ( exExt[0] >= exExt[1] || exExt[2] >= exExt[3] || exExt[4] >= exExt[5] )
+    {
+    vtkDebugMacro(<<"3D structured contours requires 3D data");
+    return 1;
+    }
+
+  vtkDataArray *inScalars = this->GetInputArrayToProcess(0,inputVector);
+  if (inScalars == NULL)
+    {
+    vtkDebugMacro("No scalars for contouring.");
+    return 1;
+    }
+  int numComps = inScalars->GetNumberOfComponents();
+  if (this->ArrayComponent >= numComps)
+    {
+    vtkErrorMacro("Scalars have " << numComps << " components. "
+                  "ArrayComponent must be smaller than " << numComps);
+    return 1;
+    }
+
+  void *ptr = input->GetArrayPointerForExtent(inScalars, exExt);
+  switch (inScalars->GetDataType())
+    {
+    vtkTemplateMacro(
+      vtkFlyingEdges3DContour(this, exExt, inInfo, input, output,
+                              static_cast<VTK_TT *>(ptr), inScalars));
+    }
+
+  output->Squeeze();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkFlyingEdges3D::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info objects
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  int piece, numPieces, ghostLevels;
+  int *wholeExt;
+  int ext[6];
+
+  vtkExtentTranslator *translator = vtkExtentTranslator::SafeDownCast(
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::EXTENT_TRANSLATOR()));
+  wholeExt =
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+
+  // Get request from output
+  piece =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  numPieces =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  ghostLevels =
+    outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+
+  // Start with the whole grid.
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext);
+
+  // get the extent associated with the piece.
+  if (translator == NULL)
+    {
+    // Default behavior
+    if (piece != 0)
+      {
+      ext[0] = ext[2] = ext[4] = 0;
+      ext[1] = ext[3] = ext[5] = -1;
+      }
+    }
+  else
+    {
+    translator->PieceToExtentThreadSafe(piece, numPieces, ghostLevels,
+                                        wholeExt, ext,
+                                        translator->GetSplitMode(),0);
+    }
+
+  // As a side product of this call, ExecuteExtent is set.  The input
+  // extent is grown by one point to compute the gradients.
+  int i;
+  for (i = 0; i < 6; i++)
+    {
+    this->ExecuteExtent[i] = ext[i];
+    }
+  if (this->ComputeGradients || this->ComputeNormals)
+    {
+    for (i = 0; i < 3; i++)
+      {
+      ext[2*i] = (ext[2*i] > wholeExt[2*i] ? ext[2*i] - 1 : wholeExt[2*i]);
+      ext[2*i+1] =
+        (ext[2*i+1] < wholeExt[2*i+1] ? ext[2*i+1] + 1 : wholeExt[2*i+1]);
+      }
+    }
+
+  // Set the update extent of the input.
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), ext, 6);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkFlyingEdges3D::FillInputPortInformation(int, vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkFlyingEdges3D::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  this->ContourValues->PrintSelf(os,indent.GetNextIndent());
+
+  os << indent << "Compute Normals: " << (this->ComputeNormals ? "On\n" : "Off\n");
+  os << indent << "Compute Gradients: " << (this->ComputeGradients ? "On\n" : "Off\n");
+  os << indent << "Compute Scalars: " << (this->ComputeScalars ? "On\n" : "Off\n");
+  os << indent << "ArrayComponent: " << this->ArrayComponent << endl;
+}
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFlyingEdges3D.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkFlyingEdges3D - generate isosurface from 3D image data in data-parallel passes
+// .SECTION Description
+// vtkFlyingEdges3D extracts the same isosurface as
+// vtkSynchronizedTemplates3D, but instead of creating the points and
+// triangles as it sweeps the volume, it first sizes the output and then
+// fills it in place, so that every pass processes the rows of points
+// along x independently of each other with vtkSMPTools:
+//
+// 1. Each point is classified against the contour value, and the points
+// generated by each row (on its x, y and z edges, or on the point
+// itself when it lies exactly on the contour value) are counted.
+// 2. The triangles generated by each row of voxels are counted from the
+// classification, with the case tables of vtkSynchronizedTemplates3D.
+// 3. Prefix sums of the counts give the first point and the first
+// triangle of each row, and the output is allocated at its final size.
+// 4. Each row writes its points, their attributes, and its triangles.
+// The ids of the points of the edges of a voxel are computed from the
+// classification of the four rows it touches, so no point locator or
+// edge cache shared between rows is needed.
+//
+// The triangles are those of vtkSynchronizedTemplates3D, in the same
+// order, and they share the points the same way: all the edges meeting
+// at a point that lies exactly on the contour value share one output
+// point and the triangles that become degenerate are dropped.  Only the
+// numbering of the points differs.  The output does not depend on the
+// number of threads.
+
+// .SECTION Caveats
+// This filter is specialized to 3D images.  It keeps one byte per point
+// of the volume while it executes.  The attributes of the points are
+// interpolated from the threads, so the input arrays must be numeric
+// arrays of the standard memory layout for the last pass to run in
+// parallel; it runs serially otherwise.
+
+// .SECTION See Also
+// vtkSynchronizedTemplates3D vtkContourFilter vtkMarchingCubes
+
+#ifndef __vtkFlyingEdges3D_h
+#define __vtkFlyingEdges3D_h
+
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkContourValues.h" // Passes calls through
+
+class vtkImageData;
+
+class VTK_GRAPHICS_EXPORT vtkFlyingEdges3D : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkFlyingEdges3D *New();
+  vtkTypeMacro(vtkFlyingEdges3D,vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Because we delegate to vtkContourValues
+  unsigned long int GetMTime();
+
+  // Description:
+  // Set/Get the computation of normals. Normal computation is fairly
+  // expensive in both time and storage. If the output data will be
+  // processed by filters that modify topology or geometry, it may be
+  // wise to turn Normals and Gradients off.
+  vtkSetMacro(ComputeNormals,int);
+  vtkGetMacro(ComputeNormals,int);
+  vtkBooleanMacro(ComputeNormals,int);
+
+  // Description:
+  // Set/Get the computation of gradients. Gradient computation is
+  // fairly expensive in both time and storage. Note that if
+  // ComputeNormals is on, gradients will have to be calculated, but
+  // will not be stored in the output dataset.
+  vtkSetMacro(ComputeGradients,int);
+  vtkGetMacro(ComputeGradients,int);
+  vtkBooleanMacro(ComputeGradients,int);
+
+  // Description:
+  // Set/Get the computation of scalars.
+  vtkSetMacro(ComputeScalars,int);
+  vtkGetMacro(ComputeScalars,int);
+  vtkBooleanMacro(ComputeScalars,int);
+
+  // Description:
+  // Set/get which component of the scalar array to contour on; defaults to 0.
+  vtkSetMacro(ArrayComponent, int);
+  vtkGetMacro(ArrayComponent, int);
+
+  // Description:
+  // Set a particular contour value at contour number i. The index i ranges
+  // between 0<=i<NumberOfContours.
+  void SetValue(int i, double value) {this->ContourValues->SetValue(i,value);}
+
+  // Description:
+  // Get the ith contour value.
+  double GetValue(int i) {return this->ContourValues->GetValue(i);}
+
+  // Description:
+  // Get a pointer to an array of contour values. There will be
+  // GetNumberOfContours() values in the list.
+  double *GetValues() {return this->ContourValues->GetValues();}
+
+  // Description:
+  // Fill a supplied list with contour values. There will be
+  // GetNumberOfContours() values in the list. Make sure you allocate
+  // enough memory to hold the list.
+  void GetValues(double *contourValues) {
+    this->ContourValues->GetValues(contourValues);}
+
+  // Description:
+  // Set the number of contours to place into the list. You only really
+  // need to use this method to reduce list size. The method SetValue()
+  // will automatically increase list size as needed.
+  void SetNumberOfContours(int number) {
+    this->ContourValues->SetNumberOfContours(number);}
+
+  // Description:
+  // Get the number of contours in the list of contour values.
+  int GetNumberOfContours() {
+    return this->ContourValues->GetNumberOfContours();}
+
+  // Description:
+  // Generate numContours equally spaced contour values between specified
+  // range. Contour values will include min/max range values.
+  void GenerateValues(int numContours, double range[2]) {
+    this->ContourValues->GenerateValues(numContours, range);}
+
+  // Description:
+  // Generate numContours equally spaced contour values between specified
+  // range. Contour values will include min/max range values.
+  void GenerateValues(int numContours, double rangeStart, double rangeEnd)
+    {this->ContourValues->GenerateValues(numContours, rangeStart, rangeEnd);}
+
+protected:
+  vtkFlyingEdges3D();
+  ~vtkFlyingEdges3D();
+
+  virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+  virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
+  virtual int FillInputPortInformation(int port, vtkInformation *info);
+
+  int ComputeNormals;
+  int ComputeGradients;
+  int ComputeScalars;
+  int ArrayComponent;
+  vtkContourValues *ContourValues;
+
+  // The extent contoured, without the layer of points added to the
+  // input extent to compute the gradients.
+  int ExecuteExtent[6];
+
+private:
+  vtkFlyingEdges3D(const vtkFlyingEdges3D&);  // Not implemented.
+  void operator=(const vtkFlyingEdges3D&);  // Not implemented.
+};
+
+#endif
@@ -29,6 +29,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -61,6 +63,8 @@ vtkGridSynchronizedTemplates3D::vtkGridSynchronizedTemplates3D()
   this->MinimumPieceSize[1] = 10;
   this->MinimumPieceSize[2] = 10;
 
+  this->EnableSMP = 1;
+
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
                                vtkDataSetAttributes::SCALARS);
@@ -335,11 +339,13 @@ if (ComputeScalars) \
 } 
 
 //----------------------------------------------------------------------------
-// Contouring filter specialized for structured grids
+// Contouring filter specialized for structured grids.  When slabs is not
+// NULL, only the given slab of exExt is contoured.
 template <class T, class PointsType>
 void ContourGrid(vtkGridSynchronizedTemplates3D *self,
                  int *exExt, T *scalars,
-                 vtkStructuredGrid *input, vtkPolyData *output, PointsType*, vtkDataArray *inScalars)
+                 vtkStructuredGrid *input, vtkPolyData *output, PointsType*, vtkDataArray *inScalars,
+                 vtkSynchronizedTemplatesSlabs *slabs, int slab)
 {
   int *inExt = input->GetExtent();
   int xdim = exExt[1] - exExt[0] + 1;
@@ -386,6 +392,11 @@ void ContourGrid(vtkGridSynchronizedTemplates3D *self,
   vtkFloatArray *newScalars = NULL;
   vtkFloatArray *newNormals = NULL;
   vtkFloatArray *newGradients = NULL;
+  int ext[6] = {exExt[0], exExt[1], exExt[2], exExt[3], exExt[4], exExt[5]};
+  if (slabs)
+    {
+    slabs->GetSlabZRange(slab, ext[4], ext[5]);
+    }
 
   if (ComputeScalars)
     {
@@ -399,18 +410,18 @@ void ContourGrid(vtkGridSynchronizedTemplates3D *self,
     {
     newGradients = vtkFloatArray::New();
     }
-  vtkGridSynchronizedTemplates3DInitializeOutput(exExt, input, output, 
+  vtkGridSynchronizedTemplates3DInitializeOutput(ext, input, output, 
                                                  newScalars, newNormals, newGradients, inScalars);
   newPts = output->GetPoints();
   newPolys = output->GetPolys();
 
   // this is an exploded execute extent.
-  XMin = exExt[0];
-  XMax = exExt[1];
-  YMin = exExt[2];
-  YMax = exExt[3];
-  ZMin = exExt[4];
-  ZMax = exExt[5];
+  XMin = ext[0];
+  XMax = ext[1];
+  YMin = ext[2];
+  YMax = ext[3];
+  ZMin = ext[4];
+  ZMax = ext[5];
   // to skip over an x row of the input.
   incY = inExt[1]-inExt[0]+1;
   // to skip over an xy slice of the input.
@@ -464,10 +475,21 @@ void ContourGrid(vtkGridSynchronizedTemplates3D *self,
                         (XMin - inExt[0]));
     s2 = inPtrZ;
     v2 = (*s2 < value ? 0 : 1);
+    if (slabs)
+      {
+      slabs->BeginContour(slab, vidx);
+      }
 
     //==================================================================
     for (k = ZMin; k <= ZMax; k++)
       {
+      if (slabs && vtkSMPThreadPool::GetThreadIndex() == 0)
+        {
+        // Only the calling thread may invoke the observers.
+        self->UpdateProgress((slab + static_cast<double>(vidx)/numContours +
+                              (k-ZMin)/((ZMax - ZMin+1.0)*numContours)) /
+                             slabs->GetNumberOfSlabs());
+        }
       // swap the buffers
       if (k%2)
         {
@@ -607,7 +629,9 @@ void ContourGrid(vtkGridSynchronizedTemplates3D *self,
                 }
               }
             }
-          if (k < ZMax)
+          // The edges along z of the top plane of a slab are
+          // intersected by the slab.
+          if (k < exExt[5])
             {
             p3 = (inPtPtrX + incZ*3);
             s3 = (inPtrX + incZ);
@@ -705,10 +729,18 @@ void ContourGrid(vtkGridSynchronizedTemplates3D *self,
         inPtPtrY += 3*incY;
         inPtrY += incY;
         }
+      if (slabs)
+        {
+        slabs->EndPlane(slab, vidx, k, isect2Ptr - xdim*ydim*3);
+        }
       inPtPtrZ += 3*incZ;
       inPtrZ += incZ;
       }
     }
+  if (slabs)
+    {
+    slabs->EndSlab(slab);
+    }
 
   if (newScalars)
     {
@@ -737,13 +769,84 @@ void ContourGrid(vtkGridSynchronizedTemplates3D *self,
 template <class T>
 void ContourGrid(vtkGridSynchronizedTemplates3D *self,
                  int *exExt, T *scalars, vtkStructuredGrid *input,
-                 vtkPolyData *output, vtkDataArray *inScalars)
+                 vtkPolyData *output, vtkDataArray *inScalars,
+                 vtkSynchronizedTemplatesSlabs *slabs = NULL, int slab = 0)
 {
   switch(input->GetPoints()->GetData()->GetDataType())
     {
     vtkTemplateMacro(
-                     ContourGrid(self, exExt, scalars, input, output,static_cast<VTK_TT *>(0), inScalars));
+                     ContourGrid(self, exExt, scalars, input, output,static_cast<VTK_TT *>(0), inScalars,
+                                 slabs, slab));
+    }
+}
+
+//----------------------------------------------------------------------------
+// vtkSMPTools functor contouring slabs of the execute extent.
+class vtkGridSynchronizedTemplates3DSlabFunctor
+{
+public:
+  vtkGridSynchronizedTemplates3D *Self;
+  int *ExExt;
+  void *Scalars;
+  int ScalarType;
+  vtkStructuredGrid *Input;
+  vtkDataArray *InScalars;
+  vtkSynchronizedTemplatesSlabs *Slabs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType slab = begin; slab < end; slab++)
+      {
+      vtkPolyData *output =
+        this->Slabs->GetSlabOutput(static_cast<int>(slab));
+      switch (this->ScalarType)
+        {
+        vtkTemplateMacro(
+          ContourGrid(this->Self, this->ExExt,
+                      static_cast<VTK_TT *>(this->Scalars), this->Input,
+                      output, this->InScalars, this->Slabs,
+                      static_cast<int>(slab)));
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Contour the execute extent in slabs when that is possible.  Return 0
+// if the extent must be contoured serially.
+static int vtkGridSynchronizedTemplates3DContourSlabs(
+  vtkGridSynchronizedTemplates3D *self, int *exExt, void *scalars,
+  int scalarType, vtkStructuredGrid *input, vtkPolyData *output,
+  vtkDataArray *inScalars)
+{
+  if (!self->GetEnableSMP() ||
+      !vtkSynchronizedTemplatesSlabs::CanContourInParallel(input))
+    {
+    return 0;
+    }
+  int numberOfSlabs =
+    vtkSynchronizedTemplatesSlabs::ComputeNumberOfSlabs(exExt);
+  if (numberOfSlabs < 2)
+    {
+    return 0;
     }
+
+  vtkSynchronizedTemplatesSlabs slabs(exExt, self->GetNumberOfContours(),
+                                      numberOfSlabs);
+  vtkGridSynchronizedTemplates3DSlabFunctor functor;
+  functor.Self = self;
+  functor.ExExt = exExt;
+  functor.Scalars = scalars;
+  functor.ScalarType = scalarType;
+  functor.Input = input;
+  functor.InScalars = inScalars;
+  functor.Slabs = &slabs;
+  vtkSMPTools::For(0, slabs.GetNumberOfSlabs(), 1, functor);
+  if (!slabs.Merge(output))
+    {
+    vtkErrorWithObjectMacro(self, "The planes shared by the slabs do not match.");
+    }
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -784,11 +887,16 @@ void vtkGridSynchronizedTemplates3D::ThreadedExecute(int *exExt, int ,
   if (inScalars->GetNumberOfComponents() == 1 )
     {
     void *scalars = inScalars->GetVoidPointer(0);
-    switch (inScalars->GetDataType())
+    if (!vtkGridSynchronizedTemplates3DContourSlabs(
+          this, exExt, scalars, inScalars->GetDataType(), input, output,
+          inScalars))
       {
-      vtkTemplateMacro(
-                       ContourGrid(this, exExt, static_cast<VTK_TT *>(scalars), input, output, inScalars));
-      }//switch
+      switch (inScalars->GetDataType())
+        {
+        vtkTemplateMacro(
+                         ContourGrid(this, exExt, static_cast<VTK_TT *>(scalars), input, output, inScalars));
+        }//switch
+      }
     }
   else //multiple components - have to convert
     {
@@ -797,7 +905,11 @@ void vtkGridSynchronizedTemplates3D::ThreadedExecute(int *exExt, int ,
     image->Allocate(dataSize*image->GetNumberOfComponents());
     inScalars->GetTuples(0,dataSize,image);
     double *scalars = image->GetPointer(0);
-    ContourGrid(this, exExt, scalars, input, output, inScalars);
+    if (!vtkGridSynchronizedTemplates3DContourSlabs(
+          this, exExt, scalars, VTK_DOUBLE, input, output, inScalars))
+      {
+      ContourGrid(this, exExt, scalars, input, output, inScalars);
+      }
     image->Delete();
     }
 
@@ -928,6 +1040,7 @@ void vtkGridSynchronizedTemplates3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Compute Normals: " << (this->ComputeNormals ? "On\n" : "Off\n");
   os << indent << "Compute Gradients: " << (this->ComputeGradients ? "On\n" : "Off\n");
   os << indent << "Compute Scalars: " << (this->ComputeScalars ? "On\n" : "Off\n");
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -17,6 +17,10 @@
 // .SECTION Description
 // vtkGridSynchronizedTemplates3D is a 3D implementation of the synchronized 
 // template algorithm.
+//
+// When EnableSMP is on, the execute extent is cut in slabs of cells
+// along k that are contoured concurrently by the threads of vtkSMPTools
+// and merged into the output the serial algorithm would produce.
 
 // .SECTION Caveats
 // This filter is specialized to 3D grids.
@@ -127,6 +131,17 @@ public:
   // from the input will be larger than this value (KiloBytes).
   void SetInputMemoryLimit(long limit);
 
+  // Description:
+  // Enable/Disable contouring slabs of the execute extent concurrently
+  // with vtkSMPTools.  The output is identical to the serial one, but
+  // the slabs are kept until they are merged, which about doubles the
+  // memory used by the output during the execution.  The slabs are only
+  // used when several threads are available and all the input arrays
+  // can be read concurrently.  On by default.
+  vtkSetMacro(EnableSMP, int);
+  vtkGetMacro(EnableSMP, int);
+  vtkBooleanMacro(EnableSMP, int);
+
 protected:
   vtkGridSynchronizedTemplates3D();
   ~vtkGridSynchronizedTemplates3D();
@@ -142,6 +157,7 @@ protected:
 
   int MinimumPieceSize[3];
   int ExecuteExtent[6];
+  int EnableSMP;
 
 private:
   vtkGridSynchronizedTemplates3D(const vtkGridSynchronizedTemplates3D&);  // Not implemented.
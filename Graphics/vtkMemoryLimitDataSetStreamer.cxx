@@ -0,0 +1,419 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitDataSetStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryLimitDataSetStreamer.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithmOutput.h"
+#include "vtkCommand.h"
+#include "vtkDataSet.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkMemoryLimitDataSetStreamer);
+
+//----------------------------------------------------------------------------
+// The output ports upstream of the given input information, each once.
+typedef std::pair<vtkExecutive*, int> vtkExecutivePort;
+static void vtkMemoryLimitDataSetStreamerCollectUpstream(
+  vtkInformation *inInfo, std::set<vtkExecutivePort>& visited,
+  std::vector<vtkExecutivePort>& ports)
+{
+  vtkExecutive *exec;
+  int port;
+  vtkExecutive::PRODUCER()->Get(inInfo, exec, port);
+  if (!exec || !visited.insert(vtkExecutivePort(exec, port)).second)
+    {
+    return;
+    }
+  ports.push_back(vtkExecutivePort(exec, port));
+  for (int i = 0; i < exec->GetNumberOfInputPorts(); ++i)
+    {
+    vtkInformationVector *inVector = exec->GetInputInformation(i);
+    for (int j = 0; j < inVector->GetNumberOfInformationObjects(); ++j)
+      {
+      vtkMemoryLimitDataSetStreamerCollectUpstream(
+        inVector->GetInformationObject(j), visited, ports);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Estimate the size in kilobytes of a structured update extent from the
+// point data meta information.
+static unsigned long vtkMemoryLimitDataSetStreamerEstimateExtentSize(
+  vtkInformation *info, vtkDataObject *data)
+{
+  int extent[6];
+  info->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent);
+  double numberOfPoints = 1.0;
+  for (int i = 0; i < 3; ++i)
+    {
+    numberOfPoints *= (extent[2*i+1] < extent[2*i] ? 0.0 :
+                       extent[2*i+1] - extent[2*i] + 1.0);
+    }
+  double pointSize = 0.0;
+  if (vtkInformationVector *fields =
+      info->Get(vtkDataObject::POINT_DATA_VECTOR()))
+    {
+    for (int i = 0; i < fields->GetNumberOfInformationObjects(); ++i)
+      {
+      vtkInformation *field = fields->GetInformationObject(i);
+      if (field->Has(vtkDataObject::FIELD_ARRAY_TYPE()))
+        {
+        int components = 1;
+        if (field->Has(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS()))
+          {
+          components = field->Get(vtkDataObject::FIELD_NUMBER_OF_COMPONENTS());
+          }
+        pointSize += components * vtkAbstractArray::GetDataTypeSize(
+          field->Get(vtkDataObject::FIELD_ARRAY_TYPE()));
+        }
+      }
+    }
+  if (pointSize == 0.0)
+    {
+    pointSize = sizeof(double);
+    }
+  if (data->IsA("vtkStructuredGrid"))
+    {
+    pointSize += 3*sizeof(float);
+    }
+  return static_cast<unsigned long>(numberOfPoints*pointSize / 1024.0);
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitDataSetStreamer::vtkMemoryLimitDataSetStreamer()
+{
+  this->MemoryLimit = 50000;
+  this->MergePieces = 1;
+  this->NumberOfStreamDivisions = 1;
+  this->CurrentDivision = 0;
+  this->Append = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitDataSetStreamer::~vtkMemoryLimitDataSetStreamer()
+{
+  if (this->Append)
+    {
+    this->Append->Delete();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::RequestDataObject(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  if (!inInfo)
+    {
+    return 0;
+    }
+  vtkDataSet *input = vtkDataSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  if (!input)
+    {
+    return 0;
+    }
+
+  // Pieces of poly data are appended into poly data, any other data set
+  // into an unstructured grid.
+  int outputType = (input->IsA("vtkPolyData") ?
+                    VTK_POLY_DATA : VTK_UNSTRUCTURED_GRID);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkDataSet *output = vtkDataSet::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  if (!output || output->GetDataObjectType() != outputType)
+    {
+    vtkDataSet *newOutput;
+    if (outputType == VTK_POLY_DATA)
+      {
+      newOutput = vtkPolyData::New();
+      }
+    else
+      {
+      newOutput = vtkUnstructuredGrid::New();
+      }
+    newOutput->SetPipelineInformation(outInfo);
+    newOutput->Delete();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  int piece = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int numberOfPieces = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  int ghostLevel = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+
+  if (this->CurrentDivision == 0)
+    {
+    this->ComputeNumberOfStreamDivisions(inInfo, piece, numberOfPieces,
+                                         ghostLevel);
+    }
+
+  // Each piece of the output is streamed in NumberOfStreamDivisions
+  // pieces of the input.
+  vtkStreamingDemandDrivenPipeline *exec =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+  exec->SetUpdateExtent(inInfo,
+                        piece*this->NumberOfStreamDivisions +
+                        this->CurrentDivision,
+                        numberOfPieces*this->NumberOfStreamDivisions,
+                        ghostLevel);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitDataSetStreamer::ComputeNumberOfStreamDivisions(
+  vtkInformation *inInfo, int piece, int numberOfPieces, int ghostLevel)
+{
+  vtkStreamingDemandDrivenPipeline *exec =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+  vtkExecutive *producer;
+  int producerPort;
+  vtkExecutive::PRODUCER()->Get(inInfo, producer, producerPort);
+  vtkStreamingDemandDrivenPipeline *producerExec =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(producer);
+  int maxPieces = -1;
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES()))
+    {
+    maxPieces = inInfo->Get(
+      vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES());
+    }
+
+  this->NumberOfStreamDivisions = 1;
+  if (!producerExec)
+    {
+    return;
+    }
+
+  // Double the number of pieces until the estimated size fits in memory
+  // or the pieces no longer get smaller.  Without estimates, a single
+  // piece is requested and split after it has been measured.
+  unsigned long size = 0;
+  for (int count = 0; count < 29; ++count)
+    {
+    int divisions = (1 << count);
+    if (maxPieces >= 0 && numberOfPieces*divisions > maxPieces)
+      {
+      break;
+      }
+    exec->SetUpdateExtent(inInfo, piece*divisions,
+                          numberOfPieces*divisions, ghostLevel);
+    producerExec->PropagateUpdateExtent(producerPort);
+    producerExec->PropagateUpdateExtentInformation(producerPort);
+    unsigned long newSize = this->GetEstimatedSize(inInfo);
+    if (count > 0 && newSize > 0.8*size)
+      {
+      break;
+      }
+    this->NumberOfStreamDivisions = divisions;
+    size = newSize;
+    if (size <= this->MemoryLimit)
+      {
+      break;
+      }
+    }
+
+  vtkDebugMacro("Streaming in " << this->NumberOfStreamDivisions
+                << " pieces of about " << size << " KB.");
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMemoryLimitDataSetStreamer::GetEstimatedSize(
+  vtkInformation *inInfo)
+{
+  std::set<vtkExecutivePort> visited;
+  std::vector<vtkExecutivePort> ports;
+  vtkMemoryLimitDataSetStreamerCollectUpstream(inInfo, visited, ports);
+  unsigned long size = 0;
+  for (size_t i = 0; i < ports.size(); ++i)
+    {
+    vtkInformation *info =
+      ports[i].first->GetOutputInformation(ports[i].second);
+    if (info->Has(vtkStreamingDemandDrivenPipeline::ESTIMATED_MEMORY_SIZE()))
+      {
+      size += info->Get(
+        vtkStreamingDemandDrivenPipeline::ESTIMATED_MEMORY_SIZE());
+      }
+    // Structured data can be estimated from its extent.
+    else if (vtkDataObject *data = info->Get(vtkDataObject::DATA_OBJECT()))
+      {
+      if (data->GetExtentType() == VTK_3D_EXTENT &&
+          info->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
+        {
+        size += vtkMemoryLimitDataSetStreamerEstimateExtentSize(info, data);
+        }
+      }
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMemoryLimitDataSetStreamer::GetActualSize(
+  vtkInformation *inInfo)
+{
+  std::set<vtkExecutivePort> visited;
+  std::vector<vtkExecutivePort> ports;
+  vtkMemoryLimitDataSetStreamerCollectUpstream(inInfo, visited, ports);
+  unsigned long size = 0;
+  for (size_t i = 0; i < ports.size(); ++i)
+    {
+    vtkInformation *info =
+      ports[i].first->GetOutputInformation(ports[i].second);
+    if (vtkDataObject *data = info->Get(vtkDataObject::DATA_OBJECT()))
+      {
+      size += data->GetActualMemorySize();
+      }
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitDataSetStreamer::RequestData(
+  vtkInformation *request,
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkDataSet *input = vtkDataSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkDataSet *output = vtkDataSet::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  // Is this the first piece?
+  if (!this->CurrentDivision)
+    {
+    // Tell the pipeline to start looping.
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+    if (this->Append)
+      {
+      this->Append->Delete();
+      this->Append = 0;
+      }
+    if (this->MergePieces)
+      {
+      if (output->IsA("vtkPolyData"))
+        {
+        this->Append = vtkAppendPolyData::New();
+        }
+      else
+        {
+        this->Append = vtkAppendFilter::New();
+        }
+      }
+    }
+
+  if (input->GetNumberOfPoints() > 0 || input->GetNumberOfCells() > 0)
+    {
+    if (this->Append)
+      {
+      vtkDataSet *copy = input->NewInstance();
+      copy->ShallowCopy(input);
+      this->Append->AddInputConnection(copy->GetProducerPort());
+      copy->Delete();
+      }
+    else
+      {
+      this->InvokeEvent(vtkCommand::UpdateDataEvent, input);
+      }
+    }
+
+  // Split the remaining pieces when this one did not fit.  Piece i of n
+  // is made of pieces i*k to i*k+k-1 of n*k.
+  int split = 1;
+  unsigned long size = this->GetActualSize(inInfo);
+  int numberOfPieces = outInfo->Get(
+    vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  int maxPieces = -1;
+  if (inInfo->Has(vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES()))
+    {
+    maxPieces = inInfo->Get(
+      vtkStreamingDemandDrivenPipeline::MAXIMUM_NUMBER_OF_PIECES());
+    }
+  while (size / split > this->MemoryLimit &&
+         this->NumberOfStreamDivisions * split < (1 << 28) &&
+         (maxPieces < 0 ||
+          numberOfPieces*this->NumberOfStreamDivisions*split*2 <= maxPieces))
+    {
+    split *= 2;
+    }
+  if (split > 1)
+    {
+    vtkDebugMacro("Piece " << this->CurrentDivision << " of "
+                  << this->NumberOfStreamDivisions << " used " << size
+                  << " KB, splitting the remaining pieces in " << split);
+    }
+  this->CurrentDivision = (this->CurrentDivision + 1)*split;
+  this->NumberOfStreamDivisions *= split;
+
+  this->UpdateProgress(static_cast<double>(this->CurrentDivision) /
+                       this->NumberOfStreamDivisions);
+
+  if (this->CurrentDivision >= this->NumberOfStreamDivisions)
+    {
+    // Tell the pipeline to stop looping.
+    request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+    this->CurrentDivision = 0;
+    if (this->Append)
+      {
+      if (this->Append->GetNumberOfInputConnections(0) > 0)
+        {
+        this->Append->Update();
+        output->ShallowCopy(this->Append->GetOutputDataObject(0));
+        }
+      this->Append->Delete();
+      this->Append = 0;
+      }
+    }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitDataSetStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+  os << indent << "MergePieces: " << this->MergePieces << endl;
+  os << indent << "NumberOfStreamDivisions: "
+     << this->NumberOfStreamDivisions << endl;
+}
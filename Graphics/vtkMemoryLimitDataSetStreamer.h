@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitDataSetStreamer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryLimitDataSetStreamer - stream a pipeline within a memory limit.
+// .SECTION Description
+// vtkMemoryLimitDataSetStreamer updates its input in as many pieces as
+// needed for the data held by the pipeline upstream to stay below
+// MemoryLimit, then appends the pieces or forwards them one at a time.
+// Any chain of piece-aware readers and filters can be streamed.
+//
+// The number of pieces is chosen before the first piece is requested.
+// The sources report the ESTIMATED_MEMORY_SIZE of the requested piece
+// in the update extent information pass of
+// vtkStreamingDemandDrivenPipeline, and the estimates of every
+// executive upstream are added since all of them keep their output.
+// Structured data without an estimate are sized from their update
+// extent and point data meta information.
+// The number of pieces is doubled until that sum fits.  Once a piece
+// has been produced, the memory actually used upstream is measured:
+// when it exceeds the limit, the remaining pieces are split further.
+// This assumes that piece p of n covers pieces p*k to p*k+k-1 of n*k,
+// as the extent translator and the XML unstructured readers do.  The
+// number of pieces never exceeds the MAXIMUM_NUMBER_OF_PIECES of the
+// input: for an XML file, the number of pieces it was written in.
+//
+// When MergePieces is on (the default), the output is the union of the
+// pieces: a vtkPolyData for poly data inputs and a vtkUnstructuredGrid
+// otherwise.  The merged output must fit in memory, which it does when
+// the pipeline reduces the data (contouring, slicing, thresholding...).
+// When MergePieces is off, each piece is passed as the call data of an
+// UpdateDataEvent as soon as it is produced and the output is left
+// empty, so that an observer can write or accumulate pieces of data
+// sets larger than memory.
+// .SECTION See Also
+// vtkPolyDataStreamer vtkMemoryLimitImageDataStreamer vtkAppendFilter
+
+#ifndef __vtkMemoryLimitDataSetStreamer_h
+#define __vtkMemoryLimitDataSetStreamer_h
+
+#include "vtkDataSetAlgorithm.h"
+
+class VTK_GRAPHICS_EXPORT vtkMemoryLimitDataSetStreamer : public vtkDataSetAlgorithm
+{
+public:
+  static vtkMemoryLimitDataSetStreamer *New();
+  vtkTypeMacro(vtkMemoryLimitDataSetStreamer,vtkDataSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set / Get the memory limit in kilobytes.  The default is 50000.
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // Set / Get whether the pieces are appended to the output or only
+  // forwarded to the observers of UpdateDataEvent.  On by default.
+  vtkSetMacro(MergePieces, int);
+  vtkGetMacro(MergePieces, int);
+  vtkBooleanMacro(MergePieces, int);
+
+  // Description:
+  // Get the number of pieces the input was divided into by the last
+  // update, including the splits made while streaming.
+  vtkGetMacro(NumberOfStreamDivisions, int);
+
+protected:
+  vtkMemoryLimitDataSetStreamer();
+  ~vtkMemoryLimitDataSetStreamer();
+
+  virtual int RequestDataObject(vtkInformation *, vtkInformationVector **,
+                                vtkInformationVector *);
+  virtual int RequestUpdateExtent(vtkInformation *, vtkInformationVector **,
+                                  vtkInformationVector *);
+  virtual int RequestData(vtkInformation *, vtkInformationVector **,
+                          vtkInformationVector *);
+
+  // Choose the number of pieces from the estimates of the sources.
+  void ComputeNumberOfStreamDivisions(vtkInformation *inInfo,
+                                      int piece, int numberOfPieces,
+                                      int ghostLevel);
+
+  // Return the estimated size in kilobytes of the data held upstream
+  // for the piece requested in inInfo, or 0 when no source gives one.
+  unsigned long GetEstimatedSize(vtkInformation *inInfo);
+
+  // Return the size in kilobytes of the data held upstream.
+  unsigned long GetActualSize(vtkInformation *inInfo);
+
+  unsigned long MemoryLimit;
+  int MergePieces;
+  int NumberOfStreamDivisions;
+  int CurrentDivision;
+
+  // The filter appending the pieces while streaming.
+  vtkAlgorithm *Append;
+
+private:
+  vtkMemoryLimitDataSetStreamer(const vtkMemoryLimitDataSetStreamer&);  // Not implemented.
+  void operator=(const vtkMemoryLimitDataSetStreamer&);  // Not implemented.
+};
+
+#endif
@@ -676,6 +676,41 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3],
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol,
                                           double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId)
+{
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId,
+                                         cellId, NULL);
+}
+//---------------------------------------------------------------------------
+// The cell is only used as scratch space until the intersected cell is
+// found, so this method may run on several threads, each with its own cell.
+int vtkModifiedBSPTree::ThreadedIntersectWithLine(double p1[3],
+                                                  double p2[3],
+                                                  double tol,
+                                                  double &t,
+                                                  double x[3],
+                                                  double pcoords[3],
+                                                  int &subId,
+                                                  vtkIdType &cellId,
+                                                  vtkGenericCell *cell)
+{
+  int hit = this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId,
+                                            cellId, cell);
+  if (hit)
+    {
+    this->DataSet->GetCell(cellId, cell);
+    }
+  return hit;
+}
+//---------------------------------------------------------------------------
+int vtkModifiedBSPTree::IntersectWithLineInternal(double p1[3],
+                                                  double p2[3],
+                                                  double tol,
+                                                  double &t,
+                                                  double x[3],
+                                                  double pcoords[3],
+                                                  int &subId,
+                                                  vtkIdType &cellId,
+                                                  vtkGenericCell *cell)
 {
   //
   BSPNode  *node, *Near, *Mid, *Far;
@@ -779,7 +814,9 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol
       ctmin = _tmin; ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
         {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (cell ?
+            this->ThreadedIntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell) :
+            this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
           {
           if (t_hit<closest_intersection)
             {
@@ -992,6 +1029,42 @@ int vtkModifiedBSPTree::IntersectCellInternal(
   this->DataSet->GetCell(cell_ID, this->GenericCell);
   return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
+//---------------------------------------------------------------------------
+int vtkModifiedBSPTree::ThreadedIntersectCellInternal(
+  vtkIdType cell_ID,
+  const double p1[3],
+  const double p2[3],
+  const double tol,
+  double &t,
+  double ipt[3],
+  double pcoords[3],
+  int &subId,
+  vtkGenericCell *cell)
+{
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+}
+//---------------------------------------------------------------------------
+int vtkModifiedBSPTree::HasThreadedIntersectCellInternal()
+{
+  // The subclasses may have overridden the serial cell test only.
+  return strcmp(this->GetClassName(), "vtkModifiedBSPTree") == 0;
+}
+//---------------------------------------------------------------------------
+int vtkModifiedBSPTree::PrepareForThreadedIntersectWithLine()
+{
+  if (!this->HasThreadedIntersectCellInternal())
+    {
+    return 0;
+    }
+  this->BuildLocatorIfNeeded();
+  if (!this->mRoot)
+    {
+    return 0;
+    }
+  this->DataSet->PrepareForThreadedAccess();
+  return 1;
+}
 //////////////////////////////////////////////////////////////////////////////
 // FindCell stuff
 //////////////////////////////////////////////////////////////////////////////
@@ -276,6 +276,31 @@ class VTK_GRAPHICS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLocator {
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
     const double tol, double &t, double ipt[3], double pcoords[3], int &subId);
 
+  // The same cell/ray test for the threads of IntersectWithLines(), done
+  // in the given cell rather than in the shared GenericCell.
+  virtual int ThreadedIntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+    const double p2[3], const double tol, double &t, double ipt[3],
+    double pcoords[3], int &subId, vtkGenericCell *cell);
+
+  // Return 1 if ThreadedIntersectCellInternal() does the cell test of
+  // IntersectCellInternal(), so that IntersectWithLines() may use the
+  // threads.  Only vtkModifiedBSPTree itself returns 1: a subclass
+  // overriding IntersectCellInternal() is intersected serially unless it
+  // overrides ThreadedIntersectCellInternal() and this method too.
+  virtual int HasThreadedIntersectCellInternal();
+
+  virtual int PrepareForThreadedIntersectWithLine();
+  virtual int ThreadedIntersectWithLine(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell);
+
+  // The ray traversal shared by the IntersectWithLine() methods.  The
+  // cells are tested with IntersectCellInternal(), or with
+  // ThreadedIntersectCellInternal() in cell if it is not NULL.
+  int IntersectWithLineInternal(
+    double p1[3], double p2[3], double tol, double &t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell);
+
 //ETX
   void BuildLocatorIfNeeded();
   void ForceBuildLocator();
@@ -978,6 +978,18 @@ int vtkOBBTree::IntersectWithLine(double a0[3], double a1[3], double tol,
     }
 }
 
+// The tree is not built on demand, so threaded line intersections need a
+// built tree.
+int vtkOBBTree::PrepareForThreadedIntersectWithLine()
+{
+  if ( this->Tree == NULL )
+    {
+    return 0;
+    }
+  this->DataSet->PrepareForThreadedAccess();
+  return 1;
+}
+
 void vtkOBBNode::DebugPrintTree( int level, double *leaf_vol,
                                  int *minCells, int *maxCells )
   {
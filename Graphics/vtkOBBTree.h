@@ -132,7 +132,9 @@ public:
   // Description:
   // Return the first intersection of the specified line segment with
   // the OBB tree, as well as information about the cell which the
-  // line segment intersected.
+  // line segment intersected.  Once the tree is built, this method may be
+  // called from several threads with different cells, see
+  // IntersectWithLines().
   int IntersectWithLine(double a0[3], double a1[3], double tol,
                         double& t, double x[3], double pcoords[3],
                         int &subId, vtkIdType &cellId, vtkGenericCell *cell);
@@ -286,6 +288,8 @@ protected:
   void GeneratePolygons(vtkOBBNode *OBBptr, int level, int repLevel, 
                         vtkPoints* pts, vtkCellArray *polys);
 
+  virtual int PrepareForThreadedIntersectWithLine();
+
   //ETX
 private:
   vtkOBBTree(const vtkOBBTree&);  // Not implemented.
@@ -14,12 +14,14 @@
 =========================================================================*/
 #include "vtkSynchronizedTemplates3D.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkExtentTranslator.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
@@ -27,7 +29,10 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadPool.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredPoints.h"
@@ -37,6 +42,8 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <math.h>
+#include <string.h>
+#include <vector>
 
 vtkStandardNewMacro(vtkSynchronizedTemplates3D);
 
@@ -56,6 +63,7 @@ vtkSynchronizedTemplates3D::vtkSynchronizedTemplates3D()
     = this->ExecuteExtent[4] = this->ExecuteExtent[5] = 0;
 
   this->ArrayComponent = 0;
+  this->EnableSMP = 1;
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
@@ -248,13 +256,15 @@ if (ComputeScalars) \
 
 //----------------------------------------------------------------------------
 //
-// Contouring filter specialized for images
+// Contouring filter specialized for images.  When slabs is not NULL,
+// only the given slab of exExt is contoured.
 //
 template <class T>
 void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
                   vtkInformation *inInfo,
                   vtkImageData *data, vtkPolyData *output, T *ptr, 
-                  vtkDataArray *inScalars)
+                  vtkDataArray *inScalars,
+                  vtkSynchronizedTemplatesSlabs *slabs = NULL, int slab = 0)
 {
   int *inExt = data->GetExtent();
   int xdim = exExt[1] - exExt[0] + 1;
@@ -297,7 +307,12 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
   vtkFloatArray *newGradients = NULL;
   vtkPoints *newPts;
   vtkCellArray *newPolys;
+  int ext[6] = {exExt[0], exExt[1], exExt[2], exExt[3], exExt[4], exExt[5]};
   ptr += self->GetArrayComponent();
+  if (slabs)
+    {
+    slabs->GetSlabZRange(slab, ext[4], ext[5]);
+    }
   
   if (ComputeScalars)
     {
@@ -311,7 +326,7 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
     {
     newGradients = vtkFloatArray::New();
     }
-  vtkSynchronizedTemplates3DInitializeOutput(exExt, 
+  vtkSynchronizedTemplates3DInitializeOutput(ext, 
                                              data, output, 
                                              newScalars, newNormals, 
                                              newGradients, inScalars);
@@ -319,12 +334,12 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
   newPolys = output->GetPolys();
   
   // this is an exploded execute extent.
-  xMin = exExt[0];
-  xMax = exExt[1];
-  yMin = exExt[2];
-  yMax = exExt[3];
-  zMin = exExt[4];
-  zMax = exExt[5];
+  xMin = ext[0];
+  xMax = ext[1];
+  yMin = ext[2];
+  yMax = ext[3];
+  zMin = ext[4];
+  zMax = ext[5];
   
   // increments to move through scalars. Compute these ourself because
   // we may be contouring an array other than scalars.
@@ -332,6 +347,9 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
   yInc = xInc*(inExt[1]-inExt[0]+1);
   zInc = yInc*(inExt[3]-inExt[2]+1);
 
+  // ptr points to the first point of the execute extent.
+  ptr += (zMin - exExt[4])*zInc;
+
   wholeExt = inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
   
   // Kens increments, probably to do with edge array
@@ -370,12 +388,26 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
     {
     value = values[vidx];
     inPtrZ = ptr;
+    if (slabs)
+      {
+      slabs->BeginContour(slab, vidx);
+      }
 
     //==================================================================
     for (k = zMin; k <= zMax; k++)
       {
-      self->UpdateProgress((double)vidx/numContours + 
-                           (k-zMin)/((zMax - zMin+1.0)*numContours));
+      if (!slabs)
+        {
+        self->UpdateProgress((double)vidx/numContours + 
+                             (k-zMin)/((zMax - zMin+1.0)*numContours));
+        }
+      else if (vtkSMPThreadPool::GetThreadIndex() == 0)
+        {
+        // Only the calling thread may invoke the observers.
+        self->UpdateProgress((slab + (double)vidx/numContours +
+                              (k-zMin)/((zMax - zMin+1.0)*numContours)) /
+                             slabs->GetNumberOfSlabs());
+        }
       z = origin[2] + spacing[2]*k;
       x[2] = z;
 
@@ -512,7 +544,9 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
                 }
               }
             }
-          if (k < zMax)
+          // The edges along z of the top plane of a slab are
+          // intersected by the slab.
+          if (k < exExt[5])
             {
             s3 = (inPtrX + zInc);
             v3 = (*s3 < value ? 0 : 1);
@@ -601,10 +635,18 @@ void ContourImage(vtkSynchronizedTemplates3D *self, int *exExt,
           }
         inPtrY += yInc;
         }
+      if (slabs)
+        {
+        slabs->EndPlane(slab, vidx, k, isect2Ptr - xdim*ydim*3);
+        }
       inPtrZ += zInc;
       }
     }
   delete [] isect1;
+  if (slabs)
+    {
+    slabs->EndSlab(slab);
+    }
 
   if (newScalars)
     {
@@ -658,6 +700,37 @@ unsigned long vtkSynchronizedTemplates3D::GetInputMemoryLimit()
 
 
 
+//----------------------------------------------------------------------------
+// vtkSMPTools functor contouring slabs of the execute extent.
+class vtkSynchronizedTemplates3DSlabFunctor
+{
+public:
+  vtkSynchronizedTemplates3D *Self;
+  int *ExExt;
+  vtkInformation *InInfo;
+  vtkImageData *Data;
+  void *Ptr;
+  vtkDataArray *InScalars;
+  vtkSynchronizedTemplatesSlabs *Slabs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType slab = begin; slab < end; slab++)
+      {
+      vtkPolyData *output =
+        this->Slabs->GetSlabOutput(static_cast<int>(slab));
+      switch (this->InScalars->GetDataType())
+        {
+        vtkTemplateMacro(
+          ContourImage(this->Self, this->ExExt, this->InInfo, this->Data,
+                       output, static_cast<VTK_TT *>(this->Ptr),
+                       this->InScalars, this->Slabs,
+                       static_cast<int>(slab)));
+        }
+      }
+    }
+};
+
 //----------------------------------------------------------------------------
 //
 // Contouring filter specialized for images (or slices from images)
@@ -698,6 +771,33 @@ void vtkSynchronizedTemplates3D::ThreadedExecute(vtkImageData *data,
     }
   
   ptr = data->GetArrayPointerForExtent(inScalars, exExt);
+
+  int numberOfSlabs = 1;
+  if (this->EnableSMP &&
+      vtkSynchronizedTemplatesSlabs::CanContourInParallel(data))
+    {
+    numberOfSlabs = vtkSynchronizedTemplatesSlabs::ComputeNumberOfSlabs(exExt);
+    }
+  if (numberOfSlabs > 1)
+    {
+    vtkSynchronizedTemplatesSlabs slabs(exExt, this->GetNumberOfContours(),
+                                        numberOfSlabs);
+    vtkSynchronizedTemplates3DSlabFunctor functor;
+    functor.Self = this;
+    functor.ExExt = exExt;
+    functor.InInfo = inInfo;
+    functor.Data = data;
+    functor.Ptr = ptr;
+    functor.InScalars = inScalars;
+    functor.Slabs = &slabs;
+    vtkSMPTools::For(0, slabs.GetNumberOfSlabs(), 1, functor);
+    if (!slabs.Merge(output))
+      {
+      vtkErrorMacro("The planes shared by the slabs do not match.");
+      }
+    return;
+    }
+
   switch (inScalars->GetDataType())
     {
     vtkTemplateMacro(
@@ -856,6 +956,469 @@ void vtkSynchronizedTemplates3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Compute Gradients: " << (this->ComputeGradients ? "On\n" : "Off\n");
   os << indent << "Compute Scalars: " << (this->ComputeScalars ? "On\n" : "Off\n");
   os << indent << "ArrayComponent: " << this->ArrayComponent << endl;
+  os << indent << "EnableSMP: " << (this->EnableSMP ? "On\n" : "Off\n");
+}
+
+//----------------------------------------------------------------------------
+// The slabs are at least this many layers of cells thick, so that
+// contouring the bottom plane of each slab twice stays cheap.
+static const int vtkSynchronizedTemplatesMinimumSlabThickness = 8;
+
+// The output of a slab and the bookkeeping needed to merge it.  The
+// contour values are contoured one after the other, so the points and
+// cells of each contour value are contiguous in the output of a slab.
+struct vtkSynchronizedTemplatesSlabs::Slab
+{
+  int ZMin;
+  int ZMax;
+  vtkPolyData *Output;
+
+  // Per contour value, plus one entry for the end: the first point and
+  // cell, and the first edge id of the bottom and top planes.
+  std::vector<vtkIdType> PointOffsets;
+  std::vector<vtkIdType> CellOffsets;
+  std::vector<vtkIdType> BottomOffsets;
+  std::vector<vtkIdType> TopOffsets;
+
+  // Per contour value: the number of points created on the bottom plane,
+  // which belong to the slab below.  Always 0 for the first slab.
+  std::vector<vtkIdType> NumberOfBottomPoints;
+
+  // The ids of the intersected edges of the bottom and top planes in
+  // scan order.  There is no bottom plane for the first slab and no top
+  // plane for the last one.
+  std::vector<vtkIdType> BottomIds;
+  std::vector<vtkIdType> TopIds;
+
+  // Filled by Merge().  Per contour value: the output id of the first
+  // point owned by the slab, the first output cell, the number of cells
+  // kept and the start of the contour value in BottomMap.  BottomMap
+  // holds the output ids of the bottom plane points and TopMap the
+  // output ids of TopIds.
+  std::vector<vtkIdType> PointStarts;
+  std::vector<vtkIdType> CellStarts;
+  std::vector<vtkIdType> NumberOfCells;
+  std::vector<vtkIdType> BottomMapOffsets;
+  std::vector<vtkIdType> BottomMap;
+  std::vector<vtkIdType> TopMap;
+
+  // Return the output id of a point of the slab created for a contour
+  // value.
+  vtkIdType GetOutputId(int contour, vtkIdType id)
+    {
+    id -= this->PointOffsets[contour];
+    vtkIdType numBottomPts = this->NumberOfBottomPoints[contour];
+    if (id < numBottomPts)
+      {
+      return this->BottomMap[this->BottomMapOffsets[contour] + id];
+      }
+    return this->PointStarts[contour] + id - numBottomPts;
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkSynchronizedTemplatesSlabs::vtkSynchronizedTemplatesSlabs(
+  int *exExt, int numberOfContours, int numberOfSlabs)
+{
+  int numberOfLayers = exExt[5] - exExt[4];
+  if (numberOfSlabs > numberOfLayers)
+    {
+    numberOfSlabs = numberOfLayers;
+    }
+  if (numberOfSlabs < 1)
+    {
+    numberOfSlabs = 1;
+    }
+  this->NumberOfSlabs = numberOfSlabs;
+  this->NumberOfContours = numberOfContours;
+  this->PlaneSize = (exExt[1] - exExt[0] + 1)*(exExt[3] - exExt[2] + 1)*3;
+  this->ZMax = exExt[5];
+  this->Slabs = new Slab[numberOfSlabs];
+  for (int s = 0; s < numberOfSlabs; s++)
+    {
+    // Share the layers of cells evenly.  Two consecutive slabs share a
+    // plane of points.
+    Slab &slab = this->Slabs[s];
+    slab.ZMin = exExt[4] + numberOfLayers*s/numberOfSlabs;
+    slab.ZMax = exExt[4] + numberOfLayers*(s+1)/numberOfSlabs;
+    slab.Output = vtkPolyData::New();
+    slab.PointOffsets.resize(numberOfContours+1, 0);
+    slab.CellOffsets.resize(numberOfContours+1, 0);
+    slab.BottomOffsets.resize(numberOfContours+1, 0);
+    slab.TopOffsets.resize(numberOfContours+1, 0);
+    slab.NumberOfBottomPoints.resize(numberOfContours, 0);
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkSynchronizedTemplatesSlabs::~vtkSynchronizedTemplatesSlabs()
+{
+  for (int s = 0; s < this->NumberOfSlabs; s++)
+    {
+    this->Slabs[s].Output->Delete();
+    }
+  delete [] this->Slabs;
+}
+
+//----------------------------------------------------------------------------
+int vtkSynchronizedTemplatesSlabs::ComputeNumberOfSlabs(int *exExt)
+{
+  int numberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (numberOfThreads < 2)
+    {
+    return 1;
+    }
+  int numberOfSlabs =
+    (exExt[5] - exExt[4]) / vtkSynchronizedTemplatesMinimumSlabThickness;
+  // A few slabs per thread balance the load.
+  if (numberOfSlabs > 4*numberOfThreads)
+    {
+    numberOfSlabs = 4*numberOfThreads;
+    }
+  return (numberOfSlabs > 1 ? numberOfSlabs : 1);
+}
+
+//----------------------------------------------------------------------------
+int vtkSynchronizedTemplatesSlabs::CanContourInParallel(vtkDataSet *input)
+{
+  // The attributes are interpolated from the threads.  Only the arrays
+  // whose values are dispatched directly are read without side effects
+  // and written one tuple at a time: a vtkBitArray packs the values of
+  // several tuples in each byte.
+  vtkDataSetAttributes *attributes[2] =
+    { input->GetPointData(), input->GetCellData() };
+  for (int a = 0; a < 2; a++)
+    {
+    for (int i = 0; i < attributes[a]->GetNumberOfArrays(); i++)
+      {
+      if (!vtkArrayDispatchIsDirect(attributes[a]->GetArray(i)))
+        {
+        return 0;
+        }
+      }
+    }
+  vtkPointSet *pointSet = vtkPointSet::SafeDownCast(input);
+  if (pointSet && pointSet->GetPoints() &&
+      !pointSet->GetPoints()->GetData()->HasStandardMemoryLayout())
+    {
+    return 0;
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkPolyData *vtkSynchronizedTemplatesSlabs::GetSlabOutput(int slab)
+{
+  return this->Slabs[slab].Output;
+}
+
+//----------------------------------------------------------------------------
+void vtkSynchronizedTemplatesSlabs::GetSlabZRange(int slab, int &zMin,
+                                                  int &zMax)
+{
+  zMin = this->Slabs[slab].ZMin;
+  zMax = this->Slabs[slab].ZMax;
+}
+
+//----------------------------------------------------------------------------
+void vtkSynchronizedTemplatesSlabs::BeginContour(int slab, int contour)
+{
+  Slab &s = this->Slabs[slab];
+  s.PointOffsets[contour] = s.Output->GetNumberOfPoints();
+  s.CellOffsets[contour] = s.Output->GetPolys()->GetNumberOfCells();
+  s.BottomOffsets[contour] = static_cast<vtkIdType>(s.BottomIds.size());
+  s.TopOffsets[contour] = static_cast<vtkIdType>(s.TopIds.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkSynchronizedTemplatesSlabs::EndPlane(int slab, int contour, int k,
+                                             int *isect)
+{
+  Slab &s = this->Slabs[slab];
+  std::vector<vtkIdType> *ids = NULL;
+  if (k == s.ZMin && slab > 0)
+    {
+    s.NumberOfBottomPoints[contour] =
+      s.Output->GetNumberOfPoints() - s.PointOffsets[contour];
+    ids = &s.BottomIds;
+    }
+  else if (k == s.ZMax && slab < this->NumberOfSlabs - 1)
+    {
+    ids = &s.TopIds;
+    }
+  if (ids)
+    {
+    for (int i = 0; i < this->PlaneSize; i++)
+      {
+      if (isect[i] > -1)
+        {
+        ids->push_back(isect[i]);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSynchronizedTemplatesSlabs::EndSlab(int slab)
+{
+  this->BeginContour(slab, this->NumberOfContours);
+}
+
+//----------------------------------------------------------------------------
+// vtkSMPTools functor counting the triangles of the slabs that are not
+// degenerate once their points have output ids.
+class vtkSynchronizedTemplatesSlabsCountCells
+{
+public:
+  vtkSynchronizedTemplatesSlabs::Slab *Slabs;
+  int NumberOfContours;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType s = begin; s < end; s++)
+      {
+      vtkSynchronizedTemplatesSlabs::Slab &slab = this->Slabs[s];
+      vtkIdType *cells = slab.Output->GetPolys()->GetPointer();
+      for (int v = 0; v < this->NumberOfContours; v++)
+        {
+        vtkIdType numCells = 0;
+        for (vtkIdType c = slab.CellOffsets[v]; c < slab.CellOffsets[v+1]; c++)
+          {
+          vtkIdType *pts = cells + 4*c;
+          vtkIdType id0 = slab.GetOutputId(v, pts[1]);
+          vtkIdType id1 = slab.GetOutputId(v, pts[2]);
+          vtkIdType id2 = slab.GetOutputId(v, pts[3]);
+          if (id0 != id1 && id0 != id2 && id1 != id2)
+            {
+            numCells++;
+            }
+          }
+        slab.NumberOfCells[v] = numCells;
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// vtkSMPTools functor copying the points, triangles and attributes of
+// the slabs to their place in the output.
+class vtkSynchronizedTemplatesSlabsCopy
+{
+public:
+  vtkSynchronizedTemplatesSlabs::Slab *Slabs;
+  int NumberOfContours;
+  vtkDataArray *Points;
+  vtkPointData *OutPD;
+  vtkCellData *OutCD;
+  vtkIdType *Connectivity;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+    {
+    int pointSize = 3*this->Points->GetDataTypeSize();
+    for (vtkIdType s = begin; s < end; s++)
+      {
+      vtkSynchronizedTemplatesSlabs::Slab &slab = this->Slabs[s];
+      vtkDataArray *points = slab.Output->GetPoints()->GetData();
+      vtkPointData *pd = slab.Output->GetPointData();
+      vtkCellData *cd = slab.Output->GetCellData();
+      vtkIdType *cells = slab.Output->GetPolys()->GetPointer();
+      for (int v = 0; v < this->NumberOfContours; v++)
+        {
+        // The points owned by the slab keep their order.
+        vtkIdType first = slab.PointOffsets[v] + slab.NumberOfBottomPoints[v];
+        vtkIdType numPts = slab.PointOffsets[v+1] - first;
+        if (numPts > 0)
+          {
+          memcpy(this->Points->GetVoidPointer(3*slab.PointStarts[v]),
+                 points->GetVoidPointer(3*first), numPts*pointSize);
+          this->OutPD->CopyData(pd, slab.PointStarts[v], numPts, first);
+          }
+
+        // The cell data of consecutive triangles kept are copied at once.
+        vtkIdType cellId = slab.CellStarts[v];
+        vtkIdType *outPts = this->Connectivity + 4*cellId;
+        vtkIdType runStart = 0;
+        vtkIdType runLength = 0;
+        for (vtkIdType c = slab.CellOffsets[v]; c < slab.CellOffsets[v+1]; c++)
+          {
+          vtkIdType *pts = cells + 4*c;
+          vtkIdType id0 = slab.GetOutputId(v, pts[1]);
+          vtkIdType id1 = slab.GetOutputId(v, pts[2]);
+          vtkIdType id2 = slab.GetOutputId(v, pts[3]);
+          if (id0 != id1 && id0 != id2 && id1 != id2)
+            {
+            outPts[0] = 3;
+            outPts[1] = id0;
+            outPts[2] = id1;
+            outPts[3] = id2;
+            outPts += 4;
+            if (runLength == 0)
+              {
+              runStart = c;
+              }
+            runLength++;
+            }
+          else if (runLength > 0)
+            {
+            this->OutCD->CopyData(cd, cellId, runLength, runStart);
+            cellId += runLength;
+            runLength = 0;
+            }
+          }
+        this->OutCD->CopyData(cd, cellId, runLength, runStart);
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+int vtkSynchronizedTemplatesSlabs::Merge(vtkPolyData *output)
+{
+  int numContours = this->NumberOfContours;
+  int numSlabs = this->NumberOfSlabs;
+  int s, v;
+
+  // Number the points owned by the slabs in the order of the serial
+  // algorithm: contour value after contour value, slab after slab.
+  vtkIdType numPts = 0;
+  for (s = 0; s < numSlabs; s++)
+    {
+    this->Slabs[s].PointStarts.resize(numContours);
+    }
+  for (v = 0; v < numContours; v++)
+    {
+    for (s = 0; s < numSlabs; s++)
+      {
+      Slab &slab = this->Slabs[s];
+      slab.PointStarts[v] = numPts;
+      numPts += slab.PointOffsets[v+1] - slab.PointOffsets[v] -
+        slab.NumberOfBottomPoints[v];
+      }
+    }
+
+  // The points of the bottom plane of a slab are those of the top plane
+  // of the slab below, whose output ids are known once the slabs below
+  // have been mapped.  Both planes list the same intersected edges.
+  for (s = 0; s < numSlabs; s++)
+    {
+    Slab &slab = this->Slabs[s];
+    slab.BottomMapOffsets.resize(numContours+1);
+    slab.BottomMapOffsets[0] = 0;
+    for (v = 0; v < numContours; v++)
+      {
+      slab.BottomMapOffsets[v+1] =
+        slab.BottomMapOffsets[v] + slab.NumberOfBottomPoints[v];
+      }
+    slab.BottomMap.assign(slab.BottomMapOffsets[numContours], -1);
+    if (s > 0)
+      {
+      Slab &below = this->Slabs[s-1];
+      for (v = 0; v < numContours; v++)
+        {
+        vtkIdType bottom = slab.BottomOffsets[v];
+        vtkIdType top = below.TopOffsets[v];
+        vtkIdType numIds = slab.BottomOffsets[v+1] - bottom;
+        if (numIds != below.TopOffsets[v+1] - top)
+          {
+          return 0;
+          }
+        for (vtkIdType m = 0; m < numIds; m++)
+          {
+          vtkIdType id = slab.BottomIds[bottom+m] - slab.PointOffsets[v];
+          if (id < 0 || id >= slab.NumberOfBottomPoints[v])
+            {
+            return 0;
+            }
+          slab.BottomMap[slab.BottomMapOffsets[v] + id] = below.TopMap[top+m];
+          }
+        }
+      for (size_t i = 0; i < slab.BottomMap.size(); i++)
+        {
+        if (slab.BottomMap[i] < 0)
+          {
+          return 0;
+          }
+        }
+      }
+    if (s < numSlabs - 1)
+      {
+      slab.TopMap.resize(slab.TopIds.size());
+      for (v = 0; v < numContours; v++)
+        {
+        for (vtkIdType m = slab.TopOffsets[v]; m < slab.TopOffsets[v+1]; m++)
+          {
+          slab.TopMap[m] = slab.GetOutputId(v, slab.TopIds[m]);
+          }
+        }
+      }
+    // The mapping of the slab below is not needed anymore.
+    if (s > 0)
+      {
+      std::vector<vtkIdType>().swap(this->Slabs[s-1].TopMap);
+      }
+    }
+
+  // Number the triangles kept in the same order as the points.
+  vtkSynchronizedTemplatesSlabsCountCells counter;
+  counter.Slabs = this->Slabs;
+  counter.NumberOfContours = numContours;
+  for (s = 0; s < numSlabs; s++)
+    {
+    this->Slabs[s].NumberOfCells.resize(numContours);
+    this->Slabs[s].CellStarts.resize(numContours);
+    }
+  vtkSMPTools::For(0, numSlabs, 1, counter);
+  vtkIdType numCells = 0;
+  for (v = 0; v < numContours; v++)
+    {
+    for (s = 0; s < numSlabs; s++)
+      {
+      this->Slabs[s].CellStarts[v] = numCells;
+      numCells += this->Slabs[s].NumberOfCells[v];
+      }
+    }
+
+  // Allocate the output at its final size so that the slabs can be
+  // copied concurrently.  All the slabs have the same arrays.
+  vtkPolyData *first = this->Slabs[0].Output;
+  vtkPoints *newPts = vtkPoints::New(first->GetPoints()->GetDataType());
+  newPts->SetNumberOfPoints(numPts);
+  vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfValues(4*numCells);
+  int i;
+  vtkPointData *outPD = output->GetPointData();
+  outPD->CopyAllOn();
+  outPD->CopyAllocate(first->GetPointData(), numPts);
+  for (i = 0; i < outPD->GetNumberOfArrays(); i++)
+    {
+    outPD->GetAbstractArray(i)->SetNumberOfTuples(numPts);
+    }
+  vtkCellData *outCD = output->GetCellData();
+  outCD->CopyAllOn();
+  outCD->CopyAllocate(first->GetCellData(), numCells);
+  for (i = 0; i < outCD->GetNumberOfArrays(); i++)
+    {
+    outCD->GetAbstractArray(i)->SetNumberOfTuples(numCells);
+    }
+
+  vtkSynchronizedTemplatesSlabsCopy copier;
+  copier.Slabs = this->Slabs;
+  copier.NumberOfContours = numContours;
+  copier.Points = newPts->GetData();
+  copier.OutPD = outPD;
+  copier.OutCD = outCD;
+  copier.Connectivity = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numSlabs, 1, copier);
+
+  output->SetPoints(newPts);
+  newPts->Delete();
+  vtkCellArray *newPolys = vtkCellArray::New();
+  newPolys->SetCells(numCells, connectivity);
+  connectivity->Delete();
+  output->SetPolys(newPolys);
+  newPolys->Delete();
+
+  return 1;
 }
 
 
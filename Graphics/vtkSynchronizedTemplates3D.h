@@ -18,6 +18,12 @@
 // vtkSynchronizedTemplates3D is a 3D implementation of the synchronized 
 // template algorithm. Note that vtkContourFilter will automatically
 // use this class when appropriate.
+//
+// When EnableSMP is on, the execute extent is cut in slabs of cells
+// along z that are contoured concurrently by the threads of vtkSMPTools.
+// The slabs are then merged in the order the serial algorithm visits
+// them, so the output (point ids, point and cell data) is the same
+// whatever the number of threads.
 
 // .SECTION Caveats
 // This filter is specialized to 3D images (aka volumes).
@@ -31,7 +37,9 @@
 #include "vtkPolyDataAlgorithm.h"
 #include "vtkContourValues.h" // Passes calls through
 
+class vtkDataSet;
 class vtkImageData;
+class vtkPolyData;
 
 class VTK_GRAPHICS_EXPORT vtkSynchronizedTemplates3D : public vtkPolyDataAlgorithm
 {
@@ -135,6 +143,17 @@ public:
   vtkSetMacro(ArrayComponent, int);
   vtkGetMacro(ArrayComponent, int);
 
+  // Description:
+  // Enable/Disable contouring slabs of the execute extent concurrently
+  // with vtkSMPTools.  The output is identical to the serial one, but
+  // the slabs are kept until they are merged, which about doubles the
+  // memory used by the output during the execution.  The slabs are only
+  // used when several threads are available and all the input arrays
+  // can be read concurrently.  On by default.
+  vtkSetMacro(EnableSMP, int);
+  vtkGetMacro(EnableSMP, int);
+  vtkBooleanMacro(EnableSMP, int);
+
 protected:
   vtkSynchronizedTemplates3D();
   ~vtkSynchronizedTemplates3D();
@@ -151,6 +170,7 @@ protected:
   int ExecuteExtent[6];
 
   int ArrayComponent;
+  int EnableSMP;
 
 private:
   vtkSynchronizedTemplates3D(const vtkSynchronizedTemplates3D&);  // Not implemented.
@@ -164,6 +184,76 @@ private:
 extern int VTK_GRAPHICS_EXPORT VTK_SYNCHRONIZED_TEMPLATES_3D_TABLE_1[];
 extern int VTK_GRAPHICS_EXPORT VTK_SYNCHRONIZED_TEMPLATES_3D_TABLE_2[];
 
+// Contour the execute extent of a synchronized templates filter in slabs
+// of cells along z and merge them.  It is shared by
+// vtkSynchronizedTemplates3D and vtkGridSynchronizedTemplates3D.
+//
+// Each slab is contoured into its own vtkPolyData by the serial
+// algorithm restricted to the planes zmin to zmax of the slab, except
+// that the edges along z are intersected up to the end of the execute
+// extent so that the top plane of a slab is complete.  The points of
+// the bottom plane of a slab are the points of the top plane of the
+// slab below: the contour functions report the edge ids of both planes
+// with EndPlane() and Merge() maps one onto the other.  A point created
+// on a bottom plane may not be reused there the way the serial
+// algorithm reuses degenerate points from the plane below, so Merge()
+// also drops the triangles that become degenerate once mapped.
+class VTK_GRAPHICS_EXPORT vtkSynchronizedTemplatesSlabs
+{
+public:
+  // Description:
+  // Cut the cells of exExt in numberOfSlabs slabs along z, numberOfSlabs
+  // being clamped to the number of layers of cells.
+  vtkSynchronizedTemplatesSlabs(int *exExt, int numberOfContours,
+                                int numberOfSlabs);
+  ~vtkSynchronizedTemplatesSlabs();
+
+  // Description:
+  // Return the number of slabs to use for exExt with the threads of
+  // vtkSMPTools, 1 when the extent should be contoured serially.
+  static int ComputeNumberOfSlabs(int *exExt);
+
+  // Description:
+  // Return 1 when the point and cell arrays of the input can be read, and
+  // copied or interpolated to disjoint tuples, by several threads at once:
+  // they must all be dispatched directly (see vtkArrayDispatchIsDirect()),
+  // which excludes vtkBitArray.
+  static int CanContourInParallel(vtkDataSet *input);
+
+  // Description:
+  // Get the number of slabs, the output of a slab and the range of z
+  // indices of its points.
+  int GetNumberOfSlabs() {return this->NumberOfSlabs;}
+  vtkPolyData *GetSlabOutput(int slab);
+  void GetSlabZRange(int slab, int &zMin, int &zMax);
+
+  // Description:
+  // To be called by the contour functions while contouring a slab: at
+  // the start of each contour value, after each plane with the edge ids
+  // of the plane (3 per point of the execute extent in x and y, -1 when
+  // the edge is not intersected) and when the slab is done.
+  void BeginContour(int slab, int contour);
+  void EndPlane(int slab, int contour, int k, int *isect);
+  void EndSlab(int slab);
+
+  // Description:
+  // Merge the slabs into output with vtkSMPTools.  Return 0 if the
+  // planes shared by two slabs do not match.
+  int Merge(vtkPolyData *output);
+
+  struct Slab;
+
+private:
+  int NumberOfSlabs;
+  int NumberOfContours;
+  int PlaneSize;
+  int ZMax;
+  Slab *Slabs;
+
+  vtkSynchronizedTemplatesSlabs(const vtkSynchronizedTemplatesSlabs&);  // Not implemented.
+  void operator=(const vtkSynchronizedTemplatesSlabs&);  // Not implemented.
+};
+
 //ETX
 
 #endif
@@ -14,7 +14,7 @@
 =========================================================================*/
 #include "vtkThreshold.h"
 
-#include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
@@ -103,10 +103,11 @@ int vtkThreshold::RequestData(
   vtkUnstructuredGrid *output = vtkUnstructuredGrid::SafeDownCast(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, newCellId;
+  vtkIdType cellId, newCellId, numCells;
+  vtkIdType numNewPts, numNewCells, connectivitySize;
   vtkIdList *cellPts, *pointMap;
   vtkIdList *newCellPts;
-  vtkCell *cell;
+  vtkIdList *fromIds, *toIds;
   vtkPoints *newPoints;
   int i, ptId, newId, numPts;
   int numCellPts;
@@ -131,17 +132,8 @@ int vtkThreshold::RequestData(
     return 1;
     }
 
-  outPD->CopyGlobalIdsOn();
-  outPD->CopyAllocate(pd);
-  outCD->CopyGlobalIdsOn();
-  outCD->CopyAllocate(cd);
-
   numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
-
-  newPoints = vtkPoints::New();
-  newPoints->SetDataType( this->PointsDataType );
-  newPoints->Allocate(numPts);
+  numCells = input->GetNumberOfCells();
 
   pointMap = vtkIdList::New(); //maps old point ids into new
   pointMap->SetNumberOfIds(numPts);
@@ -150,17 +142,23 @@ int vtkThreshold::RequestData(
     pointMap->SetId(i,-1);
     }
 
+  cellPts = vtkIdList::New();
   newCellPts = vtkIdList::New();     
+  char *keptCells = new char[numCells > 0 ? numCells : 1];
 
   // are we using pointScalars?
   usePointScalars = (inScalars->GetNumberOfTuples() == numPts);
   
-  // Check that the scalars of each cell satisfy the threshold criterion
-  for (cellId=0; cellId < input->GetNumberOfCells(); cellId++)
+  // Check that the scalars of each cell satisfy the threshold criterion,
+  // numbering the points of the kept cells and counting the output so
+  // that it is allocated once to its exact size.
+  numNewPts = 0;
+  numNewCells = 0;
+  connectivitySize = 0;
+  for (cellId=0; cellId < numCells; cellId++)
     {
-    cell = input->GetCell(cellId);
-    cellPts = cell->GetPointIds();
-    numCellPts = cell->GetNumberOfPoints();
+    input->GetCellPoints(cellId, cellPts);
+    numCellPts = cellPts->GetNumberOfIds();
     
     if ( usePointScalars )
       {
@@ -188,43 +186,98 @@ int vtkThreshold::RequestData(
       keepCell = this->EvaluateComponents( inScalars, cellId );
       }
     
-    if (  numCellPts > 0 && keepCell )
+    // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
+    keptCells[cellId] = (numCellPts > 0 && keepCell);
+    if ( keptCells[cellId] )
       {
-      // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
       for (i=0; i < numCellPts; i++)
         {
         ptId = cellPts->GetId(i);
-        if ( (newId = pointMap->GetId(ptId)) < 0 )
+        if ( pointMap->GetId(ptId) < 0 )
           {
-          input->GetPoint(ptId, x);
-          newId = newPoints->InsertNextPoint(x);
-          pointMap->SetId(ptId,newId);
-          outPD->CopyData(pd,ptId,newId);
+          pointMap->SetId(ptId,numNewPts++);
           }
-        newCellPts->InsertId(i,newId);
         }
-      // special handling for polyhedron cells
-      if (vtkUnstructuredGrid::SafeDownCast(input) &&
-          input->GetCellType(cellId) == VTK_POLYHEDRON)
+      numNewCells++;
+      connectivitySize += numCellPts + 1;
+      }
+    } // for all cells
+
+  outPD->CopyGlobalIdsOn();
+  outPD->CopyAllocate(pd,numNewPts);
+  outCD->CopyGlobalIdsOn();
+  outCD->CopyAllocate(cd,numNewCells);
+
+  output->AllocateExact(numNewCells, connectivitySize);
+
+  newPoints = vtkPoints::New();
+  newPoints->SetDataType( this->PointsDataType );
+  newPoints->SetNumberOfPoints(numNewPts);
+
+  // The point and cell data are copied in bulk once the ids are known.
+  fromIds = vtkIdList::New();
+  toIds = vtkIdList::New();
+  fromIds->Allocate(numNewPts);
+  toIds->Allocate(numNewPts);
+  for (ptId=0; ptId < numPts; ptId++)
+    {
+    if ( (newId = pointMap->GetId(ptId)) >= 0 )
+      {
+      input->GetPoint(ptId, x);
+      newPoints->SetPoint(newId, x);
+      fromIds->InsertNextId(ptId);
+      toIds->InsertNextId(newId);
+      }
+    }
+  outPD->CopyData(pd,fromIds,toIds);
+
+  fromIds->Reset();
+  toIds->Reset();
+  fromIds->Allocate(numNewCells);
+  toIds->Allocate(numNewCells);
+
+  for (cellId=0; cellId < numCells; cellId++)
+    {
+    if ( !keptCells[cellId] )
+      {
+      continue;
+      }
+    // special handling for polyhedron cells
+    if (vtkUnstructuredGrid::SafeDownCast(input) &&
+        input->GetCellType(cellId) == VTK_POLYHEDRON)
+      {
+      newCellPts->Reset();
+      vtkUnstructuredGrid::SafeDownCast(input)->
+        GetFaceStream(cellId, newCellPts);
+      vtkUnstructuredGrid::ConvertFaceStreamPointIds(
+        newCellPts, pointMap->GetPointer(0));
+      }
+    else
+      {
+      input->GetCellPoints(cellId, cellPts);
+      numCellPts = cellPts->GetNumberOfIds();
+      newCellPts->SetNumberOfIds(numCellPts);
+      for (i=0; i < numCellPts; i++)
         {
-        newCellPts->Reset();
-        vtkUnstructuredGrid::SafeDownCast(input)->
-          GetFaceStream(cellId, newCellPts);
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(
-          newCellPts, pointMap->GetPointer(0));
+        newCellPts->SetId(i, pointMap->GetId(cellPts->GetId(i)));
         }
-      newCellId = output->InsertNextCell(cell->GetCellType(),newCellPts);
-      outCD->CopyData(cd,cellId,newCellId);
-      newCellPts->Reset();
-      } // satisfied thresholding
-    } // for all cells
+      }
+    newCellId = output->InsertNextCell(input->GetCellType(cellId),newCellPts);
+    fromIds->InsertNextId(cellId);
+    toIds->InsertNextId(newCellId);
+    }
+  outCD->CopyData(cd,fromIds,toIds);
 
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() 
                 << " number of cells.");
 
   // now clean up / update ourselves
+  delete [] keptCells;
   pointMap->Delete();
+  cellPts->Delete();
   newCellPts->Delete();
+  fromIds->Delete();
+  toIds->Delete();
   
   output->SetPoints(newPoints);
   newPoints->Delete();
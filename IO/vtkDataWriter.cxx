@@ -1874,14 +1874,17 @@ int vtkDataWriter::WriteCells(ostream *fp, vtkCellArray *cells, const char *labe
     {
     // swap the bytes if necc
     // currently writing vtkIdType as int
-    vtkIdType *tempArray = cells->GetPointer();
-    int arraySize = cells->GetNumberOfConnectivityEntries();
-    int *intArray = new int[arraySize];
-    int i;
-    
-    for (i = 0; i < arraySize; i++)
+    int *intArray = new int[size];
+    int i = 0;
+    vtkIdType *pts = 0;
+    vtkIdType npts = 0;
+    for (cells->InitTraversal(); cells->GetNextCell(npts,pts); )
       {
-      intArray[i] = tempArray[i];
+      intArray[i++] = static_cast<int>(npts);
+      for (vtkIdType j=0; j<npts; j++)
+        {
+        intArray[i++] = static_cast<int>(pts[j]);
+        }
       }
     
     vtkByteSwap::SwapWrite4BERange(intArray,size,fp);
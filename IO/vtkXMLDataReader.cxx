@@ -157,6 +157,10 @@ void vtkXMLDataReader::SetupUpdateExtentInformation(vtkInformation *outInfo)
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
   int npieces = 
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  if (piece < 0 || piece >= this->NumberOfPieces)
+    {
+    return;
+    }
   
   // Setup the Field Information for PointData. 
   vtkInformationVector *infoVector = 
@@ -194,6 +194,14 @@ vtkIdType vtkXMLPolyDataReader::GetNumberOfCellsInPiece(int piece)
           this->NumberOfPolys[piece]);
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkXMLPolyDataReader::GetEstimatedCellSize()
+{
+  // The number of points and three point ids.  The cell types and
+  // locations are only built on demand.
+  return 4*sizeof(vtkIdType);
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPolyDataReader::SetupOutputData()
 {
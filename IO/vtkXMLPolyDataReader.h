@@ -72,6 +72,9 @@ protected:
   // UpdateInformation.
   virtual vtkIdType GetNumberOfCellsInPiece(int piece);
 
+  // Estimate the topology of a cell as that of a triangle.
+  virtual unsigned long GetEstimatedCellSize();
+
   virtual int FillOutputPortInformation(int, vtkInformation*);
 
   // The size of the UpdatePiece.
@@ -22,6 +22,7 @@
 #include "vtkPointSet.h"
 #include "vtkInformation.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkDataObject.h"
 
 #include <assert.h>
 
@@ -359,6 +360,86 @@ void vtkXMLUnstructuredDataReader::SetupOutputInformation(vtkInformation *outInf
 }
 
 
+//----------------------------------------------------------------------------
+void vtkXMLUnstructuredDataReader::SetupUpdateExtentInformation(
+  vtkInformation *outInfo)
+{
+  this->Superclass::SetupUpdateExtentInformation(outInfo);
+  if(!this->NumberOfPieces)
+    {
+    return;
+    }
+
+  // Find the range of pieces that would be read, as SetupUpdateExtent
+  // does.
+  int piece =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  int numberOfPieces =
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  if(numberOfPieces > this->NumberOfPieces)
+    {
+    numberOfPieces = this->NumberOfPieces;
+    }
+  vtkIdType numberOfPoints = 0;
+  vtkIdType numberOfCells = 0;
+  if(piece >= 0 && piece < numberOfPieces)
+    {
+    int startPiece = (piece*this->NumberOfPieces) / numberOfPieces;
+    int endPiece = ((piece+1)*this->NumberOfPieces) / numberOfPieces;
+    for(int i=startPiece; i < endPiece; ++i)
+      {
+      numberOfPoints += this->GetNumberOfPointsInPiece(i);
+      numberOfCells += this->GetNumberOfCellsInPiece(i);
+      }
+    }
+
+  double pointSize = this->GetTupleSize(this->PointElements[0], -1) +
+    this->GetTupleSize(this->PointDataElements[0],
+                       vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  double cellSize = this->GetTupleSize(this->CellDataElements[0],
+                                       vtkDataObject::FIELD_ASSOCIATION_CELLS) +
+    this->GetEstimatedCellSize();
+  double size = (numberOfPoints*pointSize + numberOfCells*cellSize) / 1024.0;
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::ESTIMATED_MEMORY_SIZE(),
+               static_cast<unsigned long>(size + 1.0));
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkXMLUnstructuredDataReader::GetEstimatedCellSize()
+{
+  return 1 + 6*sizeof(vtkIdType);
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkXMLUnstructuredDataReader::GetTupleSize(
+  vtkXMLDataElement* eParent, int association)
+{
+  unsigned long size = 0;
+  if(!eParent)
+    {
+    return size;
+    }
+  for(int i=0; i < eParent->GetNumberOfNestedElements(); ++i)
+    {
+    vtkXMLDataElement* eNested = eParent->GetNestedElement(i);
+    if((association == vtkDataObject::FIELD_ASSOCIATION_POINTS &&
+        !this->PointDataArrayIsEnabled(eNested)) ||
+       (association == vtkDataObject::FIELD_ASSOCIATION_CELLS &&
+        !this->CellDataArrayIsEnabled(eNested)))
+      {
+      continue;
+      }
+    int dataType = 0;
+    int components = 1;
+    if(eNested->GetWordTypeAttribute("type", dataType))
+      {
+      eNested->GetScalarAttribute("NumberOfComponents", components);
+      size += components*vtkAbstractArray::GetDataTypeSize(dataType);
+      }
+    }
+  return size;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLUnstructuredDataReader::CopyOutputInformation(vtkInformation *outInfo, int port)
 {
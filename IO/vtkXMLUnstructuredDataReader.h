@@ -80,6 +80,19 @@ protected:
   // Setup the output's information.
   void SetupOutputInformation(vtkInformation *outInfo);
 
+  // Setup the output's information for the update extent: estimate the
+  // memory size of the requested piece from the file meta data.
+  virtual void SetupUpdateExtentInformation(vtkInformation *outInfo);
+
+  // Get the number of bytes per tuple of the arrays nested in the given
+  // element, skipping the disabled point or cell data arrays.
+  unsigned long GetTupleSize(vtkXMLDataElement* eParent, int association);
+
+  // Get the estimated number of bytes used by the topology of one cell.
+  // The connectivity size is not in the meta data, so the default
+  // counts a cell type, a location and the ids of a tetrahedron.
+  virtual unsigned long GetEstimatedCellSize();
+
   void SetupOutputData();
   int ReadPiece(vtkXMLDataElement* ePiece);
   int ReadPieceData();
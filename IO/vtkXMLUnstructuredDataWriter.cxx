@@ -20,6 +20,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkErrorCode.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -772,27 +773,31 @@ vtkXMLUnstructuredDataWriter::WriteCellsAppendedData(vtkCellArray* cells,
 //----------------------------------------------------------------------------
 void vtkXMLUnstructuredDataWriter::ConvertCells(vtkCellArray* cells)
 {
-  vtkIdTypeArray* connectivity = cells->GetData();
   vtkIdType numberOfCells = cells->GetNumberOfCells();
-  vtkIdType numberOfTuples = connectivity->GetNumberOfTuples();
+  vtkIdType numberOfTuples = cells->GetNumberOfConnectivityEntries();
   
   this->CellPoints->SetNumberOfTuples(numberOfTuples - numberOfCells);
   this->CellOffsets->SetNumberOfTuples(numberOfCells);
   
-  vtkIdType* inCell = connectivity->GetPointer(0);
   vtkIdType* outCellPointsBase = this->CellPoints->GetPointer(0);
   vtkIdType* outCellPoints = outCellPointsBase;
   vtkIdType* outCellOffset = this->CellOffsets->GetPointer(0);
   
+  // The cells are traversed rather than copied from the vtkIdType list,
+  // which does not exist when the cell array uses 32 bit storage.
+  vtkIdList* buffer = vtkIdList::New();
+  vtkIdType loc = 0;
+  vtkIdType numberOfPoints;
+  vtkIdType* inCell;
   vtkIdType i;
-  for(i=0;i < numberOfCells; ++i)
+  for(i=0;i < numberOfCells &&
+        cells->GetNextCell(loc, numberOfPoints, inCell, buffer); ++i)
     {
-    vtkIdType numberOfPoints = *inCell++;
     memcpy(outCellPoints, inCell, sizeof(vtkIdType)*numberOfPoints);
     outCellPoints += numberOfPoints;
-    inCell += numberOfPoints;
     *outCellOffset++ = outCellPoints - outCellPointsBase;
     }
+  buffer->Delete();
 }
 
 //----------------------------------------------------------------------------
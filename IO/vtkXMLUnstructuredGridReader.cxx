@@ -125,6 +125,13 @@ vtkIdType vtkXMLUnstructuredGridReader::GetNumberOfCellsInPiece(int piece)
   return this->NumberOfCells[piece];
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkXMLUnstructuredGridReader::GetEstimatedCellSize()
+{
+  // A type, a location, the number of points and eight point ids.
+  return 1 + 10*sizeof(vtkIdType);
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLUnstructuredGridReader::SetupOutputData()
 {
@@ -66,6 +66,9 @@ protected:
   // UpdateInformation.
   virtual vtkIdType GetNumberOfCellsInPiece(int piece);
 
+  // Estimate the topology of a cell as that of a hexahedron.
+  virtual unsigned long GetEstimatedCellSize();
+
   virtual int FillOutputPortInformation(int, vtkInformation*);
 
   // The index of the cell in the output where the current piece
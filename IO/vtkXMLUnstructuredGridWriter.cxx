@@ -226,7 +226,7 @@ void vtkXMLUnstructuredGridWriter::CalculateSuperclassFraction(float* fractions)
     }
   else
     {
-    connectSize = (input->GetCells()->GetData()->GetNumberOfTuples() -
+    connectSize = (input->GetCells()->GetNumberOfConnectivityEntries() -
                    input->GetNumberOfCells());
     }
   vtkIdType offsetSize = input->GetNumberOfCells();
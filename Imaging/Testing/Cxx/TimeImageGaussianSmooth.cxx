@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeImageGaussianSmooth.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the execution time of vtkImageGaussianSmooth when its pieces
+// are run by vtkMultiThreader::SingleMethodExecute (threads created for
+// every execution) and by vtkSMPTools (persistent thread pool).
+//
+// Usage: TimeImageGaussianSmooth [maxThreads [repetitions]]
+
+#include "vtkImageData.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkMultiThreader.h"
+#include "vtkPointData.h"
+#include "vtkDataArray.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <stdlib.h>
+
+// Time "repetitions" executions of the smoothing filter and return the
+// average time per execution.
+static double TimeSmooth(vtkImageGaussianSmooth *smooth, int repetitions)
+{
+  vtkSmartPointer<vtkTimerLog> timer = vtkSmartPointer<vtkTimerLog>::New();
+  smooth->Modified();
+  smooth->Update(); // warm up
+  timer->StartTimer();
+  for (int i = 0; i < repetitions; ++i)
+    {
+    smooth->Modified();
+    smooth->Update();
+    }
+  timer->StopTimer();
+  return timer->GetElapsedTime() / repetitions;
+}
+
+static double MaxDifference(vtkImageData *a, vtkImageData *b)
+{
+  vtkDataArray *sa = a->GetPointData()->GetScalars();
+  vtkDataArray *sb = b->GetPointData()->GetScalars();
+  double maxDiff = 0.0;
+  for (vtkIdType i = 0; i < sa->GetNumberOfTuples(); ++i)
+    {
+    double d = sa->GetTuple1(i) - sb->GetTuple1(i);
+    d = (d < 0 ? -d : d);
+    maxDiff = (d > maxDiff ? d : maxDiff);
+    }
+  return maxDiff;
+}
+
+int main(int argc, char *argv[])
+{
+  int maxThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  int repetitions = 20;
+  if (argc > 1)
+    {
+    maxThreads = atoi(argv[1]);
+    }
+  if (argc > 2)
+    {
+    repetitions = atoi(argv[2]);
+    }
+
+  // A 2D slice, where thread creation dominates, and a volume.
+  int extents[2][6] = { { -128, 127, -128, 127, 0, 0 },
+                        { -64, 63, -64, 63, -64, 63 } };
+  const char *names[2] = { "256x256 slice", "128^3 volume" };
+
+  int retVal = 0;
+  for (int e = 0; e < 2; ++e)
+    {
+    vtkSmartPointer<vtkRTAnalyticSource> source =
+      vtkSmartPointer<vtkRTAnalyticSource>::New();
+    source->SetWholeExtent(extents[e][0], extents[e][1], extents[e][2],
+                           extents[e][3], extents[e][4], extents[e][5]);
+    source->Update();
+
+    vtkSmartPointer<vtkImageGaussianSmooth> smooth =
+      vtkSmartPointer<vtkImageGaussianSmooth>::New();
+    smooth->SetInputConnection(source->GetOutputPort());
+    smooth->SetDimensionality(extents[e][4] == extents[e][5] ? 2 : 3);
+
+    vtkSmartPointer<vtkImageData> reference =
+      vtkSmartPointer<vtkImageData>::New();
+
+    cout << names[e] << " (" << repetitions << " executions)" << endl;
+    cout << "  threads  SingleMethodExecute(ms)  vtkSMPTools(ms)  speedup"
+         << "  work stealing(ms)" << endl;
+    for (int n = 1; n <= maxThreads; n *= 2)
+      {
+      smooth->SetNumberOfThreads(n);
+
+      smooth->EnableSMPOff();
+      double threaderTime = TimeSmooth(smooth, repetitions);
+      reference->DeepCopy(smooth->GetOutput());
+
+      vtkSMPTools::Initialize(n);
+      smooth->EnableSMPOn();
+      double smpTime = TimeSmooth(smooth, repetitions);
+
+      double diff = MaxDifference(reference, smooth->GetOutput());
+
+      // Over-decompose in pieces of 64 KB, up to VTK_MAX_THREADS of them,
+      // scheduled by work stealing.
+      smooth->SetNumberOfThreads(VTK_MAX_THREADS);
+      smooth->SetDesiredBytesPerPiece(65536);
+      double stealingTime = TimeSmooth(smooth, repetitions);
+      smooth->SetDesiredBytesPerPiece(0);
+      smooth->SetNumberOfThreads(n);
+      double stealingDiff = MaxDifference(reference, smooth->GetOutput());
+      diff = (stealingDiff > diff ? stealingDiff : diff);
+      if (diff != 0.0)
+        {
+        cerr << "Outputs differ by " << diff << " with " << n
+             << " threads" << endl;
+        retVal = 1;
+        }
+
+      cout << "  " << n << "\t   " << threaderTime * 1000.0 << "\t\t\t    "
+           << smpTime * 1000.0 << "\t     " << threaderTime / smpTime
+           << "\t      " << stealingTime * 1000.0 << endl;
+      }
+    }
+
+  return retVal;
+}
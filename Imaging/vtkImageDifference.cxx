@@ -95,6 +95,21 @@ if (this->Averaging && \
 
 
 
+//----------------------------------------------------------------------------
+// The pieces add their errors to those of their threadId, which may be
+// given to several pieces in SMP mode.
+int vtkImageDifference::RequestData(vtkInformation *request,
+                                    vtkInformationVector **inputVector,
+                                    vtkInformationVector *outputVector)
+{
+  for (int i = 0; i < this->NumberOfThreads; i++)
+    {
+    this->ErrorPerThread[i] = 0;
+    this->ThresholdedErrorPerThread[i] = 0;
+    }
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
 //----------------------------------------------------------------------------
 // This method computes the input extent necessary to generate the output.
 int vtkImageDifference::RequestUpdateExtent(
@@ -184,9 +199,6 @@ void vtkImageDifference::ThreadedRequestData(
   unsigned long count = 0;
   unsigned long target;
   
-  this->ErrorPerThread[id] = 0;
-  this->ThresholdedErrorPerThread[id] = 0;
-  
   if (inData[0] == NULL || inData[1] == NULL || outData == NULL)
     {
     if (!id)
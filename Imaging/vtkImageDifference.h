@@ -101,6 +101,9 @@ protected:
   virtual int RequestUpdateExtent(vtkInformation *, 
                                   vtkInformationVector **,
                                   vtkInformationVector *);
+  virtual int RequestData(vtkInformation *,
+                          vtkInformationVector **,
+                          vtkInformationVector *);
   
   virtual void ThreadedRequestData(vtkInformation *request, 
                                    vtkInformationVector **inputVector, 
@@ -71,7 +71,8 @@ void vtkExtractUnstructuredGridPiece::ComputeCellTags(vtkIntArray *tags,
 {
   int j;
   vtkIdType idx, numCells, ptId;
-  vtkIdType* cellPointer;
+  vtkCellArray* cells = input->GetCells();
+  vtkIdType cellLoc = 0;
   vtkIdType* ids;
   vtkIdType numCellPts;
 
@@ -87,8 +88,9 @@ void vtkExtractUnstructuredGridPiece::ComputeCellTags(vtkIntArray *tags,
       }
     }
     
-  // Brute force division.
-  cellPointer = (input->GetCells() ? input->GetCells()->GetPointer() : 0);
+  // Brute force division.  The points of a cell are decoded into
+  // cellIdBuffer when the cells use 32 bit storage.
+  vtkIdList* cellIdBuffer = vtkIdList::New();
   for (idx = 0; idx < numCells; ++idx)
     {
     if ((idx * numPieces / numCells) == piece)
@@ -102,10 +104,7 @@ void vtkExtractUnstructuredGridPiece::ComputeCellTags(vtkIntArray *tags,
     // Fill in point ownership mapping.
     if (pointOwnership)
       {
-      numCellPts = cellPointer[0];
-      ids = cellPointer+1;
-      // Move to the next cell.
-      cellPointer += (1 + numCellPts);
+      cells->GetNextCell(cellLoc, numCellPts, ids, cellIdBuffer);
       for (j = 0; j < numCellPts; ++j)
         {
         ptId = ids[j];
@@ -116,6 +115,7 @@ void vtkExtractUnstructuredGridPiece::ComputeCellTags(vtkIntArray *tags,
         }
       }
     }
+  cellIdBuffer->Delete();
 }
 
 int vtkExtractUnstructuredGridPiece::RequestData(
@@ -147,8 +147,8 @@ int vtkExtractUnstructuredGridPiece::RequestData(
   vtkIdList *pointOwnership = 0;
   vtkUnsignedCharArray* pointGhostLevels = 0;
   vtkIdType i, ptId, newId, numPts, numCells;
-  int numCellPts;
-  vtkIdType *cellPointer;
+  vtkIdType numCellPts;
+  vtkIdType cellLoc = 0;
   vtkIdType *ids;
   double *x;
 
@@ -211,15 +211,14 @@ int vtkExtractUnstructuredGridPiece::RequestData(
     }
 
   // Filter the cells
-  cellPointer = (input->GetCells() ? input->GetCells()->GetPointer() : 0);
+  // The points of a cell are decoded into cellIdBuffer with 32 bit storage.
+  vtkCellArray *cells = input->GetCells();
+  vtkIdList *cellIdBuffer = vtkIdList::New();
   for (cellId=0; cellId < numCells; cellId++)
     {
     // Direct access to cells.
     cellType = cellTypes[cellId];
-    numCellPts = cellPointer[0];
-    ids = cellPointer+1;
-    // Move to the next cell.
-    cellPointer += (1 + *cellPointer);
+    cells->GetNextCell(cellLoc, numCellPts, ids, cellIdBuffer);
 
     if ( cellTags->GetValue(cellId) != -1) // satisfied thresholding
       {
@@ -290,6 +289,7 @@ int vtkExtractUnstructuredGridPiece::RequestData(
   // now clean up / update ourselves
   pointMap->Delete();
   newCellPts->Delete();
+  cellIdBuffer->Delete();
   
   if (cellGhostLevels)
     {
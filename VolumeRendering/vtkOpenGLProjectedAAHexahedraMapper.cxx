@@ -605,7 +605,7 @@ void vtkOpenGLProjectedAAHexahedraMapper::ProjectHexahedra(
 
   this->SetState(observer);
 
-  vtkIdType *cells = input->GetCells()->GetPointer();
+  vtkCellArray *cells = input->GetCells();
   vtkIdType totalnumcells = input->GetNumberOfCells();
   vtkIdType numcellsrendered = 0;
 
@@ -629,7 +629,7 @@ void vtkOpenGLProjectedAAHexahedraMapper::ProjectHexahedra(
       float corner_scalars[8];
 
       // get the data for the current hexahedron
-      vtkIdType index = cells [ 9 * cell + 1 ];
+      vtkIdType index = cells->GetCellPointId( 9 * cell, 0 );
       float* p = points + 3 * index;
 
       float vmin[3] = {p[0],p[1],p[2]},
@@ -638,7 +638,7 @@ void vtkOpenGLProjectedAAHexahedraMapper::ProjectHexahedra(
         int j;
         for(j = 1; j < 8; j++)
           {
-          index = cells [ 9 * cell + 1 + j ];
+          index = cells->GetCellPointId( 9 * cell, j );
 
           p = points + 3 * index;
           if (p[0]<vmin[0])
@@ -678,7 +678,7 @@ void vtkOpenGLProjectedAAHexahedraMapper::ProjectHexahedra(
 
         for(j = 0; j < 8; j++)
           {
-          index = cells [ 9 * cell + 1 + j ];
+          index = cells->GetCellPointId( 9 * cell, j );
 
           p = points + 3 * index;
           int corner = 0;
@@ -618,7 +618,7 @@ void vtkOpenGLProjectedTetrahedraMapper::ProjectTetrahedra(vtkRenderer *renderer
   glLoadIdentity();
 
   unsigned char *colors = this->Colors->GetPointer(0);
-  vtkIdType *cells = input->GetCells()->GetPointer();
+  vtkCellArray *cells = input->GetCells();
   vtkIdType totalnumcells = input->GetNumberOfCells();
   vtkIdType numcellsrendered = 0;
 
@@ -644,7 +644,7 @@ void vtkOpenGLProjectedTetrahedraMapper::ProjectTetrahedra(vtkRenderer *renderer
         {
         // Assuming we only have tetrahedra, each entry in cells has 5
         // components.
-        const float *p = points + 3*cells[5*cell + j + 1];
+        const float *p = points + 3*cells->GetCellPointId(5*cell, j);
         tet_points[j*3 + 0] = p[0];
         tet_points[j*3 + 1] = p[1];
         tet_points[j*3 + 2] = p[2];
@@ -656,7 +656,7 @@ void vtkOpenGLProjectedTetrahedraMapper::ProjectTetrahedra(vtkRenderer *renderer
           }
         else
           {
-          c = colors + 4*cells[5*cell + j + 1];
+          c = colors + 4*cells->GetCellPointId(5*cell, j);
           }
         tet_colors[j*3 + 0] = c[0];
         tet_colors[j*3 + 1] = c[1];